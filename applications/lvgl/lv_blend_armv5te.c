@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+/**
+ * @file lv_blend_armv5te.c
+ *
+ * Blend kernels of the software renderer for the ARM926EJ-S. Two RGB565 pixels
+ * are moved as one word, rows are filled and copied with multi-word STM/LDM
+ * bursts, and opacities are scaled by SMULBB. The results are bit-exact with
+ * fill_normal and map_normal of lv_draw_sw_blend.c, every mix is done by
+ * lv_color_mix() or lv_color_mix_premult() in the same way as there.
+ *
+ * The assembly is used with GCC on an ARMv5TE or later core in ARM state,
+ * other builds take the C code of the same kernels.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_armv5te.h"
+
+#if (LV_COLOR_DEPTH == 16) || (LV_COLOR_DEPTH == 32)
+
+/*********************
+ *      DEFINES
+ *********************/
+#if defined(__GNUC__) && defined(__ARM_FEATURE_DSP) && !defined(__thumb__)
+    #define BLEND_USE_ASM   1
+#else
+    #define BLEND_USE_ASM   0
+#endif
+
+#define BLEND_MASK32_COVER  0xFFFFFFFFU
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* (a * b) >> 8 of two 8-bit values. */
+static inline uint32_t blend_mul8(uint32_t a, uint32_t b)
+{
+#if BLEND_USE_ASM
+    uint32_t r;
+
+    __asm__("smulbb %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+
+    return r >> 8;
+#else
+    return (a * b) >> 8;
+#endif
+}
+
+/* Store n words of value c. */
+LV_ATTRIBUTE_FAST_MEM static void blend_fill_words(uint32_t *d, uint32_t c, int32_t n)
+{
+#if BLEND_USE_ASM
+    /* 8 words a loop */
+    __asm__ volatile(
+        "   mov     r4, %[c]                    \n"
+        "   mov     r5, %[c]                    \n"
+        "   mov     r6, %[c]                    \n"
+        "   mov     r8, %[c]                    \n"
+        "   subs    %[n], %[n], #8              \n"
+        "   blt     2f                          \n"
+        "1: stmia   %[d]!, {r4, r5, r6, r8}     \n"
+        "   stmia   %[d]!, {r4, r5, r6, r8}     \n"
+        "   subs    %[n], %[n], #8              \n"
+        "   bge     1b                          \n"
+        "2: add     %[n], %[n], #8              \n"
+        : [d] "+r"(d), [n] "+r"(n)
+        : [c] "r"(c)
+        : "r4", "r5", "r6", "r8", "cc", "memory");
+#endif
+
+    while (n-- > 0)
+        *d++ = c;
+}
+
+/* Copy n words, the source is prefetched one cache line ahead. */
+LV_ATTRIBUTE_FAST_MEM static void blend_copy_words(uint32_t *d, const uint32_t *s, int32_t n)
+{
+#if BLEND_USE_ASM
+    /* 4 words a loop */
+    __asm__ volatile(
+        "   subs    %[n], %[n], #4              \n"
+        "   blt     2f                          \n"
+        "1: pld     [%[s], #32]                 \n"
+        "   ldmia   %[s]!, {r4, r5, r6, r8}     \n"
+        "   subs    %[n], %[n], #4              \n"
+        "   stmia   %[d]!, {r4, r5, r6, r8}     \n"
+        "   bge     1b                          \n"
+        "2: add     %[n], %[n], #4              \n"
+        : [d] "+r"(d), [s] "+r"(s), [n] "+r"(n)
+        :
+        : "r4", "r5", "r6", "r8", "cc", "memory");
+#endif
+
+    while (n-- > 0)
+        *d++ = *s++;
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_fill_row(lv_color_t *dest_buf, lv_color_t color, int32_t w)
+{
+#if LV_COLOR_DEPTH == 16
+    if (w <= 0)
+        return;
+
+    if ((lv_uintptr_t)dest_buf & 0x2)
+    {
+        *dest_buf++ = color;
+        w--;
+    }
+
+    blend_fill_words((uint32_t *)dest_buf, color.full | ((uint32_t)color.full << 16), w >> 1);
+
+    if (w & 0x1)
+        dest_buf[w - 1] = color;
+#else
+    blend_fill_words((uint32_t *)dest_buf, color.full, w);
+#endif
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_copy_row(lv_color_t *dest_buf, const lv_color_t *src_buf, int32_t w)
+{
+#if LV_COLOR_DEPTH == 16
+    if (w <= 0)
+        return;
+
+    /* Only the same alignment could be copied in words. */
+    if (((lv_uintptr_t)dest_buf ^ (lv_uintptr_t)src_buf) & 0x2)
+    {
+        lv_memcpy(dest_buf, src_buf, w * sizeof(lv_color_t));
+        return;
+    }
+
+    if ((lv_uintptr_t)dest_buf & 0x2)
+    {
+        *dest_buf++ = *src_buf++;
+        w--;
+    }
+
+    blend_copy_words((uint32_t *)dest_buf, (const uint32_t *)src_buf, w >> 1);
+
+    if (w & 0x1)
+        dest_buf[w - 1] = src_buf[w - 1];
+#else
+    blend_copy_words((uint32_t *)dest_buf, (const uint32_t *)src_buf, w);
+#endif
+}
+
+/* dest = lv_color_mix(src, dest, mix) over a row. */
+LV_ATTRIBUTE_FAST_MEM static void blend_mix_row(lv_color_t *dest_buf, const lv_color_t *src_buf, int32_t w, lv_opa_t mix)
+{
+    int32_t x = 0;
+
+#if LV_COLOR_DEPTH == 16
+    if ((((lv_uintptr_t)dest_buf | (lv_uintptr_t)src_buf) & 0x2) == 0)
+    {
+        const uint32_t *s32 = (const uint32_t *)src_buf;
+        uint32_t *d32 = (uint32_t *)dest_buf;
+        lv_color_t s, d, r0, r1;
+
+        for (; x < (w & ~0x1); x += 2)
+        {
+            uint32_t sw = *s32++;
+            uint32_t dw = *d32;
+
+            s.full = (uint16_t)sw;
+            d.full = (uint16_t)dw;
+            r0 = lv_color_mix(s, d, mix);
+
+            s.full = (uint16_t)(sw >> 16);
+            d.full = (uint16_t)(dw >> 16);
+            r1 = lv_color_mix(s, d, mix);
+
+            *d32++ = r0.full | ((uint32_t)r1.full << 16);
+        }
+    }
+#endif
+
+    for (; x < w; x++)
+        dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], mix);
+}
+
+/* Length of the run of value v at the start of the mask. */
+LV_ATTRIBUTE_FAST_MEM static int32_t blend_mask_run(const lv_opa_t *mask, int32_t n, lv_opa_t v)
+{
+    uint32_t v32 = v * 0x01010101U;
+    int32_t i = 0;
+
+    for (; (i < n) && ((lv_uintptr_t)(mask + i) & 0x3); i++)
+    {
+        if (mask[i] != v)
+            return i;
+    }
+
+    for (; (i + 4 <= n) && (*(const uint32_t *)(mask + i) == v32); i += 4);
+
+    for (; (i < n) && (mask[i] == v); i++);
+
+    return i;
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_fill_opa(lv_color_t *dest_buf, int32_t w, int32_t h, lv_coord_t dest_stride,
+        lv_color_t color, lv_opa_t opa)
+{
+    lv_color_t last_dest_color = lv_color_black();
+    lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+    uint16_t color_premult[3];
+    lv_opa_t opa_inv;
+    int32_t x, y;
+
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+    /* Same rounding as fill_normal */
+    opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa = opa << 3;
+#endif
+
+    lv_color_premult(color, opa, color_premult);
+    opa_inv = 255 - opa;
+
+    for (y = 0; y < h; y++)
+    {
+        x = 0;
+
+#if LV_COLOR_DEPTH == 16
+        if ((lv_uintptr_t)dest_buf & 0x2)
+        {
+            if (w > 0)
+            {
+                if (last_dest_color.full != dest_buf[0].full)
+                {
+                    last_dest_color = dest_buf[0];
+                    last_res_color = lv_color_mix_premult(color_premult, dest_buf[0], opa_inv);
+                }
+                dest_buf[0] = last_res_color;
+            }
+            x = 1;
+        }
+
+        /* Two pixels of the same color as the last one are stored at once. */
+        for (; x < w - 1; x += 2)
+        {
+            uint32_t *d32 = (uint32_t *)&dest_buf[x];
+            uint32_t dw = *d32;
+            lv_color_t d;
+
+            if (dw != (last_dest_color.full | ((uint32_t)last_dest_color.full << 16)))
+            {
+                d.full = (uint16_t)dw;
+                if (last_dest_color.full != d.full)
+                {
+                    last_dest_color = d;
+                    last_res_color = lv_color_mix_premult(color_premult, d, opa_inv);
+                }
+                dest_buf[x] = last_res_color;
+
+                d.full = (uint16_t)(dw >> 16);
+                if (last_dest_color.full != d.full)
+                {
+                    last_dest_color = d;
+                    last_res_color = lv_color_mix_premult(color_premult, d, opa_inv);
+                }
+                dest_buf[x + 1] = last_res_color;
+            }
+            else
+            {
+                *d32 = last_res_color.full | ((uint32_t)last_res_color.full << 16);
+            }
+        }
+#endif
+
+        for (; x < w; x++)
+        {
+            if (last_dest_color.full != dest_buf[x].full)
+            {
+                last_dest_color = dest_buf[x];
+                last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
+            }
+            dest_buf[x] = last_res_color;
+        }
+
+        dest_buf += dest_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_fill_mask(lv_color_t *dest_buf, int32_t w, int32_t h, lv_coord_t dest_stride,
+        lv_color_t color, const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    int32_t x, y, n;
+
+    /*
+     * The walk over the mask is the one of fill_normal: a mask of 0 is still mixed
+     * outside of the all-zero words, that sets the alpha byte of ARGB8888.
+     */
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; (x < w) && ((lv_uintptr_t)&mask[x] & 0x3); x++)
+            dest_buf[x] = (mask[x] == LV_OPA_COVER) ? color : lv_color_mix(color, dest_buf[x], mask[x]);
+
+        while (x <= w - 4)
+        {
+            uint32_t mask32 = *(const uint32_t *)&mask[x];
+
+            if (mask32 == BLEND_MASK32_COVER)
+            {
+                /* Fill the covered words together. */
+                n = 4;
+                while ((x + n <= w - 4) && (*(const uint32_t *)&mask[x + n] == BLEND_MASK32_COVER))
+                    n += 4;
+
+                blend_fill_row(&dest_buf[x], color, n);
+                x += n;
+            }
+            else if (mask32)
+            {
+                for (n = x + 4; x < n; x++)
+                    dest_buf[x] = (mask[x] == LV_OPA_COVER) ? color : lv_color_mix(color, dest_buf[x], mask[x]);
+            }
+            else
+            {
+                x += 4;
+            }
+        }
+
+        for (; x < w; x++)
+            dest_buf[x] = (mask[x] == LV_OPA_COVER) ? color : lv_color_mix(color, dest_buf[x], mask[x]);
+
+        dest_buf += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_fill_mask_opa(lv_color_t *dest_buf, int32_t w, int32_t h, lv_coord_t dest_stride,
+        lv_color_t color, lv_opa_t opa, const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    lv_color_t last_dest_color = dest_buf[0];
+    lv_color_t last_res_color = dest_buf[0];
+    lv_opa_t last_mask = LV_OPA_TRANSP;
+    lv_opa_t opa_tmp = LV_OPA_TRANSP;
+    int32_t x, y;
+
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x++)
+        {
+            if (mask[x] == LV_OPA_TRANSP)
+            {
+                /* Skip the transparent words. */
+                if (((lv_uintptr_t)&mask[x] & 0x3) == 0)
+                    x += blend_mask_run(&mask[x], w - x, LV_OPA_TRANSP) - 1;
+                continue;
+            }
+
+            if (mask[x] != last_mask)
+                opa_tmp = (mask[x] == LV_OPA_COVER) ? opa : blend_mul8(mask[x], opa);
+
+            if ((mask[x] != last_mask) || (last_dest_color.full != dest_buf[x].full))
+            {
+                last_res_color = (opa_tmp == LV_OPA_COVER) ? color : lv_color_mix(color, dest_buf[x], opa_tmp);
+                last_mask = mask[x];
+                last_dest_color = dest_buf[x];
+            }
+
+            dest_buf[x] = last_res_color;
+        }
+
+        dest_buf += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_map_mask(lv_color_t *dest_buf, int32_t w, int32_t h, lv_coord_t dest_stride,
+        const lv_color_t *src_buf, lv_coord_t src_stride, const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    int32_t x, y, n;
+
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x += n)
+        {
+            if (mask[x] == LV_OPA_TRANSP)
+            {
+                n = blend_mask_run(&mask[x], w - x, LV_OPA_TRANSP);
+            }
+            else if (mask[x] == LV_OPA_COVER)
+            {
+                n = blend_mask_run(&mask[x], w - x, LV_OPA_COVER);
+                blend_copy_row(&dest_buf[x], &src_buf[x], n);
+            }
+            else
+            {
+                dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], mask[x]);
+                n = 1;
+            }
+        }
+
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+        mask += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void blend_map_mask_opa(lv_color_t *dest_buf, int32_t w, int32_t h, lv_coord_t dest_stride,
+        const lv_color_t *src_buf, lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    int32_t x, y;
+
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x++)
+        {
+            if (mask[x] == LV_OPA_TRANSP)
+            {
+                if (((lv_uintptr_t)&mask[x] & 0x3) == 0)
+                    x += blend_mask_run(&mask[x], w - x, LV_OPA_TRANSP) - 1;
+                continue;
+            }
+
+            dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], (mask[x] >= LV_OPA_MAX) ? opa : blend_mul8(opa, mask[x]));
+        }
+
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+        mask += mask_stride;
+    }
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM void lv_blend_armv5te_fill(lv_color_t *dest_buf, const lv_area_t *dest_area, lv_coord_t dest_stride,
+        lv_color_t color, lv_opa_t opa, const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+    int32_t y;
+
+    if (mask == NULL)
+    {
+        if (opa >= LV_OPA_MAX)
+        {
+            for (y = 0; y < h; y++)
+            {
+                blend_fill_row(dest_buf, color, w);
+                dest_buf += dest_stride;
+            }
+        }
+        else
+        {
+            blend_fill_opa(dest_buf, w, h, dest_stride, color, opa);
+        }
+    }
+    else if (opa >= LV_OPA_MAX)
+    {
+        blend_fill_mask(dest_buf, w, h, dest_stride, color, mask, mask_stride);
+    }
+    else
+    {
+        blend_fill_mask_opa(dest_buf, w, h, dest_stride, color, opa, mask, mask_stride);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_blend_armv5te_map(lv_color_t *dest_buf, const lv_area_t *dest_area, lv_coord_t dest_stride,
+        const lv_color_t *src_buf, lv_coord_t src_stride, lv_opa_t opa,
+        const lv_opa_t *mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+    int32_t y;
+
+    if (mask == NULL)
+    {
+        for (y = 0; y < h; y++)
+        {
+            if (opa >= LV_OPA_MAX)
+                blend_copy_row(dest_buf, src_buf, w);
+            else
+                blend_mix_row(dest_buf, src_buf, w, opa);
+
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+        }
+    }
+    /* The same limits as map_normal */
+    else if (opa > LV_OPA_MAX)
+    {
+        blend_map_mask(dest_buf, w, h, dest_stride, src_buf, src_stride, mask, mask_stride);
+    }
+    else
+    {
+        blend_map_mask_opa(dest_buf, w, h, dest_stride, src_buf, src_stride, opa, mask, mask_stride);
+    }
+}
+
+#endif /* (LV_COLOR_DEPTH == 16) || (LV_COLOR_DEPTH == 32) */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_BLEND_ARMV5TE_H
+#define LV_BLEND_ARMV5TE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if (LV_COLOR_DEPTH == 16) || (LV_COLOR_DEPTH == 32)
+
+/* Hooks of fill_normal and map_normal in lv_draw_sw_blend.c */
+#define LV_DRAW_SW_FILL_NORMAL(dest_buf, dest_area, dest_stride, color, opa, mask, mask_stride) \
+    lv_blend_armv5te_fill(dest_buf, dest_area, dest_stride, color, opa, mask, mask_stride)
+
+#define LV_DRAW_SW_MAP_NORMAL(dest_buf, dest_area, dest_stride, src_buf, src_stride, opa, mask, mask_stride) \
+    lv_blend_armv5te_map(dest_buf, dest_area, dest_stride, src_buf, src_stride, opa, mask, mask_stride)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill an area with a color, the output is the same as fill_normal of lv_draw_sw_blend.c.
+ * @param dest_buf     pointer to the first pixel of the area
+ * @param dest_area    the area, only its size is used
+ * @param dest_stride  width of the destination buffer in pixels
+ * @param color        the fill color
+ * @param opa          opacity of the color
+ * @param mask         A8 mask of the area, or NULL
+ * @param mask_stride  width of the mask buffer in pixels
+ */
+void lv_blend_armv5te_fill(lv_color_t *dest_buf, const lv_area_t *dest_area, lv_coord_t dest_stride,
+                           lv_color_t color, lv_opa_t opa, const lv_opa_t *mask, lv_coord_t mask_stride);
+
+/**
+ * Blend an image to an area, the output is the same as map_normal of lv_draw_sw_blend.c.
+ * @param dest_buf     pointer to the first pixel of the area
+ * @param dest_area    the area, only its size is used
+ * @param dest_stride  width of the destination buffer in pixels
+ * @param src_buf      pointer to the first pixel of the image
+ * @param src_stride   width of the image in pixels
+ * @param opa          opacity of the image
+ * @param mask         A8 mask of the area, or NULL
+ * @param mask_stride  width of the mask buffer in pixels
+ */
+void lv_blend_armv5te_map(lv_color_t *dest_buf, const lv_area_t *dest_area, lv_coord_t dest_stride,
+                          const lv_color_t *src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                          const lv_opa_t *mask, lv_coord_t mask_stride);
+
+#endif /* (LV_COLOR_DEPTH == 16) || (LV_COLOR_DEPTH == 32) */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_ARMV5TE_H*/
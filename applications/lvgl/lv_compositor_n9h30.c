@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+/**
+ * @file lv_compositor_n9h30.c
+ *
+ * Composition of the two VPOST planes. The LCD plane is at the bottom and holds the
+ * static content, e.g. a background rendered once from an LVGL object, or video. The
+ * OSD plane is on top of it and holds the UI; the VPOST shows the LCD plane where the
+ * OSD pixel matches the colour key. A change of the UI re-renders the OSD plane only.
+ *
+ * The software compositor does the same per pixel, so plane assignment and damage
+ * propagation can be checked on a host without the VPOST.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_compositor_n9h30.h"
+
+#if LV_USE_COMPOSITOR_N9H30
+
+#if defined(__RTTHREAD__)
+    #include <rtthread.h>
+    #include <rtdevice.h>
+    #include "mmu.h"
+    #include "drv_vpost.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef BIT31
+    #define BIT31    (0x80000000)       ///< Bit 31 mask of an 32 bit integer
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_color_t *buf;
+    lv_coord_t w;
+    lv_coord_t h;
+} nu_plane_t;
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static nu_plane_t s_planes[_LV_COMPOSITOR_N9H30_PLANE_NUM];
+static lv_color_t s_key;
+
+/* Areas of the composed image which are out of date */
+static lv_area_t s_damage[LV_COMPOSITOR_N9H30_DAMAGE_MAX];
+static uint32_t s_damage_count;
+
+static lv_compositor_n9h30_stat_t s_stat;
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static void nu_damage_add(const lv_area_t *area)
+{
+    nu_plane_t *plane = &s_planes[LV_COMPOSITOR_N9H30_PLANE_LCD];
+    uint32_t i;
+    lv_area_t joined;
+
+    for (i = 0; i < s_damage_count; i++)
+    {
+        if (_lv_area_is_in(area, &s_damage[i], 0))
+            return;
+
+        /* Join them if the bounding box is not larger than the both. */
+        _lv_area_join(&joined, area, &s_damage[i]);
+        if (lv_area_get_size(&joined) <= lv_area_get_size(area) + lv_area_get_size(&s_damage[i]))
+        {
+            s_damage[i] = joined;
+            s_stat.merges++;
+            return;
+        }
+    }
+
+    if (s_damage_count == LV_COMPOSITOR_N9H30_DAMAGE_MAX)
+    {
+        /* Too many pieces, compose whole plane. */
+        lv_area_set(&s_damage[0], 0, 0, plane->w - 1, plane->h - 1);
+        s_damage_count = 1;
+        s_stat.merges++;
+        return;
+    }
+
+    s_damage[s_damage_count++] = *area;
+}
+
+#if defined(__RTTHREAD__)
+static void nu_compositor_hw_init(void)
+{
+    struct rt_device_graphic_info info;
+    rt_device_t lcd = rt_device_find("lcd");
+    rt_device_t osd = rt_device_find("osd");
+    rt_uint32_t u32Key;
+
+    if (lcd == RT_NULL || osd == RT_NULL)
+    {
+        LV_LOG_WARN("no lcd or osd layer");
+        return;
+    }
+
+    if (rt_device_control(lcd, RTGRAPHIC_CTRL_GET_INFO, &info) != RT_EOK)
+        return;
+
+    /* Draw into the first buffer of the LCD layer through the cache. */
+    lv_compositor_n9h30_set_plane(LV_COMPOSITOR_N9H30_PLANE_LCD,
+                                  (lv_color_t *)((uint32_t)info.framebuffer & ~BIT31),
+                                  info.width, info.height);
+
+    if (rt_device_open(lcd, 0) != RT_EOK)
+        return;
+
+    rt_device_control(lcd, RTGRAPHIC_CTRL_PAN_DISPLAY, info.framebuffer);
+
+    /* The key takes 8-bit R/G/B whatever the colour depth is. */
+    u32Key = lv_color_to32(s_key) & 0x00FFFFFF;
+
+    if (rt_device_control(osd, NU_VPOST_CTRL_SET_COLKEY, &u32Key) != RT_EOK)
+        LV_LOG_WARN("no colour key");
+}
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+void lv_compositor_n9h30_init(lv_disp_t *disp, lv_color_t key)
+{
+    s_key = key;
+    s_damage_count = 0;
+    lv_memset_00(&s_stat, sizeof(s_stat));
+
+    if (disp)
+    {
+        /* Transparent screens show the LCD plane. */
+        lv_disp_set_bg_color(disp, key);
+        lv_disp_set_bg_opa(disp, LV_OPA_COVER);
+    }
+
+#if defined(__RTTHREAD__)
+    nu_compositor_hw_init();
+#endif
+}
+
+void lv_compositor_n9h30_set_plane(lv_compositor_n9h30_plane_t plane, lv_color_t *buf, lv_coord_t w, lv_coord_t h)
+{
+    lv_area_t area;
+
+    LV_ASSERT(plane < _LV_COMPOSITOR_N9H30_PLANE_NUM);
+
+    s_planes[plane].buf = buf;
+    s_planes[plane].w = w;
+    s_planes[plane].h = h;
+
+    /* The new content is not composed yet. */
+    lv_area_set(&area, 0, 0, w - 1, h - 1);
+    nu_damage_add(&area);
+}
+
+lv_color_t *lv_compositor_n9h30_get_buf(lv_compositor_n9h30_plane_t plane)
+{
+    LV_ASSERT(plane < _LV_COMPOSITOR_N9H30_PLANE_NUM);
+
+    return s_planes[plane].buf;
+}
+
+lv_color_t lv_compositor_n9h30_get_key(void)
+{
+    return s_key;
+}
+
+void lv_compositor_n9h30_set_transparent(lv_obj_t *obj)
+{
+    lv_obj_set_style_bg_color(obj, s_key, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+}
+
+lv_res_t lv_compositor_n9h30_assign(lv_obj_t *obj, lv_compositor_n9h30_plane_t plane)
+{
+    LV_ASSERT_NULL(obj);
+
+    if (plane == LV_COMPOSITOR_N9H30_PLANE_OSD)
+    {
+        if (lv_obj_get_parent(obj) != NULL)
+            return LV_RES_INV;
+
+        /* The UI display renders the OSD plane and reports its own damage. */
+        lv_scr_load(obj);
+        return LV_RES_OK;
+    }
+
+#if LV_USE_SNAPSHOT
+    {
+        nu_plane_t *lcd = &s_planes[LV_COMPOSITOR_N9H30_PLANE_LCD];
+        lv_img_dsc_t *snapshot;
+        lv_area_t area, clipped;
+        lv_coord_t ext_size, w, y;
+
+        if (lcd->buf == NULL)
+            return LV_RES_INV;
+
+        snapshot = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR);
+        if (snapshot == NULL)
+            return LV_RES_INV;
+
+        /* The snapshot covers the drawing area of the object. */
+        ext_size = _lv_obj_get_ext_draw_size(obj);
+        lv_obj_get_coords(obj, &area);
+        lv_area_increase(&area, ext_size, ext_size);
+
+        lv_area_set(&clipped, 0, 0, lcd->w - 1, lcd->h - 1);
+        if (_lv_area_intersect(&clipped, &clipped, &area))
+        {
+            const lv_color_t *src = (const lv_color_t *)snapshot->data;
+
+            w = lv_area_get_width(&clipped);
+            src += (clipped.y1 - area.y1) * snapshot->header.w + (clipped.x1 - area.x1);
+
+            for (y = clipped.y1; y <= clipped.y2; y++)
+            {
+                lv_memcpy(&lcd->buf[y * lcd->w + clipped.x1], src, w * sizeof(lv_color_t));
+                src += snapshot->header.w;
+            }
+
+            lv_compositor_n9h30_invalidate(LV_COMPOSITOR_N9H30_PLANE_LCD, &clipped);
+        }
+
+        lv_snapshot_free(snapshot);
+        s_stat.assigns++;
+
+        return LV_RES_OK;
+    }
+#else
+    LV_LOG_WARN("LV_USE_SNAPSHOT is needed to render into the LCD plane");
+    return LV_RES_INV;
+#endif
+}
+
+void lv_compositor_n9h30_invalidate(lv_compositor_n9h30_plane_t plane, const lv_area_t *area)
+{
+    nu_plane_t *p;
+    lv_area_t clipped;
+
+    LV_ASSERT(plane < _LV_COMPOSITOR_N9H30_PLANE_NUM);
+
+    p = &s_planes[plane];
+    lv_area_set(&clipped, 0, 0, p->w - 1, p->h - 1);
+    if (!_lv_area_intersect(&clipped, &clipped, area))
+        return;
+
+#if defined(__RTTHREAD__)
+    if (plane == LV_COMPOSITOR_N9H30_PLANE_LCD && p->buf)
+    {
+        /* The VPOST reads the plane behind the data cache. */
+        mmu_clean_dcache((uint32_t)&p->buf[clipped.y1 * p->w],
+                         lv_area_get_height(&clipped) * p->w * sizeof(lv_color_t));
+    }
+#endif
+
+    s_stat.damages++;
+    nu_damage_add(&clipped);
+}
+
+void lv_compositor_n9h30_sw_compose(lv_color_t *dst, const lv_color_t *lcd, const lv_color_t *osd,
+                                    lv_coord_t stride, const lv_area_t *area, lv_color_t key)
+{
+    lv_coord_t x, y;
+
+    for (y = area->y1; y <= area->y2; y++)
+    {
+        uint32_t offset = (uint32_t)y * stride;
+
+        for (x = area->x1; x <= area->x2; x++)
+        {
+            lv_color_t c = osd[offset + x];
+
+            dst[offset + x] = (c.full == key.full) ? lcd[offset + x] : c;
+        }
+    }
+}
+
+uint32_t lv_compositor_n9h30_sw_flush(lv_color_t *dst)
+{
+    nu_plane_t *lcd = &s_planes[LV_COMPOSITOR_N9H30_PLANE_LCD];
+    nu_plane_t *osd = &s_planes[LV_COMPOSITOR_N9H30_PLANE_OSD];
+    uint32_t i, pixels = 0;
+
+    if (lcd->buf == NULL)
+        return 0;
+
+    for (i = 0; i < s_damage_count; i++)
+    {
+        lv_area_t *area = &s_damage[i];
+
+        if (osd->buf)
+        {
+            lv_compositor_n9h30_sw_compose(dst, lcd->buf, osd->buf, lcd->w, area, s_key);
+        }
+        else
+        {
+            lv_coord_t y;
+
+            for (y = area->y1; y <= area->y2; y++)
+                lv_memcpy(&dst[y * lcd->w + area->x1], &lcd->buf[y * lcd->w + area->x1],
+                          lv_area_get_width(area) * sizeof(lv_color_t));
+        }
+
+        pixels += lv_area_get_size(area);
+    }
+
+    s_stat.composes += s_damage_count;
+    s_stat.pixels += pixels;
+    s_damage_count = 0;
+
+    return pixels;
+}
+
+void lv_compositor_n9h30_get_stat(lv_compositor_n9h30_stat_t *stat)
+{
+    *stat = s_stat;
+}
+
+#if defined(__RTTHREAD__) && defined(RT_USING_FINSH)
+static void compositor_stat(void)
+{
+    lv_compositor_n9h30_stat_t stat;
+
+    lv_compositor_n9h30_get_stat(&stat);
+    rt_kprintf("key: 0x%08x\n", (uint32_t)s_key.full);
+    rt_kprintf("assigns: %d, damages: %d, merges: %d, pending: %d\n",
+               stat.assigns, stat.damages, stat.merges, s_damage_count);
+    rt_kprintf("sw composes: %d, pixels: %d\n", stat.composes, stat.pixels);
+}
+MSH_CMD_EXPORT(compositor_stat, show layer compositor statistics);
+#endif
+
+#endif /* LV_USE_COMPOSITOR_N9H30 */
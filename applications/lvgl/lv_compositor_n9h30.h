@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_COMPOSITOR_N9H30_H
+#define LV_COMPOSITOR_N9H30_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Damaged areas of a plane kept for the software compositor, they are merged beyond this. */
+#ifndef LV_COMPOSITOR_N9H30_DAMAGE_MAX
+    #define LV_COMPOSITOR_N9H30_DAMAGE_MAX      16
+#endif
+
+/* Default colour key, the UI shows the LCD plane where it is drawn in this colour. */
+#ifndef LV_COMPOSITOR_N9H30_KEY
+    #define LV_COMPOSITOR_N9H30_KEY             lv_color_make(0xff, 0x00, 0xff)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum
+{
+    LV_COMPOSITOR_N9H30_PLANE_LCD,      /* Bottom plane: static backgrounds, video */
+    LV_COMPOSITOR_N9H30_PLANE_OSD,      /* Top plane: the UI, transparent where it matches the key */
+    _LV_COMPOSITOR_N9H30_PLANE_NUM
+} lv_compositor_n9h30_plane_t;
+
+typedef struct
+{
+    uint32_t assigns;       /* Objects rendered into the LCD plane */
+    uint32_t damages;       /* Areas reported by lv_compositor_n9h30_invalidate */
+    uint32_t merges;        /* Damaged areas merged into a bounding area */
+    uint32_t composes;      /* Areas composed by the software compositor */
+    uint32_t pixels;        /* Pixels composed by the software compositor */
+} lv_compositor_n9h30_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the compositor: the LCD plane is found by its device and the OSD plane
+ * shows it where the UI matches the key. The background of `disp` is set to the key.
+ * @param disp  the display of the UI, it renders on the OSD plane
+ * @param key   the colour key
+ */
+void lv_compositor_n9h30_init(lv_disp_t *disp, lv_color_t key);
+
+/**
+ * Set the buffer of a plane, e.g. on a host or when the LCD plane is double-buffered by the application.
+ * @param plane the plane
+ * @param buf   the buffer of the plane, `w * h` pixels
+ * @param w     width of the plane in pixels
+ * @param h     height of the plane in pixels
+ */
+void lv_compositor_n9h30_set_plane(lv_compositor_n9h30_plane_t plane, lv_color_t *buf, lv_coord_t w, lv_coord_t h);
+
+/**
+ * Get the buffer of a plane to draw into it directly, e.g. a video frame into the LCD plane.
+ * Report the drawn area by lv_compositor_n9h30_invalidate() afterwards.
+ * @param plane the plane
+ * @return      the buffer or NULL
+ */
+lv_color_t *lv_compositor_n9h30_get_buf(lv_compositor_n9h30_plane_t plane);
+
+/**
+ * Get the colour key.
+ * @return      the colour key
+ */
+lv_color_t lv_compositor_n9h30_get_key(void);
+
+/**
+ * Draw the background of an object in the colour key, the LCD plane shows through it.
+ * Anti-aliased edges against the key are blended with it and show as a fringe.
+ * @param obj   the object, e.g. a screen of the UI
+ */
+void lv_compositor_n9h30_set_transparent(lv_obj_t *obj);
+
+/**
+ * Assign an object to a plane.
+ * LCD: the object is rendered once into the LCD plane at its coordinates. It is not
+ *      rendered again when the UI changes, so it should not be on the active screen.
+ * OSD: the object, a screen, is loaded on the UI display.
+ * @param obj   the object
+ * @param plane the plane
+ * @return      LV_RES_OK: the object is shown on the plane, LV_RES_INV: failed
+ */
+lv_res_t lv_compositor_n9h30_assign(lv_obj_t *obj, lv_compositor_n9h30_plane_t plane);
+
+/**
+ * Report an area of a plane which has been drawn into. The cache lines of the LCD plane
+ * are written back, and the area is kept for lv_compositor_n9h30_sw_flush().
+ * @param plane the plane
+ * @param area  the area in plane coordinates
+ */
+void lv_compositor_n9h30_invalidate(lv_compositor_n9h30_plane_t plane, const lv_area_t *area);
+
+/**
+ * Compose an area of the planes as the overlay of the VPOST does it:
+ * the OSD pixel, or the LCD pixel where the OSD pixel equals the key.
+ * @param dst   the destination buffer
+ * @param lcd   the buffer of the LCD plane
+ * @param osd   the buffer of the OSD plane
+ * @param stride    width of the buffers in pixels
+ * @param area  the area to compose
+ * @param key   the colour key
+ */
+void lv_compositor_n9h30_sw_compose(lv_color_t *dst, const lv_color_t *lcd, const lv_color_t *osd,
+                                    lv_coord_t stride, const lv_area_t *area, lv_color_t key);
+
+/**
+ * Compose the damaged areas of both planes into a buffer and forget them.
+ * @param dst   the destination buffer, as large as the planes
+ * @return      number of composed pixels
+ */
+uint32_t lv_compositor_n9h30_sw_flush(lv_color_t *dst);
+
+/**
+ * Get the statistics of the compositor.
+ * @param stat  store the statistics here
+ */
+void lv_compositor_n9h30_get_stat(lv_compositor_n9h30_stat_t *stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_COMPOSITOR_N9H30_H*/
@@ -6,6 +6,13 @@
  * Change Logs:
  * Date           Author        Notes
  * 2022-6-1       Wayne Lin     First version
+ * 2026-10-16     Wayne Lin     Add LV_DRAW_SW_ASM_INCLUDE
+ * 2026-10-16     Wayne Lin     Add LV_USE_JPEG_N9H30
+ * 2026-10-16     Wayne Lin     Add LV_USE_GLYPH_CACHE
+ * 2026-10-16     Wayne Lin     Add LV_USE_VSYNC_PACING
+ * 2026-10-16     Wayne Lin     Add LV_USE_COMPOSITOR_N9H30
+ * 2026-10-16     Wayne Lin     Add LV_DISP_ROTATION
+ * 2026-10-16     Wayne Lin     Add LV_USE_PROF_N9H30
  */
 
 #ifndef LV_CONF_H
@@ -14,7 +21,29 @@
 #include "rtconfig.h"
 
 #define LV_USE_ANTI_TEARING      1
+#define LV_USE_DIRTY_AREA_SYNC   1      /* Anti-tearing renders invalidated areas only */
+#define LV_USE_FLUSH_MONITOR     0      /* Report rendered and synchronised pixels per frame */
+#define LV_USE_PROF_N9H30        1      /* Time frame phases, see lv_prof in msh */
+#define LV_USE_VSYNC_PACING      1      /* Run lv_task_handler at vsync */
+#define LV_DISP_ROTATION         0      /* 0, 90, 180 or 270 degrees, rotated by 2DGE at flushing */
 #define LV_GPU_USE_N9H30_2DGE    1
+#define LV_DRAW_SW_ASM_INCLUDE   "lv_blend_armv5te.h"   /* ARMv5TE kernels of software blending */
+
+#define LV_USE_GLYPH_CACHE       1      /* Keep A8 bitmaps of glyphs in an atlas */
+#if LV_USE_GLYPH_CACHE
+    #define LV_GLYPH_CACHE_SIZE         (64 * 1024)         /* Budget of the atlas in bytes */
+#endif
+
+#define LV_USE_JPEG_N9H30        1      /* Decode JPEG images by the JPEG engine */
+#if LV_USE_JPEG_N9H30
+    #define LV_JPEG_N9H30_CACHE_SIZE    (4 * 1024 * 1024)   /* Budget of decoded images in bytes */
+    #define LV_USE_SJPG                 1                   /* Software fallback */
+#endif
+
+#define LV_USE_COMPOSITOR_N9H30  0      /* UI on OSD layer, over LCD layer by colour key */
+#if LV_USE_COMPOSITOR_N9H30
+    #define LV_USE_SNAPSHOT             1                   /* Render objects into LCD layer */
+#endif
 
 #define LV_COLOR_DEPTH                  BSP_LCD_BPP
 #define LV_HOR_RES_MAX                  BSP_LCD_WIDTH
@@ -37,5 +66,6 @@
 /* Please comment LV_USE_DEMO_RTT_MUSIC declaration before un-comment below */
 //#define LV_USE_DEMO_WIDGETS         1
 //#define LV_USE_DEMO_BENCHMARK       1
+//#define LV_USE_DEMO_2DGE_BENCHMARK  1   /* Compare CPU and 2DGE rendering */
 
 #endif
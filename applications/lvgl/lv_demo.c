@@ -6,15 +6,207 @@
  * Change Logs:
  * Date           Author        Notes
  * 2022-6-1       Wayne         First version
+ * 2026-10-16     Wayne         Add 2DGE offload benchmark
  */
 
 #include <lvgl.h>
 
+#if LV_USE_DEMO_2DGE_BENCHMARK
+#include "lv_gpu_n9h30_2dge.h"
+
+#define NU_BENCH_FRAMES     30
+#define NU_BENCH_IMG_W      200
+#define NU_BENCH_IMG_H      120
+
+typedef struct
+{
+    const char *name;
+    void (*create)(lv_obj_t *parent);
+} nu_bench_case_t;
+
+static lv_img_dsc_t s_bench_img;
+
+static void nu_bench_fill(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+}
+
+static void nu_bench_rects(lv_obj_t *parent, lv_coord_t radius)
+{
+    int i;
+
+    for (i = 0; i < 24; i++)
+    {
+        lv_obj_t *obj = lv_obj_create(parent);
+
+        lv_obj_remove_style_all(obj);
+        /* Odd positions and sizes exercise the unaligned edges. */
+        lv_obj_set_pos(obj, (i % 6) * 127 + 3, (i / 6) * 97 + 5);
+        lv_obj_set_size(obj, 101 + (i % 3), 73 + (i % 2));
+        lv_obj_set_style_radius(obj, radius, 0);
+        lv_obj_set_style_bg_color(obj, lv_palette_main((lv_palette_t)(i % _LV_PALETTE_LAST)), 0);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    }
+}
+
+static void nu_bench_small_rects(lv_obj_t *parent)
+{
+    nu_bench_rects(parent, 0);
+}
+
+static void nu_bench_rounded_rects(lv_obj_t *parent)
+{
+    nu_bench_rects(parent, 16);
+}
+
+static void nu_bench_images(lv_obj_t *parent, lv_opa_t opa)
+{
+    int i;
+
+    for (i = 0; i < 12; i++)
+    {
+        lv_obj_t *img = lv_img_create(parent);
+
+        lv_img_set_src(img, &s_bench_img);
+        lv_obj_set_pos(img, (i % 4) * NU_BENCH_IMG_W + 1, (i / 4) * NU_BENCH_IMG_H + 1);
+        lv_obj_set_style_img_opa(img, opa, 0);
+    }
+}
+
+static void nu_bench_images_cover(lv_obj_t *parent)
+{
+    nu_bench_images(parent, LV_OPA_COVER);
+}
+
+static void nu_bench_images_half(lv_obj_t *parent)
+{
+    nu_bench_images(parent, LV_OPA_50);
+}
+
+static void nu_bench_additive(lv_obj_t *parent)
+{
+    lv_obj_t *obj;
+
+    nu_bench_fill(parent);
+
+    obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, LV_PCT(80), LV_PCT(80));
+    lv_obj_center(obj);
+    lv_obj_set_style_bg_color(obj, lv_color_make(0xff, 0x00, 0x00), 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_blend_mode(obj, LV_BLEND_MODE_ADDITIVE, 0);
+}
+
+static const nu_bench_case_t s_bench_cases[] =
+{
+    { "Full screen fill",      nu_bench_fill },
+    { "Small unaligned rects", nu_bench_small_rects },
+    { "Rounded rects",         nu_bench_rounded_rects },
+    { "True-color images",     nu_bench_images_cover },
+    { "Images at 50% opa",     nu_bench_images_half },
+    { "Additive fill",         nu_bench_additive },
+};
+
+/* Milliseconds to render NU_BENCH_FRAMES full frames. */
+static uint32_t nu_bench_run(lv_obj_t *scr)
+{
+    uint32_t start = lv_tick_get();
+    int i;
+
+    for (i = 0; i < NU_BENCH_FRAMES; i++)
+    {
+        lv_obj_invalidate(scr);
+        lv_refr_now(NULL);
+    }
+
+    return lv_tick_elaps(start);
+}
+
+static void nu_bench_img_init(void)
+{
+    lv_color_t *data = lv_mem_alloc(NU_BENCH_IMG_W * NU_BENCH_IMG_H * sizeof(lv_color_t));
+    int x, y;
+
+    LV_ASSERT_MALLOC(data);
+
+    for (y = 0; y < NU_BENCH_IMG_H; y++)
+        for (x = 0; x < NU_BENCH_IMG_W; x++)
+            data[y * NU_BENCH_IMG_W + x] = lv_color_make(x * 255 / NU_BENCH_IMG_W, y * 255 / NU_BENCH_IMG_H, 0x80);
+
+    s_bench_img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    s_bench_img.header.w = NU_BENCH_IMG_W;
+    s_bench_img.header.h = NU_BENCH_IMG_H;
+    s_bench_img.data_size = NU_BENCH_IMG_W * NU_BENCH_IMG_H * sizeof(lv_color_t);
+    s_bench_img.data = (const uint8_t *)data;
+}
+
+static void nu_bench_2dge(lv_timer_t *timer)
+{
+    lv_obj_t *result_scr, *label;
+    uint32_t i, t_sw, t_hw;
+    char *text;
+    int len = 0;
+
+    text = lv_mem_alloc(1024);
+    LV_ASSERT_MALLOC(text);
+
+    nu_bench_img_init();
+
+    len += lv_snprintf(text + len, 1024 - len, "2DGE offload threshold: %u pixels\n\n", (unsigned)lv_draw_n9h30_2dge_get_threshold());
+
+    for (i = 0; i < sizeof(s_bench_cases) / sizeof(s_bench_cases[0]); i++)
+    {
+        lv_obj_t *scr = lv_obj_create(NULL);
+
+        lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+        s_bench_cases[i].create(scr);
+        lv_scr_load(scr);
+
+        lv_draw_n9h30_2dge_enable(false);
+        t_sw = nu_bench_run(scr);
+
+        lv_draw_n9h30_2dge_enable(true);
+        t_hw = nu_bench_run(scr);
+
+        /* Speedup x100 */
+        len += lv_snprintf(text + len, 1024 - len, "%-22s CPU %5ums  2DGE %5ums  x%u.%02u\n",
+                           s_bench_cases[i].name, (unsigned)t_sw, (unsigned)t_hw,
+                           (unsigned)(t_sw * 100 / LV_MAX(t_hw, 1) / 100), (unsigned)(t_sw * 100 / LV_MAX(t_hw, 1) % 100));
+    }
+
+    LV_LOG_USER("\n%s", text);
+
+    result_scr = lv_obj_create(NULL);
+    label = lv_label_create(result_scr);
+    lv_label_set_text(label, text);
+    lv_obj_center(label);
+    lv_scr_load_anim(result_scr, LV_SCR_LOAD_ANIM_NONE, 0, 0, true);
+
+    lv_mem_free(text);
+}
+
+static void lv_demo_2dge_benchmark(void)
+{
+    lv_timer_t *timer = lv_timer_create(nu_bench_2dge, 500, NULL);
+
+    lv_timer_set_repeat_count(timer, 1);
+}
+#endif
+
 RT_WEAK void lv_user_gui_init(void)
 {
     /* display demo; you may replace with your LVGL application at here and disable related definitions. */
 
-#if LV_USE_DEMO_BENCHMARK
+#if LV_USE_DEMO_2DGE_BENCHMARK
+    lv_demo_2dge_benchmark();
+
+#elif LV_USE_DEMO_BENCHMARK
     extern void lv_demo_benchmark(void);
     lv_demo_benchmark();
 
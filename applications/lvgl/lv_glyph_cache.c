@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+/**
+ * @file lv_glyph_cache.c
+ *
+ * lv_draw_sw_letter decodes the glyph bitmap of the font, decompressing it for
+ * compressed fonts, and converts it to A8 pixel by pixel at every draw. Here the
+ * A8 bitmaps are kept in an atlas of LV_GLYPH_CACHE_SIZE bytes keyed by the font
+ * and the code point, a font object has a single size. The atlas is split into
+ * pages which are filled in turn, and the least recently used page is dropped
+ * as a whole when a new glyph doesn't fit. An unclipped letter is blended with
+ * its bitmap in the atlas as the mask.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_glyph_cache.h"
+
+#if LV_USE_GLYPH_CACHE
+
+#if defined(__RTTHREAD__)
+    #include <rtthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define NU_GLYPH_PAGE_NUM       (LV_GLYPH_CACHE_SIZE / LV_GLYPH_CACHE_PAGE_SIZE)
+#define NU_GLYPH_BUCKET_NUM     256
+
+#if (NU_GLYPH_PAGE_NUM < 1)
+    #error "LV_GLYPH_CACHE_SIZE must hold a page at least"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _nu_glyph_t
+{
+    const lv_font_t *font;
+    uint32_t letter;
+    struct _nu_glyph_t *next;   /* Next glyph of the bucket */
+    uint16_t w;
+    uint16_t h;
+    /* The A8 bitmap follows. */
+} nu_glyph_t;
+
+typedef struct
+{
+    uint32_t used;              /* Bytes of glyphs in the page */
+    uint32_t stamp;             /* Time of the last use */
+} nu_glyph_page_t;
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t *s_pu8Atlas = NULL;
+static bool s_bAtlasFailed = false;
+
+static nu_glyph_page_t s_asPages[NU_GLYPH_PAGE_NUM];
+static nu_glyph_t *s_apsBuckets[NU_GLYPH_BUCKET_NUM];
+
+static uint32_t s_u32FillPage = 0;
+static uint32_t s_u32Clock = 0;
+
+static lv_glyph_cache_stat_t s_sStat;
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static inline uint32_t nu_glyph_size(uint32_t w, uint32_t h)
+{
+    /* The next glyph follows, aligned for the pointers of its header. */
+    return (sizeof(nu_glyph_t) + w * h + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+}
+
+static inline uint8_t *nu_glyph_bitmap(nu_glyph_t *glyph)
+{
+    return (uint8_t *)(glyph + 1);
+}
+
+static inline uint32_t nu_glyph_page_of(const nu_glyph_t *glyph)
+{
+    return ((const uint8_t *)glyph - s_pu8Atlas) / LV_GLYPH_CACHE_PAGE_SIZE;
+}
+
+static inline nu_glyph_t **nu_glyph_bucket(const lv_font_t *font, uint32_t letter)
+{
+    uint32_t hash = (((uint32_t)(lv_uintptr_t)font >> 2) ^ letter) * 0x9E3779B1u;
+
+    return &s_apsBuckets[hash >> 24];
+}
+
+static nu_glyph_t *nu_glyph_find(const lv_font_t *font, uint32_t letter)
+{
+    nu_glyph_t *glyph = *nu_glyph_bucket(font, letter);
+
+    while (glyph != NULL)
+    {
+        if ((glyph->letter == letter) && (glyph->font == font))
+            return glyph;
+
+        glyph = glyph->next;
+    }
+
+    return NULL;
+}
+
+static void nu_glyph_page_evict(uint32_t page)
+{
+    uint8_t *base = s_pu8Atlas + page * LV_GLYPH_CACHE_PAGE_SIZE;
+    uint32_t off = 0;
+
+    if (s_asPages[page].used == 0)
+        return;
+
+    /* Unlink every glyph of the page from its bucket. */
+    while (off < s_asPages[page].used)
+    {
+        nu_glyph_t *glyph = (nu_glyph_t *)(base + off);
+        nu_glyph_t **pp = nu_glyph_bucket(glyph->font, glyph->letter);
+
+        while (*pp != glyph)
+            pp = &(*pp)->next;
+        *pp = glyph->next;
+
+        off += nu_glyph_size(glyph->w, glyph->h);
+    }
+
+    s_sStat.used -= s_asPages[page].used;
+    s_sStat.evictions++;
+    s_asPages[page].used = 0;
+}
+
+static nu_glyph_t *nu_glyph_alloc(uint32_t size)
+{
+    nu_glyph_page_t *page = &s_asPages[s_u32FillPage];
+    nu_glyph_t *glyph;
+    uint32_t i;
+
+    if (page->used + size > LV_GLYPH_CACHE_PAGE_SIZE)
+    {
+        /* Refill the least recently used page, an empty page is never used. */
+        s_u32FillPage = 0;
+        for (i = 1; i < NU_GLYPH_PAGE_NUM; i++)
+        {
+            if (s_asPages[i].stamp < s_asPages[s_u32FillPage].stamp)
+                s_u32FillPage = i;
+        }
+
+        nu_glyph_page_evict(s_u32FillPage);
+        page = &s_asPages[s_u32FillPage];
+    }
+
+    glyph = (nu_glyph_t *)(s_pu8Atlas + s_u32FillPage * LV_GLYPH_CACHE_PAGE_SIZE + page->used);
+    page->used += size;
+    page->stamp = ++s_u32Clock;
+    s_sStat.used += size;
+
+    return glyph;
+}
+
+/* Decode the glyph into the atlas as A8. */
+static nu_glyph_t *nu_glyph_load(const lv_font_glyph_dsc_t *g, uint32_t letter)
+{
+    uint32_t bpp = (g->bpp == 3) ? 4 : g->bpp;
+    uint32_t shade = 255 / ((1 << bpp) - 1);
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t i, n = g->box_w * g->box_h;
+    uint32_t bit = 0;
+    const uint8_t *map_p;
+    nu_glyph_t *glyph;
+    uint8_t *a8;
+
+    map_p = lv_font_get_glyph_bitmap(g->resolved_font, letter);
+    if (map_p == NULL)
+    {
+        LV_LOG_WARN("lv_glyph_cache: character's bitmap not found");
+        return NULL;
+    }
+
+    glyph = nu_glyph_alloc(nu_glyph_size(g->box_w, g->box_h));
+    glyph->font = g->resolved_font;
+    glyph->letter = letter;
+    glyph->w = g->box_w;
+    glyph->h = g->box_h;
+
+    /* The rows of the bitmap are packed without padding. */
+    a8 = nu_glyph_bitmap(glyph);
+    for (i = 0; i < n; i++, bit += bpp)
+        a8[i] = ((map_p[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask) * shade;
+
+    glyph->next = *nu_glyph_bucket(glyph->font, letter);
+    *nu_glyph_bucket(glyph->font, letter) = glyph;
+
+    return glyph;
+}
+
+/* The glyphs drawn the same way as lv_draw_sw_letter only */
+static bool nu_glyph_is_cacheable(const lv_font_glyph_dsc_t *g)
+{
+    if (g->resolved_font->subpx)
+        return false;
+
+    if ((g->bpp != 1) && (g->bpp != 2) && (g->bpp != 3) && (g->bpp != 4) && (g->bpp != 8))
+        return false;
+
+    return nu_glyph_size(g->box_w, g->box_h) <= LV_GLYPH_CACHE_PAGE_SIZE;
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_glyph_cache_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    draw_ctx->draw_letter = lv_glyph_cache_draw_letter;
+}
+
+void lv_glyph_cache_draw_letter(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos_p,
+                                uint32_t letter)
+{
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_area_t letter_area, blend_area;
+    lv_font_glyph_dsc_t g;
+    nu_glyph_t *glyph;
+    lv_opa_t opa = dsc->opa;
+    bool mask_any = false;
+
+    if (s_pu8Atlas == NULL && !s_bAtlasFailed)
+    {
+        s_pu8Atlas = lv_mem_alloc(LV_GLYPH_CACHE_SIZE);
+        s_bAtlasFailed = (s_pu8Atlas == NULL);
+        s_sStat.budget = s_bAtlasFailed ? 0 : LV_GLYPH_CACHE_SIZE;
+    }
+
+    /* Leave the missing, sub-pixel, image and huge glyphs to the software renderer. */
+    if ((s_pu8Atlas == NULL) || !lv_font_get_glyph_dsc(dsc->font, &g, letter, '\0') || !nu_glyph_is_cacheable(&g))
+    {
+        s_sStat.bypasses++;
+        lv_draw_sw_letter(draw_ctx, dsc, pos_p, letter);
+        return;
+    }
+
+    /*Don't draw anything if the character is empty. E.g. space*/
+    if ((g.box_h == 0) || (g.box_w == 0)) return;
+
+    letter_area.x1 = pos_p->x + g.ofs_x;
+    letter_area.y1 = pos_p->y + (dsc->font->line_height - dsc->font->base_line) - g.box_h - g.ofs_y;
+    letter_area.x2 = letter_area.x1 + g.box_w - 1;
+    letter_area.y2 = letter_area.y1 + g.box_h - 1;
+
+    /*If the letter is completely out of mask don't draw it*/
+    if (!_lv_area_intersect(&blend_area, &letter_area, draw_ctx->clip_area)) return;
+
+    glyph = nu_glyph_find(g.resolved_font, letter);
+    if (glyph != NULL)
+    {
+        s_sStat.hits++;
+        s_asPages[nu_glyph_page_of(glyph)].stamp = ++s_u32Clock;
+    }
+    else
+    {
+        s_sStat.misses++;
+        glyph = nu_glyph_load(&g, letter);
+        if (glyph == NULL)
+            return;
+    }
+
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.blend_area = &blend_area;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+#if LV_DRAW_COMPLEX
+    mask_any = lv_draw_mask_is_any(&blend_area);
+#endif
+
+    if ((opa >= LV_OPA_MAX) && !mask_any)
+    {
+        /* Blend with the bitmap in the atlas. */
+        blend_dsc.mask_buf = nu_glyph_bitmap(glyph);
+        blend_dsc.mask_area = &letter_area;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+    else
+    {
+        lv_coord_t blend_w = lv_area_get_width(&blend_area);
+        lv_coord_t x, y;
+        lv_opa_t *mask_buf = lv_mem_buf_get(lv_area_get_size(&blend_area));
+        lv_opa_t *dst = mask_buf;
+
+        for (y = blend_area.y1; y <= blend_area.y2; y++, dst += blend_w)
+        {
+            const lv_opa_t *src = nu_glyph_bitmap(glyph) + (y - letter_area.y1) * g.box_w + (blend_area.x1 - letter_area.x1);
+
+            /* Same as the opacity table of lv_draw_sw_letter */
+            if (opa < LV_OPA_MAX)
+            {
+                for (x = 0; x < blend_w; x++)
+                    dst[x] = (src[x] == LV_OPA_COVER) ? opa : ((src[x] * opa) >> 8);
+            }
+            else
+            {
+                lv_memcpy(dst, src, blend_w);
+            }
+
+#if LV_DRAW_COMPLEX
+            /*Apply masks if any*/
+            if (mask_any)
+            {
+                if (lv_draw_mask_apply(dst, blend_area.x1, y, blend_w) == LV_DRAW_MASK_RES_TRANSP)
+                    lv_memset_00(dst, blend_w);
+            }
+#endif
+        }
+
+        blend_dsc.mask_buf = mask_buf;
+        blend_dsc.mask_area = &blend_area;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        lv_mem_buf_release(mask_buf);
+    }
+}
+
+void lv_glyph_cache_flush(void)
+{
+    lv_memset_00(s_asPages, sizeof(s_asPages));
+    lv_memset_00(s_apsBuckets, sizeof(s_apsBuckets));
+    s_u32FillPage = 0;
+    s_u32Clock = 0;
+    s_sStat.used = 0;
+}
+
+void lv_glyph_cache_get_stat(lv_glyph_cache_stat_t *stat)
+{
+    *stat = s_sStat;
+}
+
+#if defined(__RTTHREAD__) && defined(RT_USING_FINSH)
+static void glyph_stat(void)
+{
+    lv_glyph_cache_stat_t stat;
+
+    lv_glyph_cache_get_stat(&stat);
+
+    rt_kprintf("hit: %d, miss: %d, evict: %d, bypass: %d\n", stat.hits, stat.misses, stat.evictions, stat.bypasses);
+    rt_kprintf("atlas: %d/%d bytes\n", stat.used, stat.budget);
+}
+MSH_CMD_EXPORT(glyph_stat, show glyph cache statistics);
+#endif
+
+#endif /* LV_USE_GLYPH_CACHE */
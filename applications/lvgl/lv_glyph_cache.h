@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_GLYPH_CACHE_H
+#define LV_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+#include "../sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Budget of the glyph atlas in bytes */
+#ifndef LV_GLYPH_CACHE_SIZE
+    #define LV_GLYPH_CACHE_SIZE         (64 * 1024)
+#endif
+
+/* The atlas is evicted by pages, a glyph larger than a page is not cached. */
+#ifndef LV_GLYPH_CACHE_PAGE_SIZE
+    #define LV_GLYPH_CACHE_PAGE_SIZE    (4 * 1024)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint32_t hits;          /* Drawn from the atlas */
+    uint32_t misses;        /* Decoded into the atlas */
+    uint32_t evictions;     /* Pages dropped from the atlas */
+    uint32_t bypasses;      /* Drawn by lv_draw_sw_letter */
+    uint32_t used;          /* Bytes of glyphs in the atlas */
+    uint32_t budget;        /* Bytes of the atlas */
+} lv_glyph_cache_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a software draw context which draws letters from the glyph atlas.
+ * @param drv       the display driver
+ * @param draw_ctx  the draw context to initialize
+ */
+void lv_glyph_cache_ctx_init(struct _lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx);
+
+/**
+ * Draw a letter, a replacement of lv_draw_sw_letter which keeps the A8 bitmap of the glyph in the atlas.
+ * @param draw_ctx  the draw context
+ * @param dsc       the label descriptor
+ * @param pos_p     left-top coordinate of the letter
+ * @param letter    the code point of the letter
+ */
+void lv_glyph_cache_draw_letter(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos_p,
+                                uint32_t letter);
+
+/**
+ * Drop every glyph of the atlas, e.g. before a font is freed.
+ */
+void lv_glyph_cache_flush(void);
+
+/**
+ * Get the statistics of the atlas.
+ * @param stat  store the statistics here
+ */
+void lv_glyph_cache_get_stat(lv_glyph_cache_stat_t *stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_GLYPH_CACHE_H*/
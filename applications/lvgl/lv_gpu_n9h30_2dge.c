@@ -6,6 +6,10 @@
  * Change Logs:
  * Date           Author       Notes
  * 2021-12-17     Wayne        The first version
+ * 2026-10-16     Wayne        Queue GE2D commands to overlap CPU rendering
+ * 2026-10-16     Wayne        Split unaligned edges, 32bpp, ROP blend modes and tuned threshold
+ * 2026-10-16     Wayne        Draw letters from the glyph atlas
+ * 2026-10-16     Wayne        Time cache maintenance and waiting in the profiler
  */
 /**
  * @file lv_gpu_n9h30_2dge.c
@@ -20,6 +24,8 @@
 #include "mmu.h"
 
 #include "lv_gpu_n9h30_2dge.h"
+#include "lv_glyph_cache.h"
+#include "lv_prof_n9h30.h"
 /*********************
  *      DEFINES
  *********************/
@@ -33,6 +39,15 @@
     #error "Can't use GPU with other formats"
 #endif
 
+/* Offload threshold before calibration, in pixels. */
+#define NU_2DGE_THRESHOLD_DEFAULT    7200
+
+/* Ticks to spend on each point of the cost model. */
+#define NU_2DGE_CALIBRATE_TICKS      (RT_TICK_PER_SECOND / 50)
+
+/* rop code: DSna, destination AND NOT source */
+#define NU_2DGE_ROP_DSNA             0x22
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -41,14 +56,39 @@
  *  STATIC PROTOTYPES
  **********************/
 
-static bool lv_draw_n9h30_2dge_blend_fill(lv_color_t *dest_buf, lv_coord_t dest_stride, const lv_area_t *fill_area, lv_color_t color);
+static bool lv_draw_n9h30_2dge_blend_fill(lv_color_t *dest_buf, lv_coord_t dest_stride, const lv_area_t *fill_area, lv_color_t color, int rop);
 
 static bool lv_draw_n9h30_2dge_blend_map(lv_color_t *dest_buf, const lv_area_t *dest_area, lv_coord_t dest_stride, const lv_color_t *src_buf, lv_coord_t src_stride, lv_opa_t opa);
 
+static void lv_draw_n9h30_2dge_buffer_copy(lv_draw_ctx_t *draw_ctx, void *dest_buf, lv_coord_t dest_stride, const lv_area_t *dest_area,
+        void *src_buf, lv_coord_t src_stride, const lv_area_t *src_area);
+
+static void lv_draw_n9h30_2dge_pending_add(uint32_t u32Start, uint32_t u32End);
+
+static void lv_draw_n9h30_2dge_sync(void);
+
+static void lv_draw_n9h30_2dge_sync_area(const lv_color_t *buf, lv_coord_t stride, const lv_area_t *area);
+
+static void lv_draw_n9h30_2dge_blend_sw(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc, const lv_area_t *area);
+
+static int lv_draw_n9h30_2dge_fill_rop(const lv_draw_sw_blend_dsc_t *dsc);
+
+static void lv_draw_n9h30_2dge_calibrate(void);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+/* Memory range still being written by the queued commands, aligned to cache line. */
+static uint32_t s_u32PendingStart, s_u32PendingEnd;
+
+/* Blends smaller than it are cheaper on the CPU, see lv_draw_n9h30_2dge_calibrate. */
+static uint32_t s_u32Threshold = NU_2DGE_THRESHOLD_DEFAULT;
+
+static bool s_bCalibrated = false;
+
+static bool s_bEnabled = true;
+
 /**********************
  *      MACROS
  **********************/
@@ -68,94 +108,164 @@ void lv_draw_n9h30_2dge_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
 
     ge2d_draw_ctx->blend = lv_draw_n9h30_2dge_blend;
     ge2d_draw_ctx->base_draw.wait_for_finish = lv_gpu_n9h30_2dge_wait_cb;
+    ge2d_draw_ctx->base_draw.buffer_copy = lv_draw_n9h30_2dge_buffer_copy;
+#if (LV_USE_GLYPH_CACHE==1)
+    ge2d_draw_ctx->base_draw.draw_letter = lv_glyph_cache_draw_letter;
+#endif
+
+    if (!s_bCalibrated)
+    {
+        lv_draw_n9h30_2dge_calibrate();
+        s_bCalibrated = true;
+    }
 }
 
 void lv_draw_n9h30_2dge_ctx_deinit(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
 {
     LV_UNUSED(drv);
     LV_UNUSED(draw_ctx);
+
+    lv_draw_n9h30_2dge_sync();
 }
 
 void lv_draw_n9h30_2dge_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
 {
-    lv_area_t blend_area;
-    bool bAlignedWord, done = false;
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    lv_area_t blend_area, core_area, edge_area;
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);  /*Width of the destination buffer*/
+    lv_coord_t src_stride = 0;
+    const lv_color_t *src_buf = NULL;
+    bool done = false;
+    int rop = SRCCOPY;
 
     if (!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
 
-#if (LV_COLOR_DEPTH == 16)
+    if (dsc->mask_buf && (dsc->mask_res == LV_DRAW_MASK_RES_TRANSP)) return;
 
-    uint32_t blend_area_stride = lv_area_get_width(&blend_area) * sizeof(lv_color_t);
-    /* Check Hardware constraint: The stride must be a word-alignment. */
-    bAlignedWord = ((blend_area_stride & 0x3) == 0) &&
-                   (((blend_area.x1 * sizeof(lv_color_t)) & 0x3) == 0) ? true : false;
+    /* Only a plain buffer of lv_color_t could be rendered by the engine. */
+    if (!s_bEnabled || (disp == NULL) || disp->driver->set_px_cb || disp->driver->screen_transp)
+        goto exit_blend;
 
-    LV_LOG_INFO("[%s] %d %d %d",     __func__, lv_area_get_size(&blend_area), (blend_area_stride & 0x3), (blend_area.x1 & 0x2));
+    /* A fully covering mask could be ignored. */
+    if (dsc->mask_buf && (dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER))
+        goto exit_blend;
 
-#else
+    if (dsc->src_buf)
+    {
+        if (dsc->blend_mode != LV_BLEND_MODE_NORMAL)
+            goto exit_blend;
 
-    bAlignedWord = false;
+        src_stride = lv_area_get_width(dsc->blend_area);  /*Width of the source buffer*/
+        src_buf = dsc->src_buf + (src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1));
+    }
+    else
+    {
+        rop = lv_draw_n9h30_2dge_fill_rop(dsc);
+        if (rop < 0)
+            goto exit_blend;
+    }
 
-#endif
+    core_area = blend_area;
+
+#if (LV_COLOR_DEPTH == 16)
+    /* Check Hardware constraint: The stride and the start of rows must be word-aligned. */
+    if ((dest_stride & 0x1) || (src_buf && (src_stride & 0x1)))
+        goto exit_blend;
 
+    /* Leave the odd pixels on both sides to the CPU. */
+    if ((blend_area.x1 - draw_ctx->buf_area->x1) & 0x1)
+        core_area.x1++;
+    if (((blend_area.x2 - draw_ctx->buf_area->x1) & 0x1) == 0)
+        core_area.x2--;
 
-    if ((lv_area_get_size(&blend_area) > 7200) &&
-            bAlignedWord &&
-            (dsc->mask_buf == NULL) &&
-            (dsc->blend_mode == LV_BLEND_MODE_NORMAL))
+    if (src_buf)
     {
-        lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);  /*Width of the destination buffer*/
+        src_buf += core_area.x1 - blend_area.x1;
+        if ((uint32_t)src_buf & 0x3)
+            goto exit_blend;
+    }
+#endif
 
-        /* Pointer to an image to blend. If set, color is ignored. If not set fill blend_area with color. */
-        if (dsc->src_buf)
-        {
+    if ((core_area.x2 < core_area.x1) || (lv_area_get_size(&core_area) < s_u32Threshold))
+        goto exit_blend;
 
-            lv_coord_t src_stride = lv_area_get_width(dsc->blend_area);  /*Width of the source buffer*/
-            lv_color_t *src_buf = (lv_color_t *)dsc->src_buf + (src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 -  dsc->blend_area->x1));
-            lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
+    LV_LOG_INFO("[%s] %d %d %d %d", __func__, lv_area_get_size(&blend_area), core_area.x1 - blend_area.x1, blend_area.x2 - core_area.x2, rop);
 
-            if (src_stride == lv_area_get_width(&blend_area))
-                done = lv_draw_n9h30_2dge_blend_map(draw_ctx->buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa);
-        }
-        else if (dsc->opa >= LV_OPA_MAX)
-        {
-            lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
-
-            done = lv_draw_n9h30_2dge_blend_fill(draw_ctx->buf, dest_stride, &blend_area, dsc->color);
-        }
+    /* Draw the edge strips before queuing the core, they may share cache lines with it. */
+    if (core_area.x1 != blend_area.x1)
+    {
+        edge_area = blend_area;
+        edge_area.x2 = core_area.x1 - 1;
+        lv_draw_n9h30_2dge_blend_sw(draw_ctx, dsc, &edge_area);
+    }
+    if (core_area.x2 != blend_area.x2)
+    {
+        edge_area = blend_area;
+        edge_area.x1 = core_area.x2 + 1;
+        lv_draw_n9h30_2dge_blend_sw(draw_ctx, dsc, &edge_area);
     }
 
+    lv_area_move(&core_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
+
+    /* Pointer to an image to blend. If set, color is ignored. If not set fill blend_area with color. */
+    if (src_buf)
+        done = lv_draw_n9h30_2dge_blend_map(draw_ctx->buf, &core_area, dest_stride, src_buf, src_stride, dsc->opa);
+    else
+        done = lv_draw_n9h30_2dge_blend_fill(draw_ctx->buf, dest_stride, &core_area, dsc->color, rop);
 
     if (!done)
     {
-        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        /* The edges are drawn already. */
+        lv_area_move(&core_area, draw_ctx->buf_area->x1, draw_ctx->buf_area->y1);
+        lv_draw_n9h30_2dge_blend_sw(draw_ctx, dsc, &core_area);
     }
+
+    return;
+
+exit_blend:
+
+    lv_draw_n9h30_2dge_blend_sw(draw_ctx, dsc, &blend_area);
+}
+
+/**
+ * Enable or disable the offloading at run time, for comparison.
+ */
+void lv_draw_n9h30_2dge_enable(bool en)
+{
+    lv_draw_n9h30_2dge_sync();
+
+    s_bEnabled = en;
+}
+
+/**
+ * Get the smallest blend in pixels which is offloaded to the engine.
+ */
+uint32_t lv_draw_n9h30_2dge_get_threshold(void)
+{
+    return s_u32Threshold;
 }
 
-static bool lv_draw_n9h30_2dge_blend_fill(lv_color_t *dest_buf, lv_coord_t dest_stride, const lv_area_t *fill_area, lv_color_t color)
+static bool lv_draw_n9h30_2dge_blend_fill(lv_color_t *dest_buf, lv_coord_t dest_stride, const lv_area_t *fill_area, lv_color_t color, int rop)
 {
     int32_t fill_area_w = lv_area_get_width(fill_area);
     int32_t fill_area_h = lv_area_get_height(fill_area);
-    lv_color_t *dest_buf_start = dest_buf + (fill_area->y1 * dest_stride);
+    uint32_t u32Start, u32End;
 
     LV_LOG_INFO("[%s] %d %d %08x color=%08x@%08x %d %d %dx%d", __func__, dest_stride, lv_area_get_size(fill_area), lv_color_to32(color),  color, dest_buf, fill_area->x1, fill_area->y1, fill_area_w, fill_area_h);
 
-    mmu_clean_invalidated_dcache((rt_uint32_t)dest_buf_start, sizeof(lv_color_t) * dest_stride * fill_area_h);
+    u32Start = RT_ALIGN_DOWN((uint32_t)(dest_buf + fill_area->y1 * dest_stride + fill_area->x1), CACHE_LINE_SIZE);
+    u32End = RT_ALIGN((uint32_t)(dest_buf + fill_area->y2 * dest_stride + fill_area->x2 + 1), CACHE_LINE_SIZE);
 
-    /*Hardware filling*/
-    // Enter GE2D ->
-    ge2dInit(LV_COLOR_DEPTH, dest_stride, fill_area_h, (void *)dest_buf);
+    /* Drop the cached lines, the engine writes the memory directly. */
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
+    mmu_clean_invalidated_dcache(u32Start, u32End - u32Start);
+    LV_PROF_N9H30_END();
 
-    ge2dClip_SetClip(fill_area->x1, fill_area->y1, fill_area->x2, fill_area->y2);
+    /*Hardware filling, it runs behind the CPU.*/
+    if (ge2dQueue_FillRop(dest_buf, dest_stride, LV_COLOR_DEPTH, fill_area->x1, fill_area->y1, fill_area_w, fill_area_h, color.full, rop) < 0)
+        return false;
 
-#if (LV_COLOR_DEPTH == 32)
-    ge2dFill_Solid(fill_area->x1, fill_area->y1, fill_area_w, fill_area_h, color.full);
-#elif (LV_COLOR_DEPTH == 16)
-    ge2dFill_Solid_RGB565(fill_area->x1, fill_area->y1, fill_area_w, fill_area_h, color.full);
-#endif
-
-    ge2dClip_SetClip(-1, 0, 0, 0);
-    // -> Leave GE2D
+    lv_draw_n9h30_2dge_pending_add(u32Start, u32End);
 
     return true;
 }
@@ -170,35 +280,233 @@ static bool lv_draw_n9h30_2dge_blend_map(lv_color_t *dest_buf, const lv_area_t *
     int32_t dest_y = dest_area->y1;
     const lv_color_t *dest_start_buf = dest_buf + (dest_y * dest_stride);
 
-    // Enter GE2D ->
-    ge2dInit(LV_COLOR_DEPTH, dest_stride, dest_h, (void *)dest_buf);
-
-    if (opa >= LV_OPA_MAX)
-    {
-        ge2dBitblt_SetAlphaMode(0, 0, 0);
-        ge2dBitblt_SetDrawMode(0, 0, 0);
-    }
-    else
-    {
-        ge2dBitblt_SetAlphaMode(1, opa, opa);
-    }
-
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
     mmu_clean_invalidated_dcache((rt_uint32_t)dest_start_buf, sizeof(lv_color_t) * dest_stride * dest_h);
     mmu_clean_dcache((rt_uint32_t)src_buf, sizeof(lv_color_t) * (src_stride * dest_h + dest_w));
+    LV_PROF_N9H30_END();
 
-    ge2dSpriteBlt_Screen(dest_x, dest_y, dest_w, dest_h, (void *)src_buf);
-    // -> Leave GE2D
+    if (ge2dQueue_SpriteBlt(dest_buf, dest_stride, LV_COLOR_DEPTH, dest_x, dest_y, dest_w, dest_h,
+                            (void *)src_buf, src_stride, (opa >= LV_OPA_MAX) ? 255 : opa) < 0)
+        return false;
+
+    /* The source is often a temporary buffer of the caller, it must be consumed before returning. */
+    lv_draw_n9h30_2dge_sync();
 
     return true;
 }
 
 
 
+/**
+ * Queue a copy of an area between two buffers of the same stride, it returns without waiting.
+ * The source must stay unchanged until the draw context waits for finishing.
+ */
+bool lv_draw_n9h30_2dge_copy(lv_color_t *dest_buf, const lv_color_t *src_buf, lv_coord_t stride, const lv_area_t *area)
+{
+    uint32_t u32Start, u32End;
+    const lv_color_t *src_start_buf = src_buf + (area->y1 * stride + area->x1);
+
+    u32Start = RT_ALIGN_DOWN((uint32_t)(dest_buf + area->y1 * stride + area->x1), CACHE_LINE_SIZE);
+    u32End = RT_ALIGN((uint32_t)(dest_buf + area->y2 * stride + area->x2 + 1), CACHE_LINE_SIZE);
+
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
+    mmu_clean_invalidated_dcache(u32Start, u32End - u32Start);
+    LV_PROF_N9H30_END();
+
+    if (ge2dQueue_SpriteBlt(dest_buf, stride, LV_COLOR_DEPTH, area->x1, area->y1,
+                            lv_area_get_width(area), lv_area_get_height(area),
+                            (void *)src_start_buf, stride, 255) < 0)
+        return false;
+
+    lv_draw_n9h30_2dge_pending_add(u32Start, u32End);
+
+    return true;
+}
+
 void lv_gpu_n9h30_2dge_wait_cb(lv_draw_ctx_t *draw_ctx)
 {
+    lv_draw_n9h30_2dge_sync();
+
     lv_draw_sw_wait_for_finish(draw_ctx);
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void lv_draw_n9h30_2dge_buffer_copy(lv_draw_ctx_t *draw_ctx, void *dest_buf, lv_coord_t dest_stride, const lv_area_t *dest_area,
+        void *src_buf, lv_coord_t src_stride, const lv_area_t *src_area)
+{
+    lv_draw_n9h30_2dge_sync();
+
+    lv_draw_sw_buffer_copy(draw_ctx, dest_buf, dest_stride, dest_area, src_buf, src_stride, src_area);
+}
+
+static void lv_draw_n9h30_2dge_pending_add(uint32_t u32Start, uint32_t u32End)
+{
+    if (s_u32PendingStart == s_u32PendingEnd)
+    {
+        s_u32PendingStart = u32Start;
+        s_u32PendingEnd = u32End;
+    }
+    else
+    {
+        s_u32PendingStart = LV_MIN(s_u32PendingStart, u32Start);
+        s_u32PendingEnd = LV_MAX(s_u32PendingEnd, u32End);
+    }
+}
+
+static void lv_draw_n9h30_2dge_sync(void)
+{
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_GE_WAIT);
+    ge2dQueue_Sync();
+    LV_PROF_N9H30_END();
+
+    s_u32PendingStart = s_u32PendingEnd = 0;
+}
+
+static void lv_draw_n9h30_2dge_sync_area(const lv_color_t *buf, lv_coord_t stride, const lv_area_t *area)
+{
+    uint32_t u32Start, u32End;
+
+    if (s_u32PendingStart == s_u32PendingEnd)
+        return;
+
+    if (ge2dQueue_IsIdle())
+    {
+        s_u32PendingStart = s_u32PendingEnd = 0;
+        return;
+    }
+
+    u32Start = RT_ALIGN_DOWN((uint32_t)(buf + area->y1 * stride + area->x1), CACHE_LINE_SIZE);
+    u32End = RT_ALIGN((uint32_t)(buf + area->y2 * stride + area->x2 + 1), CACHE_LINE_SIZE);
+
+    if ((u32Start < s_u32PendingEnd) && (s_u32PendingStart < u32End))
+        lv_draw_n9h30_2dge_sync();
+}
+
+static void lv_draw_n9h30_2dge_blend_sw(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc, const lv_area_t *area)
+{
+    const lv_area_t *clip_area = draw_ctx->clip_area;
+    lv_area_t sync_area = *area;
+
+    /* The CPU must not touch the lines which the engine is still writing. */
+    lv_area_move(&sync_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
+    lv_draw_n9h30_2dge_sync_area(draw_ctx->buf, lv_area_get_width(draw_ctx->buf_area), &sync_area);
+
+    /* Clip the software blending to the area. */
+    draw_ctx->clip_area = area;
+    lv_draw_sw_blend_basic(draw_ctx, dsc);
+    draw_ctx->clip_area = clip_area;
+}
+
+static bool lv_draw_n9h30_2dge_color_is_saturated(lv_color_t color)
+{
+    lv_color_t white = lv_color_white();
+
+    return ((LV_COLOR_GET_R(color) == 0) || (LV_COLOR_GET_R(color) == LV_COLOR_GET_R(white))) &&
+           ((LV_COLOR_GET_G(color) == 0) || (LV_COLOR_GET_G(color) == LV_COLOR_GET_G(white))) &&
+           ((LV_COLOR_GET_B(color) == 0) || (LV_COLOR_GET_B(color) == LV_COLOR_GET_B(white)));
+}
+
+/* Map the blend mode of a fill to a ROP code, or -1 if the engine can't do it exactly. */
+static int lv_draw_n9h30_2dge_fill_rop(const lv_draw_sw_blend_dsc_t *dsc)
+{
+    if (dsc->opa < LV_OPA_MAX)
+        return -1;
+
+    if (dsc->blend_mode == LV_BLEND_MODE_NORMAL)
+        return SRCCOPY;
+
+    /* With every channel either 0 or full, saturating arithmetic turns into bitwise operations. */
+    if (!lv_draw_n9h30_2dge_color_is_saturated(dsc->color))
+        return -1;
+
+    switch (dsc->blend_mode)
+    {
+    case LV_BLEND_MODE_ADDITIVE:
+        return SRCPAINT;            /* min(D + S, max) == D | S */
+    case LV_BLEND_MODE_SUBTRACTIVE:
+        return NU_2DGE_ROP_DSNA;    /* max(D - S, 0) == D & ~S */
+    case LV_BLEND_MODE_MULTIPLY:
+        return SRCAND;              /* D * S / max == D & S */
+    default:
+        break;
+    }
+
+    return -1;
+}
+
+/* Nanoseconds per fill of w x h pixels on the engine or the CPU. */
+static uint32_t lv_draw_n9h30_2dge_measure(lv_color_t *buf, lv_coord_t stride, lv_coord_t w, lv_coord_t h, bool hw)
+{
+    lv_area_t area = {0, 0, w - 1, h - 1};
+    lv_color_t color = lv_color_hex(0x5A5A5A);
+    rt_tick_t start, elapsed;
+    uint32_t n = 0;
+    lv_coord_t y;
+
+    /* Start at a tick boundary. */
+    start = rt_tick_get();
+    while (rt_tick_get() == start);
+    start = rt_tick_get();
+
+    do
+    {
+        if (hw)
+        {
+            lv_draw_n9h30_2dge_blend_fill(buf, stride, &area, color, SRCCOPY);
+            lv_draw_n9h30_2dge_sync();
+        }
+        else
+        {
+            for (y = 0; y < h; y++)
+                lv_color_fill(buf + y * stride, color, w);
+        }
+        n++;
+        elapsed = rt_tick_get() - start;
+    }
+    while (elapsed < NU_2DGE_CALIBRATE_TICKS);
+
+    return (uint32_t)((uint64_t)elapsed * (1000000000 / RT_TICK_PER_SECOND) / n);
+}
+
+/*
+ * Fit t = a + b * n for both of the engine and the CPU with a small and a large fill,
+ * the engine wins when n > (a_hw - a_sw) / (b_sw - b_hw).
+ */
+static void lv_draw_n9h30_2dge_calibrate(void)
+{
+    const lv_coord_t stride = 128, w[2] = {16, 128}, h[2] = {16, 64};
+    int64_t t_hw[2], t_sw[2], n[2], b_hw, b_sw, a_hw, a_sw;
+    lv_color_t *buf;
+    int i;
+
+    buf = rt_malloc_align(stride * h[1] * sizeof(lv_color_t), CACHE_LINE_SIZE);
+    if (buf == RT_NULL)
+        return;
+
+    for (i = 0; i < 2; i++)
+    {
+        n[i] = w[i] * h[i];
+        t_hw[i] = lv_draw_n9h30_2dge_measure(buf, stride, w[i], h[i], true);
+        t_sw[i] = lv_draw_n9h30_2dge_measure(buf, stride, w[i], h[i], false);
+    }
+
+    rt_free_align(buf);
+
+    b_hw = (t_hw[1] - t_hw[0]) * 1024 / (n[1] - n[0]);
+    b_sw = (t_sw[1] - t_sw[0]) * 1024 / (n[1] - n[0]);
+    a_hw = t_hw[0] * 1024 - b_hw * n[0];
+    a_sw = t_sw[0] * 1024 - b_sw * n[0];
+
+    if (b_sw <= b_hw)
+        s_u32Threshold = UINT32_MAX;    /* The CPU is never slower. */
+    else if (a_hw <= a_sw)
+        s_u32Threshold = 0;
+    else
+        s_u32Threshold = (uint32_t)((a_hw - a_sw) / (b_sw - b_hw));
+
+    LV_LOG_USER("2DGE %d/%dns, CPU %d/%dns for %d/%d pixels, offload threshold: %d pixels",
+                (int)t_hw[0], (int)t_hw[1], (int)t_sw[0], (int)t_sw[1], (int)n[0], (int)n[1], s_u32Threshold);
+}
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2022-3-29      Wayne        The first version
+ * 2026-10-16     Wayne        Add lv_draw_n9h30_2dge_copy
+ * 2026-10-16     Wayne        Add lv_draw_n9h30_2dge_enable and threshold query
  */
 #ifndef LV_GPU_N9H30_2DGE_H
 #define LV_GPU_N9H30_2DGE_H
@@ -46,6 +48,12 @@ void lv_draw_n9h30_2dge_ctx_deinit(struct _lv_disp_drv_t *drv, lv_draw_ctx_t *dr
 
 void lv_draw_n9h30_2dge_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
 
+void lv_draw_n9h30_2dge_enable(bool en);
+
+uint32_t lv_draw_n9h30_2dge_get_threshold(void);
+
+bool lv_draw_n9h30_2dge_copy(lv_color_t *dest_buf, const lv_color_t *src_buf, lv_coord_t stride, const lv_area_t *area);
+
 void lv_gpu_n9h30_2dge_wait_cb(lv_draw_ctx_t *draw_ctx);
 
 /**********************
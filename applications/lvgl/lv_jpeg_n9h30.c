@@ -0,0 +1,724 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+/**
+ * @file lv_jpeg_n9h30.c
+ *
+ * An image decoder of baseline JPEG files (*.jpg, *.jpeg) and of JPEG streams in
+ * memory described by lv_jpeg_n9h30_dsc_init(). The image is decoded by the JPEG
+ * engine in packet RGB mode straight at the size of the source descriptor, with
+ * the down-scaler when it is smaller than the JPEG. tjpgd takes over when the
+ * engine can't be used or fails. The decoded images are kept in a size-bounded
+ * LRU cache, an image is dropped from it only after its last session is closed.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_jpeg_n9h30.h"
+#include "src/misc/lv_lru.h"
+
+#if LV_USE_JPEG_N9H30
+
+#if defined(__RTTHREAD__)
+    #include <rtthread.h>
+#endif
+
+#if LV_JPEG_N9H30_USE_HW
+    #include "NuMicro.h"
+    #include "nu_jpegcodec.h"
+    #include "mmu.h"
+#endif
+
+#if LV_USE_SJPG
+    #include "src/extra/libs/sjpg/tjpgd.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_JPEG_N9H30_USE_HW
+    /* The engine writes the buffer behind the data cache. */
+    #define NU_JPEG_MALLOC(size)    rt_malloc_align(RT_ALIGN(size, CACHE_LINE_SIZE), CACHE_LINE_SIZE)
+    #define NU_JPEG_FREE(ptr)       rt_free_align(ptr)
+#else
+    #define NU_JPEG_MALLOC(size)    lv_mem_alloc(size)
+    #define NU_JPEG_FREE(ptr)       lv_mem_free(ptr)
+#endif
+
+/* Expected size of a decoded image, it sizes the hash table of the cache. */
+#define NU_JPEG_AVG_SIZE            (32 * 1024)
+
+#define NU_JPEG_TJPGD_WORK_SIZE     4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint32_t ref;           /* Opened sessions */
+    bool cached;            /* Owned by the cache */
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_color_t *data;
+} nu_jpeg_entry_t;
+
+/* Leading part of the cache key, a file name follows for a file source. */
+typedef struct
+{
+    uint32_t src_type;
+    lv_coord_t w;
+    lv_coord_t h;
+    const void *data;
+    uint32_t data_size;
+} nu_jpeg_key_t;
+
+/* Reader of a JPEG stream in memory or in a file */
+typedef struct
+{
+    const uint8_t *buf;
+    uint32_t size;
+    lv_fs_file_t *file;
+} nu_jpeg_reader_t;
+
+#if LV_USE_SJPG
+typedef struct
+{
+    const uint8_t *bs;
+    uint32_t size;
+    uint32_t pos;
+    lv_color_t *out;
+    lv_coord_t pitch;
+} nu_jpeg_sw_io_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t nu_jpeg_decoder_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header);
+static lv_res_t nu_jpeg_decoder_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc);
+static void nu_jpeg_decoder_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_lru_t *s_psCache = NULL;
+
+static lv_jpeg_n9h30_stat_t s_sStat;
+
+#if LV_JPEG_N9H30_USE_HW
+    static bool s_bHwReady = false;
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static void nu_jpeg_entry_free(nu_jpeg_entry_t *entry)
+{
+    NU_JPEG_FREE(entry->data);
+    lv_mem_free(entry);
+}
+
+/* Value destructor of the cache, the entry stays alive until the last session is closed. */
+static void nu_jpeg_entry_evict(void *v)
+{
+    nu_jpeg_entry_t *entry = (nu_jpeg_entry_t *)v;
+
+    entry->cached = false;
+    s_sStat.evictions++;
+
+    if (entry->ref == 0)
+        nu_jpeg_entry_free(entry);
+}
+
+static bool nu_jpeg_read(const nu_jpeg_reader_t *rd, uint32_t pos, uint8_t *buf, uint32_t len)
+{
+    uint32_t rn;
+
+    if (rd->file == NULL)
+    {
+        if ((pos > rd->size) || (len > rd->size - pos))
+            return false;
+
+        lv_memcpy(buf, rd->buf + pos, len);
+        return true;
+    }
+
+    if (lv_fs_seek(rd->file, pos, LV_FS_SEEK_SET) != LV_FS_RES_OK)
+        return false;
+
+    return (lv_fs_read(rd->file, buf, len, &rn) == LV_FS_RES_OK) && (rn == len);
+}
+
+/* Walk the markers to the frame header, only baseline JPEG is accepted. */
+static bool nu_jpeg_parse(const nu_jpeg_reader_t *rd, uint16_t *pu16Width, uint16_t *pu16Height)
+{
+    uint32_t pos = 2;
+    uint8_t buf[9];
+
+    if (!nu_jpeg_read(rd, 0, buf, 2) || (buf[0] != 0xFF) || (buf[1] != 0xD8))
+        return false;
+
+    while (nu_jpeg_read(rd, pos, buf, 4))
+    {
+        uint8_t marker = buf[1];
+
+        if (buf[0] != 0xFF)
+            return false;
+
+        /* Fill byte */
+        if (marker == 0xFF)
+        {
+            pos++;
+            continue;
+        }
+
+        /* SOF0 and SOF1 */
+        if ((marker == 0xC0) || (marker == 0xC1))
+        {
+            if (!nu_jpeg_read(rd, pos, buf, 9))
+                return false;
+
+            *pu16Height = (buf[5] << 8) | buf[6];
+            *pu16Width = (buf[7] << 8) | buf[8];
+
+            return (*pu16Width != 0) && (*pu16Height != 0);
+        }
+
+        /* Progressive, lossless, arithmetic coding, or no frame before the scan */
+        if (((marker >= 0xC2) && (marker <= 0xCF) && (marker != 0xC4) && (marker != 0xC8) && (marker != 0xCC)) ||
+                (marker == 0xDA) || (marker == 0xD9))
+            return false;
+
+        pos += 2 + ((buf[2] << 8) | buf[3]);
+    }
+
+    return false;
+}
+
+static bool nu_jpeg_is_file(const char *fn)
+{
+    const char *ext = lv_fs_get_ext(fn);
+
+    return (strcmp(ext, "jpg") == 0) || (strcmp(ext, "JPG") == 0) ||
+           (strcmp(ext, "jpeg") == 0) || (strcmp(ext, "JPEG") == 0);
+}
+
+/* Nearest-neighbour resize, the source is freed. */
+static lv_color_t *nu_jpeg_resize(lv_color_t *src, lv_coord_t sw, lv_coord_t sh, lv_coord_t dw, lv_coord_t dh)
+{
+    uint32_t x_step = ((uint32_t)sw << 16) / dw;
+    uint32_t y_step = ((uint32_t)sh << 16) / dh;
+    uint32_t sy = y_step / 2;
+    lv_color_t *dst, *d;
+    lv_coord_t x, y;
+
+    if ((sw == dw) && (sh == dh))
+        return src;
+
+    dst = NU_JPEG_MALLOC(dw * dh * sizeof(lv_color_t));
+    if (dst != NULL)
+    {
+        d = dst;
+        for (y = 0; y < dh; y++, sy += y_step)
+        {
+            const lv_color_t *row = src + (sy >> 16) * sw;
+            uint32_t sx = x_step / 2;
+
+            for (x = 0; x < dw; x++, sx += x_step)
+                *d++ = row[sx >> 16];
+        }
+    }
+
+    NU_JPEG_FREE(src);
+
+    return dst;
+}
+
+#if LV_JPEG_N9H30_USE_HW
+static lv_color_t *nu_jpeg_hw_decode(const uint8_t *bs, uint32_t bs_size, uint16_t u16Width, uint16_t u16Height,
+                                     lv_coord_t w, lv_coord_t h)
+{
+    bool bScale = (w <= u16Width) && (h <= u16Height) && ((w != u16Width) || (h != u16Height));
+    lv_coord_t out_w = bScale ? w : u16Width;
+    lv_coord_t out_h = bScale ? h : u16Height;
+    /* Without scaling, the engine writes whole MCUs. */
+    lv_coord_t pitch = bScale ? w : RT_ALIGN(u16Width, 32);
+    lv_coord_t rows = RT_ALIGN(out_h, 16);
+    uint32_t u32OutSize = RT_ALIGN(pitch * rows * sizeof(lv_color_t), CACHE_LINE_SIZE);
+    lv_color_t *out;
+    lv_coord_t y;
+    INT ret;
+
+    if (!s_bHwReady)
+        return NULL;
+
+    out = NU_JPEG_MALLOC(u32OutSize);
+    if (out == NULL)
+        return NULL;
+
+    mmu_clean_dcache((uint32_t)bs, bs_size);
+    mmu_clean_invalidated_dcache((uint32_t)out, u32OutSize);
+
+    jpegInit();
+#if (LV_COLOR_DEPTH == 16)
+    jpegIoctl(JPEG_IOCTL_SET_DECODE_MODE, JPEG_DEC_PRIMARY_PACKET_RGB565, 0);
+#else
+    jpegIoctl(JPEG_IOCTL_SET_DECODE_MODE, JPEG_DEC_PRIMARY_PACKET_RGB888, 0);
+#endif
+    jpegIoctl(JPEG_IOCTL_SET_BITSTREAM_ADDR, (UINT32)bs, 0);
+    jpegIoctl(JPEG_IOCTL_SET_YADDR, (UINT32)out, 0);
+
+    if (bScale)
+        jpegIoctl(JPEG_IOCTL_SET_DECODE_DOWNSCALE, out_h, out_w);
+    else
+        jpegIoctl(JPEG_IOCTL_SET_DECODE_STRIDE, pitch, 0);
+
+    jpegIoctl(JPEG_IOCTL_DECODE_TRIGGER, 0, 0);
+    ret = jpegWait();
+
+    mmu_invalidate_dcache((uint32_t)out, u32OutSize);
+
+    if (ret != E_SUCCESS)
+    {
+        LV_LOG_WARN("JPEG engine failed to decode %dx%d", u16Width, u16Height);
+        NU_JPEG_FREE(out);
+        return NULL;
+    }
+
+    /* Pack the rows. */
+    if (pitch != out_w)
+    {
+        for (y = 1; y < out_h; y++)
+            lv_memcpy(out + y * out_w, out + y * pitch, out_w * sizeof(lv_color_t));
+    }
+
+#if (LV_COLOR_DEPTH == 32)
+    {
+        /* The pixel count does not fit lv_coord_t. */
+        uint32_t i;
+
+        for (i = 0; i < (uint32_t)out_w * out_h; i++)
+            out[i].ch.alpha = 0xFF;
+    }
+#endif
+
+    s_sStat.hw_decodes++;
+
+    return nu_jpeg_resize(out, out_w, out_h, w, h);
+}
+#endif /* LV_JPEG_N9H30_USE_HW */
+
+#if LV_USE_SJPG
+static size_t nu_jpeg_sw_input(JDEC *jd, uint8_t *buff, size_t ndata)
+{
+    nu_jpeg_sw_io_t *io = (nu_jpeg_sw_io_t *)jd->device;
+
+    if (ndata > io->size - io->pos)
+        ndata = io->size - io->pos;
+
+    if (buff)
+        lv_memcpy(buff, io->bs + io->pos, ndata);
+
+    io->pos += ndata;
+
+    return ndata;
+}
+
+static int nu_jpeg_sw_output(JDEC *jd, void *data, JRECT *rect)
+{
+    nu_jpeg_sw_io_t *io = (nu_jpeg_sw_io_t *)jd->device;
+    const uint8_t *rgb = (const uint8_t *)data;
+    int x, y;
+
+    for (y = rect->top; y <= rect->bottom; y++)
+    {
+        lv_color_t *d = io->out + y * io->pitch + rect->left;
+
+        for (x = rect->left; x <= rect->right; x++, rgb += 3)
+            *d++ = lv_color_make(rgb[0], rgb[1], rgb[2]);
+    }
+
+    return 1;
+}
+
+static lv_color_t *nu_jpeg_sw_decode(const uint8_t *bs, uint32_t bs_size, lv_coord_t w, lv_coord_t h)
+{
+    nu_jpeg_sw_io_t io = { .bs = bs, .size = bs_size };
+    lv_color_t *out = NULL;
+    uint8_t scale = 0;
+    lv_coord_t out_w, out_h;
+    void *work;
+    JDEC jd;
+
+    work = lv_mem_alloc(NU_JPEG_TJPGD_WORK_SIZE);
+    if (work == NULL)
+        return NULL;
+
+    if (jd_prepare(&jd, nu_jpeg_sw_input, work, NU_JPEG_TJPGD_WORK_SIZE, &io) != JDR_OK)
+        goto exit_sw_decode;
+
+    /* Descale by tjpgd as far as it stays larger than the target. */
+    while ((scale < 3) && ((jd.width >> (scale + 1)) >= w) && ((jd.height >> (scale + 1)) >= h))
+        scale++;
+
+    out_w = jd.width >> scale;
+    out_h = jd.height >> scale;
+
+    out = NU_JPEG_MALLOC(out_w * out_h * sizeof(lv_color_t));
+    if (out == NULL)
+        goto exit_sw_decode;
+
+    io.out = out;
+    io.pitch = out_w;
+
+    if (jd_decomp(&jd, nu_jpeg_sw_output, scale) != JDR_OK)
+    {
+        NU_JPEG_FREE(out);
+        out = NULL;
+        goto exit_sw_decode;
+    }
+
+    s_sStat.sw_decodes++;
+
+    out = nu_jpeg_resize(out, out_w, out_h, w, h);
+
+exit_sw_decode:
+
+    lv_mem_free(work);
+
+    return out;
+}
+#endif /* LV_USE_SJPG */
+
+static lv_res_t nu_jpeg_decoder_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    nu_jpeg_reader_t rd = {0};
+    lv_fs_file_t file;
+    uint16_t u16Width, u16Height;
+    bool bJpeg;
+
+    LV_UNUSED(decoder);
+
+    if (src_type == LV_IMG_SRC_VARIABLE)
+    {
+        const lv_img_dsc_t *img_dsc = (const lv_img_dsc_t *)src;
+
+        if (img_dsc->header.cf != LV_IMG_CF_RAW)
+            return LV_RES_INV;
+
+        rd.buf = img_dsc->data;
+        rd.size = img_dsc->data_size;
+        if (!nu_jpeg_parse(&rd, &u16Width, &u16Height))
+            return LV_RES_INV;
+
+        /* Decode at the size of the descriptor. */
+        header->w = img_dsc->header.w ? img_dsc->header.w : u16Width;
+        header->h = img_dsc->header.h ? img_dsc->header.h : u16Height;
+    }
+    else if (src_type == LV_IMG_SRC_FILE)
+    {
+        if (!nu_jpeg_is_file((const char *)src))
+            return LV_RES_INV;
+
+        if (lv_fs_open(&file, (const char *)src, LV_FS_MODE_RD) != LV_FS_RES_OK)
+            return LV_RES_INV;
+
+        rd.file = &file;
+        bJpeg = nu_jpeg_parse(&rd, &u16Width, &u16Height);
+        lv_fs_close(&file);
+
+        if (!bJpeg)
+            return LV_RES_INV;
+
+        header->w = u16Width;
+        header->h = u16Height;
+    }
+    else
+    {
+        return LV_RES_INV;
+    }
+
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+
+    return LV_RES_OK;
+}
+
+/* Load the whole stream of a file. */
+static uint8_t *nu_jpeg_load_file(const char *fn, uint32_t *pu32Size)
+{
+    lv_fs_file_t file;
+    uint8_t *bs = NULL;
+    uint32_t size, rn;
+
+    if (lv_fs_open(&file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK)
+        return NULL;
+
+    if ((lv_fs_seek(&file, 0, LV_FS_SEEK_END) != LV_FS_RES_OK) ||
+            (lv_fs_tell(&file, &size) != LV_FS_RES_OK) || (size == 0) ||
+            (lv_fs_seek(&file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK))
+        goto exit_load_file;
+
+    bs = NU_JPEG_MALLOC(size);
+    if (bs == NULL)
+        goto exit_load_file;
+
+    if ((lv_fs_read(&file, bs, size, &rn) != LV_FS_RES_OK) || (rn != size))
+    {
+        NU_JPEG_FREE(bs);
+        bs = NULL;
+        goto exit_load_file;
+    }
+
+    *pu32Size = size;
+
+exit_load_file:
+
+    lv_fs_close(&file);
+
+    return bs;
+}
+
+static lv_color_t *nu_jpeg_decode(lv_img_decoder_dsc_t *dsc)
+{
+    nu_jpeg_reader_t rd = {0};
+    const uint8_t *bs = NULL;
+    uint8_t *bs_copy = NULL;
+    uint32_t bs_size = 0;
+    lv_color_t *out = NULL;
+    uint16_t u16Width, u16Height;
+
+    if (dsc->src_type == LV_IMG_SRC_FILE)
+    {
+        bs = bs_copy = nu_jpeg_load_file((const char *)dsc->src, &bs_size);
+    }
+    else
+    {
+        const lv_img_dsc_t *img_dsc = (const lv_img_dsc_t *)dsc->src;
+
+        bs = img_dsc->data;
+        bs_size = img_dsc->data_size;
+
+#if LV_JPEG_N9H30_USE_HW
+        /* The engine reads the stream by words. */
+        if ((uint32_t)bs & 0x3)
+        {
+            bs_copy = NU_JPEG_MALLOC(bs_size);
+            if (bs_copy != NULL)
+                lv_memcpy(bs_copy, bs, bs_size);
+            bs = bs_copy;
+        }
+#endif
+    }
+
+    if (bs == NULL)
+        return NULL;
+
+    rd.buf = bs;
+    rd.size = bs_size;
+    if (!nu_jpeg_parse(&rd, &u16Width, &u16Height))
+        goto exit_decode;
+
+#if LV_JPEG_N9H30_USE_HW
+    out = nu_jpeg_hw_decode(bs, bs_size, u16Width, u16Height, dsc->header.w, dsc->header.h);
+#endif
+
+#if LV_USE_SJPG
+    if (out == NULL)
+        out = nu_jpeg_sw_decode(bs, bs_size, dsc->header.w, dsc->header.h);
+#endif
+
+exit_decode:
+
+    if (bs_copy != NULL)
+        NU_JPEG_FREE(bs_copy);
+
+    return out;
+}
+
+/* The key is the source and the decoded size. */
+static void *nu_jpeg_key(const lv_img_decoder_dsc_t *dsc, size_t *key_size)
+{
+    nu_jpeg_key_t *key;
+    size_t fn_len = 0;
+
+    if (dsc->src_type == LV_IMG_SRC_FILE)
+        fn_len = strlen((const char *)dsc->src);
+
+    *key_size = sizeof(nu_jpeg_key_t) + fn_len;
+
+    key = lv_mem_alloc(*key_size);
+    if (key == NULL)
+        return NULL;
+
+    /* Clear the padding, the key is compared as bytes. */
+    lv_memset_00(key, sizeof(nu_jpeg_key_t));
+    key->src_type = dsc->src_type;
+    key->w = dsc->header.w;
+    key->h = dsc->header.h;
+
+    if (dsc->src_type == LV_IMG_SRC_FILE)
+    {
+        lv_memcpy(key + 1, dsc->src, fn_len);
+    }
+    else
+    {
+        key->data = ((const lv_img_dsc_t *)dsc->src)->data;
+        key->data_size = ((const lv_img_dsc_t *)dsc->src)->data_size;
+    }
+
+    return key;
+}
+
+static lv_res_t nu_jpeg_decoder_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    nu_jpeg_entry_t *entry = NULL;
+    size_t key_size;
+    void *key;
+
+    LV_UNUSED(decoder);
+
+    key = nu_jpeg_key(dsc, &key_size);
+    if (key == NULL)
+        return LV_RES_INV;
+
+    if (s_psCache != NULL)
+        lv_lru_get(s_psCache, key, key_size, (void **)&entry);
+
+    if (entry != NULL)
+    {
+        s_sStat.hits++;
+    }
+    else
+    {
+        s_sStat.misses++;
+
+        entry = lv_mem_alloc(sizeof(nu_jpeg_entry_t));
+        if (entry == NULL)
+            goto exit_open;
+
+        lv_memset_00(entry, sizeof(nu_jpeg_entry_t));
+        entry->w = dsc->header.w;
+        entry->h = dsc->header.h;
+        entry->data = nu_jpeg_decode(dsc);
+        if (entry->data == NULL)
+        {
+            s_sStat.failures++;
+            lv_mem_free(entry);
+            entry = NULL;
+            goto exit_open;
+        }
+
+        /* An image larger than the budget is only kept while it is opened. */
+        if ((s_psCache != NULL) &&
+                (lv_lru_set(s_psCache, key, key_size, entry, entry->w * entry->h * sizeof(lv_color_t)) == LV_LRU_OK))
+            entry->cached = true;
+    }
+
+    entry->ref++;
+    dsc->user_data = entry;
+    dsc->img_data = (const uint8_t *)entry->data;
+
+exit_open:
+
+    lv_mem_free(key);
+
+    return (entry != NULL) ? LV_RES_OK : LV_RES_INV;
+}
+
+static void nu_jpeg_decoder_close(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    nu_jpeg_entry_t *entry = (nu_jpeg_entry_t *)dsc->user_data;
+
+    LV_UNUSED(decoder);
+
+    if (entry == NULL)
+        return;
+
+    entry->ref--;
+    if ((entry->ref == 0) && !entry->cached)
+        nu_jpeg_entry_free(entry);
+
+    dsc->user_data = NULL;
+    dsc->img_data = NULL;
+}
+
+static lv_lru_t *nu_jpeg_cache_create(void)
+{
+    return lv_lru_create(LV_JPEG_N9H30_CACHE_SIZE, LV_MIN(LV_JPEG_N9H30_CACHE_SIZE, NU_JPEG_AVG_SIZE),
+                         nu_jpeg_entry_evict, NULL);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_jpeg_n9h30_init(void)
+{
+    lv_img_decoder_t *dec;
+
+#if LV_JPEG_N9H30_USE_HW
+    s_bHwReady = (jpegOpen() == E_SUCCESS);
+    if (!s_bHwReady)
+        LV_LOG_WARN("JPEG engine is not available, decode by software.");
+#endif
+
+    s_psCache = nu_jpeg_cache_create();
+    s_sStat.budget = LV_JPEG_N9H30_CACHE_SIZE;
+
+    dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, nu_jpeg_decoder_info);
+    lv_img_decoder_set_open_cb(dec, nu_jpeg_decoder_open);
+    lv_img_decoder_set_close_cb(dec, nu_jpeg_decoder_close);
+}
+
+void lv_jpeg_n9h30_dsc_init(lv_img_dsc_t *dsc, const void *jpeg, uint32_t size, lv_coord_t w, lv_coord_t h)
+{
+    lv_memset_00(dsc, sizeof(lv_img_dsc_t));
+    dsc->header.cf = LV_IMG_CF_RAW;
+    dsc->header.w = w;
+    dsc->header.h = h;
+    dsc->data = (const uint8_t *)jpeg;
+    dsc->data_size = size;
+}
+
+void lv_jpeg_n9h30_cache_flush(void)
+{
+    if (s_psCache == NULL)
+        return;
+
+    /* The opened images are freed when they are closed. */
+    lv_lru_del(s_psCache);
+    s_psCache = nu_jpeg_cache_create();
+}
+
+void lv_jpeg_n9h30_get_stat(lv_jpeg_n9h30_stat_t *stat)
+{
+    *stat = s_sStat;
+    stat->used = (s_psCache != NULL) ? (s_psCache->total_memory - s_psCache->free_memory) : 0;
+}
+
+#if defined(__RTTHREAD__) && defined(RT_USING_FINSH)
+static void jpeg_stat(void)
+{
+    lv_jpeg_n9h30_stat_t stat;
+
+    lv_jpeg_n9h30_get_stat(&stat);
+
+    rt_kprintf("hit: %d, miss: %d, evict: %d\n", stat.hits, stat.misses, stat.evictions);
+    rt_kprintf("decode hw: %d, sw: %d, fail: %d\n", stat.hw_decodes, stat.sw_decodes, stat.failures);
+    rt_kprintf("cache: %d/%d bytes\n", stat.used, stat.budget);
+}
+MSH_CMD_EXPORT(jpeg_stat, show jpeg decoder statistics);
+#endif
+
+#endif /* LV_USE_JPEG_N9H30 */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_JPEG_N9H30_H
+#define LV_JPEG_N9H30_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Budget of the decoded-image cache in bytes */
+#ifndef LV_JPEG_N9H30_CACHE_SIZE
+    #define LV_JPEG_N9H30_CACHE_SIZE    (4 * 1024 * 1024)
+#endif
+
+/* Decode with the JPEG engine, or with tjpgd only. */
+#ifndef LV_JPEG_N9H30_USE_HW
+    #if defined(__RTTHREAD__)
+        #define LV_JPEG_N9H30_USE_HW    1
+    #else
+        #define LV_JPEG_N9H30_USE_HW    0
+    #endif
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint32_t hits;          /* Opened from the cache */
+    uint32_t misses;        /* Decoded */
+    uint32_t evictions;     /* Dropped from the cache */
+    uint32_t hw_decodes;    /* Decoded by the JPEG engine */
+    uint32_t sw_decodes;    /* Decoded by tjpgd */
+    uint32_t failures;      /* Failed to decode */
+    uint32_t used;          /* Bytes in the cache */
+    uint32_t budget;        /* LV_JPEG_N9H30_CACHE_SIZE */
+} lv_jpeg_n9h30_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the JPEG decoder, it takes precedence over the decoders registered before.
+ */
+void lv_jpeg_n9h30_init(void);
+
+/**
+ * Describe a JPEG stream in memory as an image source.
+ * @param dsc   the descriptor to initialize
+ * @param jpeg  the JPEG stream
+ * @param size  size of the stream in bytes
+ * @param w     width to decode the image at, 0: the width of the JPEG
+ * @param h     height to decode the image at, 0: the height of the JPEG
+ */
+void lv_jpeg_n9h30_dsc_init(lv_img_dsc_t *dsc, const void *jpeg, uint32_t size, lv_coord_t w, lv_coord_t h);
+
+/**
+ * Drop every decoded image which is not opened.
+ */
+void lv_jpeg_n9h30_cache_flush(void);
+
+/**
+ * Get the statistics of the decoder and the cache.
+ * @param stat  store the statistics here
+ */
+void lv_jpeg_n9h30_get_stat(lv_jpeg_n9h30_stat_t *stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_JPEG_N9H30_H*/
@@ -6,10 +6,23 @@
  * Change Logs:
  * Date           Author       Notes
  * 2021-12-17     Wayne        The first version
+ * 2026-10-16     Wayne        Render only invalidated areas in anti-tearing mode
+ * 2026-10-16     Wayne        Register the JPEG decoder
+ * 2026-10-16     Wayne        Draw letters from the glyph atlas
+ * 2026-10-16     Wayne        Pace the handler to vsync
+ * 2026-10-16     Wayne        Render on OSD layer over LCD layer by colour key
+ * 2026-10-16     Wayne        Rotate at flushing for LV_DISP_ROTATION
+ * 2026-10-16     Wayne        Profile the frame phases
  */
 #include <lvgl.h>
 #include "mmu.h"
 #include "lv_gpu_n9h30_2dge.h"
+#include "lv_jpeg_n9h30.h"
+#include "lv_glyph_cache.h"
+#include "lv_compositor_n9h30.h"
+#include "lv_rotate_n9h30.h"
+#include "lv_prof_n9h30.h"
+#include "drv_vpost.h"
 
 #define LOG_TAG             "lvgl.disp"
 #define DBG_ENABLE
@@ -19,13 +32,28 @@
 #include <rtdbg.h>
 
 #if !defined(NU_PKG_LVGL_RENDERING_LAYER)
+#if (LV_USE_COMPOSITOR_N9H30==1)
+    /* The UI is on top, the LCD layer shows through the colour key. */
+    #define NU_PKG_LVGL_RENDERING_LAYER "osd"
+#else
     #define NU_PKG_LVGL_RENDERING_LAYER "lcd"
 #endif
+#endif
 
 #ifndef BIT31
     #define BIT31    (0x80000000)       ///< Bit 31 mask of an 32 bit integer
 #endif
 
+#if (LV_DISP_ROTATION==90)
+    #define NU_DISP_ROT     LV_DISP_ROT_90
+#elif (LV_DISP_ROTATION==180)
+    #define NU_DISP_ROT     LV_DISP_ROT_180
+#elif (LV_DISP_ROTATION==270)
+    #define NU_DISP_ROT     LV_DISP_ROT_270
+#elif (LV_DISP_ROTATION!=0)
+    #error "LV_DISP_ROTATION must be 0, 90, 180 or 270"
+#endif
+
 /*A static or global variable to store the buffers*/
 static lv_disp_draw_buf_t disp_buf;
 static rt_device_t lcd_device = 0;
@@ -58,7 +86,9 @@ static void nu_antitearing(lv_disp_draw_buf_t *draw_buf, lv_color_t *color_p)
 
 static void nu_flush_full_refresh(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
     mmu_clean_dcache((uint32_t)color_p, disp_drv->draw_buf->size * sizeof(lv_color_t));
+    LV_PROF_N9H30_END();
 
     /* Use PANDISPLAY without H/W copying */
     rt_device_control(lcd_device, RTGRAPHIC_CTRL_PAN_DISPLAY, color_p);
@@ -75,6 +105,175 @@ static void nu_flush_full_refresh(lv_disp_drv_t *disp_drv, const lv_area_t *area
     lv_disp_flush_ready(disp_drv);
 }
 
+#if (LV_USE_DIRTY_AREA_SYNC==1)
+
+#define NU_STALE_AREA_MAX    16
+
+/* Areas of a screen-sized buffer which are older than the front buffer. */
+typedef struct
+{
+    void      *buf;
+    uint32_t   count;
+    lv_area_t  areas[NU_STALE_AREA_MAX];
+} nu_stale_t;
+
+static nu_stale_t s_stale[3];
+
+static uint32_t u32SyncPixels = 0;
+
+static nu_stale_t *nu_stale_find(void *buf)
+{
+    int i;
+
+    for (i = 0; i < sizeof(s_stale) / sizeof(s_stale[0]); i++)
+    {
+        if (s_stale[i].buf == buf)
+            return &s_stale[i];
+    }
+
+    return RT_NULL;
+}
+
+static void nu_stale_add(nu_stale_t *stale, const lv_area_t *area)
+{
+    uint32_t i;
+    lv_area_t joined;
+
+    for (i = 0; i < stale->count; i++)
+    {
+        if (_lv_area_is_in(area, &stale->areas[i], 0))
+            return;
+
+        /* Join them if the bounding box is not larger than the both. */
+        _lv_area_join(&joined, area, &stale->areas[i]);
+        if (lv_area_get_size(&joined) <= lv_area_get_size(area) + lv_area_get_size(&stale->areas[i]))
+        {
+            stale->areas[i] = joined;
+            return;
+        }
+    }
+
+    if (stale->count == NU_STALE_AREA_MAX)
+    {
+        /* Too many pieces, synchronise whole screen. */
+        lv_area_set(&stale->areas[0], 0, 0, info.width - 1, info.height - 1);
+        stale->count = 1;
+        return;
+    }
+
+    stale->areas[stale->count++] = *area;
+}
+
+static void nu_stale_init(void *buf1, void *buf2, void *buf3)
+{
+    lv_area_t full_area = {0, 0, info.width - 1, info.height - 1 };
+
+    rt_memset(s_stale, 0, sizeof(s_stale));
+
+    /* LVGL renders whole screen into buf1 at first, the others are garbage. */
+    s_stale[0].buf = buf1;
+    s_stale[1].buf = buf2;
+    s_stale[2].buf = buf3;
+    nu_stale_add(&s_stale[1], &full_area);
+    nu_stale_add(&s_stale[2], &full_area);
+}
+
+static void nu_stale_sync(void *dst, const void *src)
+{
+    nu_stale_t *stale = nu_stale_find(dst);
+    lv_area_t area;
+    uint32_t i;
+
+    if (stale == RT_NULL)
+        return;
+
+    for (i = 0; i < stale->count; i++)
+    {
+        area = stale->areas[i];
+
+        /* Round out to even pixels, 2DGE needs a word-aligned stride. */
+        area.x1 &= ~1;
+        area.x2 = LV_MIN(area.x2 | 1, info.width - 1);
+
+#if (LV_GPU_USE_N9H30_2DGE==1)
+        if (lv_draw_n9h30_2dge_copy(dst, src, info.width, &area))
+        {
+            u32SyncPixels += lv_area_get_size(&area);
+            continue;
+        }
+#endif
+        {
+            lv_coord_t y;
+            uint32_t u32Offset, u32Len = lv_area_get_width(&area) * sizeof(lv_color_t);
+
+            for (y = area.y1; y <= area.y2; y++)
+            {
+                u32Offset = (y * info.width + area.x1) * sizeof(lv_color_t);
+                lv_memcpy((uint8_t *)dst + u32Offset, (const uint8_t *)src + u32Offset, u32Len);
+            }
+            u32SyncPixels += lv_area_get_size(&area);
+        }
+    }
+
+    stale->count = 0;
+}
+
+static void nu_flush_direct(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    lv_disp_draw_buf_t *draw_buf = disp_drv->draw_buf;
+    uint32_t i, j, u32Start, u32End;
+    const lv_area_t *dirty;
+    void *next;
+
+    if (!lv_disp_flush_is_last(disp_drv))
+    {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    for (i = 0; i < disp->inv_p; i++)
+    {
+        if (disp->inv_area_joined[i])
+            continue;
+
+        dirty = &disp->inv_areas[i];
+
+        /* Write back the rendered pixels only. */
+        u32Start = (uint32_t)(color_p + dirty->y1 * info.width + dirty->x1);
+        u32End = (uint32_t)(color_p + dirty->y2 * info.width + dirty->x2 + 1);
+        LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
+        mmu_clean_dcache(u32Start, u32End - u32Start);
+        LV_PROF_N9H30_END();
+
+        /* The other buffers miss this area now. */
+        for (j = 0; j < sizeof(s_stale) / sizeof(s_stale[0]); j++)
+        {
+            if (s_stale[j].buf && (s_stale[j].buf != color_p))
+                nu_stale_add(&s_stale[j], dirty);
+        }
+    }
+
+    /* Use PANDISPLAY without H/W copying */
+    rt_device_control(lcd_device, RTGRAPHIC_CTRL_PAN_DISPLAY, color_p);
+
+    nu_antitearing(draw_buf, color_p);
+
+    /* LVGL swaps buf_act after flushing, bring the next one up to date from the front buffer. */
+    next = (draw_buf->buf_act == draw_buf->buf1) ? draw_buf->buf2 : draw_buf->buf1;
+    nu_stale_sync(next, color_p);
+
+    if (!u32FirstFlush)
+    {
+        /* Enable backlight at first flushing. */
+        rt_device_control(lcd_device, RTGRAPHIC_CTRL_POWERON, RT_NULL);
+        u32FirstFlush = 1;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+#endif
+
 static void nu_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
     int32_t area_w = lv_area_get_width(area);
@@ -108,14 +307,70 @@ static void nu_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t
     lv_disp_flush_ready(disp_drv);
 }
 
+#if defined(NU_DISP_ROT)
+/* Frame buffers written by the rotation, the back one is unused without anti-tearing. */
+static lv_color_t *s_rot_fb[2];
+static uint32_t u32RotBack = 0;
+
+static void nu_flush_rotate(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_color_t *dest = s_rot_fb[u32RotBack];
+
+    /* LVGL renders the area unrotated and packed. */
+    lv_rotate_n9h30(disp_drv, dest, area, color_p, lv_area_get_width(area));
+
+    if (disp_drv->full_refresh)
+    {
+        /* Show the rotated frame, then draw the next one into the former front buffer. */
+        rt_device_control(lcd_device, RTGRAPHIC_CTRL_PAN_DISPLAY, dest);
+        rt_device_control(lcd_device, RTGRAPHIC_CTRL_WAIT_VSYNC, RT_NULL);
+        u32RotBack ^= 1;
+    }
+
+    if (!u32FirstFlush)
+    {
+        /* Enable backlight at first flushing. */
+        rt_device_control(lcd_device, RTGRAPHIC_CTRL_POWERON, RT_NULL);
+        u32FirstFlush = 1;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+#endif
+
+#if (LV_USE_VSYNC_PACING==1)
+/* Run the handler right after vsync, the rendering has a whole frame period until the next one. */
+void lv_port_frame_wait(void)
+{
+    nu_vpost_vsync_t vsync;
+
+    if ((lcd_device == RT_NULL) ||
+            (rt_device_control(lcd_device, NU_VPOST_CTRL_WAIT_NEXT_VSYNC, &vsync) != RT_EOK))
+    {
+        rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+    }
+}
+#endif
+
 void nu_perf_monitor(struct _lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px)
 {
+#if (LV_USE_DIRTY_AREA_SYNC==1)
+    if (disp_drv->direct_mode)
+    {
+        LOG_I("Elapsed: %dms, Rendered: %d(%d%%), Synchronised: %d(%d%%)", time,
+              px, px * 100 / disp_drv->draw_buf->size,
+              u32SyncPixels, u32SyncPixels * 100 / disp_drv->draw_buf->size);
+        u32SyncPixels = 0;
+        return;
+    }
+#endif
     LOG_I("Elapsed: %dms, Pixel: %d, Bytes:%d, %d%\n", time, px, px * sizeof(lv_color_t), px * 100 / disp_drv->draw_buf->size);
 }
 
 void lv_port_disp_init(void)
 {
     rt_err_t result;
+    lv_disp_t *disp;
     void *buf1 = RT_NULL;
     void *buf2 = RT_NULL;
     uint32_t u32FBSize;
@@ -149,19 +404,52 @@ void lv_port_disp_init(void)
     disp_drv.ver_res = info.height;
     u32FBSize = info.height * info.width * (info.bits_per_pixel / 8);
 
+#if defined(NU_DISP_ROT)
+    /* The panel is in frame buffer orientation, LVGL lays out in the rotated one. */
+    disp_drv.rotated = NU_DISP_ROT;
+    disp_drv.sw_rotate = 0;
 #if (LV_USE_ANTI_TEARING==1)
     disp_drv.full_refresh = 1;
 #endif
-    LOG_I("LVGL: %s anti-tearing", disp_drv.full_refresh ? "Enabled" : "Disabled");
 
-    if (disp_drv.full_refresh)
+    /* Render into the third buffer and rotate into the first two. */
+    s_rot_fb[0] = (lv_color_t *)((uint32_t)info.framebuffer & ~BIT31); // Use Cacheable VRAM
+    s_rot_fb[1] = (lv_color_t *)((uint32_t)s_rot_fb[0] + u32FBSize);
+    buf1 = (void *)((uint32_t)s_rot_fb[1] + u32FBSize);
+    LOG_I("LVGL: Rotate %d degrees(%s) - buf1@%08x, fb@%08x/%08x", LV_DISP_ROTATION,
+          disp_drv.full_refresh ? "full_refresh" : "partial", buf1, s_rot_fb[0], s_rot_fb[1]);
+
+    rt_device_control(lcd_device, RTGRAPHIC_CTRL_PAN_DISPLAY, info.framebuffer);
+    disp_drv.flush_cb = nu_flush_rotate;
+#else
+#if (LV_USE_ANTI_TEARING==1)
+#if (LV_USE_DIRTY_AREA_SYNC==1)
+    disp_drv.direct_mode = 1;
+#else
+    disp_drv.full_refresh = 1;
+#endif
+#endif
+    LOG_I("LVGL: %s anti-tearing", (disp_drv.full_refresh || disp_drv.direct_mode) ? "Enabled" : "Disabled");
+
+    if (disp_drv.full_refresh || disp_drv.direct_mode)
     {
         buf1 = (void *)((uint32_t)info.framebuffer & ~BIT31); // Use Cacheable VRAM
         buf2 = (void *)((uint32_t)buf1 + u32FBSize);
         buf3_next = (void *)((uint32_t)buf2 + u32FBSize);
-        LOG_I("LVGL: Use triple screen-sized buffers(full_refresh) - buf1@%08x, buf2@%08x, buf3_next@%08x", buf1, buf2, buf3_next);
-
-        disp_drv.flush_cb = nu_flush_full_refresh;
+        LOG_I("LVGL: Use triple screen-sized buffers(%s) - buf1@%08x, buf2@%08x, buf3_next@%08x",
+              disp_drv.direct_mode ? "direct_mode" : "full_refresh", buf1, buf2, buf3_next);
+
+#if (LV_USE_DIRTY_AREA_SYNC==1)
+        if (disp_drv.direct_mode)
+        {
+            nu_stale_init(buf1, buf2, buf3_next);
+            disp_drv.flush_cb = nu_flush_direct;
+        }
+        else
+#endif
+        {
+            disp_drv.flush_cb = nu_flush_full_refresh;
+        }
     }
     else
     {
@@ -172,6 +460,7 @@ void lv_port_disp_init(void)
 
         disp_drv.flush_cb = nu_flush;
     }
+#endif
 
     /*Initialize `disp_buf` with the buffer(s).*/
     lv_disp_draw_buf_init(&disp_buf, buf1, buf2, info.width * info.height);
@@ -190,10 +479,31 @@ void lv_port_disp_init(void)
     disp_drv.draw_ctx_init = lv_draw_n9h30_2dge_ctx_init;
     disp_drv.draw_ctx_deinit = lv_draw_n9h30_2dge_ctx_init;
     disp_drv.draw_ctx_size = sizeof(lv_draw_n9h30_2dge_ctx_t);
+#elif (LV_USE_GLYPH_CACHE==1)
+    disp_drv.draw_ctx_init = lv_glyph_cache_ctx_init;
 #endif
     /*Called after every refresh cycle to tell the rendering and flushing time + the number of flushed pixels*/
-    //disp_drv.monitor_cb = nu_perf_monitor;
+#if (LV_USE_FLUSH_MONITOR==1)
+    disp_drv.monitor_cb = nu_perf_monitor;
+#endif
 
     /*Finally register the driver*/
-    lv_disp_drv_register(&disp_drv);
+    disp = lv_disp_drv_register(&disp_drv);
+
+#if (LV_USE_VSYNC_PACING==1)
+    /* Refresh at every paced call of the handler. */
+    lv_timer_set_period(disp->refr_timer, 1);
+#endif
+
+#if (LV_USE_JPEG_N9H30==1)
+    lv_jpeg_n9h30_init();
+#endif
+
+#if (LV_USE_COMPOSITOR_N9H30==1)
+    lv_compositor_n9h30_init(disp, LV_COMPOSITOR_N9H30_KEY);
+#endif
+
+#if (LV_USE_PROF_N9H30==1)
+    lv_prof_n9h30_init(disp);
+#endif
 }
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+/**
+ * @file lv_prof_n9h30.c
+ *
+ * Frame-time profiler of the LVGL port. The refresh timer of the display is wrapped,
+ * a frame is one run of it which flushed something. The time of a frame is split into
+ * exclusive phases: a phase entered by lv_prof_n9h30_begin() stops the clock of the
+ * outer one, and the time in no other phase is drawing. Every phase keeps the last
+ * LV_PROF_N9H30_HISTORY frames for min/avg/p99/max. The clock is cputime.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_prof_n9h30.h"
+
+#if LV_USE_PROF_N9H30
+
+#include <rtthread.h>
+#if defined(RT_USING_CPUTIME)
+    #include <drivers/cputime.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define NU_PROF_DEPTH_MAX       4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    uint32_t history[LV_PROF_N9H30_HISTORY];    /* Microseconds */
+    uint32_t index;         /* The next entry */
+    uint32_t count;
+} nu_prof_ring_t;
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static nu_prof_ring_t s_rings[_LV_PROF_N9H30_NUM];
+
+/* The current frame */
+static rt_thread_t s_thread;
+static uint32_t s_depth;
+static lv_prof_n9h30_phase_t s_stack[NU_PROF_DEPTH_MAX];
+static uint64_t s_u64Mark;
+static uint64_t s_u64FrameStart;
+static uint32_t s_acc[_LV_PROF_N9H30_NUM];     /* CPU time steps */
+static uint32_t s_u32Flushes;
+
+static lv_disp_t *s_disp;
+static lv_timer_cb_t s_refr_cb;
+static void (*s_flush_cb)(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+
+static volatile bool s_bReset;
+static volatile bool s_bShow;
+static lv_obj_t *s_overlay;
+
+static const char *s_names[_LV_PROF_N9H30_NUM] =
+{
+    "layout", "draw", "ge wait", "cache", "flush", "frame"
+};
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static uint64_t nu_prof_now(void)
+{
+#if defined(RT_USING_CPUTIME)
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+static uint32_t nu_prof_to_us(uint32_t u32Steps)
+{
+#if defined(RT_USING_CPUTIME)
+    return clock_cpu_microsecond(u32Steps);
+#else
+    return u32Steps * (1000000 / RT_TICK_PER_SECOND);
+#endif
+}
+
+/* Charge the time since the last mark to the current phase. */
+static void nu_prof_charge(void)
+{
+    uint64_t u64Now = nu_prof_now();
+
+    s_acc[s_stack[s_depth - 1]] += (uint32_t)(u64Now - s_u64Mark);
+    s_u64Mark = u64Now;
+}
+
+static void nu_prof_ring_push(nu_prof_ring_t *ring, uint32_t u32Us)
+{
+    ring->history[ring->index] = u32Us;
+    ring->index = (ring->index + 1) % LV_PROF_N9H30_HISTORY;
+    if (ring->count < LV_PROF_N9H30_HISTORY)
+        ring->count++;
+}
+
+static void nu_prof_frame_begin(void)
+{
+    if (s_bReset)
+    {
+        rt_memset(s_rings, 0, sizeof(s_rings));
+        s_bReset = false;
+    }
+
+    rt_memset(s_acc, 0, sizeof(s_acc));
+    s_u32Flushes = 0;
+    s_thread = rt_thread_self();
+
+    s_stack[0] = LV_PROF_N9H30_DRAW;
+    s_depth = 1;
+    s_u64FrameStart = s_u64Mark = nu_prof_now();
+}
+
+static void nu_prof_frame_end(void)
+{
+    int i;
+
+    nu_prof_charge();
+    s_depth = 0;
+
+    /* Nothing was redrawn. */
+    if (s_u32Flushes == 0)
+        return;
+
+    for (i = 0; i < LV_PROF_N9H30_FRAME; i++)
+        nu_prof_ring_push(&s_rings[i], nu_prof_to_us(s_acc[i]));
+
+    nu_prof_ring_push(&s_rings[LV_PROF_N9H30_FRAME], nu_prof_to_us((uint32_t)(s_u64Mark - s_u64FrameStart)));
+}
+
+static void nu_prof_refr_timer(lv_timer_t *timer)
+{
+    lv_disp_t *disp = (lv_disp_t *)timer->user_data;
+
+    nu_prof_frame_begin();
+
+    /* The refreshing finds the layout up to date. */
+    lv_prof_n9h30_begin(LV_PROF_N9H30_LAYOUT);
+    lv_obj_update_layout(disp->act_scr);
+    if (disp->prev_scr)
+        lv_obj_update_layout(disp->prev_scr);
+    lv_obj_update_layout(disp->top_layer);
+    lv_obj_update_layout(disp->sys_layer);
+    lv_prof_n9h30_end();
+
+    s_refr_cb(timer);
+
+    nu_prof_frame_end();
+}
+
+static void nu_prof_flush(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    s_u32Flushes++;
+
+    lv_prof_n9h30_begin(LV_PROF_N9H30_FLUSH);
+    s_flush_cb(disp_drv, area, color_p);
+    lv_prof_n9h30_end();
+}
+
+static void nu_prof_overlay_timer(lv_timer_t *timer)
+{
+    lv_prof_n9h30_stat_t stat;
+    char buf[256];
+    int i, len = 0;
+
+    if (!s_bShow)
+    {
+        if (s_overlay)
+        {
+            lv_obj_del(s_overlay);
+            s_overlay = NULL;
+        }
+        return;
+    }
+
+    if (s_overlay == NULL)
+    {
+        s_overlay = lv_label_create(lv_layer_sys());
+        lv_obj_set_style_bg_opa(s_overlay, LV_OPA_50, 0);
+        lv_obj_set_style_bg_color(s_overlay, lv_color_black(), 0);
+        lv_obj_set_style_text_color(s_overlay, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(s_overlay, 3, 0);
+        lv_obj_align(s_overlay, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    }
+
+    len += lv_snprintf(&buf[len], sizeof(buf) - len, "us       avg    p99");
+    for (i = 0; i < _LV_PROF_N9H30_NUM; i++)
+    {
+        lv_prof_n9h30_get_stat((lv_prof_n9h30_phase_t)i, &stat);
+        len += lv_snprintf(&buf[len], sizeof(buf) - len, "\n%-7s %6u %6u", s_names[i], stat.avg, stat.p99);
+    }
+
+    lv_label_set_text(s_overlay, buf);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+void lv_prof_n9h30_init(lv_disp_t *disp)
+{
+    LV_ASSERT_NULL(disp);
+
+    if (s_disp)
+        return;
+
+    s_disp = disp;
+
+    s_refr_cb = disp->refr_timer->timer_cb;
+    disp->refr_timer->timer_cb = nu_prof_refr_timer;
+
+    s_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = nu_prof_flush;
+
+    lv_timer_create(nu_prof_overlay_timer, LV_PROF_N9H30_OVERLAY_PERIOD, NULL);
+}
+
+void lv_prof_n9h30_begin(lv_prof_n9h30_phase_t phase)
+{
+    if ((s_depth == 0) || (s_depth == NU_PROF_DEPTH_MAX) || (rt_thread_self() != s_thread))
+        return;
+
+    nu_prof_charge();
+    s_stack[s_depth++] = phase;
+}
+
+void lv_prof_n9h30_end(void)
+{
+    if ((s_depth <= 1) || (rt_thread_self() != s_thread))
+        return;
+
+    nu_prof_charge();
+    s_depth--;
+}
+
+void lv_prof_n9h30_get_stat(lv_prof_n9h30_phase_t phase, lv_prof_n9h30_stat_t *stat)
+{
+    uint32_t sorted[LV_PROF_N9H30_HISTORY];
+    nu_prof_ring_t *ring;
+    uint64_t u64Sum = 0;
+    uint32_t i, j, n, v;
+
+    LV_ASSERT(phase < _LV_PROF_N9H30_NUM);
+
+    lv_memset_00(stat, sizeof(*stat));
+
+    ring = &s_rings[phase];
+    n = ring->count;
+    if (n == 0)
+        return;
+
+    /* Insertion sort, the history is short. */
+    for (i = 0; i < n; i++)
+    {
+        v = ring->history[i];
+        u64Sum += v;
+
+        for (j = i; (j > 0) && (sorted[j - 1] > v); j--)
+            sorted[j] = sorted[j - 1];
+        sorted[j] = v;
+    }
+
+    stat->count = n;
+    stat->min = sorted[0];
+    stat->max = sorted[n - 1];
+    stat->avg = (uint32_t)(u64Sum / n);
+    stat->p99 = sorted[(n * 99 + 99) / 100 - 1];
+    stat->last = ring->history[(ring->index + LV_PROF_N9H30_HISTORY - 1) % LV_PROF_N9H30_HISTORY];
+}
+
+void lv_prof_n9h30_reset(void)
+{
+    s_bReset = true;
+}
+
+void lv_prof_n9h30_show(bool en)
+{
+    s_bShow = en;
+}
+
+#if defined(RT_USING_FINSH)
+static int lv_prof(int argc, char **argv)
+{
+    lv_prof_n9h30_stat_t stat;
+    int i;
+
+    if (argc >= 2)
+    {
+        if (!rt_strcmp(argv[1], "reset"))
+        {
+            lv_prof_n9h30_reset();
+            return 0;
+        }
+        else if (!rt_strcmp(argv[1], "overlay") && (argc >= 3))
+        {
+            lv_prof_n9h30_show(!rt_strcmp(argv[2], "on"));
+            return 0;
+        }
+
+        rt_kprintf("Usage: lv_prof [reset|overlay on|overlay off]\n");
+        return -1;
+    }
+
+    rt_kprintf("%-8s %8s %8s %8s %8s %8s (us)\n", "phase", "last", "min", "avg", "p99", "max");
+    for (i = 0; i < _LV_PROF_N9H30_NUM; i++)
+    {
+        lv_prof_n9h30_get_stat((lv_prof_n9h30_phase_t)i, &stat);
+        rt_kprintf("%-8s %8d %8d %8d %8d %8d\n", s_names[i], stat.last, stat.min, stat.avg, stat.p99, stat.max);
+    }
+    rt_kprintf("frames: %d\n", stat.count);
+
+    return 0;
+}
+MSH_CMD_EXPORT(lv_prof, show lvgl frame phases: lv_prof [reset|overlay on|overlay off]);
+#endif
+
+#endif /* LV_USE_PROF_N9H30 */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_PROF_N9H30_H
+#define LV_PROF_N9H30_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_USE_PROF_N9H30
+    #define LV_USE_PROF_N9H30               0
+#endif
+
+/* Frames kept in the history of every phase */
+#ifndef LV_PROF_N9H30_HISTORY
+    #define LV_PROF_N9H30_HISTORY           128
+#endif
+
+/* Update period of the on-screen overlay in milliseconds */
+#ifndef LV_PROF_N9H30_OVERLAY_PERIOD
+    #define LV_PROF_N9H30_OVERLAY_PERIOD    500
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum
+{
+    LV_PROF_N9H30_LAYOUT,       /* lv_obj_update_layout of the screens and layers */
+    LV_PROF_N9H30_DRAW,         /* Rendering, the time of a frame not in another phase */
+    LV_PROF_N9H30_GE_WAIT,      /* Waiting for the 2D graphic engine */
+    LV_PROF_N9H30_CACHE,        /* Data cache maintenance */
+    LV_PROF_N9H30_FLUSH,        /* flush_cb, e.g. panning and copying */
+    LV_PROF_N9H30_FRAME,        /* The whole frame, not a phase to begin */
+    _LV_PROF_N9H30_NUM
+} lv_prof_n9h30_phase_t;
+
+typedef struct
+{
+    uint32_t min;       /* Microseconds */
+    uint32_t avg;
+    uint32_t p99;
+    uint32_t max;
+    uint32_t last;
+    uint32_t count;     /* Frames in the history */
+} lv_prof_n9h30_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Time the frames of a display. Call it after the display is registered.
+ * @param disp  the display
+ */
+void lv_prof_n9h30_init(lv_disp_t *disp);
+
+/**
+ * Enter a phase of the current frame, the time is not counted to the outer phase until
+ * lv_prof_n9h30_end(). It does nothing out of a frame or out of the thread of the frame.
+ * @param phase the phase
+ */
+void lv_prof_n9h30_begin(lv_prof_n9h30_phase_t phase);
+
+/**
+ * Leave the phase entered last.
+ */
+void lv_prof_n9h30_end(void);
+
+/**
+ * Get the statistics of a phase over the history.
+ * @param phase the phase, or LV_PROF_N9H30_FRAME
+ * @param stat  store the statistics here
+ */
+void lv_prof_n9h30_get_stat(lv_prof_n9h30_phase_t phase, lv_prof_n9h30_stat_t *stat);
+
+/**
+ * Drop the history before the next frame.
+ */
+void lv_prof_n9h30_reset(void);
+
+/**
+ * Show or hide the statistics on the system layer, it is applied by the overlay timer.
+ * @param en    true: show, false: hide
+ */
+void lv_prof_n9h30_show(bool en);
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_USE_PROF_N9H30
+    #define LV_PROF_N9H30_BEGIN(phase)      lv_prof_n9h30_begin(phase)
+    #define LV_PROF_N9H30_END()             lv_prof_n9h30_end()
+#else
+    #define LV_PROF_N9H30_BEGIN(phase)
+    #define LV_PROF_N9H30_END()
+#endif
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROF_N9H30_H*/
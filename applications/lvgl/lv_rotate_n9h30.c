@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ * 2026-10-16     Wayne        Time cache maintenance and waiting in the profiler
+ */
+/**
+ * @file lv_rotate_n9h30.c
+ *
+ * Rotation of rendered areas into the frame buffer of a panel mounted in another
+ * orientation. LVGL renders unrotated with `rotated` set and `sw_rotate` cleared;
+ * the flushing rotates every area by the 2D graphic engine. The coordinates follow
+ * `sw_rotate` of LVGL, a display coordinate (x, y) goes to the frame buffer at
+ *   LV_DISP_ROT_90:  (y, ver_res - 1 - x)
+ *   LV_DISP_ROT_180: (hor_res - 1 - x, ver_res - 1 - y)
+ *   LV_DISP_ROT_270: (hor_res - 1 - y, x)
+ * where hor_res and ver_res are of the frame buffer.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_rotate_n9h30.h"
+
+#if LV_ROTATE_N9H30_USE_HW
+    #include <rtthread.h>
+    #include "NuMicro.h"
+    #include "nu_2d.h"
+    #include "mmu.h"
+#endif
+#include "lv_prof_n9h30.h"
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void nu_rotate_point(const lv_disp_drv_t *drv, lv_coord_t x, lv_coord_t y, lv_point_t *out);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+void lv_rotate_n9h30_area(const lv_disp_drv_t *drv, const lv_area_t *area, lv_area_t *out, lv_point_t *first)
+{
+    lv_point_t p1, p2;
+
+    nu_rotate_point(drv, area->x1, area->y1, &p1);
+    nu_rotate_point(drv, area->x2, area->y2, &p2);
+
+    out->x1 = LV_MIN(p1.x, p2.x);
+    out->y1 = LV_MIN(p1.y, p2.y);
+    out->x2 = LV_MAX(p1.x, p2.x);
+    out->y2 = LV_MAX(p1.y, p2.y);
+
+    if (first)
+        *first = p1;
+}
+
+void lv_rotate_n9h30_sw(const lv_disp_drv_t *drv, lv_color_t *dest, const lv_area_t *area,
+                        const lv_color_t *src, lv_coord_t src_stride)
+{
+    lv_coord_t area_w = lv_area_get_width(area);
+    lv_coord_t area_h = lv_area_get_height(area);
+    lv_coord_t stride = drv->hor_res;
+    int32_t step_x, step_y;
+    lv_color_t *dest_line;
+    lv_point_t first;
+    lv_coord_t x, y;
+
+    nu_rotate_point(drv, area->x1, area->y1, &first);
+
+    /* Offsets in the frame buffer of the next pixel and the next line of the source. */
+    switch (drv->rotated)
+    {
+    case LV_DISP_ROT_90:
+        step_x = -stride;
+        step_y = 1;
+        break;
+    case LV_DISP_ROT_180:
+        step_x = -1;
+        step_y = -stride;
+        break;
+    case LV_DISP_ROT_270:
+        step_x = stride;
+        step_y = -1;
+        break;
+    default:
+        step_x = 1;
+        step_y = stride;
+        break;
+    }
+
+    dest_line = dest + first.y * stride + first.x;
+
+    for (y = 0; y < area_h; y++)
+    {
+        lv_color_t *d = dest_line;
+
+        for (x = 0; x < area_w; x++)
+        {
+            *d = src[x];
+            d += step_x;
+        }
+
+        src += src_stride;
+        dest_line += step_y;
+    }
+}
+
+void lv_rotate_n9h30(const lv_disp_drv_t *drv, lv_color_t *dest, const lv_area_t *area,
+                     const lv_color_t *src, lv_coord_t src_stride)
+{
+#if LV_ROTATE_N9H30_USE_HW
+    lv_coord_t area_w = lv_area_get_width(area);
+    lv_coord_t area_h = lv_area_get_height(area);
+    uint32_t u32Start, u32End;
+    lv_area_t out;
+    lv_point_t first;
+    int ctl;
+
+    switch (drv->rotated)
+    {
+    case LV_DISP_ROT_90:
+        ctl = GE_ROT_LEFT_90;
+        break;
+    case LV_DISP_ROT_180:
+        ctl = GE_ROT_UP_DOWN;
+        break;
+    case LV_DISP_ROT_270:
+        ctl = GE_ROT_RIGHT_90;
+        break;
+    default:
+        ctl = -1;
+        break;
+    }
+
+    if (ctl >= 0)
+    {
+        lv_rotate_n9h30_area(drv, area, &out, &first);
+
+        /* The engine reads the rendered pixels and writes the frame buffer behind the data cache. */
+        u32Start = RT_ALIGN_DOWN((uint32_t)(dest + out.y1 * drv->hor_res + out.x1), CACHE_LINE_SIZE);
+        u32End = RT_ALIGN((uint32_t)(dest + out.y2 * drv->hor_res + out.x2 + 1), CACHE_LINE_SIZE);
+
+        LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
+        mmu_clean_dcache((uint32_t)src, ((area_h - 1) * src_stride + area_w) * sizeof(lv_color_t));
+        mmu_clean_invalidated_dcache(u32Start, u32End - u32Start);
+        LV_PROF_N9H30_END();
+
+        if (ge2dQueue_Rotation(dest, drv->hor_res, LV_COLOR_DEPTH, first.x, first.y, area_w, area_h,
+                               (void *)src, src_stride, ctl) == 0)
+        {
+            LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_GE_WAIT);
+            ge2dQueue_Sync();
+            LV_PROF_N9H30_END();
+            return;
+        }
+    }
+#endif
+
+    lv_rotate_n9h30_sw(drv, dest, area, src, src_stride);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+static void nu_rotate_point(const lv_disp_drv_t *drv, lv_coord_t x, lv_coord_t y, lv_point_t *out)
+{
+    switch (drv->rotated)
+    {
+    case LV_DISP_ROT_90:
+        out->x = y;
+        out->y = drv->ver_res - 1 - x;
+        break;
+    case LV_DISP_ROT_180:
+        out->x = drv->hor_res - 1 - x;
+        out->y = drv->ver_res - 1 - y;
+        break;
+    case LV_DISP_ROT_270:
+        out->x = drv->hor_res - 1 - y;
+        out->y = x;
+        break;
+    default:
+        out->x = x;
+        out->y = y;
+        break;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     Wayne        The first version
+ */
+#ifndef LV_ROTATE_N9H30_H
+#define LV_ROTATE_N9H30_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <lvgl.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Rotate by the 2D graphic engine, or by the CPU only. */
+#ifndef LV_ROTATE_N9H30_USE_HW
+    #if defined(__RTTHREAD__) && (LV_GPU_USE_N9H30_2DGE==1)
+        #define LV_ROTATE_N9H30_USE_HW  1
+    #else
+        #define LV_ROTATE_N9H30_USE_HW  0
+    #endif
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Map an area of the rotated display to the frame buffer, the same way as `sw_rotate` of LVGL does.
+ * @param drv   the display driver, `hor_res` and `ver_res` are of the frame buffer
+ * @param area  the area in display coordinates
+ * @param out   store the area in frame buffer coordinates here
+ * @param first store the position of the first pixel of `area` in the frame buffer here, can be NULL
+ */
+void lv_rotate_n9h30_area(const lv_disp_drv_t *drv, const lv_area_t *area, lv_area_t *out, lv_point_t *first);
+
+/**
+ * Rotate the rendered pixels of an area into the frame buffer by the CPU, the reference of the 2D graphic engine.
+ * @param drv       the display driver
+ * @param dest      the frame buffer, `drv->hor_res` pixels a line
+ * @param area      the area in display coordinates
+ * @param src       the first rendered pixel of `area`
+ * @param src_stride    width of the rendered buffer in pixels
+ */
+void lv_rotate_n9h30_sw(const lv_disp_drv_t *drv, lv_color_t *dest, const lv_area_t *area,
+                        const lv_color_t *src, lv_coord_t src_stride);
+
+/**
+ * Rotate the rendered pixels of an area into the frame buffer, by the 2D graphic engine if possible.
+ * It returns after the frame buffer is written.
+ * @param drv       the display driver
+ * @param dest      the frame buffer, `drv->hor_res` pixels a line
+ * @param area      the area in display coordinates
+ * @param src       the first rendered pixel of `area`
+ * @param src_stride    width of the rendered buffer in pixels
+ */
+void lv_rotate_n9h30(const lv_disp_drv_t *drv, lv_color_t *dest, const lv_area_t *area,
+                     const lv_color_t *src, lv_coord_t src_stride);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ROTATE_N9H30_H*/
@@ -108,6 +108,12 @@ typedef struct
 #define MODE_SRC_TRANSPARENT    MODE_TRANSPARENT    /*!< source transparent mode */
 #define MODE_DEST_TRANSPARENT   2                   /*!< destination transparent mode */
 
+#define GE_ROT_LEFT_45      0x0 /*!< rotation: 45 degrees counter-clockwise */
+#define GE_ROT_LEFT_90      0x1 /*!< rotation: 90 degrees counter-clockwise */
+#define GE_ROT_UP_DOWN      0x2 /*!< rotation: 180 degrees */
+#define GE_ROT_RIGHT_45     0x4 /*!< rotation: 45 degrees clockwise */
+#define GE_ROT_RIGHT_90     0x5 /*!< rotation: 90 degrees clockwise */
+
 #define MODE_INSIDE_CLIP    0   /*!< clip inside */
 #define MODE_OUTSIDE_CLIP   1   /*!< clip outside */
 
@@ -173,6 +179,12 @@ void ge2dInitMonoInputPattern(uint32_t PatternA, uint32_t PatternB, int fore_col
 void ge2dInitColorPattern(int patformat, void *patdata);
 void ge2dFont_PutChar(int x, int y, char asc_code, int fore_color, int back_color, int draw_mode, int font_id);
 void ge2dFont_PutString(int x, int y, char *str, int fore_color, int back_color, int draw_mode, int font_id);
+int ge2dQueue_Fill(void *dest, int dest_pitch, int bpp, int dx, int dy, int width, int height, int color);
+int ge2dQueue_FillRop(void *dest, int dest_pitch, int bpp, int dx, int dy, int width, int height, int color, int rop);
+int ge2dQueue_SpriteBlt(void *dest, int dest_pitch, int bpp, int destx, int desty, int width, int height, void *src, int src_pitch, int alpha);
+int ge2dQueue_Rotation(void *dest, int dest_pitch, int bpp, int destx, int desty, int width, int height, void *src, int src_pitch, int ctl);
+void ge2dQueue_Sync(void);
+int ge2dQueue_IsIdle(void);
 
 /*@}*/ /* end of group N9H30_GE2D_EXPORTED_FUNCTIONS */
 
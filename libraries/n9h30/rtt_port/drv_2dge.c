@@ -590,6 +590,23 @@ static unsigned char FontData16[256][16] =
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00} //255
 };
 
+#if !defined(NU_GE2D_QUEUE_DEPTH)
+    #define NU_GE2D_QUEUE_DEPTH     16
+#endif
+
+/* Register image of a queued command, written to the engine as it is. */
+typedef struct
+{
+    UINT32 u32Ctl;          /* REG_GE2D_CTL */
+    UINT32 u32MiscCtl;      /* REG_GE2D_MISCTL: bpp and alpha factors */
+    UINT32 u32Pitch;        /* REG_GE2D_SDPITCH */
+    UINT32 u32SrcOrg;       /* REG_GE2D_XYSORG */
+    UINT32 u32DstOrg;       /* REG_GE2D_XYDORG */
+    UINT32 u32DstStart;     /* REG_GE2D_DSTSPA */
+    UINT32 u32Dimension;    /* REG_GE2D_RTGLSZ */
+    UINT32 u32FgColor;      /* REG_GE2D_FGCOLR */
+} S_GE2D_CMD;
+
 struct nu_ge2d
 {
     char                *name;
@@ -600,6 +617,12 @@ struct nu_ge2d
     rt_mutex_t           lock;
 #if defined(DEF_COND_WAIT)
     struct rt_completion signal;
+
+    /* Commands are executed from head one by one, the ISR starts the next one. */
+    S_GE2D_CMD           queue[NU_GE2D_QUEUE_DEPTH];
+    volatile rt_uint32_t queue_head;
+    volatile rt_uint32_t queue_count;
+    volatile rt_bool_t   queue_busy;
 #endif
 };
 typedef struct nu_ge2d *nu_ge2d_t;
@@ -622,6 +645,22 @@ static struct nu_ge2d g_sNuGe2d =
                               RT_ASSERT(result == RT_EOK); \
                           }
 
+static void nu_ge2d_queue_issue(const S_GE2D_CMD *psCmd)
+{
+    outpw(REG_GE2D_MISCTL, psCmd->u32MiscCtl);
+    outpw(REG_GE2D_WRPLNMSK, 0x00ffffff);
+    outpw(REG_GE2D_XYSORG, psCmd->u32SrcOrg);
+    outpw(REG_GE2D_XYDORG, psCmd->u32DstOrg);
+    outpw(REG_GE2D_SDPITCH, psCmd->u32Pitch);
+    outpw(REG_GE2D_SRCSPA, 0);
+    outpw(REG_GE2D_DSTSPA, psCmd->u32DstStart);
+    outpw(REG_GE2D_RTGLSZ, psCmd->u32Dimension);
+    outpw(REG_GE2D_FGCOLR, psCmd->u32FgColor);
+    outpw(REG_GE2D_CTL, psCmd->u32Ctl);
+
+    outpw(REG_GE2D_TRG, 1);
+}
+
 #if defined(DEF_COND_WAIT)
 #define NU_GE2D_GO()        { \
                                 rt_completion_init(&(g_sNuGe2d.signal)); \
@@ -644,9 +683,59 @@ static void nu_ge2d_isr(int vector, void *param)
     /* Clear interrupt status. */
     outpw(REG_GE2D_INTSTS, 1);
 
+    if (g_sNuGe2d.queue_busy)
+    {
+        /* The command at head is done, kick the next one without waking anybody. */
+        g_sNuGe2d.queue_head = (g_sNuGe2d.queue_head + 1) % NU_GE2D_QUEUE_DEPTH;
+        g_sNuGe2d.queue_count--;
+
+        if (g_sNuGe2d.queue_count > 0)
+        {
+            nu_ge2d_queue_issue(&g_sNuGe2d.queue[g_sNuGe2d.queue_head]);
+            return;
+        }
+
+        g_sNuGe2d.queue_busy = RT_FALSE;
+    }
+
     /* Signal condition-waiting to resume caller. */
     NU_GE2D_SIGNAL();
 }
+
+/* Wait until all queued commands are done, the caller must hold the lock. */
+static void nu_ge2d_queue_drain(void)
+{
+    rt_base_t level;
+    rt_uint32_t u32Dropped;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        if (!g_sNuGe2d.queue_busy)
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+        rt_completion_init(&(g_sNuGe2d.signal));
+        rt_hw_interrupt_enable(level);
+
+        if (rt_completion_wait(&g_sNuGe2d.signal, 60) != RT_EOK)
+        {
+            /* No completion interrupt, the engine hangs. Drop the remaining commands. */
+            level = rt_hw_interrupt_disable();
+            u32Dropped = g_sNuGe2d.queue_count;
+            if (g_sNuGe2d.queue_busy)
+            {
+                ge2dReset();
+                g_sNuGe2d.queue_count = 0;
+                g_sNuGe2d.queue_busy = RT_FALSE;
+            }
+            rt_hw_interrupt_enable(level);
+
+            rt_kprintf("[%s] timeout, %d queued commands dropped.\n", g_sNuGe2d.name, u32Dropped);
+        }
+    }
+}
 #else
 #define NU_GE2D_GO()        { \
                                  outpw(REG_GE2D_TRG, 1); \
@@ -657,6 +746,8 @@ static void nu_ge2d_isr(int vector, void *param)
                                  outpw(REG_GE2D_INTSTS, 1); \
                             }
 #define NU_GE2D_SIGNAL()
+
+#define nu_ge2d_queue_drain()
 #endif
 
 
@@ -775,6 +866,9 @@ void ge2dInit(int bpp, int width, int height, void *destination)
 
     NU_GE2D_LOCK();
 
+    /* Let the queued commands finish before taking over the engine. */
+    nu_ge2d_queue_drain();
+
     ge2dReset();
 
     GFX_WIDTH = width;
@@ -3457,6 +3551,231 @@ void ge2dFont_PutString(int x, int y, char *str, int fore_color, int back_color,
     }
 }
 
+static int nu_ge2d_queue_submit(const S_GE2D_CMD *psCmd)
+{
+#if defined(DEF_COND_WAIT)
+    rt_base_t level;
+    rt_uint32_t u32Tail;
+
+    NU_GE2D_LOCK();
+
+    /* No free slot, wait for the engine to catch up. */
+    if (g_sNuGe2d.queue_count == NU_GE2D_QUEUE_DEPTH)
+        nu_ge2d_queue_drain();
+
+    level = rt_hw_interrupt_disable();
+
+    u32Tail = (g_sNuGe2d.queue_head + g_sNuGe2d.queue_count) % NU_GE2D_QUEUE_DEPTH;
+    g_sNuGe2d.queue[u32Tail] = *psCmd;
+    g_sNuGe2d.queue_count++;
+
+    if (!g_sNuGe2d.queue_busy)
+    {
+        g_sNuGe2d.queue_busy = RT_TRUE;
+        nu_ge2d_queue_issue(&g_sNuGe2d.queue[g_sNuGe2d.queue_head]);
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    NU_GE2D_UNLOCK();
+#else
+    NU_GE2D_LOCK();
+
+    nu_ge2d_queue_issue(psCmd);
+
+    NU_GE2D_COND_WAIT();
+
+    NU_GE2D_UNLOCK();
+#endif
+
+    return 0;
+}
+
+static int nu_ge2d_queue_bpp(int bpp, UINT32 *pu32MiscCtl)
+{
+    switch (bpp)
+    {
+    case 8:
+        *pu32MiscCtl = GE_BPP_8;
+        break;
+    case 16:
+        *pu32MiscCtl = GE_BPP_16;
+        break;
+    case 32:
+        *pu32MiscCtl = GE_BPP_32;
+        break;
+    default:
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+  * @brief Queue a rectangle solid color fill, it returns without waiting for the engine.
+  * @param[in] dest is pointer of destination buffer
+  * @param[in] dest_pitch is pitch of destination buffer in pixel
+  * @param[in] bpp bit per pixel of destination buffer
+  * @param[in] dx x position
+  * @param[in] dy y position
+  * @param[in] width is fill width
+  * @param[in] height is fill height
+  * @param[in] color is color of foreground in the format of destination buffer
+  * @return 0: queued, -1: invalid parameter
+  * @note The caller has to clean and invalidate the destination in data cache, and must not
+  *       touch it until @ref ge2dQueue_Sync returns.
+  */
+int ge2dQueue_Fill(void *dest, int dest_pitch, int bpp, int dx, int dy, int width, int height, int color)
+{
+    return ge2dQueue_FillRop(dest, dest_pitch, bpp, dx, dy, width, height, color, SRCCOPY);
+}
+
+/**
+  * @brief Queue a rectangle solid color fill with a ROP operation, the foreground color is the source.
+  * @param[in] dest is pointer of destination buffer
+  * @param[in] dest_pitch is pitch of destination buffer in pixel
+  * @param[in] bpp bit per pixel of destination buffer
+  * @param[in] dx x position
+  * @param[in] dy y position
+  * @param[in] width is fill width
+  * @param[in] height is fill height
+  * @param[in] color is color of foreground in the format of destination buffer
+  * @param[in] rop is rop operation code
+  * @return 0: queued, -1: invalid parameter
+  */
+int ge2dQueue_FillRop(void *dest, int dest_pitch, int bpp, int dx, int dy, int width, int height, int color, int rop)
+{
+    S_GE2D_CMD sCmd;
+
+    if ((dest == NULL) || (width <= 0) || (height <= 0))
+        return -1;
+
+    if (nu_ge2d_queue_bpp(bpp, &sCmd.u32MiscCtl) < 0)
+        return -1;
+
+    sCmd.u32Ctl       = ((UINT32)(rop & 0xff) << 24) | 0x00430060;
+    sCmd.u32Pitch     = dest_pitch << 16;
+    sCmd.u32SrcOrg    = (UINT32)dest;
+    sCmd.u32DstOrg    = (UINT32)dest;
+    sCmd.u32DstStart  = dy << 16 | dx;
+    sCmd.u32Dimension = height << 16 | width;
+    sCmd.u32FgColor   = (UINT32)color;
+
+    return nu_ge2d_queue_submit(&sCmd);
+}
+
+/**
+  * @brief Queue an OffScreen-to-OnScreen SpriteBlt, optionally alpha blended with destination.
+  * @param[in] dest is pointer of destination buffer
+  * @param[in] dest_pitch is pitch of destination buffer in pixel
+  * @param[in] bpp bit per pixel of both buffers
+  * @param[in] destx destination x position
+  * @param[in] desty destination y position
+  * @param[in] width is sprite width
+  * @param[in] height is sprite height
+  * @param[in] src is pointer of the first sprite pixel
+  * @param[in] src_pitch is pitch of sprite in pixel
+  * @param[in] alpha is opacity of sprite, 0~255. 255 means SRCCOPY.
+  * @return 0: queued, -1: invalid parameter
+  * @note The source must stay unchanged until @ref ge2dQueue_Sync returns.
+  */
+int ge2dQueue_SpriteBlt(void *dest, int dest_pitch, int bpp, int destx, int desty, int width, int height,
+                        void *src, int src_pitch, int alpha)
+{
+    S_GE2D_CMD sCmd;
+
+    if ((dest == NULL) || (src == NULL) || (width <= 0) || (height <= 0) || (alpha < 0) || (alpha > 255))
+        return -1;
+
+    if (nu_ge2d_queue_bpp(bpp, &sCmd.u32MiscCtl) < 0)
+        return -1;
+
+    sCmd.u32Ctl       = 0xcc430000;
+    sCmd.u32Pitch     = dest_pitch << 16 | src_pitch;
+    sCmd.u32SrcOrg    = (UINT32)src;
+    sCmd.u32DstOrg    = (UINT32)dest;
+    sCmd.u32DstStart  = desty << 16 | destx;
+    sCmd.u32Dimension = height << 16 | width;
+    sCmd.u32FgColor   = 0;
+
+    if (alpha < 255)
+    {
+        /* Ks + Kd must not be over 255. */
+        sCmd.u32Ctl |= 0x00200000;
+        sCmd.u32MiscCtl |= (UINT32)((alpha << 8) | (255 - alpha)) << 16;
+    }
+
+    return nu_ge2d_queue_submit(&sCmd);
+}
+
+/**
+  * @brief Queue an OffScreen-to-OnScreen rotation, the first source pixel lands on the destination position.
+  * @param[in] dest is pointer of destination buffer
+  * @param[in] dest_pitch is pitch of destination buffer in pixel
+  * @param[in] bpp bit per pixel of both buffers
+  * @param[in] destx destination x position of the first source pixel
+  * @param[in] desty destination y position of the first source pixel
+  * @param[in] width is source width
+  * @param[in] height is source height
+  * @param[in] src is pointer of the first source pixel
+  * @param[in] src_pitch is pitch of source in pixel
+  * @param[in] ctl is drawing direction, GE_ROT_xxx
+  * @return 0: queued, -1: invalid parameter
+  * @note The source must stay unchanged until @ref ge2dQueue_Sync returns.
+  */
+int ge2dQueue_Rotation(void *dest, int dest_pitch, int bpp, int destx, int desty, int width, int height,
+                       void *src, int src_pitch, int ctl)
+{
+    S_GE2D_CMD sCmd;
+
+    if ((dest == NULL) || (src == NULL) || (width <= 0) || (height <= 0) || (ctl < 0) || (ctl > 7))
+        return -1;
+
+    if (nu_ge2d_queue_bpp(bpp, &sCmd.u32MiscCtl) < 0)
+        return -1;
+
+    sCmd.u32Ctl       = 0xcc030000 | (ctl << 1);
+    sCmd.u32Pitch     = dest_pitch << 16 | src_pitch;
+    sCmd.u32SrcOrg    = (UINT32)src;
+    sCmd.u32DstOrg    = (UINT32)dest;
+    sCmd.u32DstStart  = desty << 16 | destx;
+    sCmd.u32Dimension = height << 16 | width;
+    sCmd.u32FgColor   = 0;
+
+    return nu_ge2d_queue_submit(&sCmd);
+}
+
+/**
+  * @brief Wait until all queued commands are done.
+  * @return none
+  */
+void ge2dQueue_Sync(void)
+{
+#if defined(DEF_COND_WAIT)
+    if (!g_sNuGe2d.queue_busy)
+        return;
+
+    NU_GE2D_LOCK();
+
+    nu_ge2d_queue_drain();
+
+    NU_GE2D_UNLOCK();
+#endif
+}
+
+/**
+  * @brief Check if the queued commands are all done.
+  * @return 1: idle, 0: busy
+  */
+int ge2dQueue_IsIdle(void)
+{
+#if defined(DEF_COND_WAIT)
+    return g_sNuGe2d.queue_busy ? 0 : 1;
+#else
+    return 1;
+#endif
+}
+
 /**
  * Hardware GE2D Initialization
  */
@@ -7,6 +7,8 @@
 * Change Logs:
 * Date            Author           Notes
 * 2020-12-12      Wayne            First version
+* 2026-10-16      Wayne            Mount the cards through a write-back block cache
+* 2026-10-16      Wayne            Multi-block bounce buffer and transfer statistics
 *
 ******************************************************************************/
 
@@ -18,6 +20,10 @@
 #include <string.h>
 #include "NuMicro.h"
 #include <drv_sys.h>
+#include "drv_sdh.h"
+#if defined(RT_USING_CPUTIME)
+    #include <drivers/cputime.h>
+#endif
 
 #define LOG_TAG    "drv.sdh"
 #define DBG_ENABLE
@@ -100,10 +106,19 @@ enum
 
 #define SDH_BLOCK_SIZE   512ul
 
+/* Blocks of the bounce buffer of a device, an unaligned request goes in commands of this size. */
+#if !defined(NU_SDH_BOUNCE_BLOCKS)
+    #define NU_SDH_BOUNCE_BLOCKS   16
+#endif
+
 #if defined(NU_SDH_HOTPLUG)
     #define NU_SDH_TID_STACK_SIZE  1024
 #endif
 
+#if defined(NU_SDH_HOTPLUG) && defined(RT_USING_BLK_CACHE) && (NU_SDH_CACHE_BLOCKS > 0)
+    #define NU_SDH_CACHE   1
+#endif
+
 #if defined(NU_SDH_HOTPLUG)
 typedef enum
 {
@@ -135,7 +150,8 @@ struct nu_sdh
     int                   IsCardMounted;
     SDH_INFO_T           *info;
     struct rt_semaphore   lock;
-    uint8_t              *pbuf;
+    uint8_t              *pbuf;             /* Bounce buffer of NU_SDH_BOUNCE_BLOCKS blocks */
+    nu_sdh_stat_t         stat;
 };
 typedef struct nu_sdh *nu_sdh_t;
 
@@ -193,7 +209,9 @@ static struct nu_sdh nu_sdh_arr [] =
         .rstidx = FMIRST,
         .clkidx = EMMCCKEN,
         .info = &EMMC,
+#if defined(NU_SDH_HOTPLUG)
         .card_detected_event = NU_SDH_CARD_DETECTED_EMMC,
+#endif
     },
 #endif
 
@@ -209,7 +227,9 @@ static struct nu_sdh nu_sdh_arr [] =
         .rstidx = SDIORST,
         .clkidx = SDHCKEN,
         .info = &SD0,
+#if defined(NU_SDH_HOTPLUG)
         .card_detected_event = NU_SDH_CARD_DETECTED_SD0,
+#endif
     },
 #endif
 
@@ -231,7 +251,9 @@ static struct nu_sdh nu_sdh_arr [] =
         .clkidx = SDHCKEN,
 #endif
         .info = &SD1,
+#if defined(NU_SDH_HOTPLUG)
         .card_detected_event = NU_SDH_CARD_DETECTED_SD1,
+#endif
     },
 #endif
 }; /* struct nu_sdh nu_sdh_arr [] */
@@ -364,10 +386,50 @@ static rt_err_t nu_sdh_close(rt_device_t dev)
     return RT_EOK;
 }
 
+static uint64_t nu_sdh_now(void)
+{
+#if defined(RT_USING_CPUTIME)
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+static void nu_sdh_stat_update(nu_sdh_xfer_stat_t *stat, rt_uint32_t count, rt_bool_t bounce, rt_bool_t ok, uint64_t start)
+{
+    uint32_t elapsed = (uint32_t)(nu_sdh_now() - start);
+
+#if defined(RT_USING_CPUTIME)
+    elapsed = clock_cpu_microsecond(elapsed);
+#else
+    elapsed = elapsed * (1000000 / RT_TICK_PER_SECOND);
+#endif
+
+    stat->cmds++;
+    if (!ok)
+    {
+        stat->errors++;
+        return;
+    }
+
+    stat->blocks += count;
+    if (bounce)
+        stat->bounced += count;
+    stat->sizes[nu_sdh_stat_size_index(count)]++;
+
+    if ((stat->lat_min == 0) || (elapsed < stat->lat_min))
+        stat->lat_min = elapsed;
+    if (elapsed > stat->lat_max)
+        stat->lat_max = elapsed;
+    stat->lat_total += elapsed;
+}
+
 static rt_size_t nu_sdh_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t blk_nb)
 {
     rt_err_t result = RT_ERROR;
     rt_uint32_t ret = 0;
+    rt_uint32_t done = 0, count;
+    rt_bool_t bounce;
     nu_sdh_t sdh = (nu_sdh_t)dev;
 
     RT_ASSERT(dev);
@@ -385,39 +447,28 @@ static rt_size_t nu_sdh_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_siz
     result = rt_sem_take(&sdh->lock, RT_WAITING_FOREVER);
     RT_ASSERT(result == RT_EOK);
 
-    /* Check alignment. */
-    if (((uint32_t)buffer & 0x03) != 0)
+    while ((count = nu_sdh_split(buffer, done, blk_nb, NU_SDH_BOUNCE_BLOCKS, &bounce)) > 0)
     {
-        /* Non-aligned. */
-        uint32_t i;
-        uint8_t *copy_buffer = (uint8_t *)buffer;
-
-        for (i = 0; i < blk_nb; i++)
-        {
-            /* Read to temp buffer from specified sector. */
-            ret = SDH_Read(sdh->base, sdh->info, (uint8_t *)((uint32_t)&sdh->pbuf[0] | NONCACHEABLE), pos, 1);
-            if (ret != Successful)
-                goto exit_nu_sdh_read;
+        /* A non-aligned buffer is read through the bounce buffer, still by multi-block commands. */
+        uint8_t *dma_buffer = bounce ? sdh->pbuf : (uint8_t *)buffer + done * SDH_BLOCK_SIZE;
+        uint64_t start;
 
 #if defined(BSP_USING_MMU)
-            mmu_invalidate_dcache((rt_uint32_t)&sdh->pbuf[0], SDH_BLOCK_SIZE);
+        mmu_clean_invalidated_dcache((rt_uint32_t)dma_buffer, SDH_BLOCK_SIZE * count);
 #endif
-            /* Move to user's buffer */
-            memcpy((void *)copy_buffer, (void *)&sdh->pbuf[0], SDH_BLOCK_SIZE);
 
-            pos ++;
-            copy_buffer += SDH_BLOCK_SIZE;
-        }
-    }
-    else
-    {
+        start = nu_sdh_now();
+        ret = SDH_Read(sdh->base, sdh->info, (uint8_t *)((uint32_t)dma_buffer | NONCACHEABLE), pos + done, count);
 
-#if defined(BSP_USING_MMU)
-        mmu_clean_invalidated_dcache((rt_uint32_t)buffer, SDH_BLOCK_SIZE * blk_nb);
-#endif
+        nu_sdh_stat_update(&sdh->stat.read, count, bounce, ret == Successful, start);
+        if (ret != Successful)
+            goto exit_nu_sdh_read;
 
-        /* Read to user's buffer from specified sector. */
-        ret = SDH_Read(sdh->base, sdh->info, (uint8_t *)((uint32_t)buffer | NONCACHEABLE), pos, blk_nb);
+        /* Move to user's buffer */
+        if (bounce)
+            memcpy((uint8_t *)buffer + done * SDH_BLOCK_SIZE, dma_buffer, SDH_BLOCK_SIZE * count);
+
+        done += count;
     }
 
 exit_nu_sdh_read:
@@ -442,6 +493,8 @@ static rt_size_t nu_sdh_write(rt_device_t dev, rt_off_t pos, const void *buffer,
 {
     rt_err_t result = RT_ERROR;
     rt_uint32_t ret = 0;
+    rt_uint32_t done = 0, count;
+    rt_bool_t bounce;
     nu_sdh_t sdh = (nu_sdh_t)dev;
 
     RT_ASSERT(dev != RT_NULL);
@@ -459,37 +512,30 @@ static rt_size_t nu_sdh_write(rt_device_t dev, rt_off_t pos, const void *buffer,
     result = rt_sem_take(&sdh->lock, RT_WAITING_FOREVER);
     RT_ASSERT(result == RT_EOK);
 
-    /* Check alignment. */
-    if (((uint32_t)buffer & 0x03) != 0)
+    while ((count = nu_sdh_split(buffer, done, blk_nb, NU_SDH_BOUNCE_BLOCKS, &bounce)) > 0)
     {
-        /* Non-aligned. */
-        uint32_t i;
-        uint8_t *copy_buffer = (uint8_t *)buffer;
+        /* A non-aligned buffer is written through the bounce buffer, still by multi-block commands. */
+        uint8_t *dma_buffer = (uint8_t *)buffer + done * SDH_BLOCK_SIZE;
+        uint64_t start;
 
-        for (i = 0; i < blk_nb; i++)
+        if (bounce)
         {
-            memcpy((void *)&sdh->pbuf[0], copy_buffer, SDH_BLOCK_SIZE);
+            memcpy(sdh->pbuf, dma_buffer, SDH_BLOCK_SIZE * count);
+            dma_buffer = sdh->pbuf;
+        }
 
 #if defined(BSP_USING_MMU)
-            mmu_clean_invalidated_dcache((rt_uint32_t)&sdh->pbuf[0], SDH_BLOCK_SIZE);
+        mmu_clean_invalidated_dcache((rt_uint32_t)dma_buffer, SDH_BLOCK_SIZE * count);
 #endif
 
-            ret = SDH_Write(sdh->base, sdh->info, (uint8_t *)((uint32_t)&sdh->pbuf[0] | NONCACHEABLE), pos, 1);
-            if (ret != Successful)
-                goto exit_nu_sdh_write;
+        start = nu_sdh_now();
+        ret = SDH_Write(sdh->base, sdh->info, (uint8_t *)((uint32_t)dma_buffer | NONCACHEABLE), pos + done, count);
 
-            pos++;
-            copy_buffer += SDH_BLOCK_SIZE;
-        }
-    }
-    else
-    {
-#if defined(BSP_USING_MMU)
-        mmu_clean_invalidated_dcache((rt_uint32_t)buffer, SDH_BLOCK_SIZE * blk_nb);
-#endif
+        nu_sdh_stat_update(&sdh->stat.write, count, bounce, ret == Successful, start);
+        if (ret != Successful)
+            goto exit_nu_sdh_write;
 
-        /* Write to device directly. */
-        ret = SDH_Write(sdh->base, sdh->info, (uint8_t *)((uint32_t)buffer | NONCACHEABLE), pos, blk_nb);
+        done += count;
     }
 
 exit_nu_sdh_write:
@@ -528,6 +574,24 @@ static rt_err_t nu_sdh_control(rt_device_t dev, int cmd, void *args)
         geometry->block_size = sdh_info->sectorSize;
         geometry->sector_count = sdh_info->totalSectorN;
     }
+    else if ((cmd == NU_SDH_CTRL_GET_STAT) || (cmd == NU_SDH_CTRL_RESET_STAT))
+    {
+        rt_err_t result;
+
+        if ((cmd == NU_SDH_CTRL_GET_STAT) && (args == RT_NULL))
+            return -RT_ERROR;
+
+        result = rt_sem_take(&sdh->lock, RT_WAITING_FOREVER);
+        RT_ASSERT(result == RT_EOK);
+
+        if (cmd == NU_SDH_CTRL_GET_STAT)
+            rt_memcpy(args, &sdh->stat, sizeof(nu_sdh_stat_t));
+        else
+            rt_memset(&sdh->stat, 0, sizeof(nu_sdh_stat_t));
+
+        result = rt_sem_release(&sdh->lock);
+        RT_ASSERT(result == RT_EOK);
+    }
 
     return RT_EOK;
 }
@@ -585,7 +649,7 @@ static int rt_hw_sdh_init(void)
             nu_sys_ip_reset(nu_sdh_arr[i].rstidx);
         }
 
-        nu_sdh_arr[i].pbuf = rt_malloc_align(SDH_BLOCK_SIZE, 32);
+        nu_sdh_arr[i].pbuf = rt_malloc_align(SDH_BLOCK_SIZE * NU_SDH_BOUNCE_BLOCKS, 32);
         RT_ASSERT(nu_sdh_arr[i].pbuf);
 
         ret = rt_device_register(&nu_sdh_arr[i].dev, nu_sdh_arr[i].name, flags);
@@ -596,6 +660,45 @@ static int rt_hw_sdh_init(void)
 }
 INIT_BOARD_EXPORT(rt_hw_sdh_init);
 
+#if defined(RT_USING_FINSH)
+static void nu_sdh_stat_show(const char *name, const char *dir, nu_sdh_xfer_stat_t *stat)
+{
+    rt_uint32_t ok = stat->cmds - stat->errors;
+    int i;
+
+    rt_kprintf("%-6s %-5s %8d %8d %8d %6d %6d %6d %6d |", name, dir, stat->cmds, stat->blocks, stat->bounced, stat->errors,
+               stat->lat_min, ok ? (rt_uint32_t)(stat->lat_total / ok) : 0, stat->lat_max);
+    for (i = 0; i < NU_SDH_STAT_SIZES; i++)
+        rt_kprintf(" %d", stat->sizes[i]);
+    rt_kprintf("\n");
+}
+
+static int sdh_stat(int argc, char **argv)
+{
+    nu_sdh_stat_t stat;
+    int i;
+
+    for (i = (SDH_START + 1); i < SDH_CNT; i++)
+    {
+        if ((argc >= 2) && !rt_strcmp(argv[1], "reset"))
+        {
+            nu_sdh_control(&nu_sdh_arr[i].dev, NU_SDH_CTRL_RESET_STAT, RT_NULL);
+            continue;
+        }
+
+        if (i == (SDH_START + 1))
+            rt_kprintf("device dir       cmds   blocks  bounced errors    min    avg    max | cmds of 1,2-3,4-7,..,256+ blocks (us)\n");
+
+        nu_sdh_control(&nu_sdh_arr[i].dev, NU_SDH_CTRL_GET_STAT, &stat);
+        nu_sdh_stat_show(nu_sdh_arr[i].name, "read", &stat.read);
+        nu_sdh_stat_show(nu_sdh_arr[i].name, "write", &stat.write);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(sdh_stat, show sdh transfer statistics: sdh_stat [reset]);
+#endif
+
 #if defined(NU_SDH_HOTPLUG)
 static rt_bool_t nu_sdh_hotplug_is_mounted(const char *mounting_path)
 {
@@ -622,7 +725,12 @@ exit_nu_sdh_hotplug_is_mounted:
 static rt_err_t nu_sdh_hotplug_mount(nu_sdh_t sdh)
 {
     rt_err_t ret = RT_ERROR;
+    const char *dev_name = sdh->name;
     DIR *t;
+#if defined(NU_SDH_CACHE)
+    char cache_name[RT_NAME_MAX];
+    rt_device_t cache;
+#endif
 
     if (nu_sdh_hotplug_is_mounted(sdh->mounted_point) == RT_TRUE)
     {
@@ -659,13 +767,27 @@ static rt_err_t nu_sdh_hotplug_mount(nu_sdh_t sdh)
     } //else
 #endif
 
-    if ((ret = dfs_mount(sdh->name, sdh->mounted_point, "elm", 0, 0)) == 0)
+#if defined(NU_SDH_CACHE)
+    /* The filesystem goes through a write-back cache, it starts empty on a newly inserted card. */
+    rt_snprintf(cache_name, sizeof(cache_name), "%sc", sdh->name);
+    if ((cache = rt_device_find(cache_name)) != RT_NULL)
     {
-        rt_kprintf("Mounted %s on %s\n", sdh->name, sdh->mounted_point);
+        rt_blk_cache_invalidate(cache);
+        dev_name = cache_name;
+    }
+    else if (rt_blk_cache_create(cache_name, sdh->name, NU_SDH_CACHE_BLOCKS) != RT_NULL)
+    {
+        dev_name = cache_name;
+    }
+#endif
+
+    if ((ret = dfs_mount(dev_name, sdh->mounted_point, "elm", 0, 0)) == 0)
+    {
+        rt_kprintf("Mounted %s on %s\n", dev_name, sdh->mounted_point);
     }
     else
     {
-        rt_kprintf("Failed to mount %s on %s\n", sdh->name, sdh->mounted_point);
+        rt_kprintf("Failed to mount %s on %s\n", dev_name, sdh->mounted_point);
         ret = RT_ERROR;
     }
 
@@ -678,6 +800,18 @@ static rt_err_t nu_sdh_hotplug_unmount(nu_sdh_t sdh)
 {
     rt_err_t ret = RT_ERROR;
 
+#if defined(NU_SDH_CACHE)
+    {
+        char cache_name[RT_NAME_MAX];
+        rt_device_t cache;
+
+        /* The card is gone, the dirty blocks can't be written back. */
+        rt_snprintf(cache_name, sizeof(cache_name), "%sc", sdh->name);
+        if ((cache = rt_device_find(cache_name)) != RT_NULL)
+            rt_blk_cache_invalidate(cache);
+    }
+#endif
+
     /* Due to file handgle still is opening, it will get a hang when call un-mount action. */
     if (0)
     {
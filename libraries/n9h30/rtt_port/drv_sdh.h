@@ -0,0 +1,82 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-16      Wayne        First version
+*
+******************************************************************************/
+
+#ifndef __DRV_SDH_H__
+#define __DRV_SDH_H__
+
+#include <rtthread.h>
+
+/* Extended controls of the sdh devices */
+#define NU_SDH_CTRL_GET_STAT        (RT_DEVICE_CTRL_BASE(Block) + 0x30)  /* nu_sdh_stat_t */
+#define NU_SDH_CTRL_RESET_STAT      (RT_DEVICE_CTRL_BASE(Block) + 0x31)  /* RT_NULL */
+
+/* The DMA address must be word-aligned, other buffers go through the bounce buffer. */
+#define NU_SDH_DMA_ALIGN            4
+
+/* Commands of 1, 2-3, 4-7, ..., 128-255 and 256 or more blocks */
+#define NU_SDH_STAT_SIZES           9
+
+typedef struct
+{
+    rt_uint32_t cmds;           /* Read or write commands */
+    rt_uint32_t blocks;         /* Blocks transferred */
+    rt_uint32_t bounced;        /* Blocks through the bounce buffer */
+    rt_uint32_t errors;         /* Failed commands */
+    rt_uint32_t sizes[NU_SDH_STAT_SIZES];   /* Commands by size */
+    rt_uint32_t lat_min;        /* Latency of a command in microseconds */
+    rt_uint32_t lat_max;
+    rt_uint64_t lat_total;
+} nu_sdh_xfer_stat_t;
+
+typedef struct
+{
+    nu_sdh_xfer_stat_t read;
+    nu_sdh_xfer_stat_t write;
+} nu_sdh_stat_t;
+
+/**
+ * Size the next command of a request. The blocks go to the buffer directly if the DMA
+ * can take it, or through a bounce buffer of bounce_blocks blocks if not.
+ *
+ * @param buffer        the buffer of the request
+ * @param done          blocks of the request transferred
+ * @param blocks        blocks of the request
+ * @param bounce_blocks size of the bounce buffer in blocks
+ * @param bounce        [out] RT_TRUE: the command goes through the bounce buffer
+ *
+ * @return blocks of the next command, 0 if the request is done
+ */
+rt_inline rt_uint32_t nu_sdh_split(const void *buffer, rt_uint32_t done, rt_uint32_t blocks,
+                                   rt_uint32_t bounce_blocks, rt_bool_t *bounce)
+{
+    rt_uint32_t left = blocks - done;
+
+    *bounce = (((rt_ubase_t)buffer & (NU_SDH_DMA_ALIGN - 1)) != 0) ? RT_TRUE : RT_FALSE;
+
+    if (*bounce && (left > bounce_blocks))
+        return bounce_blocks;
+
+    return left;
+}
+
+/* The index of nu_sdh_xfer_stat_t.sizes for a command of `blocks` blocks */
+rt_inline int nu_sdh_stat_size_index(rt_uint32_t blocks)
+{
+    int i = 0;
+
+    while ((blocks >>= 1) && (i < NU_SDH_STAT_SIZES - 1))
+        i++;
+
+    return i;
+}
+
+#endif /* __DRV_SDH_H__ */
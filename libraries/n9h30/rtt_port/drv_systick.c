@@ -7,10 +7,14 @@
 * Change Logs:
 * Date            Author           Notes
 * 2020-11-11      Wayne            First version
+* 2026-10-16      Wayne            Support tickless idle
+* 2026-10-16      Wayne            Provide cputime ops
 *
 ******************************************************************************/
 
 #include "rtthread.h"
+#include "rthw.h"
+#include "rtdevice.h"
 #include "NuMicro.h"
 #include "drv_sys.h"
 #include "nu_timer.h"
@@ -30,8 +34,133 @@
 
 #define SYSTICK_RST           CONCAT3(TIMER, USE_TIMER, RST)
 
+/* Counter value of one tick period. */
+static rt_uint32_t s_u32TickPeriod;
+
+#if defined(RT_USING_TICKLESS)
+
+/* The timer counter is 24-bit wide. */
+#define TICKLESS_COUNTER_MAX    0xFFFFFFUL
+
+/* Don't program the compare value too close to the running counter. */
+#define TICKLESS_MARGIN         (s_u32TickPeriod / 16)
+
+/* The compare value is stretched, restore it at next tick interrupt. */
+static volatile rt_uint32_t s_u32TicklessRestore = 0;
+
+static void nu_cpu_wait_for_interrupt(void)
+{
+    rt_uint32_t value = 0;
+
+    /* ARM926EJ-S wakes up on IRQ even if it is masked in CPSR. */
+#if defined(__CC_ARM)
+    __asm volatile { mcr p15, 0, value, c7, c0, 4 }
+#elif defined( __GNUC__ )
+    __asm volatile("mcr p15, 0, %0, c7, c0, 4" :: "r"(value));
+#endif
+}
+
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t tick)
+{
+    rt_uint32_t u32Cnt, u32Elapsed;
+    rt_tick_t max_tick = TICKLESS_COUNTER_MAX / s_u32TickPeriod;
+
+    /* A tick is pending or the last sleep is not over yet. */
+    if (TIMER_GetIntFlag(USE_TIMER) || s_u32TicklessRestore)
+        return 0;
+
+    if (tick > max_tick)
+        tick = max_tick;
+
+    /* Stretch current period, the counter keeps its phase. */
+    s_u32TicklessRestore = 1;
+    TIMER_SET_CMP_VALUE(USE_TIMER, tick * s_u32TickPeriod);
+
+    /* The tick boundary was crossed before stretching, the stretched period just starts. */
+    if (TIMER_GetIntFlag(USE_TIMER))
+        return 0;
+
+    nu_cpu_wait_for_interrupt();
+
+    u32Cnt = TIMER_GetCounter(USE_TIMER);
+    if (TIMER_GetIntFlag(USE_TIMER))
+    {
+        /* Slept to the end, the pending tick interrupt reports the last tick. */
+        return tick - 1;
+    }
+
+    /* Woken up by others, end the stretched period at next tick boundary. */
+    u32Elapsed = u32Cnt / s_u32TickPeriod;
+    if (((u32Elapsed + 1) * s_u32TickPeriod - u32Cnt) < TICKLESS_MARGIN)
+    {
+        if ((u32Elapsed + 1) >= tick)
+            return tick - 1;
+
+        /* Too close to program, let the boundary pass and end the period at the next one. */
+        while (TIMER_GetCounter(USE_TIMER) < (u32Elapsed + 1) * s_u32TickPeriod);
+        u32Elapsed++;
+    }
+
+    TIMER_SET_CMP_VALUE(USE_TIMER, (u32Elapsed + 1) * s_u32TickPeriod);
+
+    return u32Elapsed;
+}
+
+#endif /* RT_USING_TICKLESS */
+
+#if defined(RT_USING_CPUTIME)
+
+static float nu_cputime_getres(void)
+{
+    /* Nanosecond per counter step. */
+    return 1000000000.0f / TIMER_GetModuleClock(USE_TIMER);
+}
+
+static uint64_t nu_cputime_gettime(void)
+{
+    rt_base_t level;
+    rt_tick_t tick;
+    rt_uint32_t u32Cnt;
+
+    level = rt_hw_interrupt_disable();
+
+    tick = rt_tick_get();
+    u32Cnt = TIMER_GetCounter(USE_TIMER);
+    if (TIMER_GetIntFlag(USE_TIMER))
+    {
+        /* The counter was restarted, but the tick is not reported yet. */
+        u32Cnt = TIMER_GetCounter(USE_TIMER);
+        tick++;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    /* The compare value may be stretched by tickless idle, keep the phase only. */
+    return (uint64_t)tick * s_u32TickPeriod + (u32Cnt % s_u32TickPeriod);
+}
+
+static const struct rt_clock_cputime_ops nu_cputime_ops =
+{
+    nu_cputime_getres,
+    nu_cputime_gettime
+};
+
+#endif /* RT_USING_CPUTIME */
+
 static void nu_systick_isr(int vector, void *param)
 {
+#if defined(RT_USING_TICKLESS)
+    if (s_u32TicklessRestore)
+    {
+        /* Back to periodic tick. */
+        TIMER_SET_CMP_VALUE(USE_TIMER, s_u32TickPeriod);
+        if (TIMER_GetCounter(USE_TIMER) >= s_u32TickPeriod)
+            TIMER_ClearCounter(USE_TIMER);
+
+        s_u32TicklessRestore = 0;
+    }
+#endif
+
     rt_tick_increase();
     TIMER_ClearIntFlag(USE_TIMER);
 }
@@ -44,6 +173,7 @@ void rt_hw_systick_init(void)
 
     // Set timer frequency
     TIMER_Open(USE_TIMER, TIMER_PERIODIC_MODE, RT_TICK_PER_SECOND);
+    s_u32TickPeriod = TIMER_GetCompareData(USE_TIMER);
 
     // Enable timer interrupt
     TIMER_EnableInt(USE_TIMER);
@@ -53,31 +183,36 @@ void rt_hw_systick_init(void)
     rt_hw_interrupt_umask(SYSTICK_IRQ);
 
     TIMER_Start(USE_TIMER);
+
+#if defined(RT_USING_CPUTIME)
+    clock_cpu_setops(&nu_cputime_ops);
+#endif
 } /* rt_hw_systick_init */
 
 void rt_hw_us_delay(rt_uint32_t us)
 {
     rt_uint32_t ticks;
     rt_uint32_t told, tnow, tcnt = 0;
-    rt_uint32_t cmp = TIMER_GetCompareData(USE_TIMER);
 
-    ticks = us * cmp / (1000000 / RT_TICK_PER_SECOND);
-    told = TIMER_GetCounter(USE_TIMER);
+    ticks = us * s_u32TickPeriod / (1000000 / RT_TICK_PER_SECOND);
+
+    /* The compare value may be stretched by tickless idle, count the phase in a tick period only. */
+    told = TIMER_GetCounter(USE_TIMER) % s_u32TickPeriod;
     while (1)
     {
         /* Timer counter is increment. */
-        tnow = TIMER_GetCounter(USE_TIMER);
+        tnow = TIMER_GetCounter(USE_TIMER) % s_u32TickPeriod;
         if (tnow != told)
         {
-            /* 0 -- old === now -------- cmp */
+            /* 0 -- old === now -------- period */
             if (tnow > told)
             {
                 tcnt += tnow - told;
             }
             else
             {
-                /* 0 == now --- old ======== cmp */
-                tcnt += cmp - told + tnow;
+                /* 0 == now --- old ======== period */
+                tcnt += s_u32TickPeriod - told + tnow;
             }
             told = tnow;
 
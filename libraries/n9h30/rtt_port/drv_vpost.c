@@ -7,6 +7,8 @@
 * Change Logs:
 * Date            Author       Notes
 * 2021-4-13       Wayne        First version
+* 2026-10-16      Wayne        Show the panned buffers at vsync with fences and statistics
+* 2026-10-16      Wayne        Add colour key control of OSD layer
 *
 ******************************************************************************/
 
@@ -19,12 +21,24 @@
 #include <rtdbg.h>
 #include "NuMicro.h"
 #include <drv_sys.h>
+#include "drv_vpost.h"
 
 /* Private typedef --------------------------------------------------------------*/
 
 #define DEF_VPOST_BUFFER_NUMBER 3
 #define DEF_DEBUG_FPS_URPS      0
 
+/* One buffer is scanned and one is rendered, the others could wait for vsync. */
+#define DEF_VPOST_QUEUE_DEPTH   ((DEF_VPOST_BUFFER_NUMBER > 2) ? (DEF_VPOST_BUFFER_NUMBER - 2) : 1)
+
+/* Period of the software vsync while the panel is stopped */
+#define DEF_VPOST_SOFT_VSYNC_HZ 60
+
+/* Give up waiting for a vsync after this period */
+#define DEF_VPOST_VSYNC_TIMEOUT (RT_TICK_PER_SECOND / 10)
+
+#define EVT_VSYNC               (1 << 0)
+
 typedef enum
 {
     eVpost_LCD,
@@ -34,6 +48,13 @@ typedef enum
     eVpost_Cnt
 } E_VPOST_LAYER;
 
+typedef struct
+{
+    void       *buf;
+    uint32_t    due;        /* The vsync to show the frame at */
+    uint32_t    missed;     /* Submitted after the target vsync */
+} nu_vpost_frame_t;
+
 struct nu_vpost
 {
     struct rt_device      dev;
@@ -42,14 +63,26 @@ struct nu_vpost
     IRQn_Type             irqn;
     E_SYS_IPRST           rstidx;
     E_SYS_IPCLK           clkidx;
-    uint32_t              last_commit;
     struct rt_device_graphic_info info;
+
+    /* Frames waiting for vsync, the fences count the submitted and the shown frames. */
+    nu_vpost_frame_t      queue[DEF_VPOST_QUEUE_DEPTH];
+    uint32_t              queue_head;
+    uint32_t              queue_count;
+    uint32_t              fence_submitted;
+    uint32_t              fence_shown;
+    nu_vpost_stat_t       stat;
 };
 typedef struct nu_vpost *nu_vpost_t;
 
 static volatile uint32_t s_u32VSyncBlank = 0;
 static volatile uint32_t s_u32UnderRun = 0;
-static struct rt_completion vsync_wq;
+static volatile uint64_t s_u64VSyncTime = 0;
+static volatile uint32_t s_u32VSyncPeriod = 0;
+static struct rt_event s_sVSyncEvent;
+
+/* Vsync is generated by a timer while the panel is stopped. */
+static struct rt_timer s_sSoftVSync;
 
 static struct nu_vpost nu_fbdev[eVpost_Cnt] =
 {
@@ -74,6 +107,183 @@ static struct nu_vpost nu_fbdev[eVpost_Cnt] =
 RT_WEAK void nu_lcd_backlight_on(void) { }
 
 RT_WEAK void nu_lcd_backlight_off(void) { }
+
+static uint64_t nu_vpost_get_time_us(void)
+{
+#if defined(RT_USING_CPUTIME)
+    static uint32_t u32StepPerUs = 0;
+
+    if (u32StepPerUs == 0)
+        u32StepPerUs = (uint32_t)(1000.0f / clock_cpu_getres());
+
+    return clock_cpu_gettime() / u32StepPerUs;
+#else
+    return (uint64_t)rt_tick_get() * (1000000 / RT_TICK_PER_SECOND);
+#endif
+}
+
+static void nu_vpost_set_buffer(nu_vpost_t psVpost, void *pvBuf)
+{
+    switch (psVpost->layer)
+    {
+    case eVpost_LCD:
+        vpostSetFrameBuffer(pvBuf);
+        break;
+
+#if defined(BSP_USING_VPOST_OSD)
+    case eVpost_OSD:
+        vpostSetOSDBuffer(pvBuf);
+        break;
+#endif
+
+    default:
+        break;
+    }
+}
+
+/* Called at the start of vertical blanking, the queued frame is shown from the next scan. */
+static void nu_vpost_vsync(void)
+{
+    uint64_t u64Now = nu_vpost_get_time_us();
+    uint32_t u32Period;
+    int i;
+
+    s_u32VSyncBlank++;
+
+    if (s_u64VSyncTime != 0)
+    {
+        u32Period = (uint32_t)(u64Now - s_u64VSyncTime);
+        s_u32VSyncPeriod = s_u32VSyncPeriod ? ((s_u32VSyncPeriod * 7 + u32Period) / 8) : u32Period;
+    }
+    s_u64VSyncTime = u64Now;
+
+    for (i = eVpost_LCD; i < eVpost_Cnt; i++)
+    {
+        nu_vpost_t psVpost = &nu_fbdev[i];
+        nu_vpost_frame_t *psFrame = &psVpost->queue[psVpost->queue_head];
+
+        if ((psVpost->queue_count == 0) || ((int32_t)(s_u32VSyncBlank - psFrame->due) < 0))
+        {
+            if (psVpost->dev.ref_count)
+                psVpost->stat.repeats++;
+            continue;
+        }
+
+        nu_vpost_set_buffer(psVpost, psFrame->buf);
+
+        if (s_u32VSyncBlank != psFrame->due)
+            psVpost->stat.late++;
+        if (psFrame->missed)
+            psVpost->stat.missed++;
+        psVpost->stat.presented++;
+
+        psVpost->queue_head = (psVpost->queue_head + 1) % DEF_VPOST_QUEUE_DEPTH;
+        psVpost->queue_count--;
+        psVpost->fence_shown++;
+    }
+
+    rt_event_send(&s_sVSyncEvent, EVT_VSYNC);
+}
+
+static void nu_vpost_soft_vsync(void *parameter)
+{
+    nu_vpost_vsync();
+}
+
+static void nu_vpost_start(void)
+{
+    rt_timer_stop(&s_sSoftVSync);
+    vpostVAStartTrigger();
+}
+
+static void nu_vpost_stop(void)
+{
+    vpostVAStopTrigger();
+    rt_timer_start(&s_sSoftVSync);
+}
+
+static void nu_vpost_get_vsync(nu_vpost_vsync_t *psVSync)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    psVSync->count = s_u32VSyncBlank;
+    psVSync->timestamp = s_u64VSyncTime;
+    psVSync->period = s_u32VSyncPeriod;
+
+    rt_hw_interrupt_enable(level);
+}
+
+/* Wait until the vsync counter reaches u32Count. */
+static rt_err_t nu_vpost_wait_vsync(uint32_t u32Count)
+{
+    rt_uint32_t u32Recved;
+
+    while ((int32_t)(s_u32VSyncBlank - u32Count) < 0)
+    {
+        /* A stale event only costs a loop. */
+        if (rt_event_recv(&s_sVSyncEvent, EVT_VSYNC, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                          DEF_VPOST_VSYNC_TIMEOUT, &u32Recved) != RT_EOK)
+            return -RT_ETIMEOUT;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t nu_vpost_wait_fence(nu_vpost_t psVpost, uint32_t u32Fence)
+{
+    while ((int32_t)(psVpost->fence_shown - u32Fence) < 0)
+    {
+        if (nu_vpost_wait_vsync(s_u32VSyncBlank + 1) != RT_EOK)
+            return -RT_ETIMEOUT;
+    }
+
+    return RT_EOK;
+}
+
+/* Queue a frame for vsync, wait if the queue is full. A frame is never dropped or shown twice. */
+static rt_err_t nu_vpost_submit(nu_vpost_t psVpost, nu_vpost_submit_t *psSubmit)
+{
+    nu_vpost_frame_t *psFrame;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+
+    if (psVpost->queue_count == DEF_VPOST_QUEUE_DEPTH)
+        psVpost->stat.stalls++;
+
+    while (psVpost->queue_count == DEF_VPOST_QUEUE_DEPTH)
+    {
+        uint32_t u32Next = s_u32VSyncBlank + 1;
+
+        rt_hw_interrupt_enable(level);
+
+        if (nu_vpost_wait_vsync(u32Next) != RT_EOK)
+            return -RT_ETIMEOUT;
+
+        level = rt_hw_interrupt_disable();
+    }
+
+    psFrame = &psVpost->queue[(psVpost->queue_head + psVpost->queue_count) % DEF_VPOST_QUEUE_DEPTH];
+    psFrame->buf = psSubmit->buf;
+    psFrame->due = s_u32VSyncBlank + 1;
+    psFrame->missed = 0;
+
+    if (psSubmit->target != 0)
+    {
+        if ((int32_t)(psSubmit->target - psFrame->due) > 0)
+            psFrame->due = psSubmit->target;
+        else if ((int32_t)(psSubmit->target - psFrame->due) < 0)
+            psFrame->missed = 1;
+    }
+
+    psVpost->queue_count++;
+    psSubmit->fence = ++psVpost->fence_submitted;
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
 static rt_err_t vpost_layer_open(rt_device_t dev, rt_uint16_t oflag)
 {
     nu_vpost_t psVpost = (nu_vpost_t)dev;
@@ -82,12 +292,12 @@ static rt_err_t vpost_layer_open(rt_device_t dev, rt_uint16_t oflag)
     switch (psVpost->layer)
     {
     case eVpost_LCD:
-        vpostVAStartTrigger();
+        nu_vpost_start();
         break;
 
 #if defined(BSP_USING_VPOST_OSD)
     case eVpost_OSD:
-        vpostVAStartTrigger();
+        nu_vpost_start();
 
         /* Set scale to 1:1 */
         vpostOSDScalingCtrl(1, 0, 0);
@@ -126,7 +336,7 @@ static rt_err_t vpost_layer_close(rt_device_t dev)
 #if defined(BSP_USING_VPOST_OSD)
         if (nu_fbdev[eVpost_OSD].dev.ref_count == 0)
 #endif
-            vpostVAStopTrigger();
+            nu_vpost_stop();
         break;
 
 #if defined(BSP_USING_VPOST_OSD)
@@ -135,7 +345,7 @@ static rt_err_t vpost_layer_close(rt_device_t dev)
         if (nu_fbdev[eVpost_LCD].dev.ref_count == 0)
         {
             /* Also stop displaying */
-            vpostVAStopTrigger();
+            nu_vpost_stop();
         }
         break;
 #endif
@@ -176,47 +386,91 @@ static rt_err_t vpost_layer_control(rt_device_t dev, int cmd, void *args)
 
     case RTGRAPHIC_CTRL_PAN_DISPLAY:
     {
+        nu_vpost_submit_t sSubmit = { .buf = args };
+
+        if (args == RT_NULL)
+            return -RT_ERROR;
+
+        /* Pan display at next vsync */
+        return nu_vpost_submit(psVpost, &sSubmit);
+    }
+
+    case RTGRAPHIC_CTRL_WAIT_VSYNC:
+    {
+        /* Wait for the next vsync, or until the panned buffers are shown. */
         if (args != RT_NULL)
-        {
-            uint8_t *pu8BufPtr = (uint8_t *)args;
+            return nu_vpost_wait_vsync(s_u32VSyncBlank + 1);
 
-            psVpost->last_commit = s_u32VSyncBlank;
+        return nu_vpost_wait_fence(psVpost, psVpost->fence_submitted);
+    }
 
-            /* Pan display */
-            switch (psVpost->layer)
-            {
-            case eVpost_LCD:
-                vpostSetFrameBuffer(pu8BufPtr);
-                break;
+    case NU_VPOST_CTRL_SUBMIT:
+    {
+        RT_ASSERT(args != RT_NULL);
+        return nu_vpost_submit(psVpost, (nu_vpost_submit_t *)args);
+    }
 
-#if defined(BSP_USING_VPOST_OSD)
-            case eVpost_OSD:
-                vpostSetOSDBuffer(pu8BufPtr);
-                break;
-#endif
+    case NU_VPOST_CTRL_WAIT_FENCE:
+    {
+        RT_ASSERT(args != RT_NULL);
+        return nu_vpost_wait_fence(psVpost, *(rt_uint32_t *)args);
+    }
 
-            default:
-                return -RT_ERROR;
-            }
+    case NU_VPOST_CTRL_GET_VSYNC:
+    {
+        RT_ASSERT(args != RT_NULL);
+        nu_vpost_get_vsync((nu_vpost_vsync_t *)args);
+    }
+    break;
 
-        }
-        else
-            return -RT_ERROR;
+    case NU_VPOST_CTRL_WAIT_NEXT_VSYNC:
+    {
+        rt_err_t ret;
+
+        RT_ASSERT(args != RT_NULL);
+        ret = nu_vpost_wait_vsync(s_u32VSyncBlank + 1);
+        nu_vpost_get_vsync((nu_vpost_vsync_t *)args);
+
+        return ret;
+    }
+
+    case NU_VPOST_CTRL_GET_STAT:
+    {
+        nu_vpost_stat_t *psStat = (nu_vpost_stat_t *)args;
+        rt_base_t level;
+
+        RT_ASSERT(psStat != RT_NULL);
+
+        level = rt_hw_interrupt_disable();
+        *psStat = psVpost->stat;
+        psStat->vsyncs = s_u32VSyncBlank;
+        psStat->underruns = s_u32UnderRun;
+        rt_hw_interrupt_enable(level);
     }
     break;
 
-    case RTGRAPHIC_CTRL_WAIT_VSYNC:
+#if defined(BSP_USING_VPOST_OSD)
+    case NU_VPOST_CTRL_SET_COLKEY:
     {
-        if (args != RT_NULL)
-            psVpost->last_commit = s_u32VSyncBlank + 1;
+        rt_uint32_t u32Key;
 
-        if (psVpost->last_commit >= s_u32VSyncBlank)
+        if (psVpost->layer != eVpost_OSD)
+            return -RT_ERROR;
+
+        if (args == RT_NULL)
         {
-            rt_completion_init(&vsync_wq);
-            rt_completion_wait(&vsync_wq, RT_TICK_PER_SECOND / 60);
+            /* Show OSD data everywhere. */
+            vpostOSDSetOverlay(DISPLAY_OSD, DISPLAY_OSD, 0);
+            break;
         }
+
+        /* The video data is shown where the OSD data matches the key. */
+        u32Key = *(rt_uint32_t *)args;
+        vpostOSDSetColKey((u32Key >> 16) & 0xff, (u32Key >> 8) & 0xff, u32Key & 0xff);
+        vpostOSDSetOverlay(DISPLAY_VIDEO, DISPLAY_OSD, 0);
     }
     break;
+#endif
 
     default:
         return -RT_ERROR;
@@ -233,7 +487,6 @@ static rt_err_t vpost_layer_init(rt_device_t dev)
     /* Enable VPOST engine clock. */
     nu_sys_ipclk_enable(LCDCKEN);
 
-    rt_completion_init(&vsync_wq);
     outpw(REG_LCM_INT_CS, VPOSTB_UNDERRUN_EN | VPOSTB_DISP_F_EN);
     outpw(REG_LCM_DCCS, (inpw(REG_LCM_DCCS) | (1 << 4)));
 
@@ -278,8 +531,7 @@ static void nu_vpost_isr(int vector, void *param)
     {
         outpw(REG_LCM_INT_CS, inpw(REG_LCM_INT_CS) | VPOSTB_DISP_F_STATUS);
 
-        s_u32VSyncBlank++;
-        rt_completion_done(&vsync_wq);
+        nu_vpost_vsync();
     }
     else if (u32VpostIRQStatus & VPOSTB_UNDERRUN_INT)
     {
@@ -327,6 +579,14 @@ int rt_hw_vpost_init(void)
     /* Set scale to 1:1 */
     vpostVAScalingCtrl(1, 0, 1, 0, VA_SCALE_INTERPOLATION);
 
+    rt_event_init(&s_sVSyncEvent, "vsync", RT_IPC_FLAG_PRIO);
+
+    /* The panel is stopped until a layer is opened. */
+    rt_timer_init(&s_sSoftVSync, "vsync", nu_vpost_soft_vsync, RT_NULL,
+                  (RT_TICK_PER_SECOND + DEF_VPOST_SOFT_VSYNC_HZ - 1) / DEF_VPOST_SOFT_VSYNC_HZ,
+                  RT_TIMER_FLAG_PERIODIC);
+    rt_timer_start(&s_sSoftVSync);
+
     for (i = eVpost_LCD; i < eVpost_Cnt; i++)
     {
         nu_vpost_t psVpost = &nu_fbdev[i];
@@ -497,4 +757,26 @@ static rt_err_t vpost_fill_color(int argc, char **argv)
 }
 MSH_CMD_EXPORT(vpost_fill_color, e.g: vpost_fill_color layer R G B);
 
+/* Support "vpost_stat" command line in msh mode */
+static rt_err_t vpost_stat(int argc, char **argv)
+{
+    nu_vpost_vsync_t sVSync;
+    nu_vpost_stat_t sStat;
+    int i;
+
+    nu_vpost_get_vsync(&sVSync);
+    rt_kprintf("vsync: %d, period: %dus\n", sVSync.count, sVSync.period);
+
+    for (i = eVpost_LCD; i < eVpost_Cnt; i++)
+    {
+        vpost_layer_control(&nu_fbdev[i].dev, NU_VPOST_CTRL_GET_STAT, &sStat);
+        rt_kprintf("%s: presented %d, late %d, missed %d, repeats %d, stalls %d, underruns %d\n",
+                   nu_fbdev[i].name, sStat.presented, sStat.late, sStat.missed,
+                   sStat.repeats, sStat.stalls, sStat.underruns);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(vpost_stat, show frame statistics);
+
 #endif /* if defined(BSP_USING_VPOST) */
@@ -0,0 +1,52 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-16      Wayne        First version
+* 2026-10-16      Wayne        Add NU_VPOST_CTRL_SET_COLKEY
+*
+******************************************************************************/
+
+#ifndef __DRV_VPOST_H__
+#define __DRV_VPOST_H__
+
+#include <rtthread.h>
+
+/* Extended controls of the lcd and osd devices */
+#define NU_VPOST_CTRL_SUBMIT            (RT_DEVICE_CTRL_BASE(Graphic) + 0x30)  /* nu_vpost_submit_t */
+#define NU_VPOST_CTRL_WAIT_FENCE        (RT_DEVICE_CTRL_BASE(Graphic) + 0x31)  /* rt_uint32_t, fence to wait for */
+#define NU_VPOST_CTRL_GET_VSYNC         (RT_DEVICE_CTRL_BASE(Graphic) + 0x32)  /* nu_vpost_vsync_t, the last vsync */
+#define NU_VPOST_CTRL_WAIT_NEXT_VSYNC   (RT_DEVICE_CTRL_BASE(Graphic) + 0x33)  /* nu_vpost_vsync_t, the next vsync */
+#define NU_VPOST_CTRL_GET_STAT          (RT_DEVICE_CTRL_BASE(Graphic) + 0x34)  /* nu_vpost_stat_t */
+#define NU_VPOST_CTRL_SET_COLKEY        (RT_DEVICE_CTRL_BASE(Graphic) + 0x35)  /* rt_uint32_t, 0xRRGGBB of OSD source, RT_NULL: disable */
+
+typedef struct
+{
+    rt_uint32_t count;          /* Number of the vsync */
+    rt_uint64_t timestamp;      /* Time of the vsync in microseconds */
+    rt_uint32_t period;         /* Average frame period in microseconds */
+} nu_vpost_vsync_t;
+
+typedef struct
+{
+    void       *buf;            /* Frame buffer to show */
+    rt_uint32_t target;         /* Show at this vsync or later, 0: at next vsync */
+    rt_uint32_t fence;          /* [out] Fence of the frame, it is signaled when the frame is shown */
+} nu_vpost_submit_t;
+
+typedef struct
+{
+    rt_uint32_t vsyncs;         /* Vsync events */
+    rt_uint32_t presented;      /* Frames shown */
+    rt_uint32_t late;           /* Frames shown after their due vsync */
+    rt_uint32_t missed;         /* Frames submitted after their target vsync */
+    rt_uint32_t repeats;        /* Vsyncs without a new frame */
+    rt_uint32_t stalls;         /* Submissions waiting for a free queue entry */
+    rt_uint32_t underruns;      /* FIFO under-runs */
+} nu_vpost_stat_t;
+
+#endif /* __DRV_VPOST_H__ */
@@ -7,6 +7,7 @@
 * Change Logs:
 * Date            Author       Notes
 * 2022-5-22       Wayne        First version
+* 2026-10-16      Wayne        Read and write the spare area of a page
 *
 ******************************************************************************/
 
@@ -111,6 +112,42 @@ static rt_err_t nu_fminand_read_page(struct rt_mtd_nand_device *device,
     result = rt_mutex_take(FMINAND_FLASH_LOCK, RT_WAITING_FOREVER);
     RT_ASSERT(result == RT_EOK);
 
+    if (spare && spare_len)
+    {
+        /* The page itself, not skipping bad blocks: a user of the spare area manages them. */
+        struct mtd_oob_ops ops;
+        int ret;
+
+        rt_memset(&ops, 0, sizeof(ops));
+        if (spare_len > FMINAND_MTD_INFO->oobavail)
+        {
+            /* The whole spare area as placed on the flash, for inspection only: it can't be written so. */
+            ops.mode   = MTD_OPS_PLACE_OOB;
+            ops.ooblen = (spare_len < FMINAND_MTD_INFO->oobsize) ? spare_len : FMINAND_MTD_INFO->oobsize;
+        }
+        else
+        {
+            /* The free bytes of the spare area. */
+            ops.mode   = MTD_OPS_AUTO_OOB;
+            ops.ooblen = spare_len;
+        }
+        ops.oobbuf = spare;
+        ops.datbuf = (data && data_len) ? data : NULL;
+        ops.len    = ops.datbuf ? data_len : 0;
+
+        ret = mtd_read_oob(FMINAND_MTD_INFO, (loff_t)FMINAND_MTD_INFO->writesize * page, &ops);
+        if (ret == -EUCLEAN)
+        {
+            /* Corrected bit-flips. */
+            ret = 0;
+        }
+
+        if (ret != 0)
+            result = (ret == -EBADMSG) ? -RT_MTD_EECC : -RT_MTD_EIO;
+
+        goto exit_nu_fminand_read_page;
+    }
+
     if (data && data_len)
     {
         int ret = nand_read_skip_bad(FMINAND_MTD_INFO, FMINAND_MTD_INFO->writesize * page, &data_len, NULL, FMINAND_MTD_INFO->size, (u_char *)data);
@@ -158,6 +195,34 @@ static rt_err_t nu_fminand_write_page(struct rt_mtd_nand_device *device,
     result = rt_mutex_take(FMINAND_FLASH_LOCK, RT_WAITING_FOREVER);
     RT_ASSERT(result == RT_EOK);
 
+    if (spare && spare_len)
+    {
+        /* The page itself with the free bytes of the spare area, not skipping bad blocks. */
+        struct mtd_oob_ops ops;
+        int ret;
+
+        /* The rest of the spare area holds the bad block marker and ECC, it is never written. */
+        if (spare_len > FMINAND_MTD_INFO->oobavail)
+        {
+            LOG_E("[EIO] write page:%d, spare: %d > %d free bytes", page, spare_len, FMINAND_MTD_INFO->oobavail);
+            result = -RT_MTD_EIO;
+            goto exit_nu_fminand_write_page;
+        }
+
+        rt_memset(&ops, 0, sizeof(ops));
+        ops.mode   = MTD_OPS_AUTO_OOB;
+        ops.ooblen = spare_len;
+        ops.oobbuf = (uint8_t *)spare;
+        ops.datbuf = (data && data_len) ? (uint8_t *)data : NULL;
+        ops.len    = ops.datbuf ? data_len : 0;
+
+        ret = mtd_write_oob(FMINAND_MTD_INFO, (loff_t)FMINAND_MTD_INFO->writesize * page, &ops);
+        if (ret != 0)
+            result = -RT_MTD_EIO;
+
+        goto exit_nu_fminand_write_page;
+    }
+
     /* Read data: 0~2111, to cache */
     if (data && data_len)
     {
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-10-18     Meco Man     the first version
  * 2022-05-10     Meco Man     improve rt-thread initialization process
+ * 2026-10-16     Wayne        let the display port pace the handler
  */
 
 #ifdef __RTTHREAD__
@@ -46,6 +47,12 @@ static void lv_rt_log(const char *buf)
 }
 #endif /* LV_USE_LOG */
 
+/* The display port could override it to run the handler at vsync. */
+RT_WEAK void lv_port_frame_wait(void)
+{
+    rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+}
+
 static void lvgl_thread_entry(void *parameter)
 {
 #if LV_USE_LOG
@@ -60,7 +67,7 @@ static void lvgl_thread_entry(void *parameter)
     while(1)
     {
         lv_task_handler();
-        rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+        lv_port_frame_wait();
     }
 }
 
@@ -11,6 +11,10 @@
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
 
+#ifdef LV_DRAW_SW_ASM_INCLUDE
+    #include LV_DRAW_SW_ASM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -240,6 +244,12 @@ static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_
 LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                               lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
 {
+#ifdef LV_DRAW_SW_FILL_NORMAL
+    /*Replaced by the kernel of the platform*/
+    LV_DRAW_SW_FILL_NORMAL(dest_buf, dest_area, dest_stride, color, opa, mask, mask_stride);
+    return;
+#endif
+
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
@@ -637,6 +647,12 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
                                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
 
 {
+#ifdef LV_DRAW_SW_MAP_NORMAL
+    /*Replaced by the kernel of the platform*/
+    LV_DRAW_SW_MAP_NORMAL(dest_buf, dest_area, dest_stride, src_buf, src_stride, opa, mask, mask_stride);
+    return;
+#endif
+
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
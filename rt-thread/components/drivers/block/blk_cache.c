@@ -0,0 +1,797 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/blk_cache.h>
+#include <stdlib.h>
+
+#define DBG_TAG    "blk.cache"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#ifndef RT_BLK_CACHE_FLUSH_PERIOD
+#define RT_BLK_CACHE_FLUSH_PERIOD   1000
+#endif
+
+#ifndef RT_BLK_CACHE_READ_AHEAD
+#define RT_BLK_CACHE_READ_AHEAD     8
+#endif
+
+/* the most dirty blocks on consecutive sectors written in one request */
+#define BLK_CACHE_WB_BATCH          8
+
+/* the buffers are aligned to a cache line, so DMA of a block never shares one */
+#define BLK_CACHE_ALIGN             32
+
+#define BLK_CACHE_INVALID           ((rt_uint32_t)-1)
+
+struct blk_cache_entry
+{
+    rt_uint32_t sector;                     /* BLK_CACHE_INVALID if unused */
+    rt_uint32_t dirty;
+    rt_uint8_t *data;
+    rt_list_t lru;                          /* node of lru_list, the most recently used first */
+    rt_list_t dirty_node;                   /* node of dirty_list, in the order of dirtying */
+    struct blk_cache_entry *hash_next;
+};
+
+struct blk_cache
+{
+    struct rt_device parent;
+    rt_device_t lower;
+    struct rt_device_blk_geometry geometry;
+
+    struct rt_mutex lock;
+    struct blk_cache_entry *entries;
+    struct blk_cache_entry **hash;
+    rt_uint32_t hash_mask;
+    rt_uint8_t *data;
+    rt_uint8_t *wb_buf;                     /* BLK_CACHE_WB_BATCH blocks */
+    rt_uint8_t *ra_buf;                     /* RT_BLK_CACHE_READ_AHEAD blocks */
+    rt_list_t lru_list;
+    rt_list_t dirty_list;
+
+    rt_uint32_t next_sector;                /* the sector after the last read, for sequential reading */
+    rt_int32_t fault;                       /* blocks the lower device still takes, -1: no injection */
+    struct rt_work flush_work;
+    rt_bool_t flush_pending;
+
+    struct rt_blk_cache_stat stat;
+    rt_slist_t node;
+};
+
+static rt_slist_t _cache_list = RT_SLIST_OBJECT_INIT(_cache_list);
+
+static struct blk_cache_entry *_blk_cache_lookup(struct blk_cache *cache, rt_uint32_t sector)
+{
+    struct blk_cache_entry *entry;
+
+    for (entry = cache->hash[sector & cache->hash_mask]; entry != RT_NULL; entry = entry->hash_next)
+    {
+        if (entry->sector == sector)
+            return entry;
+    }
+
+    return RT_NULL;
+}
+
+static void _blk_cache_unhash(struct blk_cache *cache, struct blk_cache_entry *entry)
+{
+    struct blk_cache_entry **link = &cache->hash[entry->sector & cache->hash_mask];
+
+    while (*link != entry)
+        link = &(*link)->hash_next;
+    *link = entry->hash_next;
+
+    entry->hash_next = RT_NULL;
+    entry->sector = BLK_CACHE_INVALID;
+}
+
+static void _blk_cache_touch(struct blk_cache *cache, struct blk_cache_entry *entry)
+{
+    rt_list_remove(&entry->lru);
+    rt_list_insert_after(&cache->lru_list, &entry->lru);
+}
+
+static void _blk_cache_mark_clean(struct blk_cache *cache, struct blk_cache_entry *entry)
+{
+    if (entry->dirty)
+    {
+        entry->dirty = 0;
+        rt_list_remove(&entry->dirty_node);
+        cache->stat.dirty--;
+    }
+}
+
+static void _blk_cache_mark_dirty(struct blk_cache *cache, struct blk_cache_entry *entry)
+{
+    if (entry->dirty)
+        return;
+
+    entry->dirty = 1;
+    rt_list_insert_before(&cache->dirty_list, &entry->dirty_node);
+    cache->stat.dirty++;
+
+    if (!cache->flush_pending)
+    {
+        cache->flush_pending = RT_TRUE;
+        rt_work_submit(&cache->flush_work, rt_tick_from_millisecond(RT_BLK_CACHE_FLUSH_PERIOD));
+    }
+}
+
+/* drop an entry, dirty or not, and make it the first to replace */
+static void _blk_cache_drop(struct blk_cache *cache, struct blk_cache_entry *entry)
+{
+    _blk_cache_mark_clean(cache, entry);
+    _blk_cache_unhash(cache, entry);
+    rt_list_remove(&entry->lru);
+    rt_list_insert_before(&cache->lru_list, &entry->lru);
+}
+
+static rt_size_t _blk_cache_lower_write(struct blk_cache *cache, rt_uint32_t sector, const void *buffer, rt_size_t count)
+{
+    rt_size_t allowed = count, done = 0;
+
+    if (cache->fault >= 0 && count > (rt_size_t)cache->fault)
+        allowed = cache->fault;
+
+    if (allowed > 0)
+        done = rt_device_write(cache->lower, sector, buffer, allowed);
+
+    if (cache->fault >= 0)
+    {
+        cache->fault -= done;
+        cache->stat.dropped += count - allowed;
+    }
+
+    return done;
+}
+
+/* write dirty blocks back in the order of dirtying until `stop` is clean, or all if it is RT_NULL */
+static rt_err_t _blk_cache_writeback(struct blk_cache *cache, struct blk_cache_entry *stop)
+{
+    rt_uint32_t block_size = cache->geometry.bytes_per_sector;
+
+    while (!rt_list_isempty(&cache->dirty_list))
+    {
+        struct blk_cache_entry *first, *entry, *next;
+        const void *buffer;
+        rt_size_t count = 1, done, i;
+        rt_bool_t last;
+
+        first = rt_list_first_entry(&cache->dirty_list, struct blk_cache_entry, dirty_node);
+        entry = first;
+        buffer = first->data;
+        last = (first == stop);
+
+        /* blocks dirtied one after another on consecutive sectors go in one request */
+        while (!last && count < BLK_CACHE_WB_BATCH && entry->dirty_node.next != &cache->dirty_list)
+        {
+            next = rt_list_entry(entry->dirty_node.next, struct blk_cache_entry, dirty_node);
+            if (next->sector != entry->sector + 1)
+                break;
+
+            if (count == 1)
+            {
+                rt_memcpy(cache->wb_buf, first->data, block_size);
+                buffer = cache->wb_buf;
+            }
+            rt_memcpy(cache->wb_buf + count * block_size, next->data, block_size);
+
+            entry = next;
+            last = (entry == stop);
+            count++;
+        }
+
+        done = _blk_cache_lower_write(cache, first->sector, buffer, count);
+        for (i = 0; i < done; i++)
+        {
+            _blk_cache_mark_clean(cache, rt_list_first_entry(&cache->dirty_list, struct blk_cache_entry, dirty_node));
+        }
+        cache->stat.writebacks += done;
+
+        if (done != count)
+            return -RT_EIO;
+
+        if (last)
+            break;
+    }
+
+    return RT_EOK;
+}
+
+/* take the least recently used entry for a sector not cached */
+static struct blk_cache_entry *_blk_cache_alloc(struct blk_cache *cache, rt_uint32_t sector)
+{
+    struct blk_cache_entry *entry = rt_list_entry(cache->lru_list.prev, struct blk_cache_entry, lru);
+
+    if (entry->dirty && _blk_cache_writeback(cache, entry) != RT_EOK)
+        return RT_NULL;
+
+    if (entry->sector != BLK_CACHE_INVALID)
+    {
+        _blk_cache_unhash(cache, entry);
+        cache->stat.evictions++;
+    }
+
+    entry->sector = sector;
+    entry->hash_next = cache->hash[sector & cache->hash_mask];
+    cache->hash[sector & cache->hash_mask] = entry;
+    _blk_cache_touch(cache, entry);
+
+    return entry;
+}
+
+static void _blk_cache_read_ahead(struct blk_cache *cache, rt_uint32_t sector)
+{
+    rt_uint32_t block_size = cache->geometry.bytes_per_sector;
+    struct blk_cache_entry *entry;
+    rt_size_t count, i;
+
+    for (count = 0; count < RT_BLK_CACHE_READ_AHEAD; count++)
+    {
+        if (sector + count >= cache->geometry.sector_count || _blk_cache_lookup(cache, sector + count))
+            break;
+    }
+
+    if (count == 0 || rt_device_read(cache->lower, sector, cache->ra_buf, count) != count)
+        return;
+
+    for (i = 0; i < count; i++)
+    {
+        if ((entry = _blk_cache_alloc(cache, sector + i)) == RT_NULL)
+            break;
+
+        rt_memcpy(entry->data, cache->ra_buf + i * block_size, block_size);
+    }
+    cache->stat.readaheads += i;
+}
+
+static rt_size_t _blk_cache_read_cached(struct blk_cache *cache, rt_uint32_t pos, rt_uint8_t *buffer, rt_size_t size)
+{
+    rt_uint32_t block_size = cache->geometry.bytes_per_sector;
+    struct blk_cache_entry *entry;
+    rt_size_t i = 0, count, j;
+
+    while (i < size)
+    {
+        entry = _blk_cache_lookup(cache, pos + i);
+        if (entry != RT_NULL)
+        {
+            rt_memcpy(buffer + i * block_size, entry->data, block_size);
+            _blk_cache_touch(cache, entry);
+            cache->stat.hits++;
+            i++;
+            continue;
+        }
+
+        /* read a run of missing blocks in one request */
+        for (count = 1; i + count < size && !_blk_cache_lookup(cache, pos + i + count); count++);
+
+        if (rt_device_read(cache->lower, pos + i, buffer + i * block_size, count) != count)
+            break;
+        cache->stat.misses += count;
+
+        for (j = 0; j < count; j++)
+        {
+            if ((entry = _blk_cache_alloc(cache, pos + i + j)) == RT_NULL)
+                break;
+
+            rt_memcpy(entry->data, buffer + (i + j) * block_size, block_size);
+        }
+        i += count;
+    }
+
+    if (i == size && pos == cache->next_sector && RT_BLK_CACHE_READ_AHEAD > 0)
+        _blk_cache_read_ahead(cache, pos + size);
+
+    return i;
+}
+
+static rt_size_t _blk_cache_read_bypass(struct blk_cache *cache, rt_uint32_t pos, rt_uint8_t *buffer, rt_size_t size)
+{
+    rt_uint32_t block_size = cache->geometry.bytes_per_sector;
+    struct blk_cache_entry *entry;
+    rt_size_t done;
+
+    done = rt_device_read(cache->lower, pos, buffer, size);
+    cache->stat.bypasses += done;
+
+    /* the dirty blocks are newer than the device */
+    rt_list_for_each_entry(entry, &cache->dirty_list, dirty_node)
+    {
+        if (entry->sector >= pos && entry->sector < pos + done)
+            rt_memcpy(buffer + (entry->sector - pos) * block_size, entry->data, block_size);
+    }
+
+    return done;
+}
+
+static rt_size_t _blk_cache_write_bypass(struct blk_cache *cache, rt_uint32_t pos, const rt_uint8_t *buffer, rt_size_t size)
+{
+    rt_uint32_t block_size = cache->geometry.bytes_per_sector;
+    struct blk_cache_entry *entry;
+    rt_size_t done, i;
+
+    /* the older dirty blocks go first */
+    if (_blk_cache_writeback(cache, RT_NULL) != RT_EOK)
+        return 0;
+
+    done = _blk_cache_lower_write(cache, pos, buffer, size);
+    cache->stat.bypasses += done;
+
+    /* the cached blocks are clean, keep them as the device */
+    for (i = 0; i < size; i++)
+    {
+        if ((entry = _blk_cache_lookup(cache, pos + i)) == RT_NULL)
+            continue;
+
+        if (i < done)
+            rt_memcpy(entry->data, buffer + i * block_size, block_size);
+        else
+            _blk_cache_drop(cache, entry);
+    }
+
+    return done;
+}
+
+static void _blk_cache_flush_work(struct rt_work *work, void *work_data)
+{
+    struct blk_cache *cache = (struct blk_cache *)work_data;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    cache->flush_pending = RT_FALSE;
+    if (_blk_cache_writeback(cache, RT_NULL) != RT_EOK)
+        LOG_W("%s: write-back failed, %d blocks dirty", cache->parent.parent.name, cache->stat.dirty);
+    else
+        cache->stat.flushes++;
+
+    rt_mutex_release(&cache->lock);
+}
+
+/* RT-Thread Device Driver Interface */
+static rt_err_t _blk_cache_init(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _blk_cache_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _blk_cache_close(rt_device_t dev)
+{
+    return rt_blk_cache_flush(dev);
+}
+
+static rt_size_t _blk_cache_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    rt_size_t done;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    /* a large request would flush the cache */
+    if (size > cache->stat.blocks / 4)
+        done = _blk_cache_read_bypass(cache, pos, buffer, size);
+    else
+        done = _blk_cache_read_cached(cache, pos, buffer, size);
+    cache->next_sector = pos + done;
+
+    rt_mutex_release(&cache->lock);
+
+    return done;
+}
+
+static rt_size_t _blk_cache_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    rt_uint32_t block_size;
+    struct blk_cache_entry *entry;
+    rt_size_t i;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    block_size = cache->geometry.bytes_per_sector;
+
+    if (size > cache->stat.blocks / 4)
+    {
+        i = _blk_cache_write_bypass(cache, pos, buffer, size);
+    }
+    else
+    {
+        for (i = 0; i < size; i++)
+        {
+            entry = _blk_cache_lookup(cache, pos + i);
+            if (entry == RT_NULL && (entry = _blk_cache_alloc(cache, pos + i)) == RT_NULL)
+                break;
+
+            rt_memcpy(entry->data, (const rt_uint8_t *)buffer + i * block_size, block_size);
+            _blk_cache_touch(cache, entry);
+            _blk_cache_mark_dirty(cache, entry);
+        }
+    }
+
+    rt_mutex_release(&cache->lock);
+
+    return i;
+}
+
+static rt_err_t _blk_cache_control(rt_device_t dev, int cmd, void *args)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    struct blk_cache_entry *entry;
+    rt_err_t result;
+    rt_uint32_t i;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    switch (cmd)
+    {
+    case RT_DEVICE_CTRL_BLK_SYNC:
+        result = rt_blk_cache_flush(dev);
+        if (result == RT_EOK)
+            rt_device_control(cache->lower, cmd, args);
+        break;
+
+    case RT_DEVICE_CTRL_BLK_ERASE:
+        /* the erased blocks are dropped, dirty or not */
+        if (args != RT_NULL)
+        {
+            rt_uint32_t *range = (rt_uint32_t *)args;
+
+            rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+            for (i = 0; i < cache->stat.blocks; i++)
+            {
+                entry = &cache->entries[i];
+                if (entry->sector != BLK_CACHE_INVALID && entry->sector >= range[0] && entry->sector <= range[1])
+                    _blk_cache_drop(cache, entry);
+            }
+            rt_mutex_release(&cache->lock);
+        }
+        result = rt_device_control(cache->lower, cmd, args);
+        break;
+
+    default:
+        result = rt_device_control(cache->lower, cmd, args);
+        break;
+    }
+
+    return result;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops blk_cache_ops =
+{
+    _blk_cache_init,
+    _blk_cache_open,
+    _blk_cache_close,
+    _blk_cache_read,
+    _blk_cache_write,
+    _blk_cache_control
+};
+#endif
+
+static void _blk_cache_free(struct blk_cache *cache)
+{
+    if (cache->ra_buf)
+        rt_free_align(cache->ra_buf);
+    if (cache->wb_buf)
+        rt_free_align(cache->wb_buf);
+    if (cache->data)
+        rt_free_align(cache->data);
+    if (cache->hash)
+        rt_free(cache->hash);
+    if (cache->entries)
+        rt_free(cache->entries);
+    rt_free(cache);
+}
+
+rt_device_t rt_blk_cache_create(const char *name, const char *dev_name, rt_uint32_t blocks)
+{
+    struct blk_cache *cache;
+    rt_device_t lower;
+    rt_uint32_t block_size, buckets, i;
+
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(dev_name != RT_NULL);
+
+    if (blocks == 0)
+        return RT_NULL;
+
+    lower = rt_device_find(dev_name);
+    if (lower == RT_NULL || lower->type != RT_Device_Class_Block)
+    {
+        LOG_E("%s is not a block device", dev_name);
+        return RT_NULL;
+    }
+
+    cache = (struct blk_cache *)rt_calloc(1, sizeof(struct blk_cache));
+    if (cache == RT_NULL)
+        return RT_NULL;
+
+    if (rt_device_control(lower, RT_DEVICE_CTRL_BLK_GETGEOME, &cache->geometry) != RT_EOK ||
+            cache->geometry.bytes_per_sector == 0)
+    {
+        LOG_E("no geometry of %s", dev_name);
+        goto _error;
+    }
+    block_size = cache->geometry.bytes_per_sector;
+
+    for (buckets = 1; buckets < blocks; buckets <<= 1);
+
+    cache->entries = (struct blk_cache_entry *)rt_calloc(blocks, sizeof(struct blk_cache_entry));
+    cache->hash = (struct blk_cache_entry **)rt_calloc(buckets, sizeof(struct blk_cache_entry *));
+    cache->data = (rt_uint8_t *)rt_malloc_align(blocks * block_size, BLK_CACHE_ALIGN);
+    cache->wb_buf = (rt_uint8_t *)rt_malloc_align(BLK_CACHE_WB_BATCH * block_size, BLK_CACHE_ALIGN);
+#if RT_BLK_CACHE_READ_AHEAD > 0
+    cache->ra_buf = (rt_uint8_t *)rt_malloc_align(RT_BLK_CACHE_READ_AHEAD * block_size, BLK_CACHE_ALIGN);
+    if (cache->ra_buf == RT_NULL)
+        goto _no_memory;
+#endif
+    if (cache->entries == RT_NULL || cache->hash == RT_NULL || cache->data == RT_NULL || cache->wb_buf == RT_NULL)
+        goto _no_memory;
+
+    cache->hash_mask = buckets - 1;
+    rt_list_init(&cache->lru_list);
+    rt_list_init(&cache->dirty_list);
+    for (i = 0; i < blocks; i++)
+    {
+        cache->entries[i].sector = BLK_CACHE_INVALID;
+        cache->entries[i].data = cache->data + i * block_size;
+        rt_list_insert_before(&cache->lru_list, &cache->entries[i].lru);
+    }
+
+    cache->lower = lower;
+    cache->next_sector = BLK_CACHE_INVALID;
+    cache->fault = -1;
+    cache->stat.blocks = blocks;
+
+    if (rt_device_open(lower, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        LOG_E("open %s failed", dev_name);
+        goto _error;
+    }
+
+    rt_mutex_init(&cache->lock, name, RT_IPC_FLAG_PRIO);
+    rt_work_init(&cache->flush_work, _blk_cache_flush_work, cache);
+
+    cache->parent.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    cache->parent.ops = &blk_cache_ops;
+#else
+    cache->parent.init = _blk_cache_init;
+    cache->parent.open = _blk_cache_open;
+    cache->parent.close = _blk_cache_close;
+    cache->parent.read = _blk_cache_read;
+    cache->parent.write = _blk_cache_write;
+    cache->parent.control = _blk_cache_control;
+#endif
+
+    if (rt_device_register(&cache->parent, name, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_REMOVABLE) != RT_EOK)
+    {
+        rt_mutex_detach(&cache->lock);
+        rt_device_close(lower);
+        goto _error;
+    }
+
+    rt_enter_critical();
+    rt_slist_append(&_cache_list, &cache->node);
+    rt_exit_critical();
+
+    LOG_I("%s: %d blocks of %d bytes over %s", name, blocks, block_size, dev_name);
+
+    return &cache->parent;
+
+_no_memory:
+    LOG_E("no memory for %s, %d blocks", name, blocks);
+_error:
+    _blk_cache_free(cache);
+    return RT_NULL;
+}
+
+rt_err_t rt_blk_cache_destroy(rt_device_t dev)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    result = rt_blk_cache_flush(dev);
+
+    while (rt_work_cancel(&cache->flush_work) == -RT_EBUSY)
+        rt_thread_mdelay(1);
+
+    rt_enter_critical();
+    rt_slist_remove(&_cache_list, &cache->node);
+    rt_exit_critical();
+
+    rt_device_unregister(&cache->parent);
+    rt_device_close(cache->lower);
+    rt_mutex_detach(&cache->lock);
+    _blk_cache_free(cache);
+
+    return result;
+}
+
+rt_err_t rt_blk_cache_flush(rt_device_t dev)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    result = _blk_cache_writeback(cache, RT_NULL);
+    if (result == RT_EOK)
+        cache->stat.flushes++;
+    rt_mutex_release(&cache->lock);
+
+    return result;
+}
+
+void rt_blk_cache_invalidate(rt_device_t dev)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    struct rt_device_blk_geometry geometry;
+    rt_uint32_t i;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < cache->stat.blocks; i++)
+    {
+        if (cache->entries[i].sector != BLK_CACHE_INVALID)
+            _blk_cache_drop(cache, &cache->entries[i]);
+    }
+    cache->next_sector = BLK_CACHE_INVALID;
+
+    /* the medium may be another one, of the same block size */
+    if (rt_device_control(cache->lower, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry) == RT_EOK &&
+            geometry.bytes_per_sector == cache->geometry.bytes_per_sector)
+    {
+        cache->geometry = geometry;
+    }
+
+    rt_mutex_release(&cache->lock);
+}
+
+void rt_blk_cache_set_fault(rt_device_t dev, rt_int32_t blocks)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    cache->fault = blocks < 0 ? -1 : blocks;
+    rt_mutex_release(&cache->lock);
+}
+
+void rt_blk_cache_get_stat(rt_device_t dev, struct rt_blk_cache_stat *stat)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+
+    RT_ASSERT(cache != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    *stat = cache->stat;
+    rt_mutex_release(&cache->lock);
+}
+
+void rt_blk_cache_reset_stat(rt_device_t dev)
+{
+    struct blk_cache *cache = (struct blk_cache *)dev;
+    rt_uint32_t dirty, blocks;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    dirty = cache->stat.dirty;
+    blocks = cache->stat.blocks;
+    rt_memset(&cache->stat, 0, sizeof(cache->stat));
+    cache->stat.dirty = dirty;
+    cache->stat.blocks = blocks;
+    rt_mutex_release(&cache->lock);
+}
+
+#ifdef RT_USING_FINSH
+static struct blk_cache *_blk_cache_find(const char *name)
+{
+    struct blk_cache *cache;
+
+    rt_slist_for_each_entry(cache, &_cache_list, node)
+    {
+        if (rt_strncmp(cache->parent.parent.name, name, RT_NAME_MAX) == 0)
+            return cache;
+    }
+
+    return RT_NULL;
+}
+
+static void _blk_cache_show(struct blk_cache *cache)
+{
+    struct rt_blk_cache_stat stat;
+    rt_uint32_t reads;
+
+    rt_blk_cache_get_stat(&cache->parent, &stat);
+    reads = stat.hits + stat.misses;
+
+    rt_kprintf("%-*.*s %-*.*s %6d %6d %3d%% %6d %6d %6d %6d %6d %6d %6d/%d\n",
+               RT_NAME_MAX, RT_NAME_MAX, cache->parent.parent.name,
+               RT_NAME_MAX, RT_NAME_MAX, cache->lower->parent.name,
+               stat.hits, stat.misses, reads ? stat.hits * 100 / reads : 0,
+               stat.readaheads, stat.writebacks, stat.evictions, stat.bypasses,
+               stat.flushes, stat.dropped, stat.dirty, stat.blocks);
+}
+
+static int blk_cache(int argc, char **argv)
+{
+    struct blk_cache *cache = RT_NULL;
+
+    if (argc == 1)
+    {
+        rt_kprintf("%-*.*s %-*.*s   hits misses rate     ra     wb  evict bypass  flush   drop  dirty\n",
+                   RT_NAME_MAX, RT_NAME_MAX, "cache", RT_NAME_MAX, RT_NAME_MAX, "device");
+        rt_slist_for_each_entry(cache, &_cache_list, node)
+        {
+            _blk_cache_show(cache);
+        }
+        return 0;
+    }
+
+    if (argc == 5 && !rt_strcmp(argv[1], "create"))
+    {
+        return rt_blk_cache_create(argv[2], argv[3], atoi(argv[4])) ? 0 : -1;
+    }
+
+    if (argc >= 3 && (cache = _blk_cache_find(argv[2])) == RT_NULL)
+    {
+        rt_kprintf("no cache %s\n", argv[2]);
+        return -1;
+    }
+
+    if (argc == 3 && !rt_strcmp(argv[1], "flush"))
+    {
+        return rt_blk_cache_flush(&cache->parent) == RT_EOK ? 0 : -1;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_blk_cache_reset_stat(&cache->parent);
+        return 0;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "destroy"))
+    {
+        return rt_blk_cache_destroy(&cache->parent) == RT_EOK ? 0 : -1;
+    }
+    else if (argc == 4 && !rt_strcmp(argv[1], "fault"))
+    {
+        rt_blk_cache_set_fault(&cache->parent, atoi(argv[3]));
+        return 0;
+    }
+
+    rt_kprintf("Usage:\n");
+    rt_kprintf("blk_cache                                   - show the caches\n");
+    rt_kprintf("blk_cache create <name> <device> <blocks>   - cache a block device\n");
+    rt_kprintf("blk_cache flush|reset|destroy <name>\n");
+    rt_kprintf("blk_cache fault <name> <blocks>             - drop the writes after <blocks>, -1: off\n");
+
+    return -1;
+}
+MSH_CMD_EXPORT(blk_cache, block cache: blk_cache [create|flush|reset|destroy|fault]);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/blk_queue.h>
+
+#define DBG_TAG    "blk.queue"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#ifndef RT_BLK_QUEUE_DEPTH
+#define RT_BLK_QUEUE_DEPTH              32
+#endif
+
+#ifndef RT_BLK_QUEUE_MERGE_BLOCKS
+#define RT_BLK_QUEUE_MERGE_BLOCKS       32
+#endif
+
+#ifndef RT_BLK_QUEUE_READ_EXPIRE
+#define RT_BLK_QUEUE_READ_EXPIRE        100
+#endif
+
+#ifndef RT_BLK_QUEUE_WRITE_EXPIRE
+#define RT_BLK_QUEUE_WRITE_EXPIRE       1000
+#endif
+
+#ifndef RT_BLK_QUEUE_THREAD_STACK_SIZE
+#define RT_BLK_QUEUE_THREAD_STACK_SIZE  2048
+#endif
+
+#ifndef RT_BLK_QUEUE_THREAD_PRIORITY
+#define RT_BLK_QUEUE_THREAD_PRIORITY    10
+#endif
+
+/* the merge buffer is aligned to a cache line, so DMA never shares one */
+#define BLK_QUEUE_ALIGN                 32
+
+#define BLK_QUEUE_EVENT_IDLE            (1 << 0)
+
+struct blk_queue
+{
+    struct rt_device parent;
+    rt_device_t lower;
+    rt_uint32_t block_size;
+
+    struct rt_mutex lock;
+    rt_list_t sorted_list;                  /* pending requests by sector */
+    rt_list_t fifo_list;                    /* pending requests by submitting */
+    rt_uint32_t pending;
+    rt_uint32_t head;                       /* the sector after the last command */
+
+    struct rt_semaphore slots;              /* free entries of the queue */
+    struct rt_semaphore kick;               /* released on submitting */
+    struct rt_event idle;                   /* BLK_QUEUE_EVENT_IDLE: nothing pending or in flight */
+    rt_thread_t thread;
+    rt_uint8_t *merge_buf;                  /* RT_BLK_QUEUE_MERGE_BLOCKS blocks */
+
+    struct rt_blk_queue_stat stat;
+    rt_slist_t node;
+};
+
+static rt_slist_t _queue_list = RT_SLIST_OBJECT_INIT(_queue_list);
+
+rt_inline rt_bool_t _blk_queue_conflicts(struct rt_blk_request *a, struct rt_blk_request *b)
+{
+    if (a->dir == RT_BLK_REQ_READ && b->dir == RT_BLK_REQ_READ)
+        return RT_FALSE;
+
+    return (a->sector < b->sector + b->count && b->sector < a->sector + a->count) ? RT_TRUE : RT_FALSE;
+}
+
+/* the oldest pending request submitted before `req` that must be served before it */
+static struct rt_blk_request *_blk_queue_blocker(struct blk_queue *queue, struct rt_blk_request *req)
+{
+    struct rt_blk_request *older;
+
+    rt_list_for_each_entry(older, &queue->fifo_list, fifo)
+    {
+        if (older == req)
+            break;
+
+        if (_blk_queue_conflicts(older, req))
+            return older;
+    }
+
+    return RT_NULL;
+}
+
+static void _blk_queue_remove(struct blk_queue *queue, struct rt_blk_request *req)
+{
+    rt_list_remove(&req->node);
+    rt_list_remove(&req->fifo);
+    queue->pending--;
+}
+
+static struct rt_blk_request *_blk_queue_choose(struct blk_queue *queue)
+{
+    struct rt_blk_request *req, *blocker;
+
+    /* the oldest request after its deadline */
+    req = rt_list_first_entry(&queue->fifo_list, struct rt_blk_request, fifo);
+    if ((rt_int32_t)(rt_tick_get() - req->deadline) >= 0)
+    {
+        queue->stat.expired++;
+    }
+    else
+    {
+        /* the elevator goes up from the head and wraps around to the lowest sector */
+        req = RT_NULL;
+        rt_list_for_each_entry(req, &queue->sorted_list, node)
+        {
+            if (req->sector >= queue->head)
+                break;
+        }
+        if (&req->node == &queue->sorted_list)
+            req = rt_list_first_entry(&queue->sorted_list, struct rt_blk_request, node);
+    }
+
+    while ((blocker = _blk_queue_blocker(queue, req)) != RT_NULL)
+        req = blocker;
+
+    return req;
+}
+
+/* take the requests of the next command into `cmd`, return the blocks of it */
+static rt_size_t _blk_queue_next_command(struct blk_queue *queue, rt_list_t *cmd)
+{
+    struct rt_blk_request *first, *req, *next;
+    rt_size_t count;
+
+    first = _blk_queue_choose(queue);
+    next = rt_list_entry(first->node.next, struct rt_blk_request, node);
+    _blk_queue_remove(queue, first);
+    rt_list_insert_before(cmd, &first->node);
+    count = first->count;
+
+    /* the requests continuing the command in the same direction ride along */
+    for (req = next; &req->node != &queue->sorted_list && req->sector <= first->sector + count; req = next)
+    {
+        next = rt_list_entry(req->node.next, struct rt_blk_request, node);
+
+        if (req->sector != first->sector + count || req->dir != first->dir ||
+                count + req->count > RT_BLK_QUEUE_MERGE_BLOCKS || _blk_queue_blocker(queue, req) != RT_NULL)
+            continue;
+
+        _blk_queue_remove(queue, req);
+        rt_list_insert_before(cmd, &req->node);
+        count += req->count;
+        queue->stat.merged++;
+    }
+
+    queue->head = first->sector + count;
+    queue->stat.commands++;
+    if (first->dir == RT_BLK_REQ_READ)
+        queue->stat.read_blocks += count;
+    else
+        queue->stat.write_blocks += count;
+
+    return count;
+}
+
+static void _blk_queue_execute(struct blk_queue *queue, rt_list_t *cmd, rt_size_t count)
+{
+    struct rt_blk_request *first, *req, *next;
+    rt_size_t done, offset = 0;
+    rt_uint8_t *buffer;
+
+    first = rt_list_first_entry(cmd, struct rt_blk_request, node);
+
+    /* a merged command goes through the merge buffer */
+    buffer = (first->count == count) ? first->buffer : queue->merge_buf;
+
+    if (first->dir == RT_BLK_REQ_READ)
+    {
+        done = rt_device_read(queue->lower, first->sector, buffer, count);
+    }
+    else
+    {
+        if (buffer == queue->merge_buf)
+        {
+            rt_list_for_each_entry(req, cmd, node)
+            {
+                rt_memcpy(buffer + offset * queue->block_size, req->buffer, req->count * queue->block_size);
+                offset += req->count;
+            }
+            offset = 0;
+        }
+        done = rt_device_write(queue->lower, first->sector, buffer, count);
+    }
+
+    rt_list_for_each_entry_safe(req, next, cmd, node)
+    {
+        rt_list_remove(&req->node);
+
+        req->result = (done > offset) ? done - offset : 0;
+        if (req->result > req->count)
+            req->result = req->count;
+
+        if (first->dir == RT_BLK_REQ_READ && buffer == queue->merge_buf)
+            rt_memcpy(req->buffer, buffer + offset * queue->block_size, req->result * queue->block_size);
+        offset += req->count;
+
+        rt_sem_release(&queue->slots);
+        if (req->done)
+            req->done(req);
+    }
+}
+
+static void _blk_queue_dispatcher(void *parameter)
+{
+    struct blk_queue *queue = (struct blk_queue *)parameter;
+    rt_list_t cmd;
+    rt_size_t count;
+
+    rt_list_init(&cmd);
+
+    while (1)
+    {
+        rt_sem_take(&queue->kick, RT_WAITING_FOREVER);
+
+        while (1)
+        {
+            rt_mutex_take(&queue->lock, RT_WAITING_FOREVER);
+            if (queue->pending == 0)
+            {
+                rt_event_send(&queue->idle, BLK_QUEUE_EVENT_IDLE);
+                rt_mutex_release(&queue->lock);
+                break;
+            }
+            count = _blk_queue_next_command(queue, &cmd);
+            rt_mutex_release(&queue->lock);
+
+            _blk_queue_execute(queue, &cmd, count);
+        }
+    }
+}
+
+rt_err_t rt_blk_queue_submit(rt_device_t dev, struct rt_blk_request *req)
+{
+    struct blk_queue *queue = (struct blk_queue *)dev;
+    struct rt_blk_request *pos;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(req != RT_NULL);
+
+    if (req->count == 0 || req->buffer == RT_NULL)
+        return -RT_EINVAL;
+
+    req->result = 0;
+    req->deadline = rt_tick_get() + rt_tick_from_millisecond(req->dir == RT_BLK_REQ_READ ?
+                    RT_BLK_QUEUE_READ_EXPIRE : RT_BLK_QUEUE_WRITE_EXPIRE);
+
+    rt_sem_take(&queue->slots, RT_WAITING_FOREVER);
+    rt_mutex_take(&queue->lock, RT_WAITING_FOREVER);
+
+    /* after the requests on the same sector, so they keep the submitting order */
+    rt_list_for_each_entry(pos, &queue->sorted_list, node)
+    {
+        if (pos->sector > req->sector)
+            break;
+    }
+    rt_list_insert_before(&pos->node, &req->node);
+    rt_list_insert_before(&queue->fifo_list, &req->fifo);
+
+    queue->pending++;
+    queue->stat.requests++;
+    if (queue->pending > queue->stat.max_pending)
+        queue->stat.max_pending = queue->pending;
+    rt_event_recv(&queue->idle, BLK_QUEUE_EVENT_IDLE, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, 0, RT_NULL);
+
+    rt_mutex_release(&queue->lock);
+    rt_sem_release(&queue->kick);
+
+    return RT_EOK;
+}
+
+static void _blk_queue_wakeup(struct rt_blk_request *req)
+{
+    rt_completion_done((struct rt_completion *)req->user_data);
+}
+
+static rt_size_t _blk_queue_transfer(rt_device_t dev, rt_uint8_t dir, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct rt_blk_request req;
+    struct rt_completion completion;
+
+    rt_memset(&req, 0, sizeof(req));
+    req.dir = dir;
+    req.sector = pos;
+    req.count = size;
+    req.buffer = buffer;
+    req.done = _blk_queue_wakeup;
+    req.user_data = &completion;
+
+    rt_completion_init(&completion);
+    if (rt_blk_queue_submit(dev, &req) != RT_EOK)
+        return 0;
+    rt_completion_wait(&completion, RT_WAITING_FOREVER);
+
+    return req.result;
+}
+
+/* RT-Thread Device Driver Interface */
+static rt_err_t _blk_queue_init(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _blk_queue_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _blk_queue_close(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_size_t _blk_queue_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    return _blk_queue_transfer(dev, RT_BLK_REQ_READ, pos, buffer, size);
+}
+
+static rt_size_t _blk_queue_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    return _blk_queue_transfer(dev, RT_BLK_REQ_WRITE, pos, (void *)buffer, size);
+}
+
+static rt_err_t _blk_queue_control(rt_device_t dev, int cmd, void *args)
+{
+    struct blk_queue *queue = (struct blk_queue *)dev;
+
+    RT_ASSERT(queue != RT_NULL);
+
+    /* the queued writes go first */
+    if (cmd == RT_DEVICE_CTRL_BLK_SYNC || cmd == RT_DEVICE_CTRL_BLK_ERASE)
+        rt_event_recv(&queue->idle, BLK_QUEUE_EVENT_IDLE, RT_EVENT_FLAG_OR, RT_WAITING_FOREVER, RT_NULL);
+
+    return rt_device_control(queue->lower, cmd, args);
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops blk_queue_ops =
+{
+    _blk_queue_init,
+    _blk_queue_open,
+    _blk_queue_close,
+    _blk_queue_read,
+    _blk_queue_write,
+    _blk_queue_control
+};
+#endif
+
+rt_device_t rt_blk_queue_create(const char *name, const char *dev_name)
+{
+    struct rt_device_blk_geometry geometry;
+    struct blk_queue *queue;
+    rt_device_t lower;
+
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(dev_name != RT_NULL);
+
+    lower = rt_device_find(dev_name);
+    if (lower == RT_NULL || lower->type != RT_Device_Class_Block)
+    {
+        LOG_E("%s is not a block device", dev_name);
+        return RT_NULL;
+    }
+
+    if (rt_device_control(lower, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry) != RT_EOK ||
+            geometry.bytes_per_sector == 0)
+    {
+        LOG_E("no geometry of %s", dev_name);
+        return RT_NULL;
+    }
+
+    queue = (struct blk_queue *)rt_calloc(1, sizeof(struct blk_queue));
+    if (queue == RT_NULL)
+        return RT_NULL;
+
+    queue->block_size = geometry.bytes_per_sector;
+    queue->merge_buf = (rt_uint8_t *)rt_malloc_align(RT_BLK_QUEUE_MERGE_BLOCKS * queue->block_size, BLK_QUEUE_ALIGN);
+    if (queue->merge_buf == RT_NULL)
+    {
+        LOG_E("no memory for %s", name);
+        rt_free(queue);
+        return RT_NULL;
+    }
+
+    if (rt_device_open(lower, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        LOG_E("open %s failed", dev_name);
+        goto _error;
+    }
+
+    queue->lower = lower;
+    rt_list_init(&queue->sorted_list);
+    rt_list_init(&queue->fifo_list);
+    rt_mutex_init(&queue->lock, name, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&queue->slots, name, RT_BLK_QUEUE_DEPTH, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&queue->kick, name, 0, RT_IPC_FLAG_FIFO);
+    rt_event_init(&queue->idle, name, RT_IPC_FLAG_FIFO);
+    rt_event_send(&queue->idle, BLK_QUEUE_EVENT_IDLE);
+
+    queue->thread = rt_thread_create(name, _blk_queue_dispatcher, queue,
+                                     RT_BLK_QUEUE_THREAD_STACK_SIZE, RT_BLK_QUEUE_THREAD_PRIORITY, 10);
+    if (queue->thread == RT_NULL)
+        goto _error_ipc;
+
+    queue->parent.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    queue->parent.ops = &blk_queue_ops;
+#else
+    queue->parent.init = _blk_queue_init;
+    queue->parent.open = _blk_queue_open;
+    queue->parent.close = _blk_queue_close;
+    queue->parent.read = _blk_queue_read;
+    queue->parent.write = _blk_queue_write;
+    queue->parent.control = _blk_queue_control;
+#endif
+
+    if (rt_device_register(&queue->parent, name, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_REMOVABLE) != RT_EOK)
+    {
+        rt_thread_delete(queue->thread);
+        goto _error_ipc;
+    }
+
+    rt_enter_critical();
+    rt_slist_append(&_queue_list, &queue->node);
+    rt_exit_critical();
+
+    rt_thread_startup(queue->thread);
+
+    return &queue->parent;
+
+_error_ipc:
+    rt_event_detach(&queue->idle);
+    rt_sem_detach(&queue->kick);
+    rt_sem_detach(&queue->slots);
+    rt_mutex_detach(&queue->lock);
+    rt_device_close(lower);
+_error:
+    rt_free_align(queue->merge_buf);
+    rt_free(queue);
+    return RT_NULL;
+}
+
+void rt_blk_queue_get_stat(rt_device_t dev, struct rt_blk_queue_stat *stat)
+{
+    struct blk_queue *queue = (struct blk_queue *)dev;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    rt_mutex_take(&queue->lock, RT_WAITING_FOREVER);
+    *stat = queue->stat;
+    rt_mutex_release(&queue->lock);
+}
+
+void rt_blk_queue_reset_stat(rt_device_t dev)
+{
+    struct blk_queue *queue = (struct blk_queue *)dev;
+
+    RT_ASSERT(queue != RT_NULL);
+
+    rt_mutex_take(&queue->lock, RT_WAITING_FOREVER);
+    rt_memset(&queue->stat, 0, sizeof(queue->stat));
+    rt_mutex_release(&queue->lock);
+}
+
+#ifdef RT_USING_FINSH
+#include <stdlib.h>
+
+static int blk_queue(int argc, char **argv)
+{
+    struct blk_queue *queue;
+    struct rt_blk_queue_stat stat;
+
+    if (argc == 1)
+    {
+        rt_kprintf("%-*.*s %-*.*s requests commands merged expired  r_blocks  w_blocks max\n",
+                   RT_NAME_MAX, RT_NAME_MAX, "queue", RT_NAME_MAX, RT_NAME_MAX, "device");
+        rt_slist_for_each_entry(queue, &_queue_list, node)
+        {
+            rt_blk_queue_get_stat(&queue->parent, &stat);
+            rt_kprintf("%-*.*s %-*.*s %8d %8d %6d %7d %9d %9d %3d\n",
+                       RT_NAME_MAX, RT_NAME_MAX, queue->parent.parent.name,
+                       RT_NAME_MAX, RT_NAME_MAX, queue->lower->parent.name,
+                       stat.requests, stat.commands, stat.merged, stat.expired,
+                       stat.read_blocks, stat.write_blocks, stat.max_pending);
+        }
+        return 0;
+    }
+
+    if (argc == 4 && !rt_strcmp(argv[1], "create"))
+    {
+        return rt_blk_queue_create(argv[2], argv[3]) ? 0 : -1;
+    }
+
+    if (argc == 3 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_slist_for_each_entry(queue, &_queue_list, node)
+        {
+            if (rt_strncmp(queue->parent.parent.name, argv[2], RT_NAME_MAX) == 0)
+            {
+                rt_blk_queue_reset_stat(&queue->parent);
+                return 0;
+            }
+        }
+        rt_kprintf("no queue %s\n", argv[2]);
+        return -1;
+    }
+
+    rt_kprintf("Usage:\n");
+    rt_kprintf("blk_queue                           - show the queues\n");
+    rt_kprintf("blk_queue create <name> <device>    - queue the requests of a block device\n");
+    rt_kprintf("blk_queue reset <name>\n");
+
+    return -1;
+}
+MSH_CMD_EXPORT(blk_queue, block request queue: blk_queue [create|reset]);
+#endif /* RT_USING_FINSH */
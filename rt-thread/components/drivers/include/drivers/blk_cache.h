@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#ifndef BLK_CACHE_H__
+#define BLK_CACHE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* counters of a block cache, in blocks unless noted */
+struct rt_blk_cache_stat
+{
+    rt_uint32_t hits;           /* blocks read from the cache */
+    rt_uint32_t misses;         /* blocks read from the device on demand */
+    rt_uint32_t readaheads;     /* blocks read from the device ahead of a sequential reading */
+    rt_uint32_t writebacks;     /* dirty blocks written to the device */
+    rt_uint32_t evictions;      /* valid blocks replaced */
+    rt_uint32_t bypasses;       /* blocks of large requests passed to the device directly */
+    rt_uint32_t flushes;        /* flushes of all dirty blocks, in times */
+    rt_uint32_t dropped;        /* writes dropped by the fault injection */
+    rt_uint32_t dirty;          /* dirty blocks now */
+    rt_uint32_t blocks;         /* size of the cache */
+};
+
+/**
+ * This function creates a block device caching another one, and registers it.
+ * A filesystem mounted on it reads and writes the cache; dirty blocks reach the
+ * lower device in the order they were first dirtied, on replacement, after
+ * RT_BLK_CACHE_FLUSH_PERIOD ms, or on RT_DEVICE_CTRL_BLK_SYNC.
+ *
+ * @param name is the name of the cache device.
+ * @param dev_name is the name of the lower block device, it is opened here.
+ * @param blocks is the number of blocks cached.
+ *
+ * @return the cache device, or RT_NULL on failure.
+ */
+rt_device_t rt_blk_cache_create(const char *name, const char *dev_name, rt_uint32_t blocks);
+
+/**
+ * This function writes the dirty blocks back, unregisters the cache device,
+ * closes the lower device and frees the cache.
+ */
+rt_err_t rt_blk_cache_destroy(rt_device_t cache);
+
+/**
+ * This function writes all dirty blocks to the lower device.
+ *
+ * @return RT_EOK, or -RT_EIO when the lower device failed a write.
+ */
+rt_err_t rt_blk_cache_flush(rt_device_t cache);
+
+/**
+ * This function drops all blocks, dirty or not, e.g. after the medium was changed.
+ */
+void rt_blk_cache_invalidate(rt_device_t cache);
+
+/**
+ * This function simulates a power loss for testing: the lower device takes
+ * `blocks` more blocks of writes, then every write is dropped and fails.
+ * The blocks remain dirty in the cache, so the image of the lower device is
+ * what a power loss at that point leaves.
+ *
+ * @param blocks is the number of blocks still written, -1 disables the injection.
+ */
+void rt_blk_cache_set_fault(rt_device_t cache, rt_int32_t blocks);
+
+void rt_blk_cache_get_stat(rt_device_t cache, struct rt_blk_cache_stat *stat);
+void rt_blk_cache_reset_stat(rt_device_t cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLK_CACHE_H__ */
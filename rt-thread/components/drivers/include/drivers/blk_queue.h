@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#ifndef BLK_QUEUE_H__
+#define BLK_QUEUE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RT_BLK_REQ_READ     0
+#define RT_BLK_REQ_WRITE    1
+
+/* a request of a block queue, it belongs to the queue from submitting until done */
+struct rt_blk_request
+{
+    rt_uint8_t dir;                             /* RT_BLK_REQ_READ or RT_BLK_REQ_WRITE */
+    rt_uint32_t sector;
+    rt_size_t count;                            /* blocks */
+    void *buffer;
+
+    /* called in the dispatch thread when the request is done */
+    void (*done)(struct rt_blk_request *req);
+    void *user_data;
+    rt_size_t result;                           /* blocks transferred */
+
+    /* private */
+    rt_list_t node;                             /* node of the sector order, or of a command */
+    rt_list_t fifo;                             /* node of the submitting order */
+    rt_tick_t deadline;
+};
+
+struct rt_blk_queue_stat
+{
+    rt_uint32_t requests;                       /* requests submitted */
+    rt_uint32_t commands;                       /* reads and writes of the lower device */
+    rt_uint32_t merged;                         /* requests merged into the command of another */
+    rt_uint32_t expired;                        /* requests dispatched for the deadline */
+    rt_uint32_t read_blocks;
+    rt_uint32_t write_blocks;
+    rt_uint32_t max_pending;                    /* the most pending requests */
+};
+
+/**
+ * This function creates a block device queueing the requests to another one,
+ * and registers it. A dispatch thread serves the requests in the sector order,
+ * or the oldest one after its deadline, and merges the requests on adjacent
+ * sectors into one command. An older request on an overlapping sector is
+ * served first if any of them writes. The read and write of the device wait
+ * for the request.
+ *
+ * @param name is the name of the queue device.
+ * @param dev_name is the name of the lower block device, it is opened here.
+ *
+ * @return the queue device, or RT_NULL on failure.
+ */
+rt_device_t rt_blk_queue_create(const char *name, const char *dev_name);
+
+/**
+ * This function queues a request, it waits if RT_BLK_QUEUE_DEPTH requests are pending.
+ *
+ * @return RT_EOK, or -RT_EINVAL for an empty request.
+ */
+rt_err_t rt_blk_queue_submit(rt_device_t queue, struct rt_blk_request *req);
+
+void rt_blk_queue_get_stat(rt_device_t queue, struct rt_blk_queue_stat *stat);
+void rt_blk_queue_reset_stat(rt_device_t queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLK_QUEUE_H__ */
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#ifndef MTD_NAND_FTL_H__
+#define MTD_NAND_FTL_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* counters of a flash translation layer, in pages unless noted */
+struct rt_mtd_nand_ftl_stat
+{
+    rt_uint32_t host_pages;                     /* pages written by the filesystem */
+    rt_uint32_t gc_pages;                       /* valid pages copied by the garbage collection */
+    rt_uint32_t ckpt_pages;                     /* pages of the mapping checkpoints */
+    rt_uint32_t erases;                         /* blocks erased */
+    rt_uint32_t gc_blocks;                      /* blocks collected */
+    rt_uint32_t wl_blocks;                      /* blocks collected to move cold data */
+    rt_uint32_t checkpoints;                    /* checkpoints written, in times */
+    rt_uint32_t retired;                        /* blocks gone bad in use */
+
+    /* the state now, not cleared by rt_mtd_nand_ftl_reset_stat() */
+    rt_uint32_t bad_blocks;
+    rt_uint32_t free_blocks;
+    rt_uint32_t min_erase;                      /* erase counts of the good blocks */
+    rt_uint32_t max_erase;
+};
+
+/**
+ * This function creates a block device over a MTD Nand device, and registers
+ * it. A sector is a page of the NAND flash; a write goes to a fresh page and
+ * the logical page of it is kept in the spare area, so the Nand device must
+ * have 16 free bytes in the spare area of a page. The space of blocks freed
+ * is collected in background, the blocks least erased are written first and
+ * the cold data are moved to the blocks most erased. The mapping is saved in
+ * checkpoints, and the pages written after the last one are found again after
+ * a power loss.
+ *
+ * @param name is the name of the block device.
+ * @param nand_name is the name of the MTD Nand device.
+ * @param format is RT_TRUE to erase the Nand device and start empty, or
+ *        RT_FALSE to load what was written.
+ *
+ * @return the block device, or RT_NULL on failure.
+ */
+rt_device_t rt_mtd_nand_ftl_create(const char *name, const char *nand_name, rt_bool_t format);
+
+/**
+ * This function writes a checkpoint, unregisters the block device and frees it.
+ */
+rt_err_t rt_mtd_nand_ftl_destroy(rt_device_t ftl);
+
+/**
+ * This function writes a checkpoint of the mapping now.
+ */
+rt_err_t rt_mtd_nand_ftl_checkpoint(rt_device_t ftl);
+
+/**
+ * This function does one step of the background work: collects a block if the
+ * free blocks are few, moves the coldest block for the wear levelling, or
+ * writes a checkpoint if it is due.
+ *
+ * @return RT_EOK if a step was done, or -RT_EEMPTY if nothing to do.
+ */
+rt_err_t rt_mtd_nand_ftl_collect(rt_device_t ftl);
+
+void rt_mtd_nand_ftl_get_stat(rt_device_t ftl, struct rt_mtd_nand_ftl_stat *stat);
+void rt_mtd_nand_ftl_reset_stat(rt_device_t ftl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_NAND_FTL_H__ */
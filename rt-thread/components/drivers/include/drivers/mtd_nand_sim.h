@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#ifndef MTD_NAND_SIM_H__
+#define MTD_NAND_SIM_H__
+
+#include <rtthread.h>
+#include <drivers/mtd_nand.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rt_mtd_nand_sim_stat
+{
+    rt_uint32_t reads;                          /* pages read */
+    rt_uint32_t programs;                       /* pages programmed */
+    rt_uint32_t erases;                         /* blocks erased */
+    rt_uint32_t violations;                     /* pages programmed twice or out of order */
+};
+
+/**
+ * This function creates a NAND flash simulated in memory and registers it as
+ * a MTD Nand device. A page is programmed once after erasing, in the order of
+ * the pages of its block, and the whole spare area is free.
+ *
+ * @param name is the name of the device.
+ * @param blocks is the number of blocks.
+ * @param pages_per_block is the number of pages of a block.
+ * @param page_size is the size of the data area of a page.
+ * @param oob_size is the size of the spare area of a page.
+ *
+ * @return the device, or RT_NULL on failure.
+ */
+struct rt_mtd_nand_device *rt_mtd_nand_sim_create(const char *name, rt_uint32_t blocks,
+        rt_uint32_t pages_per_block, rt_uint16_t page_size, rt_uint16_t oob_size);
+
+/**
+ * This function simulates a power loss: `ops` more programs and erases are
+ * done, the next one is torn and every access fails until it is called again
+ * with -1. A torn page, or a page of a torn block, fails reading with ECC errors.
+ *
+ * @param ops is the number of programs and erases still done, -1 to power on.
+ */
+void rt_mtd_nand_sim_set_fault(struct rt_mtd_nand_device *nand, rt_int32_t ops);
+
+/**
+ * This function makes a block go bad: its programs and erases fail from now on.
+ */
+void rt_mtd_nand_sim_set_bad(struct rt_mtd_nand_device *nand, rt_uint32_t block);
+
+void rt_mtd_nand_sim_get_stat(struct rt_mtd_nand_device *nand, struct rt_mtd_nand_sim_stat *stat);
+void rt_mtd_nand_sim_reset_stat(struct rt_mtd_nand_device *nand);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_NAND_SIM_H__ */
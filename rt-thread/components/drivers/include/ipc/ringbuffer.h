@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2021-08-14     Jackistang   add comments for function interface.
+ * 2026-10-16     RT-Thread    add lock-free single-producer single-consumer ring buffer
  */
 #ifndef RINGBUFFER_H__
 #define RINGBUFFER_H__
@@ -97,6 +98,61 @@ rt_inline rt_uint16_t rt_ringbuffer_get_size(struct rt_ringbuffer *rb)
 /** return the size of empty space in rb */
 #define rt_ringbuffer_space_len(rb) ((rb)->buffer_size - (rt_int16_t)rt_ringbuffer_data_len(rb))
 
+/*
+ * Lock-free ring buffer for one producer and one consumer, e.g. an ISR and a
+ * thread. The producer only writes write_index and the consumer only writes
+ * read_index, so neither side needs to disable interrupt or take a lock.
+ *
+ * The indexes run in [0, 2 * buffer_size) so a full buffer differs from an
+ * empty one. When buffer_size is a power of 2, they run freely and wrap at
+ * 2^32 instead, and the offset is taken by mask.
+ */
+struct rt_ringbuffer_spsc
+{
+    rt_uint8_t *buffer_ptr;
+    rt_uint32_t buffer_size;
+    rt_uint32_t mask;                   /* buffer_size - 1 if it's power of 2, otherwise 0 */
+
+    volatile rt_uint32_t write_index;   /* only written by producer */
+    volatile rt_uint32_t read_index;    /* only written by consumer */
+};
+
+/* a contiguous piece of the ring buffer */
+struct rt_ringbuffer_segment
+{
+    rt_uint8_t *ptr;
+    rt_size_t   length;
+};
+
+/* memory barrier between the data and the index, override it for SMP or weakly ordered memory */
+#ifndef RT_RINGBUFFER_BARRIER
+#if defined(RT_USING_SMP) && defined(__GNUC__)
+#define RT_RINGBUFFER_BARRIER()     __sync_synchronize()
+#elif defined(__CC_ARM)
+#define RT_RINGBUFFER_BARRIER()     __memory_changed()
+#elif defined(__GNUC__) || defined(__clang__)
+#define RT_RINGBUFFER_BARRIER()     __asm volatile("" ::: "memory")
+#else
+#define RT_RINGBUFFER_BARRIER()
+#endif
+#endif /* RT_RINGBUFFER_BARRIER */
+
+void rt_ringbuffer_spsc_init(struct rt_ringbuffer_spsc *rb, rt_uint8_t *pool, rt_uint32_t size);
+void rt_ringbuffer_spsc_reset(struct rt_ringbuffer_spsc *rb);
+rt_size_t rt_ringbuffer_spsc_data_len(struct rt_ringbuffer_spsc *rb);
+rt_size_t rt_ringbuffer_spsc_space_len(struct rt_ringbuffer_spsc *rb);
+rt_size_t rt_ringbuffer_spsc_put(struct rt_ringbuffer_spsc *rb, const rt_uint8_t *ptr, rt_size_t length);
+rt_size_t rt_ringbuffer_spsc_get(struct rt_ringbuffer_spsc *rb, rt_uint8_t *ptr, rt_size_t length);
+rt_size_t rt_ringbuffer_spsc_put_reserve(struct rt_ringbuffer_spsc *rb, struct rt_ringbuffer_segment seg[2], rt_size_t length);
+void rt_ringbuffer_spsc_put_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length);
+rt_size_t rt_ringbuffer_spsc_get_reserve(struct rt_ringbuffer_spsc *rb, struct rt_ringbuffer_segment seg[2], rt_size_t length);
+void rt_ringbuffer_spsc_get_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length);
+
+#ifdef RT_USING_HEAP
+struct rt_ringbuffer_spsc *rt_ringbuffer_spsc_create(rt_uint32_t size);
+void rt_ringbuffer_spsc_destroy(struct rt_ringbuffer_spsc *rb);
+#endif
+
 
 #ifdef __cplusplus
 }
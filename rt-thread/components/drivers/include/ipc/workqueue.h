@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-08-01     Meco Man     remove rt_delayed_work_init() and rt_delayed_work structure
  * 2021-08-14     Jackistang   add comments for rt_work_init()
+ * 2026-10-16     RT-Thread    add multi-worker workqueue, work priority and statistics
  */
 #ifndef WORKQUEUE_H__
 #define WORKQUEUE_H__
@@ -31,15 +32,42 @@ enum
     RT_WORK_TYPE_DELAYED     = 0x0001,
 };
 
+#define RT_WORK_PRIORITY_DEFAULT    (RT_THREAD_PRIORITY_MAX / 2) /* smaller value, higher priority */
+#define RT_WORK_CPU_ANY             0xFF                         /* work runs on any worker */
+
+struct rt_workqueue;
+
+/* worker thread of workqueue */
+struct rt_workqueue_worker
+{
+    rt_list_t      work_list;     /* pending works, ordered by priority */
+    struct rt_work *work_current; /* current work */
+    rt_thread_t    work_thread;
+    struct rt_workqueue *queue;
+    rt_uint8_t     cpu;           /* bound cpu, RT_WORK_CPU_ANY if not bound */
+
+    /* statistics */
+    rt_uint32_t    work_count;    /* works done */
+    rt_uint32_t    steal_count;   /* works taken from other workers */
+    rt_uint32_t    max_time;      /* longest execution time, in cputime tick or OS tick */
+    rt_uint64_t    total_time;    /* total execution time */
+};
+
 /* workqueue implementation */
 struct rt_workqueue
 {
-    rt_list_t      work_list;
+    char           name[RT_NAME_MAX];
+    rt_list_t      list;          /* node of workqueue list */
     rt_list_t      delayed_list;
-    struct rt_work *work_current; /* current work */
 
     struct rt_semaphore sem;
-    rt_thread_t    work_thread;
+    rt_uint16_t    worker_num;
+    rt_uint16_t    worker_next;   /* round robin position to queue work */
+    struct rt_workqueue_worker *workers;
+
+    /* statistics */
+    rt_uint16_t    depth;         /* works pending */
+    rt_uint16_t    max_depth;
 };
 
 struct rt_work
@@ -50,6 +78,8 @@ struct rt_work
     void *work_data;
     rt_uint16_t flags;
     rt_uint16_t type;
+    rt_uint8_t  priority;
+    rt_uint8_t  cpu;
     struct rt_timer timer;
     struct rt_workqueue *workqueue;
 };
@@ -59,7 +89,11 @@ struct rt_work
  * WorkQueue for DeviceDriver
  */
 void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data), void *work_data);
+void rt_work_set_priority(struct rt_work *work, rt_uint8_t priority);
+void rt_work_set_cpu(struct rt_work *work, rt_uint8_t cpu);
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority);
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                              rt_uint16_t worker_num);
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue);
 rt_err_t rt_workqueue_dowork(struct rt_workqueue *queue, struct rt_work *work);
 rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *work, rt_tick_t ticks);
@@ -46,8 +46,22 @@ extern "C" {
 
 #ifdef RT_USING_MTD_NAND
 #include "drivers/mtd_nand.h"
+#ifdef RT_USING_MTD_NAND_FTL
+#include "drivers/mtd_nand_ftl.h"
+#endif /* RT_USING_MTD_NAND_FTL */
+#ifdef RT_USING_MTD_NAND_SIM
+#include "drivers/mtd_nand_sim.h"
+#endif /* RT_USING_MTD_NAND_SIM */
 #endif /* RT_USING_MTD_NAND */
 
+#ifdef RT_USING_BLK_CACHE
+#include "drivers/blk_cache.h"
+#endif /* RT_USING_BLK_CACHE */
+
+#ifdef RT_USING_BLK_QUEUE
+#include "drivers/blk_queue.h"
+#endif /* RT_USING_BLK_QUEUE */
+
 #ifdef RT_USING_USB_DEVICE
 #include "drivers/usb_device.h"
 #endif /* RT_USING_USB_DEVICE */
@@ -10,6 +10,7 @@
  * 2016-08-18     heyuanjie    add interface
  * 2021-07-20     arminker     fix write_index bug in function rt_ringbuffer_put_force
  * 2021-08-14     Jackistang   add comments for function interface.
+ * 2026-10-16     RT-Thread    add lock-free single-producer single-consumer ring buffer
  */
 
 #include <rtthread.h>
@@ -465,3 +466,323 @@ void rt_ringbuffer_destroy(struct rt_ringbuffer *rb)
 RTM_EXPORT(rt_ringbuffer_destroy);
 
 #endif
+
+/*
+ * Lock-free single-producer single-consumer ring buffer.
+ *
+ * The producer only writes the write_index and the consumer only writes the
+ * read_index. The data is copied before the index is published, and the index
+ * of the other side is loaded before the data is touched, with a barrier in
+ * between. So the producer and the consumer may run in different contexts,
+ * such as an ISR and a thread, without disabling interrupt.
+ */
+
+rt_inline rt_uint32_t _spsc_used(struct rt_ringbuffer_spsc *rb, rt_uint32_t write_index, rt_uint32_t read_index)
+{
+    if (rb->mask)
+        return write_index - read_index;
+
+    if (write_index >= read_index)
+        return write_index - read_index;
+
+    return write_index + 2 * rb->buffer_size - read_index;
+}
+
+rt_inline rt_uint32_t _spsc_offset(struct rt_ringbuffer_spsc *rb, rt_uint32_t index)
+{
+    if (rb->mask)
+        return index & rb->mask;
+
+    return index >= rb->buffer_size ? index - rb->buffer_size : index;
+}
+
+rt_inline rt_uint32_t _spsc_advance(struct rt_ringbuffer_spsc *rb, rt_uint32_t index, rt_size_t length)
+{
+    index += length;
+
+    if (rb->mask == 0 && index >= 2 * rb->buffer_size)
+        index -= 2 * rb->buffer_size;
+
+    return index;
+}
+
+rt_inline rt_size_t _spsc_segment(struct rt_ringbuffer_spsc *rb, struct rt_ringbuffer_segment seg[2],
+                                  rt_uint32_t index, rt_size_t length)
+{
+    rt_uint32_t offset = _spsc_offset(rb, index);
+    rt_size_t first = rb->buffer_size - offset;
+
+    if (first > length)
+        first = length;
+
+    seg[0].ptr = &rb->buffer_ptr[offset];
+    seg[0].length = first;
+    seg[1].ptr = rb->buffer_ptr;
+    seg[1].length = length - first;
+
+    return length;
+}
+
+/**
+ * @brief Initialize the lock-free single-producer single-consumer ring buffer object.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param pool      A pointer to the buffer.
+ * @param size      The size of the buffer in bytes. A power of 2 size lets the indexes wrap by mask.
+ */
+void rt_ringbuffer_spsc_init(struct rt_ringbuffer_spsc *rb, rt_uint8_t *pool, rt_uint32_t size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(size > 0 && size <= 0x7FFFFFFFUL);
+
+    rb->buffer_ptr = pool;
+    rb->buffer_size = size;
+    rb->mask = (size & (size - 1)) == 0 ? size - 1 : 0;
+    rb->write_index = 0;
+    rb->read_index = 0;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_init);
+
+/**
+ * @brief Reset the ring buffer object. It must not race with the producer or the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ */
+void rt_ringbuffer_spsc_reset(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rb->write_index = 0;
+    rb->read_index = 0;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_reset);
+
+/**
+ * @brief Get the size of data in the ring buffer in bytes.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ *
+ * @return Return the size of data, it's exact for the consumer and a lower bound for the producer.
+ */
+rt_size_t rt_ringbuffer_spsc_data_len(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return _spsc_used(rb, rb->write_index, rb->read_index);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_data_len);
+
+/**
+ * @brief Get the size of empty space in the ring buffer in bytes.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ *
+ * @return Return the size of space, it's exact for the producer and a lower bound for the consumer.
+ */
+rt_size_t rt_ringbuffer_spsc_space_len(struct rt_ringbuffer_spsc *rb)
+{
+    rt_uint32_t read_index;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    read_index = rb->read_index;
+
+    return rb->buffer_size - _spsc_used(rb, rb->write_index, read_index);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_space_len);
+
+/**
+ * @brief Reserve empty space in the ring buffer for writing in place. Only called by the producer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param seg       The space is returned in two pieces, the second one is empty unless the space wraps.
+ * @param length    The size of space wanted.
+ *
+ * @return Return the size of space reserved, it may be less than length.
+ */
+rt_size_t rt_ringbuffer_spsc_put_reserve(struct rt_ringbuffer_spsc *rb, struct rt_ringbuffer_segment seg[2], rt_size_t length)
+{
+    rt_uint32_t read_index, write_index;
+    rt_size_t space;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(seg != RT_NULL);
+
+    read_index = rb->read_index;
+    /* the consumer has finished reading the space before it's given back */
+    RT_RINGBUFFER_BARRIER();
+    write_index = rb->write_index;
+
+    space = rb->buffer_size - _spsc_used(rb, write_index, read_index);
+    if (length > space)
+        length = space;
+
+    return _spsc_segment(rb, seg, write_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_put_reserve);
+
+/**
+ * @brief Publish the data written into the reserved space. Only called by the producer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data written, no more than the size reserved.
+ */
+void rt_ringbuffer_spsc_put_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer_spsc_space_len(rb));
+
+    /* the data must be visible before the index */
+    RT_RINGBUFFER_BARRIER();
+    rb->write_index = _spsc_advance(rb, rb->write_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_put_commit);
+
+/**
+ * @brief Reserve data in the ring buffer for reading in place. Only called by the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param seg       The data is returned in two pieces, the second one is empty unless the data wraps.
+ * @param length    The size of data wanted.
+ *
+ * @return Return the size of data reserved, it may be less than length.
+ */
+rt_size_t rt_ringbuffer_spsc_get_reserve(struct rt_ringbuffer_spsc *rb, struct rt_ringbuffer_segment seg[2], rt_size_t length)
+{
+    rt_uint32_t read_index, write_index;
+    rt_size_t size;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(seg != RT_NULL);
+
+    write_index = rb->write_index;
+    /* the data is read after the index which publishes it */
+    RT_RINGBUFFER_BARRIER();
+    read_index = rb->read_index;
+
+    size = _spsc_used(rb, write_index, read_index);
+    if (length > size)
+        length = size;
+
+    return _spsc_segment(rb, seg, read_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_get_reserve);
+
+/**
+ * @brief Give back the space of the data read from the reserved data. Only called by the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data read, no more than the size reserved.
+ */
+void rt_ringbuffer_spsc_get_commit(struct rt_ringbuffer_spsc *rb, rt_size_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer_spsc_data_len(rb));
+
+    /* the data must be read out before the space is given back */
+    RT_RINGBUFFER_BARRIER();
+    rb->read_index = _spsc_advance(rb, rb->read_index, length);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_get_commit);
+
+/**
+ * @brief Put a block of data into the ring buffer. Only called by the producer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       A pointer to the data buffer.
+ * @param length    The size of data in bytes.
+ *
+ * @return Return the data size we put into the ring buffer.
+ */
+rt_size_t rt_ringbuffer_spsc_put(struct rt_ringbuffer_spsc *rb, const rt_uint8_t *ptr, rt_size_t length)
+{
+    struct rt_ringbuffer_segment seg[2];
+
+    length = rt_ringbuffer_spsc_put_reserve(rb, seg, length);
+    if (length == 0)
+        return 0;
+
+    rt_memcpy(seg[0].ptr, ptr, seg[0].length);
+    if (seg[1].length)
+        rt_memcpy(seg[1].ptr, ptr + seg[0].length, seg[1].length);
+
+    rt_ringbuffer_spsc_put_commit(rb, length);
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_put);
+
+/**
+ * @brief Get data from the ring buffer. Only called by the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       A pointer to the buffer, used to store the data retrieved from the ring buffer.
+ * @param length    The size of the data we want to read from the ring buffer.
+ *
+ * @return Return the data size we read from the ring buffer.
+ */
+rt_size_t rt_ringbuffer_spsc_get(struct rt_ringbuffer_spsc *rb, rt_uint8_t *ptr, rt_size_t length)
+{
+    struct rt_ringbuffer_segment seg[2];
+
+    length = rt_ringbuffer_spsc_get_reserve(rb, seg, length);
+    if (length == 0)
+        return 0;
+
+    rt_memcpy(ptr, seg[0].ptr, seg[0].length);
+    if (seg[1].length)
+        rt_memcpy(ptr + seg[0].length, seg[1].ptr, seg[1].length);
+
+    rt_ringbuffer_spsc_get_commit(rb, length);
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_get);
+
+#ifdef RT_USING_HEAP
+
+/**
+ * @brief Create a lock-free single-producer single-consumer ring buffer object with a given size.
+ *
+ * @param size      The size of the buffer in bytes.
+ *
+ * @return Return a pointer to ring buffer object. When the return value is RT_NULL, it means this creation failed.
+ */
+struct rt_ringbuffer_spsc *rt_ringbuffer_spsc_create(rt_uint32_t size)
+{
+    struct rt_ringbuffer_spsc *rb;
+    rt_uint8_t *pool;
+
+    RT_ASSERT(size > 0);
+
+    rb = (struct rt_ringbuffer_spsc *)rt_malloc(sizeof(struct rt_ringbuffer_spsc));
+    if (rb == RT_NULL)
+        return RT_NULL;
+
+    pool = (rt_uint8_t *)rt_malloc(size);
+    if (pool == RT_NULL)
+    {
+        rt_free(rb);
+        return RT_NULL;
+    }
+    rt_ringbuffer_spsc_init(rb, pool, size);
+
+    return rb;
+}
+RTM_EXPORT(rt_ringbuffer_spsc_create);
+
+/**
+ * @brief Destroy the ring buffer object, which is created by rt_ringbuffer_spsc_create() .
+ *
+ * @param rb        A pointer to the ring buffer object.
+ */
+void rt_ringbuffer_spsc_destroy(struct rt_ringbuffer_spsc *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rt_free(rb->buffer_ptr);
+    rt_free(rb);
+}
+RTM_EXPORT(rt_ringbuffer_spsc_destroy);
+
+#endif
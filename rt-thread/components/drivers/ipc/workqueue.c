@@ -9,6 +9,7 @@
  * 2021-08-01     Meco Man     remove rt_delayed_work_init()
  * 2021-08-14     Jackistang   add comments for function interface
  * 2022-01-16     Meco Man     add rt_work_urgent()
+ * 2026-10-16     RT-Thread    add multi-worker workqueue, work priority and statistics
  */
 
 #include <rthw.h>
@@ -19,6 +20,17 @@
 
 static void _delayed_work_timeout_handler(void *parameter);
 
+static rt_list_t _workqueue_list = RT_LIST_OBJECT_INIT(_workqueue_list);
+
+rt_inline rt_uint64_t _workqueue_clock(void)
+{
+#ifdef RT_USING_CPUTIME
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
 rt_inline rt_err_t _workqueue_work_completion(struct rt_workqueue *queue)
 {
     rt_err_t result;
@@ -50,19 +62,170 @@ rt_inline rt_err_t _workqueue_work_completion(struct rt_workqueue *queue)
     return result;
 }
 
+/* whether the work can run on the worker */
+rt_inline rt_bool_t _workqueue_work_allowed(struct rt_workqueue_worker *worker, struct rt_work *work)
+{
+    return work->cpu == RT_WORK_CPU_ANY || worker->cpu == RT_WORK_CPU_ANY || work->cpu == worker->cpu;
+}
+
+/* the worker of the queue executing the work, RT_NULL if none, must be called with interrupt disabled */
+static struct rt_workqueue_worker *_workqueue_work_running(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_uint16_t i;
+
+    for (i = 0; i < queue->worker_num; i++)
+    {
+        if (queue->workers[i].work_current == work)
+            return &queue->workers[i];
+    }
+
+    return RT_NULL;
+}
+
+/* remove the work from the list it's in, must be called with interrupt disabled */
+static void _workqueue_work_remove(struct rt_work *work)
+{
+    if (work->flags & RT_WORK_STATE_PENDING)
+    {
+        RT_ASSERT(work->workqueue != RT_NULL);
+        work->workqueue->depth--;
+        work->flags &= ~RT_WORK_STATE_PENDING;
+    }
+    rt_list_remove(&(work->list));
+}
+
+/*
+ * Queue the work to an idle worker, or to the workers in turn if all of them
+ * are busy. The idle workers steal the works left on busy workers, so the
+ * choice here only needs to be cheap. A work queued while it's executing
+ * goes to its own worker, it must not run twice at once. Must be called with
+ * interrupt disabled.
+ */
+static struct rt_workqueue_worker *_workqueue_work_insert(struct rt_workqueue *queue,
+        struct rt_work *work, rt_bool_t urgent)
+{
+    struct rt_workqueue_worker *worker = RT_NULL;
+    struct rt_workqueue_worker *idle = RT_NULL;
+    struct rt_workqueue_worker *running = _workqueue_work_running(queue, work);
+    rt_list_t *node;
+    rt_uint16_t i, index;
+
+    for (i = 0; running == RT_NULL && i < queue->worker_num; i++)
+    {
+        index = (queue->worker_next + i) % queue->worker_num;
+        if (!_workqueue_work_allowed(&queue->workers[index], work))
+            continue;
+
+        if (worker == RT_NULL)
+        {
+            worker = &queue->workers[index];
+            queue->worker_next = (index + 1) % queue->worker_num;
+        }
+
+        if (queue->workers[index].work_current == RT_NULL &&
+                rt_list_isempty(&(queue->workers[index].work_list)))
+        {
+            idle = &queue->workers[index];
+            break;
+        }
+    }
+
+    if (running != RT_NULL)
+        worker = running;
+    else if (idle != RT_NULL)
+        worker = idle;
+    else if (worker == RT_NULL)
+        worker = &queue->workers[0];
+
+    if (urgent)
+    {
+        node = &(worker->work_list);
+    }
+    else
+    {
+        /* after the works with the same or higher priority */
+        for (node = worker->work_list.prev; node != &(worker->work_list); node = node->prev)
+        {
+            if (rt_list_entry(node, struct rt_work, list)->priority <= work->priority)
+                break;
+        }
+    }
+    rt_list_insert_after(node, &(work->list));
+
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->workqueue = queue;
+    queue->depth++;
+    if (queue->depth > queue->max_depth)
+        queue->max_depth = queue->depth;
+
+    return worker;
+}
+
+/* resume the worker if it's waiting for work, must be called with interrupt disabled */
+static rt_bool_t _workqueue_worker_wakeup(struct rt_workqueue_worker *worker)
+{
+    if (worker->work_current == RT_NULL &&
+            ((worker->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+    {
+        /* resume work thread */
+        rt_thread_resume(worker->work_thread);
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/*
+ * Fetch the next work for the worker: the work with the highest priority at
+ * the head of its own list and the lists of the other workers. Taking it from
+ * another worker steals the work. Must be called with interrupt disabled.
+ */
+static struct rt_work *_workqueue_work_fetch(struct rt_workqueue_worker *worker)
+{
+    struct rt_workqueue *queue = worker->queue;
+    struct rt_work *work = RT_NULL;
+    struct rt_work *head;
+    rt_uint16_t i;
+
+    if (!rt_list_isempty(&(worker->work_list)))
+        work = rt_list_first_entry(&(worker->work_list), struct rt_work, list);
+
+    for (i = 0; i < queue->worker_num; i++)
+    {
+        if (&queue->workers[i] == worker || rt_list_isempty(&(queue->workers[i].work_list)))
+            continue;
+
+        /* not the work queued again while its worker executes it */
+        head = rt_list_first_entry(&(queue->workers[i].work_list), struct rt_work, list);
+        if (head != queue->workers[i].work_current && _workqueue_work_allowed(worker, head) &&
+                (work == RT_NULL || head->priority < work->priority))
+        {
+            work = head;
+        }
+    }
+
+    if (work != RT_NULL && work->list.prev != &(worker->work_list))
+        worker->steal_count++;
+
+    return work;
+}
+
 static void _workqueue_thread_entry(void *parameter)
 {
     rt_base_t level;
     struct rt_work *work;
-    struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
+    rt_uint64_t start;
+    rt_uint32_t elapsed;
 
-    queue = (struct rt_workqueue *) parameter;
-    RT_ASSERT(queue != RT_NULL);
+    worker = (struct rt_workqueue_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
 
     while (1)
     {
         level = rt_hw_interrupt_disable();
-        if (rt_list_isempty(&(queue->work_list)))
+        work = _workqueue_work_fetch(worker);
+        if (work == RT_NULL)
         {
             /* no software timer exist, suspend self. */
             rt_thread_suspend(rt_thread_self());
@@ -72,20 +235,27 @@ static void _workqueue_thread_entry(void *parameter)
         }
 
         /* we have work to do with. */
-        work = rt_list_entry(queue->work_list.next, struct rt_work, list);
-        rt_list_remove(&(work->list));
-        queue->work_current = work;
-        work->flags &= ~RT_WORK_STATE_PENDING;
+        _workqueue_work_remove(work);
+        worker->work_current = work;
         work->workqueue = RT_NULL;
         rt_hw_interrupt_enable(level);
 
         /* do work */
+        start = _workqueue_clock();
         work->work_func(work, work->work_data);
+        elapsed = (rt_uint32_t)(_workqueue_clock() - start);
+
+        level = rt_hw_interrupt_disable();
+        worker->work_count++;
+        worker->total_time += elapsed;
+        if (elapsed > worker->max_time)
+            worker->max_time = elapsed;
         /* clean current work */
-        queue->work_current = RT_NULL;
+        worker->work_current = RT_NULL;
+        rt_hw_interrupt_enable(level);
 
         /* ack work completion */
-        _workqueue_work_completion(queue);
+        _workqueue_work_completion(worker->queue);
     }
 }
 
@@ -94,39 +264,33 @@ static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue,
 {
     rt_base_t level;
     rt_err_t err;
+    struct rt_workqueue_worker *worker;
 
     level = rt_hw_interrupt_disable();
     /* remove list */
-    rt_list_remove(&(work->list));
-    work->flags &= ~RT_WORK_STATE_PENDING;
+    _workqueue_work_remove(work);
 
     if (ticks == 0)
     {
-        if (queue->work_current != work)
+        if (!_workqueue_work_running(queue, work))
         {
-            rt_list_insert_after(queue->work_list.prev, &(work->list));
-            work->flags |= RT_WORK_STATE_PENDING;
-            work->workqueue = queue;
+            worker = _workqueue_work_insert(queue, work, RT_FALSE);
             err = RT_EOK;
+
+            /* whether the workqueue is doing work */
+            if (_workqueue_worker_wakeup(worker))
+            {
+                rt_hw_interrupt_enable(level);
+                rt_schedule();
+                return err;
+            }
         }
         else
         {
             err = -RT_EBUSY;
         }
 
-        /* whether the workqueue is doing work */
-        if (queue->work_current == RT_NULL &&
-                ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
-        {
-            /* resume work thread */
-            rt_thread_resume(queue->work_thread);
-            rt_hw_interrupt_enable(level);
-            rt_schedule();
-        }
-        else
-        {
-            rt_hw_interrupt_enable(level);
-        }
+        rt_hw_interrupt_enable(level);
         return err;
     }
     else if (ticks < RT_TICK_MAX / 2)
@@ -160,8 +324,7 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
     rt_err_t err;
 
     level = rt_hw_interrupt_disable();
-    rt_list_remove(&(work->list));
-    work->flags &= ~RT_WORK_STATE_PENDING;
+    _workqueue_work_remove(work);
     /* Timer started */
     if (work->flags & RT_WORK_STATE_SUBMITTING)
     {
@@ -169,7 +332,7 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
         rt_timer_detach(&(work->timer));
         work->flags &= ~RT_WORK_STATE_SUBMITTING;
     }
-    err = queue->work_current != work ? RT_EOK : -RT_EBUSY;
+    err = _workqueue_work_running(queue, work) ? -RT_EBUSY : RT_EOK;
     work->workqueue = RT_NULL;
     rt_hw_interrupt_enable(level);
     return err;
@@ -179,6 +342,7 @@ static void _delayed_work_timeout_handler(void *parameter)
 {
     struct rt_work *work;
     struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
     rt_base_t level;
 
     work = (struct rt_work *)parameter;
@@ -191,24 +355,18 @@ static void _delayed_work_timeout_handler(void *parameter)
     /* remove delay list */
     rt_list_remove(&(work->list));
     /* insert work queue */
-    if (queue->work_current != work)
-    {
-        rt_list_insert_after(queue->work_list.prev, &(work->list));
-        work->flags |= RT_WORK_STATE_PENDING;
-    }
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL &&
-            ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
-    {
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
-        rt_hw_interrupt_enable(level);
-        rt_schedule();
-    }
-    else
+    if (!_workqueue_work_running(queue, work))
     {
-        rt_hw_interrupt_enable(level);
+        worker = _workqueue_work_insert(queue, work, RT_FALSE);
+        /* whether the workqueue is doing work */
+        if (_workqueue_worker_wakeup(worker))
+        {
+            rt_hw_interrupt_enable(level);
+            rt_schedule();
+            return;
+        }
     }
+    rt_hw_interrupt_enable(level);
 }
 
 /**
@@ -233,6 +391,38 @@ void rt_work_init(struct rt_work *work,
     work->workqueue = RT_NULL;
     work->flags = 0;
     work->type = 0;
+    work->priority = RT_WORK_PRIORITY_DEFAULT;
+    work->cpu = RT_WORK_CPU_ANY;
+}
+
+/**
+ * @brief Set the priority of a work item. The pending work items run in order of priority,
+ *        and in order of submission for the same priority.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @param priority is the priority of the work item, the smaller value, the higher priority.
+ */
+void rt_work_set_priority(struct rt_work *work, rt_uint8_t priority)
+{
+    RT_ASSERT(work != RT_NULL);
+
+    work->priority = priority;
+}
+
+/**
+ * @brief Set the cpu to run a work item. It only makes sense with SMP, for the workers of
+ *        a workqueue created by rt_workqueue_create_pool() are bound to the cpus in turn.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @param cpu is the cpu index, or RT_WORK_CPU_ANY to run it on any worker.
+ */
+void rt_work_set_cpu(struct rt_work *work, rt_uint8_t cpu)
+{
+    RT_ASSERT(work != RT_NULL);
+
+    work->cpu = cpu;
 }
 
 /**
@@ -247,28 +437,96 @@ void rt_work_init(struct rt_work *work,
  * @return Return a pointer to the workqueue object. It will return RT_NULL if failed.
  */
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    return rt_workqueue_create_pool(name, stack_size, priority, 1);
+}
+
+/**
+ * @brief Create a work queue with several worker threads inside. The work items are
+ *        queued to the idle workers, and an idle worker takes the pending work items
+ *        from the busy ones, so a slow work item doesn't hold up the others.
+ *
+ * @param name is a name of the work queue. The worker threads are named with a
+ *        suffix of their index if there are more than one.
+ *
+ * @param stack_size is stack size of each worker thread.
+ *
+ * @param priority is a priority of the worker threads.
+ *
+ * @param worker_num is the number of worker threads. With SMP, the worker threads
+ *        are bound to the cpus in turn if there are more than one.
+ *
+ * @return Return a pointer to the workqueue object. It will return RT_NULL if failed.
+ */
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                              rt_uint16_t worker_num)
 {
     struct rt_workqueue *queue = RT_NULL;
+    struct rt_workqueue_worker *worker;
+    char thread_name[RT_NAME_MAX];
+    rt_base_t level;
+    rt_uint16_t i;
 
-    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
-    if (queue != RT_NULL)
+    RT_ASSERT(worker_num > 0);
+
+    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue) +
+            worker_num * sizeof(struct rt_workqueue_worker));
+    if (queue == RT_NULL)
+        return RT_NULL;
+
+    rt_memset(queue, 0, sizeof(struct rt_workqueue) + worker_num * sizeof(struct rt_workqueue_worker));
+    rt_strncpy(queue->name, name, RT_NAME_MAX);
+    /* initialize work list */
+    rt_list_init(&(queue->delayed_list));
+    rt_sem_init(&(queue->sem), "wqueue", 0, RT_IPC_FLAG_FIFO);
+    queue->workers = (struct rt_workqueue_worker *)(queue + 1);
+
+    for (i = 0; i < worker_num; i++)
     {
-        /* initialize work list */
-        rt_list_init(&(queue->work_list));
-        rt_list_init(&(queue->delayed_list));
-        queue->work_current = RT_NULL;
-        rt_sem_init(&(queue->sem), "wqueue", 0, RT_IPC_FLAG_FIFO);
+        worker = &queue->workers[i];
+        rt_list_init(&(worker->work_list));
+        worker->queue = queue;
+        worker->cpu = RT_WORK_CPU_ANY;
+
+        rt_strncpy(thread_name, name, RT_NAME_MAX);
+        if (worker_num > 1)
+        {
+            /* leave room for the index */
+            thread_name[RT_NAME_MAX - 4] = '\0';
+            rt_snprintf(thread_name + rt_strlen(thread_name), 4, "%d", i);
+        }
 
         /* create the work thread */
-        queue->work_thread = rt_thread_create(name, _workqueue_thread_entry, queue, stack_size, priority, 10);
-        if (queue->work_thread == RT_NULL)
+        worker->work_thread = rt_thread_create(thread_name, _workqueue_thread_entry, worker,
+                                               stack_size, priority, 10);
+        if (worker->work_thread == RT_NULL)
+            break;
+
+#ifdef RT_USING_SMP
+        if (worker_num > 1)
         {
-            RT_KERNEL_FREE(queue);
-            return RT_NULL;
+            worker->cpu = i % RT_CPUS_NR;
+            rt_thread_control(worker->work_thread, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)worker->cpu);
         }
+#endif /* RT_USING_SMP */
+    }
 
-        rt_thread_startup(queue->work_thread);
+    if (i < worker_num)
+    {
+        while (i--)
+            rt_thread_delete(queue->workers[i].work_thread);
+        rt_sem_detach(&(queue->sem));
+        RT_KERNEL_FREE(queue);
+        return RT_NULL;
     }
+    queue->worker_num = worker_num;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&_workqueue_list, &(queue->list));
+    rt_hw_interrupt_enable(level);
+
+    for (i = 0; i < worker_num; i++)
+        rt_thread_startup(queue->workers[i].work_thread);
 
     return queue;
 }
@@ -282,10 +540,18 @@ struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_siz
  */
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue)
 {
+    rt_base_t level;
+    rt_uint16_t i;
+
     RT_ASSERT(queue != RT_NULL);
 
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(queue->list));
+    rt_hw_interrupt_enable(level);
+
     rt_workqueue_cancel_all_work(queue);
-    rt_thread_delete(queue->work_thread);
+    for (i = 0; i < queue->worker_num; i++)
+        rt_thread_delete(queue->workers[i].work_thread);
     rt_sem_detach(&(queue->sem));
     RT_KERNEL_FREE(queue);
 
@@ -346,20 +612,18 @@ rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *wo
 rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work)
 {
     rt_base_t level;
+    struct rt_workqueue_worker *worker;
 
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(work != RT_NULL);
 
     level = rt_hw_interrupt_disable();
     /* NOTE: the work MUST be initialized firstly */
-    rt_list_remove(&(work->list));
-    rt_list_insert_after(&queue->work_list, &(work->list));
+    _workqueue_work_remove(work);
+    worker = _workqueue_work_insert(queue, work, RT_TRUE);
     /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL &&
-            ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+    if (_workqueue_worker_wakeup(worker))
     {
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
         rt_hw_interrupt_enable(level);
         rt_schedule();
     }
@@ -403,14 +667,11 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(work != RT_NULL);
 
-    if (queue->work_current == work) /* it's current work in the queue */
+    if (_workqueue_cancel_work(queue, work) == -RT_EBUSY) /* it's current work in the queue */
     {
         /* wait for work completion */
-        rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
-    }
-    else
-    {
-        _workqueue_cancel_work(queue, work);
+        while (_workqueue_work_running(queue, work))
+            rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
     }
 
     return RT_EOK;
@@ -426,15 +687,19 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
 rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
 {
     struct rt_work *work;
+    rt_uint16_t i;
 
     RT_ASSERT(queue != RT_NULL);
 
     /* cancel work */
     rt_enter_critical();
-    while (rt_list_isempty(&queue->work_list) == RT_FALSE)
+    for (i = 0; i < queue->worker_num; i++)
     {
-        work = rt_list_first_entry(&queue->work_list, struct rt_work, list);
-        _workqueue_cancel_work(queue, work);
+        while (rt_list_isempty(&queue->workers[i].work_list) == RT_FALSE)
+        {
+            work = rt_list_first_entry(&queue->workers[i].work_list, struct rt_work, list);
+            _workqueue_cancel_work(queue, work);
+        }
     }
     /* cancel delay work */
     while (rt_list_isempty(&queue->delayed_list) == RT_FALSE)
@@ -449,6 +714,10 @@ rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
 
 #ifdef RT_USING_SYSTEM_WORKQUEUE
 
+#ifndef RT_SYSTEM_WORKQUEUE_WORKERS
+#define RT_SYSTEM_WORKQUEUE_WORKERS 1
+#endif
+
 static struct rt_workqueue *sys_workq; /* system work queue */
 
 /**
@@ -499,12 +768,90 @@ static int rt_work_sys_workqueue_init(void)
     if (sys_workq != RT_NULL)
         return RT_EOK;
 
-    sys_workq = rt_workqueue_create("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
-                                    RT_SYSTEM_WORKQUEUE_PRIORITY);
+    sys_workq = rt_workqueue_create_pool("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
+                                         RT_SYSTEM_WORKQUEUE_PRIORITY, RT_SYSTEM_WORKQUEUE_WORKERS);
     RT_ASSERT(sys_workq != RT_NULL);
 
     return RT_EOK;
 }
 INIT_PREV_EXPORT(rt_work_sys_workqueue_init);
 #endif /* RT_USING_SYSTEM_WORKQUEUE */
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+/* convert the execution time to microsecond */
+static rt_uint32_t _workqueue_time_us(rt_uint64_t time)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)(time * clock_cpu_getres() / 1000);
+#else
+    return (rt_uint32_t)(time * (1000000 / RT_TICK_PER_SECOND));
+#endif
+}
+
+static int list_workqueue(int argc, char **argv)
+{
+    struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker, stat;
+    void (*work_func)(struct rt_work *work, void *work_data);
+    rt_bool_t reset = argc > 1 && rt_strcmp(argv[1], "-r") == 0;
+    rt_base_t level;
+    rt_list_t *node;
+    rt_uint16_t i, depth;
+
+    if (argc > 1 && !reset)
+    {
+        rt_kprintf("Usage: list_workqueue [-r]\n");
+        rt_kprintf("  -r    reset the statistics\n");
+        return -RT_EINVAL;
+    }
+
+    rt_kprintf("%-*s depth  max cpu    works   steals  avg(us)  max(us) current\n", RT_NAME_MAX + 2, "workqueue");
+    rt_kprintf("------------------ ----- ---- --- -------- -------- -------- -------- ----------\n");
+
+    /* the workqueues are seldom created or destroyed, it's good enough to lock scheduler */
+    rt_enter_critical();
+    rt_list_for_each(node, &_workqueue_list)
+    {
+        queue = rt_list_entry(node, struct rt_workqueue, list);
+        rt_kprintf("%-*.*s %5d %4d\n", RT_NAME_MAX + 2, RT_NAME_MAX, queue->name, queue->depth, queue->max_depth);
+        if (reset)
+            queue->max_depth = queue->depth;
+
+        for (i = 0; i < queue->worker_num; i++)
+        {
+            worker = &queue->workers[i];
+
+            /* take a snapshot, for the worker updates it with interrupt disabled */
+            level = rt_hw_interrupt_disable();
+            stat = *worker;
+            depth = rt_list_len(&(worker->work_list));
+            work_func = worker->work_current ? worker->work_current->work_func : RT_NULL;
+            if (reset)
+            {
+                worker->work_count = 0;
+                worker->steal_count = 0;
+                worker->max_time = 0;
+                worker->total_time = 0;
+            }
+            rt_hw_interrupt_enable(level);
+
+            rt_kprintf("  %-*.*s %5d      ", RT_NAME_MAX, RT_NAME_MAX, stat.work_thread->name, depth);
+            if (stat.cpu == RT_WORK_CPU_ANY)
+                rt_kprintf("  -");
+            else
+                rt_kprintf("%3d", stat.cpu);
+            rt_kprintf(" %8d %8d %8d %8d %p\n", stat.work_count, stat.steal_count,
+                       stat.work_count ? _workqueue_time_us(stat.total_time / stat.work_count) : 0,
+                       _workqueue_time_us(stat.max_time),
+                       (void *)work_func);
+        }
+    }
+    rt_exit_critical();
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_workqueue, list workqueue and worker statistics);
+#endif /* RT_USING_FINSH */
 #endif /* RT_USING_HEAP */
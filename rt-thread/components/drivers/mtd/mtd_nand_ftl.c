@@ -0,0 +1,1446 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/mtd_nand_ftl.h>
+#include <stdlib.h>
+
+#define DBG_TAG    "nand.ftl"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#ifndef RT_MTD_NAND_FTL_RESERVE
+#define RT_MTD_NAND_FTL_RESERVE         5
+#endif
+
+#ifndef RT_MTD_NAND_FTL_CKPT_INTERVAL
+#define RT_MTD_NAND_FTL_CKPT_INTERVAL   4096
+#endif
+
+#ifndef RT_MTD_NAND_FTL_WL_THRESHOLD
+#define RT_MTD_NAND_FTL_WL_THRESHOLD    64
+#endif
+
+#ifndef RT_MTD_NAND_FTL_GC_PERIOD
+#define RT_MTD_NAND_FTL_GC_PERIOD       200
+#endif
+
+#ifndef RT_MTD_NAND_FTL_GC_FREE
+#define RT_MTD_NAND_FTL_GC_FREE         8
+#endif
+
+/* the blocks of the host and gc streams, and the two kept free for them */
+#define FTL_FIXED_BLOCKS                4
+/* for the blocks going bad */
+#define FTL_SPARE_BLOCKS                4
+
+#define FTL_MIN(a, b)                   ((a) < (b) ? (a) : (b))
+#define FTL_MAX(a, b)                   ((a) > (b) ? (a) : (b))
+
+#define FTL_NONE                        ((rt_uint32_t)-1)
+#define FTL_MAGIC                       0x4C54464E      /* "NFTL" */
+#define FTL_VERSION                     1
+
+#define FTL_PAGE_DATA                   0x01
+#define FTL_PAGE_CKPT                   0x02
+
+#define FTL_BLK_FREE                    0               /* no valid page, erased before use */
+#define FTL_BLK_OPEN                    1               /* being written by a stream */
+#define FTL_BLK_USED                    2
+#define FTL_BLK_CKPT                    3               /* of the checkpoint in force */
+#define FTL_BLK_CKPT_NEW                4               /* of the checkpoint being written */
+#define FTL_BLK_BAD                     5
+
+#define FTL_STREAM_HOST                 0               /* pages written by the filesystem */
+#define FTL_STREAM_GC                   1               /* pages moved by the garbage collection */
+#define FTL_STREAM_CKPT                 2
+#define FTL_STREAMS                     3
+
+/* in the spare area of every page */
+struct ftl_meta
+{
+    rt_uint8_t type;
+    rt_uint8_t reserved;
+    rt_uint16_t crc;                            /* of the meta with crc 0 */
+    rt_uint32_t seq;                            /* write sequence, or that of the checkpoint */
+    rt_uint32_t addr;                           /* logical page, or index | total << 16 of a checkpoint page */
+    rt_uint32_t ec;                             /* erase count of the block */
+};
+
+/* a checkpoint is the header, the mapping, the erase counts of the blocks and a crc32 of them */
+struct ftl_ckpt_header
+{
+    rt_uint32_t magic;
+    rt_uint32_t version;
+    rt_uint32_t seq;
+    rt_uint32_t blocks;
+    rt_uint32_t pages_per_block;
+    rt_uint32_t page_size;
+    rt_uint32_t lpns;
+    rt_uint32_t open[2];                        /* blocks of the host and gc streams */
+};
+
+struct ftl_block
+{
+    rt_uint32_t ec;
+    rt_uint16_t valid;
+    rt_uint8_t state;
+    rt_uint8_t erased;
+};
+
+struct ftl_stream
+{
+    rt_uint32_t block;
+    rt_uint32_t page;
+};
+
+struct mtd_nand_ftl
+{
+    struct rt_device parent;
+    struct rt_mtd_nand_device *nand;
+
+    rt_uint32_t blocks;
+    rt_uint32_t ppb;
+    rt_uint32_t page_size;
+    rt_uint32_t lpns;                           /* logical pages */
+    rt_uint32_t ckpt_pages;
+    rt_uint32_t ckpt_blocks;
+
+    struct rt_mutex lock;
+    rt_uint32_t *map;                           /* logical page to page, FTL_NONE if not written */
+    struct ftl_block *blk;
+    rt_uint8_t *buf;                            /* a page */
+    struct ftl_stream stream[FTL_STREAMS];
+    rt_uint32_t free_blocks;
+
+    rt_uint32_t seq;                            /* of the next page */
+    rt_uint32_t ckpt_seq;                       /* of the checkpoint in force */
+    rt_uint32_t since_ckpt;                     /* pages written after it */
+
+#if RT_MTD_NAND_FTL_GC_PERIOD > 0
+    struct rt_work gc_work;
+#endif
+
+    struct rt_mtd_nand_ftl_stat stat;
+    rt_slist_t node;
+};
+
+static rt_slist_t _ftl_list = RT_SLIST_OBJECT_INIT(_ftl_list);
+
+static const rt_uint32_t _ftl_crc_table[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static rt_uint32_t _ftl_crc32(rt_uint32_t crc, const void *buf, rt_size_t len)
+{
+    const rt_uint8_t *p = (const rt_uint8_t *)buf;
+
+    crc = ~crc;
+    while (len--)
+    {
+        crc = _ftl_crc_table[(crc ^ *p) & 0x0F] ^ (crc >> 4);
+        crc = _ftl_crc_table[(crc ^ (*p >> 4)) & 0x0F] ^ (crc >> 4);
+        p++;
+    }
+
+    return ~crc;
+}
+
+static rt_uint16_t _ftl_meta_crc(const struct ftl_meta *meta)
+{
+    struct ftl_meta tmp = *meta;
+
+    tmp.crc = 0;
+    return (rt_uint16_t)_ftl_crc32(0, &tmp, sizeof(tmp));
+}
+
+static rt_off_t _ftl_page(struct mtd_nand_ftl *ftl, rt_uint32_t block, rt_uint32_t page)
+{
+    return (ftl->nand->block_start + block) * ftl->ppb + page;
+}
+
+/* RT_EOK, -RT_EEMPTY for a page not written, or -RT_ERROR */
+static rt_err_t _ftl_check_meta(const struct ftl_meta *meta)
+{
+    const rt_uint8_t *p = (const rt_uint8_t *)meta;
+    rt_size_t i;
+
+    for (i = 0; i < sizeof(*meta) && p[i] == 0xFF; i++);
+    if (i == sizeof(*meta))
+        return -RT_EEMPTY;
+
+    return _ftl_meta_crc(meta) == meta->crc ? RT_EOK : -RT_ERROR;
+}
+
+/* -RT_ERROR if the page is not readable, -RT_EIO if the device failed */
+static rt_err_t _ftl_read_page(struct mtd_nand_ftl *ftl, rt_uint32_t block, rt_uint32_t page,
+                               rt_uint8_t *data, struct ftl_meta *meta)
+{
+    rt_err_t result;
+
+    result = rt_mtd_nand_read(ftl->nand, _ftl_page(ftl, block, page), data, data ? ftl->page_size : 0,
+                              (rt_uint8_t *)meta, sizeof(*meta));
+    if (result == -RT_MTD_EECC)
+        return -RT_ERROR;
+    if (result != RT_EOK)
+        return -RT_EIO;
+
+    return _ftl_check_meta(meta);
+}
+
+/* the block is full, or given up */
+static void _ftl_close_stream(struct mtd_nand_ftl *ftl, int s)
+{
+    struct ftl_block *blk = &ftl->blk[ftl->stream[s].block];
+
+    if (blk->state == FTL_BLK_OPEN)
+    {
+        if (blk->valid)
+        {
+            blk->state = FTL_BLK_USED;
+        }
+        else
+        {
+            blk->state = FTL_BLK_FREE;
+            ftl->free_blocks++;
+        }
+    }
+    ftl->stream[s].block = FTL_NONE;
+}
+
+static void _ftl_invalidate(struct mtd_nand_ftl *ftl, rt_uint32_t ppn)
+{
+    struct ftl_block *blk = &ftl->blk[ppn / ftl->ppb];
+
+    RT_ASSERT(blk->valid > 0);
+
+    if (--blk->valid == 0 && blk->state == FTL_BLK_USED)
+    {
+        blk->state = FTL_BLK_FREE;
+        ftl->free_blocks++;
+    }
+}
+
+static void _ftl_mark_bad(struct mtd_nand_ftl *ftl, rt_uint32_t block)
+{
+    LOG_W("%s: block %d goes bad", ftl->parent.parent.name, ftl->nand->block_start + block);
+
+    if (ftl->blk[block].state == FTL_BLK_FREE)
+        ftl->free_blocks--;
+    ftl->blk[block].state = FTL_BLK_BAD;
+    ftl->stat.retired++;
+    rt_mtd_nand_mark_badblock(ftl->nand, ftl->nand->block_start + block);
+}
+
+/*
+ * Take a free block, erased before use. The host stream and the checkpoints take the
+ * least erased one, and the garbage collection, moving colder data, takes the most.
+ */
+static rt_uint32_t _ftl_alloc(struct mtd_nand_ftl *ftl, int s)
+{
+    rt_uint32_t block, i;
+
+    for (;;)
+    {
+        block = FTL_NONE;
+        for (i = 0; i < ftl->blocks; i++)
+        {
+            if (ftl->blk[i].state != FTL_BLK_FREE)
+                continue;
+
+            if (block == FTL_NONE ||
+                    (s == FTL_STREAM_GC ? ftl->blk[i].ec > ftl->blk[block].ec : ftl->blk[i].ec < ftl->blk[block].ec))
+                block = i;
+        }
+        if (block == FTL_NONE)
+            return FTL_NONE;
+
+        if (!ftl->blk[block].erased)
+        {
+            ftl->stat.erases++;
+            if (rt_mtd_nand_erase_block(ftl->nand, ftl->nand->block_start + block) != RT_EOK)
+            {
+                _ftl_mark_bad(ftl, block);
+                continue;
+            }
+            ftl->blk[block].ec++;
+        }
+
+        ftl->blk[block].erased = 0;
+        ftl->blk[block].valid = 0;
+        ftl->blk[block].state = (s == FTL_STREAM_CKPT) ? FTL_BLK_CKPT_NEW : FTL_BLK_OPEN;
+        ftl->free_blocks--;
+
+        return block;
+    }
+}
+
+/* program the next page of a stream, -RT_EIO if the page failed or -RT_EFULL if no block is free */
+static rt_err_t _ftl_program(struct mtd_nand_ftl *ftl, int s, rt_uint8_t type, rt_uint32_t seq,
+                             rt_uint32_t addr, const rt_uint8_t *data, rt_uint32_t *ppn)
+{
+    struct ftl_stream *stream = &ftl->stream[s];
+    struct ftl_meta meta;
+    rt_err_t result;
+
+    if (stream->block == FTL_NONE)
+    {
+        stream->block = _ftl_alloc(ftl, s);
+        stream->page = 0;
+        if (stream->block == FTL_NONE)
+            return -RT_EFULL;
+    }
+
+    rt_memset(&meta, 0, sizeof(meta));
+    meta.type = type;
+    meta.seq = seq;
+    meta.addr = addr;
+    meta.ec = ftl->blk[stream->block].ec;
+    meta.crc = _ftl_meta_crc(&meta);
+
+    result = rt_mtd_nand_write(ftl->nand, _ftl_page(ftl, stream->block, stream->page),
+                               data, ftl->page_size, (const rt_uint8_t *)&meta, sizeof(meta));
+    if (result != RT_EOK)
+        return -RT_EIO;
+
+    *ppn = stream->block * ftl->ppb + stream->page;
+    stream->page++;
+
+    return RT_EOK;
+}
+
+static void _ftl_retire(struct mtd_nand_ftl *ftl, rt_uint32_t block);
+
+/* write a logical page to a stream, a block failing is retired and the write goes on in another */
+static rt_err_t _ftl_write_page(struct mtd_nand_ftl *ftl, int s, rt_uint32_t lpn, const rt_uint8_t *data)
+{
+    rt_uint32_t ppn, block;
+    rt_err_t result;
+
+    for (;;)
+    {
+        result = _ftl_program(ftl, s, FTL_PAGE_DATA, ftl->seq++, lpn, data, &ppn);
+        if (result == -RT_EFULL)
+            return result;
+
+        block = ftl->stream[s].block;
+        if (result != RT_EOK)
+        {
+            ftl->stream[s].block = FTL_NONE;
+            _ftl_retire(ftl, block);
+            continue;
+        }
+
+        if (ftl->map[lpn] != FTL_NONE)
+            _ftl_invalidate(ftl, ftl->map[lpn]);
+        ftl->map[lpn] = ppn;
+        ftl->blk[block].valid++;
+        ftl->since_ckpt++;
+
+        if (ftl->stream[s].page == ftl->ppb)
+            _ftl_close_stream(ftl, s);
+
+        return RT_EOK;
+    }
+}
+
+/* move the valid pages of a block to the gc stream */
+static rt_err_t _ftl_relocate(struct mtd_nand_ftl *ftl, rt_uint32_t block)
+{
+    struct ftl_meta meta;
+    rt_uint32_t page, ppn, lpn;
+    rt_err_t result;
+
+    for (page = 0; page < ftl->ppb && ftl->blk[block].valid > 0; page++)
+    {
+        ppn = block * ftl->ppb + page;
+
+        result = _ftl_read_page(ftl, block, page, RT_NULL, &meta);
+        if (result == RT_EOK && meta.type == FTL_PAGE_DATA && meta.addr < ftl->lpns && ftl->map[meta.addr] != ppn)
+            continue;
+
+        if (result == RT_EOK && meta.type == FTL_PAGE_DATA && meta.addr < ftl->lpns)
+            result = _ftl_read_page(ftl, block, page, ftl->buf, &meta);
+
+        if (result == -RT_EIO)
+            return result;
+
+        if (result != RT_EOK || meta.type != FTL_PAGE_DATA || meta.addr >= ftl->lpns)
+        {
+            /* a page unreadable, drop the logical page mapped to it */
+            for (lpn = 0; lpn < ftl->lpns; lpn++)
+            {
+                if (ftl->map[lpn] == ppn)
+                {
+                    LOG_E("%s: logical page %d lost", ftl->parent.parent.name, lpn);
+                    _ftl_invalidate(ftl, ppn);
+                    ftl->map[lpn] = FTL_NONE;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        result = _ftl_write_page(ftl, FTL_STREAM_GC, meta.addr, ftl->buf);
+        if (result != RT_EOK)
+            return result;
+        ftl->stat.gc_pages++;
+    }
+
+    return RT_EOK;
+}
+
+/* a block failed programming, move out what it holds and give it up */
+static void _ftl_retire(struct mtd_nand_ftl *ftl, rt_uint32_t block)
+{
+    /* neither collected nor allocated from now on */
+    ftl->blk[block].state = FTL_BLK_BAD;
+    _ftl_relocate(ftl, block);
+    _ftl_mark_bad(ftl, block);
+}
+
+/* the block to collect: the fewest valid pages, or the least erased for the wear levelling */
+static rt_uint32_t _ftl_victim(struct mtd_nand_ftl *ftl, rt_bool_t wl)
+{
+    rt_uint32_t block = FTL_NONE, i;
+
+    for (i = 0; i < ftl->blocks; i++)
+    {
+        struct ftl_block *blk = &ftl->blk[i];
+
+        if (blk->state != FTL_BLK_USED)
+            continue;
+
+        if (block == FTL_NONE)
+            block = i;
+        else if (wl && blk->ec < ftl->blk[block].ec)
+            block = i;
+        else if (!wl && (blk->valid < ftl->blk[block].valid ||
+                         (blk->valid == ftl->blk[block].valid && blk->ec < ftl->blk[block].ec)))
+            block = i;
+    }
+
+    return block;
+}
+
+static rt_err_t _ftl_collect_block(struct mtd_nand_ftl *ftl, rt_uint32_t block)
+{
+    rt_err_t result = _ftl_relocate(ftl, block);
+
+    if (result == RT_EOK)
+        ftl->stat.gc_blocks++;
+
+    return result;
+}
+
+/* collect blocks until a host block and a checkpoint can be written */
+static rt_err_t _ftl_make_room(struct mtd_nand_ftl *ftl)
+{
+    rt_uint32_t victim, tries;
+
+    for (tries = 0; ftl->free_blocks < ftl->ckpt_blocks + 2; tries++)
+    {
+        victim = _ftl_victim(ftl, RT_FALSE);
+        if (victim == FTL_NONE || ftl->blk[victim].valid == ftl->ppb || tries >= ftl->blocks)
+        {
+            LOG_E("%s: no space", ftl->parent.parent.name);
+            return -RT_EFULL;
+        }
+
+        if (_ftl_collect_block(ftl, victim) != RT_EOK)
+            return -RT_EFULL;
+    }
+
+    return RT_EOK;
+}
+
+static rt_size_t _ftl_ckpt_size(rt_uint32_t lpns, rt_uint32_t blocks)
+{
+    return sizeof(struct ftl_ckpt_header) + (lpns + blocks + 1) * sizeof(rt_uint32_t);
+}
+
+/*
+ * Copy a part of the checkpoint: the header, the map, the erase counts and the crc. The parts
+ * are copied in order and the crc runs over what was copied, as the erase counts change when
+ * the blocks of the checkpoint are taken.
+ */
+static void _ftl_ckpt_fill(struct mtd_nand_ftl *ftl, const struct ftl_ckpt_header *header, rt_uint32_t *crc,
+                           rt_size_t off, rt_uint8_t *buf, rt_size_t len)
+{
+    rt_size_t map_off = sizeof(*header);
+    rt_size_t ec_off = map_off + ftl->lpns * sizeof(rt_uint32_t);
+    rt_size_t crc_off = ec_off + ftl->blocks * sizeof(rt_uint32_t);
+    rt_size_t n;
+
+    while (len > 0)
+    {
+        if (off < map_off)
+        {
+            n = FTL_MIN(len, map_off - off);
+            rt_memcpy(buf, (const rt_uint8_t *)header + off, n);
+        }
+        else if (off < ec_off)
+        {
+            n = FTL_MIN(len, ec_off - off);
+            rt_memcpy(buf, (const rt_uint8_t *)ftl->map + off - map_off, n);
+        }
+        else if (off < crc_off)
+        {
+            rt_uint32_t ec = ftl->blk[(off - ec_off) / sizeof(rt_uint32_t)].ec;
+            rt_size_t at = (off - ec_off) % sizeof(rt_uint32_t);
+
+            n = FTL_MIN(len, sizeof(rt_uint32_t) - at);
+            rt_memcpy(buf, (const rt_uint8_t *)&ec + at, n);
+        }
+        else if (off < crc_off + sizeof(*crc))
+        {
+            n = FTL_MIN(len, crc_off + sizeof(*crc) - off);
+            rt_memcpy(buf, (const rt_uint8_t *)crc + off - crc_off, n);
+        }
+        else
+        {
+            n = len;
+            rt_memset(buf, 0, n);
+        }
+
+        if (off < crc_off)
+            *crc = _ftl_crc32(*crc, buf, n);
+
+        off += n;
+        buf += n;
+        len -= n;
+    }
+}
+
+static void _ftl_ckpt_abort(struct mtd_nand_ftl *ftl)
+{
+    rt_uint32_t i;
+
+    for (i = 0; i < ftl->blocks; i++)
+    {
+        if (ftl->blk[i].state == FTL_BLK_CKPT_NEW)
+        {
+            ftl->blk[i].state = FTL_BLK_FREE;
+            ftl->free_blocks++;
+        }
+    }
+    ftl->stream[FTL_STREAM_CKPT].block = FTL_NONE;
+}
+
+/*
+ * Write the mapping to fresh blocks. The blocks of the checkpoint before are kept until
+ * this one is complete, so one of them is always whole on the flash.
+ */
+static rt_err_t _ftl_checkpoint(struct mtd_nand_ftl *ftl)
+{
+    struct ftl_ckpt_header header;
+    rt_uint32_t crc, i, ppn, tries;
+    rt_err_t result = -RT_ERROR;
+
+    _ftl_make_room(ftl);
+
+    for (tries = 0; tries < 3 && result != RT_EOK; tries++)
+    {
+        if (ftl->free_blocks < ftl->ckpt_blocks)
+            return -RT_EFULL;
+
+        header.magic = FTL_MAGIC;
+        header.version = FTL_VERSION;
+        header.seq = ftl->seq++;
+        header.blocks = ftl->blocks;
+        header.pages_per_block = ftl->ppb;
+        header.page_size = ftl->page_size;
+        header.lpns = ftl->lpns;
+        header.open[0] = ftl->stream[FTL_STREAM_HOST].block;
+        header.open[1] = ftl->stream[FTL_STREAM_GC].block;
+        crc = 0;
+
+        /* a checkpoint starts at the first page of a block */
+        ftl->stream[FTL_STREAM_CKPT].block = FTL_NONE;
+        for (i = 0, result = RT_EOK; i < ftl->ckpt_pages && result == RT_EOK; i++)
+        {
+            rt_uint32_t block = ftl->stream[FTL_STREAM_CKPT].block;
+
+            if (block != FTL_NONE && ftl->stream[FTL_STREAM_CKPT].page == ftl->ppb)
+                ftl->stream[FTL_STREAM_CKPT].block = FTL_NONE;
+
+            _ftl_ckpt_fill(ftl, &header, &crc, i * ftl->page_size, ftl->buf, ftl->page_size);
+            result = _ftl_program(ftl, FTL_STREAM_CKPT, FTL_PAGE_CKPT, header.seq,
+                                  i | (ftl->ckpt_pages << 16), ftl->buf, &ppn);
+            if (result == -RT_EIO)
+            {
+                block = ftl->stream[FTL_STREAM_CKPT].block;
+                ftl->blk[block].state = FTL_BLK_BAD;
+                _ftl_mark_bad(ftl, block);
+            }
+        }
+
+        if (result != RT_EOK)
+            _ftl_ckpt_abort(ftl);
+    }
+
+    if (result != RT_EOK)
+    {
+        LOG_E("%s: checkpoint failed %d", ftl->parent.parent.name, result);
+        return result;
+    }
+
+    for (i = 0; i < ftl->blocks; i++)
+    {
+        if (ftl->blk[i].state == FTL_BLK_CKPT)
+        {
+            ftl->blk[i].state = FTL_BLK_FREE;
+            ftl->free_blocks++;
+        }
+        else if (ftl->blk[i].state == FTL_BLK_CKPT_NEW)
+        {
+            ftl->blk[i].state = FTL_BLK_CKPT;
+        }
+    }
+    ftl->stream[FTL_STREAM_CKPT].block = FTL_NONE;
+    ftl->ckpt_seq = header.seq;
+    ftl->since_ckpt = 0;
+    ftl->stat.checkpoints++;
+    ftl->stat.ckpt_pages += ftl->ckpt_pages;
+
+    return RT_EOK;
+}
+
+/* the block holding the page `index` of the checkpoint `seq` */
+static rt_uint32_t _ftl_ckpt_block(struct mtd_nand_ftl *ftl, rt_uint32_t seq, rt_uint32_t index,
+                                   const rt_uint32_t *seq0, const rt_uint32_t *addr0)
+{
+    rt_uint32_t block, first = (index - index % ftl->ppb) | (ftl->ckpt_pages << 16);
+
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        if (ftl->blk[block].state == FTL_BLK_CKPT && seq0[block] == seq && addr0[block] == first)
+            return block;
+    }
+
+    return FTL_NONE;
+}
+
+/* load the checkpoint written with `seq` into the map and `ecs`, RT_EOK if it is whole */
+static rt_err_t _ftl_load_ckpt(struct mtd_nand_ftl *ftl, rt_uint32_t seq, const rt_uint32_t *seq0,
+                               const rt_uint32_t *addr0, struct ftl_ckpt_header *header, rt_uint32_t *ecs)
+{
+    rt_size_t map_off = sizeof(*header);
+    rt_size_t ec_off = map_off + ftl->lpns * sizeof(rt_uint32_t);
+    rt_size_t crc_off = ec_off + ftl->blocks * sizeof(rt_uint32_t);
+    rt_size_t end = crc_off + sizeof(rt_uint32_t);
+    rt_uint32_t crc = 0, stored = 0, i, block = FTL_NONE;
+    rt_size_t off, n, at;
+    struct ftl_meta meta;
+
+    for (i = 0; i < ftl->ckpt_pages; i++)
+    {
+        if (i % ftl->ppb == 0)
+        {
+            block = _ftl_ckpt_block(ftl, seq, i, seq0, addr0);
+            if (block == FTL_NONE)
+                return -RT_ERROR;
+        }
+
+        if (_ftl_read_page(ftl, block, i % ftl->ppb, ftl->buf, &meta) != RT_EOK || meta.type != FTL_PAGE_CKPT ||
+                meta.seq != seq || meta.addr != (i | (ftl->ckpt_pages << 16)))
+            return -RT_ERROR;
+
+        for (at = 0, off = i * ftl->page_size; at < ftl->page_size && off < end; at += n, off += n)
+        {
+            if (off < map_off)
+            {
+                n = FTL_MIN(map_off - off, ftl->page_size - at);
+                rt_memcpy((rt_uint8_t *)header + off, ftl->buf + at, n);
+            }
+            else if (off < ec_off)
+            {
+                n = FTL_MIN(ec_off - off, ftl->page_size - at);
+                rt_memcpy((rt_uint8_t *)ftl->map + off - map_off, ftl->buf + at, n);
+            }
+            else if (off < crc_off)
+            {
+                n = FTL_MIN(crc_off - off, ftl->page_size - at);
+                rt_memcpy((rt_uint8_t *)ecs + off - ec_off, ftl->buf + at, n);
+            }
+            else
+            {
+                n = FTL_MIN(end - off, ftl->page_size - at);
+                rt_memcpy((rt_uint8_t *)&stored + off - crc_off, ftl->buf + at, n);
+                continue;
+            }
+            crc = _ftl_crc32(crc, ftl->buf + at, n);
+        }
+
+        /* the header is in the first page */
+        if (i == 0 && (header->magic != FTL_MAGIC || header->version != FTL_VERSION || header->seq != seq ||
+                       header->blocks != ftl->blocks || header->pages_per_block != ftl->ppb ||
+                       header->page_size != ftl->page_size || header->lpns != ftl->lpns))
+            return -RT_ERROR;
+    }
+
+    return crc == stored ? RT_EOK : -RT_ERROR;
+}
+
+/*
+ * Load the latest whole checkpoint, then roll forward the pages written after it: those
+ * in the blocks first written after it, and in the blocks open at the checkpoint.
+ */
+static rt_err_t _ftl_mount(struct mtd_nand_ftl *ftl)
+{
+    struct ftl_ckpt_header header;
+    struct ftl_meta meta;
+    rt_uint32_t *seq0, *addr0, *ecs, *seqs = RT_NULL;
+    rt_uint32_t block, page, lpn, seq, max_seq = 0, rolled = 0;
+    rt_err_t result = -RT_ERROR;
+
+    seq0 = (rt_uint32_t *)rt_calloc(ftl->blocks, sizeof(rt_uint32_t));
+    addr0 = (rt_uint32_t *)rt_calloc(ftl->blocks, sizeof(rt_uint32_t));
+    ecs = (rt_uint32_t *)rt_calloc(ftl->blocks, sizeof(rt_uint32_t));
+    if (seq0 == RT_NULL || addr0 == RT_NULL || ecs == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto _exit;
+    }
+
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        struct ftl_block *blk = &ftl->blk[block];
+
+        blk->state = FTL_BLK_FREE;
+        if (rt_mtd_nand_check_block(ftl->nand, ftl->nand->block_start + block) != RT_EOK)
+        {
+            blk->state = FTL_BLK_BAD;
+            continue;
+        }
+
+        if (_ftl_read_page(ftl, block, 0, RT_NULL, &meta) != RT_EOK)
+            continue;
+
+        if (meta.type == FTL_PAGE_DATA)
+            blk->state = FTL_BLK_USED;
+        else if (meta.type == FTL_PAGE_CKPT)
+            blk->state = FTL_BLK_CKPT;
+        else
+            continue;
+
+        blk->ec = meta.ec;
+        seq0[block] = meta.seq;
+        addr0[block] = meta.addr;
+        max_seq = FTL_MAX(max_seq, meta.seq);
+    }
+
+    /* the latest checkpoint, or the one before if it is not whole */
+    for (seq = FTL_NONE; ;)
+    {
+        rt_uint32_t next = 0;
+        rt_bool_t found = RT_FALSE;
+
+        for (block = 0; block < ftl->blocks; block++)
+        {
+            if (ftl->blk[block].state == FTL_BLK_CKPT && seq0[block] < seq && seq0[block] >= next)
+            {
+                next = seq0[block];
+                found = RT_TRUE;
+            }
+        }
+        if (!found)
+        {
+            LOG_E("%s: no checkpoint on %s", ftl->parent.parent.name, ftl->nand->parent.parent.name);
+            goto _exit;
+        }
+
+        seq = next;
+        if (_ftl_load_ckpt(ftl, seq, seq0, addr0, &header, ecs) == RT_EOK)
+            break;
+
+        LOG_W("%s: checkpoint %d is broken", ftl->parent.parent.name, seq);
+    }
+
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        /* the count in the first page is newer if the block was erased after the checkpoint */
+        ftl->blk[block].ec = FTL_MAX(ftl->blk[block].ec, ecs[block]);
+
+        if (ftl->blk[block].state == FTL_BLK_CKPT && seq0[block] != seq)
+            ftl->blk[block].state = FTL_BLK_FREE;
+    }
+
+    seqs = (rt_uint32_t *)rt_calloc(ftl->lpns, sizeof(rt_uint32_t));
+    if (seqs == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto _exit;
+    }
+
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        if (ftl->blk[block].state != FTL_BLK_USED ||
+                (seq0[block] <= seq && block != header.open[0] && block != header.open[1]))
+            continue;
+
+        for (page = 0; page < ftl->ppb; page++)
+        {
+            result = _ftl_read_page(ftl, block, page, ftl->buf, &meta);
+            if (result == -RT_EEMPTY)
+                break;
+
+            /* a page torn by the power loss */
+            if (result != RT_EOK || meta.type != FTL_PAGE_DATA)
+                continue;
+
+            max_seq = FTL_MAX(max_seq, meta.seq);
+            if (meta.seq > seq && meta.addr < ftl->lpns && meta.seq > seqs[meta.addr])
+            {
+                ftl->map[meta.addr] = block * ftl->ppb + page;
+                seqs[meta.addr] = meta.seq;
+                rolled++;
+            }
+        }
+    }
+
+    for (lpn = 0; lpn < ftl->lpns; lpn++)
+    {
+        rt_uint32_t ppn = ftl->map[lpn];
+
+        if (ppn == FTL_NONE)
+            continue;
+
+        if (ppn / ftl->ppb >= ftl->blocks || ftl->blk[ppn / ftl->ppb].state != FTL_BLK_USED)
+        {
+            LOG_E("%s: logical page %d lost", ftl->parent.parent.name, lpn);
+            ftl->map[lpn] = FTL_NONE;
+            continue;
+        }
+        ftl->blk[ppn / ftl->ppb].valid++;
+    }
+
+    ftl->free_blocks = 0;
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        if (ftl->blk[block].state == FTL_BLK_USED && ftl->blk[block].valid == 0)
+            ftl->blk[block].state = FTL_BLK_FREE;
+        if (ftl->blk[block].state == FTL_BLK_FREE)
+            ftl->free_blocks++;
+    }
+
+    ftl->seq = FTL_MAX(max_seq, seq) + 1;
+    ftl->ckpt_seq = seq;
+    ftl->since_ckpt = rolled;
+    result = RT_EOK;
+
+    LOG_I("%s: checkpoint %d, %d pages rolled forward, %d free blocks",
+          ftl->parent.parent.name, seq, rolled, ftl->free_blocks);
+
+_exit:
+    rt_free(seqs);
+    rt_free(ecs);
+    rt_free(seq0);
+    rt_free(addr0);
+    return result;
+}
+
+static rt_err_t _ftl_format(struct mtd_nand_ftl *ftl)
+{
+    rt_uint32_t block, good = 0;
+
+    for (block = 0; block < ftl->blocks; block++)
+    {
+        struct ftl_block *blk = &ftl->blk[block];
+
+        blk->state = FTL_BLK_BAD;
+        if (rt_mtd_nand_check_block(ftl->nand, ftl->nand->block_start + block) != RT_EOK)
+            continue;
+
+        ftl->stat.erases++;
+        if (rt_mtd_nand_erase_block(ftl->nand, ftl->nand->block_start + block) != RT_EOK)
+        {
+            rt_mtd_nand_mark_badblock(ftl->nand, ftl->nand->block_start + block);
+            continue;
+        }
+
+        blk->ec = 1;
+        blk->erased = 1;
+        blk->state = FTL_BLK_FREE;
+        good++;
+    }
+
+    if (good < ftl->lpns / ftl->ppb + 2 * ftl->ckpt_blocks + FTL_FIXED_BLOCKS)
+    {
+        LOG_E("%s: %d bad blocks, too many", ftl->parent.parent.name, ftl->blocks - good);
+        return -RT_ERROR;
+    }
+
+    rt_memset(ftl->map, 0xFF, ftl->lpns * sizeof(rt_uint32_t));
+    ftl->free_blocks = good;
+    ftl->seq = 1;
+
+    return _ftl_checkpoint(ftl);
+}
+
+static rt_err_t _ftl_step(struct mtd_nand_ftl *ftl)
+{
+    rt_uint32_t victim, i, min_ec = FTL_NONE, max_ec = 0;
+
+    /* static wear levelling first: free the least erased block from its cold data */
+    for (i = 0; i < ftl->blocks; i++)
+    {
+        if (ftl->blk[i].state == FTL_BLK_BAD)
+            continue;
+        if (ftl->blk[i].state == FTL_BLK_USED)
+            min_ec = FTL_MIN(min_ec, ftl->blk[i].ec);
+        max_ec = FTL_MAX(max_ec, ftl->blk[i].ec);
+    }
+    if (min_ec != FTL_NONE && max_ec - min_ec > RT_MTD_NAND_FTL_WL_THRESHOLD && ftl->free_blocks > ftl->ckpt_blocks)
+    {
+        victim = _ftl_victim(ftl, RT_TRUE);
+        if (_ftl_collect_block(ftl, victim) == RT_EOK)
+        {
+            ftl->stat.wl_blocks++;
+            return RT_EOK;
+        }
+    }
+
+    /* collect ahead of the writes */
+    if (ftl->free_blocks < ftl->ckpt_blocks + 2 + RT_MTD_NAND_FTL_GC_FREE)
+    {
+        victim = _ftl_victim(ftl, RT_FALSE);
+        if (victim != FTL_NONE && ftl->blk[victim].valid < ftl->ppb)
+            return _ftl_collect_block(ftl, victim);
+    }
+
+    if (ftl->since_ckpt >= RT_MTD_NAND_FTL_CKPT_INTERVAL)
+        return _ftl_checkpoint(ftl);
+
+    return -RT_EEMPTY;
+}
+
+#if RT_MTD_NAND_FTL_GC_PERIOD > 0
+static void _ftl_gc_work(struct rt_work *work, void *work_data)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)work_data;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    _ftl_step(ftl);
+    rt_mutex_release(&ftl->lock);
+
+    rt_work_submit(&ftl->gc_work, rt_tick_from_millisecond(RT_MTD_NAND_FTL_GC_PERIOD));
+}
+#endif
+
+static rt_err_t _ftl_dev_init(rt_device_t dev)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _ftl_dev_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    return RT_EOK;
+}
+
+/* the last user closed it, e.g. the filesystem is unmounted */
+static rt_err_t _ftl_dev_close(rt_device_t dev)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_err_t result = RT_EOK;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    if (ftl->since_ckpt > 0)
+        result = _ftl_checkpoint(ftl);
+    rt_mutex_release(&ftl->lock);
+
+    return result;
+}
+
+static rt_size_t _ftl_dev_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_uint8_t *buf = (rt_uint8_t *)buffer;
+    struct ftl_meta meta;
+    rt_size_t i;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < size && pos + i < ftl->lpns; i++, buf += ftl->page_size)
+    {
+        rt_uint32_t ppn = ftl->map[pos + i];
+
+        if (ppn == FTL_NONE)
+        {
+            rt_memset(buf, 0xFF, ftl->page_size);
+            continue;
+        }
+
+        if (_ftl_read_page(ftl, ppn / ftl->ppb, ppn % ftl->ppb, buf, &meta) != RT_EOK ||
+                meta.type != FTL_PAGE_DATA || meta.addr != pos + i)
+        {
+            LOG_E("%s: read logical page %d failed", ftl->parent.parent.name, pos + i);
+            break;
+        }
+    }
+
+    rt_mutex_release(&ftl->lock);
+
+    return i;
+}
+
+static rt_size_t _ftl_dev_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    const rt_uint8_t *buf = (const rt_uint8_t *)buffer;
+    rt_size_t i;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+
+    for (i = 0; i < size && pos + i < ftl->lpns; i++, buf += ftl->page_size)
+    {
+        if (_ftl_make_room(ftl) != RT_EOK || _ftl_write_page(ftl, FTL_STREAM_HOST, pos + i, buf) != RT_EOK)
+            break;
+        ftl->stat.host_pages++;
+    }
+
+    /* bound the pages to roll forward after a power loss */
+    if (ftl->since_ckpt >= RT_MTD_NAND_FTL_CKPT_INTERVAL)
+        _ftl_checkpoint(ftl);
+
+    rt_mutex_release(&ftl->lock);
+
+    return i;
+}
+
+static rt_err_t _ftl_dev_control(rt_device_t dev, int cmd, void *args)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+
+    RT_ASSERT(ftl != RT_NULL);
+
+    switch (cmd)
+    {
+    case RT_DEVICE_CTRL_BLK_GETGEOME:
+    {
+        struct rt_device_blk_geometry *geometry = (struct rt_device_blk_geometry *)args;
+
+        if (geometry == RT_NULL)
+            return -RT_ERROR;
+
+        geometry->bytes_per_sector = ftl->page_size;
+        geometry->block_size = ftl->page_size * ftl->ppb;
+        geometry->sector_count = ftl->lpns;
+        break;
+    }
+
+    /* a write is on the flash when it returns */
+    case RT_DEVICE_CTRL_BLK_SYNC:
+        break;
+
+    /* the sectors freed are not known, they are collected when written again */
+    case RT_DEVICE_CTRL_BLK_ERASE:
+        break;
+
+    default:
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops mtd_nand_ftl_ops =
+{
+    _ftl_dev_init,
+    _ftl_dev_open,
+    _ftl_dev_close,
+    _ftl_dev_read,
+    _ftl_dev_write,
+    _ftl_dev_control
+};
+#endif
+
+static void _ftl_free(struct mtd_nand_ftl *ftl)
+{
+    rt_free(ftl->buf);
+    rt_free(ftl->blk);
+    rt_free(ftl->map);
+    rt_free(ftl);
+}
+
+rt_device_t rt_mtd_nand_ftl_create(const char *name, const char *nand_name, rt_bool_t format)
+{
+    struct rt_mtd_nand_device *nand;
+    struct mtd_nand_ftl *ftl;
+    rt_uint32_t reserve, i;
+
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(nand_name != RT_NULL);
+
+    nand = RT_MTD_NAND_DEVICE(rt_device_find(nand_name));
+    if (nand == RT_NULL || nand->parent.type != RT_Device_Class_MTD)
+    {
+        LOG_E("%s is not a MTD Nand device", nand_name);
+        return RT_NULL;
+    }
+
+    if (nand->oob_free < sizeof(struct ftl_meta))
+    {
+        LOG_E("%s has %d free bytes of spare, %d needed", nand_name, nand->oob_free, sizeof(struct ftl_meta));
+        return RT_NULL;
+    }
+
+    ftl = (struct mtd_nand_ftl *)rt_calloc(1, sizeof(struct mtd_nand_ftl));
+    if (ftl == RT_NULL)
+        return RT_NULL;
+
+    ftl->nand = nand;
+    ftl->blocks = nand->block_end - nand->block_start + 1;
+    ftl->ppb = nand->pages_per_block;
+    ftl->page_size = nand->page_size;
+
+    /* sized for the whole device, so the capacity does not depend on the bad blocks */
+    ftl->ckpt_pages = (_ftl_ckpt_size(ftl->blocks * ftl->ppb, ftl->blocks) + ftl->page_size - 1) / ftl->page_size;
+    ftl->ckpt_blocks = (ftl->ckpt_pages + ftl->ppb - 1) / ftl->ppb;
+    /* two checkpoints, the blocks open and kept free, then the room of the garbage collection */
+    reserve = 2 * ftl->ckpt_blocks + FTL_FIXED_BLOCKS + FTL_SPARE_BLOCKS + ftl->blocks * RT_MTD_NAND_FTL_RESERVE / 100;
+    if (ftl->ppb > 0xFFFF || ftl->ckpt_pages > 0xFFFF || ftl->blocks <= reserve)
+    {
+        LOG_E("%s: %d blocks of %d pages, not supported", nand_name, ftl->blocks, ftl->ppb);
+        rt_free(ftl);
+        return RT_NULL;
+    }
+    ftl->lpns = (ftl->blocks - reserve) * ftl->ppb;
+
+    ftl->map = (rt_uint32_t *)rt_malloc(ftl->lpns * sizeof(rt_uint32_t));
+    ftl->blk = (struct ftl_block *)rt_calloc(ftl->blocks, sizeof(struct ftl_block));
+    ftl->buf = (rt_uint8_t *)rt_malloc(ftl->page_size);
+    if (ftl->map == RT_NULL || ftl->blk == RT_NULL || ftl->buf == RT_NULL)
+    {
+        LOG_E("no memory for %s, %d pages", name, ftl->lpns);
+        _ftl_free(ftl);
+        return RT_NULL;
+    }
+
+    rt_memset(ftl->map, 0xFF, ftl->lpns * sizeof(rt_uint32_t));
+    for (i = 0; i < FTL_STREAMS; i++)
+        ftl->stream[i].block = FTL_NONE;
+
+    /* register with the name first, the messages carry it */
+    rt_strncpy(ftl->parent.parent.name, name, RT_NAME_MAX);
+
+    if (rt_device_open(&nand->parent, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        LOG_E("open %s failed", nand_name);
+        _ftl_free(ftl);
+        return RT_NULL;
+    }
+
+    if ((format ? _ftl_format(ftl) : _ftl_mount(ftl)) != RT_EOK)
+    {
+        LOG_E("%s: %s %s failed", name, format ? "format" : "mount", nand_name);
+        rt_device_close(&nand->parent);
+        _ftl_free(ftl);
+        return RT_NULL;
+    }
+
+    /* the pages rolled forward are saved again, not found once more on the next mount */
+    if (ftl->since_ckpt > 0)
+        _ftl_checkpoint(ftl);
+
+    rt_mutex_init(&ftl->lock, name, RT_IPC_FLAG_PRIO);
+
+    ftl->parent.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    ftl->parent.ops = &mtd_nand_ftl_ops;
+#else
+    ftl->parent.init = _ftl_dev_init;
+    ftl->parent.open = _ftl_dev_open;
+    ftl->parent.close = _ftl_dev_close;
+    ftl->parent.read = _ftl_dev_read;
+    ftl->parent.write = _ftl_dev_write;
+    ftl->parent.control = _ftl_dev_control;
+#endif
+
+    if (rt_device_register(&ftl->parent, name, RT_DEVICE_FLAG_RDWR) != RT_EOK)
+    {
+        rt_mutex_detach(&ftl->lock);
+        rt_device_close(&nand->parent);
+        _ftl_free(ftl);
+        return RT_NULL;
+    }
+
+    rt_enter_critical();
+    rt_slist_append(&_ftl_list, &ftl->node);
+    rt_exit_critical();
+
+#if RT_MTD_NAND_FTL_GC_PERIOD > 0
+    rt_work_init(&ftl->gc_work, _ftl_gc_work, ftl);
+    rt_work_submit(&ftl->gc_work, rt_tick_from_millisecond(RT_MTD_NAND_FTL_GC_PERIOD));
+#endif
+
+    LOG_I("%s: %d sectors of %d bytes over %s, %d blocks reserved",
+          name, ftl->lpns, ftl->page_size, nand_name, reserve);
+
+    return &ftl->parent;
+}
+
+rt_err_t rt_mtd_nand_ftl_destroy(rt_device_t dev)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(ftl != RT_NULL);
+
+#if RT_MTD_NAND_FTL_GC_PERIOD > 0
+    while (rt_work_cancel(&ftl->gc_work) == -RT_EBUSY)
+        rt_thread_mdelay(1);
+#endif
+
+    result = rt_mtd_nand_ftl_checkpoint(dev);
+
+    rt_enter_critical();
+    rt_slist_remove(&_ftl_list, &ftl->node);
+    rt_exit_critical();
+
+    rt_device_unregister(&ftl->parent);
+    rt_device_close(&ftl->nand->parent);
+    rt_mutex_detach(&ftl->lock);
+    _ftl_free(ftl);
+
+    return result;
+}
+
+rt_err_t rt_mtd_nand_ftl_checkpoint(rt_device_t dev)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(ftl != RT_NULL);
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    result = _ftl_checkpoint(ftl);
+    rt_mutex_release(&ftl->lock);
+
+    return result;
+}
+
+rt_err_t rt_mtd_nand_ftl_collect(rt_device_t dev)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(ftl != RT_NULL);
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    result = _ftl_step(ftl);
+    rt_mutex_release(&ftl->lock);
+
+    return result;
+}
+
+void rt_mtd_nand_ftl_get_stat(rt_device_t dev, struct rt_mtd_nand_ftl_stat *stat)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+    rt_uint32_t i;
+
+    RT_ASSERT(ftl != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+
+    *stat = ftl->stat;
+    stat->bad_blocks = 0;
+    stat->free_blocks = ftl->free_blocks;
+    stat->min_erase = FTL_NONE;
+    stat->max_erase = 0;
+    for (i = 0; i < ftl->blocks; i++)
+    {
+        if (ftl->blk[i].state == FTL_BLK_BAD)
+        {
+            stat->bad_blocks++;
+            continue;
+        }
+        stat->min_erase = FTL_MIN(stat->min_erase, ftl->blk[i].ec);
+        stat->max_erase = FTL_MAX(stat->max_erase, ftl->blk[i].ec);
+    }
+    if (stat->min_erase == FTL_NONE)
+        stat->min_erase = 0;
+
+    rt_mutex_release(&ftl->lock);
+}
+
+void rt_mtd_nand_ftl_reset_stat(rt_device_t dev)
+{
+    struct mtd_nand_ftl *ftl = (struct mtd_nand_ftl *)dev;
+
+    RT_ASSERT(ftl != RT_NULL);
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    rt_memset(&ftl->stat, 0, sizeof(ftl->stat));
+    rt_mutex_release(&ftl->lock);
+}
+
+#ifdef RT_USING_FINSH
+static struct mtd_nand_ftl *_ftl_find(const char *name)
+{
+    struct mtd_nand_ftl *ftl;
+
+    rt_slist_for_each_entry(ftl, &_ftl_list, node)
+    {
+        if (rt_strncmp(ftl->parent.parent.name, name, RT_NAME_MAX) == 0)
+            return ftl;
+    }
+
+    return RT_NULL;
+}
+
+static void _ftl_show(struct mtd_nand_ftl *ftl)
+{
+    struct rt_mtd_nand_ftl_stat stat;
+    rt_uint32_t written;
+
+    rt_mtd_nand_ftl_get_stat(&ftl->parent, &stat);
+    written = stat.host_pages + stat.gc_pages + stat.ckpt_pages;
+
+    rt_kprintf("%-*.*s %-*.*s %8d %8d %6d %6d.%02d %6d %5d %4d %4d %5d %d-%d\n",
+               RT_NAME_MAX, RT_NAME_MAX, ftl->parent.parent.name,
+               RT_NAME_MAX, RT_NAME_MAX, ftl->nand->parent.parent.name,
+               stat.host_pages, stat.gc_pages, stat.ckpt_pages,
+               stat.host_pages ? written / stat.host_pages : 0,
+               stat.host_pages ? written % stat.host_pages * 100 / stat.host_pages : 0,
+               stat.erases, stat.wl_blocks, stat.checkpoints, stat.free_blocks, stat.bad_blocks,
+               stat.min_erase, stat.max_erase);
+}
+
+/* write the whole device, then overwrite it at random, `hot` percent of the writes to a tenth of it */
+static int _ftl_bench(struct mtd_nand_ftl *ftl, rt_uint32_t writes, rt_uint32_t hot)
+{
+    rt_uint32_t *version, *page, lpn, i, j, errors = 0;
+    rt_tick_t tick;
+
+    version = (rt_uint32_t *)rt_calloc(ftl->lpns, sizeof(rt_uint32_t));
+    page = (rt_uint32_t *)rt_malloc(ftl->page_size);
+    if (version == RT_NULL || page == RT_NULL || rt_device_open(&ftl->parent, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        rt_kprintf("no memory\n");
+        rt_free(version);
+        rt_free(page);
+        return -1;
+    }
+
+    tick = rt_tick_get();
+    for (i = 0; i < ftl->lpns + writes; i++)
+    {
+        if (i < ftl->lpns)
+            lpn = i;
+        else if ((rt_uint32_t)rand() % 100 < hot)
+            lpn = rand() % FTL_MAX(ftl->lpns / 10, 1);
+        else
+            lpn = rand() % ftl->lpns;
+
+        version[lpn]++;
+        for (j = 0; j < ftl->page_size / sizeof(rt_uint32_t); j++)
+            page[j] = lpn ^ (version[lpn] << 20) ^ j;
+
+        if (rt_device_write(&ftl->parent, lpn, page, 1) != 1)
+        {
+            rt_kprintf("write %d failed\n", lpn);
+            break;
+        }
+
+        if (i == ftl->lpns - 1)
+            rt_mtd_nand_ftl_reset_stat(&ftl->parent);
+    }
+    tick = rt_tick_get() - tick;
+
+    for (lpn = 0; lpn < ftl->lpns; lpn++)
+    {
+        if (rt_device_read(&ftl->parent, lpn, page, 1) != 1)
+        {
+            errors++;
+            continue;
+        }
+        for (j = 0; j < ftl->page_size / sizeof(rt_uint32_t); j++)
+        {
+            if (page[j] != (lpn ^ (version[lpn] << 20) ^ j))
+            {
+                errors++;
+                break;
+            }
+        }
+    }
+
+    rt_device_close(&ftl->parent);
+    rt_kprintf("%d pages written in %d ms, %d pages wrong\n", i, tick * 1000 / RT_TICK_PER_SECOND, errors);
+    rt_free(version);
+    rt_free(page);
+
+    return errors ? -1 : 0;
+}
+
+static int nftl(int argc, char **argv)
+{
+    struct mtd_nand_ftl *ftl = RT_NULL;
+
+    if (argc == 1 || (argc == 2 && !rt_strcmp(argv[1], "list")))
+    {
+        rt_kprintf("%-*.*s %-*.*s     host       gc   ckpt     WA erases    wl ckpt free   bad erased\n",
+                   RT_NAME_MAX, RT_NAME_MAX, "ftl", RT_NAME_MAX, RT_NAME_MAX, "nand");
+        rt_slist_for_each_entry(ftl, &_ftl_list, node)
+        {
+            _ftl_show(ftl);
+        }
+        return 0;
+    }
+
+    if ((argc == 4 || argc == 5) && !rt_strcmp(argv[1], "create"))
+    {
+        return rt_mtd_nand_ftl_create(argv[2], argv[3], argc == 5 && !rt_strcmp(argv[4], "format")) ? 0 : -1;
+    }
+
+    if (argc >= 3 && (ftl = _ftl_find(argv[2])) == RT_NULL)
+    {
+        rt_kprintf("no ftl %s\n", argv[2]);
+        return -1;
+    }
+
+    if (argc == 3 && !rt_strcmp(argv[1], "ckpt"))
+    {
+        return rt_mtd_nand_ftl_checkpoint(&ftl->parent) == RT_EOK ? 0 : -1;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "stat"))
+    {
+        _ftl_show(ftl);
+        return 0;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_mtd_nand_ftl_reset_stat(&ftl->parent);
+        return 0;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "destroy"))
+    {
+        return rt_mtd_nand_ftl_destroy(&ftl->parent) == RT_EOK ? 0 : -1;
+    }
+    else if (argc >= 5 && !rt_strcmp(argv[1], "bench") && !rt_strcmp(argv[argc - 1], "yes"))
+    {
+        return _ftl_bench(ftl, atoi(argv[3]), argc == 6 ? atoi(argv[4]) : 0);
+    }
+
+    rt_kprintf("Usage:\n");
+    rt_kprintf("nftl [list]                                 - show the flash translation layers\n");
+    rt_kprintf("nftl create <name> <nand> [format]          - a block device over a MTD Nand device\n");
+    rt_kprintf("nftl ckpt|stat|reset|destroy <name>\n");
+    rt_kprintf("nftl bench <name> <writes> [hot%%] yes       - overwrite the whole device, its data are lost\n");
+
+    return -1;
+}
+MSH_CMD_EXPORT(nftl, Nand flash translation layer: nftl [create|ckpt|stat|reset|destroy|bench]);
+#endif /* RT_USING_FINSH */
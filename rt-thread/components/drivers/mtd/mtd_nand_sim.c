@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/mtd_nand_sim.h>
+#include <stdlib.h>
+
+#define DBG_TAG    "nand.sim"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#define SIM_MIN(a, b)               ((a) < (b) ? (a) : (b))
+
+#define SIM_PAGE_ERASED             0
+#define SIM_PAGE_PROGRAMMED         1
+#define SIM_PAGE_TORN               2           /* reads fail with ECC errors */
+
+#define SIM_BLOCK_MARKED            0x01        /* marked bad */
+#define SIM_BLOCK_FAILING           0x02        /* programs and erases fail */
+
+struct nand_sim
+{
+    struct rt_mtd_nand_device parent;
+
+    rt_uint8_t *data;
+    rt_uint8_t *spare;
+    rt_uint8_t *page_state;
+    rt_uint8_t *block_flag;
+    rt_uint32_t *next_page;                     /* the lowest page of a block still programmable in order */
+
+    struct rt_mutex lock;
+    rt_int32_t fault;                           /* programs and erases before the power loss, -1: no loss */
+    rt_bool_t power_off;
+
+    struct rt_mtd_nand_sim_stat stat;
+};
+
+static const struct rt_mtd_nand_driver_ops _nand_sim_ops;
+
+static struct nand_sim *_nand_sim_check(struct rt_mtd_nand_device *nand)
+{
+    if (nand == RT_NULL || nand->ops != &_nand_sim_ops)
+        return RT_NULL;
+
+    return (struct nand_sim *)nand;
+}
+
+/* count a program or erase down to the power loss, RT_TRUE if this one is torn */
+static rt_bool_t _nand_sim_tear(struct nand_sim *sim)
+{
+    if (sim->fault < 0)
+        return RT_FALSE;
+
+    if (sim->fault-- > 0)
+        return RT_FALSE;
+
+    sim->power_off = RT_TRUE;
+    return RT_TRUE;
+}
+
+static rt_err_t _nand_sim_read_id(struct rt_mtd_nand_device *device)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _nand_sim_read_page(struct rt_mtd_nand_device *device, rt_off_t page,
+                                    rt_uint8_t *data, rt_uint32_t data_len,
+                                    rt_uint8_t *spare, rt_uint32_t spare_len)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+    rt_err_t result = RT_EOK;
+
+    if (page < 0 || page >= device->block_total * device->pages_per_block)
+        return -RT_MTD_EIO;
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+
+    if (sim->power_off)
+    {
+        result = -RT_MTD_EIO;
+        goto _exit;
+    }
+
+    if (data && data_len)
+        rt_memcpy(data, sim->data + page * device->page_size, SIM_MIN(data_len, device->page_size));
+    if (spare && spare_len)
+        rt_memcpy(spare, sim->spare + page * device->oob_size, SIM_MIN(spare_len, device->oob_size));
+
+    if (sim->page_state[page] == SIM_PAGE_TORN)
+        result = -RT_MTD_EECC;
+    sim->stat.reads++;
+
+_exit:
+    rt_mutex_release(&sim->lock);
+    return result;
+}
+
+static rt_err_t _nand_sim_program(struct nand_sim *sim, rt_off_t page,
+                                  const rt_uint8_t *data, rt_uint32_t data_len,
+                                  const rt_uint8_t *spare, rt_uint32_t spare_len)
+{
+    struct rt_mtd_nand_device *device = &sim->parent;
+    rt_uint32_t block = page / device->pages_per_block;
+    rt_uint8_t *page_data = sim->data + page * device->page_size;
+    rt_uint8_t *page_spare = sim->spare + page * device->oob_size;
+
+    if (sim->power_off)
+        return -RT_MTD_EIO;
+
+    data_len = data ? SIM_MIN(data_len, device->page_size) : 0;
+    spare_len = spare ? SIM_MIN(spare_len, device->oob_size) : 0;
+
+    if (_nand_sim_tear(sim))
+    {
+        rt_memcpy(page_data, data, data_len / 2);
+        sim->page_state[page] = SIM_PAGE_TORN;
+        return -RT_MTD_EIO;
+    }
+
+    if (sim->page_state[page] != SIM_PAGE_ERASED || page % device->pages_per_block < sim->next_page[block])
+    {
+        LOG_W("%s: page %d programmed again or out of order", device->parent.parent.name, page);
+        sim->stat.violations++;
+        sim->page_state[page] = SIM_PAGE_TORN;
+        return -RT_MTD_EIO;
+    }
+
+    sim->next_page[block] = page % device->pages_per_block + 1;
+    sim->stat.programs++;
+
+    if (sim->block_flag[block] & SIM_BLOCK_FAILING)
+    {
+        sim->page_state[page] = SIM_PAGE_TORN;
+        return -RT_MTD_EIO;
+    }
+
+    rt_memcpy(page_data, data, data_len);
+    rt_memcpy(page_spare, spare, spare_len);
+    sim->page_state[page] = SIM_PAGE_PROGRAMMED;
+
+    return RT_EOK;
+}
+
+static rt_err_t _nand_sim_write_page(struct rt_mtd_nand_device *device, rt_off_t page,
+                                     const rt_uint8_t *data, rt_uint32_t data_len,
+                                     const rt_uint8_t *spare, rt_uint32_t spare_len)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+    rt_err_t result;
+
+    if (page < 0 || page >= device->block_total * device->pages_per_block)
+        return -RT_MTD_EIO;
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    result = _nand_sim_program(sim, page, data, data_len, spare, spare_len);
+    rt_mutex_release(&sim->lock);
+
+    return result;
+}
+
+static rt_err_t _nand_sim_move_page(struct rt_mtd_nand_device *device, rt_off_t src_page, rt_off_t dst_page)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+    rt_uint32_t pages = device->block_total * device->pages_per_block;
+    rt_err_t result;
+
+    if (src_page < 0 || src_page >= pages || dst_page < 0 || dst_page >= pages)
+        return -RT_MTD_EIO;
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    if (sim->page_state[src_page] == SIM_PAGE_TORN)
+        result = -RT_MTD_EECC;
+    else
+        result = _nand_sim_program(sim, dst_page, sim->data + src_page * device->page_size, device->page_size,
+                                   sim->spare + src_page * device->oob_size, device->oob_size);
+    rt_mutex_release(&sim->lock);
+
+    return result;
+}
+
+static rt_err_t _nand_sim_erase_block(struct rt_mtd_nand_device *device, rt_uint32_t block)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+    rt_uint32_t page = block * device->pages_per_block;
+    rt_err_t result = RT_EOK;
+
+    if (block >= device->block_total)
+        return -RT_MTD_EIO;
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+
+    if (sim->power_off)
+    {
+        result = -RT_MTD_EIO;
+    }
+    else if (_nand_sim_tear(sim))
+    {
+        rt_memset(sim->page_state + page, SIM_PAGE_TORN, device->pages_per_block);
+        result = -RT_MTD_EIO;
+    }
+    else if (sim->block_flag[block] & SIM_BLOCK_FAILING)
+    {
+        sim->stat.erases++;
+        result = -RT_MTD_EIO;
+    }
+    else
+    {
+        rt_memset(sim->data + page * device->page_size, 0xFF, device->pages_per_block * device->page_size);
+        rt_memset(sim->spare + page * device->oob_size, 0xFF, device->pages_per_block * device->oob_size);
+        rt_memset(sim->page_state + page, SIM_PAGE_ERASED, device->pages_per_block);
+        sim->next_page[block] = 0;
+        sim->stat.erases++;
+    }
+
+    rt_mutex_release(&sim->lock);
+    return result;
+}
+
+static rt_err_t _nand_sim_check_block(struct rt_mtd_nand_device *device, rt_uint32_t block)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+
+    if (block >= device->block_total)
+        return -RT_MTD_EIO;
+
+    return (sim->block_flag[block] & SIM_BLOCK_MARKED) ? -RT_ERROR : RT_EOK;
+}
+
+static rt_err_t _nand_sim_mark_badblock(struct rt_mtd_nand_device *device, rt_uint32_t block)
+{
+    struct nand_sim *sim = (struct nand_sim *)device;
+
+    if (block >= device->block_total)
+        return -RT_MTD_EIO;
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    if (sim->power_off)
+    {
+        rt_mutex_release(&sim->lock);
+        return -RT_MTD_EIO;
+    }
+    sim->block_flag[block] |= SIM_BLOCK_MARKED;
+    rt_mutex_release(&sim->lock);
+
+    return RT_EOK;
+}
+
+static const struct rt_mtd_nand_driver_ops _nand_sim_ops =
+{
+    _nand_sim_read_id,
+    _nand_sim_read_page,
+    _nand_sim_write_page,
+    _nand_sim_move_page,
+    _nand_sim_erase_block,
+    _nand_sim_check_block,
+    _nand_sim_mark_badblock
+};
+
+static void _nand_sim_free(struct nand_sim *sim)
+{
+    rt_free(sim->data);
+    rt_free(sim->spare);
+    rt_free(sim->page_state);
+    rt_free(sim->block_flag);
+    rt_free(sim->next_page);
+    rt_free(sim);
+}
+
+struct rt_mtd_nand_device *rt_mtd_nand_sim_create(const char *name, rt_uint32_t blocks,
+        rt_uint32_t pages_per_block, rt_uint16_t page_size, rt_uint16_t oob_size)
+{
+    struct nand_sim *sim;
+    rt_uint32_t pages = blocks * pages_per_block;
+
+    RT_ASSERT(name != RT_NULL);
+
+    if (blocks == 0 || pages_per_block == 0 || page_size == 0 || blocks > 0xFFFF)
+        return RT_NULL;
+
+    if (rt_device_find(name) != RT_NULL)
+    {
+        LOG_E("%s exists", name);
+        return RT_NULL;
+    }
+
+    sim = (struct nand_sim *)rt_calloc(1, sizeof(struct nand_sim));
+    if (sim == RT_NULL)
+        return RT_NULL;
+
+    sim->data = (rt_uint8_t *)rt_malloc(pages * page_size);
+    sim->spare = (rt_uint8_t *)rt_malloc(pages * oob_size + 1);
+    sim->page_state = (rt_uint8_t *)rt_calloc(pages, sizeof(rt_uint8_t));
+    sim->block_flag = (rt_uint8_t *)rt_calloc(blocks, sizeof(rt_uint8_t));
+    sim->next_page = (rt_uint32_t *)rt_calloc(blocks, sizeof(rt_uint32_t));
+    if (sim->data == RT_NULL || sim->spare == RT_NULL || sim->page_state == RT_NULL ||
+            sim->block_flag == RT_NULL || sim->next_page == RT_NULL)
+    {
+        LOG_E("no memory for %s, %d blocks", name, blocks);
+        _nand_sim_free(sim);
+        return RT_NULL;
+    }
+
+    /* a new chip is erased */
+    rt_memset(sim->data, 0xFF, pages * page_size);
+    rt_memset(sim->spare, 0xFF, pages * oob_size);
+    sim->fault = -1;
+
+    sim->parent.page_size = page_size;
+    sim->parent.oob_size = oob_size;
+    sim->parent.oob_free = oob_size;
+    sim->parent.plane_num = 1;
+    sim->parent.pages_per_block = pages_per_block;
+    sim->parent.block_total = blocks;
+    sim->parent.block_start = 0;
+    sim->parent.block_end = blocks - 1;
+    sim->parent.ops = &_nand_sim_ops;
+
+    rt_mutex_init(&sim->lock, name, RT_IPC_FLAG_PRIO);
+
+    if (rt_mtd_nand_register_device(name, &sim->parent) != RT_EOK)
+    {
+        rt_mutex_detach(&sim->lock);
+        _nand_sim_free(sim);
+        return RT_NULL;
+    }
+
+    LOG_I("%s: %d blocks of %d pages of %d+%d bytes", name, blocks, pages_per_block, page_size, oob_size);
+
+    return &sim->parent;
+}
+
+void rt_mtd_nand_sim_set_fault(struct rt_mtd_nand_device *nand, rt_int32_t ops)
+{
+    struct nand_sim *sim = _nand_sim_check(nand);
+
+    RT_ASSERT(sim != RT_NULL);
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    sim->fault = ops < 0 ? -1 : ops;
+    sim->power_off = RT_FALSE;
+    rt_mutex_release(&sim->lock);
+}
+
+void rt_mtd_nand_sim_set_bad(struct rt_mtd_nand_device *nand, rt_uint32_t block)
+{
+    struct nand_sim *sim = _nand_sim_check(nand);
+
+    RT_ASSERT(sim != RT_NULL);
+
+    if (block < nand->block_total)
+        sim->block_flag[block] |= SIM_BLOCK_FAILING;
+}
+
+void rt_mtd_nand_sim_get_stat(struct rt_mtd_nand_device *nand, struct rt_mtd_nand_sim_stat *stat)
+{
+    struct nand_sim *sim = _nand_sim_check(nand);
+
+    RT_ASSERT(sim != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    *stat = sim->stat;
+    rt_mutex_release(&sim->lock);
+}
+
+void rt_mtd_nand_sim_reset_stat(struct rt_mtd_nand_device *nand)
+{
+    struct nand_sim *sim = _nand_sim_check(nand);
+
+    RT_ASSERT(sim != RT_NULL);
+
+    rt_mutex_take(&sim->lock, RT_WAITING_FOREVER);
+    rt_memset(&sim->stat, 0, sizeof(sim->stat));
+    rt_mutex_release(&sim->lock);
+}
+
+#ifdef RT_USING_FINSH
+static int nand_sim(int argc, char **argv)
+{
+    struct rt_mtd_nand_device *nand = RT_NULL;
+
+    if (argc >= 3)
+        nand = RT_MTD_NAND_DEVICE(rt_device_find(argv[2]));
+
+    if (argc >= 4 && !rt_strcmp(argv[1], "create"))
+    {
+        return rt_mtd_nand_sim_create(argv[2], atoi(argv[3]),
+                                      argc > 4 ? atoi(argv[4]) : 64,
+                                      argc > 5 ? atoi(argv[5]) : 2048,
+                                      argc > 6 ? atoi(argv[6]) : 64) ? 0 : -1;
+    }
+
+    if (_nand_sim_check(nand) == RT_NULL)
+    {
+        rt_kprintf("Usage:\n");
+        rt_kprintf("nand_sim create <name> <blocks> [pages_per_block] [page_size] [oob_size]\n");
+        rt_kprintf("nand_sim stat <name> [reset]\n");
+        rt_kprintf("nand_sim fault <name> <ops>   - lose the power after ops programs and erases, -1 to power on\n");
+        rt_kprintf("nand_sim bad <name> <block>   - make a block go bad\n");
+        return -1;
+    }
+
+    if (!rt_strcmp(argv[1], "stat"))
+    {
+        struct rt_mtd_nand_sim_stat stat;
+
+        rt_mtd_nand_sim_get_stat(nand, &stat);
+        rt_kprintf("reads %d, programs %d, erases %d, violations %d\n",
+                   stat.reads, stat.programs, stat.erases, stat.violations);
+        if (argc > 3 && !rt_strcmp(argv[3], "reset"))
+            rt_mtd_nand_sim_reset_stat(nand);
+    }
+    else if (argc > 3 && !rt_strcmp(argv[1], "fault"))
+    {
+        rt_mtd_nand_sim_set_fault(nand, atoi(argv[3]));
+    }
+    else if (argc > 3 && !rt_strcmp(argv[1], "bad"))
+    {
+        rt_mtd_nand_sim_set_bad(nand, atoi(argv[3]));
+    }
+    else
+    {
+        rt_kprintf("unknown command %s\n", argv[1]);
+        return -1;
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(nand_sim, MTD Nand simulator);
+#endif /* RT_USING_FINSH */
@@ -131,6 +131,43 @@ void fal_show_part_table(void);
  */
 struct rt_device *fal_blk_device_create(const char *parition_name);
 
+#ifdef FAL_USING_BLK_CACHE
+/**
+ * counters of the FAL block device
+ */
+struct fal_blk_stat
+{
+    uint32_t writes;        /* sectors written */
+    uint32_t hits;          /* sectors read from the cache */
+    uint32_t writebacks;    /* erase blocks written back */
+    uint32_t erases;        /* erase blocks erased */
+    uint32_t programs;      /* program operations */
+    uint32_t skipped;       /* write-backs without erasing */
+};
+
+/**
+ * write the erase blocks cached by the FAL block device to the flash
+ *
+ * @param dev the FAL block device
+ *
+ * @return 0: success
+ *        -1: error
+ */
+int fal_blk_device_flush(struct rt_device *dev);
+
+/**
+ * get the counters of the FAL block device
+ *
+ * @param dev the FAL block device
+ * @param stat the counters, it can be NULL
+ * @param reset clear the counters after getting them
+ *
+ * @return 0: success
+ *        -1: not a FAL block device
+ */
+int fal_blk_device_stat(struct rt_device *dev, struct fal_blk_stat *stat, int reset);
+#endif /* FAL_USING_BLK_CACHE */
+
 #if defined(RT_USING_MTD_NOR)
 /**
  * create RT-Thread MTD NOR device by specified partition
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2018-06-23     armink       the first version
  * 2019-08-22     MurphyZhao   adapt to none rt-thread case
+ * 2026-10-16     RT-Thread    add the erase block cache of the block device
  */
 
 #include <fal.h>
@@ -18,13 +19,235 @@
 #include <stdlib.h>
 
 /* ========================== block device ======================== */
+#ifdef FAL_USING_BLK_CACHE
+#ifndef FAL_BLK_CACHE_BLOCKS
+#define FAL_BLK_CACHE_BLOCKS           2
+#endif
+#ifndef FAL_BLK_SECTOR_SIZE
+#define FAL_BLK_SECTOR_SIZE            0
+#endif
+
+/* the dirty sectors of an erase block are kept in a 32 bits map */
+#define FAL_BLK_CACHE_MAX_SECTORS      32
+#define FAL_BLK_CACHE_NONE             0xFFFFFFFF
+
+struct fal_blk_cache
+{
+    uint32_t                        block;      /* erase block cached, FAL_BLK_CACHE_NONE if unused */
+    uint32_t                        dirty;      /* map of the sectors written */
+    uint32_t                        stamp;      /* the last use, for the replacement */
+    rt_bool_t                       erase;      /* the block must be erased before programming */
+    uint8_t                        *buf;
+};
+#endif /* FAL_USING_BLK_CACHE */
+
 struct fal_blk_device
 {
     struct rt_device                parent;
     struct rt_device_blk_geometry   geometry;
     const struct fal_partition     *fal_part;
+#ifdef FAL_USING_BLK_CACHE
+    const struct fal_flash_dev     *fal_flash;
+    uint32_t                        sectors_per_block;
+    uint32_t                        stamp;
+    struct rt_mutex                 lock;
+    struct fal_blk_cache            cache[FAL_BLK_CACHE_BLOCKS];
+    struct fal_blk_stat             stat;
+#endif
 };
 
+#ifdef FAL_USING_BLK_CACHE
+/* Whether the flash can be programmed from `old` to `new` without erasing. A NOR flash
+ * only clears bits, others must write a unit once after erasing. */
+static rt_bool_t blk_cache_programmable(struct fal_blk_device *part, const uint8_t *old, const uint8_t *new, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (part->fal_flash->write_gran <= 1)
+        {
+            if (new[i] & ~old[i])
+            {
+                return RT_FALSE;
+            }
+        }
+        else if (old[i] != 0xFF)
+        {
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+static rt_bool_t blk_cache_blank(const uint8_t *buf, size_t size)
+{
+    while (size--)
+    {
+        if (*buf++ != 0xFF)
+        {
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/* write a cached erase block to the flash: erase it and program the sectors not blank,
+ * or program the dirty sectors only if the erase is not needed */
+static int blk_cache_writeback(struct fal_blk_device *part, struct fal_blk_cache *cache)
+{
+    uint32_t addr = cache->block * part->geometry.block_size;
+    uint32_t sector_size = part->geometry.bytes_per_sector;
+    uint32_t start, end, program, run;
+
+    if (cache->dirty == 0)
+    {
+        return 0;
+    }
+
+    if (cache->erase)
+    {
+        if (fal_partition_erase(part->fal_part, addr, part->geometry.block_size) < 0)
+        {
+            return -1;
+        }
+        part->stat.erases++;
+
+        program = 0;
+        for (start = 0; start < part->sectors_per_block; start++)
+        {
+            if (!blk_cache_blank(cache->buf + start * sector_size, sector_size))
+            {
+                program |= 1UL << start;
+            }
+        }
+        /* the block is blank now, the dirty sectors are what to be programmed */
+        cache->erase = RT_FALSE;
+        cache->dirty = program;
+    }
+    else
+    {
+        part->stat.skipped++;
+    }
+
+    /* program the runs of the sectors */
+    for (start = 0; start < part->sectors_per_block; start = end)
+    {
+        if (!(cache->dirty & (1UL << start)))
+        {
+            end = start + 1;
+            continue;
+        }
+
+        for (end = start, run = 0; end < part->sectors_per_block && (cache->dirty & (1UL << end)); end++)
+        {
+            run |= 1UL << end;
+        }
+
+        if (fal_partition_write(part->fal_part, addr + start * sector_size, cache->buf + start * sector_size,
+                                (end - start) * sector_size) < 0)
+        {
+            return -1;
+        }
+        part->stat.programs++;
+        cache->dirty &= ~run;
+    }
+    part->stat.writebacks++;
+
+    return 0;
+}
+
+static int blk_cache_flush(struct fal_blk_device *part)
+{
+    int i, ret = 0;
+
+    for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+    {
+        if (part->cache[i].block != FAL_BLK_CACHE_NONE && blk_cache_writeback(part, &part->cache[i]) < 0)
+        {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
+static struct fal_blk_cache *blk_cache_find(struct fal_blk_device *part, uint32_t block)
+{
+    int i;
+
+    for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+    {
+        if (part->cache[i].block == block)
+        {
+            part->cache[i].stamp = ++part->stamp;
+            return &part->cache[i];
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* get the cache of an erase block, the least recently used one is written back for it */
+static struct fal_blk_cache *blk_cache_get(struct fal_blk_device *part, uint32_t block)
+{
+    struct fal_blk_cache *cache = blk_cache_find(part, block);
+    int i;
+
+    if (cache)
+    {
+        return cache;
+    }
+
+    cache = &part->cache[0];
+    for (i = 1; i < FAL_BLK_CACHE_BLOCKS; i++)
+    {
+        if (cache->block == FAL_BLK_CACHE_NONE)
+        {
+            break;
+        }
+        if (part->cache[i].block == FAL_BLK_CACHE_NONE || part->cache[i].stamp < cache->stamp)
+        {
+            cache = &part->cache[i];
+        }
+    }
+
+    if (cache->block != FAL_BLK_CACHE_NONE && blk_cache_writeback(part, cache) < 0)
+    {
+        return RT_NULL;
+    }
+
+    cache->block = FAL_BLK_CACHE_NONE;
+    if (fal_partition_read(part->fal_part, block * part->geometry.block_size, cache->buf,
+                           part->geometry.block_size) < 0)
+    {
+        return RT_NULL;
+    }
+    cache->block = block;
+    cache->dirty = 0;
+    cache->erase = RT_FALSE;
+    cache->stamp = ++part->stamp;
+
+    return cache;
+}
+
+static rt_err_t blk_dev_close(rt_device_t dev)
+{
+    struct fal_blk_device *part = (struct fal_blk_device*) dev;
+    int ret;
+
+    assert(part != RT_NULL);
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    ret = blk_cache_flush(part);
+    rt_mutex_release(&part->lock);
+
+    return ret < 0 ? -RT_EIO : RT_EOK;
+}
+#endif /* FAL_USING_BLK_CACHE */
+
 /* RT-Thread device interface */
 #if RTTHREAD_VERSION >= 30000
 static rt_err_t blk_dev_control(rt_device_t dev, int cmd, void *args)
@@ -63,6 +286,34 @@ static rt_err_t blk_dev_control(rt_device_t dev, rt_uint8_t cmd, void *args)
             end_addr++;
         }
 
+#ifdef FAL_USING_BLK_CACHE
+        /* only the erase blocks covered entirely, the others keep the sectors out of the range */
+        start_addr = (start_addr + part->sectors_per_block - 1) / part->sectors_per_block;
+        end_addr = end_addr / part->sectors_per_block;
+        if (start_addr >= end_addr)
+        {
+            return RT_EOK;
+        }
+
+        phy_start_addr = start_addr * part->geometry.block_size;
+        phy_size = (end_addr - start_addr) * part->geometry.block_size;
+
+        rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+        for (int i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+        {
+            if (part->cache[i].block >= start_addr && part->cache[i].block < end_addr)
+            {
+                part->cache[i].block = FAL_BLK_CACHE_NONE;
+            }
+        }
+        if (fal_partition_erase(part->fal_part, phy_start_addr, phy_size) < 0)
+        {
+            rt_mutex_release(&part->lock);
+            return -RT_ERROR;
+        }
+        part->stat.erases += end_addr - start_addr;
+        rt_mutex_release(&part->lock);
+#else
         phy_start_addr = start_addr * part->geometry.bytes_per_sector;
         phy_size = (end_addr - start_addr) * part->geometry.bytes_per_sector;
 
@@ -70,7 +321,23 @@ static rt_err_t blk_dev_control(rt_device_t dev, rt_uint8_t cmd, void *args)
         {
             return -RT_ERROR;
         }
+#endif
     }
+#ifdef FAL_USING_BLK_CACHE
+    else if (cmd == RT_DEVICE_CTRL_BLK_SYNC)
+    {
+        int ret;
+
+        rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+        ret = blk_cache_flush(part);
+        rt_mutex_release(&part->lock);
+
+        if (ret < 0)
+        {
+            return -RT_EIO;
+        }
+    }
+#endif
 
     return RT_EOK;
 }
@@ -82,6 +349,43 @@ static rt_size_t blk_dev_read(rt_device_t dev, rt_off_t pos, void* buffer, rt_si
 
     assert(part != RT_NULL);
 
+#ifdef FAL_USING_BLK_CACHE
+    {
+        uint32_t sector_size = part->geometry.bytes_per_sector;
+        uint8_t *buf = (uint8_t *) buffer;
+        struct fal_blk_cache *cache;
+        rt_size_t done, count;
+
+        rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+        for (done = 0; done < size; done += count)
+        {
+            uint32_t block = (pos + done) / part->sectors_per_block;
+            uint32_t index = (pos + done) % part->sectors_per_block;
+
+            count = part->sectors_per_block - index;
+            if (count > size - done)
+            {
+                count = size - done;
+            }
+
+            /* the erase blocks cached may be newer than the flash */
+            if ((cache = blk_cache_find(part, block)) != RT_NULL)
+            {
+                memcpy(buf + done * sector_size, cache->buf + index * sector_size, count * sector_size);
+                part->stat.hits += count;
+            }
+            else if (fal_partition_read(part->fal_part, (pos + done) * sector_size, buf + done * sector_size,
+                                        count * sector_size) != (int)(count * sector_size))
+            {
+                break;
+            }
+        }
+        rt_mutex_release(&part->lock);
+
+        return done;
+    }
+#endif
+
     ret = fal_partition_read(part->fal_part, pos * part->geometry.block_size, buffer, size * part->geometry.block_size);
 
     if (ret != (int)(size * part->geometry.block_size))
@@ -106,6 +410,54 @@ static rt_size_t blk_dev_write(rt_device_t dev, rt_off_t pos, const void* buffer
     part = (struct fal_blk_device*) dev;
     assert(part != RT_NULL);
 
+#ifdef FAL_USING_BLK_CACHE
+    {
+        uint32_t sector_size = part->geometry.bytes_per_sector;
+        const uint8_t *buf = (const uint8_t *) buffer;
+        struct fal_blk_cache *cache;
+        rt_size_t done, count, i;
+
+        /* the sectors are written to the cache of their erase block, which is erased and
+         * programmed once when it is replaced or synchronized */
+        rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+        for (done = 0; done < size; done += count)
+        {
+            uint32_t block = (pos + done) / part->sectors_per_block;
+            uint32_t index = (pos + done) % part->sectors_per_block;
+
+            count = part->sectors_per_block - index;
+            if (count > size - done)
+            {
+                count = size - done;
+            }
+
+            if ((cache = blk_cache_get(part, block)) == RT_NULL)
+            {
+                break;
+            }
+
+            for (i = 0; i < count; i++)
+            {
+                uint8_t *dst = cache->buf + (index + i) * sector_size;
+                const uint8_t *src = buf + (done + i) * sector_size;
+
+                /* the cache is the flash for clean sectors, and was programmable from the flash for
+                 * dirty sectors, so what is programmable from the cache is programmable from the flash */
+                if (!cache->erase && !blk_cache_programmable(part, dst, src, sector_size))
+                {
+                    cache->erase = RT_TRUE;
+                }
+                memcpy(dst, src, sector_size);
+                cache->dirty |= 1UL << (index + i);
+            }
+            part->stat.writes += count;
+        }
+        rt_mutex_release(&part->lock);
+
+        return done;
+    }
+#endif
+
     /* change the block device's logic address to physical address */
     phy_pos = pos * part->geometry.bytes_per_sector;
     phy_size = size * part->geometry.bytes_per_sector;
@@ -134,7 +486,11 @@ const static struct rt_device_ops blk_dev_ops =
 {
     RT_NULL,
     RT_NULL,
+#ifdef FAL_USING_BLK_CACHE
+    blk_dev_close,
+#else
     RT_NULL,
+#endif
     blk_dev_read,
     blk_dev_write,
     blk_dev_control
@@ -168,12 +524,55 @@ struct rt_device *fal_blk_device_create(const char *parition_name)
     }
 
     blk_dev = (struct fal_blk_device*) rt_malloc(sizeof(struct fal_blk_device));
+#ifdef FAL_USING_BLK_CACHE
+    if (blk_dev)
+    {
+        uint8_t *buf = (uint8_t *) rt_malloc(FAL_BLK_CACHE_BLOCKS * fal_flash->blk_size);
+        size_t sector_size = FAL_BLK_SECTOR_SIZE;
+        int i;
+
+        if (buf == RT_NULL)
+        {
+            rt_free(blk_dev);
+            blk_dev = RT_NULL;
+        }
+        else
+        {
+            memset(&blk_dev->stat, 0, sizeof(blk_dev->stat));
+            blk_dev->fal_flash = fal_flash;
+            blk_dev->stamp = 0;
+            for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+            {
+                blk_dev->cache[i].block = FAL_BLK_CACHE_NONE;
+                blk_dev->cache[i].buf = buf + i * fal_flash->blk_size;
+            }
+            rt_mutex_init(&blk_dev->lock, "fal_blk", RT_IPC_FLAG_PRIO);
+
+            /* sectors of the erase block size if FAL_BLK_SECTOR_SIZE is not a fraction of it */
+            if (sector_size == 0 || sector_size > fal_flash->blk_size || fal_flash->blk_size % sector_size != 0)
+            {
+                sector_size = fal_flash->blk_size;
+            }
+            if (fal_flash->blk_size / sector_size > FAL_BLK_CACHE_MAX_SECTORS)
+            {
+                sector_size = fal_flash->blk_size / FAL_BLK_CACHE_MAX_SECTORS;
+            }
+            blk_dev->sectors_per_block = fal_flash->blk_size / sector_size;
+        }
+    }
+#endif
     if (blk_dev)
     {
         blk_dev->fal_part = fal_part;
+#ifdef FAL_USING_BLK_CACHE
+        blk_dev->geometry.bytes_per_sector = fal_flash->blk_size / blk_dev->sectors_per_block;
+        blk_dev->geometry.block_size = fal_flash->blk_size;
+        blk_dev->geometry.sector_count = fal_part->len / blk_dev->geometry.bytes_per_sector;
+#else
         blk_dev->geometry.bytes_per_sector = fal_flash->blk_size;
         blk_dev->geometry.block_size = fal_flash->blk_size;
         blk_dev->geometry.sector_count = fal_part->len / fal_flash->blk_size;
+#endif
 
         /* register device */
         blk_dev->parent.type = RT_Device_Class_Block;
@@ -183,7 +582,11 @@ struct rt_device *fal_blk_device_create(const char *parition_name)
 #else
         blk_dev->parent.init = NULL;
         blk_dev->parent.open = NULL;
+#ifdef FAL_USING_BLK_CACHE
+        blk_dev->parent.close = blk_dev_close;
+#else
         blk_dev->parent.close = NULL;
+#endif
         blk_dev->parent.read = blk_dev_read;
         blk_dev->parent.write = blk_dev_write;
         blk_dev->parent.control = blk_dev_control;
@@ -203,6 +606,80 @@ struct rt_device *fal_blk_device_create(const char *parition_name)
     return RT_DEVICE(blk_dev);
 }
 
+#ifdef FAL_USING_BLK_CACHE
+static struct fal_blk_device *fal_blk_device_check(struct rt_device *dev)
+{
+#ifdef RT_USING_DEVICE_OPS
+    if (dev == RT_NULL || dev->ops != &blk_dev_ops)
+#else
+    if (dev == RT_NULL || dev->read != blk_dev_read)
+#endif
+    {
+        return RT_NULL;
+    }
+
+    return (struct fal_blk_device *) dev;
+}
+
+/**
+ * write the erase blocks cached by the FAL block device to the flash
+ *
+ * @param dev the FAL block device
+ *
+ * @return 0: success
+ *        -1: error
+ */
+int fal_blk_device_flush(struct rt_device *dev)
+{
+    struct fal_blk_device *part = fal_blk_device_check(dev);
+    int ret;
+
+    if (part == RT_NULL)
+    {
+        return -1;
+    }
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    ret = blk_cache_flush(part);
+    rt_mutex_release(&part->lock);
+
+    return ret;
+}
+
+/**
+ * get the counters of the FAL block device
+ *
+ * @param dev the FAL block device
+ * @param stat the counters
+ * @param reset clear the counters after getting them
+ *
+ * @return 0: success
+ *        -1: not a FAL block device
+ */
+int fal_blk_device_stat(struct rt_device *dev, struct fal_blk_stat *stat, int reset)
+{
+    struct fal_blk_device *part = fal_blk_device_check(dev);
+
+    if (part == RT_NULL)
+    {
+        return -1;
+    }
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    if (stat)
+    {
+        memcpy(stat, &part->stat, sizeof(struct fal_blk_stat));
+    }
+    if (reset)
+    {
+        memset(&part->stat, 0, sizeof(struct fal_blk_stat));
+    }
+    rt_mutex_release(&part->lock);
+
+    return 0;
+}
+#endif /* FAL_USING_BLK_CACHE */
+
 /* ========================== MTD nor device ======================== */
 #if defined(RT_USING_MTD_NOR)
 
@@ -556,6 +1033,7 @@ static void fal(uint8_t argc, char **argv) {
 #define CMD_WRITE_INDEX               2
 #define CMD_ERASE_INDEX               3
 #define CMD_BENCH_INDEX               4
+#define CMD_CACHE_INDEX               5
 
     int result = 0;
     static const struct fal_flash_dev *flash_dev = NULL;
@@ -569,6 +1047,9 @@ static void fal(uint8_t argc, char **argv) {
             [CMD_WRITE_INDEX]     = "fal write addr data1 ... dataN   - write some bytes 'data' starting at 'addr'",
             [CMD_ERASE_INDEX]     = "fal erase addr size              - erase 'size' bytes starting at 'addr'",
             [CMD_BENCH_INDEX]     = "fal bench <blk_size>             - benchmark test with per block size",
+#ifdef FAL_USING_BLK_CACHE
+            [CMD_CACHE_INDEX]     = "fal cache part_name [reset]      - show the cache counters of the block device",
+#endif
     };
 
     if (fal_init_check() != 1)
@@ -629,6 +1110,27 @@ static void fal(uint8_t argc, char **argv) {
                 fal_show_part_table();
             }
         }
+#ifdef FAL_USING_BLK_CACHE
+        else if (!strcmp(operator, "cache"))
+        {
+            struct fal_blk_stat stat;
+
+            if (argc < 3)
+            {
+                rt_kprintf("Usage: %s.\n", help_info[CMD_CACHE_INDEX]);
+                return;
+            }
+            if (fal_blk_device_stat(rt_device_find(argv[2]), &stat, argc > 3 && !strcmp(argv[3], "reset")) < 0)
+            {
+                rt_kprintf("%s is not a FAL block device.\n", argv[2]);
+                return;
+            }
+            rt_kprintf("sectors written: %d, read from cache: %d\n", stat.writes, stat.hits);
+            rt_kprintf("erase blocks written back: %d, erased: %d, without erasing: %d\n", stat.writebacks,
+                    stat.erases, stat.skipped);
+            rt_kprintf("program operations: %d\n", stat.programs);
+        }
+#endif
         else
         {
             if (!flash_dev && !part_dev)
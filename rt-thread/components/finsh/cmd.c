@@ -408,9 +408,15 @@ long list_mutex(void)
 
     maxlen = RT_NAME_MAX;
 
+#ifdef RT_USING_MUTEX_STATS
+    rt_kprintf("%-*.s   owner  hold suspend thread priority  take     contend  max hold max wait\n", maxlen, item_title);
+    object_split(maxlen);
+    rt_kprintf(" -------- ---- -------------- -------- -------- -------- -------- --------\n");
+#else
     rt_kprintf("%-*.s   owner  hold suspend thread priority\n", maxlen, item_title);
     object_split(maxlen);
     rt_kprintf(" -------- ---- -------------- --------\n");
+#endif /* RT_USING_MUTEX_STATS */
 
     do
     {
@@ -433,14 +439,29 @@ long list_mutex(void)
                 rt_hw_interrupt_enable(level);
 
                 m = (struct rt_mutex *)obj;
+#ifdef RT_USING_MUTEX_STATS
+                rt_kprintf("%-*.*s %-8.*s %04d %-14d %-8d %-8d %-8d %-8d %d\n",
+                           maxlen, RT_NAME_MAX,
+                           m->parent.parent.name,
+                           RT_NAME_MAX,
+                           m->owner ? m->owner->name : "(NULL)",
+                           m->hold,
+                           rt_list_len(&m->parent.suspend_thread),
+                           m->priority,
+                           m->take_count,
+                           m->contend_count,
+                           m->max_hold_tick,
+                           m->max_wait_tick);
+#else
                 rt_kprintf("%-*.*s %-8.*s %04d %d              %d\n",
                            maxlen, RT_NAME_MAX,
                            m->parent.parent.name,
                            RT_NAME_MAX,
-                           m->owner->name,
+                           m->owner ? m->owner->name : "(NULL)",
                            m->hold,
                            rt_list_len(&m->parent.suspend_thread),
                            m->priority);
+#endif /* RT_USING_MUTEX_STATS */
 
             }
         }
@@ -722,6 +743,125 @@ long list_mempool(void)
 }
 #endif /* RT_USING_MEMPOOL */
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+long list_heapcache(void)
+{
+    rt_base_t level;
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t *)RT_NULL;
+
+    int maxlen;
+    const char *item_title = "thread";
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list) / sizeof(obj_list[0]));
+
+    maxlen = RT_NAME_MAX;
+
+    rt_kprintf("%-*.s    hit        miss    hit rate cached size\n", maxlen, item_title);
+    object_split(maxlen);
+    rt_kprintf(" ---------- ---------- -------- -----------\n");
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i;
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+                struct rt_thread *thread;
+                rt_uint32_t hit, miss;
+                rt_size_t cached;
+                int index;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                level = rt_hw_interrupt_disable();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_hw_interrupt_enable(level);
+                    continue;
+                }
+
+                thread = (struct rt_thread *)obj;
+                hit = thread->heap_cache.hit;
+                miss = thread->heap_cache.miss;
+                for (cached = 0, index = 0; index < RT_HEAP_CACHE_CLASS_NUM; index ++)
+                {
+                    cached += (rt_size_t)thread->heap_cache.count[index] * (RT_HEAP_CACHE_MIN_SIZE << index);
+                }
+                rt_hw_interrupt_enable(level);
+
+                rt_kprintf("%-*.*s %-10d %-10d %3d%%     %-10d\n",
+                           maxlen, RT_NAME_MAX,
+                           thread->name,
+                           hit,
+                           miss,
+                           (hit + miss) ? (int)((rt_uint64_t)hit * 100 / (hit + miss)) : 0,
+                           cached);
+            }
+        }
+    }
+    while (next != (rt_list_t *)RT_NULL);
+
+    return 0;
+}
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
+#ifdef RT_USING_HEAP_POOL
+long list_heappool(void)
+{
+    rt_base_t level;
+    struct rt_heap_pool *pool;
+    rt_size_t total, free, min_free;
+    rt_uint32_t hit, miss;
+    int index;
+
+    rt_kprintf("block size total      free       min free   hit        miss\n");
+    rt_kprintf("---------- ---------- ---------- ---------- ---------- ----------\n");
+    for (index = 0; (pool = rt_heap_pool_get(index)) != RT_NULL; index ++)
+    {
+        level = rt_hw_interrupt_disable();
+        total = pool->mp.block_total_count;
+        free = pool->mp.block_free_count;
+        min_free = pool->min_free;
+        hit = pool->hit;
+        miss = pool->miss;
+        rt_hw_interrupt_enable(level);
+
+        rt_kprintf("%-10d %-10d %-10d %-10d %-10d %-10d\n",
+                   pool->mp.block_size, total, free, min_free, hit, miss);
+    }
+
+#ifdef RT_USING_MEMTRACE
+    {
+        rt_uint32_t peak[RT_HEAP_PROFILE_CLASS_NUM];
+        int first = 1;
+
+        rt_heap_profile_get(peak);
+        rt_kprintf("\npeak blocks in use since startup:\n");
+        for (index = 0; index < RT_HEAP_PROFILE_CLASS_NUM; index ++)
+        {
+            rt_kprintf(" <=%-5d %d\n", RT_HEAP_PROFILE_MIN_SIZE << index, peak[index]);
+        }
+
+        /* leave a quarter of headroom over the peak */
+        rt_kprintf("suggested RT_HEAP_POOL_CONFIG \"");
+        for (index = 0; index < RT_HEAP_PROFILE_CLASS_NUM; index ++)
+        {
+            if (peak[index] == 0)
+                continue;
+            rt_kprintf("%s%d:%d", first ? "" : ",", RT_HEAP_PROFILE_MIN_SIZE << index,
+                       peak[index] + peak[index] / 4 + 1);
+            first = 0;
+        }
+        rt_kprintf("\"\n");
+    }
+#endif /* RT_USING_MEMTRACE */
+
+    return 0;
+}
+#endif /* RT_USING_HEAP_POOL */
+
 long list_timer(void)
 {
     rt_base_t level;
@@ -933,6 +1073,18 @@ int cmd_list(int argc, char **argv)
             list_mempool();
         }
 #endif /* RT_USING_MEMPOOL */
+#ifdef RT_USING_HEAP_THREAD_CACHE
+        else if(strcmp(argv[1], "heapcache") == 0)
+        {
+            list_heapcache();
+        }
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+#ifdef RT_USING_HEAP_POOL
+        else if(strcmp(argv[1], "heappool") == 0)
+        {
+            list_heappool();
+        }
+#endif /* RT_USING_HEAP_POOL */
 #ifdef RT_USING_DEVICE
         else if(strcmp(argv[1], "device") == 0)
         {
@@ -980,6 +1132,12 @@ _usage:
 #ifdef RT_USING_MEMPOOL
     rt_kprintf("    mempool - list memory pools\n");
 #endif /* RT_USING_MEMPOOL */
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    rt_kprintf("    heapcache - list thread heap caches\n");
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+#ifdef RT_USING_HEAP_POOL
+    rt_kprintf("    heappool - list heap pools and allocation profile\n");
+#endif /* RT_USING_HEAP_POOL */
 #ifdef RT_USING_DEVICE
     rt_kprintf("    device - list devices\n");
 #endif /* RT_USING_DEVICE */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    The first version
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+#include <rtthread.h>
+
+#ifndef RT_USING_MESSAGEQUEUE_ZEROCOPY
+#error "Please enable RT_USING_MESSAGEQUEUE_ZEROCOPY"
+#endif
+
+namespace rtthread {
+
+/**
+ * The ZeroCopyQueue class passes messages of type T between threads without
+ * copying them. A message is constructed in place in a slot of the queue,
+ * committed, and borrowed by the receiver, which destroys it on release.
+ * @param  T         data type of a single message element.
+ * @param  queue_sz  maximum number of messages in queue.
+ */
+template<typename T, uint32_t queue_sz>
+class ZeroCopyQueue
+{
+    /* the messages are aligned to RT_ALIGN_SIZE, and a mailbox holds at most RT_MB_ENTRY_MAX of them */
+    static_assert(alignof(T) <= RT_ALIGN_SIZE, "T is aligned beyond RT_ALIGN_SIZE");
+    static_assert(queue_sz > 0 && queue_sz <= RT_MB_ENTRY_MAX, "queue_sz is out of range");
+
+public:
+    /**
+     * The Slot class owns one message of the queue. It is either allocated
+     * and not committed yet, or borrowed from the queue. The message is
+     * destroyed and the slot is given back when the Slot is released.
+     */
+    class Slot
+    {
+    public:
+        Slot() : mQueue(RT_NULL), mData(RT_NULL) {}
+
+        Slot(Slot&& other) : mQueue(other.mQueue), mData(other.mData)
+        {
+            other.mData = RT_NULL;
+        }
+
+        Slot& operator=(Slot&& other)
+        {
+            if (this != &other)
+            {
+                release();
+                mQueue = other.mQueue;
+                mData  = other.mData;
+                other.mData = RT_NULL;
+            }
+            return *this;
+        }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        ~Slot()
+        {
+            release();
+        }
+
+        T* get() const { return mData; }
+        T& operator*() const { return *mData; }
+        T* operator->() const { return mData; }
+        explicit operator bool() const { return mData != RT_NULL; }
+
+        /** Append the message to the queue, the Slot becomes empty. */
+        bool commit()
+        {
+            if (mData == RT_NULL)
+                return false;
+
+            rt_zcmq_commit(mQueue, mData);
+            mData = RT_NULL;
+
+            return true;
+        }
+
+        /** Destroy the message and give back the slot. */
+        void release()
+        {
+            if (mData != RT_NULL)
+            {
+                mData->~T();
+                rt_zcmq_release(mQueue, mData);
+                mData = RT_NULL;
+            }
+        }
+
+    private:
+        friend class ZeroCopyQueue;
+
+        Slot(rt_zcmq_t queue, T *data) : mQueue(queue), mData(data) {}
+
+        rt_zcmq_t mQueue;
+        T *mData;
+    };
+
+    /** Create and initialise a zero-copy message Queue. */
+    ZeroCopyQueue(const char *name = "zcmq")
+    {
+        rt_zcmq_init(&mID, name, mPool, sizeof(T), sizeof(mPool), RT_IPC_FLAG_FIFO);
+    }
+
+    ~ZeroCopyQueue()
+    {
+        rt_zcmq_detach(&mID);
+    }
+
+    /** Construct a message in a free slot, the message is sent by Slot::commit.
+      @param   millisec  timeout value or 0 in case of no time-out.
+      @param   args      arguments of the constructor of T.
+      @return  the slot, empty on timeout.
+    */
+    template<typename... Args>
+    Slot alloc(int32_t millisec, Args&&... args)
+    {
+        void *ptr = rt_zcmq_alloc(&mID, tick(millisec));
+
+        if (ptr == RT_NULL)
+            return Slot();
+
+        return Slot(&mID, new (ptr) T(std::forward<Args>(args)...));
+    }
+
+    /** Move a message into the Queue.
+      @param   data      message to move.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: 0)
+      @return  bool .
+    */
+    bool put(T&& data, int32_t millisec = 0)
+    {
+        return alloc(millisec, std::move(data)).commit();
+    }
+
+    bool put(const T& data, int32_t millisec = 0)
+    {
+        return alloc(millisec, data).commit();
+    }
+
+    /** Borrow a message from the Queue.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: wait forever)
+      @return  the slot, empty on timeout.
+    */
+    Slot borrow(int32_t millisec = -1)
+    {
+        return Slot(&mID, static_cast<T *>(rt_zcmq_borrow(&mID, tick(millisec))));
+    }
+
+    /** Move a message out of the Queue.
+      @param   millisec  timeout value or 0 in case of no time-out. (default: wait forever)
+      @return  bool .
+    */
+    bool get(T& data, int32_t millisec = -1)
+    {
+        Slot slot = borrow(millisec);
+
+        if (!slot)
+            return false;
+
+        data = std::move(*slot);
+
+        return true;
+    }
+
+private:
+    static rt_int32_t tick(int32_t millisec)
+    {
+        return millisec < 0 ? RT_WAITING_FOREVER : rt_tick_from_millisecond(millisec);
+    }
+
+    struct rt_zcmq mID;
+
+    rt_ubase_t mPool[RT_ZCMQ_POOL_SIZE(sizeof(T), queue_sz) / sizeof(rt_ubase_t)];
+};
+
+}
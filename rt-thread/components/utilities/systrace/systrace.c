@@ -0,0 +1,605 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "systrace.h"
+
+#define DBG_TAG    "systrace"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#if (RT_SYSTRACE_BUF_SIZE & (RT_SYSTRACE_BUF_SIZE - 1)) != 0
+#error "RT_SYSTRACE_BUF_SIZE must be power of 2"
+#endif
+
+#ifdef RT_USING_SMP
+#define _CPUS_NR                RT_CPUS_NR
+#define _cpu_id()               rt_hw_cpu_id()
+#define _local_irq_disable()    rt_hw_local_irq_disable()
+#define _local_irq_enable(l)    rt_hw_local_irq_enable(l)
+#else
+#define _CPUS_NR                1
+#define _cpu_id()               0
+#define _local_irq_disable()    rt_hw_interrupt_disable()
+#define _local_irq_enable(l)    rt_hw_interrupt_enable(l)
+#endif /* RT_USING_SMP */
+
+/*
+ * The events ring of one cpu. It's only written by its own cpu with local
+ * interrupt disabled, so no lock is needed. The oldest events are overwritten.
+ */
+struct systrace_ring
+{
+    rt_uint32_t head;                           /* count of events ever written */
+    struct rt_systrace_event event[RT_SYSTRACE_BUF_SIZE];
+};
+
+struct systrace_thread
+{
+    rt_thread_t thread;
+    char name[RT_NAME_MAX];
+    rt_uint8_t priority;
+
+    rt_uint64_t wakeup_ts;                      /* 0: not waiting for cpu */
+    rt_uint64_t switch_in_ts;
+    rt_uint64_t run_time;
+
+    rt_uint32_t switches;
+    rt_uint32_t preempts;
+    rt_uint32_t max_latency;                    /* ns */
+    rt_uint32_t hist[RT_SYSTRACE_HIST_NUM];
+};
+
+static struct systrace_ring _ring[_CPUS_NR];
+static struct systrace_thread _thread[RT_SYSTRACE_THREAD_NUM];
+static rt_uint32_t _thread_lost;
+static rt_uint64_t _start_ts;
+static rt_uint32_t _ns_per_tick_q16;            /* ns per cputime tick, 16.16 fixed point */
+static volatile rt_bool_t _enabled = RT_FALSE;
+
+/* the hooks installed before tracing, they are chained and restored on stop */
+static rt_bool_t _hooked = RT_FALSE;
+static void (*_prev_switch_hook)(struct rt_thread *from, struct rt_thread *to);
+static void (*_prev_wakeup_hook)(rt_thread_t thread);
+static void (*_prev_inited_hook)(rt_thread_t thread);
+static void (*_prev_irq_enter_hook)(void);
+static void (*_prev_irq_leave_hook)(void);
+
+#ifdef RT_USING_SMP
+static struct rt_spinlock _thread_lock;
+#endif /* RT_USING_SMP */
+
+static void _systrace_record(rt_uint8_t type, rt_uint64_t ts, rt_thread_t from, rt_uint32_t to)
+{
+    rt_base_t level;
+    struct systrace_ring *ring;
+    struct rt_systrace_event *event;
+
+    level = _local_irq_disable();
+
+    ring = &_ring[_cpu_id()];
+    event = &ring->event[ring->head & (RT_SYSTRACE_BUF_SIZE - 1)];
+    event->ts_low   = (rt_uint32_t)ts;
+    event->ts_high  = (rt_uint32_t)(ts >> 32);
+    event->type     = type;
+    event->cpu      = (rt_uint8_t)_cpu_id();
+    event->priority = from ? from->current_priority : 0;
+    event->from     = (rt_uint32_t)(rt_ubase_t)from;
+    event->to       = to;
+    ring->head ++;
+
+    _local_irq_enable(level);
+}
+
+/* it must be invoked with _thread_lock held */
+static struct systrace_thread *_systrace_thread_get(rt_thread_t thread)
+{
+    int index;
+    struct systrace_thread *empty = RT_NULL;
+
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        if (_thread[index].thread == thread)
+        {
+            return &_thread[index];
+        }
+
+        if (empty == RT_NULL && _thread[index].thread == RT_NULL)
+        {
+            empty = &_thread[index];
+        }
+    }
+
+    if (empty == RT_NULL)
+    {
+        _thread_lost ++;
+        return RT_NULL;
+    }
+
+    empty->thread = thread;
+    rt_strncpy(empty->name, thread->name, RT_NAME_MAX);
+
+    return empty;
+}
+
+static rt_uint32_t _systrace_ns(rt_uint64_t tick)
+{
+    rt_uint64_t ns = (tick * _ns_per_tick_q16) >> 16;
+
+    return ns > RT_UINT32_MAX ? RT_UINT32_MAX : (rt_uint32_t)ns;
+}
+
+static void _systrace_latency(struct systrace_thread *st, rt_uint64_t now)
+{
+    int bucket;
+    rt_uint32_t latency, us;
+
+    latency = _systrace_ns(now - st->wakeup_ts);
+    st->wakeup_ts = 0;
+
+    if (latency > st->max_latency)
+    {
+        st->max_latency = latency;
+    }
+
+    us = latency / 1000;
+    for (bucket = 0; bucket < RT_SYSTRACE_HIST_NUM - 1; bucket ++)
+    {
+        if (us < (1UL << bucket))
+        {
+            break;
+        }
+    }
+    st->hist[bucket] ++;
+}
+
+static void _systrace_switch_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_base_t level;
+    rt_uint64_t now;
+    struct systrace_thread *st;
+
+    if (_prev_switch_hook) _prev_switch_hook(from, to);
+    if (!_enabled) return;
+
+    now = clock_cpu_gettime();
+    _systrace_record(RT_SYSTRACE_EVENT_SWITCH, now, from, (rt_uint32_t)(rt_ubase_t)to);
+
+    level = rt_spin_lock_irqsave(&_thread_lock);
+
+    st = _systrace_thread_get(from);
+    if (st != RT_NULL)
+    {
+        if (st->switch_in_ts != 0)
+        {
+            st->run_time += now - st->switch_in_ts;
+            st->switch_in_ts = 0;
+        }
+
+        /* switched out while still runnable */
+        if ((from->stat & RT_THREAD_STAT_MASK) == RT_THREAD_RUNNING ||
+            (from->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY)
+        {
+            st->preempts ++;
+        }
+    }
+
+    st = _systrace_thread_get(to);
+    if (st != RT_NULL)
+    {
+        st->switches ++;
+        st->switch_in_ts = now;
+        st->priority = to->current_priority;
+        if (st->wakeup_ts != 0)
+        {
+            _systrace_latency(st, now);
+        }
+    }
+
+    rt_spin_unlock_irqrestore(&_thread_lock, level);
+}
+
+static void _systrace_wakeup_hook(rt_thread_t thread)
+{
+    rt_base_t level;
+    rt_uint64_t now;
+    struct systrace_thread *st;
+
+    if (_prev_wakeup_hook) _prev_wakeup_hook(thread);
+    if (!_enabled) return;
+
+    now = clock_cpu_gettime();
+    _systrace_record(RT_SYSTRACE_EVENT_WAKEUP, now, thread, (rt_uint32_t)(rt_ubase_t)rt_thread_self());
+
+    level = rt_spin_lock_irqsave(&_thread_lock);
+    /* the thread may be scheduled before the hook is invoked */
+    if ((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY)
+    {
+        st = _systrace_thread_get(thread);
+        if (st != RT_NULL && st->wakeup_ts == 0)
+        {
+            st->wakeup_ts = now;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_thread_lock, level);
+}
+
+static void _systrace_inited_hook(rt_thread_t thread)
+{
+    int index;
+    rt_base_t level;
+
+    if (_prev_inited_hook) _prev_inited_hook(thread);
+
+    /* the thread object may be reused, forget the old one */
+    level = rt_spin_lock_irqsave(&_thread_lock);
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        if (_thread[index].thread == thread)
+        {
+            rt_memset(&_thread[index], 0, sizeof(struct systrace_thread));
+            break;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_thread_lock, level);
+}
+
+static void _systrace_irq_enter_hook(void)
+{
+    if (_prev_irq_enter_hook) _prev_irq_enter_hook();
+    if (!_enabled) return;
+
+    _systrace_record(RT_SYSTRACE_EVENT_IRQ_ENTER, clock_cpu_gettime(),
+                     rt_thread_self(), rt_interrupt_get_nest());
+}
+
+static void _systrace_irq_leave_hook(void)
+{
+    if (_prev_irq_leave_hook) _prev_irq_leave_hook();
+    if (!_enabled) return;
+
+    _systrace_record(RT_SYSTRACE_EVENT_IRQ_LEAVE, clock_cpu_gettime(),
+                     rt_thread_self(), rt_interrupt_get_nest());
+}
+
+/**
+ * @brief This function will clear all the events and statistics.
+ */
+void rt_systrace_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&_thread_lock);
+    rt_memset(_ring, 0, sizeof(_ring));
+    rt_memset(_thread, 0, sizeof(_thread));
+    _thread_lost = 0;
+    _start_ts = clock_cpu_gettime();
+    rt_spin_unlock_irqrestore(&_thread_lock, level);
+}
+
+/**
+ * @brief This function will install the hooks and start tracing.
+ *
+ * @note The scheduler, thread resume/inited and interrupt enter/leave hooks
+ *       are taken by the tracer, the hooks installed before are still invoked
+ *       and they are restored by rt_systrace_stop().
+ *
+ * @return RT_EOK on success, -RT_ENOSYS if cputime is not available.
+ */
+int rt_systrace_start(void)
+{
+    float res = clock_cpu_getres();
+
+    if (res <= 0)
+    {
+        LOG_E("cputime is not available.");
+        return -RT_ENOSYS;
+    }
+    _ns_per_tick_q16 = (rt_uint32_t)(res * 65536);
+
+#ifdef RT_USING_SMP
+    rt_spin_lock_init(&_thread_lock);
+#endif /* RT_USING_SMP */
+    rt_systrace_reset();
+
+    if (!_hooked)
+    {
+        _prev_switch_hook = rt_scheduler_gethook();
+        _prev_wakeup_hook = rt_thread_resume_gethook();
+        _prev_inited_hook = rt_thread_inited_gethook();
+        _prev_irq_enter_hook = rt_interrupt_enter_gethook();
+        _prev_irq_leave_hook = rt_interrupt_leave_gethook();
+
+        rt_scheduler_sethook(_systrace_switch_hook);
+        rt_thread_resume_sethook(_systrace_wakeup_hook);
+        rt_thread_inited_sethook(_systrace_inited_hook);
+        rt_interrupt_enter_sethook(_systrace_irq_enter_hook);
+        rt_interrupt_leave_sethook(_systrace_irq_leave_hook);
+        _hooked = RT_TRUE;
+    }
+
+    _enabled = RT_TRUE;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief This function will stop tracing and restore the hooks installed before
+ *        rt_systrace_start(), the events and statistics are kept.
+ */
+void rt_systrace_stop(void)
+{
+    _enabled = RT_FALSE;
+
+    if (!_hooked)
+    {
+        return;
+    }
+
+    rt_scheduler_sethook(_prev_switch_hook);
+    rt_thread_resume_sethook(_prev_wakeup_hook);
+    rt_thread_inited_sethook(_prev_inited_hook);
+    rt_interrupt_enter_sethook(_prev_irq_enter_hook);
+    rt_interrupt_leave_sethook(_prev_irq_leave_hook);
+    _hooked = RT_FALSE;
+}
+
+/**
+ * @brief This function will export the threads and events in binary format.
+ *        Tracing is paused during the export.
+ *
+ * @param write the output function.
+ * @param ctx the parameter of output function.
+ *
+ * @return RT_EOK on success, -RT_EIO on output error.
+ */
+rt_err_t rt_systrace_export(rt_systrace_write_t write, void *ctx)
+{
+    int cpu, index;
+    rt_base_t level;
+    rt_uint32_t count, start;
+    rt_uint32_t head[_CPUS_NR];
+    rt_bool_t enabled = _enabled;
+    struct rt_systrace_header header;
+    struct rt_systrace_thread_info info;
+    rt_err_t result = RT_EOK;
+
+    _enabled = RT_FALSE;
+
+    /* take the rings as they are now, so the header and the events output agree */
+    for (cpu = 0; cpu < _CPUS_NR; cpu ++)
+    {
+        level = _local_irq_disable();
+        head[cpu] = _ring[cpu].head;
+        _local_irq_enable(level);
+    }
+
+    rt_memset(&header, 0, sizeof(header));
+    header.magic      = RT_SYSTRACE_MAGIC;
+    header.version    = RT_SYSTRACE_VERSION;
+    header.cpus       = _CPUS_NR;
+    header.event_size = sizeof(struct rt_systrace_event);
+    header.name_max   = RT_NAME_MAX;
+    header.res_ps     = (rt_uint32_t)(clock_cpu_getres() * 1000);
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        if (_thread[index].thread != RT_NULL)
+        {
+            header.thread_num ++;
+        }
+    }
+    for (cpu = 0; cpu < _CPUS_NR; cpu ++)
+    {
+        count = head[cpu];
+        if (count > RT_SYSTRACE_BUF_SIZE)
+        {
+            header.event_lost += count - RT_SYSTRACE_BUF_SIZE;
+            count = RT_SYSTRACE_BUF_SIZE;
+        }
+        header.event_num += count;
+    }
+
+    if (write(ctx, &header, sizeof(header)) != sizeof(header))
+    {
+        result = -RT_EIO;
+        goto __exit;
+    }
+
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        if (_thread[index].thread == RT_NULL)
+        {
+            continue;
+        }
+
+        rt_memset(&info, 0, sizeof(info));
+        info.id = (rt_uint32_t)(rt_ubase_t)_thread[index].thread;
+        info.priority = _thread[index].priority;
+        rt_strncpy(info.name, _thread[index].name, RT_NAME_MAX);
+        if (write(ctx, &info, sizeof(info)) != sizeof(info))
+        {
+            result = -RT_EIO;
+            goto __exit;
+        }
+    }
+
+    for (cpu = 0; cpu < _CPUS_NR; cpu ++)
+    {
+        count = head[cpu] > RT_SYSTRACE_BUF_SIZE ? RT_SYSTRACE_BUF_SIZE : head[cpu];
+        start = head[cpu] - count;
+
+        /* the ring may wrap, output it in two pieces */
+        for (index = 0; index < 2 && count > 0; index ++)
+        {
+            rt_uint32_t offset = start & (RT_SYSTRACE_BUF_SIZE - 1);
+            rt_uint32_t length = RT_SYSTRACE_BUF_SIZE - offset;
+            rt_size_t size;
+
+            if (length > count)
+            {
+                length = count;
+            }
+            size = length * sizeof(struct rt_systrace_event);
+            if (write(ctx, &_ring[cpu].event[offset], size) != (rt_ssize_t)size)
+            {
+                result = -RT_EIO;
+                goto __exit;
+            }
+
+            start += length;
+            count -= length;
+        }
+    }
+
+__exit:
+    _enabled = enabled;
+    return result;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void _systrace_show(void)
+{
+    int index, bucket;
+    rt_base_t level;
+    rt_uint64_t now, total;
+    struct systrace_thread st;
+    rt_bool_t enabled = _enabled;
+    int maxlen = RT_NAME_MAX;
+
+    _enabled = RT_FALSE;
+
+    now = clock_cpu_gettime();
+    total = now - _start_ts;
+    if (total == 0) total = 1;
+
+    rt_kprintf("%-*.*s pri  run%%   switch  preempt max lat(us)\n", maxlen, RT_NAME_MAX, "thread");
+    rt_kprintf("%-*.*s ---  ------ -------- ------- ----------\n", maxlen, RT_NAME_MAX, " ---");
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        level = rt_spin_lock_irqsave(&_thread_lock);
+        st = _thread[index];
+        rt_spin_unlock_irqrestore(&_thread_lock, level);
+
+        if (st.thread == RT_NULL)
+        {
+            continue;
+        }
+
+        if (st.switch_in_ts != 0)
+        {
+            /* still running */
+            st.run_time += now - st.switch_in_ts;
+        }
+
+        rt_kprintf("%-*.*s %3d  %3d.%02d %8d %7d %10d\n",
+                   maxlen, RT_NAME_MAX, st.name, st.priority,
+                   (rt_uint32_t)(st.run_time * 100 / total),
+                   (rt_uint32_t)(st.run_time * 10000 / total % 100),
+                   st.switches, st.preempts, st.max_latency / 1000);
+    }
+    if (_thread_lost)
+    {
+        rt_kprintf("%d threads are not traced, enlarge RT_SYSTRACE_THREAD_NUM\n", _thread_lost);
+    }
+
+    rt_kprintf("\nwakeup to run latency(us):\n%-*.*s", maxlen, RT_NAME_MAX, "thread");
+    for (bucket = 0; bucket < RT_SYSTRACE_HIST_NUM - 1; bucket ++)
+    {
+        rt_kprintf(" <%-5d", 1 << bucket);
+    }
+    rt_kprintf(" >=%-4d\n", 1 << (RT_SYSTRACE_HIST_NUM - 2));
+    for (index = 0; index < RT_SYSTRACE_THREAD_NUM; index ++)
+    {
+        if (_thread[index].thread == RT_NULL)
+        {
+            continue;
+        }
+
+        rt_kprintf("%-*.*s", maxlen, RT_NAME_MAX, _thread[index].name);
+        for (bucket = 0; bucket < RT_SYSTRACE_HIST_NUM; bucket ++)
+        {
+            rt_kprintf(" %6d", _thread[index].hist[bucket]);
+        }
+        rt_kprintf("\n");
+    }
+
+    _enabled = enabled;
+}
+
+#ifdef DFS_USING_POSIX
+#include <unistd.h>
+#include <fcntl.h>
+
+static rt_ssize_t _systrace_file_write(void *ctx, const void *buffer, rt_size_t size)
+{
+    return write(*(int *)ctx, buffer, size);
+}
+#endif /* DFS_USING_POSIX */
+
+static int systrace(int argc, char **argv)
+{
+    if (argc >= 2 && !rt_strcmp(argv[1], "start"))
+    {
+        if (rt_systrace_start() == RT_EOK)
+        {
+            rt_kprintf("systrace started.\n");
+        }
+    }
+    else if (argc >= 2 && !rt_strcmp(argv[1], "stop"))
+    {
+        rt_systrace_stop();
+        rt_kprintf("systrace stopped.\n");
+    }
+    else if (argc >= 2 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_systrace_reset();
+    }
+    else if (argc >= 2 && !rt_strcmp(argv[1], "show"))
+    {
+        _systrace_show();
+    }
+#ifdef DFS_USING_POSIX
+    else if (argc >= 3 && !rt_strcmp(argv[1], "save"))
+    {
+        int fd = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+        if (fd < 0)
+        {
+            rt_kprintf("open %s failed.\n", argv[2]);
+            return -RT_ERROR;
+        }
+
+        if (rt_systrace_export(_systrace_file_write, &fd) != RT_EOK)
+        {
+            rt_kprintf("write %s failed.\n", argv[2]);
+        }
+        close(fd);
+    }
+#endif /* DFS_USING_POSIX */
+    else
+    {
+        rt_kprintf("Usage:\n");
+        rt_kprintf("systrace start       - start tracing\n");
+        rt_kprintf("systrace stop        - stop tracing\n");
+        rt_kprintf("systrace reset       - clear the events and statistics\n");
+        rt_kprintf("systrace show        - show the thread statistics\n");
+#ifdef DFS_USING_POSIX
+        rt_kprintf("systrace save <file> - save the events in binary format\n");
+#endif /* DFS_USING_POSIX */
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(systrace, scheduler latency tracer);
+#endif /* RT_USING_FINSH */
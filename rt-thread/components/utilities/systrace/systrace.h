@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __SYSTRACE_H__
+#define __SYSTRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RT_SYSTRACE_BUF_SIZE
+#define RT_SYSTRACE_BUF_SIZE        1024
+#endif
+
+#ifndef RT_SYSTRACE_THREAD_NUM
+#define RT_SYSTRACE_THREAD_NUM      32
+#endif
+
+/* latency histogram: bucket n counts the latency below 2^n us, the last one counts the others */
+#define RT_SYSTRACE_HIST_NUM        12
+
+#define RT_SYSTRACE_MAGIC           0x52545452  /* "RTTR" */
+#define RT_SYSTRACE_VERSION         1
+
+enum rt_systrace_event_type
+{
+    RT_SYSTRACE_EVENT_SWITCH = 0,               /* from: previous thread, to: next thread */
+    RT_SYSTRACE_EVENT_WAKEUP,                   /* from: woken thread, to: current thread */
+    RT_SYSTRACE_EVENT_IRQ_ENTER,                /* from: current thread, to: interrupt nest */
+    RT_SYSTRACE_EVENT_IRQ_LEAVE,                /* from: current thread, to: interrupt nest */
+};
+
+/* the event record, also the layout in exported data */
+struct rt_systrace_event
+{
+    rt_uint32_t ts_low;                         /* cputime, low 32 bits */
+    rt_uint32_t ts_high;                        /* cputime, high 32 bits */
+    rt_uint8_t  type;                           /* rt_systrace_event_type */
+    rt_uint8_t  cpu;
+    rt_uint8_t  priority;                       /* current priority of "from" thread */
+    rt_uint8_t  reserved;
+    rt_uint32_t from;
+    rt_uint32_t to;
+};
+
+/*
+ * Exported data, all fields are little endian:
+ *
+ *   struct rt_systrace_header
+ *   struct rt_systrace_thread_info * thread_num
+ *   struct rt_systrace_event * event_num, in time order for each cpu
+ */
+struct rt_systrace_header
+{
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t cpus;
+    rt_uint16_t event_size;
+    rt_uint16_t name_max;
+    rt_uint32_t res_ps;                         /* picosecond per cputime tick */
+    rt_uint32_t thread_num;
+    rt_uint32_t event_num;
+    rt_uint32_t event_lost;
+};
+
+struct rt_systrace_thread_info
+{
+    rt_uint32_t id;
+    rt_uint8_t  priority;
+    rt_uint8_t  reserved[3];
+    char        name[RT_NAME_MAX];
+};
+
+typedef rt_ssize_t (*rt_systrace_write_t)(void *ctx, const void *buffer, rt_size_t size);
+
+int  rt_systrace_start(void);
+void rt_systrace_stop(void);
+void rt_systrace_reset(void);
+rt_err_t rt_systrace_export(rt_systrace_write_t write, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYSTRACE_H__ */
@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2006-2022, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-16     RT-Thread    the first version
+#
+# Convert the file saved by 'systrace save' to Chrome trace JSON, which can
+# be opened by chrome://tracing or https://ui.perfetto.dev
+#
+# usage: python systrace2json.py systrace.bin [systrace.json]
+
+import json
+import struct
+import sys
+
+HEADER = struct.Struct('<IHHHHIIII')
+EVENT = struct.Struct('<IIBBBBII')
+
+EVENT_SWITCH, EVENT_WAKEUP, EVENT_IRQ_ENTER, EVENT_IRQ_LEAVE = range(4)
+
+def convert(data):
+    magic, version, cpus, event_size, name_max, res_ps, thread_num, event_num, event_lost = \
+        HEADER.unpack_from(data, 0)
+    if magic != 0x52545452 or version != 1 or event_size != EVENT.size:
+        raise ValueError('not a systrace file')
+
+    offset = HEADER.size
+    info = struct.Struct('<IB3x%ds' % name_max)
+    names = {}
+    for i in range(thread_num):
+        tid, prio, name = info.unpack_from(data, offset)
+        names[tid] = '%s (pri %d)' % (name.split(b'\0')[0].decode('ascii', 'replace'), prio)
+        offset += info.size
+
+    events = []
+    for i in range(event_num):
+        events.append(EVENT.unpack_from(data, offset))
+        offset += EVENT.size
+    events.sort(key = lambda e: (e[1] << 32) | e[0])
+
+    trace = []
+    us = res_ps / 1000000.0
+    running = {}
+    for ts_low, ts_high, type, cpu, prio, reserved, frm, to in events:
+        ts = ((ts_high << 32) | ts_low) * us
+        if type == EVENT_SWITCH:
+            if cpu in running:
+                trace.append({'name': names.get(frm, hex(frm)), 'ph': 'E', 'ts': ts, 'pid': cpu, 'tid': 0})
+            trace.append({'name': names.get(to, hex(to)), 'ph': 'B', 'ts': ts, 'pid': cpu, 'tid': 0})
+            running[cpu] = to
+        elif type == EVENT_WAKEUP:
+            trace.append({'name': 'wakeup ' + names.get(frm, hex(frm)), 'ph': 'i', 's': 'p',
+                          'ts': ts, 'pid': cpu, 'tid': 0,
+                          'args': {'by': names.get(to, hex(to))}})
+        elif type == EVENT_IRQ_ENTER:
+            trace.append({'name': 'irq', 'ph': 'B', 'ts': ts, 'pid': cpu, 'tid': 1})
+        elif type == EVENT_IRQ_LEAVE:
+            trace.append({'name': 'irq', 'ph': 'E', 'ts': ts, 'pid': cpu, 'tid': 1})
+
+    for cpu in range(cpus):
+        trace.append({'name': 'process_name', 'ph': 'M', 'pid': cpu, 'args': {'name': 'cpu%d' % cpu}})
+        trace.append({'name': 'thread_name', 'ph': 'M', 'pid': cpu, 'tid': 0, 'args': {'name': 'thread'}})
+        trace.append({'name': 'thread_name', 'ph': 'M', 'pid': cpu, 'tid': 1, 'args': {'name': 'interrupt'}})
+
+    if event_lost:
+        sys.stderr.write('%d oldest events were overwritten\n' % event_lost)
+
+    return {'traceEvents': trace, 'displayTimeUnit': 'ns'}
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print('usage: python systrace2json.py systrace.bin [systrace.json]')
+        sys.exit(1)
+
+    with open(sys.argv[1], 'rb') as f:
+        result = convert(f.read())
+
+    output = sys.argv[2] if len(sys.argv) > 2 else sys.argv[1] + '.json'
+    with open(output, 'w') as f:
+        json.dump(result, f)
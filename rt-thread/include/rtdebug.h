@@ -20,6 +20,10 @@
 #define RT_DEBUG_MEM                   0
 #endif
 
+#ifndef RT_DEBUG_TLSF
+#define RT_DEBUG_TLSF                  0
+#endif
+
 #ifndef RT_DEBUG_MEMHEAP
 #define RT_DEBUG_MEMHEAP               0
 #endif
@@ -634,6 +634,24 @@ struct rt_cpu
 
 #endif /* RT_USING_SMP */
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+#define RT_HEAP_CACHE_CLASS_NUM         5                   /**< number of size classes of the heap cache */
+#define RT_HEAP_CACHE_MIN_SIZE          (RT_ALIGN_SIZE > 16 ? RT_ALIGN_SIZE : 16)
+#define RT_HEAP_CACHE_MAX_SIZE          (RT_HEAP_CACHE_MIN_SIZE << (RT_HEAP_CACHE_CLASS_NUM - 1))
+
+/**
+ * Thread local cache of small heap blocks
+ */
+struct rt_heap_cache
+{
+    void       *free_list[RT_HEAP_CACHE_CLASS_NUM];     /**< cached free blocks of each size class */
+    rt_uint16_t count[RT_HEAP_CACHE_CLASS_NUM];         /**< number of cached blocks of each size class */
+
+    rt_uint32_t hit;                                    /**< allocations served by the cache */
+    rt_uint32_t miss;                                   /**< allocations refilled from the heap */
+};
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
 /**
  * Thread structure
  */
@@ -711,6 +729,10 @@ struct rt_thread
     rt_uint64_t  duration_tick;                         /**< cpu usage tick */
 #endif /* RT_USING_CPU_USAGE */
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    struct rt_heap_cache heap_cache;                    /**< thread local heap cache */
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
 #ifdef RT_USING_PTHREADS
     void  *pthread_data;                                /**< the handle of pthread data, adapt 32/64bit */
 #endif /* RT_USING_PTHREADS */
@@ -787,6 +809,14 @@ struct rt_mutex
 
     struct rt_thread    *owner;                         /**< current owner of mutex */
     rt_list_t            taken_list;                    /**< the object list taken by thread */
+
+#ifdef RT_USING_MUTEX_STATS
+    rt_uint32_t          take_count;                    /**< numbers of acquisitions */
+    rt_uint32_t          contend_count;                 /**< numbers of acquisitions which had to wait */
+    rt_tick_t            take_tick;                     /**< the tick when current owner took the mutex */
+    rt_tick_t            max_hold_tick;                 /**< the maximal holding time */
+    rt_tick_t            max_wait_tick;                 /**< the maximal waiting time */
+#endif /* RT_USING_MUTEX_STATS */
 };
 typedef struct rt_mutex *rt_mutex_t;
 #endif /* RT_USING_MUTEX */
@@ -893,6 +923,10 @@ typedef rt_mem_t rt_smem_t;
 typedef rt_mem_t rt_slab_t;
 #endif /* RT_USING_SLAB */
 
+#ifdef RT_USING_TLSF
+typedef rt_mem_t rt_tlsf_t;
+#endif /* RT_USING_TLSF */
+
 #ifdef RT_USING_MEMHEAP
 /**
  * memory item on the heap
@@ -957,6 +991,42 @@ struct rt_mempool
 typedef struct rt_mempool *rt_mp_t;
 #endif /* RT_USING_MEMPOOL */
 
+#ifdef RT_USING_HEAP_POOL
+#define RT_HEAP_POOL_NUM_MAX            8                   /**< max number of heap pools */
+#define RT_HEAP_PROFILE_CLASS_NUM       8                   /**< number of size classes of the heap profile */
+#define RT_HEAP_PROFILE_MIN_SIZE        16
+
+/**
+ * Fixed-size memory pool in front of the system heap
+ */
+struct rt_heap_pool
+{
+    struct rt_mempool mp;                               /**< blocks of the pool */
+
+    rt_uint32_t hit;                                    /**< allocations served by the pool */
+    rt_uint32_t miss;                                   /**< allocations fell back to the heap as the pool is empty */
+    rt_size_t   min_free;                               /**< the lowest number of free blocks */
+};
+#endif /* RT_USING_HEAP_POOL */
+
+#ifdef RT_USING_MESSAGEQUEUE_ZEROCOPY
+/**
+ * zero-copy message queue structure, the messages are blocks of the memory pool
+ * and only their addresses are passed through the mailbox
+ */
+struct rt_zcmq
+{
+    struct rt_mailbox    mb;                            /**< the committed messages */
+    struct rt_mempool    mp;                            /**< the message blocks */
+};
+typedef struct rt_zcmq *rt_zcmq_t;
+
+/* the buffer size of a zero-copy message queue, each message is aligned to RT_ALIGN_SIZE */
+#define RT_ZCMQ_POOL_SIZE(msg_size, max_msgs)                                       \
+    (RT_ALIGN((max_msgs) * sizeof(rt_ubase_t), RT_ALIGN_SIZE) +                     \
+     (max_msgs) * (RT_ALIGN(msg_size, RT_ALIGN_SIZE) + RT_ALIGN_SIZE) + RT_ALIGN_SIZE)
+#endif /* RT_USING_MESSAGEQUEUE_ZEROCOPY */
+
 /**@}*/
 
 #ifdef RT_USING_DEVICE
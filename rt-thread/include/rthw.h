@@ -155,6 +155,13 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+#ifdef RT_USING_TICKLESS
+/*
+ * tickless interfaces
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t tick);
+#endif /* RT_USING_TICKLESS */
+
 #ifdef RT_USING_SMP
 typedef union
 {
@@ -83,6 +83,9 @@ void rt_object_put_sethook(void (*hook)(struct rt_object *object));
  */
 rt_tick_t rt_tick_get(void);
 void rt_tick_set(rt_tick_t tick);
+#ifdef RT_USING_TICKLESS
+void rt_tick_compensate(rt_tick_t tick);
+#endif /* RT_USING_TICKLESS */
 void rt_tick_increase(void);
 rt_tick_t  rt_tick_from_millisecond(rt_int32_t ms);
 rt_tick_t rt_tick_get_millisecond(void);
@@ -170,6 +173,8 @@ int  rt_thread_kill(rt_thread_t tid, int sig);
 void rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread));
 void rt_thread_resume_sethook (void (*hook)(rt_thread_t thread));
 void rt_thread_inited_sethook (void (*hook)(rt_thread_t thread));
+void (*rt_thread_resume_gethook(void))(rt_thread_t thread);
+void (*rt_thread_inited_gethook(void))(rt_thread_t thread);
 #endif
 
 /*
@@ -199,6 +204,7 @@ rt_uint16_t rt_critical_level(void);
 #ifdef RT_USING_HOOK
 void rt_scheduler_sethook(void (*hook)(rt_thread_t from, rt_thread_t to));
 void rt_scheduler_switch_sethook(void (*hook)(struct rt_thread *tid));
+void (*rt_scheduler_gethook(void))(rt_thread_t from, rt_thread_t to);
 #endif
 
 #ifdef RT_USING_SMP
@@ -279,6 +285,17 @@ void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
 #endif
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+void rt_heap_cache_flush(rt_thread_t thread);
+#endif
+
+#ifdef RT_USING_HEAP_POOL
+struct rt_heap_pool *rt_heap_pool_get(int index);
+#ifdef RT_USING_MEMTRACE
+void rt_heap_profile_get(rt_uint32_t peak[RT_HEAP_PROFILE_CLASS_NUM]);
+#endif
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
@@ -297,6 +314,7 @@ rt_err_t rt_smem_detach(rt_smem_t m);
 void *rt_smem_alloc(rt_smem_t m, rt_size_t size);
 void *rt_smem_realloc(rt_smem_t m, void *rmem, rt_size_t newsize);
 void rt_smem_free(void *rmem);
+rt_size_t rt_smem_usable_size(void *rmem);
 #endif
 
 #ifdef RT_USING_MEMHEAP
@@ -311,6 +329,7 @@ rt_err_t rt_memheap_detach(struct rt_memheap *heap);
 void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
 void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize);
 void rt_memheap_free(void *ptr);
+rt_size_t rt_memheap_usable_size(void *ptr);
 void rt_memheap_info(struct rt_memheap *heap,
                      rt_size_t *total,
                      rt_size_t *used,
@@ -330,6 +349,18 @@ void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size);
 void rt_slab_free(rt_slab_t m, void *ptr);
 #endif
 
+#ifdef RT_USING_TLSF
+/**
+ * tlsf memory object interface
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_detach(rt_tlsf_t m);
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size);
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize);
+void rt_tlsf_free(void *rmem);
+rt_size_t rt_tlsf_usable_size(void *rmem);
+#endif
+
 /**@}*/
 
 /**
@@ -454,6 +485,28 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
 #endif
 
+#ifdef RT_USING_MESSAGEQUEUE_ZEROCOPY
+/*
+ * zero-copy message queue interface
+ */
+rt_err_t rt_zcmq_init(rt_zcmq_t   zcmq,
+                      const char *name,
+                      void       *msgpool,
+                      rt_size_t   msg_size,
+                      rt_size_t   pool_size,
+                      rt_uint8_t  flag);
+rt_err_t rt_zcmq_detach(rt_zcmq_t zcmq);
+#ifdef RT_USING_HEAP
+rt_zcmq_t rt_zcmq_create(const char *name, rt_size_t msg_size, rt_size_t max_msgs, rt_uint8_t flag);
+rt_err_t rt_zcmq_delete(rt_zcmq_t zcmq);
+#endif /* RT_USING_HEAP */
+
+void *rt_zcmq_alloc(rt_zcmq_t zcmq, rt_int32_t timeout);
+rt_err_t rt_zcmq_commit(rt_zcmq_t zcmq, void *msg);
+void *rt_zcmq_borrow(rt_zcmq_t zcmq, rt_int32_t timeout);
+void rt_zcmq_release(rt_zcmq_t zcmq, void *msg);
+#endif /* RT_USING_MESSAGEQUEUE_ZEROCOPY */
+
 /* defunct */
 void rt_thread_defunct_enqueue(rt_thread_t thread);
 rt_thread_t rt_thread_defunct_dequeue(void);
@@ -558,6 +611,8 @@ rt_uint8_t rt_interrupt_get_nest(void);
 #ifdef RT_USING_HOOK
 void rt_interrupt_enter_sethook(void (*hook)(void));
 void rt_interrupt_leave_sethook(void (*hook)(void));
+void (*rt_interrupt_enter_gethook(void))(void);
+void (*rt_interrupt_leave_gethook(void))(void);
 #endif
 
 #ifdef RT_USING_COMPONENTS_INIT
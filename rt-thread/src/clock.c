@@ -15,6 +15,7 @@
  * 2018-11-22     Jesven       add per cpu tick
  * 2020-12-29     Meco Man     implement rt_tick_get_millisecond()
  * 2021-06-01     Meco Man     add critical section projection for rt_tick_increase()
+ * 2026-10-16     RT-Thread    add rt_tick_compensate() for tickless idle
  */
 
 #include <rthw.h>
@@ -84,6 +85,26 @@ void rt_tick_set(rt_tick_t tick)
     rt_hw_interrupt_enable(level);
 }
 
+#ifdef RT_USING_TICKLESS
+/**
+ * @brief    This function will add the ticks passed while the periodic tick
+ *           was stopped by tickless idle.
+ *
+ * @param    tick is the number of passed ticks.
+ *
+ * @note     The timeout timers are not checked here, rt_timer_check() should be
+ *           invoked once interrupt is enabled again.
+ */
+void rt_tick_compensate(rt_tick_t tick)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_tick += tick;
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_TICKLESS */
+
 /**
  * @brief    This function will notify kernel there is one tick passed.
  *           Normally, this function is invoked by clock ISR.
@@ -16,6 +16,7 @@
  * 2018-11-22     Jesven       add per cpu idle task
  *                             combine the code of primary and secondary cpu
  * 2021-11-15     THEWON       Remove duplicate work between idle and _thread_exit
+ * 2026-10-16     RT-Thread    add tickless idle
  */
 
 #include <rthw.h>
@@ -45,6 +46,10 @@
 #define _CPUS_NR                1
 #endif /* RT_USING_SMP */
 
+#if defined(RT_USING_TICKLESS) && !defined(RT_TICKLESS_MIN_TICK)
+#define RT_TICKLESS_MIN_TICK    2
+#endif /* RT_USING_TICKLESS */
+
 static rt_list_t _rt_thread_defunct = RT_LIST_OBJECT_INIT(_rt_thread_defunct);
 
 static struct rt_thread idle_thread[_CPUS_NR];
@@ -218,6 +223,10 @@ static void rt_defunct_execute(void)
         rt_thread_free_sig(thread);
 #endif
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+        rt_heap_cache_flush(thread);
+#endif
+
         /* store the point of "thread->cleanup" avoid to lose */
         cleanup = thread->cleanup;
 
@@ -248,6 +257,67 @@ static void rt_defunct_execute(void)
     }
 }
 
+#ifdef RT_USING_TICKLESS
+/**
+ * @brief This function stops the periodic tick, sleeps until the given ticks
+ *        passed or another interrupt arrives, then restarts the periodic tick.
+ *        The board should override it.
+ *
+ * @param tick the ticks to sleep, RT_TICK_MAX means there is no timer running.
+ *
+ * @return the ticks passed during the sleep, excluding the one which will be
+ *         reported by a pending tick interrupt.
+ *
+ * @note It's invoked with interrupt disabled.
+ */
+RT_WEAK rt_tick_t rt_hw_tickless_sleep(rt_tick_t tick)
+{
+    return 0;
+}
+
+/**
+ * @brief This function programs the tick timer to the next timer expiry
+ *        and corrects the system tick on wakeup.
+ */
+static void rt_tickless_idle(void)
+{
+    rt_base_t level;
+    rt_tick_t sleep_tick, timeout_tick;
+
+    level = rt_hw_interrupt_disable();
+
+    timeout_tick = rt_timer_next_timeout_tick();
+    if (timeout_tick == RT_TICK_MAX)
+    {
+        sleep_tick = RT_TICK_MAX;
+    }
+    else
+    {
+        sleep_tick = timeout_tick - rt_tick_get();
+        /* the timer is about to expire or is already expired */
+        if (sleep_tick < RT_TICKLESS_MIN_TICK || sleep_tick >= RT_TICK_MAX / 2)
+        {
+            rt_hw_interrupt_enable(level);
+            return;
+        }
+    }
+
+    sleep_tick = rt_hw_tickless_sleep(sleep_tick);
+    if (sleep_tick > 0)
+    {
+        rt_tick_compensate(sleep_tick);
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    if (sleep_tick > 0)
+    {
+        /* handle the timers expired during the sleep */
+        rt_timer_check();
+    }
+}
+#endif /* RT_USING_TICKLESS */
+
 static void idle_thread_entry(void *parameter)
 {
 #ifdef RT_USING_SMP
@@ -280,6 +350,10 @@ static void idle_thread_entry(void *parameter)
         rt_defunct_execute();
 #endif /* RT_USING_SMP */
 
+#ifdef RT_USING_TICKLESS
+        rt_tickless_idle();
+#endif /* RT_USING_TICKLESS */
+
 #ifdef RT_USING_PM
         void rt_system_power_manager(void);
         rt_system_power_manager();
@@ -44,6 +44,9 @@
  * 2022-04-08     Stanley      Correct descriptions
  * 2022-10-15     Bernard      add nested mutex feature
  * 2022-10-16     Bernard      add prioceiling feature in mutex
+ * 2026-10-16     RT-Thread    propagate priority along mutex chain, fix prioceiling
+ *                             with nested mutex and add mutex statistics
+ * 2026-10-16     RT-Thread    add zero-copy message queue
  */
 
 #include <rtthread.h>
@@ -710,6 +713,10 @@ RTM_EXPORT(rt_sem_control);
 #endif /* RT_USING_SEMAPHORE */
 
 #ifdef RT_USING_MUTEX
+#ifndef RT_MUTEX_CHAIN_DEPTH
+#define RT_MUTEX_CHAIN_DEPTH    8
+#endif /* RT_MUTEX_CHAIN_DEPTH */
+
 rt_inline rt_uint8_t _mutex_update_priority(struct rt_mutex *mutex)
 {
     struct rt_thread *thread;
@@ -724,6 +731,12 @@ rt_inline rt_uint8_t _mutex_update_priority(struct rt_mutex *mutex)
         mutex->priority = 0xff;
     }
 
+    /* the owner runs at least at the priority ceiling */
+    if (mutex->ceiling_priority < mutex->priority)
+    {
+        mutex->priority = mutex->ceiling_priority;
+    }
+
     return mutex->priority;
 }
 
@@ -745,47 +758,97 @@ rt_inline rt_uint8_t _thread_get_mutex_priority(struct rt_thread* thread)
     return priority;
 }
 
+/*
+ * Change the priority of a thread. If the thread is waiting for a mutex, the
+ * new priority is passed to the owner of that mutex, and so on along the chain
+ * of owners, at most RT_MUTEX_CHAIN_DEPTH owners are walked through.
+ */
 rt_inline void _thread_update_priority(struct rt_thread *thread, rt_uint8_t priority)
 {
-    RT_DEBUG_LOG(RT_DEBUG_IPC,
-            ("thread:%s priority -> %d\n", thread->name, priority));
+    int depth;
+    struct rt_object *pending_obj;
+    struct rt_mutex *pending_mutex;
 
-    /* change priority of the thread */
-    rt_thread_control(thread,
-                      RT_THREAD_CTRL_CHANGE_PRIORITY,
-                      &priority);
-
-    if ((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+    for (depth = 0; depth < RT_MUTEX_CHAIN_DEPTH; depth ++)
     {
-        /* whether change the priority of taken mutex */
-        struct rt_object* pending_obj = thread->pending_object;
+        RT_DEBUG_LOG(RT_DEBUG_IPC,
+                ("thread:%s priority -> %d\n", thread->name, priority));
 
-        if (pending_obj && rt_object_get_type(pending_obj) == RT_Object_Class_Mutex)
+        /* change priority of the thread */
+        rt_thread_control(thread,
+                          RT_THREAD_CTRL_CHANGE_PRIORITY,
+                          &priority);
+
+        if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
         {
-            rt_uint8_t mutex_priority;
-            struct rt_mutex* pending_mutex = (struct rt_mutex *)pending_obj;
+            break;
+        }
 
-            /* re-insert thread to suspended thread list */
-            rt_list_remove(&(thread->tlist));
-            _ipc_list_suspend(&(pending_mutex->parent.suspend_thread),
-                                thread,
-                                pending_mutex->parent.parent.flag);
+        /* whether change the priority of taken mutex */
+        pending_obj = thread->pending_object;
+        if (pending_obj == RT_NULL || rt_object_get_type(pending_obj) != RT_Object_Class_Mutex)
+        {
+            break;
+        }
 
-            /* update priority */
-            _mutex_update_priority(pending_mutex);
-            /* change the priority of mutex owner thread */
-            RT_DEBUG_LOG(RT_DEBUG_IPC,
-                    ("mutex: %s priority -> %d\n", pending_mutex->parent.parent.name,
-                    pending_mutex->priority));
+        pending_mutex = (struct rt_mutex *)pending_obj;
 
-            mutex_priority = _thread_get_mutex_priority(pending_mutex->owner);
-            if (mutex_priority != pending_mutex->owner->current_priority)
-            {
-                _thread_update_priority(pending_mutex->owner, mutex_priority);
-            }
+        /* re-insert thread to suspended thread list */
+        rt_list_remove(&(thread->tlist));
+        _ipc_list_suspend(&(pending_mutex->parent.suspend_thread),
+                            thread,
+                            pending_mutex->parent.parent.flag);
+
+        /* update priority */
+        _mutex_update_priority(pending_mutex);
+        RT_DEBUG_LOG(RT_DEBUG_IPC,
+                ("mutex: %s priority -> %d\n", pending_mutex->parent.parent.name,
+                pending_mutex->priority));
+
+        /* change the priority of mutex owner thread */
+        thread = pending_mutex->owner;
+        if (thread == RT_NULL)
+        {
+            break;
         }
+
+        priority = _thread_get_mutex_priority(thread);
+        if (priority == thread->current_priority)
+        {
+            break;
+        }
+    }
+}
+
+#ifdef RT_USING_MUTEX_STATS
+rt_inline void _mutex_stats_reset(struct rt_mutex *mutex)
+{
+    mutex->take_count    = 0;
+    mutex->contend_count = 0;
+    mutex->take_tick     = 0;
+    mutex->max_hold_tick = 0;
+    mutex->max_wait_tick = 0;
+}
+
+rt_inline void _mutex_stats_wait(struct rt_mutex *mutex, rt_tick_t wait_tick)
+{
+    wait_tick = rt_tick_get() - wait_tick;
+    if (wait_tick > mutex->max_wait_tick)
+    {
+        mutex->max_wait_tick = wait_tick;
+    }
+}
+
+rt_inline void _mutex_stats_release(struct rt_mutex *mutex)
+{
+    rt_tick_t hold_tick = rt_tick_get() - mutex->take_tick;
+
+    if (hold_tick > mutex->max_hold_tick)
+    {
+        mutex->max_hold_tick = hold_tick;
     }
 }
+#endif /* RT_USING_MUTEX_STATS */
 
 /**
  * @addtogroup mutex
@@ -836,6 +899,9 @@ rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_MUTEX_STATS
+    _mutex_stats_reset(mutex);
+#endif /* RT_USING_MUTEX_STATS */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -906,22 +972,7 @@ void rt_mutex_drop_thread(rt_mutex_t mutex, rt_thread_t thread)
         need_update = RT_TRUE;
 
     /* update the priority of mutex */
-    if (!rt_list_isempty(&mutex->parent.suspend_thread))
-    {
-        /* more thread suspended in the list */
-        struct rt_thread *th;
-
-        th = rt_list_entry(mutex->parent.suspend_thread.next,
-                                struct rt_thread,
-                                tlist);
-        /* update the priority of mutex */
-        mutex->priority = th->current_priority;
-    }
-    else
-    {
-        /* set mutex priority to maximal priority */
-        mutex->priority = 0xff;
-    }
+    _mutex_update_priority(mutex);
 
     /* try to change the priority of mutex owner thread */
     if (need_update)
@@ -950,8 +1001,22 @@ rt_uint8_t rt_mutex_setprioceiling(rt_mutex_t mutex, rt_uint8_t priority)
 
     if ((mutex) && (priority < RT_THREAD_PRIORITY_MAX))
     {
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
         ret_priority = mutex->ceiling_priority;
         mutex->ceiling_priority = priority;
+
+        /* the mutex is held, raise its owner to the new ceiling */
+        if (mutex->owner != RT_NULL)
+        {
+            _mutex_update_priority(mutex);
+            if (mutex->priority < mutex->owner->current_priority)
+            {
+                _thread_update_priority(mutex->owner, mutex->priority);
+            }
+        }
+        rt_hw_interrupt_enable(level);
     }
     else
     {
@@ -1025,6 +1090,9 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_MUTEX_STATS
+    _mutex_stats_reset(mutex);
+#endif /* RT_USING_MUTEX_STATS */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -1106,6 +1174,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
 {
     rt_base_t level;
     struct rt_thread *thread;
+#ifdef RT_USING_MUTEX_STATS
+    rt_tick_t wait_tick;
+#endif /* RT_USING_MUTEX_STATS */
 
     /* this function must not be used in interrupt even if time = 0 */
     /* current context checking */
@@ -1150,20 +1221,22 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
         {
             /* set mutex owner and original priority */
             mutex->owner    = thread;
-            mutex->priority = 0xff;
             mutex->hold     = 1;
+            _mutex_update_priority(mutex);
 
-            if (mutex->ceiling_priority != 0xFF)
-            {
-                /* set the priority of thread to the ceiling priority */
-                if (mutex->ceiling_priority < mutex->owner->current_priority)
-                    _thread_update_priority(mutex->owner, mutex->ceiling_priority);
-            }
-            else
+            /* insert mutex to thread's taken object list */
+            rt_list_insert_after(&thread->taken_object_list, &mutex->taken_list);
+
+            /* set the priority of thread to the ceiling priority */
+            if (mutex->priority < thread->current_priority)
             {
-                /* insert mutex to thread's taken object list */
-                rt_list_insert_after(&thread->taken_object_list, &mutex->taken_list);
+                _thread_update_priority(thread, mutex->priority);
             }
+
+#ifdef RT_USING_MUTEX_STATS
+            mutex->take_count ++;
+            mutex->take_tick = rt_tick_get();
+#endif /* RT_USING_MUTEX_STATS */
         }
         else
         {
@@ -1192,6 +1265,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
                                     mutex->parent.parent.flag);
                 /* set pending object in thread to this mutex */
                 thread->pending_object = &(mutex->parent.parent);
+#ifdef RT_USING_MUTEX_STATS
+                wait_tick = rt_tick_get();
+#endif /* RT_USING_MUTEX_STATS */
 
                 /* update the priority level of mutex */
                 if (priority < mutex->priority)
@@ -1226,47 +1302,24 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
                 /* disable interrupt */
                 level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_MUTEX_STATS
+                _mutex_stats_wait(mutex, wait_tick);
+#endif /* RT_USING_MUTEX_STATS */
+
                 if (thread->error == RT_EOK)
                 {
                     /* get mutex successfully */
+#ifdef RT_USING_MUTEX_STATS
+                    mutex->take_count ++;
+                    mutex->contend_count ++;
+#endif /* RT_USING_MUTEX_STATS */
                 }
                 else
                 {
                     /* the mutex has not been taken and thread has detach from the pending list. */
-
-                    rt_bool_t need_update = RT_FALSE;
-
-                    /* should change the priority of mutex owner thread */
-                    if (mutex->owner->current_priority == thread->current_priority)
-                        need_update = RT_TRUE;
-
-                    /* update the priority of mutex */
-                    if (!rt_list_isempty(&mutex->parent.suspend_thread))
+                    if (mutex->owner != RT_NULL)
                     {
-                        /* more thread suspended in the list */
-                        struct rt_thread *th;
-
-                        th = rt_list_entry(mutex->parent.suspend_thread.next,
-                                                struct rt_thread,
-                                                tlist);
-                        /* update the priority of mutex */
-                        mutex->priority = th->current_priority;
-                    }
-                    else
-                    {
-                        /* set mutex priority to maximal priority */
-                        mutex->priority = 0xff;
-                    }
-
-                    /* try to change the priority of mutex owner thread */
-                    if (need_update)
-                    {
-                        /* get the maximal priority of mutex in thread */
-                        priority = _thread_get_mutex_priority(mutex->owner);
-                        if (priority != mutex->owner->current_priority)
-                        {
-                            _thread_update_priority(mutex->owner, priority);
-                        }
+                        rt_mutex_drop_thread(mutex, thread);
                     }
 
                     /* enable interrupt */
@@ -1366,6 +1419,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* if no hold */
     if (mutex->hold == 0)
     {
+#ifdef RT_USING_MUTEX_STATS
+        _mutex_stats_release(mutex);
+#endif /* RT_USING_MUTEX_STATS */
+
         /* remove mutex from thread's taken list */
         rt_list_remove(&mutex->taken_list);
 
@@ -1404,23 +1461,18 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             rt_list_insert_after(&next_thread->taken_object_list, &mutex->taken_list);
             /* cleanup pending object */
             next_thread->pending_object = RT_NULL;
+#ifdef RT_USING_MUTEX_STATS
+            mutex->take_tick = rt_tick_get();
+#endif /* RT_USING_MUTEX_STATS */
 
             /* resume thread */
             rt_thread_resume(next_thread);
 
-            /* update mutex priority */
-            if (!rt_list_isempty(&(mutex->parent.suspend_thread)))
+            /* update mutex priority, the new owner inherits the remaining waiters or ceiling */
+            _mutex_update_priority(mutex);
+            if (mutex->priority < next_thread->current_priority)
             {
-                struct rt_thread *th;
-
-                th = rt_list_entry(mutex->parent.suspend_thread.next,
-                        struct rt_thread,
-                        tlist);
-                mutex->priority = th->current_priority;
-            }
-            else
-            {
-                mutex->priority = 0xff;
+                _thread_update_priority(next_thread, mutex->priority);
             }
 
             need_schedule = RT_TRUE;
@@ -3531,4 +3583,267 @@ RTM_EXPORT(rt_mq_control);
 /**@}*/
 #endif /* RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_MESSAGEQUEUE_ZEROCOPY
+/**
+ * @addtogroup messagequeue
+ */
+
+/**@{*/
+
+/**
+ * @brief    Initialize a static zero-copy message queue.
+ *
+ * @note     The messages are blocks of a memory pool and only their addresses are passed
+ *           through a mailbox, so a message is never copied. The sender allocates a message
+ *           by rt_zcmq_alloc(), fills it in place and commits it by rt_zcmq_commit(). The
+ *           receiver borrows a message by rt_zcmq_borrow() and gives it back by rt_zcmq_release().
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue to initialize.
+ *
+ * @param    name is a pointer to the name that given to the queue.
+ *
+ * @param    msgpool is a pointer to the buffer of the queue, use RT_ZCMQ_POOL_SIZE() for its size.
+ *
+ * @param    msg_size is the maximum length of a message in bytes.
+ *
+ * @param    pool_size is the size of msgpool in bytes, it holds at most RT_MB_ENTRY_MAX messages.
+ *
+ * @param    flag is the queuing way of threads waiting for messages, RT_IPC_FLAG_PRIO or RT_IPC_FLAG_FIFO.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
+ *           If the return value is -RT_EINVAL, the pool is too small for one message.
+ */
+rt_err_t rt_zcmq_init(rt_zcmq_t   zcmq,
+                      const char *name,
+                      void       *msgpool,
+                      rt_size_t   msg_size,
+                      rt_size_t   pool_size,
+                      rt_uint8_t  flag)
+{
+    rt_size_t max_msgs, mb_size, block_size, stride, index;
+    rt_uint8_t *block;
+
+    /* parameter check */
+    RT_ASSERT(zcmq != RT_NULL);
+    RT_ASSERT(msgpool != RT_NULL);
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    if (msg_size == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /*
+     * Each message takes one mailbox slot and one memory pool block. The link
+     * pointer rt_mp_init() puts in front of a block is padded to RT_ALIGN_SIZE,
+     * so the messages are aligned to RT_ALIGN_SIZE.
+     */
+    block_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
+    stride = block_size + RT_ALIGN_SIZE;
+    max_msgs = pool_size / (sizeof(rt_ubase_t) + stride);
+    if (max_msgs > RT_MB_ENTRY_MAX)
+    {
+        /* the mailbox can't hold more, the rest of the pool is left unused */
+        max_msgs = RT_MB_ENTRY_MAX;
+    }
+    while (max_msgs > 0 && RT_ZCMQ_POOL_SIZE(msg_size, max_msgs) > pool_size)
+    {
+        max_msgs --;
+    }
+
+    if (max_msgs == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* the mailbox slots come first, then exactly max_msgs blocks of memory pool */
+    mb_size = RT_ALIGN(max_msgs * sizeof(rt_ubase_t), RT_ALIGN_SIZE);
+    block = (rt_uint8_t *)RT_ALIGN((rt_ubase_t)msgpool + mb_size + sizeof(rt_uint8_t *), RT_ALIGN_SIZE) -
+            sizeof(rt_uint8_t *);
+    rt_mb_init(&(zcmq->mb), name, msgpool, max_msgs, flag);
+    rt_mp_init(&(zcmq->mp), name, block, max_msgs * stride, block_size);
+
+    /* relink the free list with the padded stride */
+    zcmq->mp.block_total_count = max_msgs;
+    zcmq->mp.block_free_count = max_msgs;
+    for (index = 0; index < max_msgs - 1; index ++)
+    {
+        *(rt_uint8_t **)(block + index * stride) = block + (index + 1) * stride;
+    }
+    *(rt_uint8_t **)(block + index * stride) = RT_NULL;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_zcmq_init);
+
+
+/**
+ * @brief    Detach a static zero-copy message queue. All threads waiting on it are resumed.
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue to detach.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_zcmq_detach(rt_zcmq_t zcmq)
+{
+    /* parameter check */
+    RT_ASSERT(zcmq != RT_NULL);
+
+    rt_mb_detach(&(zcmq->mb));
+    rt_mp_detach(&(zcmq->mp));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_zcmq_detach);
+
+
+#ifdef RT_USING_HEAP
+/**
+ * @brief    Create a zero-copy message queue, its buffer is allocated from the system heap.
+ *
+ * @param    name is a pointer to the name that given to the queue.
+ *
+ * @param    msg_size is the maximum length of a message in bytes.
+ *
+ * @param    max_msgs is the maximum number of messages in the queue, at most RT_MB_ENTRY_MAX.
+ *
+ * @param    flag is the queuing way of threads waiting for messages, RT_IPC_FLAG_PRIO or RT_IPC_FLAG_FIFO.
+ *
+ * @return   Return a pointer to the queue. When the return value is RT_NULL, it means the creation failed.
+ */
+rt_zcmq_t rt_zcmq_create(const char *name, rt_size_t msg_size, rt_size_t max_msgs, rt_uint8_t flag)
+{
+    rt_zcmq_t zcmq;
+    rt_size_t pool_size;
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    if (max_msgs == 0 || max_msgs > RT_MB_ENTRY_MAX)
+    {
+        return RT_NULL;
+    }
+
+    pool_size = RT_ZCMQ_POOL_SIZE(msg_size, max_msgs);
+    zcmq = (rt_zcmq_t)RT_KERNEL_MALLOC(sizeof(struct rt_zcmq) + pool_size);
+    if (zcmq == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    if (rt_zcmq_init(zcmq, name, zcmq + 1, msg_size, pool_size, flag) != RT_EOK)
+    {
+        RT_KERNEL_FREE(zcmq);
+        return RT_NULL;
+    }
+
+    return zcmq;
+}
+RTM_EXPORT(rt_zcmq_create);
+
+
+/**
+ * @brief    Delete a zero-copy message queue created by rt_zcmq_create().
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue to delete.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_zcmq_delete(rt_zcmq_t zcmq)
+{
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    rt_zcmq_detach(zcmq);
+    RT_KERNEL_FREE(zcmq);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_zcmq_delete);
+#endif /* RT_USING_HEAP */
+
+
+/**
+ * @brief    Allocate a free message to fill in place.
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue.
+ *
+ * @param    timeout is the waiting time (unit: an OS tick) when all messages are in use.
+ *
+ * @return   Return a pointer to the message, or RT_NULL on timeout.
+ */
+void *rt_zcmq_alloc(rt_zcmq_t zcmq, rt_int32_t timeout)
+{
+    RT_ASSERT(zcmq != RT_NULL);
+
+    return rt_mp_alloc(&(zcmq->mp), timeout);
+}
+RTM_EXPORT(rt_zcmq_alloc);
+
+
+/**
+ * @brief    Append a message allocated by rt_zcmq_alloc() to the queue.
+ *
+ * @note     It never blocks, since there is a mailbox slot for every message.
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue.
+ *
+ * @param    msg is the message to send, the sender must not touch it any more.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_zcmq_commit(rt_zcmq_t zcmq, void *msg)
+{
+    RT_ASSERT(zcmq != RT_NULL);
+    RT_ASSERT(msg != RT_NULL);
+
+    return rt_mb_send(&(zcmq->mb), (rt_ubase_t)msg);
+}
+RTM_EXPORT(rt_zcmq_commit);
+
+
+/**
+ * @brief    Take the first message out of the queue without copying it.
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue.
+ *
+ * @param    timeout is the waiting time (unit: an OS tick) when the queue is empty.
+ *
+ * @return   Return a pointer to the message, or RT_NULL on timeout. It must be given back
+ *           by rt_zcmq_release() after use.
+ */
+void *rt_zcmq_borrow(rt_zcmq_t zcmq, rt_int32_t timeout)
+{
+    rt_ubase_t msg;
+
+    RT_ASSERT(zcmq != RT_NULL);
+
+    if (rt_mb_recv(&(zcmq->mb), &msg, timeout) != RT_EOK)
+    {
+        return RT_NULL;
+    }
+
+    return (void *)msg;
+}
+RTM_EXPORT(rt_zcmq_borrow);
+
+
+/**
+ * @brief    Give back a borrowed message, or drop an allocated message which is not committed.
+ *
+ * @param    zcmq is a pointer to the zero-copy message queue.
+ *
+ * @param    msg is the message to release.
+ */
+void rt_zcmq_release(rt_zcmq_t zcmq, void *msg)
+{
+    RT_ASSERT(zcmq != RT_NULL);
+    RT_ASSERT(msg != RT_NULL);
+    RT_ASSERT(*(rt_mp_t *)((rt_uint8_t *)msg - sizeof(rt_uint8_t *)) == &(zcmq->mp));
+
+    rt_mp_free(msg);
+}
+RTM_EXPORT(rt_zcmq_release);
+
+/**@}*/
+#endif /* RT_USING_MESSAGEQUEUE_ZEROCOPY */
+
 /**@}*/
@@ -56,6 +56,30 @@ void rt_interrupt_leave_sethook(void (*hook)(void))
 {
     rt_interrupt_leave_hook = hook;
 }
+
+/**
+ * @ingroup Hook
+ *
+ * @brief This function get the hook function set by rt_interrupt_enter_sethook().
+ *
+ * @return the hook function, RT_NULL if there is none.
+ */
+void (*rt_interrupt_enter_gethook(void))(void)
+{
+    return rt_interrupt_enter_hook;
+}
+
+/**
+ * @ingroup Hook
+ *
+ * @brief This function get the hook function set by rt_interrupt_leave_sethook().
+ *
+ * @return the hook function, RT_NULL if there is none.
+ */
+void (*rt_interrupt_leave_gethook(void))(void)
+{
+    return rt_interrupt_leave_hook;
+}
 #endif /* RT_USING_HOOK */
 
 /**
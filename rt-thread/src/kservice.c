@@ -1427,6 +1427,8 @@ rt_inline void _smem_info(rt_size_t *total,
     rt_smem_realloc(system_heap, _ptr, _newsize)
 #define _MEM_FREE(_ptr) \
     rt_smem_free(_ptr)
+#define _MEM_SIZE(_ptr) \
+    rt_smem_usable_size(_ptr)
 #define _MEM_INFO(_total, _used, _max)  \
     _smem_info(_total, _used, _max)
 #elif defined(RT_USING_MEMHEAP_AS_HEAP)
@@ -1442,6 +1444,8 @@ void *_memheap_realloc(struct rt_memheap *heap, void *rmem, rt_size_t newsize);
     _memheap_realloc(&system_heap, _ptr, _newsize)
 #define _MEM_FREE(_ptr)   \
     _memheap_free(_ptr)
+#define _MEM_SIZE(_ptr)   \
+    rt_memheap_usable_size(_ptr)
 #define _MEM_INFO(_total, _used, _max)   \
     rt_memheap_info(&system_heap, _total, _used, _max)
 #elif defined(RT_USING_SLAB_AS_HEAP)
@@ -1465,6 +1469,29 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_FREE(_ptr) \
     rt_slab_free(system_heap, _ptr)
 #define _MEM_INFO       _slab_info
+#elif defined(RT_USING_TLSF_AS_HEAP)
+static rt_tlsf_t system_heap;
+rt_inline void _tlsf_info(rt_size_t *total,
+    rt_size_t *used, rt_size_t *max_used)
+{
+    if (total)
+        *total = system_heap->total;
+    if (used)
+        *used = system_heap->used;
+    if (max_used)
+        *max_used = system_heap->max;
+}
+#define _MEM_INIT(_name, _start, _size) \
+    system_heap = rt_tlsf_init(_name, _start, _size)
+#define _MEM_MALLOC(_size)  \
+    rt_tlsf_alloc(system_heap, _size)
+#define _MEM_REALLOC(_ptr, _newsize)    \
+    rt_tlsf_realloc(system_heap, _ptr, _newsize)
+#define _MEM_FREE(_ptr) \
+    rt_tlsf_free(_ptr)
+#define _MEM_SIZE(_ptr) \
+    rt_tlsf_usable_size(_ptr)
+#define _MEM_INFO       _tlsf_info
 #else
 #define _MEM_INIT(...)
 #define _MEM_MALLOC(...)     RT_NULL
@@ -1473,6 +1500,374 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_INFO(...)
 #endif
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+#define _HEAP_CACHE_BATCH   (RT_HEAP_CACHE_DEPTH / 2)
+
+/* the thread local cache can be used only in thread context */
+rt_inline struct rt_heap_cache *_heap_cache_get(void)
+{
+    rt_thread_t thread;
+
+    if (rt_interrupt_get_nest() != 0)
+        return RT_NULL;
+
+    thread = rt_thread_self();
+    if (thread == RT_NULL)
+        return RT_NULL;
+
+    return &thread->heap_cache;
+}
+
+/* the smallest size class which can serve 'size' bytes */
+rt_inline int _heap_cache_alloc_class(rt_size_t size)
+{
+    int index = 0;
+    rt_size_t class_size = RT_HEAP_CACHE_MIN_SIZE;
+
+    while (class_size < size)
+    {
+        class_size <<= 1;
+        index ++;
+    }
+
+    return index;
+}
+
+/* the size class which a block of 'size' usable bytes belongs to, -1 if none */
+rt_inline int _heap_cache_free_class(rt_size_t size)
+{
+    int index = 0;
+    rt_size_t class_size = RT_HEAP_CACHE_MIN_SIZE;
+
+    if (size < RT_HEAP_CACHE_MIN_SIZE || size >= (RT_HEAP_CACHE_MAX_SIZE << 1))
+        return -1;
+
+    while ((class_size << 1) <= size)
+    {
+        class_size <<= 1;
+        index ++;
+    }
+
+    return index;
+}
+
+rt_inline void *_heap_cache_pop(struct rt_heap_cache *cache, int index)
+{
+    rt_base_t level;
+    void *ptr;
+
+    /* only against the signal handler of the same thread */
+    level = rt_hw_interrupt_disable();
+    ptr = cache->free_list[index];
+    if (ptr != RT_NULL)
+    {
+        cache->free_list[index] = *(void **)ptr;
+        cache->count[index] --;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return ptr;
+}
+
+rt_inline void _heap_cache_push(struct rt_heap_cache *cache, int index, void *ptr)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *(void **)ptr = cache->free_list[index];
+    cache->free_list[index] = ptr;
+    cache->count[index] ++;
+    rt_hw_interrupt_enable(level);
+}
+
+static void *_heap_cache_alloc(struct rt_heap_cache *cache, rt_size_t size)
+{
+    int index, count;
+    rt_base_t level;
+    void *ptr, *block;
+
+    index = _heap_cache_alloc_class(size);
+    ptr = _heap_cache_pop(cache, index);
+    if (ptr != RT_NULL)
+    {
+        cache->hit ++;
+        return ptr;
+    }
+
+    /* refill the size class with a batch of blocks in one lock */
+    cache->miss ++;
+    level = _heap_lock();
+    ptr = _MEM_MALLOC(RT_HEAP_CACHE_MIN_SIZE << index);
+    for (count = 1; ptr != RT_NULL && count < _HEAP_CACHE_BATCH; count ++)
+    {
+        block = _MEM_MALLOC(RT_HEAP_CACHE_MIN_SIZE << index);
+        if (block == RT_NULL)
+            break;
+        _heap_cache_push(cache, index, block);
+    }
+    _heap_unlock(level);
+
+    return ptr;
+}
+
+static rt_bool_t _heap_cache_free(struct rt_heap_cache *cache, void *rmem)
+{
+    int index;
+    rt_base_t level;
+    void *ptr;
+
+    index = _heap_cache_free_class(_MEM_SIZE(rmem));
+    if (index < 0)
+        return RT_FALSE;
+
+    _heap_cache_push(cache, index, rmem);
+    if (cache->count[index] > RT_HEAP_CACHE_DEPTH)
+    {
+        /* give a batch of blocks back to the system heap in one lock */
+        level = _heap_lock();
+        while (cache->count[index] > RT_HEAP_CACHE_DEPTH - _HEAP_CACHE_BATCH)
+        {
+            ptr = _heap_cache_pop(cache, index);
+            _MEM_FREE(ptr);
+        }
+        _heap_unlock(level);
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief This function will give all blocks cached by a thread back to system heap.
+ *
+ * @note  It's called when the thread is removed from the system, the cache
+ *        must not be used by the thread any more.
+ *
+ * @param thread is the thread whose heap cache will be flushed.
+ */
+void rt_heap_cache_flush(rt_thread_t thread)
+{
+    int index;
+    rt_base_t level;
+    void *ptr;
+
+    RT_ASSERT(thread != RT_NULL);
+
+    level = _heap_lock();
+    for (index = 0; index < RT_HEAP_CACHE_CLASS_NUM; index ++)
+    {
+        while ((ptr = _heap_cache_pop(&thread->heap_cache, index)) != RT_NULL)
+        {
+            _MEM_FREE(ptr);
+        }
+    }
+    _heap_unlock(level);
+}
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
+#ifdef RT_USING_HEAP_POOL
+static struct rt_heap_pool _heap_pools[RT_HEAP_POOL_NUM_MAX];
+static int _heap_pool_num;
+static rt_size_t _heap_pool_max_size;
+
+/*
+ * Carve the pools described by RT_HEAP_POOL_CONFIG, "block_size:block_count,...",
+ * from the system heap. The pools are kept in order of block size.
+ */
+static void _heap_pool_init(void)
+{
+    const char *config = RT_HEAP_POOL_CONFIG;
+    rt_size_t block_size[RT_HEAP_POOL_NUM_MAX];
+    rt_size_t block_count[RT_HEAP_POOL_NUM_MAX];
+    rt_size_t size, count, stride, pool_size;
+    char name[RT_NAME_MAX];
+    rt_uint8_t *block;
+    void *start;
+    int index, num = 0;
+
+    while (*config != '\0' && num < RT_HEAP_POOL_NUM_MAX)
+    {
+        if (!_ISDIGIT(*config))
+        {
+            config ++;
+            continue;
+        }
+
+        size = skip_atoi(&config);
+        count = 0;
+        if (*config == ':' && _ISDIGIT(config[1]))
+        {
+            config ++;
+            count = skip_atoi(&config);
+        }
+        if (size == 0 || count == 0)
+            continue;
+
+        /* insert in order of block size */
+        size = RT_ALIGN(size, RT_ALIGN_SIZE);
+        for (index = num; index > 0 && block_size[index - 1] > size; index --)
+        {
+            block_size[index] = block_size[index - 1];
+            block_count[index] = block_count[index - 1];
+        }
+        block_size[index] = size;
+        block_count[index] = count;
+        num ++;
+    }
+
+    for (index = 0; index < num; index ++)
+    {
+        /*
+         * rt_mp_init() puts a link pointer in front of each block, which leaves the
+         * blocks out of RT_ALIGN_SIZE. Pad the link to RT_ALIGN_SIZE and start the
+         * first block on RT_ALIGN_SIZE, so every block handed out is aligned.
+         */
+        stride = block_size[index] + RT_ALIGN_SIZE;
+        pool_size = block_count[index] * stride;
+        start = _MEM_MALLOC(pool_size + RT_ALIGN_SIZE);
+        if (start == RT_NULL)
+            break;
+        block = (rt_uint8_t *)RT_ALIGN((rt_ubase_t)start + sizeof(rt_uint8_t *), RT_ALIGN_SIZE) - sizeof(rt_uint8_t *);
+
+        rt_snprintf(name, sizeof(name), "heap%u", (unsigned int)block_size[index]);
+        rt_mp_init(&_heap_pools[index].mp, name, block, pool_size, block_size[index]);
+
+        /* relink the free list with the padded stride */
+        _heap_pools[index].mp.block_total_count = block_count[index];
+        _heap_pools[index].mp.block_free_count = block_count[index];
+        for (count = 0; count < block_count[index] - 1; count ++)
+        {
+            *(rt_uint8_t **)(block + count * stride) = block + (count + 1) * stride;
+        }
+        *(rt_uint8_t **)(block + count * stride) = RT_NULL;
+
+        _heap_pools[index].min_free = _heap_pools[index].mp.block_total_count;
+        _heap_pool_max_size = block_size[index];
+        _heap_pool_num ++;
+    }
+}
+
+/* the pool which the block belongs to */
+rt_inline struct rt_heap_pool *_heap_pool_of(void *ptr)
+{
+    int index;
+
+    for (index = 0; index < _heap_pool_num; index ++)
+    {
+        if ((rt_uint8_t *)ptr >= (rt_uint8_t *)_heap_pools[index].mp.start_address &&
+            (rt_uint8_t *)ptr < (rt_uint8_t *)_heap_pools[index].mp.start_address + _heap_pools[index].mp.size)
+            return &_heap_pools[index];
+    }
+
+    return RT_NULL;
+}
+
+/* allocate from the smallest pool that fits, it doesn't try the larger pools */
+static void *_heap_pool_alloc(rt_size_t size)
+{
+    int index;
+    void *ptr;
+    rt_base_t level;
+    struct rt_heap_pool *pool;
+
+    for (index = 0; _heap_pools[index].mp.block_size < size; index ++);
+    pool = &_heap_pools[index];
+
+    ptr = rt_mp_alloc(&pool->mp, 0);
+
+    level = rt_hw_interrupt_disable();
+    if (ptr != RT_NULL)
+    {
+        pool->hit ++;
+        if (pool->mp.block_free_count < pool->min_free)
+            pool->min_free = pool->mp.block_free_count;
+    }
+    else
+    {
+        pool->miss ++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return ptr;
+}
+
+/**
+ * @brief This function will get a pool in front of the system heap.
+ *
+ * @param index is the index of the pool, the pools are in order of block size.
+ *
+ * @return the pool, or RT_NULL if there are no more pools.
+ */
+struct rt_heap_pool *rt_heap_pool_get(int index)
+{
+    if (index < 0 || index >= _heap_pool_num)
+        return RT_NULL;
+
+    return &_heap_pools[index];
+}
+
+#ifdef RT_USING_MEMTRACE
+/* number of blocks in use and its peak for each power of 2 size since startup */
+static rt_uint32_t _heap_profile_used[RT_HEAP_PROFILE_CLASS_NUM];
+static rt_uint32_t _heap_profile_peak[RT_HEAP_PROFILE_CLASS_NUM];
+
+/*
+ * The class is taken from the block size rather than the requested size,
+ * so the allocation and the free of a block always account the same class.
+ */
+static void _heap_profile_update(void *ptr, rt_bool_t alloc)
+{
+    struct rt_heap_pool *pool;
+    rt_size_t size, class_size;
+    rt_base_t level;
+    int index;
+
+    pool = _heap_pool_of(ptr);
+    size = pool ? pool->mp.block_size : _MEM_SIZE(ptr);
+
+    for (index = 0, class_size = RT_HEAP_PROFILE_MIN_SIZE; class_size < size; index ++)
+    {
+        class_size <<= 1;
+    }
+    if (index >= RT_HEAP_PROFILE_CLASS_NUM)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    if (alloc)
+    {
+        if (++ _heap_profile_used[index] > _heap_profile_peak[index])
+            _heap_profile_peak[index] = _heap_profile_used[index];
+    }
+    else if (_heap_profile_used[index] > 0)
+    {
+        _heap_profile_used[index] --;
+    }
+    rt_hw_interrupt_enable(level);
+}
+#define _HEAP_PROFILE_ALLOC(_ptr)   do { if (_ptr) _heap_profile_update(_ptr, RT_TRUE); } while (0)
+#define _HEAP_PROFILE_FREE(_ptr)    _heap_profile_update(_ptr, RT_FALSE)
+
+/**
+ * @brief This function will get the peak number of blocks in use of each size
+ *        class since startup, the size of class n is (RT_HEAP_PROFILE_MIN_SIZE << n).
+ *
+ * @param peak is the array to store the peak numbers.
+ */
+void rt_heap_profile_get(rt_uint32_t peak[RT_HEAP_PROFILE_CLASS_NUM])
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(peak, _heap_profile_peak, sizeof(_heap_profile_peak));
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_MEMTRACE */
+#endif /* RT_USING_HEAP_POOL */
+
+#if !defined(RT_USING_HEAP_POOL) || !defined(RT_USING_MEMTRACE)
+#define _HEAP_PROFILE_ALLOC(_ptr)
+#define _HEAP_PROFILE_FREE(_ptr)
+#endif
+
 /**
  * @brief This function will init system heap.
  *
@@ -1491,6 +1886,10 @@ RT_WEAK void rt_system_heap_init(void *begin_addr, void *end_addr)
     _MEM_INIT("heap", begin_addr, end_align - begin_align);
     /* Initialize multi thread contention lock */
     _heap_lock_init();
+#ifdef RT_USING_HEAP_POOL
+    /* Carve the fixed-size pools from system heap */
+    _heap_pool_init();
+#endif /* RT_USING_HEAP_POOL */
 }
 
 /**
@@ -1504,6 +1903,37 @@ RT_WEAK void *rt_malloc(rt_size_t size)
 {
     rt_base_t level;
     void *ptr;
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    struct rt_heap_cache *cache;
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
+#ifdef RT_USING_HEAP_POOL
+    /* small blocks are served by the fixed-size pools */
+    if (size != 0 && size <= _heap_pool_max_size)
+    {
+        ptr = _heap_pool_alloc(size);
+        if (ptr != RT_NULL)
+        {
+            _HEAP_PROFILE_ALLOC(ptr);
+            /* call 'rt_malloc' hook */
+            RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+            return ptr;
+        }
+    }
+#endif /* RT_USING_HEAP_POOL */
+
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    /* small blocks are served by the thread local cache */
+    if (size != 0 && size <= RT_HEAP_CACHE_MAX_SIZE &&
+        (cache = _heap_cache_get()) != RT_NULL)
+    {
+        ptr = _heap_cache_alloc(cache, size);
+        _HEAP_PROFILE_ALLOC(ptr);
+        /* call 'rt_malloc' hook */
+        RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
+        return ptr;
+    }
+#endif /* RT_USING_HEAP_THREAD_CACHE */
 
     /* Enter critical zone */
     level = _heap_lock();
@@ -1511,6 +1941,7 @@ RT_WEAK void *rt_malloc(rt_size_t size)
     ptr = _MEM_MALLOC(size);
     /* Exit critical zone */
     _heap_unlock(level);
+    _HEAP_PROFILE_ALLOC(ptr);
     /* call 'rt_malloc' hook */
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
     return ptr;
@@ -1530,13 +1961,50 @@ RT_WEAK void *rt_realloc(void *rmem, rt_size_t newsize)
 {
     rt_base_t level;
     void *nptr;
+#ifdef RT_USING_HEAP_POOL
+    struct rt_heap_pool *pool;
 
+    pool = rmem ? _heap_pool_of(rmem) : RT_NULL;
+    if (pool != RT_NULL)
+    {
+        if (newsize == 0)
+        {
+            rt_free(rmem);
+            return RT_NULL;
+        }
+        /* the block is large enough */
+        if (newsize <= pool->mp.block_size)
+            return rmem;
+
+        nptr = rt_malloc(newsize);
+        if (nptr != RT_NULL)
+        {
+            rt_memcpy(nptr, rmem, pool->mp.block_size);
+            rt_free(rmem);
+        }
+        return nptr;
+    }
+#endif /* RT_USING_HEAP_POOL */
+
+    if (rmem != RT_NULL)
+    {
+        _HEAP_PROFILE_FREE(rmem);
+    }
     /* Enter critical zone */
     level = _heap_lock();
     /* Change the size of previously allocated memory block */
     nptr = _MEM_REALLOC(rmem, newsize);
     /* Exit critical zone */
     _heap_unlock(level);
+    if (nptr != RT_NULL)
+    {
+        _HEAP_PROFILE_ALLOC(nptr);
+    }
+    else if (rmem != RT_NULL && newsize != 0)
+    {
+        /* the block is left unchanged */
+        _HEAP_PROFILE_ALLOC(rmem);
+    }
     return nptr;
 }
 RTM_EXPORT(rt_realloc);
@@ -1578,11 +2046,29 @@ RTM_EXPORT(rt_calloc);
 RT_WEAK void rt_free(void *rmem)
 {
     rt_base_t level;
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    struct rt_heap_cache *cache;
+#endif /* RT_USING_HEAP_THREAD_CACHE */
 
     /* call 'rt_free' hook */
     RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
     /* NULL check */
     if (rmem == RT_NULL) return;
+    _HEAP_PROFILE_FREE(rmem);
+#ifdef RT_USING_HEAP_POOL
+    /* give the block back to its pool */
+    if (_heap_pool_of(rmem) != RT_NULL)
+    {
+        rt_mp_free(rmem);
+        return;
+    }
+#endif /* RT_USING_HEAP_POOL */
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    /* keep small blocks in the thread local cache */
+    cache = _heap_cache_get();
+    if (cache != RT_NULL && _heap_cache_free(cache, rmem))
+        return;
+#endif /* RT_USING_HEAP_THREAD_CACHE */
     /* Enter critical zone */
     level = _heap_lock();
     _MEM_FREE(rmem);
@@ -559,6 +559,26 @@ void rt_smem_free(void *rmem)
 }
 RTM_EXPORT(rt_smem_free);
 
+/**
+ * @brief This function will get the usable size of the allocated memory block.
+ *
+ * @param rmem the address of memory allocated by rt_smem_alloc.
+ *
+ * @return the number of bytes which can be used in the memory block.
+ */
+rt_size_t rt_smem_usable_size(void *rmem)
+{
+    struct rt_small_mem_item *mem;
+
+    RT_ASSERT(rmem != RT_NULL);
+
+    mem = (struct rt_small_mem_item *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    RT_ASSERT(MEM_ISUSED(mem));
+
+    return MEM_SIZE(MEM_POOL(mem), mem);
+}
+RTM_EXPORT(rt_smem_usable_size);
+
 #ifdef RT_USING_FINSH
 #include <finsh.h>
 
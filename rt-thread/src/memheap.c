@@ -724,6 +724,26 @@ void rt_memheap_free(void *ptr)
 }
 RTM_EXPORT(rt_memheap_free);
 
+/**
+ * @brief This function will get the usable size of the allocated memory block.
+ *
+ * @param ptr the address of memory allocated by rt_memheap_alloc.
+ *
+ * @return the number of bytes which can be used in the memory block.
+ */
+rt_size_t rt_memheap_usable_size(void *ptr)
+{
+    struct rt_memheap_item *header_ptr;
+
+    RT_ASSERT(ptr != RT_NULL);
+
+    header_ptr = MEMITEM(ptr);
+    RT_ASSERT(header_ptr->magic == (RT_MEMHEAP_MAGIC | RT_MEMHEAP_USED));
+
+    return MEMITEM_SIZE(header_ptr);
+}
+RTM_EXPORT(rt_memheap_usable_size);
+
 /**
 * @brief This function will caculate the total memory, the used memory, and
 *        the max used memory.
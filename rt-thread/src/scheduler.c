@@ -75,6 +75,16 @@ void rt_scheduler_sethook(void (*hook)(struct rt_thread *from, struct rt_thread
     rt_scheduler_hook = hook;
 }
 
+/**
+ * @brief This function will get the hook function set by rt_scheduler_sethook().
+ *
+ * @return the hook function, RT_NULL if there is none.
+ */
+void (*rt_scheduler_gethook(void))(struct rt_thread *from, struct rt_thread *to)
+{
+    return rt_scheduler_hook;
+}
+
 /**
  * @brief This function will set a hook function, which will be invoked when context
  *        switch happens.
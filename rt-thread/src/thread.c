@@ -32,6 +32,7 @@
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to thread.c
  * 2022-01-24     THEWON       let rt_thread_sleep return thread->error when using signal
  * 2022-10-15     Bernard      add nested mutex feature
+ * 2026-10-16     RT-Thread    call resume hook when a thread is woken up by timeout
  */
 
 #include <rthw.h>
@@ -86,6 +87,26 @@ void rt_thread_inited_sethook(void (*hook)(rt_thread_t thread))
 {
     rt_thread_inited_hook = hook;
 }
+
+/**
+ * @brief   This function gets the hook function set by rt_thread_resume_sethook().
+ *
+ * @return  the hook function, RT_NULL if there is none.
+ */
+void (*rt_thread_resume_gethook(void))(rt_thread_t thread)
+{
+    return rt_thread_resume_hook;
+}
+
+/**
+ * @brief   This function gets the hook function set by rt_thread_inited_sethook().
+ *
+ * @return  the hook function, RT_NULL if there is none.
+ */
+void (*rt_thread_inited_gethook(void))(rt_thread_t thread)
+{
+    return rt_thread_inited_hook;
+}
 #endif /* defined(RT_USING_HOOK) && defined(RT_HOOK_USING_FUNC_PTR) */
 
 static void _thread_exit(void)
@@ -148,6 +169,8 @@ static void _thread_timeout(void *parameter)
     /* insert to schedule ready list */
     rt_schedule_insert_thread(thread);
 
+    RT_OBJECT_HOOK_CALL(rt_thread_resume_hook, (thread));
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -227,6 +250,10 @@ static rt_err_t _thread_init(struct rt_thread *thread,
     thread->critical_lock_nest = 0;
 #endif /* RT_USING_SMP */
 
+#ifdef RT_USING_HEAP_THREAD_CACHE
+    rt_memset(&thread->heap_cache, 0, sizeof(thread->heap_cache));
+#endif /* RT_USING_HEAP_THREAD_CACHE */
+
     /* initialize cleanup function and user data */
     thread->cleanup   = 0;
     thread->user_data = 0;
@@ -19,13 +19,47 @@
  * 2021-08-15     supperthomas add the comment
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to timer.c
  * 2022-04-19     Stanley      Correct descriptions
+ * 2026-10-16     RT-Thread    add hierarchical timing wheel backend
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_USING_TIMER_WHEEL
+/*
+ * Hierarchical timing wheel. Level n has TIMER_WHEEL_SLOTS slots of
+ * 2^(n * TIMER_WHEEL_BITS) ticks each, a timer is hashed into the level
+ * which covers its remaining ticks. Level 0 slots are expired tick by tick,
+ * the slot of level n is cascaded into the lower levels when the index of
+ * level n - 1 wraps around, so start/stop are O(1). A cascaded slot is
+ * hashed again TIMER_WHEEL_BATCH timers at a time, so the interrupts are
+ * not disabled for a time growing with the number of timers.
+ */
+#define TIMER_WHEEL_BITS        5
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK        (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVEL       ((sizeof(rt_tick_t) * 8 + TIMER_WHEEL_BITS - 1) / TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_BATCH       32
+
+struct _timer_wheel
+{
+    rt_tick_t   current;                                        /**< the next tick to be expired */
+    rt_uint32_t bitmap[TIMER_WHEEL_LEVEL];                      /**< non-empty slots, may be stale */
+    rt_list_t   slot[TIMER_WHEEL_LEVEL][TIMER_WHEEL_SLOTS];
+    rt_list_t   cascade;                                        /**< cascaded timers to be hashed again */
+    rt_list_t   expired;                                        /**< expired timers to be invoked */
+};
+typedef struct _timer_wheel *_timer_head_t;
+
+/* hard timer wheel */
+static struct _timer_wheel _timer_wheel;
+#define _timer_list (&_timer_wheel)
+#else
+typedef rt_list_t *_timer_head_t;
+
 /* hard timer list */
 static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 
 #ifdef RT_USING_TIMER_SOFT
 
@@ -42,8 +76,14 @@ static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 
 /* soft timer status */
 static rt_uint8_t _soft_timer_status = RT_SOFT_TIMER_IDLE;
+#ifdef RT_USING_TIMER_WHEEL
+/* soft timer wheel */
+static struct _timer_wheel _soft_timer_wheel;
+#define _soft_timer_list (&_soft_timer_wheel)
+#else
 /* soft timer list */
 static rt_list_t _soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 static struct rt_thread _timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t _timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -144,6 +184,417 @@ static void _timer_init(rt_timer_t timer,
     }
 }
 
+#ifdef RT_USING_TIMER_WHEEL
+/**
+ * @brief Initialize the timer wheel
+ *
+ * @param wheel is the timer wheel
+ */
+static void _timer_wheel_init(struct _timer_wheel *wheel)
+{
+    int lvl, idx;
+
+    wheel->current = rt_tick_get();
+    for (lvl = 0; lvl < TIMER_WHEEL_LEVEL; lvl++)
+    {
+        wheel->bitmap[lvl] = 0;
+        for (idx = 0; idx < TIMER_WHEEL_SLOTS; idx++)
+        {
+            rt_list_init(&wheel->slot[lvl][idx]);
+        }
+    }
+    rt_list_init(&wheel->cascade);
+    rt_list_init(&wheel->expired);
+}
+
+/**
+ * @brief Hash the timer into the slot which covers its timeout tick
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param timer is the timer to be inserted
+ */
+static void _timer_insert(struct _timer_wheel *wheel, rt_timer_t timer)
+{
+    int lvl, idx;
+    rt_tick_t tick, delta;
+
+    tick  = timer->timeout_tick;
+    delta = tick - wheel->current;
+    if (delta >= RT_TICK_MAX / 2)
+    {
+        /* already timeout, expire it on the next check */
+        tick  = wheel->current;
+        delta = 0;
+    }
+
+    for (lvl = 0; lvl < TIMER_WHEEL_LEVEL - 1; lvl++)
+    {
+        if ((delta >> (TIMER_WHEEL_BITS * (lvl + 1))) == 0)
+            break;
+    }
+    idx = (tick >> (TIMER_WHEEL_BITS * lvl)) & TIMER_WHEEL_MASK;
+
+    /* the timers with the same timeout are invoked in the order they were started */
+    rt_list_insert_before(&wheel->slot[lvl][idx], &(timer->row[0]));
+    wheel->bitmap[lvl] |= (1u << idx);
+}
+
+/**
+ * @brief Move all timers of a slot to the tail of the list
+ */
+rt_inline void _timer_wheel_move(struct _timer_wheel *wheel, int lvl, int idx, rt_list_t *list)
+{
+    rt_list_t *head = &wheel->slot[lvl][idx];
+
+    if (!rt_list_isempty(head))
+    {
+        head->next->prev = list->prev;
+        list->prev->next = head->next;
+        head->prev->next = list;
+        list->prev = head->prev;
+        rt_list_init(head);
+    }
+    wheel->bitmap[lvl] &= ~(1u << idx);
+}
+
+/**
+ * @brief Find the first non-empty slot of a level
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param lvl is the level of timer wheel
+ *
+ * @return the distance in slots from the current slot of the level, -1 if the level is empty.
+ *         The current slot is handled at the current tick only if the tick
+ *         is on the boundary of the level, otherwise it has been cascaded
+ *         and will be handled after a full round.
+ */
+static int _timer_wheel_first(struct _timer_wheel *wheel, int lvl)
+{
+    int idx, offset;
+    rt_uint32_t map;
+    rt_bool_t boundary;
+
+    idx = (wheel->current >> (TIMER_WHEEL_BITS * lvl)) & TIMER_WHEEL_MASK;
+    boundary = (wheel->current & ((1u << (TIMER_WHEEL_BITS * lvl)) - 1)) == 0;
+    while (wheel->bitmap[lvl])
+    {
+        /* rotate the current slot to bit 0 */
+        map = wheel->bitmap[lvl];
+        if (idx != 0)
+        {
+            map = (map >> idx) | (map << (TIMER_WHEEL_SLOTS - idx));
+        }
+
+        if (boundary)
+            offset = __rt_ffs(map) - 1;
+        else if (map & ~1u)
+            offset = __rt_ffs(map & ~1u) - 1;
+        else
+            offset = TIMER_WHEEL_SLOTS;
+
+        if (!rt_list_isempty(&wheel->slot[lvl][(idx + offset) & TIMER_WHEEL_MASK]))
+        {
+            return offset;
+        }
+        /* clear the stale bit left by timer stop */
+        wheel->bitmap[lvl] &= ~(1u << ((idx + offset) & TIMER_WHEEL_MASK));
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Find the next tick when the timer wheel has to do something
+ *
+ * @note   The timers in the upper levels are not sorted, the tick they are
+ *         cascaded at is taken instead, so the result may be earlier than
+ *         the real timeout but never later.
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param next_tick is the next tick to expire or cascade
+ *
+ * @return RT_EOK if there is any timer in the wheel, otherwise -RT_ERROR.
+ */
+static rt_err_t _timer_wheel_next(struct _timer_wheel *wheel, rt_tick_t *next_tick)
+{
+    int lvl, offset;
+    rt_tick_t tick, next = 0;
+    rt_bool_t found = RT_FALSE;
+
+    for (lvl = 0; lvl < TIMER_WHEEL_LEVEL; lvl++)
+    {
+        offset = _timer_wheel_first(wheel, lvl);
+        if (offset < 0)
+            continue;
+
+        tick = ((wheel->current >> (TIMER_WHEEL_BITS * lvl)) + offset) << (TIMER_WHEEL_BITS * lvl);
+
+        if (!found || (tick - wheel->current) < (next - wheel->current))
+        {
+            next = tick;
+            found = RT_TRUE;
+        }
+    }
+
+    *next_tick = next;
+
+    return found ? RT_EOK : -RT_ERROR;
+}
+
+/**
+ * @brief Move the current tick of an empty timer wheel to the tick
+ *
+ * @note  A wheel is only advanced when it is checked, the soft timer wheel
+ *        or a tickless idle may leave it behind for RT_TICK_MAX / 2 ticks or
+ *        more, and the timeout ticks could not be compared with it any more.
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param current_tick is the current tick
+ */
+rt_inline void _timer_wheel_sync(struct _timer_wheel *wheel, rt_tick_t current_tick)
+{
+    rt_tick_t next;
+
+    if (rt_list_isempty(&wheel->expired) && rt_list_isempty(&wheel->cascade) &&
+        _timer_wheel_next(wheel, &next) != RT_EOK)
+    {
+        wheel->current = current_tick;
+    }
+}
+
+/**
+ * @brief Advance the timer wheel to the tick, the timeout timers are
+ *        moved to the expired list of the wheel.
+ *
+ * @note  The ticks without anything to do are skipped, so the cost does
+ *        not depend on how long the wheel has not been advanced. At most
+ *        TIMER_WHEEL_BATCH cascaded timers are hashed again in one call,
+ *        the caller shall enable the interrupts for a while and call it
+ *        again until it returns RT_TRUE.
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param current_tick is the current tick
+ *
+ * @return RT_TRUE if the wheel is advanced to the tick, RT_FALSE if there
+ *         are cascaded timers left to hash.
+ */
+static rt_bool_t _timer_wheel_advance(struct _timer_wheel *wheel, rt_tick_t current_tick)
+{
+    int lvl, idx, count = 0;
+    rt_tick_t next;
+
+    _timer_wheel_sync(wheel, current_tick);
+    while ((current_tick - wheel->current) < RT_TICK_MAX / 2)
+    {
+        idx = wheel->current & TIMER_WHEEL_MASK;
+        if (idx == 0)
+        {
+            /* cascade the upper levels whose lower index wraps around */
+            for (lvl = 1; lvl < TIMER_WHEEL_LEVEL; lvl++)
+            {
+                int lidx = (wheel->current >> (TIMER_WHEEL_BITS * lvl)) & TIMER_WHEEL_MASK;
+
+                if (wheel->bitmap[lvl] & (1u << lidx))
+                {
+                    _timer_wheel_move(wheel, lvl, lidx, &wheel->cascade);
+                }
+                if (lidx != 0)
+                    break;
+            }
+        }
+
+        /* the cascaded timers go to the lower levels, none of them back to the slots above */
+        while (!rt_list_isempty(&wheel->cascade))
+        {
+            struct rt_timer *t = rt_list_entry(wheel->cascade.next, struct rt_timer, row[0]);
+
+            if (count++ == TIMER_WHEEL_BATCH)
+                return RT_FALSE;
+            rt_list_remove(&(t->row[0]));
+            _timer_insert(wheel, t);
+        }
+
+        if (wheel->bitmap[0] & (1u << idx))
+        {
+            _timer_wheel_move(wheel, 0, idx, &wheel->expired);
+        }
+        wheel->current ++;
+
+        if ((current_tick - wheel->current) >= RT_TICK_MAX / 2)
+            break;
+
+        /* skip the ticks without anything to do */
+        if (_timer_wheel_next(wheel, &next) != RT_EOK ||
+            (next - wheel->current) > (current_tick - wheel->current))
+        {
+            wheel->current = current_tick + 1;
+        }
+        else
+        {
+            wheel->current = next;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief Get the first expired timer
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the expired timer, RT_NULL if there is none
+ */
+rt_inline struct rt_timer *_timer_expired(struct _timer_wheel *wheel, rt_tick_t current_tick)
+{
+    if (rt_list_isempty(&wheel->expired))
+    {
+        return RT_NULL;
+    }
+
+    return rt_list_entry(wheel->expired.next, struct rt_timer, row[0]);
+}
+
+/**
+ * @brief  Find the next timeout tick of timer wheel
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param timeout_tick is the next timer's ticks
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ *          If the return value is any other values, it means this operation failed.
+ */
+static rt_err_t _timer_list_next_timeout(struct _timer_wheel *wheel, rt_tick_t *timeout_tick)
+{
+    rt_err_t result;
+    rt_base_t level;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    if (!rt_list_isempty(&wheel->expired) || !rt_list_isempty(&wheel->cascade))
+    {
+        *timeout_tick = wheel->current - 1;
+        result = RT_EOK;
+    }
+    else
+    {
+        result = _timer_wheel_next(wheel, timeout_tick);
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+#else
+/**
+ * @brief Insert the timer to the skip list ordered by timeout tick
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param timer is the timer to be inserted
+ */
+static void _timer_insert(rt_list_t timer_list[], rt_timer_t timer)
+{
+    unsigned int row_lvl;
+    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
+    unsigned int tst_nr;
+    static unsigned int random_nr;
+
+    row_head[0]  = &timer_list[0];
+    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
+             row_head[row_lvl]  = row_head[row_lvl]->next)
+        {
+            struct rt_timer *t;
+            rt_list_t *p = row_head[row_lvl]->next;
+
+            /* fix up the entry pointer */
+            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
+
+            /* If we have two timers that timeout at the same time, it's
+             * preferred that the timer inserted early get called early.
+             * So insert the new timer to the end the the some-timeout timer
+             * list.
+             */
+            if ((t->timeout_tick - timer->timeout_tick) == 0)
+            {
+                continue;
+            }
+            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
+            {
+                break;
+            }
+        }
+        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
+            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
+    }
+
+    /* Interestingly, this super simple timer insert counter works very very
+     * well on distributing the list height uniformly. By means of "very very
+     * well", I mean it beats the randomness of timer->timeout_tick very easily
+     * (actually, the timeout_tick is not random and easy to be attacked). */
+    random_nr++;
+    tst_nr = random_nr;
+
+    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
+                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
+            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
+                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
+        else
+            break;
+        /* Shift over the bits we have tested. Works well with 1 bit and 2
+         * bits. */
+        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+    }
+}
+
+/**
+ * @brief Get the first timer of the list if it is timeout
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the expired timer, RT_NULL if there is none
+ */
+rt_inline struct rt_timer *_timer_expired(rt_list_t timer_list[], rt_tick_t current_tick)
+{
+    struct rt_timer *t;
+
+    if (rt_list_isempty(&timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    {
+        return RT_NULL;
+    }
+
+    t = rt_list_entry(timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+                      struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+    /*
+     * It supposes that the new tick shall less than the half duration of
+     * tick max.
+     */
+    if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+    {
+        return t;
+    }
+
+    return RT_NULL;
+}
+
 /**
  * @brief  Find the next emtpy timer ticks
  *
@@ -180,6 +631,8 @@ static rt_err_t _timer_list_next_timeout(rt_list_t timer_list[], rt_tick_t *time
     return -RT_ERROR;
 }
 
+#endif /* RT_USING_TIMER_WHEEL */
+
 /**
  * @brief Remove the timer
  *
@@ -195,7 +648,7 @@ rt_inline void _timer_remove(rt_timer_t timer)
     }
 }
 
-#if RT_DEBUG_TIMER
+#if RT_DEBUG_TIMER && !defined(RT_USING_TIMER_WHEEL)
 /**
  * @brief The number of timer
  *
@@ -234,7 +687,7 @@ void rt_timer_dump(rt_list_t timer_heads[])
     }
     rt_kprintf("\n");
 }
-#endif /* RT_DEBUG_TIMER */
+#endif /* RT_DEBUG_TIMER && !defined(RT_USING_TIMER_WHEEL) */
 
 /**
  * @addtogroup Clock
@@ -406,13 +859,9 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
-    unsigned int row_lvl;
-    rt_list_t *timer_list;
+    _timer_head_t timer_list;
     rt_base_t level;
     rt_bool_t need_schedule;
-    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
-    unsigned int tst_nr;
-    static unsigned int random_nr;
 
     /* parameter check */
     RT_ASSERT(timer != RT_NULL);
@@ -444,56 +893,10 @@ rt_err_t rt_timer_start(rt_timer_t timer)
         timer_list = _timer_list;
     }
 
-    row_head[0]  = &timer_list[0];
-    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
-             row_head[row_lvl]  = row_head[row_lvl]->next)
-        {
-            struct rt_timer *t;
-            rt_list_t *p = row_head[row_lvl]->next;
-
-            /* fix up the entry pointer */
-            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
-
-            /* If we have two timers that timeout at the same time, it's
-             * preferred that the timer inserted early get called early.
-             * So insert the new timer to the end the the some-timeout timer
-             * list.
-             */
-            if ((t->timeout_tick - timer->timeout_tick) == 0)
-            {
-                continue;
-            }
-            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
-            {
-                break;
-            }
-        }
-        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
-            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
-    }
-
-    /* Interestingly, this super simple timer insert counter works very very
-     * well on distributing the list height uniformly. By means of "very very
-     * well", I mean it beats the randomness of timer->timeout_tick very easily
-     * (actually, the timeout_tick is not random and easy to be attacked). */
-    random_nr++;
-    tst_nr = random_nr;
-
-    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
-                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
-            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
-                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
-        else
-            break;
-        /* Shift over the bits we have tested. Works well with 1 bit and 2
-         * bits. */
-        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
-    }
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_sync(timer_list, rt_tick_get());
+#endif /* RT_USING_TIMER_WHEEL */
+    _timer_insert(timer_list, timer);
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
@@ -642,51 +1045,55 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+#ifdef RT_USING_TIMER_WHEEL
+    /* collect all timeout timers, let the interrupts in between the batches of cascade */
+    while (!_timer_wheel_advance(&_timer_wheel, current_tick))
+    {
+        rt_hw_interrupt_enable(level);
+        level = rt_hw_interrupt_disable();
+    }
+#endif /* RT_USING_TIMER_WHEEL */
+
+    while ((t = _timer_expired(_timer_list, current_tick)) != RT_NULL)
     {
-        t = rt_list_entry(_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                          struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
         {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* re-get tick */
-            current_tick = rt_tick_get();
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
 
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
-            rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
+        /* re-get tick */
+        current_tick = rt_tick_get();
+
+        /* Check whether the timer object is detached or started again */
+        if (rt_list_isempty(&list))
+        {
+            continue;
+        }
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
         }
-        else break;
     }
 
     /* enable interrupt */
@@ -726,59 +1133,59 @@ void rt_soft_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    current_tick = rt_tick_get();
+#ifdef RT_USING_TIMER_WHEEL
+    /* collect all timeout timers, let the interrupts in between the batches of cascade */
+    while (!_timer_wheel_advance(&_soft_timer_wheel, current_tick))
     {
-        t = rt_list_entry(_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                            struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+        rt_hw_interrupt_enable(level);
+        level = rt_hw_interrupt_disable();
+    }
+#endif /* RT_USING_TIMER_WHEEL */
 
-        current_tick = rt_tick_get();
+    while ((t = _timer_expired(_soft_timer_list, current_tick)) != RT_NULL)
+    {
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
         {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        _soft_timer_status = RT_SOFT_TIMER_BUSY;
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-            _soft_timer_status = RT_SOFT_TIMER_BUSY;
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
 
-            /* disable interrupt */
-            level = rt_hw_interrupt_disable();
+        /* re-get tick */
+        current_tick = rt_tick_get();
 
-            _soft_timer_status = RT_SOFT_TIMER_IDLE;
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
-            rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
+        _soft_timer_status = RT_SOFT_TIMER_IDLE;
+        /* Check whether the timer object is detached or started again */
+        if (rt_list_isempty(&list))
+        {
+            continue;
+        }
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
         }
-        else break; /* not check anymore */
     }
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -832,12 +1239,16 @@ static void _timer_thread_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_init(&_timer_wheel);
+#else
     rt_size_t i;
 
     for (i = 0; i < sizeof(_timer_list) / sizeof(_timer_list[0]); i++)
     {
         rt_list_init(_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 }
 
 /**
@@ -848,6 +1259,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_init(&_soft_timer_wheel);
+#else
     int i;
 
     for (i = 0;
@@ -856,6 +1270,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(_soft_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 
     /* start software timer thread */
     rt_thread_init(&_timer_thread,
@@ -0,0 +1,765 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * Free blocks are kept in FL x SL segregated lists. The first level splits
+ * the size range into powers of two, the second level splits every power of
+ * two into RT_TLSF_SL_INDEX_COUNT linear classes. Two bitmaps record which
+ * lists are not empty, so both allocation and release are O(1) and do not
+ * depend on the number of blocks in the heap.
+ *
+ * The algorithm follows "TLSF: a New Dynamic Memory Allocator for Real-Time
+ * Systems", M. Masmano, I. Ripoll, A. Crespo, J. Real.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_TLSF)
+
+#ifndef RT_TLSF_SL_INDEX_COUNT_LOG2
+#define RT_TLSF_SL_INDEX_COUNT_LOG2     4
+#endif
+
+#define _TLSF_LOG2(x)   ((x) >= 256 ? 8 : (x) >= 128 ? 7 : (x) >= 64 ? 6 : \
+                         (x) >= 32 ? 5 : (x) >= 16 ? 4 : (x) >= 8 ? 3 : \
+                         (x) >= 4 ? 2 : (x) >= 2 ? 1 : 0)
+
+#define SL_INDEX_COUNT_LOG2     RT_TLSF_SL_INDEX_COUNT_LOG2
+#define SL_INDEX_COUNT          (1 << SL_INDEX_COUNT_LOG2)
+#define ALIGN_SIZE_LOG2         _TLSF_LOG2(RT_ALIGN_SIZE)
+#define FL_INDEX_SHIFT          (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#ifdef ARCH_CPU_64BIT
+#define FL_INDEX_MAX            32
+#else
+#define FL_INDEX_MAX            30
+#endif /* ARCH_CPU_64BIT */
+#define FL_INDEX_COUNT          (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE        (1 << FL_INDEX_SHIFT)
+#define BLOCK_SIZE_MAX          ((rt_size_t)1 << FL_INDEX_MAX)
+
+/**
+ * memory item on the tlsf heap
+ */
+struct rt_tlsf_item
+{
+    rt_ubase_t              pool_ptr;         /**< tlsf object addr and used flag */
+    struct rt_tlsf_item    *prev_phys;        /**< previous physical item */
+    rt_size_t               size;             /**< size of user data */
+    struct rt_tlsf_item    *next_free;        /**< next free item in the same list */
+    struct rt_tlsf_item    *prev_free;        /**< prev free item in the same list */
+#ifdef RT_USING_MEMTRACE
+#ifdef ARCH_CPU_64BIT
+    rt_uint8_t              thread[8];        /**< thread name */
+#else
+    rt_uint8_t              thread[4];        /**< thread name */
+#endif /* ARCH_CPU_64BIT */
+#endif /* RT_USING_MEMTRACE */
+};
+
+/**
+ * Base structure of tlsf memory object
+ */
+struct rt_tlsf
+{
+    struct rt_memory        parent;                         /**< inherit from rt_memory */
+    rt_uint8_t             *heap_ptr;                       /**< pointer to the heap */
+    struct rt_tlsf_item    *heap_end;                       /**< end stub of the heap */
+    rt_size_t               mem_size_aligned;               /**< aligned memory size */
+
+    rt_uint32_t             fl_bitmap;                      /**< first level bitmap */
+    rt_uint32_t             sl_bitmap[FL_INDEX_COUNT];      /**< second level bitmaps */
+    struct rt_tlsf_item    *blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+};
+
+#define MEM_MASK             ((rt_ubase_t)~0x1)
+#define MEM_USED(_pool)      ((((rt_ubase_t)(_pool)) & MEM_MASK) | 0x1)
+#define MEM_FREED(_pool)     ((((rt_ubase_t)(_pool)) & MEM_MASK) | 0x0)
+#define MEM_ISUSED(_mem)     (((_mem)->pool_ptr) & (~MEM_MASK))
+#define MEM_POOL(_mem)       ((struct rt_tlsf *)(((_mem)->pool_ptr) & MEM_MASK))
+
+#ifdef ARCH_CPU_64BIT
+#define MIN_SIZE 24
+#else
+#define MIN_SIZE 12
+#endif /* ARCH_CPU_64BIT */
+
+#define MIN_SIZE_ALIGNED     RT_ALIGN(MIN_SIZE, RT_ALIGN_SIZE)
+#define SIZEOF_STRUCT_MEM    RT_ALIGN(sizeof(struct rt_tlsf_item), RT_ALIGN_SIZE)
+
+#define NEXT_PHYS(_mem)      \
+    ((struct rt_tlsf_item *)((rt_uint8_t *)(_mem) + SIZEOF_STRUCT_MEM + (_mem)->size))
+
+static const char _tlsf_algorithm[] = "tlsf";
+
+#ifdef RT_USING_MEMTRACE
+rt_inline void _tlsf_setname(struct rt_tlsf_item *mem, const char *name)
+{
+    int index;
+    for (index = 0; index < sizeof(mem->thread); index ++)
+    {
+        if (name[index] == '\0') break;
+        mem->thread[index] = name[index];
+    }
+
+    for (; index < sizeof(mem->thread); index ++)
+    {
+        mem->thread[index] = ' ';
+    }
+}
+#endif /* RT_USING_MEMTRACE */
+
+/* find last set bit, the most significant bit is numbered 32 */
+rt_inline int _tlsf_fls(rt_size_t value)
+{
+    int bit = 32;
+
+#ifdef ARCH_CPU_64BIT
+    if (value >> 32)
+        return _tlsf_fls(value >> 32) + 32;
+#endif /* ARCH_CPU_64BIT */
+    if (!value) return 0;
+    if (!(value & 0xffff0000u)) { value <<= 16; bit -= 16; }
+    if (!(value & 0xff000000u)) { value <<= 8;  bit -= 8;  }
+    if (!(value & 0xf0000000u)) { value <<= 4;  bit -= 4;  }
+    if (!(value & 0xc0000000u)) { value <<= 2;  bit -= 2;  }
+    if (!(value & 0x80000000u)) { bit -= 1; }
+
+    return bit;
+}
+
+/* find first set bit, the least significant bit is numbered 0 */
+rt_inline int _tlsf_ffs(rt_uint32_t value)
+{
+    return __rt_ffs((int)value) - 1;
+}
+
+static void _tlsf_mapping_insert(rt_size_t size, int *fli, int *sli)
+{
+    int fl, sl;
+
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        /* small blocks are stored linearly in the first list */
+        fl = 0;
+        sl = (int)(size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT));
+    }
+    else
+    {
+        fl = _tlsf_fls(size) - 1;
+        sl = (int)(size >> (fl - SL_INDEX_COUNT_LOG2)) ^ (1 << SL_INDEX_COUNT_LOG2);
+        fl -= (FL_INDEX_SHIFT - 1);
+    }
+
+    *fli = fl;
+    *sli = sl;
+}
+
+static void _tlsf_mapping_search(rt_size_t size, int *fli, int *sli)
+{
+    /* round up to the next list so that any block found there is large enough */
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        rt_size_t round = (1 << (_tlsf_fls(size) - 1 - SL_INDEX_COUNT_LOG2)) - 1;
+        size += round;
+    }
+    _tlsf_mapping_insert(size, fli, sli);
+}
+
+static struct rt_tlsf_item *_tlsf_search_suitable(struct rt_tlsf *tlsf, int *fli, int *sli)
+{
+    int fl = *fli;
+    int sl = *sli;
+    rt_uint32_t sl_map, fl_map;
+
+    if (fl >= FL_INDEX_COUNT)
+        return RT_NULL;
+
+    /* search for a non-empty list in the same first level */
+    sl_map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map)
+    {
+        /* no block in this first level, search in the next ones */
+        if (fl + 1 >= FL_INDEX_COUNT)
+            return RT_NULL;
+        fl_map = tlsf->fl_bitmap & (~0u << (fl + 1));
+        if (!fl_map)
+            return RT_NULL;
+
+        fl = _tlsf_ffs(fl_map);
+        *fli = fl;
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    RT_ASSERT(sl_map != 0);
+    sl = _tlsf_ffs(sl_map);
+    *sli = sl;
+
+    return tlsf->blocks[fl][sl];
+}
+
+static void _tlsf_remove_free(struct rt_tlsf *tlsf, struct rt_tlsf_item *mem)
+{
+    int fl, sl;
+
+    _tlsf_mapping_insert(mem->size, &fl, &sl);
+
+    if (mem->next_free)
+        mem->next_free->prev_free = mem->prev_free;
+    if (mem->prev_free)
+        mem->prev_free->next_free = mem->next_free;
+
+    if (tlsf->blocks[fl][sl] == mem)
+    {
+        tlsf->blocks[fl][sl] = mem->next_free;
+        if (mem->next_free == RT_NULL)
+        {
+            /* the list is empty now, clear the bitmaps */
+            tlsf->sl_bitmap[fl] &= ~(1u << sl);
+            if (!tlsf->sl_bitmap[fl])
+                tlsf->fl_bitmap &= ~(1u << fl);
+        }
+    }
+    mem->next_free = mem->prev_free = RT_NULL;
+}
+
+static void _tlsf_insert_free(struct rt_tlsf *tlsf, struct rt_tlsf_item *mem)
+{
+    int fl, sl;
+
+    _tlsf_mapping_insert(mem->size, &fl, &sl);
+    RT_ASSERT(fl < FL_INDEX_COUNT);
+
+    mem->prev_free = RT_NULL;
+    mem->next_free = tlsf->blocks[fl][sl];
+    if (mem->next_free)
+        mem->next_free->prev_free = mem;
+    tlsf->blocks[fl][sl] = mem;
+
+    tlsf->fl_bitmap |= (1u << fl);
+    tlsf->sl_bitmap[fl] |= (1u << sl);
+}
+
+/* merge the free item with its free physical neighbours and return the result */
+static struct rt_tlsf_item *_tlsf_merge(struct rt_tlsf *tlsf, struct rt_tlsf_item *mem)
+{
+    struct rt_tlsf_item *prev, *next;
+
+    /* merge with the next physical item */
+    next = NEXT_PHYS(mem);
+    if (!MEM_ISUSED(next))
+    {
+        _tlsf_remove_free(tlsf, next);
+        mem->size += SIZEOF_STRUCT_MEM + next->size;
+        next->pool_ptr = 0;
+        NEXT_PHYS(mem)->prev_phys = mem;
+    }
+
+    /* merge with the previous physical item */
+    prev = mem->prev_phys;
+    if (prev != RT_NULL && !MEM_ISUSED(prev))
+    {
+        _tlsf_remove_free(tlsf, prev);
+        prev->size += SIZEOF_STRUCT_MEM + mem->size;
+        mem->pool_ptr = 0;
+        mem = prev;
+        NEXT_PHYS(mem)->prev_phys = mem;
+    }
+
+    return mem;
+}
+
+/* split the used item to 'size' and give the remainder back to the free lists */
+static void _tlsf_trim(struct rt_tlsf *tlsf, struct rt_tlsf_item *mem, rt_size_t size)
+{
+    struct rt_tlsf_item *mem2;
+
+    if (mem->size < size + SIZEOF_STRUCT_MEM + MIN_SIZE_ALIGNED)
+        return;
+
+    mem2 = (struct rt_tlsf_item *)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM + size);
+    mem2->pool_ptr = MEM_FREED(tlsf);
+    mem2->prev_phys = mem;
+    mem2->size = mem->size - size - SIZEOF_STRUCT_MEM;
+#ifdef RT_USING_MEMTRACE
+    _tlsf_setname(mem2, "    ");
+#endif /* RT_USING_MEMTRACE */
+    NEXT_PHYS(mem2)->prev_phys = mem2;
+
+    tlsf->parent.used -= mem->size - size;
+    mem->size = size;
+
+    mem2 = _tlsf_merge(tlsf, mem2);
+    _tlsf_insert_free(tlsf, mem2);
+}
+
+/**
+ * @brief This function will initialize tlsf memory management algorithm.
+ *
+ * @note  The control structure, free list heads and bitmaps are placed at the
+ *        beginning of the memory, the rest is managed as the heap.
+ *
+ * @param name is the name of the tlsf memory management object.
+ *
+ * @param begin_addr the beginning address of memory.
+ *
+ * @param size is the size of the memory.
+ *
+ * @return Return a pointer to the memory object. When the return value is RT_NULL, it means the init failed.
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf_item *mem;
+    struct rt_tlsf *tlsf;
+    rt_ubase_t start_addr, begin_align, end_align, mem_size;
+
+    tlsf = (struct rt_tlsf *)RT_ALIGN((rt_ubase_t)begin_addr, RT_ALIGN_SIZE);
+    start_addr = (rt_ubase_t)tlsf + sizeof(*tlsf);
+    begin_align = RT_ALIGN((rt_ubase_t)start_addr, RT_ALIGN_SIZE);
+    end_align   = RT_ALIGN_DOWN((rt_ubase_t)begin_addr + size, RT_ALIGN_SIZE);
+
+    /* alignment addr */
+    if ((end_align > (2 * SIZEOF_STRUCT_MEM)) &&
+        ((end_align - 2 * SIZEOF_STRUCT_MEM) >= begin_align + MIN_SIZE_ALIGNED))
+    {
+        /* calculate the aligned memory size */
+        mem_size = end_align - begin_align - 2 * SIZEOF_STRUCT_MEM;
+        if (mem_size >= BLOCK_SIZE_MAX)
+            mem_size = RT_ALIGN_DOWN(BLOCK_SIZE_MAX - 1, RT_ALIGN_SIZE);
+    }
+    else
+    {
+        rt_kprintf("tlsf init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)begin_addr + size);
+
+        return RT_NULL;
+    }
+
+    rt_memset(tlsf, 0, sizeof(*tlsf));
+    /* initialize tlsf memory object */
+    rt_object_init(&(tlsf->parent.parent), RT_Object_Class_Memory, name);
+    tlsf->parent.algorithm = _tlsf_algorithm;
+    tlsf->parent.address = begin_align;
+    tlsf->parent.total = mem_size;
+    tlsf->mem_size_aligned = mem_size;
+
+    /* point to begin address of heap */
+    tlsf->heap_ptr = (rt_uint8_t *)begin_align;
+
+    RT_DEBUG_LOG(RT_DEBUG_TLSF, ("tlsf init, heap begin address 0x%x, size %d\n",
+                                 (rt_ubase_t)tlsf->heap_ptr, tlsf->mem_size_aligned));
+
+    /* initialize the whole free block */
+    mem = (struct rt_tlsf_item *)tlsf->heap_ptr;
+    mem->pool_ptr = MEM_FREED(tlsf);
+    mem->prev_phys = RT_NULL;
+    mem->size = mem_size;
+#ifdef RT_USING_MEMTRACE
+    _tlsf_setname(mem, "INIT");
+#endif /* RT_USING_MEMTRACE */
+
+    /* initialize the end of the heap, it is always used */
+    tlsf->heap_end = NEXT_PHYS(mem);
+    tlsf->heap_end->pool_ptr = MEM_USED(tlsf);
+    tlsf->heap_end->prev_phys = mem;
+    tlsf->heap_end->size = 0;
+    tlsf->heap_end->next_free = tlsf->heap_end->prev_free = RT_NULL;
+#ifdef RT_USING_MEMTRACE
+    _tlsf_setname(tlsf->heap_end, "INIT");
+#endif /* RT_USING_MEMTRACE */
+
+    _tlsf_insert_free(tlsf, mem);
+
+    return &tlsf->parent;
+}
+RTM_EXPORT(rt_tlsf_init);
+
+/**
+ * @brief This function will remove a tlsf memory object from the system.
+ *
+ * @param m the tlsf memory management object.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_tlsf_detach(rt_tlsf_t m)
+{
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    rt_object_detach(&(m->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_tlsf_detach);
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param m the tlsf memory management object.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size)
+{
+    int fl, sl;
+    struct rt_tlsf_item *mem;
+    struct rt_tlsf *tlsf;
+
+    if (size == 0)
+        return RT_NULL;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    /* alignment size */
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+
+    /* every data block must be at least MIN_SIZE_ALIGNED long */
+    if (size < MIN_SIZE_ALIGNED)
+        size = MIN_SIZE_ALIGNED;
+
+    if (size > tlsf->mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_TLSF, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    _tlsf_mapping_search(size, &fl, &sl);
+    mem = _tlsf_search_suitable(tlsf, &fl, &sl);
+    if (mem == RT_NULL)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_TLSF, ("no memory for size %d\n", size));
+
+        return RT_NULL;
+    }
+    RT_ASSERT(!MEM_ISUSED(mem));
+    RT_ASSERT(mem->size >= size);
+
+    _tlsf_remove_free(tlsf, mem);
+    mem->pool_ptr = MEM_USED(tlsf);
+    tlsf->parent.used += mem->size + SIZEOF_STRUCT_MEM;
+    /* give back the tail which is not needed */
+    _tlsf_trim(tlsf, mem, size);
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+#ifdef RT_USING_MEMTRACE
+    if (rt_thread_self())
+        _tlsf_setname(mem, rt_thread_self()->name);
+    else
+        _tlsf_setname(mem, "NONE");
+#endif /* RT_USING_MEMTRACE */
+
+    RT_ASSERT((rt_ubase_t)NEXT_PHYS(mem) <= (rt_ubase_t)tlsf->heap_end);
+    RT_ASSERT((((rt_ubase_t)mem) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    RT_DEBUG_LOG(RT_DEBUG_TLSF,
+                 ("allocate memory at 0x%x, size: %d\n",
+                  (rt_ubase_t)((rt_uint8_t *)mem + SIZEOF_STRUCT_MEM), mem->size));
+
+    /* return the memory data except mem struct */
+    return (rt_uint8_t *)mem + SIZEOF_STRUCT_MEM;
+}
+RTM_EXPORT(rt_tlsf_alloc);
+
+/**
+ * @brief This function will change the size of previously allocated memory block.
+ *
+ * @param m the tlsf memory management object.
+ *
+ * @param rmem is the pointer to memory allocated by rt_tlsf_alloc.
+ *
+ * @param newsize is the required new size.
+ *
+ * @return the changed memory block address.
+ */
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize)
+{
+    struct rt_tlsf_item *mem, *next;
+    struct rt_tlsf *tlsf;
+    rt_size_t size;
+    void *nmem;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    /* alignment size */
+    newsize = RT_ALIGN(newsize, RT_ALIGN_SIZE);
+    if (newsize > tlsf->mem_size_aligned)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_TLSF, ("realloc: out of memory\n"));
+
+        return RT_NULL;
+    }
+    else if (newsize == 0)
+    {
+        rt_tlsf_free(rmem);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_tlsf_alloc(&tlsf->parent, newsize);
+
+    if (newsize < MIN_SIZE_ALIGNED)
+        newsize = MIN_SIZE_ALIGNED;
+
+    RT_ASSERT((((rt_ubase_t)rmem) & (RT_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT((rt_uint8_t *)rmem >= (rt_uint8_t *)tlsf->heap_ptr);
+    RT_ASSERT((rt_uint8_t *)rmem < (rt_uint8_t *)tlsf->heap_end);
+
+    mem = (struct rt_tlsf_item *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    RT_ASSERT(MEM_ISUSED(mem));
+    size = mem->size;
+
+    if (newsize > size)
+    {
+        /* try to grow in place by taking the next free item */
+        next = NEXT_PHYS(mem);
+        if (!MEM_ISUSED(next) && size + SIZEOF_STRUCT_MEM + next->size >= newsize)
+        {
+            _tlsf_remove_free(tlsf, next);
+            mem->size += SIZEOF_STRUCT_MEM + next->size;
+            next->pool_ptr = 0;
+            NEXT_PHYS(mem)->prev_phys = mem;
+            tlsf->parent.used += mem->size - size;
+        }
+        else
+        {
+            /* expand memory */
+            nmem = rt_tlsf_alloc(&tlsf->parent, newsize);
+            if (nmem != RT_NULL) /* check memory */
+            {
+                rt_memcpy(nmem, rmem, size);
+                rt_tlsf_free(rmem);
+            }
+
+            return nmem;
+        }
+    }
+
+    /* shrink the memory block */
+    _tlsf_trim(tlsf, mem, newsize);
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+    return rmem;
+}
+RTM_EXPORT(rt_tlsf_realloc);
+
+/**
+ * @brief This function will release the previously allocated memory block by
+ *        rt_tlsf_alloc. The released memory block is taken back to tlsf heap.
+ *
+ * @param rmem the address of memory which will be released.
+ */
+void rt_tlsf_free(void *rmem)
+{
+    struct rt_tlsf_item *mem;
+    struct rt_tlsf *tlsf;
+
+    if (rmem == RT_NULL)
+        return;
+
+    RT_ASSERT((((rt_ubase_t)rmem) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    /* Get the corresponding struct rt_tlsf_item ... */
+    mem = (struct rt_tlsf_item *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    /* ... which has to be in a used state ... */
+    tlsf = MEM_POOL(mem);
+    RT_ASSERT(tlsf != RT_NULL);
+    RT_ASSERT(MEM_ISUSED(mem));
+    RT_ASSERT(rt_object_get_type(&tlsf->parent.parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&tlsf->parent.parent));
+    RT_ASSERT((rt_uint8_t *)rmem >= (rt_uint8_t *)tlsf->heap_ptr &&
+              (rt_uint8_t *)rmem < (rt_uint8_t *)tlsf->heap_end);
+    RT_ASSERT(MEM_POOL(NEXT_PHYS(mem)) == tlsf);
+
+    RT_DEBUG_LOG(RT_DEBUG_TLSF,
+                 ("release memory 0x%x, size: %d\n",
+                  (rt_ubase_t)rmem, mem->size));
+
+    /* ... and is now unused. */
+    mem->pool_ptr = MEM_FREED(tlsf);
+#ifdef RT_USING_MEMTRACE
+    _tlsf_setname(mem, "    ");
+#endif /* RT_USING_MEMTRACE */
+
+    tlsf->parent.used -= mem->size + SIZEOF_STRUCT_MEM;
+
+    /* finally, see if prev or next are free also */
+    mem = _tlsf_merge(tlsf, mem);
+    _tlsf_insert_free(tlsf, mem);
+}
+RTM_EXPORT(rt_tlsf_free);
+
+/**
+ * @brief This function will get the usable size of the allocated memory block.
+ *
+ * @param rmem the address of memory allocated by rt_tlsf_alloc.
+ *
+ * @return the number of bytes which can be used in the memory block.
+ */
+rt_size_t rt_tlsf_usable_size(void *rmem)
+{
+    struct rt_tlsf_item *mem;
+
+    RT_ASSERT(rmem != RT_NULL);
+
+    mem = (struct rt_tlsf_item *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    RT_ASSERT(MEM_ISUSED(mem));
+
+    return mem->size;
+}
+RTM_EXPORT(rt_tlsf_usable_size);
+
+/**@}*/
+
+#if defined(RT_USING_FINSH) && defined(RT_USING_MEMTRACE) && !defined(RT_USING_SMALL_MEM)
+#include <finsh.h>
+
+int memcheck(int argc, char *argv[])
+{
+    rt_base_t level;
+    struct rt_tlsf_item *mem, *prev;
+    struct rt_tlsf *m;
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    char *name;
+
+    name = argc > 1 ? argv[1] : RT_NULL;
+    level = rt_hw_interrupt_disable();
+    /* get mem object */
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        /* find the specified object */
+        if (name != RT_NULL && rt_strncmp(name, object->name, RT_NAME_MAX) != 0)
+            continue;
+        /* tlsf object */
+        m = (struct rt_tlsf *)object;
+        if (m->parent.algorithm != _tlsf_algorithm)
+            continue;
+        /* check mem */
+        for (prev = RT_NULL, mem = (struct rt_tlsf_item *)m->heap_ptr; mem != m->heap_end; prev = mem, mem = NEXT_PHYS(mem))
+        {
+            if ((rt_uint8_t *)mem < m->heap_ptr) goto __exit;
+            if ((rt_uint8_t *)mem > (rt_uint8_t *)m->heap_end) goto __exit;
+            if (MEM_POOL(mem) != m) goto __exit;
+            if (mem->prev_phys != prev) goto __exit;
+            /* two free neighbours should have been merged */
+            if (prev && !MEM_ISUSED(prev) && !MEM_ISUSED(mem)) goto __exit;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return 0;
+__exit:
+    rt_kprintf("Memory block wrong:\n");
+    rt_kprintf("   name: %s\n", m->parent.parent.name);
+    rt_kprintf("address: 0x%08x\n", mem);
+    rt_kprintf("   pool: 0x%04x\n", mem->pool_ptr);
+    rt_kprintf("   size: %d\n", mem->size);
+    rt_hw_interrupt_enable(level);
+
+    return 0;
+}
+MSH_CMD_EXPORT(memcheck, check memory data);
+
+int memtrace(int argc, char **argv)
+{
+    int fl, sl, lists;
+    struct rt_tlsf_item *mem;
+    struct rt_tlsf *m;
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    char *name;
+
+    name = argc > 1 ? argv[1] : RT_NULL;
+    /* get mem object */
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        /* find the specified object */
+        if (name != RT_NULL && rt_strncmp(name, object->name, RT_NAME_MAX) != 0)
+            continue;
+        /* tlsf object */
+        m = (struct rt_tlsf *)object;
+        if (m->parent.algorithm != _tlsf_algorithm)
+            continue;
+
+        for (lists = 0, fl = 0; fl < FL_INDEX_COUNT; fl ++)
+        {
+            for (sl = 0; sl < SL_INDEX_COUNT; sl ++)
+            {
+                if (m->blocks[fl][sl] != RT_NULL)
+                    lists ++;
+            }
+        }
+
+        /* show memory information */
+        rt_kprintf("\nmemory heap address:\n");
+        rt_kprintf("name    : %s\n", m->parent.parent.name);
+        rt_kprintf("total   : %d\n", m->parent.total);
+        rt_kprintf("used    : %d\n", m->parent.used);
+        rt_kprintf("max_used: %d\n", m->parent.max);
+        rt_kprintf("heap_ptr: 0x%08x\n", m->heap_ptr);
+        rt_kprintf("heap_end: 0x%08x\n", m->heap_end);
+        rt_kprintf("fl_map  : 0x%08x\n", m->fl_bitmap);
+        rt_kprintf("lists   : %d\n", lists);
+        rt_kprintf("\n--memory item information --\n");
+        for (mem = (struct rt_tlsf_item *)m->heap_ptr; mem != m->heap_end; mem = NEXT_PHYS(mem))
+        {
+            int size = mem->size;
+
+            rt_kprintf("[0x%08x - ", mem);
+            if (size < 1024)
+                rt_kprintf("%5d", size);
+            else if (size < 1024 * 1024)
+                rt_kprintf("%4dK", size / 1024);
+            else
+                rt_kprintf("%4dM", size / (1024 * 1024));
+
+            rt_kprintf("] %c%c%c%c", mem->thread[0], mem->thread[1], mem->thread[2], mem->thread[3]);
+            if (MEM_POOL(mem) != m)
+                rt_kprintf(": ***\n");
+            else
+                rt_kprintf("\n");
+        }
+    }
+    return 0;
+}
+MSH_CMD_EXPORT(memtrace, dump memory trace information);
+#endif /* defined(RT_USING_FINSH) && defined(RT_USING_MEMTRACE) && !defined(RT_USING_SMALL_MEM) */
+
+#endif /* defined (RT_USING_TLSF) */
@@ -103,6 +103,9 @@
 #define FAL_PART_HAS_TABLE_CFG
 #define FAL_USING_SFUD_PORT
 #define FAL_USING_NOR_FLASH_DEV_NAME "norflash0"
+#define FAL_USING_BLK_CACHE
+#define FAL_BLK_CACHE_BLOCKS 2
+#define FAL_BLK_SECTOR_SIZE 0
 
 /* Device Drivers */
 
@@ -110,17 +113,22 @@
 #define RT_USING_SYSTEM_WORKQUEUE
 #define RT_SYSTEM_WORKQUEUE_STACKSIZE 2048
 #define RT_SYSTEM_WORKQUEUE_PRIORITY 23
+#define RT_SYSTEM_WORKQUEUE_WORKERS 1
 #define RT_USING_SERIAL
 #define RT_USING_SERIAL_V1
 #define RT_SERIAL_RB_BUFSZ 2048
 #define RT_USING_CAN
 #define RT_USING_HWTIMER
+#define RT_USING_CPUTIME
 #define RT_USING_I2C
 #define RT_USING_I2C_BITOPS
 #define RT_USING_PIN
 #define RT_USING_ADC
 #define RT_USING_PWM
 #define RT_USING_MTD_NAND
+#define RT_USING_BLK_CACHE
+#define RT_BLK_CACHE_FLUSH_PERIOD 1000
+#define RT_BLK_CACHE_READ_AHEAD 8
 #define RT_USING_RTC
 #define RT_USING_ALARM
 #define RT_USING_SPI
@@ -438,6 +446,8 @@
 #define BSP_USING_SDH0
 #define BSP_USING_SDH1
 #define NU_SDH_HOTPLUG
+#define NU_SDH_BOUNCE_BLOCKS 16
+#define NU_SDH_CACHE_BLOCKS 64
 #define BSP_USING_CAN
 #define BSP_USING_CAN0
 #define BSP_USING_PWM
@@ -0,0 +1,14 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* Only the software blending of LVGL, at the depth of the test program. */
+#ifndef HOST_COLOR_DEPTH
+#define HOST_COLOR_DEPTH 16
+#endif
+
+#define LV_COLOR_DEPTH          HOST_COLOR_DEPTH
+#define LV_MEM_CUSTOM           1
+#define LV_MEMCPY_MEMSET_STD    1
+#define LV_TICK_CUSTOM          1
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The C form of the blend kernels of lv_blend_armv5te.c against fill_normal
+ * and map_normal of LVGL, which they replace: random areas, alignments,
+ * strides, opacities and masks, on buffers where colours repeat as in real
+ * frames. The whole buffer must come out the same, the pixels around the
+ * area too. test is built in RGB565, test_32 in ARGB8888.
+ */
+#include "src/draw/sw/lv_draw_sw_blend.c"
+#include "lv_blend_armv5te.h"
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define BUF_WIDTH           67
+#define BUF_HEIGHT          9
+#define BUF_PIXELS          (BUF_WIDTH * BUF_HEIGHT + 8)
+#define LOOPS               200000
+
+static lv_color_t _generic[BUF_PIXELS], _kernel[BUF_PIXELS], _src[BUF_PIXELS];
+static lv_opa_t _mask[BUF_PIXELS];
+
+/* lv_draw_sw_blend_basic needs it, the test calls the blend functions below it */
+lv_disp_t *_lv_refr_get_disp_refreshing(void)
+{
+    return NULL;
+}
+
+static void _fill_buffers(void)
+{
+    int palette = host_test_rand() % 4, index;
+
+    for (index = 0; index < BUF_PIXELS; index++)
+    {
+        uint32_t dice = host_test_rand() % 8;
+
+        /* mostly the same colour, as the caches of map_normal expect */
+        _generic[index].full = (palette == 0 || host_test_rand() % 3 == 0) ? host_test_rand() : 0x1234ABCD;
+        _kernel[index] = _generic[index];
+        _src[index].full = host_test_rand();
+        /* runs of transparent and covered pixels, some edges between */
+        _mask[index] = dice < 3 ? LV_OPA_TRANSP : dice < 6 ? LV_OPA_COVER : (lv_opa_t)host_test_rand();
+    }
+}
+
+int main(void)
+{
+    static const lv_opa_t opas[] = { 255, 254, 253, 252, 200, 128, 7, 3 };
+    long loop, fills = 0, maps = 0, mismatches = 0;
+
+    host_test_srand(7);
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        int width = 1 + host_test_rand() % (BUF_WIDTH - 4), height = 1 + host_test_rand() % (BUF_HEIGHT - 1);
+        int offset = host_test_rand() % 3, mask_offset = host_test_rand() % 4, src_offset = host_test_rand() % 3;
+        int src_stride = width + host_test_rand() % 3;
+        lv_opa_t opa = opas[host_test_rand() % 8];
+        const lv_opa_t *mask;
+        lv_color_t color;
+        lv_area_t area;
+
+        _fill_buffers();
+        color.full = host_test_rand();
+        mask = host_test_rand() % 2 ? _mask + mask_offset : NULL;
+        area.x1 = 0;
+        area.y1 = 0;
+        area.x2 = width - 1;
+        area.y2 = height - 1;
+
+        if (host_test_rand() % 2 && src_offset + src_stride * height <= BUF_PIXELS)
+        {
+            map_normal(_generic + offset, &area, BUF_WIDTH, _src + src_offset, src_stride, opa, mask, BUF_WIDTH);
+            lv_blend_armv5te_map(_kernel + offset, &area, BUF_WIDTH, _src + src_offset, src_stride, opa, mask, BUF_WIDTH);
+            maps++;
+        }
+        else
+        {
+            fill_normal(_generic + offset, &area, BUF_WIDTH, color, opa, mask, BUF_WIDTH);
+            lv_blend_armv5te_fill(_kernel + offset, &area, BUF_WIDTH, color, opa, mask, BUF_WIDTH);
+            fills++;
+        }
+
+        if (memcmp(_generic, _kernel, sizeof(_generic)) != 0 && mismatches++ < 5)
+        {
+            printf("loop %ld: %dx%d at %d, opa %d, %s mask\n", loop, width, height, offset, opa,
+                   mask ? "with" : "no");
+        }
+    }
+
+    CHECK(mismatches == 0);
+    printf("%d bpp: %ld fills, %ld maps, %ld mismatches\n", LV_COLOR_DEPTH, fills, maps, mismatches);
+
+    return host_test_report(LV_COLOR_DEPTH == 16 ? "blend 16 bpp" : "blend 32 bpp");
+}
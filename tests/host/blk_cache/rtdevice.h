@@ -0,0 +1,8 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* blk_cache.c needs the work queue and its own header of the device drivers. */
+#include "ipc/workqueue.h"
+#include "drivers/blk_cache.h"
+
+#endif
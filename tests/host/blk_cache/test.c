@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The write-back block cache of blk_cache.c over a ramdisk: random reads,
+ * writes, large requests past the cache, erases, periodic and explicit
+ * flushes against a model of the disk; read-ahead and the batching of
+ * sequential writes; a power loss at every point of a flush, which must
+ * leave exactly the first blocks in the order they were dirtied. Then the
+ * requests reaching the disk for a FAT-like append pattern, with and
+ * without the cache.
+ */
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "drv_ramdisk.h"
+#include "host_test.h"
+
+#define BLOCK_SIZE          512
+#define BLOCKS              256
+#define CACHE_BLOCKS        32
+#define LOOPS               200000
+#define CUT_BLOCKS          24
+
+static rt_uint8_t _disk[BLOCKS * BLOCK_SIZE], _model[BLOCKS * BLOCK_SIZE], _buf[64 * BLOCK_SIZE];
+
+/* the requests reaching the ramdisk */
+static rt_size_t (*_ramdisk_write)(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+static rt_size_t (*_ramdisk_read)(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
+static long _lower_reads, _lower_writes;
+
+static rt_size_t _count_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    _lower_writes++;
+    return _ramdisk_write(dev, pos, buffer, size);
+}
+
+static rt_size_t _count_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    _lower_reads++;
+    return _ramdisk_read(dev, pos, buffer, size);
+}
+
+/* the system work queue, its work run when the test says */
+static struct rt_work *_work;
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data), void *work_data)
+{
+    work->work_func = work_func;
+    work->work_data = work_data;
+}
+
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t ticks)
+{
+    CHECK(ticks == rt_tick_from_millisecond(RT_BLK_CACHE_FLUSH_PERIOD));
+    _work = work;
+    return RT_EOK;
+}
+
+rt_err_t rt_work_cancel(struct rt_work *work)
+{
+    if (_work == work)
+        _work = RT_NULL;
+    return RT_EOK;
+}
+
+static void _run_work(void)
+{
+    struct rt_work *work = _work;
+
+    _work = RT_NULL;
+    if (work)
+        work->work_func(work, work->work_data);
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms) { return RT_EOK; }
+
+/* one thread, the lock only has to be balanced */
+static int _lock_held;
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) { return RT_EOK; }
+rt_err_t rt_mutex_detach(rt_mutex_t mutex) { return RT_EOK; }
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    _lock_held++;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    CHECK(_lock_held > 0);
+    _lock_held--;
+
+    return RT_EOK;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    void *ptr;
+
+    return posix_memalign(&ptr, align, size) ? RT_NULL : ptr;
+}
+
+void rt_free_align(void *ptr) { free(ptr); }
+
+/* reads, writes, erases and flushes in any order read back what the model holds */
+static void _test_random(rt_device_t cache)
+{
+    struct rt_blk_cache_stat stat;
+    long loop, mismatches = 0;
+
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        /* mostly small, some past a quarter of the cache */
+        rt_off_t count = 1 + host_test_rand() % (host_test_rand() % 4 == 0 ? 20 : 4);
+        rt_off_t pos = host_test_rand() % (BLOCKS - count + 1);
+        int dice = host_test_rand() % 100, index;
+
+        if (dice < 45)
+        {
+            for (index = 0; index < count * BLOCK_SIZE; index++)
+                _buf[index] = host_test_rand();
+            memcpy(_model + pos * BLOCK_SIZE, _buf, count * BLOCK_SIZE);
+            CHECK(rt_device_write(cache, pos, _buf, count) == count);
+        }
+        else if (dice < 94)
+        {
+            CHECK(rt_device_read(cache, pos, _buf, count) == count);
+            if (memcmp(_buf, _model + pos * BLOCK_SIZE, count * BLOCK_SIZE) != 0 && mismatches++ < 5)
+                printf("loop %ld: %d blocks at %d differ\n", loop, (int)count, (int)pos);
+        }
+        else if (dice < 95)
+        {
+            rt_uint32_t range[2] = { pos, pos + count - 1 };
+
+            /* erased blocks read back anything, take what the disk has */
+            CHECK(rt_device_control(cache, RT_DEVICE_CTRL_BLK_ERASE, range) == RT_EOK);
+            memcpy(_model + pos * BLOCK_SIZE, _disk + pos * BLOCK_SIZE, count * BLOCK_SIZE);
+        }
+        else if (dice < 98)
+        {
+            _run_work();
+        }
+        else
+        {
+            CHECK(rt_device_control(cache, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL) == RT_EOK);
+        }
+        CHECK(_lock_held == 0);
+    }
+
+    CHECK(mismatches == 0);
+    CHECK(rt_device_control(cache, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL) == RT_EOK);
+    CHECK(memcmp(_disk, _model, sizeof(_disk)) == 0);
+    rt_blk_cache_get_stat(cache, &stat);
+    CHECK(stat.dirty == 0);
+    printf("random: %u hits, %u misses, %u read ahead, %u written back, %u evictions, %u bypasses\n",
+           (unsigned int)stat.hits, (unsigned int)stat.misses, (unsigned int)stat.readaheads,
+           (unsigned int)stat.writebacks, (unsigned int)stat.evictions, (unsigned int)stat.bypasses);
+}
+
+static void _test_sequential(rt_device_t cache)
+{
+    struct rt_blk_cache_stat stat;
+    rt_off_t pos;
+
+    /* reading on from where it stopped is read ahead */
+    rt_blk_cache_invalidate(cache);
+    rt_blk_cache_reset_stat(cache);
+    _lower_reads = 0;
+    for (pos = 0; pos < 128; pos++)
+        CHECK(rt_device_read(cache, pos, _buf, 1) == 1);
+    rt_blk_cache_get_stat(cache, &stat);
+    CHECK(stat.hits + stat.misses == 128);
+    CHECK(stat.readaheads > 0);
+    /* two reads on demand show the sequence, then one request each RT_BLK_CACHE_READ_AHEAD blocks */
+    CHECK(_lower_reads <= 2 + 128 / RT_BLK_CACHE_READ_AHEAD);
+    printf("128 sequential reads: %ld requests to the disk, %u blocks read ahead\n",
+           _lower_reads, (unsigned int)stat.readaheads);
+
+    /* dirty blocks on consecutive sectors go in batches */
+    _lower_writes = 0;
+    for (pos = 0; pos < 16; pos++)
+        CHECK(rt_device_write(cache, pos, _buf, 1) == 1);
+    CHECK(_lower_writes == 0);
+    CHECK(_work != RT_NULL);
+    _run_work();
+    rt_blk_cache_get_stat(cache, &stat);
+    CHECK(stat.dirty == 0);
+    CHECK(_lower_writes == 2);
+    printf("16 sequential writes: %ld requests to the disk at the periodic flush\n", _lower_writes);
+}
+
+/* a power loss after `cut` blocks of a flush leaves the first `cut` blocks dirtied */
+static void _test_power_loss(rt_device_t cache)
+{
+    struct rt_blk_cache_stat stat;
+    rt_uint32_t order[CUT_BLOCKS];
+    long cut, bad = 0;
+    int index;
+
+    for (cut = 0; cut <= CUT_BLOCKS; cut++)
+    {
+        for (index = 0; index < CUT_BLOCKS; index++)
+            order[index] = 100 + index;
+        /* shuffled, runs of consecutive sectors by chance */
+        for (index = CUT_BLOCKS - 1; index > 0; index--)
+        {
+            int other = host_test_rand() % (index + 1);
+            rt_uint32_t swap = order[index];
+
+            order[index] = order[other];
+            order[other] = swap;
+        }
+
+        memset(_disk + 100 * BLOCK_SIZE, 0, CUT_BLOCKS * BLOCK_SIZE);
+        rt_blk_cache_invalidate(cache);
+        memset(_buf, cut + 1, BLOCK_SIZE);
+        for (index = 0; index < CUT_BLOCKS; index++)
+            rt_device_write(cache, order[index], _buf, 1);
+        /* written again, they keep their place */
+        for (index = 0; index < CUT_BLOCKS; index += 5)
+            rt_device_write(cache, order[index], _buf, 1);
+
+        rt_blk_cache_set_fault(cache, cut);
+        if ((rt_blk_cache_flush(cache) == RT_EOK) != (cut == CUT_BLOCKS))
+            bad++;
+        for (index = 0; index < CUT_BLOCKS; index++)
+        {
+            if ((_disk[order[index] * BLOCK_SIZE] == cut + 1) != (index < cut))
+                bad++;
+        }
+        rt_blk_cache_get_stat(cache, &stat);
+        if (stat.dirty != CUT_BLOCKS - cut)
+            bad++;
+
+        /* the power is back */
+        rt_blk_cache_set_fault(cache, -1);
+        CHECK(rt_blk_cache_flush(cache) == RT_EOK);
+        CHECK(_disk[order[CUT_BLOCKS - 1] * BLOCK_SIZE] == cut + 1);
+    }
+
+    CHECK(bad == 0);
+    rt_blk_cache_get_stat(cache, &stat);
+    printf("power loss at %d points of a flush: %ld wrong, %u blocks dropped\n",
+           CUT_BLOCKS + 1, bad, (unsigned int)stat.dropped);
+}
+
+/* appending a file: the data, the FAT sector and the directory entry each time */
+static long _appends(rt_device_t dev)
+{
+    rt_off_t data;
+
+    _lower_writes = 0;
+    for (data = 0; data < 1024; data++)
+    {
+        rt_device_write(dev, 64 + data % (BLOCKS - 64), _buf, 1);
+        rt_device_write(dev, 1 + data / 128, _buf, 1);
+        rt_device_write(dev, 0, _buf, 1);
+    }
+    rt_device_control(dev, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL);
+
+    return _lower_writes;
+}
+
+int main(void)
+{
+    rt_device_t ramdisk, cache;
+    long direct, cached;
+
+    CHECK(ramdisk_init("ram0", _disk, BLOCK_SIZE, BLOCKS) == RT_EOK);
+    ramdisk = rt_device_find("ram0");
+    _ramdisk_write = ramdisk->write;
+    _ramdisk_read = ramdisk->read;
+    ramdisk->write = _count_write;
+    ramdisk->read = _count_read;
+
+    CHECK(rt_blk_cache_create("ramc", "nodisk", CACHE_BLOCKS) == RT_NULL);
+    cache = rt_blk_cache_create("ramc", "ram0", CACHE_BLOCKS);
+    CHECK(cache != RT_NULL && rt_device_find("ramc") == cache);
+    if (cache == RT_NULL)
+        return host_test_report("blk_cache");
+    CHECK(rt_device_open(cache, RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+
+    host_test_srand(21);
+    _test_random(cache);
+    _test_sequential(cache);
+    _test_power_loss(cache);
+
+    direct = _appends(ramdisk);
+    cached = _appends(cache);
+    printf("1024 appends: %ld writes to the disk direct, %ld through the cache\n", direct, cached);
+
+    CHECK(rt_device_close(cache) == RT_EOK);
+    CHECK(rt_blk_cache_destroy(cache) == RT_EOK);
+    CHECK(rt_device_find("ramc") == RT_NULL);
+
+    return host_test_report("blk_cache");
+}
@@ -0,0 +1,9 @@
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+/* drv_ramdisk.c takes the kernel, the device drivers and libc from here. */
+#include <stdlib.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#endif
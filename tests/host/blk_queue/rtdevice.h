@@ -0,0 +1,8 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* blk_queue.c needs the completion and its own header of the device drivers. */
+#include "ipc/completion.h"
+#include "drivers/blk_queue.h"
+
+#endif
@@ -0,0 +1,565 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The block queue of blk_queue.c over a ramdisk made a card: each command
+ * costs a fixed time, a time per block and a seek when it does not follow
+ * the last one. The dispatch thread runs on a host thread, the semaphores,
+ * mutexes, events and completions on a lock and a condition of the host.
+ * Batches of asynchronous reads and writes on overlapping sectors must read
+ * what was written before them and leave the image of a model; a request
+ * below the elevator must wait for its deadline, not longer. Then streamed
+ * one block writes and threads on distant regions, direct and queued.
+ */
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "drv_ramdisk.h"
+#include "host_test.h"
+
+#define BLOCK_SIZE          512
+#define BLOCKS              4096
+#define BATCH               RT_BLK_QUEUE_DEPTH
+#define BATCHES             1500
+#define REQUEST_BLOCKS      8
+#define ORDER_BLOCKS        64
+#define STREAM_BATCHES      80
+#define THREADS             8
+#define THREAD_OPS          300
+
+/* the kernel: everything waits on one lock and one condition */
+static pthread_mutex_t _kernel = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _wakeup = PTHREAD_COND_INITIALIZER;
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    mutex->hold = 0;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex) { return RT_EOK; }
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    pthread_mutex_lock(&_kernel);
+    while (mutex->hold)
+        pthread_cond_wait(&_wakeup, &_kernel);
+    mutex->hold = 1;
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    pthread_mutex_lock(&_kernel);
+    CHECK(mutex->hold == 1);
+    mutex->hold = 0;
+    pthread_cond_broadcast(&_wakeup);
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    sem->value = value;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem) { return RT_EOK; }
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    pthread_mutex_lock(&_kernel);
+    while (sem->value == 0)
+        pthread_cond_wait(&_wakeup, &_kernel);
+    sem->value--;
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    pthread_mutex_lock(&_kernel);
+    sem->value++;
+    pthread_cond_broadcast(&_wakeup);
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
+{
+    event->set = 0;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_detach(rt_event_t event) { return RT_EOK; }
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    pthread_mutex_lock(&_kernel);
+    event->set |= set;
+    pthread_cond_broadcast(&_wakeup);
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt, rt_int32_t timeout, rt_uint32_t *recved)
+{
+    pthread_mutex_lock(&_kernel);
+    while ((event->set & set) == 0)
+    {
+        if (timeout == 0)
+        {
+            pthread_mutex_unlock(&_kernel);
+            return -RT_ETIMEOUT;
+        }
+        pthread_cond_wait(&_wakeup, &_kernel);
+    }
+    if (recved)
+        *recved = event->set & set;
+    if (opt & RT_EVENT_FLAG_CLEAR)
+        event->set &= ~set;
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+void rt_completion_init(struct rt_completion *completion)
+{
+    completion->flag = 0;
+}
+
+rt_err_t rt_completion_wait(struct rt_completion *completion, rt_int32_t timeout)
+{
+    pthread_mutex_lock(&_kernel);
+    while (completion->flag == 0)
+        pthread_cond_wait(&_wakeup, &_kernel);
+    completion->flag = 0;
+    pthread_mutex_unlock(&_kernel);
+
+    return RT_EOK;
+}
+
+void rt_completion_done(struct rt_completion *completion)
+{
+    pthread_mutex_lock(&_kernel);
+    completion->flag = 1;
+    pthread_cond_broadcast(&_wakeup);
+    pthread_mutex_unlock(&_kernel);
+}
+
+/* a thread of the kernel is a host thread, started at rt_thread_startup */
+struct host_thread
+{
+    pthread_t pthread;
+    void (*entry)(void *parameter);
+    void *parameter;
+};
+
+static void *_thread_entry(void *parameter)
+{
+    struct host_thread *thread = (struct host_thread *)parameter;
+
+    thread->entry(thread->parameter);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    struct host_thread *thread = calloc(1, sizeof(struct host_thread));
+
+    thread->entry = entry;
+    thread->parameter = parameter;
+
+    return (rt_thread_t)thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct host_thread *host = (struct host_thread *)thread;
+
+    return pthread_create(&host->pthread, RT_NULL, _thread_entry, host) == 0 ? RT_EOK : -RT_ERROR;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+    free(thread);
+
+    return RT_EOK;
+}
+
+/* the deadlines run on the clock of the host */
+rt_tick_t rt_tick_get(void)
+{
+    return host_test_now_ns() / 1000000;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    void *ptr;
+
+    return posix_memalign(&ptr, align, size) ? RT_NULL : ptr;
+}
+
+void rt_free_align(void *ptr) { free(ptr); }
+
+/* the card: the ramdisk with the costs of a command, serving one at a time */
+static rt_uint8_t _disk[BLOCKS * BLOCK_SIZE], _model[BLOCKS * BLOCK_SIZE];
+static rt_size_t (*_ramdisk_write)(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+static rt_size_t (*_ramdisk_read)(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
+static pthread_mutex_t _card = PTHREAD_MUTEX_INITIALIZER;
+static long _cmds, _oversized, _last = -1;
+static int _cmd_us, _block_us, _seek_us;
+
+static void _card_cost(rt_off_t pos, rt_size_t size)
+{
+    int us = _cmd_us + _block_us * size + (pos != _last ? _seek_us : 0);
+
+    _cmds++;
+    if (size > RT_BLK_QUEUE_MERGE_BLOCKS)
+        _oversized++;
+    _last = pos + size;
+    if (us)
+        usleep(us);
+}
+
+static rt_size_t _card_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    rt_size_t result;
+
+    pthread_mutex_lock(&_card);
+    _card_cost(pos, size);
+    result = _ramdisk_write(dev, pos, buffer, size);
+    pthread_mutex_unlock(&_card);
+
+    return result;
+}
+
+static rt_size_t _card_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    rt_size_t result;
+
+    pthread_mutex_lock(&_card);
+    _card_cost(pos, size);
+    result = _ramdisk_read(dev, pos, buffer, size);
+    pthread_mutex_unlock(&_card);
+
+    return result;
+}
+
+static void _card_set(int cmd_us, int block_us, int seek_us)
+{
+    _cmd_us = cmd_us;
+    _block_us = block_us;
+    _seek_us = seek_us;
+    _cmds = 0;
+    _last = -1;
+}
+
+/* the asynchronous requests of the test, counted down when done */
+struct request
+{
+    struct rt_blk_request req;
+    rt_uint8_t buffer[REQUEST_BLOCKS * BLOCK_SIZE];
+    rt_uint8_t expect[REQUEST_BLOCKS * BLOCK_SIZE];
+    int busy;
+    uint64_t done_ns;
+};
+
+static struct request _requests[2 * BATCH];
+static int _pending;
+static long _failed, _stale;
+
+static void _done(struct rt_blk_request *req)
+{
+    struct request *request = (struct request *)req;
+
+    if (req->result != req->count)
+        _failed++;
+    if (req->dir == RT_BLK_REQ_READ && memcmp(request->buffer, request->expect, req->count * BLOCK_SIZE) != 0)
+        _stale++;
+    request->done_ns = host_test_now_ns();
+
+    pthread_mutex_lock(&_kernel);
+    request->busy = 0;
+    _pending--;
+    pthread_cond_broadcast(&_wakeup);
+    pthread_mutex_unlock(&_kernel);
+}
+
+static void _submit(rt_device_t queue, struct request *request, rt_uint8_t dir, rt_uint32_t sector, rt_size_t count)
+{
+    /* the slot of a request comes back before its done() */
+    pthread_mutex_lock(&_kernel);
+    while (request->busy)
+        pthread_cond_wait(&_wakeup, &_kernel);
+    request->busy = 1;
+    _pending++;
+    pthread_mutex_unlock(&_kernel);
+
+    memset(&request->req, 0, sizeof(request->req));
+    request->req.dir = dir;
+    request->req.sector = sector;
+    request->req.count = count;
+    request->req.buffer = request->buffer;
+    request->req.done = _done;
+    CHECK(rt_blk_queue_submit(queue, &request->req) == RT_EOK);
+}
+
+static void _wait_all(void)
+{
+    pthread_mutex_lock(&_kernel);
+    while (_pending)
+        pthread_cond_wait(&_wakeup, &_kernel);
+    pthread_mutex_unlock(&_kernel);
+}
+
+/* overlapping reads and writes in any direction read what was submitted before them */
+static void _test_order(rt_device_t queue)
+{
+    struct rt_blk_queue_stat stat;
+    int batch, index;
+
+    memcpy(_model, _disk, sizeof(_model));
+    _card_set(20, 0, 0);
+    rt_blk_queue_reset_stat(queue);
+
+    for (batch = 0; batch < BATCHES; batch++)
+    {
+        for (index = 0; index < BATCH; index++)
+        {
+            struct request *request = &_requests[index];
+            rt_uint8_t dir = host_test_rand() % 2;
+            rt_size_t count = 1 + host_test_rand() % REQUEST_BLOCKS;
+            rt_uint32_t sector = host_test_rand() % (ORDER_BLOCKS - count + 1);
+            int offset;
+
+            if (dir == RT_BLK_REQ_WRITE)
+            {
+                for (offset = 0; offset < count * BLOCK_SIZE; offset += 64)
+                    request->buffer[offset] = host_test_rand();
+                memcpy(_model + sector * BLOCK_SIZE, request->buffer, count * BLOCK_SIZE);
+            }
+            else
+            {
+                memcpy(request->expect, _model + sector * BLOCK_SIZE, count * BLOCK_SIZE);
+            }
+            _submit(queue, request, dir, sector, count);
+        }
+        _wait_all();
+    }
+
+    CHECK(rt_device_control(queue, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL) == RT_EOK);
+    rt_blk_queue_get_stat(queue, &stat);
+    CHECK(_failed == 0 && _stale == 0 && _oversized == 0);
+    CHECK(memcmp(_disk, _model, sizeof(_disk)) == 0);
+    CHECK(stat.requests == BATCHES * BATCH);
+    CHECK(stat.merged > 0 && stat.commands + stat.merged == stat.requests);
+    CHECK(stat.max_pending <= RT_BLK_QUEUE_DEPTH);
+    printf("%u requests: %u commands, %u merged, %u expired, %ld stale reads, at most %u pending\n",
+           (unsigned int)stat.requests, (unsigned int)stat.commands, (unsigned int)stat.merged,
+           (unsigned int)stat.expired, _stale, (unsigned int)stat.max_pending);
+}
+
+/* a request behind the elevator with requests above it all the time waits for its deadline */
+static void _test_deadline(rt_device_t queue)
+{
+    struct request *late = &_requests[2 * BATCH - 1];
+    struct rt_blk_queue_stat stat;
+    rt_uint32_t sector = 1000;
+    uint64_t begin = 0;
+    double waited;
+    int index = 0, done;
+
+    _card_set(1000, 0, 0);
+    CHECK(rt_device_read(queue, 500, _requests[0].buffer, 1) == 1);
+    rt_blk_queue_reset_stat(queue);
+
+    do
+    {
+        struct request *request = &_requests[index++ % (2 * BATCH - 1)];
+
+        /* a block apart, nothing to merge */
+        memcpy(request->expect, _disk + sector * BLOCK_SIZE, BLOCK_SIZE);
+        _submit(queue, request, RT_BLK_REQ_READ, sector, 1);
+        sector += 2;
+
+        /* once the elevator has gone up past it */
+        if (index == 4)
+        {
+            memcpy(late->expect, _disk + 10 * BLOCK_SIZE, BLOCK_SIZE);
+            begin = host_test_now_ns();
+            _submit(queue, late, RT_BLK_REQ_READ, 10, 1);
+        }
+
+        pthread_mutex_lock(&_kernel);
+        done = index > 4 && !late->busy;
+        pthread_mutex_unlock(&_kernel);
+    }
+    while (!done && sector < BLOCKS);
+    _wait_all();
+
+    waited = (late->done_ns - begin) / 1e6;
+    rt_blk_queue_get_stat(queue, &stat);
+    CHECK(done);
+    CHECK(waited >= RT_BLK_QUEUE_READ_EXPIRE && waited < 3 * RT_BLK_QUEUE_READ_EXPIRE);
+    CHECK(stat.expired > 0);
+    CHECK(_failed == 0 && _stale == 0);
+    printf("a read behind the elevator: served after %.1f ms, %d requests above it in the meantime, %u expired\n",
+           waited, index - 5, (unsigned int)stat.expired);
+}
+
+/* one block writes one after the other, as a logger does */
+static void _test_stream(rt_device_t ram, rt_device_t queue)
+{
+    struct rt_blk_queue_stat stat;
+    long direct_cmds, queue_cmds;
+    uint64_t begin;
+    double direct, queued;
+    int batch, index;
+
+    _card_set(150, 10, 250);
+    rt_blk_queue_reset_stat(queue);
+    begin = host_test_now_ns();
+    for (batch = 0; batch < STREAM_BATCHES; batch++)
+    {
+        for (index = 0; index < BATCH; index++)
+            _submit(queue, &_requests[index], RT_BLK_REQ_WRITE, 1024 + batch * BATCH + index, 1);
+        _wait_all();
+    }
+    queued = (host_test_now_ns() - begin) / 1e9;
+    queue_cmds = _cmds;
+
+    _card_set(150, 10, 250);
+    begin = host_test_now_ns();
+    for (index = 0; index < STREAM_BATCHES * BATCH; index++)
+        CHECK(rt_device_write(ram, 1024 + index, _requests[0].buffer, 1) == 1);
+    direct = (host_test_now_ns() - begin) / 1e9;
+    direct_cmds = _cmds;
+
+    rt_blk_queue_get_stat(queue, &stat);
+    CHECK(_failed == 0 && _oversized == 0);
+    CHECK(queue_cmds < direct_cmds / 8);
+    printf("%d one block writes: direct %ld commands %.3f s, queued %ld commands %.3f s, %.1fx\n",
+           STREAM_BATCHES * BATCH, direct_cmds, direct, queue_cmds, queued, direct / queued);
+}
+
+/* threads reading and writing their own regions, waiting for each request */
+static rt_device_t _target;
+
+static void *_worker(void *parameter)
+{
+    long id = (long)parameter;
+    rt_uint8_t buffer[4 * BLOCK_SIZE];
+    unsigned int seed = id;
+    int op;
+
+    for (op = 0; op < THREAD_OPS; op++)
+    {
+        if (id < 4)
+        {
+            rt_device_read(_target, id * 512 + op, buffer, 1);
+        }
+        else if (id < 6)
+        {
+            rt_size_t count = 1 + rand_r(&seed) % 4;
+
+            rt_device_read(_target, 2048 + rand_r(&seed) % 2000, buffer, count);
+        }
+        else
+        {
+            memset(buffer, op, BLOCK_SIZE);
+            rt_device_write(_target, 3072 + (id - 6) * 400 + op, buffer, 1);
+        }
+    }
+
+    return RT_NULL;
+}
+
+static double _run_threads(rt_device_t target, long *cmds)
+{
+    pthread_t threads[THREADS];
+    uint64_t begin;
+    long id;
+
+    _target = target;
+    _card_set(150, 10, 250);
+    begin = host_test_now_ns();
+    for (id = 0; id < THREADS; id++)
+        pthread_create(&threads[id], RT_NULL, _worker, (void *)id);
+    for (id = 0; id < THREADS; id++)
+        pthread_join(threads[id], RT_NULL);
+    *cmds = _cmds;
+
+    return (host_test_now_ns() - begin) / 1e9;
+}
+
+static void _test_threads(rt_device_t ram, rt_device_t queue)
+{
+    struct rt_blk_queue_stat stat;
+    long direct_cmds, queue_cmds;
+    double direct, queued;
+
+    direct = _run_threads(ram, &direct_cmds);
+    rt_blk_queue_reset_stat(queue);
+    queued = _run_threads(queue, &queue_cmds);
+    rt_blk_queue_get_stat(queue, &stat);
+
+    CHECK(stat.requests == THREADS * THREAD_OPS);
+    CHECK(queue_cmds <= direct_cmds);
+    printf("%d threads on their own regions: direct %ld commands %.3f s, queued %ld commands %.3f s, %u merged\n",
+           THREADS, direct_cmds, direct, queue_cmds, queued, (unsigned int)stat.merged);
+}
+
+int main(void)
+{
+    rt_device_t ram, queue;
+    int index;
+
+    for (index = 0; index < sizeof(_disk); index++)
+        _disk[index] = index * 7 + index / BLOCK_SIZE;
+    CHECK(ramdisk_init("ram0", _disk, BLOCK_SIZE, BLOCKS) == RT_EOK);
+    ram = rt_device_find("ram0");
+    _ramdisk_write = ram->write;
+    _ramdisk_read = ram->read;
+    ram->write = _card_write;
+    ram->read = _card_read;
+
+    CHECK(rt_blk_queue_create("ramq", "nodisk") == RT_NULL);
+    queue = rt_blk_queue_create("ramq", "ram0");
+    CHECK(queue != RT_NULL && rt_device_find("ramq") == queue);
+    if (queue == RT_NULL)
+        return host_test_report("blk_queue");
+    CHECK(rt_device_open(queue, RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+    CHECK(rt_blk_queue_submit(queue, &(struct rt_blk_request) { .count = 0 }) == -RT_EINVAL);
+
+    host_test_srand(23);
+    _test_order(queue);
+    _test_deadline(queue);
+    _test_stream(ram, queue);
+    _test_threads(ram, queue);
+
+    return host_test_report("blk_queue");
+}
@@ -0,0 +1,31 @@
+#
+# Shared rules of the host tests. A test directory sets SRCS and includes
+# this file; its own rtconfig.h comes first on the include path.
+#
+HOST_TESTS := $(abspath $(dir $(lastword $(MAKEFILE_LIST))))
+REPO       := $(abspath $(HOST_TESTS)/../..)
+
+CC         ?= cc
+SANITIZE   ?= -fsanitize=address,undefined
+OPT        ?= -O2
+TARGET     ?= test
+# more programs of the test, built by rules of its own Makefile
+VARIANTS   ?=
+
+CFLAGS     += -g $(OPT) -Wall -D__RTTHREAD__ $(SANITIZE) \
+              -I. -I$(HOST_TESTS)/common -I$(REPO)/rt-thread/include
+LDFLAGS    += $(SANITIZE)
+LDLIBS     += -lpthread -lm
+
+all: $(TARGET) $(VARIANTS)
+
+$(TARGET): $(SRCS) $(wildcard *.h) $(wildcard $(HOST_TESTS)/common/*.h)
+	$(CC) $(CFLAGS) -o $@ $(SRCS) $(LDFLAGS) $(LDLIBS)
+
+check: $(TARGET) $(VARIANTS)
+	@for prog in $(TARGET) $(VARIANTS); do echo ./$$prog $(ARGS); ./$$prog $(ARGS) || exit 1; done
+
+clean:
+	rm -f $(TARGET) $(VARIANTS)
+
+.PHONY: all check clean
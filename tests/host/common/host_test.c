@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+#include <time.h>
+#include "host_test.h"
+
+int host_test_failures;
+
+static uint32_t _seed = 1;
+
+uint64_t host_test_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void host_test_srand(uint32_t seed)
+{
+    _seed = seed ? seed : 1;
+}
+
+uint32_t host_test_rand(void)
+{
+    /* xorshift32 */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+
+    return _seed;
+}
+
+static int _compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+uint64_t host_test_percentile(uint64_t *samples, size_t count, int percent)
+{
+    size_t index;
+
+    if (count == 0)
+        return 0;
+
+    qsort(samples, count, sizeof(uint64_t), _compare_u64);
+    index = (count * percent + 99) / 100;
+
+    return samples[index ? index - 1 : 0];
+}
+
+int host_test_report(const char *name)
+{
+    if (host_test_failures)
+    {
+        printf("%s: FAILED, %d checks failed\n", name, host_test_failures);
+        return 1;
+    }
+
+    printf("%s: passed\n", name);
+    return 0;
+}
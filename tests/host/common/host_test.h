@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern int host_test_failures;
+
+/* Record a failed check and go on, so one run reports all of them. */
+#define CHECK(cond)                                                             \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+/* Monotonic time of the host in nanoseconds. */
+uint64_t host_test_now_ns(void);
+
+/* Deterministic random numbers, the same sequence on every host. */
+void host_test_srand(uint32_t seed);
+uint32_t host_test_rand(void);
+
+/* Sort the samples and return the given percentile of them. */
+uint64_t host_test_percentile(uint64_t *samples, size_t count, int percent);
+
+/* Print the verdict of the test and return its exit status. */
+int host_test_report(const char *name);
+
+#endif /* __HOST_TEST_H__ */
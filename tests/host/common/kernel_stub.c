@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * Every function is weak, the kernel source under test takes precedence.
+ */
+#include <rthw.h>
+#include <rtthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "kernel_stub.h"
+
+rt_tick_t host_tick;
+int host_irq_disabled;
+uint64_t host_irq_off_max_ns;
+uint64_t *host_irq_off_log;
+size_t host_irq_off_log_size;
+size_t host_irq_off_log_count;
+void (*host_irq_handler)(void);
+
+static uint64_t _irq_off_ns;
+static struct rt_thread _self;
+static int _in_irq;
+
+void host_irq_reset_stat(void)
+{
+    host_irq_off_max_ns = 0;
+    host_irq_off_log_count = 0;
+}
+
+RT_WEAK rt_base_t rt_hw_interrupt_disable(void)
+{
+    rt_base_t level = host_irq_disabled;
+
+    if (!host_irq_disabled)
+    {
+        host_irq_disabled = 1;
+        if (host_irq_off_log)
+            _irq_off_ns = host_test_now_ns();
+    }
+
+    return level;
+}
+
+RT_WEAK void rt_hw_interrupt_enable(rt_base_t level)
+{
+    if (host_irq_disabled && !level)
+    {
+        if (host_irq_off_log)
+        {
+            uint64_t span = host_test_now_ns() - _irq_off_ns;
+
+            if (span > host_irq_off_max_ns)
+                host_irq_off_max_ns = span;
+            if (host_irq_off_log_count < host_irq_off_log_size)
+                host_irq_off_log[host_irq_off_log_count++] = span;
+        }
+        host_irq_disabled = 0;
+
+        if (host_irq_handler && !_in_irq)
+        {
+            _in_irq = 1;
+            host_irq_handler();
+            _in_irq = 0;
+        }
+    }
+}
+
+RT_WEAK rt_tick_t rt_tick_get(void) { return host_tick; }
+RT_WEAK rt_tick_t rt_tick_from_millisecond(rt_int32_t ms) { return ms * RT_TICK_PER_SECOND / 1000; }
+RT_WEAK rt_uint16_t rt_critical_level(void) { return 0; }
+RT_WEAK rt_uint8_t rt_interrupt_get_nest(void) { return _in_irq; }
+RT_WEAK void rt_enter_critical(void) { }
+RT_WEAK void rt_exit_critical(void) { }
+RT_WEAK void rt_schedule(void) { }
+RT_WEAK int __rt_ffs(int value) { return __builtin_ffs(value); }
+
+RT_WEAK void rt_object_init(struct rt_object *object, enum rt_object_class_type type, const char *name)
+{
+    object->type = type | RT_Object_Class_Static;
+    snprintf(object->name, RT_NAME_MAX, "%s", name);
+}
+
+RT_WEAK rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
+{
+    /* large enough for any kernel object */
+    rt_object_t object = calloc(1, 512);
+
+    object->type = type;
+    snprintf(object->name, RT_NAME_MAX, "%s", name);
+
+    return object;
+}
+
+RT_WEAK void rt_object_detach(rt_object_t object) { object->type = 0; }
+RT_WEAK void rt_object_delete(rt_object_t object) { free(object); }
+RT_WEAK rt_uint8_t rt_object_get_type(rt_object_t object) { return object->type & ~RT_Object_Class_Static; }
+RT_WEAK rt_bool_t rt_object_is_systemobject(rt_object_t object) { return (object->type & RT_Object_Class_Static) != 0; }
+
+RT_WEAK rt_thread_t rt_thread_self(void) { return &_self; }
+RT_WEAK rt_err_t rt_thread_init(struct rt_thread *thread, const char *name, void (*entry)(void *parameter),
+                                void *parameter, void *stack_start, rt_uint32_t stack_size,
+                                rt_uint8_t priority, rt_uint32_t tick)
+{
+    return RT_EOK;
+}
+RT_WEAK rt_err_t rt_thread_startup(rt_thread_t thread) { return RT_EOK; }
+RT_WEAK rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg) { return RT_EOK; }
+RT_WEAK rt_err_t rt_thread_resume(rt_thread_t thread) { return RT_EOK; }
+RT_WEAK rt_err_t rt_thread_suspend(rt_thread_t thread) { return RT_EOK; }
+RT_WEAK rt_err_t rt_thread_delay(rt_tick_t tick) { host_tick += tick; return RT_EOK; }
+RT_WEAK rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg) { return RT_EOK; }
+RT_WEAK rt_err_t rt_timer_start(rt_timer_t timer) { return RT_EOK; }
+RT_WEAK rt_err_t rt_timer_stop(rt_timer_t timer) { return RT_EOK; }
+
+RT_WEAK void *rt_malloc(rt_size_t size) { return malloc(size); }
+RT_WEAK void *rt_realloc(void *ptr, rt_size_t size) { return realloc(ptr, size); }
+RT_WEAK void *rt_calloc(rt_size_t count, rt_size_t size) { return calloc(count, size); }
+RT_WEAK void rt_free(void *ptr) { free(ptr); }
+
+#ifndef RT_KSERVICE_USING_STDLIB_MEMORY
+RT_WEAK void *rt_memset(void *s, int c, rt_ubase_t count) { return memset(s, c, count); }
+RT_WEAK void *rt_memcpy(void *dst, const void *src, rt_ubase_t count) { return memcpy(dst, src, count); }
+RT_WEAK void *rt_memmove(void *dst, const void *src, rt_size_t count) { return memmove(dst, src, count); }
+RT_WEAK rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_size_t count) { return memcmp(cs, ct, count); }
+#endif /* RT_KSERVICE_USING_STDLIB_MEMORY */
+
+RT_WEAK int rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    return length;
+}
+
+RT_WEAK int rt_sprintf(char *buf, const char *format, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, format);
+    length = vsprintf(buf, format, args);
+    va_end(args);
+
+    return length;
+}
+
+RT_WEAK void rt_set_errno(rt_err_t error) { }
+
+#ifdef RT_USING_CONSOLE
+RT_WEAK int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vprintf(fmt, args);
+    va_end(args);
+
+    return length;
+}
+#endif /* RT_USING_CONSOLE */
+
+RT_WEAK void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    printf("assertion \"%s\" failed in %s:%d\n", ex, func, (int)line);
+    abort();
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+#ifndef __KERNEL_STUB_H__
+#define __KERNEL_STUB_H__
+
+#include <rtthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A single thread kernel for the host tests of kernel sources. The tick is
+ * set by the test, nothing ever blocks, and the interrupt lock can be timed
+ * or let a simulated interrupt in.
+ */
+extern rt_tick_t host_tick;
+
+/* 1 while the interrupt lock is held */
+extern int host_irq_disabled;
+
+/*
+ * When set, the interrupt lock is timed and the length of each is stored
+ * here, until host_irq_off_log_size of them. host_irq_off_max_ns is the
+ * longest since the last reset.
+ */
+extern uint64_t *host_irq_off_log;
+extern size_t host_irq_off_log_size;
+extern size_t host_irq_off_log_count;
+extern uint64_t host_irq_off_max_ns;
+
+void host_irq_reset_stat(void);
+
+/*
+ * When set, it is called as an interrupt each time the interrupt lock is
+ * released, not nested.
+ */
+extern void (*host_irq_handler)(void);
+
+#endif /* __KERNEL_STUB_H__ */
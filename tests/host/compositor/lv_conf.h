@@ -0,0 +1,14 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL with the compositor of the port and the snapshot it renders the LCD plane by. */
+#define LV_COLOR_DEPTH                      16
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        0
+#define LV_USE_SNAPSHOT                     1
+#define LV_USE_COMPOSITOR_N9H30             1
+
+#endif
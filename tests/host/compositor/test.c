@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The layer compositor of lv_compositor_n9h30.c with its software reference:
+ * a background assigned to the LCD plane, the UI on the OSD plane and
+ * transparent by the key, then random frames where the UI moves, rectangles
+ * are drawn into the LCD plane (more than the damage list holds) and objects
+ * are assigned to it again. After each sw_flush the composed image must be
+ * the overlay of both planes everywhere, i.e. no damage was lost, and the
+ * LCD plane is not touched by a UI refresh. Then the frame time of the UI
+ * on the OSD plane against the same screen rendered on one layer.
+ */
+#include "lv_compositor_n9h30.h"
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define HOR_RES             480
+#define VER_RES             272
+#define PIXELS              (HOR_RES * VER_RES)
+#define FRAMES              300
+#define BENCH_FRAMES        200
+
+struct display
+{
+    lv_disp_drv_t drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_disp_t *disp;
+    lv_obj_t *box;
+    lv_obj_t *label;
+};
+
+static lv_color_t _lcd[PIXELS], _osd[PIXELS], _out[PIXELS], _saved[PIXELS];
+static lv_color_t _draw_ui[PIXELS], _draw_one[PIXELS];
+static struct display _ui, _one;
+
+/* the UI display draws into the OSD plane and reports the area */
+static void _flush_osd(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_coord_t y, w = lv_area_get_width(area);
+
+    for (y = area->y1; y <= area->y2; y++, color_p += w)
+        memcpy(&_osd[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+    lv_compositor_n9h30_invalidate(LV_COMPOSITOR_N9H30_PLANE_OSD, area);
+    lv_disp_flush_ready(drv);
+}
+
+static void _flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_disp_flush_ready(drv);
+}
+
+static void _init(struct display *display, lv_color_t *buf, void (*flush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *))
+{
+    lv_disp_draw_buf_init(&display->draw_buf, buf, NULL, PIXELS);
+    lv_disp_drv_init(&display->drv);
+    display->drv.hor_res = HOR_RES;
+    display->drv.ver_res = VER_RES;
+    display->drv.flush_cb = flush;
+    display->drv.draw_buf = &display->draw_buf;
+    display->disp = lv_disp_drv_register(&display->drv);
+}
+
+/* a background worth not rendering again: a gradient and shadowed cards */
+static void _build_background(lv_obj_t *scr)
+{
+    int index;
+
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x003a57), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x8fd3ff), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    for (index = 0; index < 24; index++)
+    {
+        lv_obj_t *card = lv_obj_create(scr);
+
+        lv_obj_set_size(card, 70, 50);
+        lv_obj_set_pos(card, 10 + (index % 6) * 78, 10 + (index / 6) * 64);
+        lv_obj_set_style_radius(card, 12, 0);
+        lv_obj_set_style_shadow_width(card, 16, 0);
+        lv_obj_set_style_bg_color(card, lv_color_hex(0x203040 + index * 0x060504), 0);
+    }
+}
+
+static void _build_ui(struct display *display, lv_obj_t *scr)
+{
+    display->box = lv_obj_create(scr);
+    lv_obj_set_size(display->box, 40, 30);
+    lv_obj_set_style_radius(display->box, 0, 0);
+    lv_obj_set_style_border_width(display->box, 0, 0);
+    lv_obj_set_style_bg_color(display->box, lv_color_hex(0xff0000), 0);
+
+    display->label = lv_label_create(scr);
+    lv_obj_set_pos(display->label, 200, 120);
+    lv_obj_set_style_text_color(display->label, lv_color_hex(0xffffff), 0);
+    lv_label_set_text(display->label, "0 km/h");
+}
+
+/* what the VPOST shows, computed here without the compositor */
+static long _compare(void)
+{
+    lv_color_t key = lv_compositor_n9h30_get_key();
+    long index, bad = 0;
+
+    for (index = 0; index < PIXELS; index++)
+    {
+        lv_color_t expect = _osd[index].full == key.full ? _lcd[index] : _osd[index];
+
+        if (_out[index].full != expect.full)
+            bad++;
+    }
+
+    return bad;
+}
+
+static void _update_ui(struct display *display, int frame)
+{
+    char text[16];
+
+    snprintf(text, sizeof(text), "%d km/h", frame * 7 % 300);
+    lv_label_set_text(display->label, text);
+    lv_obj_set_pos(display->box, (frame * 13) % (HOR_RES - 40), (frame * 5) % (VER_RES - 30));
+}
+
+static void _test_frames(lv_obj_t *background)
+{
+    lv_compositor_n9h30_stat_t stat;
+    long frame, bad = 0, untouched = 0, pixels = 0;
+    lv_obj_t *tile = lv_obj_create(NULL);
+
+    lv_obj_set_size(tile, 60, 40);
+    lv_obj_set_style_bg_color(tile, lv_color_hex(0xffcc00), 0);
+
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        int dice = host_test_rand() % 10;
+
+        /* video or drawing straight into the LCD plane */
+        if (dice < 3)
+        {
+            int count = 1 + host_test_rand() % (LV_COMPOSITOR_N9H30_DAMAGE_MAX + 8), index;
+
+            for (index = 0; index < count; index++)
+            {
+                lv_coord_t x = host_test_rand() % HOR_RES - 10, y = host_test_rand() % VER_RES - 10, row;
+                lv_area_t area;
+                lv_color_t color;
+
+                color.full = host_test_rand();
+                lv_area_set(&area, x, y, x + host_test_rand() % 40, y + host_test_rand() % 30);
+                for (row = LV_MAX(area.y1, 0); row <= LV_MIN(area.y2, VER_RES - 1); row++)
+                {
+                    lv_coord_t col;
+
+                    for (col = LV_MAX(area.x1, 0); col <= LV_MIN(area.x2, HOR_RES - 1); col++)
+                        _lcd[row * HOR_RES + col] = color;
+                }
+                lv_compositor_n9h30_invalidate(LV_COMPOSITOR_N9H30_PLANE_LCD, &area);
+            }
+        }
+        else if (dice == 3)
+        {
+            lv_obj_set_pos(tile, host_test_rand() % HOR_RES - 20, host_test_rand() % VER_RES - 20);
+            CHECK(lv_compositor_n9h30_assign(tile, LV_COMPOSITOR_N9H30_PLANE_LCD) == LV_RES_OK);
+        }
+        else if (dice == 4)
+        {
+            CHECK(lv_compositor_n9h30_assign(background, LV_COMPOSITOR_N9H30_PLANE_LCD) == LV_RES_OK);
+        }
+
+        /* the UI alone leaves the LCD plane as it is */
+        memcpy(_saved, _lcd, sizeof(_lcd));
+        _update_ui(&_ui, frame);
+        lv_refr_now(_ui.disp);
+        if (memcmp(_saved, _lcd, sizeof(_lcd)) != 0)
+            untouched++;
+
+        pixels += lv_compositor_n9h30_sw_flush(_out);
+        if (_compare() != 0 && bad++ < 5)
+            printf("frame %ld: %ld pixels differ from the overlay\n", frame, _compare());
+        CHECK(lv_compositor_n9h30_sw_flush(_out) == 0);
+    }
+
+    CHECK(bad == 0);
+    CHECK(untouched == 0);
+    lv_compositor_n9h30_get_stat(&stat);
+    printf("%ld frames: %u damages, %u merges, %u areas, %.1f%% of the pixels composed\n", frame,
+           (unsigned int)stat.damages, (unsigned int)stat.merges, (unsigned int)stat.composes,
+           100.0 * pixels / ((double)FRAMES * PIXELS));
+
+    lv_obj_del(tile);
+}
+
+/* milliseconds per frame of a UI change */
+static double _bench(struct display *display)
+{
+    uint64_t begin;
+    int frame;
+
+    begin = host_test_now_ns();
+    for (frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        _update_ui(display, frame);
+        lv_refr_now(display->disp);
+    }
+
+    return (host_test_now_ns() - begin) / 1e6 / BENCH_FRAMES;
+}
+
+int main(void)
+{
+    lv_obj_t *background, *ui, *scr;
+    double one_layer, overlay;
+
+    lv_init();
+    _init(&_ui, _draw_ui, _flush_osd);
+    _init(&_one, _draw_one, _flush);
+
+    lv_compositor_n9h30_init(_ui.disp, LV_COMPOSITOR_N9H30_KEY);
+    background = lv_obj_create(NULL);
+    _build_background(background);
+    /* no LCD plane yet */
+    CHECK(lv_compositor_n9h30_assign(background, LV_COMPOSITOR_N9H30_PLANE_LCD) == LV_RES_INV);
+
+    lv_compositor_n9h30_set_plane(LV_COMPOSITOR_N9H30_PLANE_LCD, _lcd, HOR_RES, VER_RES);
+    lv_compositor_n9h30_set_plane(LV_COMPOSITOR_N9H30_PLANE_OSD, _osd, HOR_RES, VER_RES);
+    CHECK(lv_compositor_n9h30_get_buf(LV_COMPOSITOR_N9H30_PLANE_LCD) == _lcd);
+    CHECK(lv_compositor_n9h30_assign(background, LV_COMPOSITOR_N9H30_PLANE_LCD) == LV_RES_OK);
+
+    ui = lv_obj_create(NULL);
+    lv_compositor_n9h30_set_transparent(ui);
+    _build_ui(&_ui, ui);
+    /* only a screen is loaded on the OSD plane */
+    CHECK(lv_compositor_n9h30_assign(_ui.box, LV_COMPOSITOR_N9H30_PLANE_OSD) == LV_RES_INV);
+    CHECK(lv_compositor_n9h30_assign(ui, LV_COMPOSITOR_N9H30_PLANE_OSD) == LV_RES_OK);
+    CHECK(lv_disp_get_scr_act(_ui.disp) == ui);
+
+    lv_refr_now(_ui.disp);
+    lv_compositor_n9h30_sw_flush(_out);
+    CHECK(_compare() == 0);
+    /* the box of the UI over the card of the background, the background beside it */
+    CHECK(_out[5 * HOR_RES + 5].full == lv_color_hex(0xff0000).full);
+    CHECK(_out[VER_RES / 2 * HOR_RES + 5].full == _lcd[VER_RES / 2 * HOR_RES + 5].full);
+    CHECK(_out[VER_RES / 2 * HOR_RES + 5].full != lv_compositor_n9h30_get_key().full);
+
+    host_test_srand(18);
+    _test_frames(background);
+
+    /* the same screen on one layer: the background is rendered under every change */
+    scr = lv_disp_get_scr_act(_one.disp);
+    _build_background(scr);
+    _build_ui(&_one, scr);
+    lv_refr_now(_one.disp);
+    one_layer = _bench(&_one);
+    overlay = _bench(&_ui);
+    printf("ms per frame    one layer %.3f    OSD over LCD %.3f\n", one_layer, overlay);
+
+    return host_test_report("compositor");
+}
@@ -0,0 +1,17 @@
+#ifndef _FAL_CFG_H_
+#define _FAL_CFG_H_
+
+/* A NOR flash of 1 MB in RAM, see test.c, and the file system partition on it. */
+extern struct fal_flash_dev host_flash;
+
+#define FAL_FLASH_DEV_TABLE                                                    \
+{                                                                              \
+    &host_flash,                                                               \
+}
+
+#define FAL_PART_TABLE                                                         \
+{                                                                              \
+    {FAL_PART_MAGIC_WORD, "fs", "hostflash", 64 * 1024, 512 * 1024, 0},       \
+}
+
+#endif /* _FAL_CFG_H_ */
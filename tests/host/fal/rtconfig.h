@@ -0,0 +1,36 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The FAL block device with the erase block cache, on a NOR flash in RAM. */
+
+#ifndef HOST_SECTOR_SIZE
+#define HOST_SECTOR_SIZE 0
+#endif
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_USING_HEAP
+#define RT_USING_MUTEX
+#define RT_USING_DEVICE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#define RT_VER_NUM 0x50000
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#define RT_USING_FAL
+#define FAL_PART_HAS_TABLE_CFG
+#if !defined(HOST_NO_CACHE)
+#define FAL_USING_BLK_CACHE
+#define FAL_BLK_CACHE_BLOCKS 2
+#define FAL_BLK_SECTOR_SIZE HOST_SECTOR_SIZE
+#endif
+
+#endif
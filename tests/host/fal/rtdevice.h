@@ -0,0 +1,7 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* fal_rtt.c needs only the block device of rtdef.h without MTD and POSIX, and the cast of rtdevice.h. */
+#define RT_DEVICE(device)            ((rt_device_t)device)
+
+#endif
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The block device of fal_rtt.c with its erase block cache, on a flash in
+ * RAM which counts the erases and the programs and keeps the rules of a
+ * flash: a NOR flash only clears bits, a flash with a write granularity
+ * takes a unit once after erasing. A FAT-like pattern of appends with the
+ * FAT and directory sectors rewritten, then random reads, writes, syncs and
+ * trims against a model: reads must see every write, the flash must be the
+ * model after each sync and the last close, and nothing may be programmed
+ * without the erase it needed. test has sectors of the erase block, test_512
+ * of 512 bytes, test_gran on a flash of 32 bits words, test_nocache is the
+ * device without the cache, erasing at every write.
+ */
+#include <rtthread.h>
+#include <fal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+
+#ifndef HOST_WRITE_GRAN
+#define HOST_WRITE_GRAN     1
+#endif
+
+#define FLASH_SIZE          (1024 * 1024)
+#define BLOCK_SIZE          4096
+#define PART_OFFSET         (64 * 1024)
+#define PART_SIZE           (512 * 1024)
+#define LOOPS               200000
+#define SYNC_PERIOD         5000
+#define TRIM_PERIOD         7777
+
+static rt_uint8_t _flash[FLASH_SIZE], _model[PART_SIZE], _buf[2 * BLOCK_SIZE];
+static long _erases, _programs, _violations;
+
+/* the flash */
+static int _flash_init(void) { return 0; }
+
+static int _flash_read(long offset, uint8_t *buf, size_t size)
+{
+    memcpy(buf, _flash + offset, size);
+
+    return size;
+}
+
+static int _flash_write(long offset, const uint8_t *buf, size_t size)
+{
+    size_t index;
+
+    _programs++;
+    if (HOST_WRITE_GRAN > 1 && (offset % (HOST_WRITE_GRAN / 8) || size % (HOST_WRITE_GRAN / 8)))
+        _violations++;
+    for (index = 0; index < size; index++)
+    {
+        if (HOST_WRITE_GRAN > 1 ? _flash[offset + index] != 0xFF : (buf[index] & ~_flash[offset + index]) != 0)
+            _violations++;
+        _flash[offset + index] &= buf[index];
+    }
+
+    return size;
+}
+
+static int _flash_erase(long offset, size_t size)
+{
+    CHECK(offset % BLOCK_SIZE == 0 && size % BLOCK_SIZE == 0);
+    memset(_flash + offset, 0xFF, size);
+    _erases += size / BLOCK_SIZE;
+
+    return size;
+}
+
+struct fal_flash_dev host_flash =
+{
+    .name = "hostflash",
+    .addr = 0,
+    .len = FLASH_SIZE,
+    .blk_size = BLOCK_SIZE,
+    .ops = { _flash_init, _flash_read, _flash_write, _flash_erase },
+    .write_gran = HOST_WRITE_GRAN,
+};
+
+/* one thread, the lock only has to be balanced */
+static int _lock_held;
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) { return RT_EOK; }
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    _lock_held++;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    CHECK(_lock_held > 0);
+    _lock_held--;
+
+    return RT_EOK;
+}
+
+/* files of 8 KB appended one after the other, the FAT and the directory updated for each */
+static void _test_fat(rt_device_t dev, rt_uint32_t sector_size)
+{
+    rt_uint32_t fat = 1, dir = 2 * BLOCK_SIZE / sector_size, data = 8 * BLOCK_SIZE / sector_size;
+    int file, index, writes = 0;
+
+    _erases = _programs = 0;
+    for (file = 0; file < 16; file++)
+    {
+        for (index = 0; index < 8192 / sector_size; index++)
+        {
+            memset(_buf, file + index, sector_size);
+            CHECK(rt_device_write(dev, data++, _buf, 1) == 1);
+        }
+        memset(_buf, 0, sector_size);
+        _buf[file] = file;
+        CHECK(rt_device_write(dev, fat, _buf, 1) == 1);
+        _buf[0] = file;
+        CHECK(rt_device_write(dev, dir, _buf, 1) == 1);
+        writes += index + 2;
+        CHECK(rt_device_control(dev, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL) == RT_EOK);
+    }
+
+    CHECK(_violations == 0);
+#ifdef FAL_USING_BLK_CACHE
+    /* no more erases than the 32 erase blocks of data, one for each write without the cache */
+    CHECK(_erases <= 32);
+#endif
+    printf("16 files of 8 KB: %d writes of %u bytes, %ld erases, %ld programs\n",
+           writes, (unsigned int)sector_size, _erases, _programs);
+}
+
+/* blank, random or only clearing bits of what is there */
+static void _fill(rt_uint8_t *buf, const rt_uint8_t *old, rt_size_t size)
+{
+    int kind = host_test_rand() % 3;
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+        buf[index] = kind == 0 ? 0xFF : kind == 1 ? host_test_rand() : old[index] & host_test_rand();
+}
+
+static void _test_random(rt_device_t dev, rt_uint32_t sector_size, rt_uint32_t sectors)
+{
+    rt_uint32_t per_block = BLOCK_SIZE / sector_size;
+    long loop, mismatches = 0, flash_mismatches = 0;
+
+    memset(_flash, 0xFF, sizeof(_flash));
+    memset(_model, 0xFF, sizeof(_model));
+    _erases = _programs = _violations = 0;
+#ifdef FAL_USING_BLK_CACHE
+    CHECK(fal_blk_device_stat(dev, RT_NULL, 1) == 0);
+#endif
+
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        rt_uint32_t count = 1 + host_test_rand() % (2 * per_block);
+        rt_uint32_t pos = host_test_rand() % (sectors - count + 1);
+
+        if (host_test_rand() % 2)
+        {
+            _fill(_buf, _model + pos * sector_size, count * sector_size);
+            CHECK(rt_device_write(dev, pos, _buf, count) == count);
+            memcpy(_model + pos * sector_size, _buf, count * sector_size);
+        }
+        else
+        {
+            CHECK(rt_device_read(dev, pos, _buf, count) == count);
+            if (memcmp(_buf, _model + pos * sector_size, count * sector_size) != 0 && mismatches++ < 5)
+                printf("loop %ld: %u sectors at %u differ\n", loop, (unsigned int)count, (unsigned int)pos);
+        }
+
+        if (loop % SYNC_PERIOD == 0)
+        {
+            CHECK(rt_device_control(dev, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL) == RT_EOK);
+            if (memcmp(_flash + PART_OFFSET, _model, PART_SIZE) != 0)
+                flash_mismatches++;
+        }
+
+        if (loop % TRIM_PERIOD == 0)
+        {
+            rt_uint32_t range[2] = { pos, pos + host_test_rand() % (3 * per_block) };
+            rt_uint32_t first, last;
+
+            if (range[1] >= sectors)
+                range[1] = sectors - 1;
+            CHECK(rt_device_control(dev, RT_DEVICE_CTRL_BLK_ERASE, range) == RT_EOK);
+
+            /* only the erase blocks covered entirely are erased */
+            first = (range[0] + per_block - 1) / per_block;
+            last = (range[1] == range[0] ? range[0] + 1 : range[1]) / per_block;
+            if (first < last)
+                memset(_model + first * BLOCK_SIZE, 0xFF, (last - first) * BLOCK_SIZE);
+        }
+        CHECK(_lock_held == 0);
+    }
+
+    /* the last close is the unmount */
+    CHECK(rt_device_close(dev) == RT_EOK);
+    if (memcmp(_flash + PART_OFFSET, _model, PART_SIZE) != 0)
+        flash_mismatches++;
+
+    CHECK(mismatches == 0);
+    CHECK(flash_mismatches == 0);
+    CHECK(_violations == 0);
+    printf("%d random operations: %ld mismatches, the flash %ld times, %ld programs without erase, "
+           "%ld erases, %ld programs\n", LOOPS, mismatches, flash_mismatches, _violations, _erases, _programs);
+
+#ifdef FAL_USING_BLK_CACHE
+    {
+        struct fal_blk_stat stat;
+
+        CHECK(fal_blk_device_stat(dev, &stat, 0) == 0);
+        CHECK(stat.erases == _erases && stat.programs == _programs);
+        printf("cache: %u sectors written, %u hits, %u write-backs, %u without erase\n",
+               (unsigned int)stat.writes, (unsigned int)stat.hits, (unsigned int)stat.writebacks,
+               (unsigned int)stat.skipped);
+    }
+#endif
+}
+
+int main(void)
+{
+    struct rt_device_blk_geometry geometry;
+    rt_device_t dev;
+    char name[32];
+
+    memset(_flash, 0xFF, sizeof(_flash));
+    CHECK(fal_init() > 0);
+    CHECK(fal_blk_device_create("nopart") == RT_NULL);
+    dev = fal_blk_device_create("fs");
+    CHECK(dev != RT_NULL && rt_device_find("fs") == dev);
+    if (dev == RT_NULL)
+        return host_test_report("fal");
+
+    CHECK(rt_device_control(dev, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry) == RT_EOK);
+    CHECK(geometry.block_size == BLOCK_SIZE);
+    CHECK(geometry.bytes_per_sector * geometry.sector_count == PART_SIZE);
+#ifdef FAL_USING_BLK_CACHE
+    {
+        struct rt_device other;
+
+        memset(&other, 0, sizeof(other));
+        CHECK(fal_blk_device_stat(RT_NULL, RT_NULL, 0) == -1);
+        CHECK(fal_blk_device_stat(&other, RT_NULL, 0) == -1);
+    }
+#endif
+    CHECK(rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+
+    host_test_srand(24);
+    _test_fat(dev, geometry.bytes_per_sector);
+    _test_random(dev, geometry.bytes_per_sector, geometry.sector_count);
+
+    snprintf(name, sizeof(name), "fal %u%s%s", (unsigned int)geometry.bytes_per_sector,
+             HOST_WRITE_GRAN > 1 ? " gran" : "",
+#ifdef FAL_USING_BLK_CACHE
+             "");
+#else
+             " no cache");
+#endif
+
+    return host_test_report(name);
+}
@@ -0,0 +1,17 @@
+#ifndef __NUMICRO_H__
+#define __NUMICRO_H__
+
+/* The registers of the N9H30, their accesses go to the model of the engine in test.c. */
+#include "N9H30.h"
+#include "nu_sys.h"
+#include "nu_2d.h"
+
+#undef outpw
+#undef inpw
+#define outpw(port, value)  host_outpw((UINT32)(port), (UINT32)(value))
+#define inpw(port)          host_inpw((UINT32)(port))
+
+void host_outpw(UINT32 port, UINT32 value);
+UINT32 host_inpw(UINT32 port);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The GE2D driver of the N9H30 with its completion interrupt. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_USING_HEAP
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_DEVICE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#endif
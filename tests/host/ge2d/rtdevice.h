@@ -0,0 +1,7 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* drv_2dge.c needs the completion, test.c gives it the model of the engine. */
+#include "ipc/completion.h"
+
+#endif
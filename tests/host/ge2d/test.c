@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The command queue of drv_2dge.c on a model of the 2D graphic engine. The
+ * engine finishes a command at any register access or wait, and raises its
+ * interrupt, held while interrupts are disabled. Fills, blits and rotations
+ * are queued at random with syncs and legacy calls in between: every command
+ * must reach the engine once, in order, only when it is idle, and the frame
+ * buffers must end up as if drawn one by one. Then the engine hangs and the
+ * queue must recover.
+ */
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+#include "kernel_stub.h"
+#include "NuMicro.h"
+#include "drv_sys.h"
+
+#define FB_WIDTH            96
+#define FB_HEIGHT           64
+#define SPRITE_SIZE         24
+#define QUEUE_LOOPS         40000
+#define CMD_MAX             (QUEUE_LOOPS + 16)
+
+#define REG(port)           _regs[((port) - GE_BA) / 4]
+
+/* the registers of a command when the engine is triggered */
+struct ge_cmd
+{
+    UINT32 ctl, misc, sorg, dorg, pitch, dstspa, dim, fg, bg;
+};
+
+/* the model */
+static UINT32 _regs[0x80 / 4];
+static struct ge_cmd _current;
+static int _busy, _hang, _irq_pending, _in_isr;
+static rt_isr_handler_t _isr;
+static long _trg_busy, _reset_busy, _resets, _lost_wakeups;
+
+/* the commands submitted by the test and those triggered on the engine */
+static struct ge_cmd _expected[CMD_MAX], _issued[CMD_MAX];
+static int _expected_count, _issued_count, _done_count;
+
+struct frame
+{
+    int bpp;
+    rt_uint8_t *buf;            /* drawn by the model of the engine */
+    rt_uint8_t *shadow;         /* drawn by the test at submitting */
+};
+
+static struct frame _fb[2];
+static rt_uint8_t *_sprite[2];
+
+/* The driver keeps buffer addresses in 32 bits as on the target. */
+static void *_map32(size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory;
+
+#ifdef MAP_32BIT
+    flags |= MAP_32BIT;
+#endif
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED || (rt_ubase_t)memory + size > 0xFFFFFFFFUL)
+    {
+        printf("no memory below 4 GB\n");
+        exit(1);
+    }
+
+    return memory;
+}
+
+static UINT32 _pixel_get(const rt_uint8_t *pixel, int bpp)
+{
+    if (bpp == 32)
+        return *(const UINT32 *)pixel;
+    if (bpp == 16)
+        return *(const rt_uint16_t *)pixel;
+
+    return *pixel;
+}
+
+static void _pixel_set(rt_uint8_t *pixel, int bpp, UINT32 value)
+{
+    if (bpp == 32)
+        *(UINT32 *)pixel = value;
+    else if (bpp == 16)
+        *(rt_uint16_t *)pixel = (rt_uint16_t)value;
+    else
+        *pixel = (rt_uint8_t)value;
+}
+
+/* Ks * source + Kd * destination per 8-bit lane, the same for the model and the test */
+static UINT32 _blend(UINT32 src, UINT32 dst, int ks, int kd)
+{
+    UINT32 result = 0;
+    int shift;
+
+    for (shift = 0; shift < 32; shift += 8)
+        result |= (((src >> shift & 0xff) * ks + (dst >> shift & 0xff) * kd) / 255) << shift;
+
+    return result;
+}
+
+/* Draw a command on the memory it points to, as the engine does. Rotations are only logged. */
+static void _draw(const struct ge_cmd *cmd, int shadow)
+{
+    int bpp = (cmd->misc & GE_BPP_32) ? 32 : (cmd->misc & GE_BPP_16) ? 16 : 8;
+    int dst_pitch = cmd->pitch >> 16, src_pitch = cmd->pitch & 0xffff;
+    int dx = cmd->dstspa & 0xffff, dy = cmd->dstspa >> 16;
+    int width = cmd->dim & 0xffff, height = cmd->dim >> 16;
+    rt_uint8_t *dst = (rt_uint8_t *)(rt_ubase_t)cmd->dorg, *src = (rt_uint8_t *)(rt_ubase_t)cmd->sorg;
+    int x, y, index;
+
+    if ((cmd->ctl & 0x00400000) == 0)
+        return;
+
+    if (shadow)
+    {
+        /* the same spot of the shadow copy */
+        for (index = 0; index < 2; index++)
+        {
+            if (dst == _fb[index].buf)
+                dst = _fb[index].shadow;
+        }
+    }
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < width; x++)
+        {
+            rt_uint8_t *pixel = dst + ((dy + y) * dst_pitch + dx + x) * (bpp / 8);
+            UINT32 value;
+
+            if (cmd->ctl & 0x40)
+                value = (cmd->ctl & 0x20) ? cmd->fg : cmd->bg;
+            else
+                value = _pixel_get(src + (y * src_pitch + x) * (bpp / 8), bpp);
+
+            if (cmd->ctl & 0x00200000)
+                value = _blend(value, _pixel_get(pixel, bpp), cmd->misc >> 24 & 0xff, cmd->misc >> 16 & 0xff);
+            _pixel_set(pixel, bpp, value);
+        }
+    }
+}
+
+static void _deliver(void)
+{
+    if (host_irq_disabled || _in_isr)
+        return;
+
+    _in_isr = 1;
+    while (_irq_pending)
+    {
+        _irq_pending = 0;
+        if (REG(REG_GE2D_INTSTS) & 1)
+            _isr(IRQ_GE2D, RT_NULL);
+    }
+    _in_isr = 0;
+}
+
+/* the engine finishes the command and raises its interrupt */
+static void _finish(void)
+{
+    _draw(&_current, 0);
+    _busy = 0;
+    _done_count++;
+    REG(REG_GE2D_INTSTS) |= 1;
+    _irq_pending = 1;
+    _deliver();
+}
+
+/* time passes at each access */
+static void _access(void)
+{
+    if (_busy && !_hang && host_test_rand() % 4 == 0)
+        _finish();
+}
+
+void host_outpw(UINT32 port, UINT32 value)
+{
+    _access();
+
+    if (port == REG_GE2D_TRG)
+    {
+        if (_busy)
+        {
+            _trg_busy++;
+            return;
+        }
+        _current.ctl = REG(REG_GE2D_CTL);
+        _current.misc = REG(REG_GE2D_MISCTL);
+        _current.sorg = REG(REG_GE2D_XYSORG);
+        _current.dorg = REG(REG_GE2D_XYDORG);
+        _current.pitch = REG(REG_GE2D_SDPITCH);
+        _current.dstspa = REG(REG_GE2D_DSTSPA);
+        _current.dim = REG(REG_GE2D_RTGLSZ);
+        _current.fg = REG(REG_GE2D_FGCOLR);
+        _current.bg = REG(REG_GE2D_BGCOLR);
+        if (_issued_count < CMD_MAX)
+            _issued[_issued_count++] = _current;
+        _busy = 1;
+    }
+    else if (port == REG_GE2D_INTSTS)
+    {
+        REG(port) &= ~value;
+    }
+    else if (port == REG_GE2D_MISCTL && (value & 0x80))
+    {
+        /* engine reset, the command in progress is lost */
+        if (_busy && !_hang)
+            _reset_busy++;
+        _busy = 0;
+        _resets++;
+        REG(port) = value;
+    }
+    else if (port >= GE_BA && port < GE_BA + sizeof(_regs))
+    {
+        REG(port) = value;
+    }
+}
+
+UINT32 host_inpw(UINT32 port)
+{
+    _access();
+
+    return REG(port);
+}
+
+/* The waiting thread lets the engine run until the completion, with interrupts enabled. */
+void rt_completion_init(struct rt_completion *completion)
+{
+    completion->flag = 0;
+}
+
+void rt_completion_done(struct rt_completion *completion)
+{
+    completion->flag = 1;
+}
+
+rt_err_t rt_completion_wait(struct rt_completion *completion, rt_int32_t timeout)
+{
+    CHECK(!host_irq_disabled);
+
+    while (!completion->flag)
+    {
+        if (_hang)
+            return -RT_ETIMEOUT;
+        if (!_busy)
+        {
+            /* nothing left to wake the thread up */
+            _lost_wakeups++;
+            return -RT_ETIMEOUT;
+        }
+        _finish();
+    }
+    completion->flag = 0;
+
+    return RT_EOK;
+}
+
+/* one thread, the lock is taken by ge2dInit and released by the legacy call after it */
+static struct rt_mutex _lock;
+static int _lock_held;
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    return &_lock;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
+{
+    CHECK(!_lock_held);
+    _lock_held = 1;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    CHECK(_lock_held);
+    _lock_held = 0;
+
+    return RT_EOK;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    return aligned_alloc(align, RT_ALIGN(size, align));
+}
+
+void rt_free_align(void *ptr)
+{
+    free(ptr);
+}
+
+/* drv_2dge.c has it for INIT_DEVICE_EXPORT only */
+int rt_hw_ge2d_init(void);
+
+rt_isr_handler_t rt_hw_interrupt_install(int vector, rt_isr_handler_t handler, void *param, const char *name)
+{
+    _isr = handler;
+
+    return RT_NULL;
+}
+
+void rt_hw_interrupt_umask(int vector) { }
+void nu_sys_ipclk_enable(E_SYS_IPCLK eIPClkIdx) { }
+
+/* the command the driver must trigger for a queued call, also drawn on the shadow */
+static void _expect(UINT32 ctl, struct frame *frame, void *src, int src_pitch, int x, int y,
+                    int width, int height, UINT32 color, int alpha)
+{
+    struct ge_cmd *cmd = &_expected[_expected_count++];
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->ctl = ctl;
+    cmd->misc = frame->bpp == 32 ? GE_BPP_32 : GE_BPP_16;
+    if (alpha < 255)
+        cmd->misc |= (UINT32)((alpha << 8) | (255 - alpha)) << 16;
+    cmd->sorg = (UINT32)(rt_ubase_t)(src ? src : frame->buf);
+    cmd->dorg = (UINT32)(rt_ubase_t)frame->buf;
+    cmd->pitch = FB_WIDTH << 16 | src_pitch;
+    cmd->dstspa = y << 16 | x;
+    cmd->dim = height << 16 | width;
+    cmd->fg = color;
+    _draw(cmd, 1);
+}
+
+/* a legacy clear of the whole frame, it has no place in the queue */
+static void _expect_clear(struct frame *frame, UINT32 color)
+{
+    struct ge_cmd clear = { 0xcc430040, GE_BPP_32, 0, (UINT32)(rt_ubase_t)frame->buf,
+                            FB_WIDTH << 16, 0, FB_HEIGHT << 16 | FB_WIDTH, 0, color };
+
+    _draw(&clear, 1);
+    memset(&_expected[_expected_count++], 0, sizeof(struct ge_cmd));
+}
+
+static long _mismatch;
+
+/* the commands triggered so far are the expected ones */
+static void _compare(int count)
+{
+    int index;
+
+    for (index = 0; index < count; index++)
+    {
+        const struct ge_cmd *want = &_expected[index], *got = &_issued[index];
+
+        if (want->ctl == 0)
+            continue;       /* a legacy call, only its place in the order counts */
+        if (got->ctl != want->ctl || got->misc != want->misc || got->dorg != want->dorg ||
+            got->pitch != want->pitch || got->dstspa != want->dstspa || got->dim != want->dim ||
+            ((want->ctl & 0x60) == 0x60 ? got->fg != want->fg : got->sorg != want->sorg))
+        {
+            if (_mismatch++ < 5)
+                printf("command %d: ctl %08x/%08x dstspa %08x/%08x\n", index,
+                       (unsigned)got->ctl, (unsigned)want->ctl, (unsigned)got->dstspa, (unsigned)want->dstspa);
+        }
+    }
+}
+
+static void _sync_and_check(void)
+{
+    int index;
+
+    ge2dQueue_Sync();
+    CHECK(ge2dQueue_IsIdle());
+    CHECK(!_busy);
+    CHECK(_issued_count == _expected_count);
+    CHECK(_done_count == _issued_count);
+    _compare(_issued_count);
+    for (index = 0; index < 2; index++)
+        CHECK(memcmp(_fb[index].buf, _fb[index].shadow, FB_WIDTH * FB_HEIGHT * _fb[index].bpp / 8) == 0);
+}
+
+static void _test_queue(void)
+{
+    static const int rops[] = { SRCCOPY, SRCCOPY, SRCCOPY, SRCINVERT };
+    long loop, syncs = 0, legacy = 0;
+
+    host_test_srand(5);
+    for (loop = 0; loop < QUEUE_LOOPS; loop++)
+    {
+        rt_uint32_t dice = host_test_rand() % 100;
+        struct frame *frame = &_fb[host_test_rand() % 2];
+        int width = 1 + host_test_rand() % SPRITE_SIZE, height = 1 + host_test_rand() % SPRITE_SIZE;
+        int x = host_test_rand() % (FB_WIDTH - width + 1), y = host_test_rand() % (FB_HEIGHT - height + 1);
+        UINT32 color = host_test_rand() & (frame->bpp == 32 ? 0xffffffff : 0xffff);
+
+        if (dice < 40)
+        {
+            int rop = rops[host_test_rand() % 4];
+
+            /* the model draws the other ROPs as a copy, only their registers count */
+            if (rop != SRCCOPY)
+            {
+                CHECK(ge2dQueue_FillRop(frame->buf, FB_WIDTH, frame->bpp, x, y, width, height, color, rop) == 0);
+                _expect((UINT32)rop << 24 | 0x00430060, frame, RT_NULL, 0, x, y, width, height, color, 255);
+            }
+            else
+            {
+                CHECK(ge2dQueue_Fill(frame->buf, FB_WIDTH, frame->bpp, x, y, width, height, color) == 0);
+                _expect(0xcc430060, frame, RT_NULL, 0, x, y, width, height, color, 255);
+            }
+        }
+        else if (dice < 60)
+        {
+            rt_uint8_t *sprite = _sprite[frame->bpp == 32];
+            int alpha = host_test_rand() % 2 ? 255 : host_test_rand() % 256;
+
+            CHECK(ge2dQueue_SpriteBlt(frame->buf, FB_WIDTH, frame->bpp, x, y, width, height,
+                                      sprite, SPRITE_SIZE, alpha) == 0);
+            _expect(alpha < 255 ? 0xcc630000 : 0xcc430000, frame, sprite, SPRITE_SIZE, x, y, width, height, 0, alpha);
+        }
+        else if (dice < 64)
+        {
+            rt_uint8_t *sprite = _sprite[frame->bpp == 32];
+            int ctl = host_test_rand() % 8;
+
+            CHECK(ge2dQueue_Rotation(frame->buf, FB_WIDTH, frame->bpp, x, y, width, height,
+                                     sprite, SPRITE_SIZE, ctl) == 0);
+            _expect(0xcc030000 | ctl << 1, frame, sprite, SPRITE_SIZE, x, y, width, height, 0, 255);
+        }
+        else if (dice < 67)
+        {
+            _sync_and_check();
+            syncs++;
+        }
+        else if (dice < 68)
+        {
+            /* a legacy call takes the engine over: whole screen in background color */
+            ge2dInit(32, FB_WIDTH, FB_HEIGHT, _fb[1].buf);
+            CHECK(!_busy && _issued_count == _expected_count);
+            ge2dClearScreen(color & 0xffffff);
+            _expect_clear(&_fb[1], color & 0xffffff);
+            legacy++;
+        }
+        else
+        {
+            /* the CPU draws something else */
+            _access();
+        }
+
+        CHECK(!_lock_held);
+        if (host_test_failures > 20)
+            break;
+    }
+    _sync_and_check();
+
+    CHECK(_trg_busy == 0);
+    CHECK(_reset_busy == 0);
+    CHECK(_lost_wakeups == 0);
+    CHECK(_mismatch == 0);
+    printf("%d commands, %ld syncs, %ld legacy calls\n", _issued_count, syncs, legacy);
+}
+
+/* the engine stops answering: the queue is dropped and the engine reset, then it works again */
+static void _test_hang(void)
+{
+    long resets = _resets;
+    int index, done;
+
+    _hang = 1;
+    for (index = 0; index < 5; index++)
+        CHECK(ge2dQueue_Fill(_fb[0].buf, FB_WIDTH, 16, index, 0, 1, 1, 0x1234) == 0);
+    ge2dQueue_Sync();
+    CHECK(ge2dQueue_IsIdle());
+    CHECK(_resets == resets + 1);
+    CHECK(!_busy);
+    _hang = 0;
+
+    done = _done_count;
+    CHECK(ge2dQueue_Fill(_fb[0].buf, FB_WIDTH, 16, 0, 0, 1, 1, 0x4321) == 0);
+    ge2dQueue_Sync();
+    CHECK(_done_count == done + 1);
+    CHECK(*(rt_uint16_t *)_fb[0].buf == 0x4321);
+    CHECK(_lost_wakeups == 0);
+    CHECK(!_lock_held);
+}
+
+int main(void)
+{
+    int index;
+
+    for (index = 0; index < 2; index++)
+    {
+        _fb[index].bpp = index ? 32 : 16;
+        _fb[index].buf = _map32(FB_WIDTH * FB_HEIGHT * 4);
+        _fb[index].shadow = malloc(FB_WIDTH * FB_HEIGHT * 4);
+        memset(_fb[index].shadow, 0, FB_WIDTH * FB_HEIGHT * 4);
+        _sprite[index] = _map32(SPRITE_SIZE * SPRITE_SIZE * 4);
+    }
+    host_test_srand(6);
+    for (index = 0; index < SPRITE_SIZE * SPRITE_SIZE * 4; index++)
+    {
+        _sprite[0][index] = host_test_rand();
+        _sprite[1][index] = host_test_rand();
+    }
+
+    host_irq_handler = _deliver;
+    rt_hw_ge2d_init();
+
+    _test_queue();
+    _test_hang();
+
+    return host_test_report("ge2d");
+}
@@ -0,0 +1,22 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL with the fonts of the test screen and the glyph atlas of the port. */
+#ifndef HOST_GLYPH_CACHE_SIZE
+#define HOST_GLYPH_CACHE_SIZE (64 * 1024)
+#endif
+
+#define LV_COLOR_DEPTH                      16
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        0
+#define LV_USE_FONT_COMPRESSED              1
+#define LV_FONT_MONTSERRAT_16               1
+#define LV_FONT_MONTSERRAT_28_COMPRESSED    1
+#define LV_FONT_SIMSUN_16_CJK               1
+#define LV_USE_GLYPH_CACHE                  1
+#define LV_GLYPH_CACHE_SIZE                 HOST_GLYPH_CACHE_SIZE
+
+#endif
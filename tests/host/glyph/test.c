@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The glyph atlas of lv_glyph_cache.c against lv_draw_sw_letter: the same
+ * screen on two displays, one drawing its letters through the atlas, with
+ * labels in compressed Montserrat, SimSun CJK, half opacity, clipped by the
+ * screen and masked by a rounded corner. The frames must be the same pixel
+ * for pixel while the text changes, then the render time of either display.
+ * test keeps the 64 KB atlas of the board, test_8k evicts all the time.
+ */
+#include "lv_glyph_cache.h"
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define HOR_RES             480
+#define VER_RES             272
+#define FRAMES              100
+
+struct display
+{
+    lv_disp_drv_t drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_disp_t *disp;
+    lv_color_t fb[HOR_RES * VER_RES];
+    lv_obj_t *cjk;
+    lv_obj_t *digits;
+};
+
+static struct display _plain, _cached;
+
+static const char *_cjk[] =
+{
+    "中文字体测试数据显示温度压力速度电压电流功率频率时间日期年月日星期一二三四五六七八九十百千万",
+    "设置系统网络无线蓝牙声音亮度语言键盘存储电池关于版本更新恢复出厂重启关机确定取消返回主页",
+    "报警记录历史曲线趋势参数配置用户登录密码权限管理打印导出导入文件目录帮助说明联系客服",
+    "上午下午今天明天昨天晴多云阴小雨中雨大雨雷阵雪雾风向风力湿度气压紫外线指数空气质量良好",
+};
+
+static void _flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_disp_flush_ready(drv);
+}
+
+static void _build(struct display *display)
+{
+    lv_obj_t *scr = lv_disp_get_scr_act(display->disp), *label, *box;
+
+    label = lv_label_create(scr);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "0123456789 km/h 88.8%");
+    lv_obj_set_pos(label, -7, 3);
+    display->digits = label;
+
+    label = lv_label_create(scr);
+    lv_obj_set_style_text_font(label, &lv_font_simsun_16_cjk, 0);
+    lv_label_set_text(label, _cjk[0]);
+    lv_obj_set_width(label, 300);
+    lv_obj_set_pos(label, 10, 40);
+    display->cjk = label;
+
+    label = lv_label_create(scr);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+    lv_label_set_text(label, "Half opa text Wg@#");
+    lv_obj_set_pos(label, 10, 150);
+
+    label = lv_label_create(scr);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "Bottom clip");
+    lv_obj_set_pos(label, 300, VER_RES - 15);
+
+    box = lv_obj_create(scr);
+    lv_obj_set_size(box, 150, 80);
+    lv_obj_set_pos(box, 320, 100);
+    lv_obj_set_style_radius(box, 30, 0);
+    lv_obj_set_style_clip_corner(box, true, 0);
+    lv_obj_set_style_pad_all(box, 0, 0);
+    label = lv_label_create(box);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xff3300), 0);
+    lv_label_set_text(label, "MASKED\nCORNER\nTEXT");
+    lv_obj_set_pos(label, -5, -5);
+}
+
+static void _init(struct display *display, int cached)
+{
+    lv_disp_draw_buf_init(&display->draw_buf, display->fb, NULL, HOR_RES * VER_RES);
+    lv_disp_drv_init(&display->drv);
+    display->drv.hor_res = HOR_RES;
+    display->drv.ver_res = VER_RES;
+    display->drv.flush_cb = _flush;
+    display->drv.draw_buf = &display->draw_buf;
+    display->drv.full_refresh = 1;
+    if (cached)
+        display->drv.draw_ctx_init = lv_glyph_cache_ctx_init;
+    display->disp = lv_disp_drv_register(&display->drv);
+    _build(display);
+}
+
+static void _render(struct display *display)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(display->disp));
+    lv_refr_now(display->disp);
+}
+
+/* the text of both displays changes, the frames must not differ */
+static void _test_frames(void)
+{
+    char digits[32];
+    int frame;
+    long mismatches = 0;
+
+    for (frame = 0; frame < 64; frame++)
+    {
+        const char *cjk = _cjk[(frame / 2) % (sizeof(_cjk) / sizeof(_cjk[0]))];
+
+        snprintf(digits, sizeof(digits), "%d km/h %d.%d%%", frame * 37, frame % 100, frame % 10);
+        lv_label_set_text(_plain.cjk, cjk);
+        lv_label_set_text(_cached.cjk, cjk);
+        lv_label_set_text(_plain.digits, digits);
+        lv_label_set_text(_cached.digits, digits);
+        _render(&_plain);
+        _render(&_cached);
+
+        if (memcmp(_plain.fb, _cached.fb, sizeof(_plain.fb)) != 0 && mismatches++ < 5)
+        {
+            int index = 0;
+
+            while (_plain.fb[index].full == _cached.fb[index].full)
+                index++;
+            printf("frame %d: first pixel differs at %d,%d\n", frame, index % HOR_RES, index / HOR_RES);
+        }
+    }
+
+    CHECK(mismatches == 0);
+}
+
+/* milliseconds per frame of the unchanged screen */
+static double _bench(struct display *display)
+{
+    uint64_t begin;
+    int frame;
+
+    _render(display);
+    begin = host_test_now_ns();
+    for (frame = 0; frame < FRAMES; frame++)
+        _render(display);
+
+    return (host_test_now_ns() - begin) / 1e6 / FRAMES;
+}
+
+int main(void)
+{
+    lv_glyph_cache_stat_t stat;
+    double plain, cached;
+
+    lv_init();
+    _init(&_plain, 0);
+    _init(&_cached, 1);
+
+    _test_frames();
+    lv_glyph_cache_get_stat(&stat);
+    CHECK(stat.budget == LV_GLYPH_CACHE_SIZE);
+    CHECK(stat.used <= stat.budget);
+    CHECK(stat.hits > 0 && stat.misses > 0 && stat.bypasses > 0);
+    printf("%u byte atlas: %u hits, %u misses, %u evictions, %u bypasses, %u bytes used\n",
+           (unsigned int)stat.budget, (unsigned int)stat.hits, (unsigned int)stat.misses,
+           (unsigned int)stat.evictions, (unsigned int)stat.bypasses, (unsigned int)stat.used);
+
+    plain = _bench(&_plain);
+    cached = _bench(&_cached);
+    printf("ms per frame    lv_draw_sw_letter %.3f    atlas %.3f\n", plain, cached);
+
+    return host_test_report(LV_GLYPH_CACHE_SIZE == 8192 ? "glyph 8k" : "glyph");
+}
@@ -0,0 +1,29 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The small memory heap with the pools in front and its profile, with the alignment of the board. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 32
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_CONSOLEBUF_SIZE 128
+#define RT_USING_HEAP
+#define RT_USING_SMALL_MEM
+#define RT_USING_SMALL_MEM_AS_HEAP
+#define RT_USING_MEMTRACE
+#define RT_USING_MEMPOOL
+#define RT_USING_HEAP_POOL
+/* out of order and with empty entries, as a configuration may be */
+#define RT_HEAP_POOL_CONFIG "128:16, 32:64,256:8,0:4,64:32,48:0"
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#endif
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The pools of RT_USING_HEAP_POOL in front of the small memory heap, against
+ * a model of the pools. The pools are carved in order of block size from a
+ * configuration out of order; a pool handed out to its last block, then the
+ * heap. Random rt_malloc, rt_calloc, rt_realloc and rt_free of small and
+ * large blocks: each request must come from the smallest pool that fits
+ * while it has a free block and from the heap otherwise, aligned to
+ * RT_ALIGN_SIZE, with its content kept; the hits, misses and lowest free
+ * counts of the pools and the peaks of the memtrace profile must be those
+ * of the model. The time of the allocations served by the pools and by the
+ * heap is reported.
+ */
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+
+#define HEAP_SIZE           (2 * 1024 * 1024)
+#define SLOTS               512
+#define LOOPS               200000
+#define LARGE_MAX           2048
+
+/* RT_HEAP_POOL_CONFIG in order of block size */
+#define POOLS               4
+static const rt_size_t _block_size[POOLS] = { 32, 64, 128, 256 };
+static const rt_size_t _block_count[POOLS] = { 64, 32, 16, 8 };
+
+struct slot
+{
+    rt_uint8_t *ptr;
+    rt_size_t size;
+    int pool;               /* -1 for the heap */
+    rt_uint32_t seed;
+};
+
+static rt_uint8_t *_heap;
+static struct slot _slots[SLOTS];
+
+/* the model */
+static rt_size_t _free[POOLS], _min_free[POOLS];
+static rt_uint32_t _hit[POOLS], _miss[POOLS];
+static rt_uint32_t _used[RT_HEAP_PROFILE_CLASS_NUM], _peak[RT_HEAP_PROFILE_CLASS_NUM];
+static long _misplaced, _unaligned, _corrupted;
+
+/* the time of the allocations of up to the largest block, by the pools and by the heap */
+static uint64_t _pool_ns, _pool_worst_ns, _heap_ns, _heap_worst_ns;
+static long _pool_allocs, _heap_allocs;
+
+/* mem.c keeps the address of the heap in 32 bits as on the target. */
+static void *_map32(size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory;
+
+#ifdef MAP_32BIT
+    flags |= MAP_32BIT;
+#endif
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED || (rt_ubase_t)memory + size > 0xFFFFFFFFUL)
+    {
+        printf("no memory below 4 GB\n");
+        exit(1);
+    }
+
+    return memory;
+}
+
+/* the pool of a block by its address, -1 for the heap */
+static int _pool_of(void *ptr)
+{
+    struct rt_heap_pool *pool;
+    int index;
+
+    for (index = 0; (pool = rt_heap_pool_get(index)) != RT_NULL; index++)
+    {
+        if ((rt_uint8_t *)ptr >= (rt_uint8_t *)pool->mp.start_address &&
+                (rt_uint8_t *)ptr < (rt_uint8_t *)pool->mp.start_address + pool->mp.size)
+            return index;
+    }
+
+    return -1;
+}
+
+/* the smallest pool that fits, -1 past the largest block */
+static int _pool_for(rt_size_t size)
+{
+    int index;
+
+    if (size == 0)
+        return -1;
+    for (index = 0; index < POOLS; index++)
+    {
+        if (size <= _block_size[index])
+            return index;
+    }
+
+    return -1;
+}
+
+/* the profile counts a block by its size, the block size of a pool or the usable size in the heap */
+static void _profile(void *ptr, int pool, int alloc)
+{
+    rt_size_t size = pool >= 0 ? _block_size[pool] : rt_smem_usable_size(ptr);
+    rt_size_t class_size = RT_HEAP_PROFILE_MIN_SIZE;
+    int index = 0;
+
+    while (class_size < size)
+    {
+        class_size <<= 1;
+        index++;
+    }
+    if (index >= RT_HEAP_PROFILE_CLASS_NUM)
+        return;
+
+    if (alloc && ++_used[index] > _peak[index])
+        _peak[index] = _used[index];
+    else if (!alloc)
+        _used[index]--;
+}
+
+/* where a new block of size is expected, and the counts of the pools */
+static int _expect_alloc(rt_size_t size)
+{
+    int pool = _pool_for(size);
+
+    if (pool < 0)
+        return -1;
+    if (_free[pool] == 0)
+    {
+        _miss[pool]++;
+        return -1;
+    }
+
+    _hit[pool]++;
+    if (--_free[pool] < _min_free[pool])
+        _min_free[pool] = _free[pool];
+
+    return pool;
+}
+
+static void _placed(struct slot *slot, int expect)
+{
+    if (slot->pool != expect && _misplaced++ < 5)
+        printf("%u bytes in pool %d, expected %d\n", (unsigned int)slot->size, slot->pool, expect);
+    if ((rt_ubase_t)slot->ptr % RT_ALIGN_SIZE)
+        _unaligned++;
+}
+
+static void _fill(struct slot *slot)
+{
+    rt_size_t index;
+
+    slot->seed = host_test_rand();
+    for (index = 0; index < slot->size; index++)
+        slot->ptr[index] = (rt_uint8_t)(slot->seed + index * 131);
+}
+
+static void _verify(const struct slot *slot, rt_size_t size)
+{
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        if (slot->ptr[index] != (rt_uint8_t)(slot->seed + index * 131))
+        {
+            _corrupted++;
+            return;
+        }
+    }
+}
+
+/* mostly small blocks, some larger than the largest block */
+static rt_size_t _random_size(void)
+{
+    if (host_test_rand() % 8 == 0)
+        return _block_size[POOLS - 1] + 1 + host_test_rand() % (LARGE_MAX - _block_size[POOLS - 1]);
+    if (host_test_rand() % 2)
+        return 1 + host_test_rand() % 48;
+
+    return 1 + host_test_rand() % _block_size[POOLS - 1];
+}
+
+static void _alloc(struct slot *slot, rt_size_t size, int zeroed)
+{
+    int expect = _expect_alloc(size);
+    uint64_t start, span;
+    rt_size_t index;
+
+    start = host_test_now_ns();
+    slot->ptr = zeroed ? rt_calloc(1, size) : rt_malloc(size);
+    span = host_test_now_ns() - start;
+    CHECK(slot->ptr != RT_NULL);
+    if (slot->ptr == RT_NULL)
+        return;
+
+    slot->size = size;
+    slot->pool = _pool_of(slot->ptr);
+    _placed(slot, expect);
+    _profile(slot->ptr, slot->pool, 1);
+
+    if (zeroed)
+    {
+        for (index = 0; index < size; index++)
+        {
+            if (slot->ptr[index] != 0)
+                _corrupted++;
+        }
+    }
+    _fill(slot);
+
+    if (size <= _block_size[POOLS - 1])
+    {
+        if (slot->pool >= 0)
+        {
+            _pool_ns += span;
+            _pool_allocs++;
+            if (span > _pool_worst_ns)
+                _pool_worst_ns = span;
+        }
+        else
+        {
+            _heap_ns += span;
+            _heap_allocs++;
+            if (span > _heap_worst_ns)
+                _heap_worst_ns = span;
+        }
+    }
+}
+
+static void _release(struct slot *slot)
+{
+    _verify(slot, slot->size);
+    _profile(slot->ptr, slot->pool, 0);
+    if (slot->pool >= 0)
+        _free[slot->pool]++;
+    rt_free(slot->ptr);
+    slot->ptr = RT_NULL;
+}
+
+/*
+ * A block of a pool stays where it is when it fits, moves as a new allocation
+ * otherwise; a block of the heap stays in the heap.
+ */
+static void _realloc(struct slot *slot, rt_size_t size)
+{
+    struct slot old = *slot;
+    int in_place = old.pool >= 0 && size <= _block_size[old.pool];
+    int expect = in_place ? old.pool : old.pool >= 0 ? _expect_alloc(size) : -1;
+
+    _verify(&old, old.size);
+    if (!in_place)
+    {
+        /* the profile forgets the old block first, its size is gone after */
+        _profile(old.ptr, old.pool, 0);
+        if (old.pool >= 0)
+            _free[old.pool]++;
+    }
+
+    slot->ptr = rt_realloc(old.ptr, size);
+    CHECK(slot->ptr != RT_NULL);
+    if (slot->ptr == RT_NULL)
+        return;
+    slot->pool = _pool_of(slot->ptr);
+    slot->size = size;
+    _placed(slot, expect);
+    if (in_place)
+        CHECK(slot->ptr == old.ptr);
+    else
+        _profile(slot->ptr, slot->pool, 1);
+
+    /* the content up to the smaller size is kept */
+    _verify(slot, old.size < size ? old.size : size);
+    _fill(slot);
+}
+
+/* a pool handed out to its last block, then the heap, then the pool again */
+static void _test_exhaust(void)
+{
+    static struct slot blocks[64 + 1];
+    struct slot *last = &blocks[_block_count[0]];
+    int index;
+
+    for (index = 0; index <= _block_count[0]; index++)
+        _alloc(&blocks[index], _block_size[0], 0);
+    CHECK(last->pool == -1);
+    CHECK(rt_heap_pool_get(0)->mp.block_free_count == 0 && rt_heap_pool_get(0)->miss == 1);
+
+    _release(&blocks[3]);
+    _alloc(&blocks[3], 1, 1);
+    CHECK(blocks[3].pool == 0);
+
+    /* realloc within the block, out of it, to nothing */
+    _realloc(&blocks[4], _block_size[0]);
+    _realloc(&blocks[5], _block_size[0] + 1);
+    CHECK(blocks[5].pool == 1);
+    CHECK(rt_realloc(blocks[6].ptr, 0) == RT_NULL);
+    _profile(blocks[6].ptr, 0, 0);
+    _free[0]++;
+    CHECK(rt_heap_pool_get(0)->mp.block_free_count == 2);
+
+    for (index = 0; index <= _block_count[0]; index++)
+    {
+        if (index != 6)
+            _release(&blocks[index]);
+    }
+
+    /* nothing to do for no block */
+    rt_free(RT_NULL);
+    CHECK(rt_malloc(0) == RT_NULL);
+}
+
+static void _test_random(void)
+{
+    long loop, ops[4] = { 0, 0, 0, 0 };
+    int index;
+
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        struct slot *slot = &_slots[host_test_rand() % SLOTS];
+        int action = host_test_rand() % 10;
+
+        if (slot->ptr == RT_NULL)
+        {
+            _alloc(slot, _random_size(), action == 0);
+            ops[0]++;
+        }
+        else if (action < 5)
+        {
+            _release(slot);
+            ops[1]++;
+        }
+        else if (action < 8)
+        {
+            _realloc(slot, _random_size());
+            ops[2]++;
+        }
+        else
+        {
+            _verify(slot, slot->size);
+            ops[3]++;
+        }
+    }
+    for (index = 0; index < SLOTS; index++)
+    {
+        if (_slots[index].ptr)
+            _release(&_slots[index]);
+    }
+
+    CHECK(_misplaced == 0 && _unaligned == 0 && _corrupted == 0);
+    printf("%ld allocations, %ld frees, %ld reallocs, %ld checks: %ld misplaced, %ld unaligned, %ld corrupted\n",
+           ops[0], ops[1], ops[2], ops[3], _misplaced, _unaligned, _corrupted);
+}
+
+static void _check_pools(void)
+{
+    rt_uint32_t peak[RT_HEAP_PROFILE_CLASS_NUM];
+    struct rt_heap_pool *pool;
+    int index;
+
+    for (index = 0; index < POOLS; index++)
+    {
+        pool = rt_heap_pool_get(index);
+        CHECK(pool->mp.block_free_count == _free[index]);
+        CHECK(pool->hit == _hit[index] && pool->miss == _miss[index] && pool->min_free == _min_free[index]);
+        printf("pool %3u: %2u blocks, %6u hits, %6u misses, %2u free at the lowest\n",
+               (unsigned int)pool->mp.block_size, (unsigned int)pool->mp.block_total_count,
+               (unsigned int)pool->hit, (unsigned int)pool->miss, (unsigned int)pool->min_free);
+    }
+
+    rt_heap_profile_get(peak);
+    CHECK(memcmp(peak, _peak, sizeof(peak)) == 0);
+    for (index = 0; index < RT_HEAP_PROFILE_CLASS_NUM; index++)
+        CHECK(_used[index] == 0);
+    printf("peak blocks in use:");
+    for (index = 0; index < RT_HEAP_PROFILE_CLASS_NUM; index++)
+        printf(" %u", (unsigned int)peak[index]);
+    printf("\n");
+}
+
+int main(void)
+{
+    struct rt_heap_pool *pool;
+    int index;
+
+    _heap = _map32(HEAP_SIZE);
+    rt_system_heap_init(_heap, _heap + HEAP_SIZE);
+
+    /* in order of block size, the empty entries left out */
+    for (index = 0; index < POOLS; index++)
+    {
+        pool = rt_heap_pool_get(index);
+        CHECK(pool != RT_NULL);
+        if (pool == RT_NULL)
+            return host_test_report("heap_pool");
+        CHECK(pool->mp.block_size == _block_size[index]);
+        CHECK(pool->mp.block_total_count == _block_count[index]);
+        CHECK(pool->mp.block_free_count == _block_count[index] && pool->min_free == _block_count[index]);
+        CHECK((rt_uint8_t *)pool->mp.start_address >= _heap && (rt_uint8_t *)pool->mp.start_address < _heap + HEAP_SIZE);
+        _free[index] = _min_free[index] = _block_count[index];
+    }
+    CHECK(rt_heap_pool_get(POOLS) == RT_NULL && rt_heap_pool_get(-1) == RT_NULL);
+
+    host_test_srand(10);
+    _test_exhaust();
+    _test_random();
+    _check_pools();
+
+    printf("up to %u bytes: pools %ld in %llu ns, worst %llu ns; heap %ld in %llu ns, worst %llu ns\n",
+           (unsigned int)_block_size[POOLS - 1], _pool_allocs,
+           (unsigned long long)(_pool_allocs ? _pool_ns / _pool_allocs : 0), (unsigned long long)_pool_worst_ns,
+           _heap_allocs, (unsigned long long)(_heap_allocs ? _heap_ns / _heap_allocs : 0),
+           (unsigned long long)_heap_worst_ns);
+
+    return host_test_report("heap_pool");
+}
@@ -0,0 +1,19 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL with tjpgd, the files of the host and the JPEG decoder of the port with a cache of three 64x48 images. */
+#define LV_COLOR_DEPTH                      16
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        0
+#define LV_USE_FS_STDIO                     1
+#define LV_FS_STDIO_LETTER                  'A'
+#define LV_FS_STDIO_PATH                    ""
+#define LV_FS_STDIO_CACHE_SIZE              0
+#define LV_USE_SJPG                         1
+#define LV_USE_JPEG_N9H30                   1
+#define LV_JPEG_N9H30_CACHE_SIZE            (3 * 64 * 48 * 2)
+
+#endif
@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The JPEG decoder of lv_jpeg_n9h30.c on its tjpgd path, the one of a host
+ * build, with its cache of decoded images. The JPEG streams are made here,
+ * blocks of 8x8 pixels of one colour each, so every decoded pixel is known:
+ * at the size of the JPEG, descaled by tjpgd and resized to any size. Then
+ * the cache: hits, the least recently used image evicted past the budget,
+ * an image evicted or flushed while opened still readable until its close,
+ * an image larger than the budget kept only while opened, broken streams,
+ * and the files of the host.
+ */
+#include "lv_jpeg_n9h30.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_test.h"
+
+#define JPEG_MAX            (16 * 1024)
+
+/* one image of the cache budget */
+#define IMAGE_W             64
+#define IMAGE_H             48
+#define IMAGE_SIZE          (IMAGE_W * IMAGE_H * sizeof(lv_color_t))
+
+struct jpeg
+{
+    uint8_t data[JPEG_MAX];
+    uint32_t size;
+    lv_coord_t w, h;
+    int seed;
+    lv_img_dsc_t dsc;
+};
+
+static struct jpeg _a, _b, _c, _d, _large;
+
+/* the colour of a block */
+static void _block_rgb(int seed, int bx, int by, uint8_t rgb[3])
+{
+    rgb[0] = (37 * bx + 91 * seed) % 256;
+    rgb[1] = (53 * by + 29 * seed) % 256;
+    rgb[2] = (71 * (bx + by) + 13 * seed) % 256;
+}
+
+struct bit_writer
+{
+    uint8_t *out;
+    uint32_t len;
+    uint32_t acc;
+    int count;
+};
+
+static void _put_bits(struct bit_writer *writer, uint32_t value, int count)
+{
+    while (count--)
+    {
+        writer->acc = (writer->acc << 1) | ((value >> count) & 1);
+        if (++writer->count == 8)
+        {
+            writer->out[writer->len++] = writer->acc;
+            /* a 0xFF of the entropy coded data is stuffed */
+            if (writer->acc == 0xFF)
+                writer->out[writer->len++] = 0;
+            writer->acc = writer->count = 0;
+        }
+    }
+}
+
+static void _put(struct jpeg *jpeg, const uint8_t *bytes, uint32_t len)
+{
+    memcpy(jpeg->data + jpeg->size, bytes, len);
+    jpeg->size += len;
+}
+
+/*
+ * A baseline JPEG without subsampling and with all quantizers 1. A block of
+ * one colour has only its DC coefficient, 8 times the level shifted sample;
+ * the DC tables code the size of a difference in 4 bits, the AC tables have
+ * only the end of block, in 1 bit.
+ */
+static void _make_jpeg(struct jpeg *jpeg, lv_coord_t w, lv_coord_t h, int seed)
+{
+    static const uint8_t soi[] = { 0xFF, 0xD8 };
+    /* DC differences of up to 11 bits in codes of 4 bits, only the end of block as AC, for both tables of tjpgd */
+    static const uint8_t dht[] =
+    {
+        0xFF, 0xC4, 0x00, 0x60,
+        0x00, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        0x10, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00,
+        0x01, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+        0x11, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00,
+    };
+    static const uint8_t sos[] = { 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00 };
+    static const uint8_t eoi[] = { 0xFF, 0xD9 };
+    uint8_t dqt[69] = { 0xFF, 0xDB, 0x00, 0x43, 0x00 };
+    uint8_t sof[19] = { 0xFF, 0xC0, 0x00, 0x11, 0x08, h >> 8, h & 0xFF, w >> 8, w & 0xFF, 0x03,
+                        0x01, 0x11, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00 };
+    struct bit_writer writer;
+    int predict[3] = { 0, 0, 0 };
+    int bx, by, comp;
+
+    memset(dqt + 5, 1, 64);
+    jpeg->size = 0;
+    jpeg->w = w;
+    jpeg->h = h;
+    jpeg->seed = seed;
+    _put(jpeg, soi, sizeof(soi));
+    _put(jpeg, dqt, sizeof(dqt));
+    _put(jpeg, sof, sizeof(sof));
+    _put(jpeg, dht, sizeof(dht));
+    _put(jpeg, sos, sizeof(sos));
+
+    memset(&writer, 0, sizeof(writer));
+    writer.out = jpeg->data + jpeg->size;
+    for (by = 0; by < h / 8; by++)
+    {
+        for (bx = 0; bx < w / 8; bx++)
+        {
+            uint8_t rgb[3];
+            double ycc[3];
+
+            _block_rgb(seed, bx, by, rgb);
+            ycc[0] = 0.299 * rgb[0] + 0.587 * rgb[1] + 0.114 * rgb[2];
+            ycc[1] = 128 - 0.168736 * rgb[0] - 0.331264 * rgb[1] + 0.5 * rgb[2];
+            ycc[2] = 128 + 0.5 * rgb[0] - 0.418688 * rgb[1] - 0.081312 * rgb[2];
+
+            for (comp = 0; comp < 3; comp++)
+            {
+                int dc = 8 * ((int)(ycc[comp] + 0.5) - 128), diff = dc - predict[comp], size = 0;
+
+                while ((diff < 0 ? -diff : diff) >> size)
+                    size++;
+                _put_bits(&writer, size, 4);
+                _put_bits(&writer, diff < 0 ? diff - 1 : diff, size);
+                _put_bits(&writer, 0, 1);
+                predict[comp] = dc;
+            }
+        }
+    }
+    /* padded with ones */
+    if (writer.count)
+        _put_bits(&writer, 0xFF, 8 - writer.count);
+    jpeg->size += writer.len;
+    _put(jpeg, eoi, sizeof(eoi));
+    CHECK(jpeg->size <= JPEG_MAX);
+
+    lv_jpeg_n9h30_dsc_init(&jpeg->dsc, jpeg->data, jpeg->size, 0, 0);
+}
+
+/* the colour of a block, the colour space conversions round a step of RGB565 either way */
+static bool _block_is(const struct jpeg *jpeg, lv_color_t pixel, lv_coord_t bx, lv_coord_t by)
+{
+    uint8_t rgb[3];
+    lv_color_t expect;
+
+    _block_rgb(jpeg->seed, bx, by, rgb);
+    expect = lv_color_make(rgb[0], rgb[1], rgb[2]);
+
+    return abs(pixel.ch.red - expect.ch.red) <= 1 && abs(pixel.ch.green - expect.ch.green) <= 1 &&
+           abs(pixel.ch.blue - expect.ch.blue) <= 1;
+}
+
+/*
+ * The pixels of an image decoded at w x h, nearest to the centre of each as
+ * the resize takes them; a centre right on the edge of two blocks may take
+ * either in the fixed point of the resize.
+ */
+static long _wrong_pixels(const struct jpeg *jpeg, const lv_color_t *pixels, lv_coord_t w, lv_coord_t h)
+{
+    lv_coord_t x, y;
+    long wrong = 0;
+
+    for (y = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x++)
+        {
+            long nx = (2 * x + 1) * jpeg->w, ny = (2 * y + 1) * jpeg->h;
+            lv_coord_t bx = nx / (2 * w) / 8, by = ny / (2 * h) / 8;
+            lv_coord_t ex = (nx % (16 * w) == 0 && bx > 0) ? bx - 1 : bx;
+            lv_coord_t ey = (ny % (16 * h) == 0 && by > 0) ? by - 1 : by;
+            lv_color_t pixel = pixels[y * w + x];
+
+            if (!_block_is(jpeg, pixel, bx, by) && !_block_is(jpeg, pixel, ex, by) &&
+                    !_block_is(jpeg, pixel, bx, ey) && !_block_is(jpeg, pixel, ex, ey))
+                wrong++;
+        }
+    }
+
+    return wrong;
+}
+
+/* open the image at w x h, 0 for the size of the JPEG */
+static lv_res_t _open(lv_img_decoder_dsc_t *dsc, struct jpeg *jpeg, lv_coord_t w, lv_coord_t h)
+{
+    jpeg->dsc.header.w = w;
+    jpeg->dsc.header.h = h;
+
+    return lv_img_decoder_open(dsc, &jpeg->dsc, lv_color_black(), 0);
+}
+
+static lv_jpeg_n9h30_stat_t _stat(void)
+{
+    lv_jpeg_n9h30_stat_t stat;
+
+    lv_jpeg_n9h30_get_stat(&stat);
+
+    return stat;
+}
+
+static void _test_decode(void)
+{
+    static const lv_coord_t sizes[][2] =
+    {
+        { 0, 0 }, { 32, 24 }, { 16, 12 }, { 8, 6 }, { 20, 15 }, { 50, 40 }, { 64, 24 }, { 1, 1 },
+    };
+    lv_img_decoder_dsc_t dsc;
+    lv_img_header_t header;
+    long wrong = 0;
+    int index;
+
+    CHECK(lv_img_decoder_get_info(&_a.dsc, &header) == LV_RES_OK);
+    CHECK(header.w == IMAGE_W && header.h == IMAGE_H && header.cf == LV_IMG_CF_TRUE_COLOR);
+
+    for (index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+    {
+        lv_coord_t w = sizes[index][0] ? sizes[index][0] : IMAGE_W;
+        lv_coord_t h = sizes[index][1] ? sizes[index][1] : IMAGE_H;
+
+        CHECK(_open(&dsc, &_a, sizes[index][0], sizes[index][1]) == LV_RES_OK);
+        CHECK(dsc.header.w == w && dsc.header.h == h && dsc.img_data != NULL);
+        if (dsc.img_data != NULL)
+        {
+            long count = _wrong_pixels(&_a, (const lv_color_t *)dsc.img_data, w, h);
+
+            if (count)
+                printf("%dx%d: %ld pixels wrong\n", w, h, count);
+            wrong += count;
+        }
+        lv_img_decoder_close(&dsc);
+    }
+
+    CHECK(wrong == 0);
+    CHECK(_stat().sw_decodes == sizeof(sizes) / sizeof(sizes[0]));
+    printf("%d sizes decoded by tjpgd: %ld pixels wrong\n", (int)(sizeof(sizes) / sizeof(sizes[0])), wrong);
+}
+
+static void _test_cache(void)
+{
+    lv_img_decoder_dsc_t a, b, c, d;
+    lv_jpeg_n9h30_stat_t stat, last;
+
+    lv_jpeg_n9h30_cache_flush();
+    last = _stat();
+    CHECK(last.used == 0 && last.budget == 3 * IMAGE_SIZE);
+
+    /* decoded once, then from the cache */
+    CHECK(_open(&a, &_a, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&a);
+    CHECK(_open(&a, &_a, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&a);
+    stat = _stat();
+    CHECK(stat.misses - last.misses == 1 && stat.hits - last.hits == 1);
+    CHECK(stat.used == IMAGE_SIZE);
+
+    /* three fill the budget, a fourth evicts the least recently used */
+    CHECK(_open(&b, &_b, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&b);
+    CHECK(_open(&c, &_c, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&c);
+    CHECK(_open(&a, &_a, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&a);
+    last = _stat();
+    CHECK(last.used == 3 * IMAGE_SIZE && last.evictions == stat.evictions);
+    CHECK(_open(&d, &_d, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&d);
+    stat = _stat();
+    CHECK(stat.evictions - last.evictions == 1 && stat.used == 3 * IMAGE_SIZE);
+    CHECK(_open(&a, &_a, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&a);
+    CHECK(_open(&b, &_b, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&b);
+    last = _stat();
+    CHECK(last.hits - stat.hits == 1 && last.misses - stat.misses == 1);
+
+    /* evicted while opened, it stays until closed */
+    CHECK(_open(&a, &_a, 0, 0) == LV_RES_OK);
+    CHECK(_open(&c, &_c, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&c);
+    CHECK(_open(&d, &_d, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&d);
+    CHECK(_open(&b, &_b, 0, 0) == LV_RES_OK);
+    lv_img_decoder_close(&b);
+    stat = _stat();
+    CHECK(stat.evictions > last.evictions);
+    CHECK(_wrong_pixels(&_a, (const lv_color_t *)a.img_data, IMAGE_W, IMAGE_H) == 0);
+    lv_img_decoder_close(&a);
+
+    /* larger than the budget, decoded at every open and never in the cache */
+    last = _stat();
+    CHECK(_open(&a, &_large, 0, 0) == LV_RES_OK);
+    CHECK(_open(&b, &_large, 0, 0) == LV_RES_OK);
+    stat = _stat();
+    CHECK(stat.misses - last.misses == 2 && stat.used == last.used && stat.evictions == last.evictions);
+    CHECK(_wrong_pixels(&_large, (const lv_color_t *)a.img_data, _large.w, _large.h) == 0);
+    lv_img_decoder_close(&a);
+    CHECK(_wrong_pixels(&_large, (const lv_color_t *)b.img_data, _large.w, _large.h) == 0);
+    lv_img_decoder_close(&b);
+
+    /* flushed while opened, it stays until closed */
+    CHECK(_open(&c, &_c, 16, 12) == LV_RES_OK);
+    lv_jpeg_n9h30_cache_flush();
+    CHECK(_stat().used == 0);
+    CHECK(_wrong_pixels(&_c, (const lv_color_t *)c.img_data, 16, 12) == 0);
+    lv_img_decoder_close(&c);
+
+    stat = _stat();
+    CHECK(stat.sw_decodes == stat.misses - stat.failures);
+    printf("cache: %u hits, %u misses, %u evictions, %u/%u bytes\n", (unsigned int)stat.hits,
+           (unsigned int)stat.misses, (unsigned int)stat.evictions, (unsigned int)stat.used,
+           (unsigned int)stat.budget);
+}
+
+/* a stream cut short fails to decode, one of another process is not taken */
+static void _test_broken(void)
+{
+    lv_img_decoder_dsc_t dsc;
+    lv_img_header_t header;
+    lv_img_dsc_t cut;
+    static struct jpeg progressive;
+    uint32_t failures = _stat().failures;
+
+    lv_jpeg_n9h30_dsc_init(&cut, _b.data, _b.size / 2, 0, 0);
+    CHECK(lv_img_decoder_get_info(&cut, &header) == LV_RES_OK);
+    CHECK(lv_img_decoder_open(&dsc, &cut, lv_color_black(), 0) != LV_RES_OK);
+    CHECK(_stat().failures == failures + 1);
+
+    /* the SOF0 after the SOI and the DQT made a SOF2 */
+    progressive = _b;
+    progressive.data[2 + 69 + 1] = 0xC2;
+    lv_jpeg_n9h30_dsc_init(&progressive.dsc, progressive.data, progressive.size, 0, 0);
+    CHECK(lv_img_decoder_get_info(&progressive.dsc, &header) != LV_RES_OK);
+}
+
+static void _test_file(void)
+{
+    char path[] = "/tmp/jpeg_XXXXXX.jpg", name[32];
+    lv_img_decoder_dsc_t dsc;
+    lv_img_header_t header;
+    lv_jpeg_n9h30_stat_t last = _stat();
+    int fd = mkstemps(path, 4);
+
+    CHECK(fd >= 0);
+    if (fd < 0)
+        return;
+    CHECK(write(fd, _d.data, _d.size) == _d.size);
+    close(fd);
+    snprintf(name, sizeof(name), "A:%s", path);
+
+    CHECK(lv_img_decoder_get_info(name, &header) == LV_RES_OK);
+    CHECK(header.w == IMAGE_W && header.h == IMAGE_H);
+    CHECK(lv_img_decoder_open(&dsc, name, lv_color_black(), 0) == LV_RES_OK);
+    CHECK(_wrong_pixels(&_d, (const lv_color_t *)dsc.img_data, IMAGE_W, IMAGE_H) == 0);
+    lv_img_decoder_close(&dsc);
+    CHECK(lv_img_decoder_open(&dsc, name, lv_color_black(), 0) == LV_RES_OK);
+    lv_img_decoder_close(&dsc);
+    CHECK(_stat().misses - last.misses == 1 && _stat().hits - last.hits == 1);
+
+    unlink(path);
+}
+
+int main(void)
+{
+    lv_init();
+    lv_jpeg_n9h30_init();
+
+    _make_jpeg(&_a, IMAGE_W, IMAGE_H, 1);
+    _make_jpeg(&_b, IMAGE_W, IMAGE_H, 2);
+    _make_jpeg(&_c, IMAGE_W, IMAGE_H, 3);
+    _make_jpeg(&_d, IMAGE_W, IMAGE_H, 4);
+    _make_jpeg(&_large, 4 * IMAGE_W, IMAGE_H, 5);
+
+    _test_decode();
+    _test_cache();
+    _test_broken();
+    _test_file();
+
+    return host_test_report("jpeg");
+}
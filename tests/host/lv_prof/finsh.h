@@ -0,0 +1,7 @@
+#ifndef __FINSH_H__
+#define __FINSH_H__
+
+/* no shell on the host, the test calls lv_prof itself */
+#define MSH_CMD_EXPORT(command, desc)
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL with the frame profiler of the port, its clock and tick set by the test. */
+#define LV_COLOR_DEPTH                      16
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        (host_lv_tick)
+#define LV_USE_PROF_N9H30                   1
+
+extern uint32_t host_lv_tick;
+
+#endif
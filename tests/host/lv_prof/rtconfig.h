@@ -0,0 +1,21 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The kernel services lv_prof_n9h30.c uses, on the cputime of the test. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_CONSOLE
+#define RT_USING_FINSH
+#define RT_USING_CPUTIME
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#endif
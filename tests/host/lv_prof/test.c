@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The frame profiler of lv_prof_n9h30.c on a display of LVGL. The cputime
+ * only moves when the test spends time in a phase: in a layout callback, in
+ * the drawing of an object with a wait for the 2DGE inside, in the flush with
+ * cache maintenance inside, and on another thread during the drawing. Each
+ * frame must split into exactly the time spent in each phase, a refresh
+ * drawing nothing must not count, and the statistics over the history must
+ * be those of the last frames. Then lv_prof and its overlay.
+ */
+#include <rtthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#include "lv_prof_n9h30.c"
+
+#define HOR_RES             320
+#define VER_RES             240
+#define PIXELS              (HOR_RES * VER_RES)
+#define STEPS_PER_US        3
+#define FRAMES              300
+
+uint32_t host_lv_tick;
+
+/* the cputime, in steps of a third of a microsecond */
+static uint64_t _clock;
+static struct rt_thread _ui_thread, _other_thread;
+static rt_thread_t _thread = &_ui_thread;
+
+uint64_t clock_cpu_gettime(void)
+{
+    return _clock;
+}
+
+uint32_t clock_cpu_microsecond(uint32_t cpu_tick)
+{
+    return cpu_tick / STEPS_PER_US;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return _thread;
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int length;
+
+    va_start(args, fmt);
+    length = vprintf(fmt, args);
+    va_end(args);
+
+    return length;
+}
+
+static void _spend(uint32_t us)
+{
+    _clock += (uint64_t)us * STEPS_PER_US;
+}
+
+/* the microseconds to spend in each phase of the next frame, once */
+static struct
+{
+    uint32_t layout;
+    uint32_t draw;
+    uint32_t ge_wait;
+    uint32_t cache;
+    uint32_t flush;
+    uint32_t other;         /* on another thread while drawing */
+} _cost;
+
+static lv_disp_drv_t _drv;
+static lv_disp_draw_buf_t _draw_buf;
+static lv_disp_t *_disp;
+static lv_color_t _buf[PIXELS];
+static lv_obj_t *_box;
+static long _flushes;
+
+/* the statistics of the frames seen, by phase */
+static uint32_t _model[_LV_PROF_N9H30_NUM][FRAMES];
+static int _frames;
+
+static void _layout(lv_obj_t *obj, void *user_data)
+{
+    _spend(_cost.layout);
+    _cost.layout = 0;
+}
+
+static void _draw(lv_event_t *e)
+{
+    _spend(_cost.draw);
+    lv_prof_n9h30_begin(LV_PROF_N9H30_GE_WAIT);
+    _spend(_cost.ge_wait);
+    lv_prof_n9h30_end();
+
+    /* not the thread of the frame, it's drawing time */
+    _thread = &_other_thread;
+    lv_prof_n9h30_begin(LV_PROF_N9H30_CACHE);
+    _spend(_cost.other);
+    lv_prof_n9h30_end();
+    _thread = &_ui_thread;
+
+    _cost.draw = _cost.ge_wait = _cost.other = 0;
+}
+
+static void _flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    _flushes++;
+    _spend(_cost.flush);
+    LV_PROF_N9H30_BEGIN(LV_PROF_N9H30_CACHE);
+    _spend(_cost.cache);
+    LV_PROF_N9H30_END();
+    _cost.flush = _cost.cache = 0;
+
+    lv_disp_flush_ready(drv);
+}
+
+static void _refresh(void)
+{
+    host_lv_tick += LV_DISP_DEF_REFR_PERIOD + 1;
+    lv_timer_handler();
+}
+
+/* one frame with random costs, kept by the model */
+static void _frame(void)
+{
+    long flushes = _flushes;
+    int phase;
+
+    _cost.layout = host_test_rand() % 3000;
+    _cost.draw = host_test_rand() % 8000;
+    _cost.ge_wait = host_test_rand() % 4 ? host_test_rand() % 2000 : 0;
+    _cost.cache = host_test_rand() % 300;
+    _cost.flush = host_test_rand() % 5000;
+    _cost.other = host_test_rand() % 1000;
+
+    _model[LV_PROF_N9H30_LAYOUT][_frames] = _cost.layout;
+    _model[LV_PROF_N9H30_DRAW][_frames] = _cost.draw + _cost.other;
+    _model[LV_PROF_N9H30_GE_WAIT][_frames] = _cost.ge_wait;
+    _model[LV_PROF_N9H30_CACHE][_frames] = _cost.cache;
+    _model[LV_PROF_N9H30_FLUSH][_frames] = _cost.flush;
+    _model[LV_PROF_N9H30_FRAME][_frames] = 0;
+    for (phase = 0; phase < LV_PROF_N9H30_FRAME; phase++)
+        _model[LV_PROF_N9H30_FRAME][_frames] += _model[phase][_frames];
+    _frames++;
+
+    lv_obj_set_x(_box, host_test_rand() % (HOR_RES - 60));
+    lv_obj_mark_layout_as_dirty(_box);
+    _refresh();
+    CHECK(_flushes > flushes);
+}
+
+/* the statistics of a phase over the last frames of the model */
+static void _expect(int phase, lv_prof_n9h30_stat_t *stat)
+{
+    uint64_t samples[LV_PROF_N9H30_HISTORY], sum = 0;
+    int index, count = _frames < LV_PROF_N9H30_HISTORY ? _frames : LV_PROF_N9H30_HISTORY;
+
+    memset(stat, 0, sizeof(*stat));
+    if (count == 0)
+        return;
+
+    for (index = 0; index < count; index++)
+    {
+        samples[index] = _model[phase][_frames - count + index];
+        sum += samples[index];
+    }
+    stat->count = count;
+    stat->last = _model[phase][_frames - 1];
+    stat->avg = sum / count;
+    stat->p99 = host_test_percentile(samples, count, 99);
+    stat->min = samples[0];
+    stat->max = samples[count - 1];
+}
+
+static long _wrong_stats(void)
+{
+    lv_prof_n9h30_stat_t stat, expect;
+    long wrong = 0;
+    int phase;
+
+    for (phase = 0; phase < _LV_PROF_N9H30_NUM; phase++)
+    {
+        lv_prof_n9h30_get_stat((lv_prof_n9h30_phase_t)phase, &stat);
+        _expect(phase, &expect);
+        if (memcmp(&stat, &expect, sizeof(stat)) != 0)
+        {
+            if (wrong++ < 5)
+                printf("frame %d, %s: last %u min %u avg %u p99 %u max %u of %u frames, "
+                       "expected %u %u %u %u %u of %u\n", _frames, s_names[phase],
+                       stat.last, stat.min, stat.avg, stat.p99, stat.max, stat.count,
+                       expect.last, expect.min, expect.avg, expect.p99, expect.max, expect.count);
+        }
+    }
+
+    return wrong;
+}
+
+static void _test_frames(void)
+{
+    lv_prof_n9h30_stat_t stat;
+    long wrong = 0, idle = 0, flushes;
+    int frame;
+
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        _frame();
+        wrong += _wrong_stats();
+
+        /* a layout, but nothing to redraw: not a frame */
+        if (frame % 10 == 0)
+        {
+            flushes = _flushes;
+            _cost.layout = 500;
+            lv_obj_mark_layout_as_dirty(_box);
+            _refresh();
+            CHECK(_cost.layout == 0);
+            CHECK(_flushes == flushes);
+            wrong += _wrong_stats();
+            idle++;
+        }
+    }
+
+    CHECK(wrong == 0);
+    lv_prof_n9h30_get_stat(LV_PROF_N9H30_FRAME, &stat);
+    printf("%d frames of %ld flushes and %ld layouts without drawing: %ld statistics wrong, "
+           "frame avg %u us p99 %u us over %u\n", FRAMES, _flushes, idle, wrong, stat.avg, stat.p99, stat.count);
+}
+
+static void _test_command(void)
+{
+    char *argv[] = { "lv_prof", "reset", RT_NULL };
+    lv_prof_n9h30_stat_t stat;
+    const char *text;
+    char expect[256];
+    int phase, length;
+
+    CHECK(lv_prof(1, argv) == 0);
+
+    /* dropped at the next frame */
+    CHECK(lv_prof(2, argv) == 0);
+    lv_prof_n9h30_get_stat(LV_PROF_N9H30_FRAME, &stat);
+    CHECK(stat.count == LV_PROF_N9H30_HISTORY);
+    _frames = 0;
+    _frame();
+    CHECK(_wrong_stats() == 0);
+    lv_prof_n9h30_get_stat(LV_PROF_N9H30_FRAME, &stat);
+    CHECK(stat.count == 1);
+
+    /* the overlay, created and deleted by its own timer */
+    argv[1] = "overlay";
+    argv[2] = "on";
+    CHECK(lv_prof(3, argv) == 0);
+    host_lv_tick += LV_PROF_N9H30_OVERLAY_PERIOD;
+    lv_timer_handler();
+    CHECK(lv_obj_get_child_cnt(lv_layer_sys()) == 1);
+
+    /* it draws a frame itself, the text is checked right after an update */
+    nu_prof_overlay_timer(RT_NULL);
+    text = lv_label_get_text(lv_obj_get_child(lv_layer_sys(), 0));
+    length = snprintf(expect, sizeof(expect), "us       avg    p99");
+    for (phase = 0; phase < _LV_PROF_N9H30_NUM; phase++)
+    {
+        lv_prof_n9h30_get_stat((lv_prof_n9h30_phase_t)phase, &stat);
+        length += snprintf(&expect[length], sizeof(expect) - length, "\n%-7s %6u %6u",
+                           s_names[phase], stat.avg, stat.p99);
+    }
+    CHECK(strcmp(text, expect) == 0);
+
+    argv[2] = "off";
+    CHECK(lv_prof(3, argv) == 0);
+    host_lv_tick += LV_PROF_N9H30_OVERLAY_PERIOD;
+    lv_timer_handler();
+    CHECK(lv_obj_get_child_cnt(lv_layer_sys()) == 0);
+
+    argv[1] = "help";
+    CHECK(lv_prof(2, argv) == -1);
+}
+
+int main(void)
+{
+    lv_prof_n9h30_stat_t stat;
+    lv_obj_t *label;
+    int phase;
+
+    lv_init();
+    lv_disp_draw_buf_init(&_draw_buf, _buf, NULL, PIXELS);
+    lv_disp_drv_init(&_drv);
+    _drv.hor_res = HOR_RES;
+    _drv.ver_res = VER_RES;
+    _drv.flush_cb = _flush;
+    _drv.draw_buf = &_draw_buf;
+    _disp = lv_disp_drv_register(&_drv);
+    lv_prof_n9h30_init(_disp);
+
+    _box = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(_box, 60, 40);
+    lv_obj_set_style_layout(_box, lv_layout_register(_layout, NULL), 0);
+    lv_obj_add_event_cb(_box, _draw, LV_EVENT_DRAW_MAIN, NULL);
+    label = lv_label_create(_box);
+    lv_label_set_text(label, "0");
+    do
+    {
+        _flushes = 0;
+        _refresh();
+    }
+    while (_flushes);
+
+    /* out of a frame, nothing is counted */
+    lv_prof_n9h30_begin(LV_PROF_N9H30_CACHE);
+    _spend(100);
+    lv_prof_n9h30_end();
+    lv_prof_n9h30_reset();
+    lv_obj_mark_layout_as_dirty(_box);
+    _refresh();
+    CHECK(_flushes == 0);
+    for (phase = 0; phase < _LV_PROF_N9H30_NUM; phase++)
+    {
+        lv_prof_n9h30_get_stat((lv_prof_n9h30_phase_t)phase, &stat);
+        CHECK(stat.count == 0);
+    }
+
+    host_test_srand(20);
+    _test_frames();
+    _test_command();
+
+    return host_test_report("lv_prof");
+}
@@ -0,0 +1,36 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The flash translation layer over the NAND flash in RAM, on one thread, collected by the test. */
+
+#ifndef HOST_WL_THRESHOLD
+#define HOST_WL_THRESHOLD 64
+#endif
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_USING_HEAP
+#define RT_USING_MUTEX
+#define RT_USING_DEVICE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#define RT_USING_MTD_NAND
+#define RT_USING_MTD_NAND_FTL
+#define RT_MTD_NAND_FTL_RESERVE 5
+#define RT_MTD_NAND_FTL_CKPT_INTERVAL 4096
+#define RT_MTD_NAND_FTL_WL_THRESHOLD HOST_WL_THRESHOLD
+#define RT_MTD_NAND_FTL_GC_PERIOD 0
+#define RT_MTD_NAND_FTL_GC_FREE 8
+#define RT_USING_MTD_NAND_SIM
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* the MTD Nand drivers need only their own headers of the device drivers, and the cast of rtdevice.h */
+#include "drivers/mtd_nand.h"
+#include "drivers/mtd_nand_ftl.h"
+#include "drivers/mtd_nand_sim.h"
+
+#define RT_DEVICE(device)            ((rt_device_t)device)
+
+#endif
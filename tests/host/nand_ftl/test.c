@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The flash translation layer of mtd_nand_ftl.c over the NAND flash in RAM
+ * of mtd_nand_sim.c, 256 blocks of 32 pages of 512 bytes. Overwrites spread
+ * evenly and 90/10 on a tenth of the device, with the write amplification
+ * and the spread of the erase counts; then power losses at random points,
+ * each followed by a remount which must find every page acknowledged, a
+ * page being written either old or new; then blocks going bad in use, to be
+ * retired with their data. No page may be programmed twice or out of order.
+ * test moves the cold data at the default difference of erase counts,
+ * test_wl at 8.
+ */
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+
+#define BLOCKS              256
+#define PAGES_PER_BLOCK     32
+#define PAGE_SIZE           512
+#define OOB_SIZE            16
+#define POWER_LOSSES        300
+#define BAD_BLOCKS          8
+
+static struct rt_mtd_nand_device *_nand;
+static rt_device_t _ftl;
+static rt_uint32_t _pages;
+/* the version of each page written, 0 if never; the one before while a write is not acknowledged */
+static rt_uint32_t *_version, *_previous;
+static rt_uint32_t _buf[PAGE_SIZE / 4], _read_buf[PAGE_SIZE / 4];
+
+/* one thread, the lock only has to be balanced */
+static int _lock_held;
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) { return RT_EOK; }
+rt_err_t rt_mutex_detach(rt_mutex_t mutex) { return RT_EOK; }
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    _lock_held++;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    CHECK(_lock_held > 0);
+    _lock_held--;
+
+    return RT_EOK;
+}
+
+/* the content of a version of a page, erased for version 0 */
+static void _fill(rt_uint32_t *buf, rt_uint32_t page, rt_uint32_t version)
+{
+    int index;
+
+    for (index = 0; index < PAGE_SIZE / 4; index++)
+        buf[index] = version ? (page * 2654435761u) ^ (version << 16) ^ index : 0xFFFFFFFF;
+}
+
+static rt_bool_t _holds(rt_uint32_t page, rt_uint32_t version)
+{
+    if (rt_device_read(_ftl, page, _read_buf, 1) != 1)
+        return RT_FALSE;
+    _fill(_buf, page, version);
+
+    return memcmp(_read_buf, _buf, PAGE_SIZE) == 0;
+}
+
+static rt_bool_t _write(rt_uint32_t page)
+{
+    _fill(_buf, page, _version[page] + 1);
+    _previous[page] = _version[page]++;
+    if (rt_device_write(_ftl, page, _buf, 1) != 1)
+        return RT_FALSE;
+    _previous[page] = _version[page];
+
+    return RT_TRUE;
+}
+
+/* every page holds its version, or the one before if its write was not acknowledged */
+static long _verify(const char *what)
+{
+    rt_uint32_t page;
+    long wrong = 0;
+
+    for (page = 0; page < _pages; page++)
+    {
+        if (_holds(page, _version[page]))
+            continue;
+        if (_previous[page] != _version[page] && _holds(page, _previous[page]))
+        {
+            _version[page] = _previous[page];
+            continue;
+        }
+        if (wrong++ < 5)
+            printf("%s: page %u is not version %u or %u\n", what, (unsigned int)page,
+                   (unsigned int)_version[page], (unsigned int)_previous[page]);
+    }
+    memcpy(_previous, _version, _pages * sizeof(rt_uint32_t));
+
+    return wrong;
+}
+
+/* a tenth of the pages take `hot` percent of the writes */
+static rt_uint32_t _pick(int hot)
+{
+    if (host_test_rand() % 100 < hot)
+        return host_test_rand() % (_pages / 10);
+
+    return host_test_rand() % _pages;
+}
+
+/* unmount, without the last checkpoint if the power is lost, then load what is on the flash */
+static void _remount(rt_bool_t power_lost)
+{
+    if (!power_lost)
+        CHECK(rt_device_close(_ftl) == RT_EOK);
+    CHECK((rt_mtd_nand_ftl_destroy(_ftl) == RT_EOK) != power_lost);
+    rt_mtd_nand_sim_set_fault(_nand, -1);
+    _ftl = rt_mtd_nand_ftl_create("ftl", "sim", RT_FALSE);
+    if (_ftl == RT_NULL || rt_device_open(_ftl, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        printf("the mount failed\n");
+        exit(1);
+    }
+}
+
+/* overwrites with the background steps between them, as the work queue would */
+static void _test_wear(const char *name, int hot)
+{
+    struct rt_mtd_nand_ftl_stat stat;
+    rt_uint32_t index;
+
+    rt_mtd_nand_ftl_reset_stat(_ftl);
+    for (index = 0; index < 3 * _pages; index++)
+    {
+        CHECK(_write(_pick(hot)));
+        if (index % 64 == 0)
+        {
+            while (rt_mtd_nand_ftl_collect(_ftl) == RT_EOK && host_test_rand() % 4)
+                ;
+        }
+    }
+
+    CHECK(_verify(name) == 0);
+    CHECK(_lock_held == 0);
+    rt_mtd_nand_ftl_get_stat(_ftl, &stat);
+    CHECK(stat.host_pages == 3 * _pages);
+    printf("%-9s: %u pages, %u copied, %u of checkpoints, WA %.2f, %u erases, %u moved cold, "
+           "erase counts %u-%u\n", name, (unsigned int)stat.host_pages, (unsigned int)stat.gc_pages,
+           (unsigned int)stat.ckpt_pages,
+           (double)(stat.host_pages + stat.gc_pages + stat.ckpt_pages) / stat.host_pages,
+           (unsigned int)stat.erases, (unsigned int)stat.wl_blocks, (unsigned int)stat.min_erase,
+           (unsigned int)stat.max_erase);
+}
+
+static void _test_power_loss(void)
+{
+    long loss, wrong = 0, torn = 0;
+
+    for (loss = 0; loss < POWER_LOSSES; loss++)
+    {
+        int index;
+
+        rt_mtd_nand_sim_set_fault(_nand, host_test_rand() % 3000);
+        for (index = 0; index < 100000; index++)
+        {
+            if (!_write(_pick(70)))
+            {
+                torn++;
+                break;
+            }
+        }
+        _remount(RT_TRUE);
+        wrong += _verify("power loss");
+    }
+
+    CHECK(torn == POWER_LOSSES);
+    CHECK(wrong == 0);
+    printf("%d power losses: %ld writes torn, %ld pages wrong after the remount\n", POWER_LOSSES, torn, wrong);
+}
+
+static void _test_bad_blocks(void)
+{
+    struct rt_mtd_nand_ftl_stat stat;
+    rt_uint32_t retired;
+    long wrong = 0;
+    int bad, index;
+
+    rt_mtd_nand_ftl_reset_stat(_ftl);
+    for (bad = 0; bad < BAD_BLOCKS; bad++)
+    {
+        rt_mtd_nand_sim_set_bad(_nand, host_test_rand() % BLOCKS);
+        for (index = 0; index < 5000; index++)
+            CHECK(_write(_pick(50)));
+        wrong += _verify("bad block");
+    }
+    rt_mtd_nand_ftl_get_stat(_ftl, &stat);
+    retired = stat.retired;
+    _remount(RT_FALSE);
+    wrong += _verify("bad block remount");
+
+    CHECK(wrong == 0);
+    CHECK(retired > 0);
+    rt_mtd_nand_ftl_get_stat(_ftl, &stat);
+    CHECK(stat.bad_blocks >= retired);
+    printf("%d blocks gone bad: %u retired, %u bad after the remount, %ld pages wrong\n",
+           BAD_BLOCKS, (unsigned int)retired, (unsigned int)stat.bad_blocks, wrong);
+}
+
+int main(void)
+{
+    struct rt_device_blk_geometry geometry;
+    struct rt_mtd_nand_sim_stat sim_stat;
+    rt_uint32_t page;
+    char name[32];
+
+    _nand = rt_mtd_nand_sim_create("sim", BLOCKS, PAGES_PER_BLOCK, PAGE_SIZE, OOB_SIZE);
+    CHECK(_nand != RT_NULL);
+    CHECK(rt_mtd_nand_ftl_create("ftl", "nonand", RT_TRUE) == RT_NULL);
+    _ftl = rt_mtd_nand_ftl_create("ftl", "sim", RT_TRUE);
+    CHECK(_ftl != RT_NULL && rt_device_find("ftl") == _ftl);
+    if (_ftl == RT_NULL)
+        return host_test_report("nand_ftl");
+
+    CHECK(rt_device_control(_ftl, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry) == RT_EOK);
+    CHECK(geometry.bytes_per_sector == PAGE_SIZE && geometry.block_size == PAGE_SIZE * PAGES_PER_BLOCK);
+    _pages = geometry.sector_count;
+    CHECK(_pages > 0 && _pages < BLOCKS * PAGES_PER_BLOCK);
+    _version = calloc(_pages, sizeof(rt_uint32_t));
+    _previous = calloc(_pages, sizeof(rt_uint32_t));
+    CHECK(rt_device_open(_ftl, RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+    printf("%u pages of %u bytes over %d blocks\n", (unsigned int)_pages,
+           (unsigned int)geometry.bytes_per_sector, BLOCKS);
+
+    /* never written reads erased */
+    CHECK(_holds(0, 0));
+
+    host_test_srand(25);
+    for (page = 0; page < _pages; page++)
+        CHECK(_write(page));
+    _test_wear("uniform", 0);
+    _test_wear("hot 90/10", 90);
+    _remount(RT_FALSE);
+    CHECK(_verify("remount") == 0);
+
+    _test_power_loss();
+    _test_bad_blocks();
+
+    rt_mtd_nand_sim_get_stat(_nand, &sim_stat);
+    CHECK(sim_stat.violations == 0);
+    printf("the flash: %u pages programmed, %u blocks erased, %u programmed twice or out of order\n",
+           (unsigned int)sim_stat.programs, (unsigned int)sim_stat.erases, (unsigned int)sim_stat.violations);
+
+    CHECK(rt_device_close(_ftl) == RT_EOK);
+    CHECK(rt_mtd_nand_ftl_destroy(_ftl) == RT_EOK);
+    CHECK(rt_device_find("ftl") == RT_NULL);
+    free(_version);
+    free(_previous);
+
+    snprintf(name, sizeof(name), "nand_ftl wl %d", RT_MTD_NAND_FTL_WL_THRESHOLD);
+    return host_test_report(name);
+}
@@ -0,0 +1,18 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL with the 2DGE draw context of the port, at the depth of the test program. */
+#ifndef HOST_COLOR_DEPTH
+#define HOST_COLOR_DEPTH 16
+#endif
+
+#define LV_COLOR_DEPTH                      HOST_COLOR_DEPTH
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        0
+#define LV_USE_GLYPH_CACHE                  0
+#define LV_USE_PROF_N9H30                   0
+
+#endif
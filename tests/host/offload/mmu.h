@@ -0,0 +1,12 @@
+#ifndef __MMU_H__
+#define __MMU_H__
+
+/* The cache maintenance of the ARM926, test.c checks it against the engine commands. */
+#include <rtthread.h>
+
+#define CACHE_LINE_SIZE     32
+
+void mmu_clean_invalidated_dcache(rt_uint32_t buffer, rt_uint32_t size);
+void mmu_clean_dcache(rt_uint32_t buffer, rt_uint32_t size);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The kernel services lv_gpu_n9h30_2dge.c uses, for its macros. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_HEAP
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The blend of the 2DGE draw context of lv_gpu_n9h30_2dge.c against
+ * lv_draw_sw_blend_basic of LVGL: random fills, ROP blend modes, images and
+ * masks on draw buffers of any width and position, with random thresholds.
+ * The engine is a model that runs the queued commands late, at random, and
+ * sometimes refuses one. Each command must be word-aligned at 16bpp and lie
+ * in the memory just cleaned from the cache, and after waiting for the
+ * engine both buffers must be the same, the bytes around them too. The
+ * alpha blend of the engine is modelled by lv_color_mix, so for images with
+ * opacity only the placement is checked. test is built in RGB565, test_32
+ * in ARGB8888.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+
+#include "lv_gpu_n9h30_2dge.c"
+
+#define BUF_WIDTH_MAX       64
+#define BUF_HEIGHT_MAX      12
+#define GUARD               64
+#define FRAMES              20000
+#define BLENDS              8
+#define QUEUE_MAX           8
+
+#define PX_SIZE             ((int)sizeof(lv_color_t))
+#define BUF_SIZE            (BUF_WIDTH_MAX * BUF_HEIGHT_MAX * PX_SIZE)
+
+/* a command of the engine, as queued by ge2dQueue_FillRop or ge2dQueue_SpriteBlt */
+struct ge_cmd
+{
+    lv_color_t *dest;
+    int pitch, x, y, width, height;
+    const lv_color_t *src;      /* RT_NULL for a fill */
+    int src_pitch, alpha;
+    lv_color_t color;
+    int rop;
+};
+
+static struct ge_cmd _queue[QUEUE_MAX];
+static int _queue_head, _queue_count;
+
+/* the memory last cleaned from the cache for the engine */
+static rt_uint32_t _invalidated[2], _cleaned[2];
+
+static long _fills, _rop_fills, _blits, _alpha_blits, _refused, _split, _cpu_only;
+
+static rt_uint8_t *_hw_mem, *_sw_mem;
+static lv_color_t _src[BUF_WIDTH_MAX * BUF_HEIGHT_MAX * 4];
+static lv_opa_t _mask[BUF_WIDTH_MAX * BUF_HEIGHT_MAX * 4];
+
+/* The driver keeps buffer addresses in 32 bits as on the target. */
+static void *_map32(size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory;
+
+#ifdef MAP_32BIT
+    flags |= MAP_32BIT;
+#endif
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED || (rt_ubase_t)memory + size > 0xFFFFFFFFUL)
+    {
+        printf("no memory below 4 GB\n");
+        exit(1);
+    }
+
+    return memory;
+}
+
+void mmu_clean_invalidated_dcache(rt_uint32_t buffer, rt_uint32_t size)
+{
+    _invalidated[0] = buffer;
+    _invalidated[1] = buffer + size;
+}
+
+void mmu_clean_dcache(rt_uint32_t buffer, rt_uint32_t size)
+{
+    _cleaned[0] = buffer;
+    _cleaned[1] = buffer + size;
+}
+
+/* the calibration is not run, the test sets the threshold */
+rt_tick_t rt_tick_get(void)
+{
+    return 0;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    return RT_NULL;
+}
+
+void rt_free_align(void *ptr)
+{
+}
+
+/* a bitwise ROP3 without pattern, bit (S << 1 | D) of the code */
+static rt_uint32_t _rop3(int rop, rt_uint32_t src, rt_uint32_t dst)
+{
+    rt_uint32_t result = 0;
+    int index;
+
+    for (index = 0; index < 4; index++)
+    {
+        rt_uint32_t s = (index & 2) ? src : ~src, d = (index & 1) ? dst : ~dst;
+
+        if (rop >> index & 1)
+            result |= s & d;
+    }
+
+    return result;
+}
+
+static void _run(const struct ge_cmd *cmd)
+{
+    int x, y;
+
+    for (y = 0; y < cmd->height; y++)
+    {
+        for (x = 0; x < cmd->width; x++)
+        {
+            lv_color_t *pixel = &cmd->dest[(cmd->y + y) * cmd->pitch + cmd->x + x];
+
+            if (cmd->src == RT_NULL)
+                pixel->full = _rop3(cmd->rop, cmd->color.full, pixel->full);
+            else if (cmd->alpha == 255)
+                *pixel = cmd->src[y * cmd->src_pitch + x];
+            else
+                *pixel = lv_color_mix(cmd->src[y * cmd->src_pitch + x], *pixel, cmd->alpha);
+        }
+    }
+}
+
+/* the engine finishes its oldest command */
+static void _run_oldest(void)
+{
+    _run(&_queue[_queue_head]);
+    _queue_head = (_queue_head + 1) % QUEUE_MAX;
+    _queue_count--;
+}
+
+/* time passes at each call */
+static void _access(void)
+{
+    if (_queue_count && host_test_rand() % 4 == 0)
+        _run_oldest();
+}
+
+static int _in(rt_uint32_t *range, const void *first, const void *last)
+{
+    return (rt_uint32_t)(rt_ubase_t)first >= range[0] && (rt_uint32_t)(rt_ubase_t)last < range[1];
+}
+
+static int _queue_cmd(const struct ge_cmd *cmd, int bpp)
+{
+    const lv_color_t *first = &cmd->dest[cmd->y * cmd->pitch + cmd->x];
+    const lv_color_t *last = &cmd->dest[(cmd->y + cmd->height - 1) * cmd->pitch + cmd->x + cmd->width - 1];
+
+    _access();
+
+    CHECK(bpp == LV_COLOR_DEPTH);
+    CHECK(cmd->width > 0 && cmd->height > 0);
+    CHECK(_in(_invalidated, first, last));
+    if (cmd->src)
+        CHECK(_in(_cleaned, cmd->src, &cmd->src[(cmd->height - 1) * cmd->src_pitch + cmd->width - 1]));
+#if LV_COLOR_DEPTH == 16
+    /* the engine reads and writes words */
+    CHECK(((rt_ubase_t)first & 0x3) == 0 && (cmd->pitch & 0x1) == 0);
+    if (cmd->src)
+        CHECK(((rt_ubase_t)cmd->src & 0x3) == 0 && (cmd->src_pitch & 0x1) == 0);
+#endif
+
+    if (host_test_rand() % 20 == 0)
+    {
+        _refused++;
+        return -1;
+    }
+
+    if (_queue_count == QUEUE_MAX)
+        _run_oldest();
+    _queue[(_queue_head + _queue_count++) % QUEUE_MAX] = *cmd;
+
+    return 0;
+}
+
+int ge2dQueue_FillRop(void *dest, int dest_pitch, int bpp, int dx, int dy, int width, int height, int color, int rop)
+{
+    struct ge_cmd cmd = { dest, dest_pitch, dx, dy, width, height, RT_NULL, 0, 255 };
+
+    cmd.color.full = color;
+    cmd.rop = rop;
+    if (_queue_cmd(&cmd, bpp) < 0)
+        return -1;
+
+    if (rop == SRCCOPY)
+        _fills++;
+    else
+        _rop_fills++;
+
+    return 0;
+}
+
+int ge2dQueue_SpriteBlt(void *dest, int dest_pitch, int bpp, int destx, int desty, int width, int height,
+                        void *src, int src_pitch, int alpha)
+{
+    struct ge_cmd cmd = { dest, dest_pitch, destx, desty, width, height, src, src_pitch, alpha };
+
+    if (_queue_cmd(&cmd, bpp) < 0)
+        return -1;
+
+    if (alpha == 255)
+        _blits++;
+    else
+        _alpha_blits++;
+
+    return 0;
+}
+
+void ge2dQueue_Sync(void)
+{
+    while (_queue_count)
+        _run_oldest();
+}
+
+int ge2dQueue_IsIdle(void)
+{
+    _access();
+
+    return _queue_count == 0;
+}
+
+static lv_color_t _random_color(int saturated)
+{
+    if (saturated)
+        return lv_color_make(host_test_rand() % 2 ? 0xff : 0, host_test_rand() % 2 ? 0xff : 0,
+                             host_test_rand() % 2 ? 0xff : 0);
+
+    return lv_color_make(host_test_rand(), host_test_rand(), host_test_rand());
+}
+
+/* an area around the buffer, overlapping it or not */
+static void _random_area(lv_area_t *area, const lv_area_t *around)
+{
+    area->x1 = around->x1 - 4 + host_test_rand() % (lv_area_get_width(around) + 4);
+    area->y1 = around->y1 - 2 + host_test_rand() % (lv_area_get_height(around) + 2);
+    area->x2 = area->x1 + host_test_rand() % (lv_area_get_width(around) + 4);
+    area->y2 = area->y1 + host_test_rand() % (lv_area_get_height(around) + 2);
+}
+
+static void _random_blend(lv_draw_sw_blend_dsc_t *dsc, lv_area_t *blend_area, lv_area_t *mask_area,
+                          const lv_area_t *buf_area)
+{
+    static const lv_opa_t opas[] = { LV_OPA_COVER, LV_OPA_COVER, LV_OPA_COVER, 254, LV_OPA_MAX, LV_OPA_70 };
+    static const lv_blend_mode_t modes[] = { LV_BLEND_MODE_ADDITIVE, LV_BLEND_MODE_SUBTRACTIVE, LV_BLEND_MODE_MULTIPLY };
+    rt_uint32_t dice = host_test_rand() % 100;
+    int index;
+
+    memset(dsc, 0, sizeof(*dsc));
+    _random_area(blend_area, buf_area);
+    dsc->blend_area = blend_area;
+    dsc->opa = opas[host_test_rand() % (sizeof(opas) / sizeof(opas[0]))];
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+
+    if (dice < 40)
+    {
+        dsc->color = _random_color(host_test_rand() % 2);
+    }
+    else if (dice < 70)
+    {
+        dsc->color = _random_color(host_test_rand() % 4);
+        dsc->blend_mode = modes[host_test_rand() % 3];
+    }
+    else
+    {
+        for (index = 0; index < lv_area_get_size(blend_area); index++)
+            _src[index] = _random_color(0);
+        dsc->src_buf = _src;
+        if (host_test_rand() % 8 == 0)
+            dsc->blend_mode = modes[host_test_rand() % 3];
+    }
+
+    dice = host_test_rand() % 100;
+    if (dice < 30)
+    {
+        *mask_area = *blend_area;
+        for (index = 0; index < lv_area_get_size(mask_area); index++)
+            _mask[index] = host_test_rand() % 3 ? LV_OPA_COVER : host_test_rand();
+        dsc->mask_buf = _mask;
+        dsc->mask_area = mask_area;
+        dsc->mask_res = dice < 15 ? LV_DRAW_MASK_RES_FULL_COVER :
+                        dice < 28 ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_TRANSP;
+    }
+}
+
+static void _test_blend(lv_draw_ctx_t *hw_ctx, lv_draw_ctx_t *sw_ctx)
+{
+    lv_area_t buf_area, clip_area, blend_area, mask_area, clipped;
+    lv_draw_sw_blend_dsc_t dsc;
+    long wrong = 0, blends = 0;
+    int frame, index;
+
+    host_test_srand(13);
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        int width = 1 + host_test_rand() % BUF_WIDTH_MAX, height = 1 + host_test_rand() % BUF_HEIGHT_MAX;
+        lv_color_t *hw_buf = (lv_color_t *)(_hw_mem + GUARD), *sw_buf = (lv_color_t *)(_sw_mem + GUARD);
+
+        for (index = 0; index < BUF_SIZE + 2 * GUARD; index++)
+            _hw_mem[index] = host_test_rand();
+        memcpy(_sw_mem, _hw_mem, BUF_SIZE + 2 * GUARD);
+
+        buf_area.x1 = host_test_rand() % 4;
+        buf_area.y1 = host_test_rand() % 4;
+        buf_area.x2 = buf_area.x1 + width - 1;
+        buf_area.y2 = buf_area.y1 + height - 1;
+        hw_ctx->buf = hw_buf;
+        sw_ctx->buf = sw_buf;
+        hw_ctx->buf_area = sw_ctx->buf_area = &buf_area;
+        hw_ctx->clip_area = sw_ctx->clip_area = &clip_area;
+
+        for (index = 0; index < BLENDS; index++)
+        {
+            long queued = _fills + _rop_fills + _blits + _alpha_blits;
+
+            clip_area = buf_area;
+            if (host_test_rand() % 4 == 0)
+                _random_area(&clip_area, &buf_area);
+            _random_blend(&dsc, &blend_area, &mask_area, &buf_area);
+            s_u32Threshold = host_test_rand() % 2 ? 0 : host_test_rand() % 200;
+
+            lv_draw_n9h30_2dge_blend(hw_ctx, &dsc);
+            lv_draw_sw_blend_basic(sw_ctx, &dsc);
+
+            if (!_lv_area_intersect(&clipped, &blend_area, &clip_area) ||
+                !_lv_area_intersect(&clipped, &clipped, &buf_area))
+                continue;
+            blends++;
+            if (_fills + _rop_fills + _blits + _alpha_blits == queued)
+                _cpu_only++;
+            else if (_queue_count && _queue[(_queue_head + _queue_count - 1) % QUEUE_MAX].width != lv_area_get_width(&clipped))
+                _split++;
+        }
+
+        lv_gpu_n9h30_2dge_wait_cb(hw_ctx);
+        CHECK(_queue_count == 0);
+        if (memcmp(_hw_mem, _sw_mem, BUF_SIZE + 2 * GUARD) != 0)
+        {
+            if (wrong++ < 5)
+                printf("frame %d: %dx%d at %d,%d differs\n", frame, width, height, buf_area.x1, buf_area.y1);
+        }
+    }
+
+    CHECK(wrong == 0);
+    CHECK(_fills > 0 && _rop_fills > 0 && _blits > 0 && _alpha_blits > 0 && _split > 0);
+    printf("%d bpp, %ld blends: %ld fills, %ld ROP fills, %ld blits, %ld alpha blits, %ld split "
+           "with CPU edges, %ld refused, %ld on the CPU; %ld frames wrong\n", LV_COLOR_DEPTH, blends,
+           _fills, _rop_fills, _blits, _alpha_blits, _split, _refused, _cpu_only, wrong);
+}
+
+/* switched off, nothing goes to the engine */
+static void _test_disable(lv_draw_ctx_t *hw_ctx)
+{
+    lv_area_t area = { 0, 0, BUF_WIDTH_MAX - 1, BUF_HEIGHT_MAX - 1 };
+    lv_draw_sw_blend_dsc_t dsc;
+    long fills = _fills;
+
+    memset(&dsc, 0, sizeof(dsc));
+    dsc.blend_area = &area;
+    dsc.opa = LV_OPA_COVER;
+    hw_ctx->buf = _hw_mem + GUARD;
+    hw_ctx->buf_area = &area;
+    hw_ctx->clip_area = &area;
+    s_u32Threshold = 0;
+
+    lv_draw_n9h30_2dge_enable(false);
+    lv_draw_n9h30_2dge_blend(hw_ctx, &dsc);
+    CHECK(_fills == fills);
+
+    lv_draw_n9h30_2dge_enable(true);
+    lv_draw_n9h30_2dge_blend(hw_ctx, &dsc);
+    CHECK(_fills == fills + 1);
+    lv_gpu_n9h30_2dge_wait_cb(hw_ctx);
+}
+
+int main(void)
+{
+    static lv_color_t draw_buf[BUF_WIDTH_MAX];
+    static lv_disp_draw_buf_t disp_buf;
+    static lv_disp_drv_t drv;
+    static lv_draw_sw_ctx_t hw_ctx, sw_ctx;
+
+    lv_init();
+    lv_disp_draw_buf_init(&disp_buf, draw_buf, NULL, BUF_WIDTH_MAX);
+    lv_disp_drv_init(&drv);
+    drv.hor_res = BUF_WIDTH_MAX;
+    drv.ver_res = BUF_HEIGHT_MAX;
+    drv.draw_buf = &disp_buf;
+    _lv_refr_set_disp_refreshing(lv_disp_drv_register(&drv));
+
+    _hw_mem = _map32(BUF_SIZE + 2 * GUARD);
+    _sw_mem = _map32(BUF_SIZE + 2 * GUARD);
+
+    s_bCalibrated = true;
+    lv_draw_n9h30_2dge_ctx_init(&drv, &hw_ctx.base_draw);
+    lv_draw_sw_init_ctx(&drv, &sw_ctx.base_draw);
+
+    _test_blend(&hw_ctx.base_draw, &sw_ctx.base_draw);
+    _test_disable(&hw_ctx.base_draw);
+
+    return host_test_report("offload");
+}
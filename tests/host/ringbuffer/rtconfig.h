@@ -0,0 +1,30 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The ring buffers of the device drivers, shared by two host threads. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_USING_HEAP
+#define RT_USING_DEVICE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+/*
+ * The threads run on two cores, as on SMP. The compiler barrier of UP is
+ * enough on x86, which keeps stores and loads in order; elsewhere a full one.
+ */
+#if !defined(__i386__) && !defined(__x86_64__)
+#define RT_RINGBUFFER_BARRIER()     __sync_synchronize()
+#endif
+
+#endif
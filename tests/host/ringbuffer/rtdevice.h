@@ -0,0 +1,7 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* ringbuffer.c needs only its own header of the device drivers. */
+#include "ipc/ringbuffer.h"
+
+#endif
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The lock-free ring buffer of ringbuffer.c: full and empty, segments across
+ * the end of the buffer and indexes across 2^32 on one thread, then a
+ * producer and a consumer thread with random lengths through the copy and
+ * the in-place calls, every byte checked. Then its throughput against
+ * rt_ringbuffer under a mutex, as the drivers use it.
+ */
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define STRESS_BYTES        (4 * 1024 * 1024)
+#define BENCH_BYTES         (64 * 1024 * 1024)
+#define BENCH_SIZE          4096
+#define CHUNK_MAX           1024
+
+/* the random numbers of one thread */
+static rt_uint32_t _rand(rt_uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+/* the producer and the consumer in turn on one thread */
+static void _test_single(rt_uint32_t size, int near_wrap)
+{
+    rt_uint8_t *pool = malloc(size), *in = malloc(size + 1), *out = malloc(size + 1);
+    struct rt_ringbuffer_segment seg[2];
+    struct rt_ringbuffer_spsc rb;
+    rt_uint32_t round, length, index, state = size;
+    rt_uint8_t next_in = 0, next_out = 0;
+    long bad = 0;
+
+    rt_ringbuffer_spsc_init(&rb, pool, size);
+    CHECK(rb.mask == ((size & (size - 1)) ? 0 : size - 1));
+    /* indexes just before they wrap, at 2^32 or at twice the size */
+    if (near_wrap)
+        rb.write_index = rb.read_index = (rb.mask ? 0 : 2 * size) - 1 - size / 2;
+
+    for (round = 0; round < 4000; round++)
+    {
+        length = _rand(&state) % (size + 1) + 1;
+        for (index = 0; index < length; index++)
+            in[index] = next_in + index;
+        length = rt_ringbuffer_spsc_put(&rb, in, length);
+        next_in += length;
+        CHECK(rt_ringbuffer_spsc_data_len(&rb) + rt_ringbuffer_spsc_space_len(&rb) == size);
+
+        if (rt_ringbuffer_spsc_space_len(&rb) == 0)
+        {
+            CHECK(rt_ringbuffer_spsc_put(&rb, in, 1) == 0);
+            CHECK(rt_ringbuffer_spsc_put_reserve(&rb, seg, 1) == 0);
+        }
+
+        /* the data as two segments, the second from the start of the buffer */
+        length = rt_ringbuffer_spsc_get_reserve(&rb, seg, size + 1);
+        CHECK(length == rt_ringbuffer_spsc_data_len(&rb));
+        CHECK(seg[0].length + seg[1].length == length);
+        CHECK(seg[0].ptr + seg[0].length <= pool + size);
+        CHECK(seg[1].length == 0 || (seg[1].ptr == pool && seg[0].ptr + seg[0].length == pool + size));
+
+        length = _rand(&state) % (size + 1) + 1;
+        length = rt_ringbuffer_spsc_get(&rb, out, length);
+        for (index = 0; index < length; index++)
+        {
+            if (out[index] != (rt_uint8_t)(next_out + index))
+                bad++;
+        }
+        next_out += length;
+    }
+    while ((length = rt_ringbuffer_spsc_get(&rb, out, size)) != 0)
+    {
+        for (index = 0; index < length; index++)
+        {
+            if (out[index] != (rt_uint8_t)(next_out + index))
+                bad++;
+        }
+        next_out += length;
+    }
+
+    CHECK(bad == 0);
+    CHECK(next_in == next_out);
+    CHECK(rt_ringbuffer_spsc_data_len(&rb) == 0 && rt_ringbuffer_spsc_space_len(&rb) == size);
+    CHECK(rt_ringbuffer_spsc_get_reserve(&rb, seg, 1) == 0);
+
+    free(out);
+    free(in);
+    free(pool);
+}
+
+struct stress
+{
+    struct rt_ringbuffer_spsc rb;
+    rt_uint32_t total;
+    int in_place;
+};
+
+/* writes the byte sequence, through the in-place calls or a copy */
+static void *_producer(void *parameter)
+{
+    struct stress *stress = parameter;
+    struct rt_ringbuffer_segment seg[2];
+    rt_uint8_t chunk[CHUNK_MAX];
+    rt_uint32_t sent = 0, state = 1, length, index;
+
+    while (sent < stress->total)
+    {
+        length = _rand(&state) % 37 + 1;
+        if (length > stress->total - sent)
+            length = stress->total - sent;
+
+        if (stress->in_place && (_rand(&state) & 1))
+        {
+            length = rt_ringbuffer_spsc_put_reserve(&stress->rb, seg, length);
+            for (index = 0; index < seg[0].length; index++)
+                seg[0].ptr[index] = (rt_uint8_t)(sent + index);
+            for (index = 0; index < seg[1].length; index++)
+                seg[1].ptr[index] = (rt_uint8_t)(sent + seg[0].length + index);
+            /* sometimes less than reserved */
+            if (length > 1 && (_rand(&state) & 3) == 0)
+                length--;
+            rt_ringbuffer_spsc_put_commit(&stress->rb, length);
+        }
+        else
+        {
+            for (index = 0; index < length; index++)
+                chunk[index] = (rt_uint8_t)(sent + index);
+            length = rt_ringbuffer_spsc_put(&stress->rb, chunk, length);
+        }
+
+        if (length == 0)
+            sched_yield();
+        sent += length;
+    }
+
+    return RT_NULL;
+}
+
+/* reads and checks the sequence, returns the number of bytes out of it */
+static long _consume(struct stress *stress)
+{
+    struct rt_ringbuffer_segment seg[2];
+    rt_uint8_t chunk[CHUNK_MAX];
+    rt_uint32_t received = 0, state = 2, length, index;
+    long bad = 0;
+
+    while (received < stress->total)
+    {
+        length = _rand(&state) % 53 + 1;
+
+        if (stress->in_place && (_rand(&state) & 1))
+        {
+            length = rt_ringbuffer_spsc_get_reserve(&stress->rb, seg, length);
+            if (length > 1 && (_rand(&state) & 3) == 0)
+                length--;
+            for (index = 0; index < length; index++)
+            {
+                rt_uint8_t byte = index < seg[0].length ? seg[0].ptr[index] : seg[1].ptr[index - seg[0].length];
+
+                if (byte != (rt_uint8_t)(received + index))
+                    bad++;
+            }
+            rt_ringbuffer_spsc_get_commit(&stress->rb, length);
+        }
+        else
+        {
+            length = rt_ringbuffer_spsc_get(&stress->rb, chunk, length);
+            for (index = 0; index < length; index++)
+            {
+                if (chunk[index] != (rt_uint8_t)(received + index))
+                    bad++;
+            }
+        }
+
+        if (length == 0)
+            sched_yield();
+        received += length;
+    }
+
+    return bad;
+}
+
+static void _test_threads(rt_uint32_t size, int in_place)
+{
+    rt_uint8_t *pool = malloc(size);
+    struct stress stress;
+    pthread_t thread;
+    long bad;
+
+    rt_ringbuffer_spsc_init(&stress.rb, pool, size);
+    stress.total = STRESS_BYTES;
+    stress.in_place = in_place;
+
+    pthread_create(&thread, RT_NULL, _producer, &stress);
+    bad = _consume(&stress);
+    pthread_join(thread, RT_NULL);
+
+    CHECK(bad == 0);
+    CHECK(rt_ringbuffer_spsc_data_len(&stress.rb) == 0);
+    if (bad)
+        printf("%u bytes%s: %ld bad bytes\n", size, in_place ? ", in place" : "", bad);
+
+    free(pool);
+}
+
+/* the throughput of BENCH_BYTES in chunks of a size, either buffer */
+struct bench
+{
+    struct rt_ringbuffer_spsc spsc;
+    struct rt_ringbuffer locked;
+    pthread_mutex_t lock;
+    rt_uint32_t chunk;
+    int use_lock;
+};
+
+static rt_size_t _bench_put(struct bench *bench, const rt_uint8_t *ptr, rt_size_t length)
+{
+    if (!bench->use_lock)
+        return rt_ringbuffer_spsc_put(&bench->spsc, ptr, length);
+
+    pthread_mutex_lock(&bench->lock);
+    length = rt_ringbuffer_put(&bench->locked, ptr, length);
+    pthread_mutex_unlock(&bench->lock);
+
+    return length;
+}
+
+static rt_size_t _bench_get(struct bench *bench, rt_uint8_t *ptr, rt_size_t length)
+{
+    if (!bench->use_lock)
+        return rt_ringbuffer_spsc_get(&bench->spsc, ptr, length);
+
+    pthread_mutex_lock(&bench->lock);
+    length = rt_ringbuffer_get(&bench->locked, ptr, length);
+    pthread_mutex_unlock(&bench->lock);
+
+    return length;
+}
+
+static void *_bench_producer(void *parameter)
+{
+    struct bench *bench = parameter;
+    rt_uint8_t chunk[CHUNK_MAX];
+    rt_size_t sent = 0, length;
+
+    memset(chunk, 0x5a, sizeof(chunk));
+    while (sent < BENCH_BYTES)
+    {
+        length = _bench_put(bench, chunk, bench->chunk);
+        if (length == 0)
+            sched_yield();
+        sent += length;
+    }
+
+    return RT_NULL;
+}
+
+static double _bench(struct bench *bench, int use_lock)
+{
+    rt_uint8_t chunk[CHUNK_MAX];
+    rt_size_t received = 0, length;
+    pthread_t thread;
+    uint64_t begin;
+
+    bench->use_lock = use_lock;
+    begin = host_test_now_ns();
+    pthread_create(&thread, RT_NULL, _bench_producer, bench);
+    while (received < BENCH_BYTES)
+    {
+        length = _bench_get(bench, chunk, bench->chunk);
+        if (length == 0)
+            sched_yield();
+        received += length;
+    }
+    pthread_join(thread, RT_NULL);
+    begin = host_test_now_ns() - begin;
+
+    /* MB/s */
+    return BENCH_BYTES * 1000.0 / begin;
+}
+
+static void _bench_all(void)
+{
+    static const rt_uint32_t chunks[] = { 16, 64, 256, 1024 };
+    static rt_uint8_t spsc_pool[BENCH_SIZE], locked_pool[BENCH_SIZE];
+    struct bench bench;
+    rt_size_t index;
+
+    rt_ringbuffer_spsc_init(&bench.spsc, spsc_pool, BENCH_SIZE);
+    rt_ringbuffer_init(&bench.locked, locked_pool, BENCH_SIZE);
+    pthread_mutex_init(&bench.lock, RT_NULL);
+
+    printf("%d byte buffer    spsc    rt_ringbuffer + mutex\n", BENCH_SIZE);
+    for (index = 0; index < sizeof(chunks) / sizeof(chunks[0]); index++)
+    {
+        double spsc, locked;
+
+        bench.chunk = chunks[index];
+        spsc = _bench(&bench, 0);
+        locked = _bench(&bench, 1);
+        printf("%4u byte chunks %6.0f MB/s %6.0f MB/s\n", chunks[index], spsc, locked);
+    }
+
+    pthread_mutex_destroy(&bench.lock);
+}
+
+int main(void)
+{
+    static const rt_uint32_t sizes[] = { 1, 7, 64, 100, 4096 };
+    rt_size_t index;
+
+    for (index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+    {
+        _test_single(sizes[index], 0);
+        _test_single(sizes[index], 1);
+        _test_threads(sizes[index], 0);
+        _test_threads(sizes[index], 1);
+    }
+    _bench_all();
+
+    return host_test_report("ringbuffer");
+}
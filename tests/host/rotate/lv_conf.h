@@ -0,0 +1,13 @@
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* LVGL rendering unrotated and by its sw_rotate, the CPU path of the port. */
+#define LV_COLOR_DEPTH                      16
+#define LV_MEM_CUSTOM                       1
+#define LV_MEMCPY_MEMSET_STD                1
+#define LV_TICK_CUSTOM                      1
+#define LV_TICK_CUSTOM_INCLUDE              <stdint.h>
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR        0
+#define LV_FONT_MONTSERRAT_16               1
+
+#endif
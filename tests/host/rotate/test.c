@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The rotation at flushing of lv_rotate_n9h30.c against sw_rotate of LVGL:
+ * the same screen on two displays of the 480x272 panel rotated by 90, 180
+ * and 270 degrees, one rotated by LVGL, the other rendered unrotated and
+ * rotated area by area by lv_rotate_n9h30. Every area must map onto its
+ * own size in the frame buffer, each pixel inside the mapped area, and both
+ * frame buffers must be the same after the full frame and after random
+ * partial changes. The 2DGE path is not built here, lv_rotate_n9h30 takes
+ * the CPU path it falls back to. Then the time of a frame by either.
+ */
+#include "lv_rotate_n9h30.h"
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+
+#define HOR_RES             480
+#define VER_RES             272
+#define PIXELS              (HOR_RES * VER_RES)
+/* the draw buffer of a tenth of the screen, as without anti-tearing */
+#define DRAW_PIXELS         (PIXELS / 10)
+#define FRAMES              100
+#define BENCH_FRAMES        50
+
+struct display
+{
+    lv_disp_drv_t drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_disp_t *disp;
+    lv_color_t draw[DRAW_PIXELS];
+    lv_color_t fb[PIXELS];
+    lv_obj_t *box;
+    lv_obj_t *label;
+};
+
+static struct display _lvgl, _port;
+static long _areas, _map_errors;
+static int _check_map = 1;
+
+/* sw_rotate of LVGL passes the rotated areas */
+static void _flush_lvgl(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_coord_t y, w = lv_area_get_width(area);
+
+    for (y = area->y1; y <= area->y2; y++, color_p += w)
+        memcpy(&_lvgl.fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+    lv_disp_flush_ready(drv);
+}
+
+/* the area maps onto its own size, every pixel of it inside */
+static void _check_area(const lv_disp_drv_t *drv, const lv_area_t *area)
+{
+    lv_area_t out, pixel, mapped;
+    lv_point_t first, point;
+    lv_coord_t x, y;
+
+    lv_rotate_n9h30_area(drv, area, &out, &first);
+    if (lv_area_get_size(&out) != lv_area_get_size(area) || out.x1 < 0 || out.y1 < 0 ||
+            out.x2 >= drv->hor_res || out.y2 >= drv->ver_res)
+        _map_errors++;
+    if (!_lv_area_is_point_on(&out, &first, 0))
+        _map_errors++;
+
+    for (y = area->y1; y <= area->y2; y++)
+    {
+        for (x = area->x1; x <= area->x2; x++)
+        {
+            lv_area_set(&pixel, x, y, x, y);
+            lv_rotate_n9h30_area(drv, &pixel, &mapped, NULL);
+            point.x = mapped.x1;
+            point.y = mapped.y1;
+            if (!_lv_area_is_point_on(&out, &point, 0))
+                _map_errors++;
+        }
+    }
+}
+
+/* the port renders unrotated and rotates at flushing */
+static void _flush_port(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    _areas++;
+    if (_check_map)
+        _check_area(drv, area);
+
+    lv_rotate_n9h30(drv, _port.fb, area, color_p, lv_area_get_width(area));
+    lv_disp_flush_ready(drv);
+}
+
+static void _init(struct display *display, void (*flush)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *),
+                  int sw_rotate)
+{
+    lv_disp_draw_buf_init(&display->draw_buf, display->draw, NULL, DRAW_PIXELS);
+    lv_disp_drv_init(&display->drv);
+    display->drv.hor_res = HOR_RES;
+    display->drv.ver_res = VER_RES;
+    display->drv.flush_cb = flush;
+    display->drv.draw_buf = &display->draw_buf;
+    display->drv.sw_rotate = sw_rotate;
+    display->disp = lv_disp_drv_register(&display->drv);
+}
+
+static void _build(struct display *display)
+{
+    lv_obj_t *scr = lv_disp_get_scr_act(display->disp), *obj;
+
+    lv_obj_clean(scr);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x102030), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x80a0c0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_HOR, 0);
+
+    display->label = lv_label_create(scr);
+    lv_obj_set_style_text_font(display->label, &lv_font_montserrat_16, 0);
+    lv_label_set_text(display->label, "Rotate 123");
+    lv_obj_set_pos(display->label, 3, 2);
+
+    display->box = lv_obj_create(scr);
+    lv_obj_set_size(display->box, 30, 20);
+    lv_obj_set_style_bg_color(display->box, lv_color_hex(0xff0000), 0);
+
+    /* the corners tell a mirrored frame from a rotated one */
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 25, 40);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x00ff00), 0);
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 15, 9);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x0000ff), 0);
+}
+
+static void _change(struct display *display, int frame, lv_coord_t x, lv_coord_t y)
+{
+    char text[16];
+
+    snprintf(text, sizeof(text), "Rotate %d", frame);
+    lv_label_set_text(display->label, text);
+    lv_obj_set_pos(display->box, x, y);
+}
+
+static long _differ(void)
+{
+    long index, count = 0;
+
+    for (index = 0; index < PIXELS; index++)
+        count += _lvgl.fb[index].full != _port.fb[index].full;
+
+    return count;
+}
+
+static void _test_rotation(lv_disp_rot_t rotation)
+{
+    long frame, full, partial = 0;
+
+    lv_disp_set_rotation(_lvgl.disp, rotation);
+    lv_disp_set_rotation(_port.disp, rotation);
+    _build(&_lvgl);
+    _build(&_port);
+    memset(_lvgl.fb, 0, sizeof(_lvgl.fb));
+    memset(_port.fb, 0xff, sizeof(_port.fb));
+    _areas = _map_errors = 0;
+
+    lv_refr_now(_lvgl.disp);
+    lv_refr_now(_port.disp);
+    full = _differ();
+
+    /* small dirty areas anywhere on the rotated screen, the edges too */
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        lv_coord_t x = host_test_rand() % (lv_disp_get_hor_res(_port.disp) + 20) - 20;
+        lv_coord_t y = host_test_rand() % (lv_disp_get_ver_res(_port.disp) + 10) - 10;
+
+        _change(&_lvgl, frame, x, y);
+        _change(&_port, frame, x, y);
+        lv_refr_now(_lvgl.disp);
+        lv_refr_now(_port.disp);
+        partial += _differ();
+    }
+
+    CHECK(full == 0);
+    CHECK(partial == 0);
+    CHECK(_map_errors == 0);
+    printf("%3d degrees: %ld areas, %ld mapping errors, %ld pixels differ, %ld after changes\n",
+           rotation * 90, _areas, _map_errors, full, partial);
+}
+
+/* milliseconds per full frame */
+static double _bench(struct display *display)
+{
+    uint64_t begin;
+    int frame;
+
+    begin = host_test_now_ns();
+    for (frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        lv_obj_invalidate(lv_disp_get_scr_act(display->disp));
+        lv_refr_now(display->disp);
+    }
+
+    return (host_test_now_ns() - begin) / 1e6 / BENCH_FRAMES;
+}
+
+int main(void)
+{
+    lv_disp_rot_t rotation;
+    double sw_rotate, port;
+
+    lv_init();
+    _init(&_lvgl, _flush_lvgl, 1);
+    _init(&_port, _flush_port, 0);
+
+    host_test_srand(19);
+    for (rotation = LV_DISP_ROT_90; rotation <= LV_DISP_ROT_270; rotation++)
+        _test_rotation(rotation);
+
+    /* without the mapping checks of every pixel */
+    _check_map = 0;
+    lv_disp_set_rotation(_lvgl.disp, LV_DISP_ROT_90);
+    lv_disp_set_rotation(_port.disp, LV_DISP_ROT_90);
+    sw_rotate = _bench(&_lvgl);
+    port = _bench(&_port);
+    printf("ms per frame at 90 degrees    sw_rotate %.3f    lv_rotate_n9h30 %.3f\n", sw_rotate, port);
+
+    return host_test_report("rotate");
+}
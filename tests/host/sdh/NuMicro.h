@@ -0,0 +1,9 @@
+#ifndef __NUMICRO_H__
+#define __NUMICRO_H__
+
+/* The SDH of the N9H30, its functions go to the model of the card in test.c. */
+#include "N9H30.h"
+#include "nu_sys.h"
+#include "nu_sdh.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef __DFS_FILE_H__
+#define __DFS_FILE_H__
+
+/* The file system is only used by the hotplug of drv_sdh.c, not built here. */
+
+#endif
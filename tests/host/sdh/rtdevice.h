@@ -0,0 +1,6 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* drv_sdh.c needs only the block device of rtdef.h without hotplug. */
+
+#endif
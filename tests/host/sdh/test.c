@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The read and write paths of drv_sdh.c on a model of the card: random
+ * requests of 1 to 300 blocks on buffers at every byte offset. A word-aligned
+ * buffer must go to the DMA in one command, any other through the bounce
+ * buffer in commands of NU_SDH_BOUNCE_BLOCKS blocks; no DMA address may be
+ * unaligned, and the card and the buffers must end up as the model. Then a
+ * failing command ends the request, and the statistics add up. Then the
+ * commands of an unaligned request against one per block as before.
+ */
+#include "drv_sdh.c"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "host_test.h"
+
+#define CARD_BLOCKS         1024
+#define REQUEST_MAX         300
+#define LOOPS               20000
+
+static rt_uint8_t _card[CARD_BLOCKS * SDH_BLOCK_SIZE], _model[CARD_BLOCKS * SDH_BLOCK_SIZE];
+static rt_uint8_t *_buf;
+static long _cmds, _unaligned, _oversized, _outside;
+static int _locked;
+/* the command of the request that fails, -1 for none */
+static long _fail_at = -1;
+
+/* The driver keeps buffer addresses in 32 bits as on the target. */
+static void *_map32(size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory;
+
+#ifdef MAP_32BIT
+    flags |= MAP_32BIT;
+#endif
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED || (rt_ubase_t)memory + size > 0xFFFFFFFFUL)
+    {
+        printf("no memory below 4 GB\n");
+        exit(1);
+    }
+
+    return memory;
+}
+
+void *rt_malloc_align(rt_size_t size, rt_size_t align)
+{
+    return _map32(size);
+}
+
+/* the model: a DMA from and to word-aligned addresses of the bounce buffer or the request */
+static uint32_t _transfer(uint8_t *addr, uint32_t sector, uint32_t count, int write)
+{
+    nu_sdh_t sdh = &nu_sdh_arr[SDH0_IDX];
+    int bounced = addr == sdh->pbuf;
+
+    CHECK(_locked == 1);
+    CHECK(sector + count <= CARD_BLOCKS);
+    if ((rt_ubase_t)addr & (NU_SDH_DMA_ALIGN - 1))
+        _unaligned++;
+
+    /* past the buffer the DMA would overwrite memory, fail the command instead */
+    if (bounced && count > NU_SDH_BOUNCE_BLOCKS)
+    {
+        _oversized++;
+        return SDH_SELECT_ERROR;
+    }
+    if (!bounced && (addr < _buf || addr + count * SDH_BLOCK_SIZE > _buf + REQUEST_MAX * SDH_BLOCK_SIZE + 8))
+    {
+        _outside++;
+        return SDH_SELECT_ERROR;
+    }
+
+    if (_cmds++ == _fail_at)
+        return SDH_SELECT_ERROR;
+
+    if (write)
+        memcpy(_card + sector * SDH_BLOCK_SIZE, addr, count * SDH_BLOCK_SIZE);
+    else
+        memcpy(addr, _card + sector * SDH_BLOCK_SIZE, count * SDH_BLOCK_SIZE);
+
+    return Successful;
+}
+
+uint32_t SDH_Read(SDH_T *sdh, SDH_INFO_T *pSD, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_t u32SecCount)
+{
+    return _transfer(pu8BufAddr, u32StartSec, u32SecCount, 0);
+}
+
+uint32_t SDH_Write(SDH_T *sdh, SDH_INFO_T *pSD, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_t u32SecCount)
+{
+    return _transfer(pu8BufAddr, u32StartSec, u32SecCount, 1);
+}
+
+uint32_t SDH_Probe(SDH_T *sdh, SDH_INFO_T *pSD, uint32_t card_num)
+{
+    pSD->sectorSize = SDH_BLOCK_SIZE;
+    pSD->totalSectorN = CARD_BLOCKS;
+
+    return 0;
+}
+
+/* the card interrupt is not modelled, SDH_Read and SDH_Write return when done */
+rt_isr_handler_t rt_hw_interrupt_install(int vector, rt_isr_handler_t handler, void *param, const char *name)
+{
+    return RT_NULL;
+}
+
+void rt_hw_interrupt_umask(int vector) { }
+void nu_sys_ip_reset(E_SYS_IPRST eIPRstIdx) { }
+void nu_sys_ipclk_enable(E_SYS_IPCLK eIPClkIdx) { }
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag) { return RT_EOK; }
+
+/* one thread, the lock only has to be held around each command */
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag) { return RT_EOK; }
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    CHECK(_locked == 0);
+    _locked++;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    CHECK(_locked == 1);
+    _locked--;
+
+    return RT_EOK;
+}
+
+/* random requests read back what the model holds, in the commands expected */
+static void _test_random(rt_device_t dev)
+{
+    long loop, mismatches = 0, bad_cmds = 0, requests[2] = { 0, 0 };
+    int index;
+
+    for (index = 0; index < sizeof(_card); index++)
+        _card[index] = _model[index] = host_test_rand();
+
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        rt_size_t count = 1 + host_test_rand() % REQUEST_MAX;
+        rt_off_t pos = host_test_rand() % (CARD_BLOCKS - count + 1);
+        int offset = host_test_rand() % 8, write = host_test_rand() % 2;
+        rt_uint8_t *buf = _buf + offset;
+        long cmds = _cmds, expect = offset % NU_SDH_DMA_ALIGN ?
+                                     (count + NU_SDH_BOUNCE_BLOCKS - 1) / NU_SDH_BOUNCE_BLOCKS : 1;
+
+        if (write)
+        {
+            for (index = 0; index < count * SDH_BLOCK_SIZE; index++)
+                buf[index] = host_test_rand();
+            memcpy(_model + pos * SDH_BLOCK_SIZE, buf, count * SDH_BLOCK_SIZE);
+            CHECK(rt_device_write(dev, pos, buf, count) == count);
+        }
+        else
+        {
+            memset(_buf, 0, REQUEST_MAX * SDH_BLOCK_SIZE + 8);
+            CHECK(rt_device_read(dev, pos, buf, count) == count);
+            if (memcmp(buf, _model + pos * SDH_BLOCK_SIZE, count * SDH_BLOCK_SIZE) != 0 && mismatches++ < 5)
+                printf("loop %ld: %d blocks at %d into +%d differ\n", loop, (int)count, (int)pos, offset);
+        }
+        requests[write]++;
+
+        if (_cmds - cmds != expect && bad_cmds++ < 5)
+            printf("loop %ld: %d blocks at +%d in %ld commands\n", loop, (int)count, offset, _cmds - cmds);
+    }
+
+    CHECK(mismatches == 0);
+    CHECK(bad_cmds == 0);
+    CHECK(_unaligned == 0 && _oversized == 0 && _outside == 0);
+    CHECK(memcmp(_card, _model, sizeof(_card)) == 0);
+    printf("%ld reads, %ld writes: %ld commands, %ld mismatches, %ld unaligned DMA, %ld oversized bounces\n",
+           requests[0], requests[1], _cmds, mismatches, _unaligned, _oversized);
+}
+
+/* a failing command fails the request, the commands after it are not issued */
+static void _test_error(rt_device_t dev)
+{
+    long cmds = _cmds;
+
+    _fail_at = _cmds + 2;
+    CHECK(rt_device_read(dev, 0, _buf + 1, 100) == 0);
+    CHECK(_cmds - cmds == 3);
+    _fail_at = _cmds;
+    CHECK(rt_device_write(dev, 0, _buf, 100) == 0);
+    CHECK(_cmds - cmds == 4);
+    _fail_at = -1;
+    CHECK(rt_device_read(dev, 0, _buf + 1, 100) == 100);
+    CHECK(memcmp(_buf + 1, _model, 100 * SDH_BLOCK_SIZE) == 0);
+}
+
+/* every command of the test is in the statistics, by direction and size */
+static void _test_stat(rt_device_t dev)
+{
+    static const rt_uint32_t blocks[] = { 1, 2, 3, 4, 7, 8, 255, 256, 1000 };
+    static const int indexes[] = { 0, 1, 1, 2, 2, 3, 7, 8, 8 };
+    struct rt_device_blk_geometry geometry;
+    nu_sdh_stat_t stat;
+    rt_uint32_t sizes = 0;
+    int index;
+
+    for (index = 0; index < sizeof(blocks) / sizeof(blocks[0]); index++)
+        CHECK(nu_sdh_stat_size_index(blocks[index]) == indexes[index]);
+
+    CHECK(rt_device_control(dev, NU_SDH_CTRL_GET_STAT, RT_NULL) == -RT_ERROR);
+    CHECK(rt_device_control(dev, NU_SDH_CTRL_GET_STAT, &stat) == RT_EOK);
+    CHECK(stat.read.cmds + stat.write.cmds == _cmds);
+    CHECK(stat.read.errors == 1 && stat.write.errors == 1);
+    for (index = 0; index < NU_SDH_STAT_SIZES; index++)
+        sizes += stat.read.sizes[index] + stat.write.sizes[index];
+    CHECK(sizes == _cmds - 2);
+    CHECK(stat.read.bounced <= stat.read.blocks && stat.write.bounced <= stat.write.blocks);
+    printf("read: %u commands, %u blocks, %u bounced    write: %u commands, %u blocks, %u bounced\n",
+           (unsigned int)stat.read.cmds, (unsigned int)stat.read.blocks, (unsigned int)stat.read.bounced,
+           (unsigned int)stat.write.cmds, (unsigned int)stat.write.blocks, (unsigned int)stat.write.bounced);
+
+    CHECK(rt_device_control(dev, NU_SDH_CTRL_RESET_STAT, RT_NULL) == RT_EOK);
+    CHECK(rt_device_control(dev, NU_SDH_CTRL_GET_STAT, &stat) == RT_EOK);
+    CHECK(stat.read.cmds == 0 && stat.write.blocks == 0);
+
+    CHECK(rt_device_control(dev, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry) == RT_EOK);
+    CHECK(geometry.bytes_per_sector == SDH_BLOCK_SIZE && geometry.sector_count == CARD_BLOCKS);
+}
+
+int main(void)
+{
+    rt_device_t dev;
+    long cmds;
+
+    _buf = _map32(REQUEST_MAX * SDH_BLOCK_SIZE + 8);
+    CHECK(rt_hw_sdh_init() == RT_EOK);
+    dev = rt_device_find("sdh0");
+    CHECK(dev != RT_NULL);
+    if (dev == RT_NULL)
+        return host_test_report("sdh");
+    CHECK(rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+
+    host_test_srand(22);
+    _test_random(dev);
+    _test_error(dev);
+    _test_stat(dev);
+
+    /* a FAT sector cluster read into a packed structure */
+    cmds = _cmds;
+    CHECK(rt_device_read(dev, 0, _buf + 2, 64) == 64);
+    printf("64 blocks into an unaligned buffer: %ld commands, one per block before\n", _cmds - cmds);
+
+    CHECK(rt_device_close(dev) == RT_EOK);
+
+    return host_test_report("sdh");
+}
@@ -0,0 +1,11 @@
+#ifndef __NUMICRO_H__
+#define __NUMICRO_H__
+
+/* What drv_systick.c takes from the N9H30 headers, the timer is a model. */
+
+#include <stdint.h>
+
+#define IRQ_TMR4        32
+#define IRQ_LEVEL_1     1
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __NU_TIMER_H__
+#define __NU_TIMER_H__
+
+/*
+ * A model of the N9H30 timers in periodic mode: a 24-bit up counter of the
+ * 12 MHz clock which restarts at 0 and sets the interrupt flag when it
+ * reaches the compare value. Only the timer of the tick is modelled.
+ */
+
+#include <stdint.h>
+
+#define TIMER_PERIODIC_MODE       (1UL << 27)
+
+void TIMER_SET_CMP_VALUE(uint32_t timer, uint32_t u32Cmpr);
+void TIMER_ClearIntFlag(uint32_t timer);
+uint32_t TIMER_GetIntFlag(uint32_t timer);
+uint32_t TIMER_GetModuleClock(uint32_t timer);
+void TIMER_Start(uint32_t timer);
+void TIMER_ClearCounter(uint32_t timer);
+uint32_t TIMER_GetCounter(uint32_t timer);
+uint32_t TIMER_GetCompareData(uint32_t timer);
+void TIMER_EnableInt(uint32_t timer);
+uint32_t TIMER_Open(uint32_t timer, uint32_t u32Mode, uint32_t u32Freq);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* drv_systick.c needs nothing of the device drivers without RT_USING_CPUTIME. */
+
+#endif
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * drv_systick.c for the host: the definition of its wait for interrupt is
+ * renamed to an unused function with the ARM instruction, the call goes to
+ * the timer model.
+ */
+void host_wfi(void);
+
+#define nu_cpu_wait_for_interrupt(...)  _HOST_WFI_##__VA_ARGS__
+#define _HOST_WFI_void                  _host_unused_wfi(void)
+#define _HOST_WFI_                      host_wfi()
+
+#include "drv_systick.c"
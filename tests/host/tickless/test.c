@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * Run the tickless idle of idle.c and the tick of drv_systick.c on a model
+ * of the N9H30 timer, and check rt_tick against the time of the model
+ * across long sleeps, early wakeups at any point of a tick, busy periods
+ * and the wrap of the tick.
+ */
+#include <rthw.h>
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "kernel_stub.h"
+#include "NuMicro.h"
+#include "nu_timer.h"
+#include "drv_sys.h"
+
+#define TIMER_CLOCK         12000000
+#define TICK_PERIOD         (TIMER_CLOCK / RT_TICK_PER_SECOND)
+#define COUNTER_MAX         0xFFFFFF
+#define NEVER               UINT64_MAX
+
+#define IDLE_LOOPS          200000
+#define ONESHOT_TIMERS      4
+
+/* the timer model */
+static uint64_t _now;               /* counts since the start */
+static uint32_t _counter;
+static uint32_t _cmp;
+static int _flag;
+static uint64_t _wake = NEVER;      /* another interrupt wakes the CPU up at */
+static long _cmp_behind;            /* compare values written behind the counter */
+static long _lost_ticks;
+
+static rt_isr_handler_t _isr;       /* the tick interrupt of drv_systick.c */
+static rt_tick_t _base;             /* rt_tick at _now 0 */
+static int _in_isr;
+
+static void _tick_irq(void);
+
+/* Time passes: the counter restarts at each match, the tick interrupt is taken if enabled. */
+static void _step(uint64_t counts)
+{
+    while (counts)
+    {
+        uint64_t match = _counter < _cmp ? _cmp - _counter : COUNTER_MAX + 1 - _counter + _cmp;
+
+        if (counts < match)
+        {
+            _counter = (_counter + counts) & COUNTER_MAX;
+            _now += counts;
+            return;
+        }
+
+        counts -= match;
+        _now += match;
+        _counter = 0;
+        if (_flag)
+            _lost_ticks++;
+        _flag = 1;
+        if (!host_irq_disabled)
+            _tick_irq();
+    }
+}
+
+/* Each access to the timer takes some time. */
+static void _access(void)
+{
+    _step(1 + host_test_rand() % 32);
+}
+
+void TIMER_SET_CMP_VALUE(uint32_t timer, uint32_t u32Cmpr)
+{
+    _access();
+    if (u32Cmpr <= _counter && !_in_isr)
+        _cmp_behind++;
+    _cmp = u32Cmpr;
+}
+
+void TIMER_ClearIntFlag(uint32_t timer) { _access(); _flag = 0; }
+uint32_t TIMER_GetIntFlag(uint32_t timer) { _access(); return _flag; }
+uint32_t TIMER_GetModuleClock(uint32_t timer) { return TIMER_CLOCK; }
+void TIMER_Start(uint32_t timer) { }
+void TIMER_ClearCounter(uint32_t timer) { _access(); _counter = 0; }
+uint32_t TIMER_GetCounter(uint32_t timer) { _access(); return _counter; }
+uint32_t TIMER_GetCompareData(uint32_t timer) { return _cmp; }
+void TIMER_EnableInt(uint32_t timer) { }
+
+uint32_t TIMER_Open(uint32_t timer, uint32_t u32Mode, uint32_t u32Freq)
+{
+    _cmp = TIMER_CLOCK / u32Freq;
+    _counter = 0;
+
+    return u32Freq;
+}
+
+void nu_sys_ipclk_enable(E_SYS_IPCLK eIPClkIdx) { }
+void nu_sys_ip_reset(E_SYS_IPRST eIPRstIdx) { }
+
+rt_isr_handler_t rt_hw_interrupt_install(int vector, rt_isr_handler_t handler, void *param, const char *name)
+{
+    _isr = handler;
+
+    return RT_NULL;
+}
+
+void rt_hw_interrupt_set_priority(int vector, int priority) { }
+void rt_hw_interrupt_umask(int vector) { }
+
+/* The CPU sleeps until the tick interrupt or another one. */
+void host_wfi(void)
+{
+    uint64_t match = _counter < _cmp ? _cmp - _counter : COUNTER_MAX + 1 - _counter + _cmp;
+
+    if (_wake != NEVER && _wake > _now && _wake - _now < match)
+        _step(_wake - _now);
+    else if (_wake == NEVER || _wake > _now)
+        _step(match);
+}
+
+/* for rt_tickless_idle */
+#include "idle.c"
+
+static void _tick_irq(void)
+{
+    if (_in_isr || !_flag)
+        return;
+
+    _in_isr = 1;
+    _isr(IRQ_TMR4, RT_NULL);
+    _in_isr = 0;
+}
+
+/* the tick the time of the model is in */
+static rt_tick_t _model_tick(void)
+{
+    return _base + (rt_tick_t)(_now / TICK_PERIOD);
+}
+
+/* the tick matches the time once the tick interrupt is taken */
+static long _tick_errors;
+
+static void _check_tick(void)
+{
+    if (!_flag && rt_tick_get() != _model_tick())
+    {
+        if (_tick_errors++ < 5)
+            printf("rt_tick %u, model %u\n", (unsigned)rt_tick_get(), (unsigned)_model_tick());
+    }
+}
+
+static struct rt_timer _periodic;
+static struct rt_timer _oneshot[ONESHOT_TIMERS];
+static rt_tick_t _due[ONESHOT_TIMERS];
+static long _fired, _wrong_fire;
+
+static void _oneshot_timeout(void *parameter)
+{
+    int index = (int)(rt_ubase_t)parameter;
+
+    _fired++;
+    if (rt_tick_get() != _due[index] || _model_tick() != _due[index])
+        _wrong_fire++;
+}
+
+static void _periodic_timeout(void *parameter)
+{
+}
+
+static long _delay_errors;
+
+/* rt_hw_us_delay counts the phase in the tick, whatever the compare value is */
+static void _check_us_delay(void)
+{
+    rt_uint32_t us = 1 + host_test_rand() % 3000;
+    uint64_t begin = _now, elapsed;
+
+    rt_hw_us_delay(us);
+    elapsed = _now - begin;
+    if (elapsed < (uint64_t)us * (TIMER_CLOCK / 1000000) ||
+        elapsed > (uint64_t)us * (TIMER_CLOCK / 1000000) + 256)
+    {
+        if (_delay_errors++ < 5)
+            printf("rt_hw_us_delay(%u) took %llu counts\n", us, (unsigned long long)elapsed);
+    }
+}
+
+int main(void)
+{
+    uint64_t idle_counts = 0, begin;
+    long loop, wakeups = 0;
+    int index;
+
+    host_irq_handler = _tick_irq;
+    rt_system_timer_init();
+    rt_hw_systick_init();
+
+    /* across the wrap of the tick */
+    _base = RT_TICK_MAX - 1000000;
+    rt_tick_set(_base);
+
+    rt_timer_init(&_periodic, "periodic", _periodic_timeout, RT_NULL, 7, RT_TIMER_FLAG_PERIODIC);
+    for (index = 0; index < ONESHOT_TIMERS; index++)
+    {
+        rt_timer_init(&_oneshot[index], "oneshot", _oneshot_timeout, (void *)(rt_ubase_t)index,
+                      1, RT_TIMER_FLAG_ONE_SHOT);
+    }
+
+    host_test_srand(4);
+    for (loop = 0; loop < IDLE_LOOPS; loop++)
+    {
+        rt_uint32_t dice = host_test_rand() % 100;
+
+        /* the threads start and stop timers, from 1 tick to beyond the reach of the counter */
+        index = host_test_rand() % ONESHOT_TIMERS;
+        if (dice < 20 && !(_oneshot[index].parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            rt_tick_t timeout = 1 + host_test_rand() % 3000;
+
+            rt_timer_control(&_oneshot[index], RT_TIMER_CTRL_SET_TIME, &timeout);
+            rt_timer_start(&_oneshot[index]);
+            _due[index] = rt_tick_get() + timeout;
+        }
+        else if (dice < 22)
+        {
+            rt_timer_stop(&_oneshot[index]);
+        }
+        else if (dice < 24)
+        {
+            if (_periodic.parent.flag & RT_TIMER_FLAG_ACTIVATED)
+                rt_timer_stop(&_periodic);
+            else
+                rt_timer_start(&_periodic);
+        }
+
+        /* and run for a while */
+        if (dice < 40)
+            _step(host_test_rand() % (3 * TICK_PERIOD));
+        if (dice >= 90)
+            _check_us_delay();
+        _check_tick();
+
+        /* then the system is idle, until the next timer or another interrupt */
+        if (host_test_rand() % 2)
+            _wake = _now + host_test_rand() % (2000 * TICK_PERIOD);
+        else
+            _wake = NEVER;
+
+        begin = _now;
+        rt_tickless_idle();
+        idle_counts += _now - begin;
+        if (_wake <= _now)
+            wakeups++;
+        _wake = NEVER;
+        _check_tick();
+    }
+
+    CHECK(_tick_errors == 0);
+    CHECK(_wrong_fire == 0);
+    CHECK(_delay_errors == 0);
+    CHECK(_cmp_behind == 0);
+    CHECK(_lost_ticks == 0);
+    CHECK(rt_tick_get() - _base == _now / TICK_PERIOD);
+    printf("%d idle loops, %ld woken early, %llu ticks idle of %llu, %ld timeouts, tick %u\n",
+           IDLE_LOOPS, wakeups, (unsigned long long)(idle_counts / TICK_PERIOD),
+           (unsigned long long)(_now / TICK_PERIOD), _fired, (unsigned)rt_tick_get());
+
+    return host_test_report("tickless");
+}
@@ -0,0 +1,23 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The timer wheel, or the sorted list when HOST_TIMER_LIST is defined. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#ifndef HOST_TIMER_LIST
+#define RT_USING_TIMER_WHEEL
+#endif
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * Stress the hard timers of timer.c, then measure them with 10k timers:
+ * the cost of rt_timer_start, of rt_timer_check per tick, and the longest
+ * time interrupts are disabled. test is built with the timer wheel, test_list
+ * with the sorted list.
+ */
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "kernel_stub.h"
+
+#ifdef RT_USING_TIMER_WHEEL
+#define BACKEND             "wheel"
+#else
+#define BACKEND             "list"
+#endif
+
+#define STRESS_TIMERS       3000
+#define IRQ_TIMERS          500
+#define STRESS_OPS          400000
+#define BENCH_TIMERS        10000
+#define BENCH_TICKS         20000
+
+static struct rt_timer _timers[BENCH_TIMERS];
+static rt_tick_t _due[BENCH_TIMERS];
+static rt_uint8_t _active[BENCH_TIMERS];
+static long _fired, _early, _late, _stray, _irq_off_calls;
+/* the tick of the previous rt_timer_check */
+static rt_tick_t _checked;
+
+static void _stress_timeout(void *parameter)
+{
+    int index = (int)(rt_ubase_t)parameter;
+
+    if (!_active[index])
+    {
+        /* stopped, but called anyway */
+        _stray++;
+        return;
+    }
+    if ((rt_tick_t)(host_tick - _due[index]) >= RT_TICK_MAX / 2)
+        _early++;
+    else if ((rt_tick_t)(_checked - _due[index]) < RT_TICK_MAX / 2)
+        _late++;
+    if (host_irq_disabled)
+        _irq_off_calls++;
+
+    _active[index] = 0;
+    _fired++;
+}
+
+/* the earliest due tick of the active timers, RT_TICK_MAX for none */
+static rt_tick_t _next_due(int count)
+{
+    rt_tick_t next = RT_TICK_MAX, distance = RT_TICK_MAX;
+    int index;
+
+    for (index = 0; index < count; index++)
+    {
+        if (_active[index] && (rt_tick_t)(_due[index] - host_tick) < distance)
+        {
+            distance = _due[index] - host_tick;
+            next = _due[index];
+        }
+    }
+
+    return next;
+}
+
+static void _start(int index, rt_tick_t timeout)
+{
+    rt_timer_control(&_timers[index], RT_TIMER_CTRL_SET_TIME, &timeout);
+    rt_timer_start(&_timers[index]);
+    _due[index] = host_tick + timeout;
+    _active[index] = 1;
+}
+
+static rt_tick_t _random_timeout(void)
+{
+    return host_test_rand() % 4 ? host_test_rand() % 300 + 1 : host_test_rand() % 2000000 + 1;
+}
+
+/*
+ * An interrupt which starts and stops timers of its own. It leaves alone the
+ * timers due, they may be on the way to their callback already.
+ */
+static void _stress_irq(void)
+{
+    int index = STRESS_TIMERS + host_test_rand() % IRQ_TIMERS;
+
+    if (host_test_rand() % 4)
+        return;
+    if (_active[index] && (rt_tick_t)(host_tick - _due[index]) < RT_TICK_MAX / 2)
+        return;
+    if (host_test_rand() % 4)
+    {
+        _start(index, _random_timeout());
+    }
+    else
+    {
+        rt_timer_stop(&_timers[index]);
+        _active[index] = 0;
+    }
+}
+
+static void _advance(rt_tick_t ticks)
+{
+    _checked = host_tick;
+    host_tick += ticks;
+    rt_timer_check();
+}
+
+/*
+ * Start, restart and stop timers at random, with short and long timeouts,
+ * while the tick wraps and sometimes jumps as it does after tickless idle,
+ * and an interrupt does the same whenever it is let in.
+ * No timer may fire early, after a check it was due at, twice or after
+ * rt_timer_stop, and rt_timer_next_timeout_tick may not be later than the
+ * earliest timer.
+ */
+static void _test_stress(void)
+{
+    rt_tick_t next, due;
+    long op, wrong_next = 0;
+    int index;
+
+    host_tick = 0xFFFF0000;
+    host_test_srand(2);
+    memset(_active, 0, sizeof(_active));
+    _fired = _early = _late = _stray = _irq_off_calls = 0;
+
+    for (index = 0; index < STRESS_TIMERS + IRQ_TIMERS; index++)
+    {
+        rt_timer_init(&_timers[index], "stress", _stress_timeout, (void *)(rt_ubase_t)index,
+                      1, RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    }
+
+    host_irq_handler = _stress_irq;
+    for (op = 0; op < STRESS_OPS; op++)
+    {
+        rt_uint32_t dice = host_test_rand() % 10;
+
+        index = host_test_rand() % STRESS_TIMERS;
+        if (dice < 3)
+        {
+            _start(index, _random_timeout());
+        }
+        else if (dice < 4)
+        {
+            rt_timer_stop(&_timers[index]);
+            _active[index] = 0;
+        }
+        else
+        {
+            if (op % 16 == 0)
+            {
+                host_irq_handler = RT_NULL;
+                next = rt_timer_next_timeout_tick();
+                due = _next_due(STRESS_TIMERS + IRQ_TIMERS);
+                host_irq_handler = _stress_irq;
+                if (due != RT_TICK_MAX && (rt_tick_t)(next - host_tick) > (rt_tick_t)(due - host_tick))
+                    wrong_next++;
+            }
+            _advance(host_test_rand() % 50 ? 1 : host_test_rand() % 5000);
+        }
+    }
+
+    /* every timer left fires */
+    host_irq_handler = RT_NULL;
+    for (op = 0; op < STRESS_TIMERS + IRQ_TIMERS && (due = _next_due(STRESS_TIMERS + IRQ_TIMERS)) != RT_TICK_MAX; op++)
+    {
+        _advance(due - host_tick);
+    }
+
+    for (index = 0; index < STRESS_TIMERS + IRQ_TIMERS; index++)
+    {
+        CHECK(!_active[index]);
+        rt_timer_detach(&_timers[index]);
+    }
+    CHECK(_early == 0);
+    CHECK(_late == 0);
+    CHECK(_stray == 0);
+    CHECK(wrong_next == 0);
+    CHECK(_irq_off_calls == 0);
+    printf("%-5s stress: %ld timeouts\n", BACKEND, _fired);
+}
+
+/*
+ * A timer started after the tick ran on for more than half its range, as a
+ * long tickless idle does, still fires on time.
+ */
+static void _test_long_idle(void)
+{
+    struct rt_timer timer;
+
+    host_tick = 100;
+    memset(_active, 0, sizeof(_active));
+    _fired = _early = _late = 0;
+    rt_timer_init(&timer, "idle", _stress_timeout, (void *)0, 10, RT_TIMER_FLAG_ONE_SHOT);
+
+    _due[0] = host_tick + 10;
+    _active[0] = 1;
+    rt_timer_start(&timer);
+    _advance(10);
+    CHECK(_fired == 1);
+
+    host_tick += 0x90000000;
+    _due[0] = host_tick + 10;
+    _active[0] = 1;
+    rt_timer_start(&timer);
+    _advance(5);
+    CHECK(_fired == 1);
+    _advance(5);
+    CHECK(_fired == 2);
+    CHECK(_early == 0 && _late == 0);
+
+    rt_timer_detach(&timer);
+}
+
+static void _bench_timeout(void *parameter)
+{
+    struct rt_timer *timer = parameter;
+    rt_tick_t timeout = host_test_rand() % 5000 + 1;
+
+    /* as a retransmission timer is armed again */
+    rt_timer_control(timer, RT_TIMER_CTRL_SET_TIME, &timeout);
+    rt_timer_start(timer);
+}
+
+/*
+ * 10k one-shot timers with 1..5000 ticks to go, each started again from its
+ * callback, and 1 tick per rt_timer_check.
+ */
+static void _bench(void)
+{
+    uint64_t *start_ns = malloc(BENCH_TIMERS * sizeof(uint64_t));
+    uint64_t *check_ns = malloc(BENCH_TICKS * sizeof(uint64_t));
+    uint64_t begin, start_off_ns, start_off_p99, start_p99;
+    rt_tick_t timeout;
+    int index;
+
+    host_tick = 0;
+    host_test_srand(3);
+    for (index = 0; index < BENCH_TIMERS; index++)
+    {
+        rt_timer_init(&_timers[index], "bench", _bench_timeout, &_timers[index],
+                      1, RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    }
+
+    host_irq_off_log_size = BENCH_TICKS * 16;
+    host_irq_off_log = malloc(host_irq_off_log_size * sizeof(uint64_t));
+    host_irq_reset_stat();
+    for (index = 0; index < BENCH_TIMERS; index++)
+    {
+        timeout = host_test_rand() % 5000 + 1;
+        rt_timer_control(&_timers[index], RT_TIMER_CTRL_SET_TIME, &timeout);
+        begin = host_test_now_ns();
+        rt_timer_start(&_timers[index]);
+        start_ns[index] = host_test_now_ns() - begin;
+    }
+    start_off_ns = host_irq_off_max_ns;
+    start_off_p99 = host_test_percentile(host_irq_off_log, host_irq_off_log_count, 99);
+
+    host_irq_reset_stat();
+    for (index = 0; index < BENCH_TICKS; index++)
+    {
+        host_tick++;
+        begin = host_test_now_ns();
+        rt_timer_check();
+        check_ns[index] = host_test_now_ns() - begin;
+    }
+
+    start_p99 = host_test_percentile(start_ns, BENCH_TIMERS, 99);
+    printf("%-5s start: p50 %6llu ns, p99 %6llu ns, irq off p99 %6llu ns, max %7llu ns\n", BACKEND,
+           (unsigned long long)host_test_percentile(start_ns, BENCH_TIMERS, 50),
+           (unsigned long long)start_p99, (unsigned long long)start_off_p99,
+           (unsigned long long)start_off_ns);
+    printf("%-5s check: p50 %6llu ns, p99 %6llu ns, irq off p99 %6llu ns, max %7llu ns\n", BACKEND,
+           (unsigned long long)host_test_percentile(check_ns, BENCH_TICKS, 50),
+           (unsigned long long)host_test_percentile(check_ns, BENCH_TICKS, 99),
+           (unsigned long long)host_test_percentile(host_irq_off_log, host_irq_off_log_count, 99),
+           (unsigned long long)host_irq_off_max_ns);
+
+    for (index = 0; index < BENCH_TIMERS; index++)
+        rt_timer_detach(&_timers[index]);
+    free(host_irq_off_log);
+    host_irq_off_log = RT_NULL;
+    host_irq_off_log_size = 0;
+    free(check_ns);
+    free(start_ns);
+}
+
+int main(void)
+{
+    rt_system_timer_init();
+
+    _test_stress();
+    _test_long_idle();
+    _bench();
+
+    return host_test_report("timer " BACKEND);
+}
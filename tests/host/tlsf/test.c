@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * Replay an allocation trace on the small memory algorithm and on TLSF, check
+ * the content of every block survives, and report the latency of each.
+ *
+ *   ./test [trace]
+ *
+ * A trace has one operation per line, as printed by malloc/free hooks:
+ *
+ *   m <address> <size>      allocation
+ *   r <address> <new address> <size>  reallocation
+ *   f <address>             release
+ *
+ * Without a trace, a synthetic one is made: LVGL-like churn of small objects
+ * with some long-lived ones, and draw buffers of several KB now and then.
+ */
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+
+#define HEAP_SIZE           (1024 * 1024)
+#define SLOT_MAX            8192
+#define SYNTH_OPS           400000
+#define SYNTH_SLOTS         1024
+
+enum
+{
+    OP_ALLOC,
+    OP_REALLOC,
+    OP_FREE,
+};
+
+struct trace_op
+{
+    rt_uint8_t type;
+    rt_uint32_t slot;
+    rt_uint32_t size;
+};
+
+struct heap_ops
+{
+    const char *name;
+    void *(*init)(void *begin, rt_size_t size);
+    void *(*alloc)(void *heap, rt_size_t size);
+    void *(*realloc)(void *heap, void *ptr, rt_size_t size);
+    void (*free)(void *ptr);
+};
+
+static struct trace_op *_trace;
+static size_t _trace_num, _trace_max;
+
+static void *_smem_init(void *begin, rt_size_t size) { return rt_smem_init("smem", begin, size); }
+static void *_smem_alloc(void *heap, rt_size_t size) { return rt_smem_alloc(heap, size); }
+static void *_smem_realloc(void *heap, void *ptr, rt_size_t size) { return rt_smem_realloc(heap, ptr, size); }
+static void *_tlsf_init(void *begin, rt_size_t size) { return rt_tlsf_init("tlsf", begin, size); }
+static void *_tlsf_alloc(void *heap, rt_size_t size) { return rt_tlsf_alloc(heap, size); }
+static void *_tlsf_realloc(void *heap, void *ptr, rt_size_t size) { return rt_tlsf_realloc(heap, ptr, size); }
+
+static const struct heap_ops _heaps[] =
+{
+    { "small mem", _smem_init, _smem_alloc, _smem_realloc, rt_smem_free },
+    { "tlsf",      _tlsf_init, _tlsf_alloc, _tlsf_realloc, rt_tlsf_free },
+};
+
+static void _trace_add(int type, rt_uint32_t slot, rt_uint32_t size)
+{
+    if (_trace_num == _trace_max)
+    {
+        _trace_max = _trace_max ? _trace_max * 2 : 4096;
+        _trace = realloc(_trace, _trace_max * sizeof(struct trace_op));
+    }
+    _trace[_trace_num].type = type;
+    _trace[_trace_num].slot = slot;
+    _trace[_trace_num].size = size;
+    _trace_num++;
+}
+
+/* The addresses of a recorded trace are mapped to slots. */
+static unsigned long _slot_addr[SLOT_MAX];
+static int _slot_used[SLOT_MAX];
+
+static int _slot_find(unsigned long addr)
+{
+    int slot;
+
+    for (slot = 0; slot < SLOT_MAX; slot++)
+    {
+        if (_slot_used[slot] && _slot_addr[slot] == addr)
+            return slot;
+    }
+
+    return -1;
+}
+
+static int _slot_new(unsigned long addr)
+{
+    int slot;
+
+    for (slot = 0; slot < SLOT_MAX; slot++)
+    {
+        if (!_slot_used[slot])
+        {
+            _slot_used[slot] = 1;
+            _slot_addr[slot] = addr;
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+static int _trace_load(const char *path)
+{
+    char line[128];
+    unsigned long addr, new_addr;
+    unsigned int size;
+    int slot;
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL)
+    {
+        printf("can't open %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file))
+    {
+        if (sscanf(line, "m %lx %u", &addr, &size) == 2)
+        {
+            if ((slot = _slot_new(addr)) >= 0)
+                _trace_add(OP_ALLOC, slot, size);
+        }
+        else if (sscanf(line, "r %lx %lx %u", &addr, &new_addr, &size) == 3)
+        {
+            if ((slot = _slot_find(addr)) >= 0)
+            {
+                _slot_addr[slot] = new_addr;
+                _trace_add(OP_REALLOC, slot, size);
+            }
+        }
+        else if (sscanf(line, "f %lx", &addr) == 1)
+        {
+            if ((slot = _slot_find(addr)) >= 0)
+            {
+                _slot_used[slot] = 0;
+                _trace_add(OP_FREE, slot, 0);
+            }
+        }
+    }
+    fclose(file);
+
+    return 0;
+}
+
+static rt_uint32_t _synth_size(void)
+{
+    rt_uint32_t dice = host_test_rand() % 100;
+
+    if (dice < 70)
+        return 8 + host_test_rand() % 120;      /* styles, objects, strings */
+    if (dice < 97)
+        return 128 + host_test_rand() % 896;    /* object trees, masks */
+
+    return 4096 + host_test_rand() % 28672;     /* draw and image buffers */
+}
+
+static void _trace_synth(void)
+{
+    static rt_uint8_t live[SYNTH_SLOTS];
+    rt_uint32_t op, slot;
+
+    host_test_srand(1);
+    for (op = 0; op < SYNTH_OPS; op++)
+    {
+        slot = host_test_rand() % SYNTH_SLOTS;
+        if (!live[slot])
+        {
+            _trace_add(OP_ALLOC, slot, _synth_size());
+            live[slot] = 1;
+        }
+        else if (slot < SYNTH_SLOTS / 8 && host_test_rand() % 64)
+        {
+            /* the first slots are long-lived objects, rarely released */
+            continue;
+        }
+        else if (host_test_rand() % 8 == 0)
+        {
+            _trace_add(OP_REALLOC, slot, _synth_size());
+        }
+        else
+        {
+            _trace_add(OP_FREE, slot, 0);
+            live[slot] = 0;
+        }
+    }
+}
+
+/* The small memory algorithm keeps the pool address in 32 bits as on the target. */
+static void *_heap_map(size_t size)
+{
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory;
+
+#ifdef MAP_32BIT
+    flags |= MAP_32BIT;
+#endif
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED)
+        return NULL;
+    /* fault the pages in now, not in the timed operations */
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+static void _fill(void *ptr, rt_uint32_t slot, rt_uint32_t size)
+{
+    memset(ptr, (rt_uint8_t)(slot * 7 + 1), size);
+}
+
+static int _verify(const void *ptr, rt_uint32_t slot, rt_uint32_t size)
+{
+    const rt_uint8_t *byte = ptr;
+    rt_uint32_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        if (byte[index] != (rt_uint8_t)(slot * 7 + 1))
+            return 0;
+    }
+
+    return 1;
+}
+
+static void _replay(const struct heap_ops *ops)
+{
+    static void *ptr[SLOT_MAX];
+    static rt_uint32_t size[SLOT_MAX];
+    uint64_t *latency = malloc(_trace_num * sizeof(uint64_t));
+    void *memory = _heap_map(HEAP_SIZE);
+    void *heap = ops->init(memory, HEAP_SIZE);
+    size_t index, failed = 0, corrupted = 0;
+    uint64_t start, sum = 0, p99;
+
+    memset(ptr, 0, sizeof(ptr));
+    for (index = 0; index < _trace_num; index++)
+    {
+        const struct trace_op *op = &_trace[index];
+        void *result = RT_NULL;
+
+        if (op->type != OP_ALLOC && ptr[op->slot] == RT_NULL)
+        {
+            /* the allocation failed earlier */
+            latency[index] = 0;
+            continue;
+        }
+        if (op->type != OP_ALLOC && !_verify(ptr[op->slot], op->slot, size[op->slot]))
+            corrupted++;
+
+        start = host_test_now_ns();
+        switch (op->type)
+        {
+        case OP_ALLOC:
+            result = ops->alloc(heap, op->size);
+            break;
+        case OP_REALLOC:
+            result = ops->realloc(heap, ptr[op->slot], op->size);
+            break;
+        case OP_FREE:
+            ops->free(ptr[op->slot]);
+            break;
+        }
+        latency[index] = host_test_now_ns() - start;
+        sum += latency[index];
+
+        if (op->type == OP_FREE)
+        {
+            ptr[op->slot] = RT_NULL;
+        }
+        else if (result == RT_NULL)
+        {
+            /* a failed realloc keeps the old block */
+            failed++;
+            if (op->type == OP_ALLOC)
+                ptr[op->slot] = RT_NULL;
+        }
+        else
+        {
+            if (op->type == OP_REALLOC &&
+                !_verify(result, op->slot, size[op->slot] < op->size ? size[op->slot] : op->size))
+                corrupted++;
+            ptr[op->slot] = result;
+            size[op->slot] = op->size;
+            _fill(result, op->slot, op->size);
+        }
+    }
+
+    for (index = 0; index < SLOT_MAX; index++)
+    {
+        if (ptr[index])
+        {
+            if (!_verify(ptr[index], index, size[index]))
+                corrupted++;
+            ops->free(ptr[index]);
+        }
+    }
+
+    CHECK(corrupted == 0);
+    /* sorts the samples for the other figures too */
+    p99 = host_test_percentile(latency, _trace_num, 99);
+    printf("%-10s %8zu ops, %5zu failed: mean %5llu ns, p99 %6llu ns, p99.9 %6llu ns, worst %7llu ns\n",
+           ops->name, _trace_num, failed, (unsigned long long)(sum / _trace_num),
+           (unsigned long long)p99,
+           (unsigned long long)latency[_trace_num - _trace_num / 1000 - 1],
+           (unsigned long long)latency[_trace_num - 1]);
+
+    munmap(memory, HEAP_SIZE);
+    free(latency);
+}
+
+static void _test_tlsf_edges(void)
+{
+    void *memory = malloc(64 * 1024);
+    rt_tlsf_t heap = rt_tlsf_init("edge", memory, 64 * 1024);
+    void *ptr, *grown;
+
+    CHECK(heap != RT_NULL);
+    CHECK(rt_tlsf_alloc(heap, 0) == RT_NULL);
+    CHECK(rt_tlsf_alloc(heap, 64 * 1024) == RT_NULL);
+
+    ptr = rt_tlsf_alloc(heap, 100);
+    CHECK(ptr != RT_NULL && ((rt_ubase_t)ptr % RT_ALIGN_SIZE) == 0);
+    CHECK(rt_tlsf_usable_size(ptr) >= 100);
+    memset(ptr, 0x5a, 100);
+    grown = rt_tlsf_realloc(heap, ptr, 3000);
+    CHECK(grown != RT_NULL && ((rt_uint8_t *)grown)[99] == 0x5a);
+    CHECK(rt_tlsf_realloc(heap, grown, 0) == RT_NULL);
+
+    /* everything merged back: the largest block fits again */
+    ptr = rt_tlsf_alloc(heap, 32 * 1024);
+    CHECK(ptr != RT_NULL);
+    rt_tlsf_free(ptr);
+    CHECK(heap->used == 0);
+
+    free(memory);
+}
+
+int main(int argc, char **argv)
+{
+    size_t index;
+
+    if (argc > 1)
+    {
+        if (_trace_load(argv[1]) != 0)
+            return 1;
+    }
+    else
+    {
+        _trace_synth();
+    }
+
+    _test_tlsf_edges();
+    for (index = 0; index < sizeof(_heaps) / sizeof(_heaps[0]); index++)
+        _replay(&_heaps[index]);
+
+    free(_trace);
+
+    return host_test_report("tlsf");
+}
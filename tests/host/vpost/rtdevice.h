@@ -0,0 +1,6 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* drv_vpost.c needs only the graphic device of rtdef.h. */
+
+#endif
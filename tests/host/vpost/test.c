@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The frame queue of drv_vpost.c driven by a simulated vsync at 60 Hz: the
+ * panel raises it while a layer is opened, the soft timer while none is. A
+ * vsync comes when the driver waits for one, and at random when interrupts
+ * are enabled, so also between the driver reading the vsync counter and
+ * waiting. Frames are submitted to the lcd and osd layers at random, panned
+ * or with a target vsync in the past or the future, between waits for
+ * fences and vsyncs, layers opened and closed, and FIFO under-runs. Every
+ * frame must be shown once and in order, never before its target or the
+ * vsync after its submission, never held past the vsync it could be shown
+ * at; each wait must return at the vsync it waits for, and the statistics
+ * must add up. Then the panel hangs and the waits must time out.
+ */
+/* the msh commands of the driver take atol from stdlib.h of the target */
+#include <stdlib.h>
+#include "drv_vpost.c"
+#include <stdio.h>
+#include "host_test.h"
+#include "kernel_stub.h"
+
+#define PANEL_W             64
+#define PANEL_H             32
+#define VSYNC_HZ            60
+#define LOOPS               100000
+#define FRAMES_MAX          (LOOPS + 16)
+#define VSYNCS_MAX          (8 * LOOPS)
+
+/* the frames submitted to a layer, the buffer of frame k is token[k] */
+struct layer_log
+{
+    rt_uint8_t token[FRAMES_MAX];
+    /* the vsyncs before and after the submission, the target, the vsync it was shown at */
+    rt_uint32_t before[FRAMES_MAX], after[FRAMES_MAX], target[FRAMES_MAX], shown_at[FRAMES_MAX];
+    rt_uint32_t submitted, shown;
+    long stalls, repeats;
+};
+
+/* the model of the panel */
+static UINT32 _int_cs, _dccs, _divctl1;
+static int _panel_on, _soft_on, _hang, _in_vsync;
+static rt_isr_handler_t _isr;
+static void *_isr_param;
+static rt_timer_t _soft_timer;
+static rt_uint32_t _vsyncs, _event_set;
+static rt_uint64_t *_stamps;
+static long _underruns, _timeouts, _early_waits, _late_waits;
+static VPOST_T _lcm = { .u32DevWidth = PANEL_W, .u32DevHeight = PANEL_H };
+
+static struct layer_log _log[eVpost_Cnt];
+
+static void _show(int layer, void *buf)
+{
+    struct layer_log *log = &_log[layer];
+    long k = (rt_uint8_t *)buf - log->token;
+
+    CHECK(_in_vsync);
+    CHECK(k == log->shown);
+    if (k != log->shown)
+        return;
+    log->shown_at[k] = s_u32VSyncBlank;
+    log->shown++;
+}
+
+/* the start of the vertical blanking, from the panel or the soft timer */
+static void _vsync(void)
+{
+    rt_uint32_t shown[eVpost_Cnt];
+    int layer;
+
+    CHECK(_panel_on + _soft_on == 1);
+    CHECK(_vsyncs + 1 < VSYNCS_MAX);
+    _vsyncs++;
+    host_tick += (rt_uint64_t)_vsyncs * RT_TICK_PER_SECOND / VSYNC_HZ -
+                 (rt_uint64_t)(_vsyncs - 1) * RT_TICK_PER_SECOND / VSYNC_HZ;
+    _stamps[_vsyncs] = (rt_uint64_t)host_tick * (1000000 / RT_TICK_PER_SECOND);
+
+    for (layer = 0; layer < eVpost_Cnt; layer++)
+        shown[layer] = _log[layer].shown;
+
+    _in_vsync = 1;
+    if (_panel_on)
+    {
+        _int_cs |= VPOSTB_DISP_F_INT | VPOSTB_DISP_F_STATUS;
+        _isr(IRQ_LCD, _isr_param);
+        CHECK((_int_cs & VPOSTB_DISP_F_STATUS) == 0);
+    }
+    else
+    {
+        _soft_timer->timeout_func(_soft_timer->parameter);
+    }
+    _in_vsync = 0;
+
+    CHECK(s_u32VSyncBlank == _vsyncs);
+    for (layer = 0; layer < eVpost_Cnt; layer++)
+    {
+        CHECK(_log[layer].shown - shown[layer] <= 1);
+        if (_log[layer].shown == shown[layer] && nu_fbdev[layer].dev.ref_count)
+            _log[layer].repeats++;
+    }
+}
+
+static void _underrun(void)
+{
+    _int_cs |= VPOSTB_UNDERRUN_INT;
+    _isr(IRQ_LCD, _isr_param);
+    CHECK((_int_cs & VPOSTB_UNDERRUN_INT) == 0);
+    _underruns++;
+}
+
+/* interrupts come when they are enabled, none from a hung panel */
+static void _interrupt(void)
+{
+    if (_hang)
+        return;
+
+    switch (host_test_rand() % 16)
+    {
+    case 0:
+    case 1:
+    case 2:
+        _vsync();
+        break;
+    case 3:
+        if (_panel_on)
+            _underrun();
+        break;
+    default:
+        break;
+    }
+}
+
+void host_outpw(UINT32 port, UINT32 value)
+{
+    switch (port)
+    {
+    case REG_LCM_INT_CS:
+        /* the status bits are cleared by writing ones */
+        _int_cs = (value & 0x07FFFFFF) | (_int_cs & ~value & 0xF8000000);
+        break;
+    case REG_LCM_DCCS:
+        _dccs = value;
+        break;
+    case REG_CLK_DIVCTL1:
+        _divctl1 = value;
+        break;
+    default:
+        CHECK(0);
+        break;
+    }
+}
+
+UINT32 host_inpw(UINT32 port)
+{
+    switch (port)
+    {
+    case REG_LCM_INT_CS:
+        return _int_cs;
+    case REG_LCM_DCCS:
+        return _dccs;
+    case REG_CLK_DIVCTL1:
+        return _divctl1;
+    default:
+        CHECK(0);
+        return 0;
+    }
+}
+
+VPOST_T *vpostLCMGetInstance(uint32_t u32DisplayPanelID) { return &_lcm; }
+void vpostLCMInit(uint32_t u32DisplayPanelID) { }
+void vpostLCMDeinit(void) { }
+void vpostVAScalingCtrl(uint8_t u8HIntegral, uint16_t u16HDecimal, uint8_t u8VIntegral, uint16_t u16VDecimal, uint32_t u32Mode) { }
+void vpostSetVASrc(uint32_t u32VASrcType) { }
+void vpostSetOSDSrc(uint32_t u32OSDSrcType) { }
+void vpostOSDSetWindow(uint32_t u32XStart, uint32_t u32YStart, uint32_t u32Width, uint32_t u32Height) { }
+void vpostOSDScalingCtrl(uint8_t u8HIntegral, uint16_t u16HDecimal, uint8_t u8VScall) { }
+void vpostOSDSetColMask(uint8_t u8MaskColorR, uint8_t u8MaskColorG, uint8_t u8MaskColorB) { }
+void vpostOSDSetColKey(uint8_t u8CKeyColorR, uint8_t u8CKeyColorG, uint8_t u8CKeyColorB) { }
+void vpostOSDSetOverlay(uint8_t u8OSDDisplayMatch, uint8_t u8OSDDisplayUnMatch, uint8_t u8OSDSynW) { }
+void vpostOSDEnable(void) { }
+void vpostOSDDisable(void) { }
+void vpostVAStartTrigger(void) { _panel_on = 1; }
+void vpostVAStopTrigger(void) { _panel_on = 0; }
+void vpostSetFrameBuffer(uint8_t *pu8BufPtr) { _show(eVpost_LCD, pu8BufPtr); }
+void vpostSetOSDBuffer(uint8_t *pu8BufPtr) { _show(eVpost_OSD, pu8BufPtr); }
+
+uint8_t *vpostGetMultiFrameBuffer(uint32_t u32Cnt)
+{
+    return calloc(u32Cnt, PANEL_W * PANEL_H * BSP_LCD_BPP / 8);
+}
+
+uint8_t *vpostGetMultiOSDBuffer(uint32_t u32Cnt)
+{
+    return calloc(u32Cnt, PANEL_W * PANEL_H * BSP_LCD_BPP / 8);
+}
+
+void nu_sys_ipclk_enable(E_SYS_IPCLK eIPClkIdx) { }
+
+rt_isr_handler_t rt_hw_interrupt_install(int vector, rt_isr_handler_t handler, void *param, const char *name)
+{
+    CHECK(vector == IRQ_LCD);
+    _isr = handler;
+    _isr_param = param;
+
+    return RT_NULL;
+}
+
+void rt_hw_interrupt_umask(int vector) { }
+
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter), void *parameter,
+                   rt_tick_t time, rt_uint8_t flag)
+{
+    CHECK(time == (RT_TICK_PER_SECOND + VSYNC_HZ - 1) / VSYNC_HZ && (flag & RT_TIMER_FLAG_PERIODIC));
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    _soft_timer = timer;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    _soft_on = 1;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    _soft_on = 0;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag) { return RT_EOK; }
+
+rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
+{
+    _event_set |= set;
+
+    return RT_EOK;
+}
+
+/* one thread, waiting lets the next vsync come; a hung panel sends none */
+rt_err_t rt_event_recv(rt_event_t event, rt_uint32_t set, rt_uint8_t opt, rt_int32_t timeout, rt_uint32_t *recved)
+{
+    CHECK(!host_irq_disabled);
+    CHECK(opt == (RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR));
+
+    if (!(_event_set & set))
+    {
+        if (_hang)
+        {
+            host_tick += timeout;
+            _timeouts++;
+            return -RT_ETIMEOUT;
+        }
+        _vsync();
+    }
+
+    *recved = _event_set & set;
+    _event_set &= ~set;
+
+    return RT_EOK;
+}
+
+static rt_device_t _dev(int layer)
+{
+    return &nu_fbdev[layer].dev;
+}
+
+/* pan, or submit for the next vsync, a past one or one to come */
+static rt_err_t _submit(int layer, int how)
+{
+    struct layer_log *log = &_log[layer];
+    rt_uint32_t k = log->submitted, before = _vsyncs;
+    nu_vpost_submit_t submit = { .buf = &log->token[k] };
+    rt_err_t ret;
+
+    CHECK(k < FRAMES_MAX);
+    if (log->submitted - log->shown == DEF_VPOST_QUEUE_DEPTH)
+        log->stalls++;
+
+    if (how == 0)
+    {
+        ret = rt_device_control(_dev(layer), RTGRAPHIC_CTRL_PAN_DISPLAY, submit.buf);
+    }
+    else
+    {
+        if (how == 2 && before > 0)
+            submit.target = 1 + host_test_rand() % before;
+        else if (how == 3)
+            submit.target = before + 1 + host_test_rand() % 4;
+        ret = rt_device_control(_dev(layer), NU_VPOST_CTRL_SUBMIT, &submit);
+        if (ret == RT_EOK)
+            CHECK(submit.fence == k + 1);
+    }
+
+    if (ret == RT_EOK)
+    {
+        log->before[k] = before;
+        log->after[k] = _vsyncs;
+        log->target[k] = submit.target;
+        log->submitted++;
+    }
+
+    return ret;
+}
+
+static rt_uint32_t _max(rt_uint32_t a, rt_uint32_t b)
+{
+    return a > b ? a : b;
+}
+
+/* a wait returns at the vsync it waits for, not later and not before */
+static void _returned_at(rt_uint32_t vsync)
+{
+    if (_vsyncs < vsync)
+        _early_waits++;
+    else if (_vsyncs > vsync)
+        _late_waits++;
+}
+
+static void _wait(int layer, int how)
+{
+    struct layer_log *log = &_log[layer];
+    rt_uint32_t before = _vsyncs;
+    nu_vpost_vsync_t vsync;
+
+    switch (how)
+    {
+    case 0:
+        /* a fence of the frames submitted */
+        if (log->submitted)
+        {
+            rt_uint32_t fence = 1 + host_test_rand() % log->submitted;
+
+            CHECK(rt_device_control(_dev(layer), NU_VPOST_CTRL_WAIT_FENCE, &fence) == RT_EOK);
+            CHECK(log->shown >= fence);
+            if (log->shown >= fence)
+                _returned_at(_max(before, log->shown_at[fence - 1]));
+        }
+        break;
+
+    case 1:
+        /* the last fence */
+        CHECK(rt_device_control(_dev(layer), RTGRAPHIC_CTRL_WAIT_VSYNC, RT_NULL) == RT_EOK);
+        CHECK(log->shown == log->submitted);
+        if (log->shown)
+            _returned_at(_max(before, log->shown_at[log->shown - 1]));
+        break;
+
+    case 2:
+        CHECK(rt_device_control(_dev(layer), RTGRAPHIC_CTRL_WAIT_VSYNC, &vsync) == RT_EOK);
+        _returned_at(before + 1);
+        break;
+
+    default:
+        /* an interrupt may bring another vsync after the one returned */
+        CHECK(rt_device_control(_dev(layer), NU_VPOST_CTRL_WAIT_NEXT_VSYNC, &vsync) == RT_EOK);
+        CHECK(vsync.count == before + 1 && vsync.timestamp == _stamps[before + 1]);
+        if (_vsyncs == before + 1)
+        {
+            CHECK(rt_device_control(_dev(layer), NU_VPOST_CTRL_GET_VSYNC, &vsync) == RT_EOK);
+            CHECK(vsync.count <= _vsyncs && vsync.timestamp == _stamps[vsync.count]);
+        }
+        break;
+    }
+}
+
+static void _open_close(int layer)
+{
+    if (nu_fbdev[layer].dev.ref_count)
+        CHECK(rt_device_close(_dev(layer)) == RT_EOK);
+    else
+        CHECK(rt_device_open(_dev(layer), RT_DEVICE_OFLAG_RDWR) == RT_EOK);
+
+    /* the panel scans while a layer is opened, the soft timer runs while none is */
+    CHECK(_panel_on == (nu_fbdev[eVpost_LCD].dev.ref_count || nu_fbdev[eVpost_OSD].dev.ref_count));
+    CHECK(_soft_on == !_panel_on);
+}
+
+/* the frames of a layer against their submission, and the statistics */
+static void _verify(int layer)
+{
+    struct layer_log *log = &_log[layer];
+    long early = 0, held = 0, missed_min = 0, missed_max = 0, late_min = 0, late_max = 0;
+    nu_vpost_stat_t stat;
+    rt_uint32_t k;
+
+    CHECK(log->shown == log->submitted);
+    for (k = 0; k < log->shown; k++)
+    {
+        rt_uint32_t target = log->target[k];
+        rt_uint32_t first = _max(log->before[k] + 1, target);
+        rt_uint32_t last = _max(_max(log->after[k] + 1, target), k ? log->shown_at[k - 1] + 1 : 0);
+
+        if (log->shown_at[k] < first)
+            early++;
+        if (log->shown_at[k] > last)
+            held++;
+
+        /* the driver takes the vsync counter somewhere in the submission */
+        if (target && target < log->before[k] + 1)
+            missed_min++;
+        if (target && target < log->after[k] + 1)
+            missed_max++;
+        if (log->shown_at[k] > _max(log->after[k] + 1, target))
+            late_min++;
+        if (log->shown_at[k] > first)
+            late_max++;
+    }
+
+    CHECK(rt_device_control(_dev(layer), NU_VPOST_CTRL_GET_STAT, &stat) == RT_EOK);
+    CHECK(early == 0 && held == 0);
+    CHECK(stat.presented == log->shown);
+    CHECK(stat.stalls == log->stalls);
+    CHECK(stat.repeats == log->repeats);
+    CHECK(stat.missed >= missed_min && stat.missed <= missed_max);
+    CHECK(stat.late >= late_min && stat.late <= late_max);
+    CHECK(stat.vsyncs == _vsyncs && stat.underruns == _underruns);
+    printf("%s: %u frames, %ld early, %ld held, %u late, %u missed of %ld-%ld, %u repeats, %u stalls\n",
+           nu_fbdev[layer].name, (unsigned int)stat.presented, early, held, (unsigned int)stat.late,
+           (unsigned int)stat.missed, missed_min, missed_max, (unsigned int)stat.repeats,
+           (unsigned int)stat.stalls);
+}
+
+static void _test_random(void)
+{
+    nu_vpost_vsync_t vsync;
+    long loop;
+    int layer;
+
+    for (loop = 0; loop < LOOPS; loop++)
+    {
+        int action = host_test_rand() % 100;
+
+        /* the lcd takes most */
+        layer = host_test_rand() % 3 ? eVpost_LCD : eVpost_OSD;
+        if (action < 50)
+            CHECK(_submit(layer, host_test_rand() % 4) == RT_EOK);
+        else if (action < 90)
+            _wait(layer, host_test_rand() % 4);
+        else if (action < 91)
+            _open_close(layer);
+        else
+        {
+            CHECK(rt_device_control(_dev(layer), NU_VPOST_CTRL_GET_VSYNC, &vsync) == RT_EOK);
+            CHECK(vsync.count <= _vsyncs && vsync.timestamp == _stamps[vsync.count]);
+        }
+    }
+
+    for (layer = 0; layer < eVpost_Cnt; layer++)
+        _wait(layer, 1);
+    /* no vsync between reading the statistics and checking them */
+    host_irq_handler = RT_NULL;
+
+    CHECK(_early_waits == 0 && _late_waits == 0);
+    CHECK(rt_device_control(_dev(eVpost_LCD), NU_VPOST_CTRL_GET_VSYNC, &vsync) == RT_EOK);
+    /* 16667 us, a tick of 1 ms either way */
+    CHECK(vsync.period > 1000000 / VSYNC_HZ - 1000 && vsync.period < 1000000 / VSYNC_HZ + 1000);
+    printf("%d operations: %u vsyncs of %u us, %ld under-runs, %ld waits early, %ld waits late\n",
+           LOOPS, (unsigned int)_vsyncs, (unsigned int)vsync.period, _underruns, _early_waits, _late_waits);
+
+    for (layer = 0; layer < eVpost_Cnt; layer++)
+        _verify(layer);
+    host_irq_handler = _interrupt;
+}
+
+/* a panel without vsync: the waits give up, a frame to a full queue is not taken */
+static void _test_hang(void)
+{
+    struct layer_log *log = &_log[eVpost_LCD];
+    nu_vpost_vsync_t vsync;
+    rt_uint32_t fence, submitted;
+
+    _wait(eVpost_LCD, 1);
+    _hang = 1;
+    CHECK(_submit(eVpost_LCD, 0) == RT_EOK);
+    submitted = log->submitted;
+    fence = submitted;
+    while (log->submitted - log->shown < DEF_VPOST_QUEUE_DEPTH)
+        CHECK(_submit(eVpost_LCD, 1) == RT_EOK);
+    CHECK(_submit(eVpost_LCD, 1) == -RT_ETIMEOUT);
+    CHECK(rt_device_control(_dev(eVpost_LCD), RTGRAPHIC_CTRL_WAIT_VSYNC, &vsync) == -RT_ETIMEOUT);
+    CHECK(rt_device_control(_dev(eVpost_LCD), NU_VPOST_CTRL_WAIT_FENCE, &fence) == -RT_ETIMEOUT);
+    CHECK(log->shown < submitted);
+    _hang = 0;
+
+    _wait(eVpost_LCD, 1);
+    CHECK(log->shown == log->submitted);
+    CHECK(_timeouts == 3);
+    printf("hung panel: %ld waits timed out\n", _timeouts);
+}
+
+int main(void)
+{
+    int layer;
+
+    _stamps = calloc(VSYNCS_MAX, sizeof(rt_uint64_t));
+    CHECK(rt_hw_vpost_init() == RT_EOK);
+    CHECK(rt_device_find("lcd") == _dev(eVpost_LCD) && rt_device_find("osd") == _dev(eVpost_OSD));
+    CHECK(_isr != RT_NULL && _soft_timer != RT_NULL && _soft_on && !_panel_on);
+
+    host_test_srand(17);
+    host_irq_handler = _interrupt;
+
+    /* frames submitted before the layer is opened are shown by the soft vsync */
+    CHECK(_submit(eVpost_LCD, 0) == RT_EOK);
+    _wait(eVpost_LCD, 1);
+    CHECK(_log[eVpost_LCD].shown == 1 && !_panel_on);
+    _open_close(eVpost_LCD);
+
+    _test_random();
+    _test_hang();
+
+    for (layer = 0; layer < eVpost_Cnt; layer++)
+    {
+        if (nu_fbdev[layer].dev.ref_count)
+            _open_close(layer);
+    }
+    host_irq_handler = RT_NULL;
+    free(_stamps);
+
+    return host_test_report("vpost");
+}
@@ -0,0 +1,28 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* The workqueue and its workers on host threads; with HOST_SMP on two cpus. */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 8
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_DEBUG
+#define RT_USING_CONSOLE
+#define RT_USING_HEAP
+#define RT_USING_SEMAPHORE
+#define RT_USING_FINSH
+#define RT_KSERVICE_USING_STDLIB
+#define RT_KSERVICE_USING_STDLIB_MEMORY
+#define RT_USING_LIBC
+#if defined(__LP64__)
+#define ARCH_CPU_64BIT
+#endif
+
+#ifdef HOST_SMP
+#define RT_USING_SMP
+#define RT_CPUS_NR 2
+#endif
+
+#endif
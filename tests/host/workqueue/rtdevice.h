@@ -0,0 +1,7 @@
+#ifndef __RT_DEVICE_H__
+#define __RT_DEVICE_H__
+
+/* workqueue.c only needs its own header of the device drivers. */
+#include "ipc/workqueue.h"
+
+#endif
@@ -0,0 +1,833 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The workqueue of workqueue.c with its workers on host threads. The
+ * interrupt lock is a lock of the host, a suspended thread waits on a
+ * condition until it's resumed, and the soft timers fire when the test says.
+ * The pending works must run by priority and in order of submission within
+ * one, an urgent work first; a slow work must not hold up the others on a
+ * pool, and an idle worker must steal what is left on a busy one. Then
+ * threads submitting, cancelling and hurrying their own works at random: no
+ * work may run on two workers at once, nor be lost. test_smp binds the
+ * workers to two cpus and some works to one of them.
+ */
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_test.h"
+
+#include "workqueue.c"
+
+#define ITEMS               64
+#define STEAL_ITEMS         10
+#define QUICK_ITEMS         40
+#define SUBMITTERS          4
+#define STRESS_OPS          100000
+#define STRESS_WORKERS      4
+#define WAIT_LIMIT_MS       5000
+
+#ifdef RT_USING_SMP
+#define TEST_NAME           "workqueue smp"
+#else
+#define TEST_NAME           "workqueue"
+#endif
+
+/* the kernel: the interrupt lock is one lock, everything waits on one condition */
+static pthread_mutex_t _kernel = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _wakeup = PTHREAD_COND_INITIALIZER;
+static __thread int _irq_nest;
+static __thread rt_thread_t _self;
+static struct rt_thread _main;
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    if (_irq_nest++ == 0)
+        pthread_mutex_lock(&_kernel);
+
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    CHECK(_irq_nest > 0);
+    if (--_irq_nest == 0)
+        pthread_mutex_unlock(&_kernel);
+}
+
+/* wait for the condition, with the interrupt lock taken once */
+static void _wait(void)
+{
+    CHECK(_irq_nest == 1);
+    pthread_cond_wait(&_wakeup, &_kernel);
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    return host_test_now_ns() / 1000000;
+}
+
+/* a thread of the kernel is a host thread, started at rt_thread_startup */
+struct host_thread
+{
+    struct rt_thread thread;
+    pthread_t pthread;
+    void (*entry)(void *parameter);
+    void *parameter;
+};
+
+static void *_thread_entry(void *parameter)
+{
+    struct host_thread *host = (struct host_thread *)parameter;
+
+    _self = &host->thread;
+    host->entry(host->parameter);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    return _self ? _self : &_main;
+}
+
+rt_thread_t rt_thread_create(const char *name, void (*entry)(void *parameter), void *parameter,
+                             rt_uint32_t stack_size, rt_uint8_t priority, rt_uint32_t tick)
+{
+    struct host_thread *host = calloc(1, sizeof(struct host_thread));
+
+    snprintf(host->thread.name, RT_NAME_MAX, "%s", name);
+    host->thread.stat = RT_THREAD_INIT;
+    host->entry = entry;
+    host->parameter = parameter;
+
+    return &host->thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct host_thread *host = (struct host_thread *)thread;
+
+    thread->stat = RT_THREAD_READY;
+
+    return pthread_create(&host->pthread, RT_NULL, _thread_entry, host) == 0 ? RT_EOK : -RT_ERROR;
+}
+
+/* the worker thread has to be waiting for work, it leaves at its next rt_schedule() */
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+    struct host_thread *host = (struct host_thread *)thread;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    thread->stat = RT_THREAD_CLOSE;
+    pthread_cond_broadcast(&_wakeup);
+    rt_hw_interrupt_enable(level);
+    pthread_join(host->pthread, RT_NULL);
+    free(host);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_suspend(rt_thread_t thread)
+{
+    CHECK(_irq_nest > 0);
+    if (thread->stat != RT_THREAD_CLOSE)
+        thread->stat = RT_THREAD_SUSPEND;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_resume(rt_thread_t thread)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (thread->stat == RT_THREAD_SUSPEND)
+        thread->stat = RT_THREAD_READY;
+    pthread_cond_broadcast(&_wakeup);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_SMP
+rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
+{
+    if (cmd == RT_THREAD_CTRL_BIND_CPU)
+        thread->bind_cpu = (rt_uint8_t)(rt_ubase_t)arg;
+
+    return RT_EOK;
+}
+#endif /* RT_USING_SMP */
+
+/* the caller runs again once resumed, or leaves if deleted */
+void rt_schedule(void)
+{
+    rt_thread_t self = rt_thread_self();
+    rt_base_t level;
+    int closed;
+
+    CHECK(_irq_nest == 0);
+    level = rt_hw_interrupt_disable();
+    while (self->stat == RT_THREAD_SUSPEND)
+        _wait();
+    closed = self->stat == RT_THREAD_CLOSE;
+    rt_hw_interrupt_enable(level);
+
+    if (closed)
+        pthread_exit(RT_NULL);
+}
+
+/* the semaphore hands a release to the first waiter, as the kernel does */
+struct sem_waiter
+{
+    rt_list_t node;
+    int woken;
+};
+
+rt_err_t rt_sem_init(rt_sem_t sem, const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    sem->value = value;
+    rt_list_init(&(sem->parent.suspend_thread));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_detach(rt_sem_t sem)
+{
+    CHECK(rt_list_isempty(&(sem->parent.suspend_thread)));
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    struct sem_waiter waiter;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (sem->value > 0)
+    {
+        sem->value--;
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+    if (time == 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_ETIMEOUT;
+    }
+
+    waiter.woken = 0;
+    rt_list_insert_before(&(sem->parent.suspend_thread), &(waiter.node));
+    while (!waiter.woken)
+        _wait();
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+    return rt_sem_take(sem, 0);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    struct sem_waiter *waiter;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&(sem->parent.suspend_thread)))
+    {
+        waiter = rt_list_first_entry(&(sem->parent.suspend_thread), struct sem_waiter, node);
+        rt_list_remove(&(waiter->node));
+        waiter->woken = 1;
+        pthread_cond_broadcast(&_wakeup);
+    }
+    else
+    {
+        sem->value++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/* the soft timers are armed here and fired by _fire_timers() */
+void rt_timer_init(rt_timer_t timer, const char *name, void (*timeout)(void *parameter), void *parameter,
+                   rt_tick_t time, rt_uint8_t flag)
+{
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+    timer->parent.flag = flag & ~RT_TIMER_FLAG_ACTIVATED;
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer)
+{
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
+{
+    if (cmd == RT_TIMER_CTRL_SET_TIME)
+        timer->init_tick = *(rt_tick_t *)arg;
+
+    return RT_EOK;
+}
+
+/* the works of the test, each one knows how it ran */
+struct item
+{
+    struct rt_work work;
+    int id;
+    volatile int *gate;     /* it runs until the gate is opened */
+    int sleep_us;
+    int running;
+    int runs;
+    int worker;             /* the worker of its last run */
+    uint64_t end_ns;
+    int want;               /* submitted and not run yet */
+};
+
+static struct item _items[ITEMS];
+static struct rt_workqueue *_queue;
+static pthread_mutex_t _log = PTHREAD_MUTEX_INITIALIZER;
+static int _order[4 * ITEMS], _order_count;
+static long _overlaps, _misplaced;
+
+static int _worker_index(void)
+{
+    rt_uint16_t i;
+
+    for (i = 0; i < _queue->worker_num; i++)
+    {
+        if (_queue->workers[i].work_thread == rt_thread_self())
+            return i;
+    }
+
+    return -1;
+}
+
+static void _work(struct rt_work *work, void *work_data)
+{
+    struct item *item = (struct item *)work_data;
+    int worker = _worker_index();
+
+    CHECK(work == &item->work && worker >= 0);
+    if (__atomic_fetch_add(&item->running, 1, __ATOMIC_SEQ_CST) != 0)
+        __atomic_fetch_add(&_overlaps, 1, __ATOMIC_SEQ_CST);
+    if (work->cpu != RT_WORK_CPU_ANY && _queue->workers[worker].cpu != RT_WORK_CPU_ANY &&
+            _queue->workers[worker].cpu != work->cpu)
+        __atomic_fetch_add(&_misplaced, 1, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&_log);
+    if (_order_count < (int)(sizeof(_order) / sizeof(_order[0])))
+        _order[_order_count++] = item->id;
+    item->runs++;
+    item->worker = worker;
+    item->want = 0;
+    pthread_mutex_unlock(&_log);
+
+    if (item->gate)
+    {
+        while (!__atomic_load_n(item->gate, __ATOMIC_SEQ_CST))
+            usleep(100);
+    }
+    if (item->sleep_us)
+        usleep(item->sleep_us);
+
+    item->end_ns = host_test_now_ns();
+    __atomic_fetch_sub(&item->running, 1, __ATOMIC_SEQ_CST);
+}
+
+static void _reset_items(void)
+{
+    int index;
+
+    memset(_items, 0, sizeof(_items));
+    for (index = 0; index < ITEMS; index++)
+    {
+        _items[index].id = index;
+        rt_work_init(&_items[index].work, _work, &_items[index]);
+    }
+    _order_count = 0;
+}
+
+static int _runs(struct item *item)
+{
+    int runs;
+
+    pthread_mutex_lock(&_log);
+    runs = item->runs;
+    pthread_mutex_unlock(&_log);
+
+    return runs;
+}
+
+/* a work lost by the queue would hang the test, it fails instead */
+static void _give_up(const char *what)
+{
+    printf("%s after %d ms, giving up\n", what, WAIT_LIMIT_MS);
+    host_test_failures++;
+    exit(host_test_report(TEST_NAME));
+}
+
+static void _wait_running(struct item *item)
+{
+    uint64_t start = host_test_now_ns();
+
+    while (__atomic_load_n(&item->running, __ATOMIC_SEQ_CST) == 0)
+    {
+        if (host_test_now_ns() - start > WAIT_LIMIT_MS * 1000000ull)
+            _give_up("the work is not running");
+        usleep(100);
+    }
+}
+
+/* nothing pending and every worker waiting */
+static void _wait_idle(struct rt_workqueue *queue)
+{
+    uint64_t start = host_test_now_ns();
+    rt_base_t level;
+    rt_uint16_t i;
+    int idle;
+
+    do
+    {
+        usleep(100);
+        level = rt_hw_interrupt_disable();
+        idle = queue->depth == 0;
+        for (i = 0; i < queue->worker_num; i++)
+        {
+            if (queue->workers[i].work_current != RT_NULL || !rt_list_isempty(&(queue->workers[i].work_list)) ||
+                    queue->workers[i].work_thread->stat != RT_THREAD_SUSPEND)
+                idle = 0;
+        }
+        rt_hw_interrupt_enable(level);
+        if (!idle && host_test_now_ns() - start > WAIT_LIMIT_MS * 1000000ull)
+            _give_up("the workers are not idle");
+    }
+    while (!idle);
+}
+
+static rt_uint32_t _works_done(struct rt_workqueue *queue)
+{
+    rt_uint32_t count = 0;
+    rt_uint16_t i;
+
+    for (i = 0; i < queue->worker_num; i++)
+        count += queue->workers[i].work_count;
+
+    return count;
+}
+
+/* the fire of the soft timers of the armed works */
+static int _fire_timers(void)
+{
+    rt_timer_t timer;
+    rt_base_t level;
+    int index, fired = 0;
+
+    for (index = 0; index < ITEMS; index++)
+    {
+        timer = &_items[index].work.timer;
+        level = rt_hw_interrupt_disable();
+        if (!(timer->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            rt_hw_interrupt_enable(level);
+            continue;
+        }
+        timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        rt_hw_interrupt_enable(level);
+
+        timer->timeout_func(timer->parameter);
+        fired++;
+    }
+
+    return fired;
+}
+
+/* one worker: by priority, in order of the last submission within one, the urgent one first */
+static void _test_priority(void)
+{
+    volatile int gate = 0;
+    int expect[ITEMS], seq[ITEMS];
+    int index, count = 0, cancelled = 0, i, j, wrong = 0;
+    char *argv[] = { "list_workqueue", "-r" };
+
+    _reset_items();
+    _queue = rt_workqueue_create("prio", 2048, 10);
+    CHECK(_queue != RT_NULL && _queue->worker_num == 1);
+
+    _items[0].gate = &gate;
+    CHECK(rt_workqueue_dowork(_queue, &_items[0].work) == RT_EOK);
+    _wait_running(&_items[0]);
+    /* the running work can neither be submitted nor cancelled */
+    CHECK(rt_workqueue_dowork(_queue, &_items[0].work) == -RT_EBUSY);
+    CHECK(rt_workqueue_cancel_work(_queue, &_items[0].work) == -RT_EBUSY);
+
+    for (index = 1; index < ITEMS - 1; index++)
+    {
+        rt_work_set_priority(&_items[index].work, host_test_rand() % 8);
+        CHECK(rt_workqueue_dowork(_queue, &_items[index].work) == RT_EOK);
+        seq[index] = index;
+    }
+    /* submitted again, a pending work goes behind the others of its priority */
+    for (index = 1; index < ITEMS - 1; index += 5)
+    {
+        CHECK(rt_workqueue_dowork(_queue, &_items[index].work) == RT_EOK);
+        seq[index] = ITEMS + index;
+    }
+    CHECK(_queue->depth == ITEMS - 2);
+    for (index = 7; index < ITEMS - 1; index += 7)
+    {
+        CHECK(rt_workqueue_cancel_work(_queue, &_items[index].work) == RT_EOK);
+        CHECK(!(_items[index].work.flags & RT_WORK_STATE_PENDING));
+        cancelled++;
+    }
+    CHECK(_queue->depth == ITEMS - 2 - cancelled);
+    /* the lowest priority, but urgent */
+    rt_work_set_priority(&_items[ITEMS - 1].work, RT_THREAD_PRIORITY_MAX - 1);
+    CHECK(rt_workqueue_urgent_work(_queue, &_items[ITEMS - 1].work) == RT_EOK);
+    CHECK(_items[ITEMS - 1].work.flags & RT_WORK_STATE_PENDING);
+    CHECK(_queue->depth == ITEMS - 1 - cancelled && _queue->max_depth == ITEMS - 2);
+
+    gate = 1;
+    _wait_idle(_queue);
+
+    /* the expected order: the running one, the urgent one, then the rest sorted */
+    expect[count++] = 0;
+    expect[count++] = ITEMS - 1;
+    for (index = 1; index < ITEMS - 1; index++)
+    {
+        if (index % 7 == 0)
+            continue;
+        for (i = count; i > 2; i--)
+        {
+            j = expect[i - 1];
+            if (_items[j].work.priority < _items[index].work.priority ||
+                    (_items[j].work.priority == _items[index].work.priority && seq[j] < seq[index]))
+                break;
+            expect[i] = j;
+        }
+        expect[i] = index;
+        count++;
+    }
+
+    CHECK(_order_count == count);
+    for (index = 0; index < count && index < _order_count; index++)
+    {
+        if (_order[index] != expect[index] && wrong++ < 5)
+            printf("run %d: work %d, expected %d\n", index, _order[index], expect[index]);
+    }
+    CHECK(wrong == 0);
+    CHECK(_queue->depth == 0 && _works_done(_queue) == (rt_uint32_t)count);
+    CHECK(_queue->workers[0].steal_count == 0);
+    printf("%d works of 8 priorities and an urgent one on one worker: %d out of order, %d cancelled\n",
+           count, wrong, cancelled);
+
+    /* the statistics are printed and reset */
+    CHECK(list_workqueue(2, argv) == 0);
+    CHECK(_queue->workers[0].work_count == 0 && _queue->max_depth == 0);
+    argv[1] = "-x";
+    CHECK(list_workqueue(2, argv) == -RT_EINVAL);
+
+    CHECK(rt_workqueue_destroy(_queue) == RT_EOK);
+}
+
+/* the time the last of the quick works is done, behind a slow one */
+static uint64_t _quick_behind_slow(rt_uint16_t workers)
+{
+    uint64_t start, last = 0;
+    int index;
+
+    _reset_items();
+    _queue = rt_workqueue_create_pool("quick", 2048, 10, workers);
+    CHECK(_queue != RT_NULL && _queue->worker_num == workers);
+
+    start = host_test_now_ns();
+    _items[0].sleep_us = 200000;
+    CHECK(rt_workqueue_dowork(_queue, &_items[0].work) == RT_EOK);
+    for (index = 1; index <= QUICK_ITEMS; index++)
+    {
+        _items[index].sleep_us = 2000;
+        CHECK(rt_workqueue_dowork(_queue, &_items[index].work) == RT_EOK);
+    }
+    _wait_idle(_queue);
+
+    for (index = 1; index <= QUICK_ITEMS; index++)
+    {
+        CHECK(_items[index].runs == 1);
+        if (_items[index].end_ns > last)
+            last = _items[index].end_ns;
+    }
+    CHECK(_items[0].runs == 1);
+    if (workers > 1)
+        CHECK(last < _items[0].end_ns);
+    CHECK(_works_done(_queue) == QUICK_ITEMS + 1);
+    /* the execution time in OS ticks of 1 ms */
+    for (index = 0; index < workers; index++)
+    {
+        if (_queue->workers[index].max_time >= 200)
+            break;
+    }
+    CHECK(index < workers && _queue->workers[index].max_time < 400);
+    CHECK(rt_workqueue_destroy(_queue) == RT_EOK);
+
+    return (last - start) / 1000000;
+}
+
+/* an idle worker takes the works left on a busy one */
+static void _test_steal(void)
+{
+    volatile int gate_a = 0, gate_b = 0;
+    int index, busy, freed, done;
+    uint64_t start;
+
+    _reset_items();
+    _queue = rt_workqueue_create_pool("steal", 2048, 10, 2);
+    CHECK(_queue != RT_NULL);
+
+    _items[0].gate = &gate_a;
+    _items[1].gate = &gate_b;
+    CHECK(rt_workqueue_dowork(_queue, &_items[0].work) == RT_EOK);
+    _wait_running(&_items[0]);
+    /* the idle worker is preferred */
+    CHECK(rt_workqueue_dowork(_queue, &_items[1].work) == RT_EOK);
+    _wait_running(&_items[1]);
+    freed = _items[0].worker;
+    busy = _items[1].worker;
+    CHECK(freed != busy);
+
+    /* both busy, the works are queued in turn */
+    for (index = 2; index < 2 + STEAL_ITEMS; index++)
+        CHECK(rt_workqueue_dowork(_queue, &_items[index].work) == RT_EOK);
+    CHECK(rt_list_len(&(_queue->workers[0].work_list)) == STEAL_ITEMS / 2);
+    CHECK(rt_list_len(&(_queue->workers[1].work_list)) == STEAL_ITEMS / 2);
+
+    gate_a = 1;
+    start = host_test_now_ns();
+    do
+    {
+        usleep(100);
+        for (done = 0, index = 2; index < 2 + STEAL_ITEMS; index++)
+            done += _runs(&_items[index]);
+        if (done < STEAL_ITEMS && host_test_now_ns() - start > WAIT_LIMIT_MS * 1000000ull)
+            _give_up("the works of the busy worker are not stolen");
+    }
+    while (done < STEAL_ITEMS);
+
+    for (index = 2; index < 2 + STEAL_ITEMS; index++)
+        CHECK(_items[index].runs == 1 && _items[index].worker == freed);
+    CHECK(_items[1].running == 1);
+    CHECK(_queue->workers[freed].steal_count == STEAL_ITEMS / 2);
+    printf("%d works queued on two busy workers, one freed: it ran %d of them, %d stolen\n",
+           STEAL_ITEMS, STEAL_ITEMS, (int)_queue->workers[freed].steal_count);
+
+    gate_b = 1;
+    _wait_idle(_queue);
+    CHECK(_queue->workers[busy].steal_count == 0);
+    CHECK(rt_workqueue_destroy(_queue) == RT_EOK);
+}
+
+/* the delayed works on their timers, cancelled before and while running */
+static void _test_delayed(void)
+{
+    volatile int gate = 0;
+    struct item *item;
+
+    _reset_items();
+    _queue = rt_workqueue_create_pool("delay", 2048, 10, 2);
+    CHECK(_queue != RT_NULL);
+    item = &_items[0];
+
+    CHECK(rt_workqueue_submit_work(_queue, &item->work, 10) == RT_EOK);
+    CHECK(item->work.flags & RT_WORK_STATE_SUBMITTING);
+    CHECK(_queue->depth == 0);
+    /* submitted again, the timer is set again */
+    CHECK(rt_workqueue_submit_work(_queue, &item->work, 20) == RT_EOK);
+    CHECK(item->work.timer.init_tick == 20);
+    CHECK(rt_list_len(&(_queue->delayed_list)) == 1);
+    CHECK(_fire_timers() == 1);
+    _wait_idle(_queue);
+    CHECK(item->runs == 1 && !(item->work.flags & RT_WORK_STATE_SUBMITTING));
+    CHECK(rt_list_isempty(&(_queue->delayed_list)));
+
+    /* cancelled before the timer */
+    CHECK(rt_workqueue_submit_work(_queue, &item->work, 10) == RT_EOK);
+    CHECK(rt_workqueue_cancel_work(_queue, &item->work) == RT_EOK);
+    CHECK(_fire_timers() == 0);
+    CHECK(rt_workqueue_submit_work(_queue, &_items[1].work, 10) == RT_EOK);
+    CHECK(rt_workqueue_cancel_all_work(_queue) == RT_EOK);
+    CHECK(_fire_timers() == 0);
+    _wait_idle(_queue);
+    CHECK(item->runs == 1 && _items[1].runs == 0);
+    CHECK(rt_list_isempty(&(_queue->delayed_list)) && _queue->depth == 0);
+
+    /* cancelled while running, the sync one waits for it */
+    item->gate = &gate;
+    item->sleep_us = 20000;
+    CHECK(rt_workqueue_dowork(_queue, &item->work) == RT_EOK);
+    _wait_running(item);
+    gate = 1;
+    CHECK(rt_workqueue_cancel_work_sync(_queue, &item->work) == RT_EOK);
+    CHECK(item->running == 0 && item->runs == 2);
+
+    CHECK(rt_workqueue_destroy(_queue) == RT_EOK);
+}
+
+/* threads at random on their own works: submitted, hurried, cancelled, moved */
+static void *_submitter(void *parameter)
+{
+    int first = (int)(rt_ubase_t)parameter * (ITEMS / SUBMITTERS);
+    struct item *item;
+    rt_err_t err;
+    uint32_t seed = first * 2654435761u + 1;
+    int op;
+
+    for (op = 0; op < STRESS_OPS; op++)
+    {
+        seed = seed * 1103515245 + 12345;
+        item = &_items[first + (seed >> 8) % (ITEMS / SUBMITTERS)];
+
+        pthread_mutex_lock(&_log);
+        item->want = 1;
+        pthread_mutex_unlock(&_log);
+
+        switch ((seed >> 20) % 10)
+        {
+        case 0:
+            err = rt_workqueue_urgent_work(_queue, &item->work);
+            break;
+        case 1:
+        case 2:
+            /* pending no more, whether running or not */
+            rt_workqueue_cancel_work(_queue, &item->work);
+            err = -RT_ERROR;
+            break;
+        case 3:
+            rt_work_set_priority(&item->work, (seed >> 12) % 4);
+            /* fall through */
+        default:
+            err = rt_workqueue_dowork(_queue, &item->work);
+            break;
+        }
+
+        if (err != RT_EOK)
+        {
+            /* cancelled, or running and not queued again */
+            pthread_mutex_lock(&_log);
+            item->want = 0;
+            pthread_mutex_unlock(&_log);
+        }
+    }
+
+    return RT_NULL;
+}
+
+static void _test_stress(void)
+{
+    pthread_t threads[SUBMITTERS];
+    long runs = 0, lost = 0, steals = 0;
+    int index;
+
+    _reset_items();
+    _overlaps = _misplaced = 0;
+    _queue = rt_workqueue_create_pool("stress", 2048, 10, STRESS_WORKERS);
+    CHECK(_queue != RT_NULL);
+#ifdef RT_USING_SMP
+    for (index = 0; index < STRESS_WORKERS; index++)
+    {
+        CHECK(_queue->workers[index].cpu == index % RT_CPUS_NR);
+        CHECK(_queue->workers[index].work_thread->bind_cpu == index % RT_CPUS_NR);
+    }
+#endif /* RT_USING_SMP */
+
+    for (index = 0; index < ITEMS; index++)
+    {
+        if (index % 8 == 0)
+            _items[index].sleep_us = 20;
+        if (index % 4 == 1)
+            rt_work_set_cpu(&_items[index].work, 1);
+    }
+
+    for (index = 0; index < SUBMITTERS; index++)
+        pthread_create(&threads[index], RT_NULL, _submitter, (void *)(rt_ubase_t)index);
+    for (index = 0; index < SUBMITTERS; index++)
+        pthread_join(threads[index], RT_NULL);
+    _wait_idle(_queue);
+
+    for (index = 0; index < ITEMS; index++)
+    {
+        runs += _items[index].runs;
+        if (_items[index].want)
+            lost++;
+    }
+    for (index = 0; index < STRESS_WORKERS; index++)
+        steals += _queue->workers[index].steal_count;
+
+    CHECK(_overlaps == 0);
+    CHECK(_misplaced == 0);
+    CHECK(lost == 0);
+    CHECK(_queue->depth == 0 && _queue->max_depth <= ITEMS);
+    CHECK(_works_done(_queue) == (rt_uint32_t)runs);
+    printf("%d threads, %d operations: %ld runs, %ld stolen, depth at most %d, "
+           "%ld runs at once, %ld on another cpu, %ld lost\n", SUBMITTERS, SUBMITTERS * STRESS_OPS,
+           runs, steals, (int)_queue->max_depth, _overlaps, _misplaced, lost);
+
+    CHECK(rt_workqueue_destroy(_queue) == RT_EOK);
+}
+
+int main(void)
+{
+    uint64_t pool, single;
+
+    _main.stat = RT_THREAD_READY;
+    host_test_srand(9);
+
+    _test_priority();
+    pool = _quick_behind_slow(4);
+    single = _quick_behind_slow(1);
+    printf("%d works of 2 ms behind one of 200 ms: all done after %u ms on 4 workers, %u ms on 1\n",
+           QUICK_ITEMS, (unsigned int)pool, (unsigned int)single);
+    _test_steal();
+    _test_delayed();
+    _test_stress();
+
+    return host_test_report(TEST_NAME);
+}
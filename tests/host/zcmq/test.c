@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    the first version
+ */
+
+/*
+ * The zero-copy message queue of ipc.c: the messages are aligned to
+ * RT_ALIGN_SIZE wherever the pool starts, they stay inside the pool, come
+ * out in order, and the queue never holds more than RT_MB_ENTRY_MAX. Then
+ * the cost of a message through it and through rt_mq, at several sizes.
+ */
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+
+#define BENCH_DEPTH         16
+#define BENCH_BYTES         (64 * 1024 * 1024)
+
+/* fill a queue in a pool at the given offset from RT_ALIGN_SIZE */
+static void _test_layout(rt_size_t msg_size, rt_size_t max_msgs, rt_size_t offset)
+{
+    rt_size_t pool_size = RT_ZCMQ_POOL_SIZE(msg_size, max_msgs);
+    rt_uint8_t *buf = aligned_alloc(RT_ALIGN_SIZE, RT_ALIGN(pool_size + offset, RT_ALIGN_SIZE));
+    rt_uint8_t *pool = buf + offset;
+    void **msgs = calloc(max_msgs, sizeof(void *));
+    struct rt_zcmq zcmq;
+    rt_size_t index;
+
+    CHECK(rt_zcmq_init(&zcmq, "zq", pool, msg_size, pool_size, RT_IPC_FLAG_FIFO) == RT_EOK);
+    CHECK(zcmq.mp.block_total_count == max_msgs);
+
+    for (index = 0; index < max_msgs; index++)
+    {
+        msgs[index] = rt_zcmq_alloc(&zcmq, 0);
+        CHECK(msgs[index] != RT_NULL);
+        if (msgs[index] == RT_NULL)
+            break;
+        CHECK(((rt_ubase_t)msgs[index] % RT_ALIGN_SIZE) == 0);
+        CHECK((rt_uint8_t *)msgs[index] >= pool + RT_ALIGN(max_msgs * sizeof(rt_ubase_t), RT_ALIGN_SIZE));
+        CHECK((rt_uint8_t *)msgs[index] + msg_size <= pool + pool_size);
+        memset(msgs[index], (int)index, msg_size);
+    }
+    CHECK(rt_zcmq_alloc(&zcmq, 0) == RT_NULL);
+
+    for (index = 0; index < max_msgs; index++)
+        CHECK(rt_zcmq_commit(&zcmq, msgs[index]) == RT_EOK);
+    for (index = 0; index < max_msgs; index++)
+    {
+        rt_uint8_t *msg = rt_zcmq_borrow(&zcmq, 0);
+
+        CHECK(msg == msgs[index]);
+        if (msg == RT_NULL)
+            break;
+        CHECK(msg[0] == (rt_uint8_t)index && msg[msg_size - 1] == (rt_uint8_t)index);
+        rt_zcmq_release(&zcmq, msg);
+    }
+    CHECK(rt_zcmq_borrow(&zcmq, 0) == RT_NULL);
+    CHECK(zcmq.mp.block_free_count == max_msgs);
+
+    rt_zcmq_detach(&zcmq);
+    free(msgs);
+    free(buf);
+}
+
+static void _test_limits(void)
+{
+    struct rt_zcmq big;
+    rt_zcmq_t zcmq;
+    void *pool;
+
+    /* too small for one message */
+    pool = malloc(RT_ALIGN_SIZE);
+    CHECK(rt_zcmq_init(&big, "zq", pool, 16, RT_ALIGN_SIZE, RT_IPC_FLAG_FIFO) == -RT_EINVAL);
+    free(pool);
+
+    /* the mailbox can't count beyond RT_MB_ENTRY_MAX */
+    CHECK(rt_zcmq_create("zq", 4, (rt_size_t)RT_MB_ENTRY_MAX + 1, RT_IPC_FLAG_FIFO) == RT_NULL);
+    CHECK(rt_zcmq_create("zq", 4, 0, RT_IPC_FLAG_FIFO) == RT_NULL);
+    pool = malloc(RT_ZCMQ_POOL_SIZE(4, 70000));
+    CHECK(rt_zcmq_init(&big, "zq", pool, 4, RT_ZCMQ_POOL_SIZE(4, 70000), RT_IPC_FLAG_FIFO) == RT_EOK);
+    CHECK(big.mp.block_total_count == RT_MB_ENTRY_MAX);
+    CHECK(big.mb.size == RT_MB_ENTRY_MAX);
+    rt_zcmq_detach(&big);
+    free(pool);
+
+    zcmq = rt_zcmq_create("zq", 24, RT_MB_ENTRY_MAX, RT_IPC_FLAG_FIFO);
+    CHECK(zcmq != RT_NULL && zcmq->mp.block_total_count == RT_MB_ENTRY_MAX);
+    if (zcmq)
+        rt_zcmq_delete(zcmq);
+}
+
+/* the words of a message the sender writes and the receiver reads, 1 or all of them */
+static rt_size_t _touch;
+
+static void _produce(rt_uint32_t *msg, rt_size_t size, rt_uint32_t seq)
+{
+    rt_size_t index, count = _touch ? _touch : size / 4;
+
+    for (index = 0; index < count; index++)
+        msg[index] = seq + index;
+}
+
+static rt_uint32_t _consume(const rt_uint32_t *msg, rt_size_t size)
+{
+    rt_uint32_t sum = 0;
+    rt_size_t index, count = _touch ? _touch : size / 4;
+
+    for (index = 0; index < count; index++)
+        sum += msg[index];
+
+    return sum;
+}
+
+/* nanoseconds per message, BENCH_DEPTH messages sent then received in turn */
+static double _bench_mq(rt_size_t size, rt_uint32_t *sum)
+{
+    rt_mq_t mq = rt_mq_create("mq", size, BENCH_DEPTH, RT_IPC_FLAG_FIFO);
+    rt_uint32_t *msg = malloc(size);
+    rt_size_t rounds = BENCH_BYTES / size / BENCH_DEPTH + 1, round, index;
+    uint64_t begin = host_test_now_ns();
+
+    for (round = 0; round < rounds; round++)
+    {
+        for (index = 0; index < BENCH_DEPTH; index++)
+        {
+            _produce(msg, size, round + index);
+            rt_mq_send(mq, msg, size);
+        }
+        for (index = 0; index < BENCH_DEPTH; index++)
+        {
+            rt_mq_recv(mq, msg, size, 0);
+            *sum += _consume(msg, size);
+        }
+    }
+    begin = host_test_now_ns() - begin;
+
+    free(msg);
+    rt_mq_delete(mq);
+
+    return (double)begin / (rounds * BENCH_DEPTH);
+}
+
+static double _bench_zcmq(rt_size_t size, rt_uint32_t *sum)
+{
+    rt_zcmq_t zcmq = rt_zcmq_create("zq", size, BENCH_DEPTH, RT_IPC_FLAG_FIFO);
+    rt_size_t rounds = BENCH_BYTES / size / BENCH_DEPTH + 1, round, index;
+    uint64_t begin = host_test_now_ns();
+
+    for (round = 0; round < rounds; round++)
+    {
+        for (index = 0; index < BENCH_DEPTH; index++)
+        {
+            rt_uint32_t *msg = rt_zcmq_alloc(zcmq, 0);
+
+            _produce(msg, size, round + index);
+            rt_zcmq_commit(zcmq, msg);
+        }
+        for (index = 0; index < BENCH_DEPTH; index++)
+        {
+            rt_uint32_t *msg = rt_zcmq_borrow(zcmq, 0);
+
+            *sum += _consume(msg, size);
+            rt_zcmq_release(zcmq, msg);
+        }
+    }
+    begin = host_test_now_ns() - begin;
+
+    rt_zcmq_delete(zcmq);
+
+    return (double)begin / (rounds * BENCH_DEPTH);
+}
+
+static void _bench(void)
+{
+    static const rt_size_t sizes[] = { 16, 64, 256, 1024, 4096 };
+    rt_uint32_t sum_mq, sum_zcmq;
+    double mq[2], zcmq[2];
+    rt_size_t index;
+
+    printf("ns per message    rt_mq    rt_zcmq   (1 word touched)\n");
+    for (index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+    {
+        for (_touch = 0; _touch < 2; _touch++)
+        {
+            sum_mq = sum_zcmq = 0;
+            mq[_touch] = _bench_mq(sizes[index], &sum_mq);
+            zcmq[_touch] = _bench_zcmq(sizes[index], &sum_zcmq);
+            /* the same messages went through */
+            CHECK(sum_mq == sum_zcmq);
+        }
+        printf("%4u bytes     %8.1f   %8.1f   (%6.1f   %6.1f)\n",
+               (unsigned int)sizes[index], mq[0], zcmq[0], mq[1], zcmq[1]);
+    }
+}
+
+int main(void)
+{
+    static const rt_size_t sizes[] = { 1, 4, 12, 32, 33, 100 };
+    rt_size_t size, offset;
+
+    for (size = 0; size < sizeof(sizes) / sizeof(sizes[0]); size++)
+    {
+        for (offset = 0; offset < RT_ALIGN_SIZE; offset += sizeof(rt_ubase_t))
+            _test_layout(sizes[size], 1 + size * 3, offset);
+    }
+    _test_limits();
+    _bench();
+
+    return host_test_report("zcmq");
+}